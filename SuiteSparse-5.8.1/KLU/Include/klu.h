@@ -27,7 +27,8 @@ typedef struct
      * in the L factor of the kth block is Lnz [k]. 
      */
 
-    /* only computed if the AMD ordering is chosen: */
+    /* only computed if the AMD or METIS ordering is chosen (symmetry: AMD
+     * only, for the largest block): */
     double symmetry ;   /* symmetry of largest block */
     double est_flops ;  /* est. factorization flop count */
     double lnz, unz ;   /* estimated nz in L and U, including diagonals */
@@ -43,7 +44,7 @@ typedef struct
         nzoff,          /* nz in off-diagonal blocks */
         nblocks,        /* number of blocks */
         maxblock,       /* size of largest block */
-        ordering,       /* ordering used (AMD, COLAMD, or GIVEN) */
+        ordering,       /* ordering used (AMD, COLAMD, GIVEN, or METIS) */
         do_btf ;        /* whether or not BTF preordering was requested */
 
     /* only computed if BTF preordering requested */
@@ -104,6 +105,17 @@ typedef struct
     void *Offx ;        /* size nzoff, numerical values */
     int nzoff ;
 
+    /* mixed precision (see Common->mixed).  If mixed is TRUE, the entries of
+     * L and U in LUbx are held in single precision, and the entries of the
+     * diagonal blocks of the scaled and permuted matrix are kept in D (in
+     * double precision) to compute the residual for iterative refinement. */
+    int mixed ;         /* TRUE if L and U are held in single precision */
+    int *Dp ;           /* size n+1, column pointers of D */
+    int *Di ;           /* size nzdiag, row indices of D, in pivotal order */
+    void *Dx ;          /* size nzdiag, numerical values of D */
+    int nzdiag ;        /* # of entries in D */
+    void *Mwork ;       /* workspace for the mixed precision solve */
+
 } klu_numeric ;
 
 typedef struct          /* 64-bit version (otherwise same as above) */
@@ -120,9 +132,56 @@ typedef struct          /* 64-bit version (otherwise same as above) */
     SuiteSparse_long *Offp, *Offi ;
     void *Offx ;
     SuiteSparse_long nzoff ;
+    SuiteSparse_long mixed, *Dp, *Di ;
+    void *Dx ;
+    SuiteSparse_long nzdiag ;
+    void *Mwork ;
 
 } klu_l_numeric ;
 
+/* -------------------------------------------------------------------------- */
+/* Batch Numeric object - contains the factors computed by klu_batch_factor */
+/* -------------------------------------------------------------------------- */
+
+/* number of matrices of a batch whose values are interleaved */
+#define KLU_BATCH_WIDTH 8
+
+typedef struct
+{
+    /* LU factors of a batch of matrices with the same pattern, all computed
+     * with the pivot ordering of the first matrix.  The matrices are held in
+     * groups of KLU_BATCH_WIDTH.  The values of each group are contiguous in
+     * LUx: the values of L and U (excl. the diagonal of U), then the diagonal
+     * of U, then the entries in the off-diagonal blocks.  The values of an
+     * entry for all the matrices of the group are contiguous. */
+
+    klu_numeric *Numeric ;  /* pattern and pivot ordering of the factors */
+    int n ;             /* A is n-by-n */
+    int nbatch ;        /* number of matrices */
+    int ngroups ;       /* number of groups of KLU_BATCH_WIDTH matrices */
+    int nzlu ;          /* nz in L and U of one matrix, excl. diagonals */
+    int *Lxp ;          /* size n. L(:,k) is at LUx [Lxp[k]*KLU_BATCH_WIDTH]
+                         * in each group */
+    int *Uxp ;          /* size n. same for U(:,k) */
+    size_t groupsize ;  /* size of the values of a group, in Entry's */
+    void *LUx ;         /* size groupsize*ngroups.  values of the factors */
+    size_t rssize ;     /* size of Rs */
+    double *Rs ;        /* scale factors of each group in pivotal order,
+                         * interleaved as LUx.  NULL if no scaling */
+
+} klu_batch_numeric ;
+
+typedef struct          /* 64-bit version (otherwise same as above) */
+{
+    klu_l_numeric *Numeric ;
+    SuiteSparse_long n, nbatch, ngroups, nzlu, *Lxp, *Uxp ;
+    size_t groupsize ;
+    void *LUx ;
+    size_t rssize ;
+    double *Rs ;
+
+} klu_l_batch_numeric ;
+
 /* -------------------------------------------------------------------------- */
 /* KLU control parameters and statistics */
 /* -------------------------------------------------------------------------- */
@@ -149,7 +208,8 @@ typedef struct klu_common_struct
 
     int btf ;               /* use BTF pre-ordering, or not */
     int ordering ;          /* 0: AMD, 1: COLAMD, 2: user P and Q,
-                             * 3: user function */
+                             * 3: user function, 4: METIS nested dissection
+                             * (if KLU is compiled with METIS) */
     int scale ;             /* row scaling: -1: none (and no error check),
                              * 0: none, 1: sum, 2: max */
 
@@ -204,6 +264,50 @@ typedef struct klu_common_struct
     size_t memusage ;   /* current memory usage, in bytes */
     size_t mempeak ;    /* peak memory usage, in bytes */
 
+    /* ---------------------------------------------------------------------- */
+    /* parameters and statistics added after KLU 1.3.9, kept at the end so that
+     * the offsets of the members above do not change */
+    /* ---------------------------------------------------------------------- */
+
+    double panel_density ;      /* density threshold for dense panels in L.  A
+        * column k of L of a block of size nk joins the panel of column k-1 if
+        * it has at least panel_density*(nk-k-1) entries and the same pattern
+        * as column k-1 (less the pivot row of column k).  The columns of a
+        * panel are then applied as one dense update in klu_factor.  <= 0:
+        * no dense panels (the default). */
+
+    int nthreads ;              /* # of threads for klu_factor, klu_refactor,
+        * klu_solve_multi and klu_tsolve_multi.  The diagonal blocks of the BTF
+        * form are numerically independent, so they can be factorized
+        * concurrently, and the right-hand-sides can be solved concurrently.
+        * <= 1: sequential (the default).  Ignored unless KLU is compiled with
+        * OpenMP.  The results are identical to those computed sequentially. */
+
+    int nd_threshold ;          /* with ordering 4, blocks of the BTF form of
+        * size less than nd_threshold are ordered with AMD instead of METIS. */
+
+    int mixed ;                 /* TRUE: klu_factor holds the entries of L and
+        * U in single precision, and klu_solve and klu_tsolve recover double
+        * precision accuracy with iterative refinement.  If the refinement
+        * stalls, the factors are converted back to double precision (and
+        * Numeric->mixed is set to FALSE).  This halves the memory for the
+        * numerical values of L and U, and the memory traffic of klu_refactor
+        * and klu_solve.  It is ignored (Numeric->mixed is FALSE) if the
+        * factors are too small for the extra copy of A to pay off.  FALSE:
+        * double precision (the default). */
+
+    int nrefine ;       /* # of steps of iterative refinement done by the last
+                         * mixed precision klu_solve or klu_tsolve */
+
+    /* ---------------------------------------------------------------------- */
+    /* memory arena (see klu_arena_start) */
+    /* ---------------------------------------------------------------------- */
+
+    void *arena ;           /* the arena, or NULL if none (the default) */
+    size_t arena_retained ; /* bytes held by the arena for reuse */
+    size_t arena_peak ;     /* peak bytes held by the arena, in use or not */
+    size_t arena_nmalloc ;  /* # of blocks the arena got from malloc */
+
 } klu_common ;
 
 typedef struct klu_l_common_struct /* 64-bit version (otherwise same as above)*/
@@ -220,6 +324,10 @@ typedef struct klu_l_common_struct /* 64-bit version (otherwise same as above)*/
         singular_col, noffdiag ;
     double flops, rcond, condest, rgrowth, work ;
     size_t memusage, mempeak ;
+    double panel_density ;
+    SuiteSparse_long nthreads, nd_threshold, mixed, nrefine ;
+    void *arena ;
+    size_t arena_retained, arena_peak, arena_nmalloc ;
 
 } klu_l_common ;
 
@@ -234,6 +342,35 @@ int klu_defaults
 
 SuiteSparse_long klu_l_defaults (klu_l_common *Common) ;
 
+/* -------------------------------------------------------------------------- */
+/* klu_arena_start, klu_arena_trim, klu_arena_finish: memory arena */
+/* -------------------------------------------------------------------------- */
+
+/* klu_arena_start attaches a memory arena to Common.  Memory that KLU frees is
+ * then kept by the arena and reused by later allocations of about the same
+ * size, instead of being returned to the heap.  A sequence of klu_factor,
+ * klu_refactor, klu_solve, and klu_free_numeric that repeats with the same
+ * matrix sizes (as in a long-running simulation) does no heap allocation
+ * once its first cycle is done.  Common->arena_retained, arena_peak and
+ * arena_nmalloc report the memory held by the arena.  Objects allocated while
+ * the arena is attached must be freed with the same Common (or a copy of it)
+ * while it is still attached, and vice versa; klu_defaults must not be called
+ * on a Common with an arena.
+ *
+ * klu_arena_start fails (with Common->status KLU_INVALID) if Common already
+ * has an arena.  klu_arena_trim returns the memory kept for reuse to the heap.
+ * klu_arena_finish trims the arena and detaches it from Common.  It fails
+ * (with Common->status KLU_INVALID) if any object allocated from the arena
+ * has not been freed. */
+
+int klu_arena_start (klu_common *Common) ;
+int klu_arena_trim (klu_common *Common) ;
+int klu_arena_finish (klu_common *Common) ;
+
+SuiteSparse_long klu_l_arena_start (klu_l_common *Common) ;
+SuiteSparse_long klu_l_arena_trim (klu_l_common *Common) ;
+SuiteSparse_long klu_l_arena_finish (klu_l_common *Common) ;
+
 /* -------------------------------------------------------------------------- */
 /* klu_analyze:  orders and analyzes a matrix */
 /* -------------------------------------------------------------------------- */
@@ -388,6 +525,61 @@ SuiteSparse_long klu_zl_tsolve (klu_l_symbolic *, klu_l_numeric *,
     klu_l_common * ) ;
 
 
+/* -------------------------------------------------------------------------- */
+/* klu_solve_multi, klu_tsolve_multi: solves with many right-hand-sides */
+/* -------------------------------------------------------------------------- */
+
+/* Same as klu_solve and klu_tsolve, but better suited for a large number of
+ * right-hand-sides.  The columns of B are solved in panels of up to 16
+ * columns, and the panels are solved concurrently if KLU is compiled with
+ * OpenMP and Common->nthreads > 1.  Workspace is allocated for each call. */
+
+int klu_solve_multi
+(
+    /* inputs, not modified */
+    klu_symbolic *Symbolic,
+    klu_numeric *Numeric,
+    int ldim,               /* leading dimension of B */
+    int nrhs,               /* number of right-hand-sides */
+
+    /* right-hand-side on input, overwritten with solution to Ax=b on output */
+    double B [ ],           /* size ldim*nrhs */
+    klu_common *Common
+) ;
+
+int klu_z_solve_multi (klu_symbolic *, klu_numeric *, int, int, double *,
+    klu_common *) ;
+
+SuiteSparse_long klu_l_solve_multi (klu_l_symbolic *, klu_l_numeric *,
+    SuiteSparse_long, SuiteSparse_long, double *, klu_l_common *) ;
+
+SuiteSparse_long klu_zl_solve_multi (klu_l_symbolic *, klu_l_numeric *,
+    SuiteSparse_long, SuiteSparse_long, double *, klu_l_common *) ;
+
+int klu_tsolve_multi
+(
+    /* inputs, not modified */
+    klu_symbolic *Symbolic,
+    klu_numeric *Numeric,
+    int ldim,               /* leading dimension of B */
+    int nrhs,               /* number of right-hand-sides */
+
+    /* right-hand-side on input, overwritten with solution to A'x=b on output */
+    double B [ ],           /* size ldim*nrhs */
+    klu_common *Common
+) ;
+
+int klu_z_tsolve_multi (klu_symbolic *, klu_numeric *, int, int, double *,
+    int, klu_common *) ;
+
+SuiteSparse_long klu_l_tsolve_multi (klu_l_symbolic *, klu_l_numeric *,
+    SuiteSparse_long, SuiteSparse_long, double *, klu_l_common *) ;
+
+SuiteSparse_long klu_zl_tsolve_multi (klu_l_symbolic *, klu_l_numeric *,
+    SuiteSparse_long, SuiteSparse_long, double *, SuiteSparse_long,
+    klu_l_common * ) ;
+
+
 /* -------------------------------------------------------------------------- */
 /* klu_refactor: refactorizes matrix with same ordering as klu_factor */
 /* -------------------------------------------------------------------------- */
@@ -459,6 +651,104 @@ SuiteSparse_long klu_l_free_numeric (klu_l_numeric **, klu_l_common *) ;
 SuiteSparse_long klu_zl_free_numeric (klu_l_numeric **, klu_l_common *) ;
 
 
+/* -------------------------------------------------------------------------- */
+/* klu_batch_*: factors and solves a batch of matrices with the same pattern */
+/* -------------------------------------------------------------------------- */
+
+/* klu_batch_factor factors the first matrix of the batch with klu_factor,
+ * then factors all of them with its pivot ordering, as klu_refactor would.
+ * klu_batch_refactor refactors a new batch of values.  klu_batch_solve
+ * solves one system per matrix.  The matrices of the batch should be close
+ * enough for the pivot ordering of the first one to remain stable.  The
+ * groups of KLU_BATCH_WIDTH matrices are processed concurrently if KLU is
+ * compiled with OpenMP and Common->nthreads > 1.  A zero pivot in any matrix
+ * is reported as KLU_SINGULAR. */
+
+klu_batch_numeric *klu_batch_factor
+(
+    /* inputs, not modified */
+    int Ap [ ],         /* size n+1, column pointers */
+    int Ai [ ],         /* size nz, row indices */
+    double Ax [ ],      /* size ldx*nbatch.  Ax [b*ldx ... b*ldx+nz-1] are the
+                         * numerical values of matrix b */
+    int ldx,            /* leading dimension of Ax, >= nz */
+    int nbatch,         /* number of matrices */
+    klu_symbolic *Symbolic,
+    klu_common *Common
+) ;
+
+klu_batch_numeric *klu_z_batch_factor (int *, int *, double *, int, int,
+    klu_symbolic *, klu_common *) ;
+
+klu_l_batch_numeric *klu_l_batch_factor (SuiteSparse_long *,
+    SuiteSparse_long *, double *, SuiteSparse_long, SuiteSparse_long,
+    klu_l_symbolic *, klu_l_common *) ;
+
+klu_l_batch_numeric *klu_zl_batch_factor (SuiteSparse_long *,
+    SuiteSparse_long *, double *, SuiteSparse_long, SuiteSparse_long,
+    klu_l_symbolic *, klu_l_common *) ;
+
+int klu_batch_refactor      /* return TRUE if successful, FALSE otherwise */
+(
+    /* inputs, not modified */
+    int Ap [ ],         /* size n+1, column pointers */
+    int Ai [ ],         /* size nz, row indices */
+    double Ax [ ],      /* size ldx*nbatch, numerical values */
+    int ldx,            /* leading dimension of Ax, >= nz */
+    klu_symbolic *Symbolic,
+    /* input, and numerical values modified on output */
+    klu_batch_numeric *Batch,
+    klu_common *Common
+) ;
+
+int klu_z_batch_refactor (int *, int *, double *, int, klu_symbolic *,
+    klu_batch_numeric *, klu_common *) ;
+
+SuiteSparse_long klu_l_batch_refactor (SuiteSparse_long *, SuiteSparse_long *,
+    double *, SuiteSparse_long, klu_l_symbolic *, klu_l_batch_numeric *,
+    klu_l_common *) ;
+
+SuiteSparse_long klu_zl_batch_refactor (SuiteSparse_long *, SuiteSparse_long *,
+    double *, SuiteSparse_long, klu_l_symbolic *, klu_l_batch_numeric *,
+    klu_l_common *) ;
+
+int klu_batch_solve
+(
+    /* inputs, not modified */
+    klu_symbolic *Symbolic,
+    klu_batch_numeric *Batch,
+    int ldim,               /* leading dimension of B */
+
+    /* right-hand-sides on input, overwritten with the solutions on output.
+     * Column b is the right-hand-side for matrix b. */
+    double B [ ],           /* size ldim*nbatch */
+    klu_common *Common
+) ;
+
+int klu_z_batch_solve (klu_symbolic *, klu_batch_numeric *, int, double *,
+    klu_common *) ;
+
+SuiteSparse_long klu_l_batch_solve (klu_l_symbolic *, klu_l_batch_numeric *,
+    SuiteSparse_long, double *, klu_l_common *) ;
+
+SuiteSparse_long klu_zl_batch_solve (klu_l_symbolic *, klu_l_batch_numeric *,
+    SuiteSparse_long, double *, klu_l_common *) ;
+
+int klu_batch_free_numeric
+(
+    klu_batch_numeric **Batch,
+    klu_common *Common
+) ;
+
+int klu_z_batch_free_numeric (klu_batch_numeric **, klu_common *) ;
+
+SuiteSparse_long klu_l_batch_free_numeric (klu_l_batch_numeric **,
+    klu_l_common *) ;
+
+SuiteSparse_long klu_zl_batch_free_numeric (klu_l_batch_numeric **,
+    klu_l_common *) ;
+
+
 /* -------------------------------------------------------------------------- */
 /* klu_sort: sorts the columns of the LU factorization */
 /* -------------------------------------------------------------------------- */
@@ -110,13 +110,16 @@ size_t KLU_kernel   /* final size of LU on output */
     /* workspace for pruning only */
     Int Lpend [ ],      /* size n workspace */
 
+    /* workspace for dense panels only */
+    Int Super [ ],      /* size n workspace, or NULL if no dense panels */
+
     /* inputs, not modified on output */
     Int k1,             /* the block of A is from k1 to k2-1 */
     Int PSinv [ ],      /* inverse of P from symbolic factorization */
     double Rs [ ],      /* scale factors for A */
 
     /* inputs, modified on output */
-    Int Offp [ ],   /* off-diagonal matrix (modified by this routine) */
+    Int Offp [ ],   /* off-diagonal col pointers of the block, size n+1 */
     Int Offi [ ],
     Entry Offx [ ],
     KLU_common *Common  /* the control input/output structure */
@@ -154,7 +157,7 @@ size_t KLU_kernel_factor            /* 0 if failure, size of LU if OK */
     double Rs [ ],      /* scale factors for A */
 
     /* inputs, modified on output */
-    Int Offp [ ],   /* off-diagonal matrix (modified by this routine) */
+    Int Offp [ ],   /* off-diagonal col pointers of the block, size n+1 */
     Int Offi [ ],
     Entry Offx [ ],
     KLU_common *Common  /* the control input/output structure */
@@ -240,4 +243,62 @@ size_t KLU_mult_size_t (size_t a, size_t k, Int *ok) ;
 
 KLU_symbolic *KLU_alloc_symbolic (Int n, Int *Ap, Int *Ai, KLU_common *Common) ;
 
+Int KLU_metis (Int n, Int Cp [ ], Int Ci [ ], Int Perm [ ], double *lnz,
+    double *flops, KLU_common *Common) ;
+
+Int KLU_nthreads (Int nwork, KLU_common *Common) ;
+
+void KLU_thread_common (Int nthreads, KLU_common Tc [ ], KLU_common *Common) ;
+
+void KLU_merge_common (Int nthreads, KLU_common Tc [ ], KLU_common *Common) ;
+
+/* memory arena (see klu_arena.c) */
+
+#define KLU_ARENA_NBINS 64
+
+typedef union klu_arena_header_union
+{
+    struct
+    {
+        size_t size ;   /* size of the block, in bytes, excl. the header */
+        union klu_arena_header_union *next ;    /* next free block in a bin */
+    } h ;
+    double align [2] ;  /* keeps the blocks aligned for Double_Complex */
+
+} klu_arena_header ;
+
+typedef struct klu_arena_struct
+{
+    klu_arena_header *bin [KLU_ARENA_NBINS] ;   /* bin [b] holds the free
+                                 * blocks of size 2^b to 2^(b+1)-1 bytes */
+    size_t inuse ;              /* bytes in blocks in use */
+    size_t retained ;           /* bytes in free blocks */
+    size_t peak ;               /* peak of inuse + retained */
+    size_t nmalloc ;            /* # of blocks obtained from malloc */
+
+} klu_arena ;
+
+void *KLU_arena_malloc (size_t size, KLU_common *Common) ;
+
+void KLU_arena_free (void *p, KLU_common *Common) ;
+
+void *KLU_arena_realloc (size_t size, size_t keep, void *p, Int *ok,
+    KLU_common *Common) ;
+
+void KLU_arena_stats (KLU_common *Common) ;
+
+Int KLU_mixed_demote (Int Ap [ ], Int Ai [ ], Entry Ax [ ],
+    KLU_symbolic *Symbolic, KLU_numeric *Numeric, KLU_common *Common) ;
+
+Int KLU_mixed_refactor_block (Int block, Int Ap [ ], Int Ai [ ], Entry Az [ ],
+    KLU_symbolic *Symbolic, KLU_numeric *Numeric, Entry X [ ],
+    KLU_common *Common) ;
+
+Int KLU_mixed_solve (KLU_symbolic *Symbolic, KLU_numeric *Numeric, Int d,
+    Int nrhs, double B [ ], Int transpose,
+#ifdef COMPLEX
+    Int conj_solve,
+#endif
+    KLU_common *Common) ;
+
 #endif
@@ -36,6 +36,15 @@
     Xx = (Entry *) (xp + UNITS (Int, xlen)) ; \
 }
 
+/* same as GET_POINTER, for L and U held in single precision (SEntry) */
+#define GET_S_POINTER(LU, Xip, Xlen, Xi, Xs, k, xlen) \
+{ \
+    Unit *xp = LU + Xip [k] ; \
+    xlen = Xlen [k] ; \
+    Xi = (Int *) xp ; \
+    Xs = (SEntry *) (xp + UNITS (Int, xlen)) ; \
+}
+
 /* function names */
 #ifdef COMPLEX 
 
@@ -44,6 +53,15 @@
 #define KLU_scale klu_zl_scale
 #define KLU_solve klu_zl_solve
 #define KLU_tsolve klu_zl_tsolve
+#define KLU_solve_multi klu_zl_solve_multi
+#define KLU_tsolve_multi klu_zl_tsolve_multi
+#define KLU_batch_factor klu_zl_batch_factor
+#define KLU_batch_refactor klu_zl_batch_refactor
+#define KLU_batch_solve klu_zl_batch_solve
+#define KLU_batch_free_numeric klu_zl_batch_free_numeric
+#define KLU_mixed_demote klu_zl_mixed_demote
+#define KLU_mixed_refactor_block klu_zl_mixed_refactor_block
+#define KLU_mixed_solve klu_zl_mixed_solve
 #define KLU_free_numeric klu_zl_free_numeric
 #define KLU_factor klu_zl_factor
 #define KLU_refactor klu_zl_refactor
@@ -67,6 +85,15 @@
 #define KLU_scale klu_z_scale
 #define KLU_solve klu_z_solve
 #define KLU_tsolve klu_z_tsolve
+#define KLU_solve_multi klu_z_solve_multi
+#define KLU_tsolve_multi klu_z_tsolve_multi
+#define KLU_batch_factor klu_z_batch_factor
+#define KLU_batch_refactor klu_z_batch_refactor
+#define KLU_batch_solve klu_z_batch_solve
+#define KLU_batch_free_numeric klu_z_batch_free_numeric
+#define KLU_mixed_demote klu_z_mixed_demote
+#define KLU_mixed_refactor_block klu_z_mixed_refactor_block
+#define KLU_mixed_solve klu_z_mixed_solve
 #define KLU_free_numeric klu_z_free_numeric
 #define KLU_factor klu_z_factor
 #define KLU_refactor klu_z_refactor
@@ -94,6 +121,15 @@
 #define KLU_scale klu_l_scale
 #define KLU_solve klu_l_solve
 #define KLU_tsolve klu_l_tsolve
+#define KLU_solve_multi klu_l_solve_multi
+#define KLU_tsolve_multi klu_l_tsolve_multi
+#define KLU_batch_factor klu_l_batch_factor
+#define KLU_batch_refactor klu_l_batch_refactor
+#define KLU_batch_solve klu_l_batch_solve
+#define KLU_batch_free_numeric klu_l_batch_free_numeric
+#define KLU_mixed_demote klu_l_mixed_demote
+#define KLU_mixed_refactor_block klu_l_mixed_refactor_block
+#define KLU_mixed_solve klu_l_mixed_solve
 #define KLU_free_numeric klu_l_free_numeric
 #define KLU_factor klu_l_factor
 #define KLU_refactor klu_l_refactor
@@ -117,6 +153,15 @@
 #define KLU_scale klu_scale
 #define KLU_solve klu_solve
 #define KLU_tsolve klu_tsolve
+#define KLU_solve_multi klu_solve_multi
+#define KLU_tsolve_multi klu_tsolve_multi
+#define KLU_batch_factor klu_batch_factor
+#define KLU_batch_refactor klu_batch_refactor
+#define KLU_batch_solve klu_batch_solve
+#define KLU_batch_free_numeric klu_batch_free_numeric
+#define KLU_mixed_demote klu_mixed_demote
+#define KLU_mixed_refactor_block klu_mixed_refactor_block
+#define KLU_mixed_solve klu_mixed_solve
 #define KLU_free_numeric klu_free_numeric
 #define KLU_factor klu_factor
 #define KLU_refactor klu_refactor
@@ -152,9 +197,21 @@
 #define KLU_realloc klu_l_realloc
 #define KLU_add_size_t klu_l_add_size_t
 #define KLU_mult_size_t klu_l_mult_size_t
+#define KLU_metis klu_l_metis
+#define KLU_nthreads klu_l_nthreads
+#define KLU_thread_common klu_l_thread_common
+#define KLU_merge_common klu_l_merge_common
+#define KLU_arena_start klu_l_arena_start
+#define KLU_arena_trim klu_l_arena_trim
+#define KLU_arena_finish klu_l_arena_finish
+#define KLU_arena_malloc klu_l_arena_malloc
+#define KLU_arena_free klu_l_arena_free
+#define KLU_arena_realloc klu_l_arena_realloc
+#define KLU_arena_stats klu_l_arena_stats
 
 #define KLU_symbolic klu_l_symbolic
 #define KLU_numeric klu_l_numeric
+#define KLU_batch_numeric klu_l_batch_numeric
 #define KLU_common klu_l_common
 
 #define BTF_order btf_l_order
@@ -176,9 +233,21 @@
 #define KLU_realloc klu_realloc
 #define KLU_add_size_t klu_add_size_t
 #define KLU_mult_size_t klu_mult_size_t
+#define KLU_metis klu_metis
+#define KLU_nthreads klu_nthreads
+#define KLU_thread_common klu_thread_common
+#define KLU_merge_common klu_merge_common
+#define KLU_arena_start klu_arena_start
+#define KLU_arena_trim klu_arena_trim
+#define KLU_arena_finish klu_arena_finish
+#define KLU_arena_malloc klu_arena_malloc
+#define KLU_arena_free klu_arena_free
+#define KLU_arena_realloc klu_arena_realloc
+#define KLU_arena_stats klu_arena_stats
 
 #define KLU_symbolic klu_symbolic
 #define KLU_numeric klu_numeric
+#define KLU_batch_numeric klu_batch_numeric
 #define KLU_common klu_common
 
 #define BTF_order btf_order
@@ -252,6 +321,7 @@ SCALAR_IS_LTZERO(x):
 
 typedef double Unit ;
 #define Entry double
+#define SEntry float
 
 #define SPLIT(s)                    (1)
 #define REAL(c)                     (c)
@@ -279,6 +349,8 @@ typedef double Unit ;
 #define ABS(s,a)                    { (s) = SCALAR_ABS (a) ; }
 #define PRINT_ENTRY(a)              PRINT_SCALAR (a)
 #define CONJ(a,x)                   a = x
+#define TO_SINGLE(s,c)              { (s) = (float) (c) ; }
+#define TO_DOUBLE(c,s)              { (c) = (double) (s) ; }
 
 /* for flop counts */
 #define MULTSUB_FLOPS   2.      /* c -= a*b */
@@ -325,8 +397,15 @@ typedef struct
 
 } Double_Complex ;
 
+typedef struct
+{
+    float component [2] ;       /* real and imaginary parts, single precision */
+
+} Single_Complex ;
+
 typedef Double_Complex Unit ;
 #define Entry Double_Complex
+#define SEntry Single_Complex
 #define Real component [0]
 #define Imag component [1]
 
@@ -689,6 +768,22 @@ typedef Double_Complex Unit ;
 
 /* -------------------------------------------------------------------------- */
 
+/* s = c, rounded to single precision */
+#define TO_SINGLE(s,c) \
+{ \
+    (s).Real = (float) (c).Real ; \
+    (s).Imag = (float) (c).Imag ; \
+}
+
+/* c = s, with s in single precision */
+#define TO_DOUBLE(c,s) \
+{ \
+    (c).Real = (double) (s).Real ; \
+    (c).Imag = (double) (s).Imag ; \
+}
+
+/* -------------------------------------------------------------------------- */
+
 #endif  /* #ifndef COMPLEX */
 
 #endif
@@ -91,7 +91,7 @@ size_t KLU_kernel_factor            /* 0 if failure, size of LU if OK */
     double Rs [ ],      /* scale factors for A */
 
     /* inputs, modified on output */
-    Int Offp [ ],   /* off-diagonal matrix (modified by this routine) */
+    Int Offp [ ],   /* off-diagonal col pointers of the block, size n+1 */
     Int Offi [ ],
     Entry Offx [ ],
     /* --------------- */
@@ -100,7 +100,7 @@ size_t KLU_kernel_factor            /* 0 if failure, size of LU if OK */
 {
     double maxlnz, dunits ;
     Unit *LU ;
-    Int *Pinv, *Lpend, *Stack, *Flag, *Ap_pos, *W ;
+    Int *Pinv, *Lpend, *Stack, *Flag, *Ap_pos, *Super, *W ;
     Int lsize, usize, anz, ok ;
     size_t lusize ;
     ASSERT (Common != NULL) ;
@@ -164,6 +164,20 @@ size_t KLU_kernel_factor            /* 0 if failure, size of LU if OK */
         return (lusize) ;
     }
 
+    /* dense panels need one more workspace array */
+    Super = NULL ;
+    if (Common->panel_density > 0 && n > 1)
+    {
+        Super = KLU_malloc (n, sizeof (Int), Common) ;
+        if (Super == NULL)
+        {
+            LU = KLU_free (LU, lusize, sizeof (Unit), Common) ;
+            Common->status = KLU_OUT_OF_MEMORY ;
+            lusize = 0 ;
+            return (lusize) ;
+        }
+    }
+
     /* ---------------------------------------------------------------------- */
     /* factorize */
     /* ---------------------------------------------------------------------- */
@@ -171,8 +185,9 @@ size_t KLU_kernel_factor            /* 0 if failure, size of LU if OK */
     /* with pruning, and non-recursive depth-first-search */
     lusize = KLU_kernel (n, Ap, Ai, Ax, Q, lusize,
             Pinv, P, &LU, Udiag, Llen, Ulen, Lip, Uip, lnz, unz,
-            X, Stack, Flag, Ap_pos, Lpend,
+            X, Stack, Flag, Ap_pos, Lpend, Super,
             k1, PSinv, Rs, Offp, Offi, Offx, Common) ;
+    Super = KLU_free (Super, n, sizeof (Int), Common) ;
 
     /* ---------------------------------------------------------------------- */
     /* return LU factors, or return nothing if an error occurred */
@@ -2,7 +2,7 @@
 /* === klu_analyze ========================================================== */
 /* ========================================================================== */
 
-/* Order the matrix using BTF (or not), and then AMD, COLAMD, the natural
+/* Order the matrix using BTF (or not), and then AMD, COLAMD, METIS, the natural
  * ordering, or the user-provided-function on the blocks.  Does not support
  * using a given ordering (use klu_analyze_given for that case). */
 
@@ -22,7 +22,8 @@ static Int analyze_worker       /* returns KLU_OK or < 0 if error */
     Int Pbtf [ ],       /* BTF row permutation */
     Int Qbtf [ ],       /* BTF col permutation */
     Int R [ ],          /* size n+1, but only Rbtf [0..nblocks] is used */
-    Int ordering,       /* what ordering to use (0, 1, or 3 for this routine) */
+    Int ordering,       /* what ordering to use (0, 1, 3, or 4 for this
+                         * routine) */
 
     /* output only, not defined on input */
     Int P [ ],          /* size n */
@@ -140,7 +141,7 @@ static Int analyze_worker       /* returns KLU_OK or < 0 if error */
             ok = TRUE ;
 
         }
-        else if (ordering == 0)
+        else if (ordering == 0 || (ordering == 4 && nk < Common->nd_threshold))
         {
 
             /* -------------------------------------------------------------- */
@@ -189,6 +190,17 @@ static Int analyze_worker       /* returns KLU_OK or < 0 if error */
                 Pblk [k] = Cp [k] ;
             }
 
+        }
+        else if (ordering == 4)
+        {
+
+            /* -------------------------------------------------------------- */
+            /* order the block with METIS nested dissection (C+C') */
+            /* -------------------------------------------------------------- */
+
+            err = KLU_metis (nk, Cp, Ci, Pblk, &lnz1, &flops1, Common) ;
+            ok = (err == KLU_OK) ;
+
         }
         else
         {
@@ -251,7 +263,7 @@ static Int analyze_worker       /* returns KLU_OK or < 0 if error */
 /* ========================================================================== */
 
 /* Orders the matrix with or with BTF, then orders each block with AMD, COLAMD,
- * or the user ordering function.  Does not handle the natural or given
+ * METIS, or the user ordering function.  Does not handle the natural or given
  * ordering cases. */
 
 static KLU_symbolic *order_and_analyze  /* returns NULL if error, or a valid
@@ -293,9 +305,10 @@ static KLU_symbolic *order_and_analyze  /* returns NULL if error, or a valid
         /* COLAMD */
         Cilen = COLAMD_recommended (nz, n, n) ;
     }
-    else if (ordering == 0 || (ordering == 3 && Common->user_order != NULL))
+    else if (ordering == 0 || ordering == 4 ||
+            (ordering == 3 && Common->user_order != NULL))
     {
-        /* AMD or user ordering function */
+        /* AMD, METIS, or user ordering function */
         Cilen = nz+1 ;
     }
     else
@@ -0,0 +1,405 @@
+/* ========================================================================== */
+/* === KLU_arena ============================================================ */
+/* ========================================================================== */
+
+/* Memory arena for KLU (see klu_arena_start in klu.h).  When Common->arena is
+ * not NULL, KLU_malloc, KLU_free, and KLU_realloc get their memory from it.
+ *
+ * Each block obtained from malloc has a header that holds its size.  A block
+ * that is freed is kept in a bin according to its size: bin [b] holds the
+ * blocks of size 2^b to 2^(b+1)-1 bytes.  A request for s bytes takes the
+ * smallest free block of at least s bytes from the bin of s, or else a block
+ * of at most 2s bytes from the next bin.  Otherwise a new block of s bytes is
+ * obtained from malloc.  The blocks are never split or merged.
+ *
+ * The factorization frees and allocates the same sizes from one cycle to the
+ * next, so once the first cycle is done the requests are all met from the
+ * bins.  The LU factors grow with KLU_realloc while they are computed; the
+ * blocks they grow through are retained as well, and are reused in the same
+ * order by the next factorization.
+ *
+ * If KLU is compiled with OpenMP, the arena is locked while it is used, since
+ * klu_factor and klu_refactor may allocate memory in several threads at once
+ * (each with its own copy of Common, and the same arena).
+ *
+ * User-callable:
+ *
+ * KLU_arena_start          attach a new arena to Common
+ * KLU_arena_trim           free the blocks held for reuse
+ * KLU_arena_finish         free the arena and detach it from Common
+ *
+ * Internal:
+ *
+ * KLU_arena_malloc         malloc from the arena
+ * KLU_arena_free           return a block to the arena
+ * KLU_arena_realloc        realloc from the arena
+ * KLU_arena_stats          copy the statistics of the arena into Common
+ */
+
+#include "klu_internal.h"
+#include <string.h>
+
+#define HEADER sizeof (klu_arena_header)
+
+/* ========================================================================== */
+/* === get_bin ============================================================== */
+/* ========================================================================== */
+
+/* floor (log2 (size)), for size > 0 */
+
+static Int get_bin (size_t size)
+{
+    Int b = 0 ;
+    while (size > 1)
+    {
+        size >>= 1 ;
+        b++ ;
+    }
+    return (b) ;
+}
+
+/* ========================================================================== */
+/* === take ================================================================= */
+/* ========================================================================== */
+
+/* Remove and return the smallest free block in bin b of at least size and at
+ * most maxsize bytes, or NULL if there is none. */
+
+static klu_arena_header *take
+(
+    klu_arena *Arena,
+    Int b,
+    size_t size,
+    size_t maxsize
+)
+{
+    klu_arena_header *h, **hp, **best ;
+
+    best = NULL ;
+    for (hp = &(Arena->bin [b]) ; *hp != NULL ; hp = &((*hp)->h.next))
+    {
+        h = *hp ;
+        if (h->h.size >= size && h->h.size <= maxsize &&
+            (best == NULL || h->h.size < (*best)->h.size))
+        {
+            best = hp ;
+            if (h->h.size == size)
+            {
+                break ;
+            }
+        }
+    }
+    if (best == NULL)
+    {
+        return (NULL) ;
+    }
+    h = *best ;
+    *best = h->h.next ;
+    Arena->retained -= h->h.size ;
+    return (h) ;
+}
+
+/* ========================================================================== */
+/* === arena_malloc ========================================================= */
+/* ========================================================================== */
+
+/* Get a block of size bytes, from a bin or from malloc.  Returns NULL if out
+ * of memory.  The arena must be locked. */
+
+static void *arena_malloc
+(
+    klu_arena *Arena,
+    size_t size
+)
+{
+    klu_arena_header *h ;
+    Int b, ok = TRUE ;
+
+    size = MAX (size, 1) ;
+    b = get_bin (size) ;
+    h = take (Arena, b, size, (size_t) -1) ;
+    if (h == NULL && b+1 < KLU_ARENA_NBINS)
+    {
+        h = take (Arena, b+1, size, (size <= ((size_t) -1) / 2) ?
+            (2 * size) : ((size_t) -1)) ;
+    }
+    if (h == NULL)
+    {
+        /* no suitable block in the bins; get one from malloc */
+        size_t s = KLU_add_size_t (size, HEADER, &ok) ;
+        h = ok ? SuiteSparse_malloc (1, s) : NULL ;
+        if (h == NULL)
+        {
+            return (NULL) ;
+        }
+        h->h.size = size ;
+        Arena->nmalloc++ ;
+    }
+    h->h.next = NULL ;
+    Arena->inuse += h->h.size ;
+    Arena->peak = MAX (Arena->peak, Arena->inuse + Arena->retained) ;
+    return ((void *) (h + 1)) ;
+}
+
+/* ========================================================================== */
+/* === arena_free =========================================================== */
+/* ========================================================================== */
+
+/* Put a block back in its bin.  The arena must be locked. */
+
+static void arena_free
+(
+    klu_arena *Arena,
+    void *p
+)
+{
+    klu_arena_header *h ;
+    Int b ;
+
+    h = ((klu_arena_header *) p) - 1 ;
+    b = get_bin (h->h.size) ;
+    h->h.next = Arena->bin [b] ;
+    Arena->bin [b] = h ;
+    Arena->inuse -= h->h.size ;
+    Arena->retained += h->h.size ;
+}
+
+/* ========================================================================== */
+/* === KLU_arena_stats ====================================================== */
+/* ========================================================================== */
+
+void KLU_arena_stats
+(
+    KLU_common *Common
+)
+{
+    klu_arena *Arena = (klu_arena *) Common->arena ;
+    if (Arena != NULL)
+    {
+        Common->arena_retained = Arena->retained ;
+        Common->arena_peak = Arena->peak ;
+        Common->arena_nmalloc = Arena->nmalloc ;
+    }
+}
+
+/* ========================================================================== */
+/* === KLU_arena_malloc ===================================================== */
+/* ========================================================================== */
+
+/* Returns a block of size bytes from the arena of Common, or NULL if out of
+ * memory.  Does not modify Common->status or Common->memusage. */
+
+void *KLU_arena_malloc
+(
+    size_t size,
+    KLU_common *Common
+)
+{
+    void *p ;
+#ifdef _OPENMP
+    #pragma omp critical (klu_arena)
+#endif
+    {
+        p = arena_malloc ((klu_arena *) Common->arena, size) ;
+        KLU_arena_stats (Common) ;
+    }
+    return (p) ;
+}
+
+/* ========================================================================== */
+/* === KLU_arena_free ======================================================= */
+/* ========================================================================== */
+
+/* Returns the block p, obtained from KLU_arena_malloc or KLU_arena_realloc,
+ * to the arena of Common. */
+
+void KLU_arena_free
+(
+    void *p,
+    KLU_common *Common
+)
+{
+#ifdef _OPENMP
+    #pragma omp critical (klu_arena)
+#endif
+    {
+        arena_free ((klu_arena *) Common->arena, p) ;
+        KLU_arena_stats (Common) ;
+    }
+}
+
+/* ========================================================================== */
+/* === KLU_arena_realloc ==================================================== */
+/* ========================================================================== */
+
+/* Changes the size of the block p to size bytes, keeping its first keep
+ * bytes.  The block is left where it is if it is large enough, unless it is
+ * more than twice as large as needed.  On failure, p is returned unchanged
+ * and ok is set to FALSE. */
+
+void *KLU_arena_realloc
+(
+    size_t size,
+    size_t keep,
+    void *p,
+    Int *ok,
+    KLU_common *Common
+)
+{
+    klu_arena *Arena ;
+    void *pnew ;
+    size_t psize ;
+
+    Arena = (klu_arena *) Common->arena ;
+    psize = (((klu_arena_header *) p) - 1)->h.size ;
+    if (size <= psize && size >= psize / 2)
+    {
+        /* the block is large enough, and not too large */
+        return (p) ;
+    }
+#ifdef _OPENMP
+    #pragma omp critical (klu_arena)
+#endif
+    {
+        pnew = arena_malloc (Arena, size) ;
+        if (pnew != NULL)
+        {
+            memcpy (pnew, p, MIN (keep, MIN (size, psize))) ;
+            arena_free (Arena, p) ;
+        }
+        KLU_arena_stats (Common) ;
+    }
+    if (pnew == NULL)
+    {
+        (*ok) = FALSE ;
+        return (p) ;
+    }
+    return (pnew) ;
+}
+
+
+/* ========================================================================== */
+/* === KLU_arena_start ====================================================== */
+/* ========================================================================== */
+
+/* Attach a new, empty arena to Common.  Returns TRUE if successful, FALSE
+ * otherwise.  Fails with KLU_INVALID if Common already has an arena. */
+
+Int KLU_arena_start
+(
+    KLU_common *Common
+)
+{
+    klu_arena *Arena ;
+    Int b ;
+
+    if (Common == NULL)
+    {
+        return (FALSE) ;
+    }
+    if (Common->arena != NULL)
+    {
+        Common->status = KLU_INVALID ;
+        return (FALSE) ;
+    }
+    Arena = SuiteSparse_malloc (1, sizeof (klu_arena)) ;
+    if (Arena == NULL)
+    {
+        Common->status = KLU_OUT_OF_MEMORY ;
+        return (FALSE) ;
+    }
+    for (b = 0 ; b < KLU_ARENA_NBINS ; b++)
+    {
+        Arena->bin [b] = NULL ;
+    }
+    Arena->inuse = 0 ;
+    Arena->retained = 0 ;
+    Arena->peak = 0 ;
+    Arena->nmalloc = 0 ;
+    Common->arena = Arena ;
+    KLU_arena_stats (Common) ;
+    Common->status = KLU_OK ;
+    return (TRUE) ;
+}
+
+
+/* ========================================================================== */
+/* === KLU_arena_trim ======================================================= */
+/* ========================================================================== */
+
+/* Free all the blocks held by the arena for reuse.  The blocks in use are not
+ * affected.  Returns TRUE if successful, FALSE otherwise. */
+
+Int KLU_arena_trim
+(
+    KLU_common *Common
+)
+{
+    klu_arena *Arena ;
+    klu_arena_header *h, *next ;
+    Int b ;
+
+    if (Common == NULL)
+    {
+        return (FALSE) ;
+    }
+    Arena = (klu_arena *) Common->arena ;
+    if (Arena == NULL)
+    {
+        Common->status = KLU_INVALID ;
+        return (FALSE) ;
+    }
+    for (b = 0 ; b < KLU_ARENA_NBINS ; b++)
+    {
+        for (h = Arena->bin [b] ; h != NULL ; h = next)
+        {
+            next = h->h.next ;
+            SuiteSparse_free (h) ;
+        }
+        Arena->bin [b] = NULL ;
+    }
+    Arena->retained = 0 ;
+    KLU_arena_stats (Common) ;
+    Common->status = KLU_OK ;
+    return (TRUE) ;
+}
+
+
+/* ========================================================================== */
+/* === KLU_arena_finish ===================================================== */
+/* ========================================================================== */
+
+/* Free the arena and detach it from Common.  Returns TRUE if successful,
+ * FALSE otherwise.  Fails with KLU_INVALID (and leaves the arena attached) if
+ * any block of the arena is still in use. */
+
+Int KLU_arena_finish
+(
+    KLU_common *Common
+)
+{
+    klu_arena *Arena ;
+
+    if (Common == NULL)
+    {
+        return (FALSE) ;
+    }
+    Arena = (klu_arena *) Common->arena ;
+    if (Arena == NULL)
+    {
+        /* nothing to do */
+        Common->status = KLU_OK ;
+        return (TRUE) ;
+    }
+    if (Arena->inuse > 0)
+    {
+        /* some objects allocated from the arena have not been freed */
+        Common->status = KLU_INVALID ;
+        return (FALSE) ;
+    }
+    KLU_arena_trim (Common) ;
+    SuiteSparse_free (Arena) ;
+    Common->arena = NULL ;
+    Common->arena_retained = 0 ;
+    return (TRUE) ;
+}
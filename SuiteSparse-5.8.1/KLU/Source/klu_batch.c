@@ -0,0 +1,956 @@
+/* ========================================================================== */
+/* === KLU_batch ============================================================ */
+/* ========================================================================== */
+
+/* Factor and solve a batch of matrices that all have the same pattern, using
+ * a single Symbolic object.
+ *
+ * KLU_batch_factor:  factors the first matrix of the batch with KLU_factor,
+ *      and then all of them (including the first) with its pivot ordering,
+ *      as KLU_refactor would.  No pivoting is done for the other matrices,
+ *      so the batch should consist of matrices whose values are close enough
+ *      for the pivot ordering of the first one to remain stable.
+ * KLU_batch_refactor:  refactors a new batch of matrices with the pivot
+ *      ordering of the prior KLU_batch_factor.
+ * KLU_batch_solve:  solves A_b*x_b = b_b for each matrix A_b of the batch.
+ * KLU_batch_free_numeric:  frees the Batch object.
+ *
+ * The values of the factors of the whole batch are held in one array.  The
+ * matrices are taken in groups of KLU_BATCH_WIDTH, and within a group the
+ * values of one entry of the factors of all the matrices are contiguous.  The
+ * innermost loops of the factorization and the solve then run over the
+ * matrices of a group with unit stride and a constant trip count, so that
+ * they can be vectorized, while the indices of the factors are read once per
+ * group.  The last group is padded with copies of the last matrix.  If KLU is
+ * compiled with OpenMP and Common->nthreads > 1, the groups are processed
+ * concurrently.
+ *
+ * A zero pivot in any matrix of the batch sets Common->status to
+ * KLU_SINGULAR, and Common->numerical_rank to the first column in which a
+ * zero pivot was found in any of the matrices.  The other matrices are not
+ * affected.  The whole batch is always factorized; if Common->halt_if_singular
+ * is true, KLU_batch_factor then fails and KLU_batch_refactor returns FALSE.
+ */
+
+#include "klu_internal.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#define NB KLU_BATCH_WIDTH
+
+/* ========================================================================== */
+/* === mult_sub_group ======================================================= */
+/* ========================================================================== */
+
+/* X [b] -= A [b] * x [b] for all matrices b of a group.  All of X is read
+ * before it is written, so that the compiler can vectorize this without
+ * checking whether X overlaps A or x. */
+
+static void mult_sub_group
+(
+    Entry X [ ],
+    Entry A [ ],
+    Entry x [ ]
+)
+{
+    Entry y [NB] ;
+    Int b ;
+
+    for (b = 0 ; b < NB ; b++)
+    {
+        y [b] = X [b] ;
+        MULT_SUB (y [b], A [b], x [b]) ;
+    }
+    for (b = 0 ; b < NB ; b++)
+    {
+        X [b] = y [b] ;
+    }
+}
+
+/* ========================================================================== */
+/* === refactor_group ======================================================= */
+/* ========================================================================== */
+
+/* Refactorize the matrices of group g, with the pattern and pivot ordering of
+ * Batch->Numeric.  Ax holds the values of the batch, the values of matrix b
+ * are Ax [b*ldx ... b*ldx+nz-1]. */
+
+static void refactor_group
+(
+    /* inputs, not modified */
+    Int g,              /* the group to refactorize */
+    Int Ap [ ],         /* size n+1, column pointers */
+    Int Ai [ ],         /* size nz, row indices */
+    Entry Az [ ],       /* values of the batch */
+    Int ldx,            /* leading dimension of Az */
+    KLU_symbolic *Symbolic,
+
+    /* input/output */
+    KLU_batch_numeric *Batch,
+
+    /* workspace */
+    Entry X [ ],        /* size maxblock*NB, zero on input and output */
+    double Rt [ ],      /* size n*NB, not used if no scaling */
+    double Rw [ ],      /* size n, not used if no scaling */
+    KLU_common *Common
+)
+{
+    Entry ukk [NB], ujk [NB], s [NB] ;
+    Entry *A [NB], *Gx, *Ux, *Lx, *Udiag, *Offx, *Xj, *Xi, *Xo ;
+    double *Rs, *Rg ;
+    KLU_numeric *Numeric ;
+    Int *Q, *R, *Ui, *Li, *Pinv, *Pnum, *Lip, *Uip, *Llen, *Ulen, *Lxp, *Uxp ;
+    Unit *LU ;
+    Int n, k1, k2, nk, k, oldcol, pend, oldrow, p, newrow, scale, poff, i, j,
+        up, ulen, llen, nzoff, nblocks, block, b, singular ;
+
+    Numeric = Batch->Numeric ;
+    n = Symbolic->n ;
+    Q = Symbolic->Q ;
+    R = Symbolic->R ;
+    nblocks = Symbolic->nblocks ;
+    nzoff = Symbolic->nzoff ;
+    Pinv = Numeric->Pinv ;
+    Pnum = Numeric->Pnum ;
+    Lip  = Numeric->Lip ;
+    Llen = Numeric->Llen ;
+    Uip  = Numeric->Uip ;
+    Ulen = Numeric->Ulen ;
+    Lxp = Batch->Lxp ;
+    Uxp = Batch->Uxp ;
+    scale = Common->scale ;
+
+    /* ---------------------------------------------------------------------- */
+    /* get the matrices of the group and their scale factors */
+    /* ---------------------------------------------------------------------- */
+
+    for (b = 0 ; b < NB ; b++)
+    {
+        A [b] = Az + ldx * MIN (g*NB + b, Batch->nbatch - 1) ;
+    }
+
+    Gx = ((Entry *) Batch->LUx) + Batch->groupsize * g ;
+    Udiag = Gx + Batch->nzlu * NB ;
+    Offx = Udiag + n * NB ;
+
+    Rs = NULL ;
+    if (scale > 0)
+    {
+        Rs = Batch->Rs + n * NB * g ;
+        for (b = 0 ; b < NB ; b++)
+        {
+            if (!KLU_scale (scale, n, Ap, Ai, (double *) A [b], Rw, NULL,
+                Common))
+            {
+                return ;
+            }
+            for (i = 0 ; i < n ; i++)
+            {
+                Rt [i*NB + b] = Rw [i] ;
+            }
+        }
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* factor each block */
+    /* ---------------------------------------------------------------------- */
+
+    for (block = 0 ; block < nblocks ; block++)
+    {
+
+        k1 = R [block] ;
+        k2 = R [block+1] ;
+        nk = k2 - k1 ;
+        poff = Numeric->Offp [k1] ;
+
+        if (nk == 1)
+        {
+
+            /* -------------------------------------------------------------- */
+            /* singleton case */
+            /* -------------------------------------------------------------- */
+
+            oldcol = Q [k1] ;
+            pend = Ap [oldcol+1] ;
+            for (b = 0 ; b < NB ; b++)
+            {
+                CLEAR (s [b]) ;
+            }
+            for (p = Ap [oldcol] ; p < pend ; p++)
+            {
+                oldrow = Ai [p] ;
+                newrow = Pinv [oldrow] - k1 ;
+                Xo = (newrow < 0 && poff < nzoff) ? (Offx + NB * poff++) : s ;
+                if (scale <= 0)
+                {
+                    for (b = 0 ; b < NB ; b++)
+                    {
+                        Xo [b] = A [b][p] ;
+                    }
+                }
+                else
+                {
+                    Rg = Rt + NB * oldrow ;
+                    for (b = 0 ; b < NB ; b++)
+                    {
+                        SCALE_DIV_ASSIGN (Xo [b], A [b][p], Rg [b]) ;
+                    }
+                }
+            }
+            singular = FALSE ;
+            for (b = 0 ; b < NB ; b++)
+            {
+                Udiag [k1*NB + b] = s [b] ;
+                singular = singular || IS_ZERO (s [b]) ;
+            }
+            if (singular)
+            {
+                Common->status = KLU_SINGULAR ;
+                if (Common->numerical_rank == EMPTY ||
+                    k1 < Common->numerical_rank)
+                {
+                    Common->numerical_rank = k1 ;
+                    Common->singular_col = Q [k1] ;
+                }
+            }
+            continue ;
+        }
+
+        /* ------------------------------------------------------------------ */
+        /* construct and factor the kth block */
+        /* ------------------------------------------------------------------ */
+
+        LU = ((Unit **) Numeric->LUbx) [block] ;
+
+        for (k = 0 ; k < nk ; k++)
+        {
+
+            /* -------------------------------------------------------------- */
+            /* scatter kth column of the block into workspace X */
+            /* -------------------------------------------------------------- */
+
+            oldcol = Q [k+k1] ;
+            pend = Ap [oldcol+1] ;
+            for (p = Ap [oldcol] ; p < pend ; p++)
+            {
+                oldrow = Ai [p] ;
+                newrow = Pinv [oldrow] - k1 ;
+                if (newrow < 0 && poff < nzoff)
+                {
+                    /* entry in off-diagonal block */
+                    Xo = Offx + NB * poff++ ;
+                }
+                else
+                {
+                    /* (newrow,k) is an entry in the block */
+                    Xo = X + NB * newrow ;
+                }
+                if (scale <= 0)
+                {
+                    for (b = 0 ; b < NB ; b++)
+                    {
+                        Xo [b] = A [b][p] ;
+                    }
+                }
+                else
+                {
+                    Rg = Rt + NB * oldrow ;
+                    for (b = 0 ; b < NB ; b++)
+                    {
+                        SCALE_DIV_ASSIGN (Xo [b], A [b][p], Rg [b]) ;
+                    }
+                }
+            }
+
+            /* -------------------------------------------------------------- */
+            /* compute kth column of U, and update kth column of A */
+            /* -------------------------------------------------------------- */
+
+            GET_I_POINTER (LU, Uip, Ui, k+k1) ;
+            ulen = Ulen [k+k1] ;
+            Ux = Gx + NB * Uxp [k+k1] ;
+            for (up = 0 ; up < ulen ; up++)
+            {
+                j = Ui [up] ;
+                Xj = X + NB * j ;
+                for (b = 0 ; b < NB ; b++)
+                {
+                    ujk [b] = Xj [b] ;
+                    CLEAR (Xj [b]) ;
+                    Ux [NB*up + b] = ujk [b] ;
+                }
+                GET_I_POINTER (LU, Lip, Li, j+k1) ;
+                llen = Llen [j+k1] ;
+                Lx = Gx + NB * Lxp [j+k1] ;
+                for (p = 0 ; p < llen ; p++)
+                {
+                    Xi = X + NB * Li [p] ;
+                    /* X [Li [p]] -= Lx [p] * ujk */
+                    mult_sub_group (Xi, Lx + NB*p, ujk) ;
+                }
+            }
+
+            /* get the diagonal entry of U */
+            Xj = X + NB * k ;
+            singular = FALSE ;
+            for (b = 0 ; b < NB ; b++)
+            {
+                ukk [b] = Xj [b] ;
+                CLEAR (Xj [b]) ;
+                Udiag [(k+k1)*NB + b] = ukk [b] ;
+                singular = singular || IS_ZERO (ukk [b]) ;
+            }
+            if (singular)
+            {
+                /* a matrix of the group is numerically singular */
+                Common->status = KLU_SINGULAR ;
+                if (Common->numerical_rank == EMPTY ||
+                    k+k1 < Common->numerical_rank)
+                {
+                    Common->numerical_rank = k+k1 ;
+                    Common->singular_col = Q [k+k1] ;
+                }
+            }
+
+            /* gather and divide by pivot to get kth column of L */
+            GET_I_POINTER (LU, Lip, Li, k+k1) ;
+            llen = Llen [k+k1] ;
+            Lx = Gx + NB * Lxp [k+k1] ;
+            for (p = 0 ; p < llen ; p++)
+            {
+                Xi = X + NB * Li [p] ;
+                for (b = 0 ; b < NB ; b++)
+                {
+                    DIV (Lx [NB*p + b], Xi [b], ukk [b]) ;
+                    CLEAR (Xi [b]) ;
+                }
+            }
+        }
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* permute scale factors Rs according to pivotal row order */
+    /* ---------------------------------------------------------------------- */
+
+    if (scale > 0)
+    {
+        for (k = 0 ; k < n ; k++)
+        {
+            Rg = Rt + NB * Pnum [k] ;
+            for (b = 0 ; b < NB ; b++)
+            {
+                Rs [k*NB + b] = Rg [b] ;
+            }
+        }
+    }
+}
+
+
+/* ========================================================================== */
+/* === solve_group ========================================================== */
+/* ========================================================================== */
+
+/* Solve A_b*x_b = b_b for the matrices of group g.  The right-hand-side of
+ * matrix b is column b of B, which is overwritten with the solution. */
+
+static void solve_group
+(
+    /* inputs, not modified */
+    Int g,
+    KLU_symbolic *Symbolic,
+    KLU_batch_numeric *Batch,
+    Int d,              /* leading dimension of B */
+
+    /* right-hand-sides on input, solutions on output */
+    Entry B [ ],
+
+    /* workspace, not defined on input or output */
+    Entry X [ ]         /* size n*NB */
+)
+{
+    Entry x [NB] ;
+    Entry *Gx, *Ux, *Lx, *Udiag, *Offx, *Xk, *Xi, *Bb ;
+    double *Rs, *Rk ;
+    KLU_numeric *Numeric ;
+    Int *Q, *R, *Pnum, *Offp, *Offi, *Li, *Ui, *Lip, *Uip, *Llen, *Ulen,
+        *Lxp, *Uxp ;
+    Unit *LU ;
+    Int n, nblocks, block, k1, k2, nk, k, p, pend, b, nb, len ;
+
+    Numeric = Batch->Numeric ;
+    n = Symbolic->n ;
+    Q = Symbolic->Q ;
+    R = Symbolic->R ;
+    nblocks = Symbolic->nblocks ;
+    Pnum = Numeric->Pnum ;
+    Offp = Numeric->Offp ;
+    Offi = Numeric->Offi ;
+    Lip  = Numeric->Lip ;
+    Llen = Numeric->Llen ;
+    Uip  = Numeric->Uip ;
+    Ulen = Numeric->Ulen ;
+    Lxp = Batch->Lxp ;
+    Uxp = Batch->Uxp ;
+
+    Gx = ((Entry *) Batch->LUx) + Batch->groupsize * g ;
+    Udiag = Gx + Batch->nzlu * NB ;
+    Offx = Udiag + n * NB ;
+    Rs = (Batch->Rs == NULL) ? NULL : (Batch->Rs + n * NB * g) ;
+
+    /* the matrices of the group that are in the batch */
+    nb = MIN (NB, Batch->nbatch - g*NB) ;
+    B += d * g * NB ;
+
+    /* ---------------------------------------------------------------------- */
+    /* scale and permute the right hand sides, X = P*(R\B) */
+    /* ---------------------------------------------------------------------- */
+
+    for (k = 0 ; k < n ; k++)
+    {
+        Xk = X + NB * k ;
+        Bb = B + Pnum [k] ;
+        if (Rs == NULL)
+        {
+            for (b = 0 ; b < nb ; b++)
+            {
+                Xk [b] = Bb [d*b] ;
+            }
+        }
+        else
+        {
+            Rk = Rs + NB * k ;
+            for (b = 0 ; b < nb ; b++)
+            {
+                SCALE_DIV_ASSIGN (Xk [b], Bb [d*b], Rk [b]) ;
+            }
+        }
+        for ( ; b < NB ; b++)
+        {
+            CLEAR (Xk [b]) ;
+        }
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* solve X = (L*U + Off)\X */
+    /* ---------------------------------------------------------------------- */
+
+    for (block = nblocks-1 ; block >= 0 ; block--)
+    {
+        k1 = R [block] ;
+        k2 = R [block+1] ;
+        nk = k2 - k1 ;
+
+        if (nk == 1)
+        {
+            Xk = X + NB * k1 ;
+            for (b = 0 ; b < NB ; b++)
+            {
+                DIV (Xk [b], Xk [b], Udiag [k1*NB + b]) ;
+            }
+        }
+        else
+        {
+            LU = ((Unit **) Numeric->LUbx) [block] ;
+
+            /* solve Lx=b */
+            for (k = k1 ; k < k2 ; k++)
+            {
+                GET_I_POINTER (LU, Lip, Li, k) ;
+                len = Llen [k] ;
+                Lx = Gx + NB * Lxp [k] ;
+                Xk = X + NB * k ;
+                for (b = 0 ; b < NB ; b++)
+                {
+                    x [b] = Xk [b] ;
+                }
+                for (p = 0 ; p < len ; p++)
+                {
+                    Xi = X + NB * (Li [p] + k1) ;
+                    /* X [Li [p]] -= Lx [p] * x [0] */
+                    mult_sub_group (Xi, Lx + NB*p, x) ;
+                }
+            }
+
+            /* solve Ux=b */
+            for (k = k2-1 ; k >= k1 ; k--)
+            {
+                GET_I_POINTER (LU, Uip, Ui, k) ;
+                len = Ulen [k] ;
+                Ux = Gx + NB * Uxp [k] ;
+                Xk = X + NB * k ;
+                for (b = 0 ; b < NB ; b++)
+                {
+                    DIV (x [b], Xk [b], Udiag [k*NB + b]) ;
+                    Xk [b] = x [b] ;
+                }
+                for (p = 0 ; p < len ; p++)
+                {
+                    Xi = X + NB * (Ui [p] + k1) ;
+                    /* X [Ui [p]] -= Ux [p] * x [0] */
+                    mult_sub_group (Xi, Ux + NB*p, x) ;
+                }
+            }
+        }
+
+        /* block back-substitution for the off-diagonal-block entries */
+        if (block > 0)
+        {
+            for (k = k1 ; k < k2 ; k++)
+            {
+                pend = Offp [k+1] ;
+                Xk = X + NB * k ;
+                for (b = 0 ; b < NB ; b++)
+                {
+                    x [b] = Xk [b] ;
+                }
+                for (p = Offp [k] ; p < pend ; p++)
+                {
+                    Xi = X + NB * Offi [p] ;
+                    mult_sub_group (Xi, Offx + NB*p, x) ;
+                }
+            }
+        }
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* permute the result, B = Q*X */
+    /* ---------------------------------------------------------------------- */
+
+    for (k = 0 ; k < n ; k++)
+    {
+        Xk = X + NB * k ;
+        Bb = B + Q [k] ;
+        for (b = 0 ; b < nb ; b++)
+        {
+            Bb [d*b] = Xk [b] ;
+        }
+    }
+}
+
+
+/* ========================================================================== */
+/* === batch_refactor ======================================================= */
+/* ========================================================================== */
+
+/* Refactorize all groups of the batch.  Returns FALSE on error, or if a
+ * matrix is singular and Common->halt_if_singular is true. */
+
+static Int batch_refactor
+(
+    Int Ap [ ],
+    Int Ai [ ],
+    double Ax [ ],
+    Int ldx,
+    KLU_symbolic *Symbolic,
+    KLU_batch_numeric *Batch,
+    KLU_common *Common
+)
+{
+    KLU_common *Tc ;
+    Entry *Xw ;
+    double *Rw ;
+    size_t xsize, rsize ;
+    Int g, k, ngroups, nthreads, ok ;
+
+    Common->status = KLU_OK ;
+    Common->numerical_rank = EMPTY ;
+    Common->singular_col = EMPTY ;
+
+    /* check the pattern once; the scale factors are computed per matrix */
+    if (Common->scale >= 0)
+    {
+        if (!KLU_scale (0, Symbolic->n, Ap, Ai, Ax, NULL, NULL, Common))
+        {
+            return (FALSE) ;
+        }
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* allocate workspace for each thread */
+    /* ---------------------------------------------------------------------- */
+
+    ngroups = Batch->ngroups ;
+    nthreads = KLU_nthreads (ngroups, Common) ;
+
+    ok = TRUE ;
+    xsize = KLU_mult_size_t (Symbolic->maxblock, NB * nthreads, &ok) ;
+    rsize = (Common->scale > 0) ?
+        KLU_mult_size_t (Symbolic->n, (NB+1) * nthreads, &ok) : 0 ;
+    if (!ok)
+    {
+        Common->status = KLU_TOO_LARGE ;
+        return (FALSE) ;
+    }
+    Tc = KLU_malloc (nthreads, sizeof (KLU_common), Common) ;
+    Xw = KLU_malloc (xsize, sizeof (Entry), Common) ;
+    Rw = KLU_malloc (rsize, sizeof (double), Common) ;
+    ok = (Common->status == KLU_OK) ;
+
+    if (ok)
+    {
+        KLU_thread_common (nthreads, Tc, Common) ;
+        for (k = 0 ; k < (Int) xsize ; k++)
+        {
+            /* X [k] = 0 */
+            CLEAR (Xw [k]) ;
+        }
+
+        /* ------------------------------------------------------------------ */
+        /* refactorize each group */
+        /* ------------------------------------------------------------------ */
+
+#ifdef _OPENMP
+        if (nthreads > 1)
+        {
+            #pragma omp parallel for num_threads(nthreads) schedule(dynamic,1)
+            for (g = 0 ; g < ngroups ; g++)
+            {
+                Int t = omp_get_thread_num ( ) ;
+                if (Tc [t].status >= KLU_OK)
+                {
+                    refactor_group (g, Ap, Ai, (Entry *) Ax, ldx, Symbolic,
+                        Batch, Xw + Symbolic->maxblock * NB * t,
+                        Rw + Symbolic->n * (NB+1) * t,
+                        Rw + Symbolic->n * ((NB+1) * t + NB), &Tc [t]) ;
+                }
+            }
+        }
+        else
+#endif
+        {
+            for (g = 0 ; g < ngroups && Tc [0].status >= KLU_OK ; g++)
+            {
+                refactor_group (g, Ap, Ai, (Entry *) Ax, ldx, Symbolic, Batch,
+                    Xw, Rw, Rw + Symbolic->n * NB, &Tc [0]) ;
+            }
+        }
+
+        KLU_merge_common (nthreads, Tc, Common) ;
+        ok = (Common->status == KLU_OK ||
+            (Common->status == KLU_SINGULAR && !Common->halt_if_singular)) ;
+    }
+    else
+    {
+        /* out of memory */
+        Common->status = KLU_OUT_OF_MEMORY ;
+    }
+
+    KLU_free (Tc, nthreads, sizeof (KLU_common), Common) ;
+    KLU_free (Xw, xsize, sizeof (Entry), Common) ;
+    KLU_free (Rw, rsize, sizeof (double), Common) ;
+    return (ok) ;
+}
+
+
+/* ========================================================================== */
+/* === KLU_batch_factor ===================================================== */
+/* ========================================================================== */
+
+KLU_batch_numeric *KLU_batch_factor    /* returns NULL if error */
+(
+    /* inputs, not modified */
+    Int Ap [ ],         /* size n+1, column pointers */
+    Int Ai [ ],         /* size nz, row indices */
+    double Ax [ ],      /* size ldx*nbatch, values of the matrices.  The values
+                         * of matrix b are Ax [b*ldx ... b*ldx+nz-1] (twice
+                         * that for the complex case) */
+    Int ldx,            /* leading dimension of Ax, >= nz */
+    Int nbatch,         /* number of matrices, > 0 */
+    KLU_symbolic *Symbolic,
+    /* -------------- */
+    KLU_common *Common
+)
+{
+    KLU_batch_numeric *Batch ;
+    KLU_numeric *Numeric ;
+    Int *R, *Llen, *Ulen ;
+    size_t s ;
+    Int n, nzlu, block, k, ok, mixed ;
+
+    /* ---------------------------------------------------------------------- */
+    /* check inputs */
+    /* ---------------------------------------------------------------------- */
+
+    if (Common == NULL)
+    {
+        return (NULL) ;
+    }
+    if (Symbolic == NULL || nbatch <= 0 || ldx < Symbolic->nz)
+    {
+        Common->status = KLU_INVALID ;
+        return (NULL) ;
+    }
+    Common->status = KLU_OK ;
+    n = Symbolic->n ;
+
+    /* ---------------------------------------------------------------------- */
+    /* factor the first matrix to find the pattern and the pivot ordering */
+    /* ---------------------------------------------------------------------- */
+
+    /* the factors of the batch are held in double precision */
+    mixed = Common->mixed ;
+    Common->mixed = FALSE ;
+    Numeric = KLU_factor (Ap, Ai, Ax, Symbolic, Common) ;
+    Common->mixed = mixed ;
+    if (Numeric == NULL)
+    {
+        return (NULL) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* allocate the Batch object */
+    /* ---------------------------------------------------------------------- */
+
+    Batch = KLU_malloc (1, sizeof (KLU_batch_numeric), Common) ;
+    if (Common->status < KLU_OK)
+    {
+        KLU_free_numeric (&Numeric, Common) ;
+        Common->status = KLU_OUT_OF_MEMORY ;
+        return (NULL) ;
+    }
+    Batch->Numeric = Numeric ;
+    Batch->n = n ;
+    Batch->nbatch = nbatch ;
+    Batch->ngroups = (nbatch + NB - 1) / NB ;
+    Batch->Lxp = KLU_malloc (n, sizeof (Int), Common) ;
+    Batch->Uxp = KLU_malloc (n, sizeof (Int), Common) ;
+    Batch->LUx = NULL ;
+    Batch->Rs = NULL ;
+    Batch->groupsize = 0 ;
+    Batch->rssize = 0 ;
+    if (Common->status < KLU_OK)
+    {
+        KLU_batch_free_numeric (&Batch, Common) ;
+        Common->status = KLU_OUT_OF_MEMORY ;
+        return (NULL) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* lay out the values of L and U of each group */
+    /* ---------------------------------------------------------------------- */
+
+    R = Symbolic->R ;
+    Llen = Numeric->Llen ;
+    Ulen = Numeric->Ulen ;
+    nzlu = 0 ;
+    for (block = 0 ; block < Symbolic->nblocks ; block++)
+    {
+        for (k = R [block] ; k < R [block+1] ; k++)
+        {
+            Batch->Lxp [k] = nzlu ;
+            Batch->Uxp [k] = nzlu ;
+            if (R [block+1] - R [block] > 1)
+            {
+                Batch->Uxp [k] += Llen [k] ;
+                nzlu += Llen [k] + Ulen [k] ;
+            }
+        }
+    }
+    Batch->nzlu = nzlu ;
+
+    ok = TRUE ;
+    s = KLU_add_size_t (nzlu, n, &ok) ;
+    s = KLU_add_size_t (s, Symbolic->nzoff, &ok) ;
+    Batch->groupsize = KLU_mult_size_t (s, NB, &ok) ;
+    s = KLU_mult_size_t (Batch->groupsize, Batch->ngroups, &ok) ;
+    if (Common->scale > 0)
+    {
+        Batch->rssize = KLU_mult_size_t (n, NB * Batch->ngroups, &ok) ;
+    }
+    if (!ok)
+    {
+        KLU_batch_free_numeric (&Batch, Common) ;
+        Common->status = KLU_TOO_LARGE ;
+        return (NULL) ;
+    }
+    Batch->LUx = KLU_malloc (s, sizeof (Entry), Common) ;
+    if (Common->scale > 0)
+    {
+        Batch->Rs = KLU_malloc (Batch->rssize, sizeof (double), Common) ;
+    }
+    if (Common->status < KLU_OK)
+    {
+        /* out of memory, or problem too large */
+        ok = Common->status ;
+        KLU_batch_free_numeric (&Batch, Common) ;
+        Common->status = ok ;
+        return (NULL) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* factor the batch */
+    /* ---------------------------------------------------------------------- */
+
+    if (!batch_refactor (Ap, Ai, Ax, ldx, Symbolic, Batch, Common))
+    {
+        ok = Common->status ;
+        KLU_batch_free_numeric (&Batch, Common) ;
+        Common->status = ok ;
+        return (NULL) ;
+    }
+    return (Batch) ;
+}
+
+
+/* ========================================================================== */
+/* === KLU_batch_refactor =================================================== */
+/* ========================================================================== */
+
+Int KLU_batch_refactor  /* returns TRUE if successful, FALSE otherwise */
+(
+    /* inputs, not modified */
+    Int Ap [ ],         /* size n+1, column pointers */
+    Int Ai [ ],         /* size nz, row indices */
+    double Ax [ ],      /* size ldx*nbatch, values of the matrices */
+    Int ldx,            /* leading dimension of Ax, >= nz */
+    KLU_symbolic *Symbolic,
+
+    /* input/output */
+    KLU_batch_numeric *Batch,
+    KLU_common *Common
+)
+{
+    if (Common == NULL)
+    {
+        return (FALSE) ;
+    }
+    if (Symbolic == NULL || Batch == NULL || ldx < Symbolic->nz ||
+        Batch->n != Symbolic->n)
+    {
+        Common->status = KLU_INVALID ;
+        return (FALSE) ;
+    }
+
+    /* the scale factors are allocated by KLU_batch_factor */
+    if ((Common->scale > 0) != (Batch->Rs != NULL))
+    {
+        Common->status = KLU_INVALID ;
+        return (FALSE) ;
+    }
+
+    return (batch_refactor (Ap, Ai, Ax, ldx, Symbolic, Batch, Common)) ;
+}
+
+
+/* ========================================================================== */
+/* === KLU_batch_solve ====================================================== */
+/* ========================================================================== */
+
+Int KLU_batch_solve     /* returns TRUE if successful, FALSE otherwise */
+(
+    /* inputs, not modified */
+    KLU_symbolic *Symbolic,
+    KLU_batch_numeric *Batch,
+    Int d,              /* leading dimension of B */
+
+    /* right-hand-sides on input, overwritten with the solutions on output */
+    double B [ ],       /* size n*nbatch, in column-oriented form, with leading
+                         * dimension d.  Column b is the right-hand-side for
+                         * matrix b of the batch. */
+    /* --------------- */
+    KLU_common *Common
+)
+{
+    Entry *X, *Bz ;
+    size_t s ;
+    Int n, g, ngroups, nthreads, ok ;
+
+    if (Common == NULL)
+    {
+        return (FALSE) ;
+    }
+    if (Symbolic == NULL || Batch == NULL || d < Symbolic->n || B == NULL ||
+        Batch->n != Symbolic->n)
+    {
+        Common->status = KLU_INVALID ;
+        return (FALSE) ;
+    }
+    Common->status = KLU_OK ;
+
+    n = Symbolic->n ;
+    if (n == 0)
+    {
+        /* nothing to do */
+        return (TRUE) ;
+    }
+
+    ngroups = Batch->ngroups ;
+    nthreads = KLU_nthreads (ngroups, Common) ;
+
+    ok = TRUE ;
+    s = KLU_mult_size_t (n, NB * nthreads, &ok) ;
+    if (!ok)
+    {
+        Common->status = KLU_TOO_LARGE ;
+        return (FALSE) ;
+    }
+    X = KLU_malloc (s, sizeof (Entry), Common) ;
+    if (Common->status < KLU_OK)
+    {
+        /* out of memory, or problem too large */
+        return (FALSE) ;
+    }
+
+    Bz = (Entry *) B ;
+
+#ifdef _OPENMP
+    if (nthreads > 1)
+    {
+        #pragma omp parallel for num_threads(nthreads) schedule(dynamic,1)
+        for (g = 0 ; g < ngroups ; g++)
+        {
+            solve_group (g, Symbolic, Batch, d, Bz,
+                X + n * NB * omp_get_thread_num ( )) ;
+        }
+    }
+    else
+#endif
+    {
+        for (g = 0 ; g < ngroups ; g++)
+        {
+            solve_group (g, Symbolic, Batch, d, Bz, X) ;
+        }
+    }
+
+    KLU_free (X, s, sizeof (Entry), Common) ;
+    return (TRUE) ;
+}
+
+
+/* ========================================================================== */
+/* === KLU_batch_free_numeric =============================================== */
+/* ========================================================================== */
+
+Int KLU_batch_free_numeric
+(
+    KLU_batch_numeric **BatchHandle,
+    KLU_common *Common
+)
+{
+    KLU_batch_numeric *Batch ;
+    Int n ;
+
+    if (Common == NULL)
+    {
+        return (FALSE) ;
+    }
+    if (BatchHandle == NULL || *BatchHandle == NULL)
+    {
+        return (TRUE) ;
+    }
+
+    Batch = *BatchHandle ;
+    n = Batch->n ;
+
+    KLU_free_numeric (&(Batch->Numeric), Common) ;
+    KLU_free (Batch->Lxp, n, sizeof (Int), Common) ;
+    KLU_free (Batch->Uxp, n, sizeof (Int), Common) ;
+    KLU_free (Batch->LUx, Batch->groupsize * Batch->ngroups, sizeof (Entry),
+        Common) ;
+    KLU_free (Batch->Rs, Batch->rssize, sizeof (double), Common) ;
+    KLU_free (Batch, 1, sizeof (KLU_batch_numeric), Common) ;
+
+    *BatchHandle = NULL ;
+    return (TRUE) ;
+}
@@ -23,13 +23,17 @@ Int KLU_defaults
     Common->initmem = 10 ;      /* init. mem otherwise: c*nnz(A) + n */
     Common->btf = TRUE ;        /* use BTF pre-ordering, or not */
     Common->maxwork = 0 ;       /* no limit to work done by btf_order */
+    Common->panel_density = 0 ; /* no dense panels in L */
     Common->ordering = 0 ;      /* 0: AMD, 1: COLAMD, 2: user-provided P and Q,
-                                 * 3: user-provided function */
+                                 * 3: user-provided function, 4: METIS */
     Common->scale = 2 ;         /* scale: -1: none, and do not check for errors
                                  * in the input matrix in KLU_refactor.
                                  * 0: none, but check for errors,
                                  * 1: sum, 2: max */
     Common->halt_if_singular = TRUE ;   /* quick halt if matrix is singular */
+    Common->nthreads = 1 ;      /* factorize the BTF blocks sequentially */
+    Common->nd_threshold = 1000 ;   /* use AMD on blocks smaller than this */
+    Common->mixed = FALSE ;     /* L and U in double precision */
 
     /* user ordering function and optional argument */
     Common->user_order = NULL ;
@@ -41,6 +45,7 @@ Int KLU_defaults
     Common->structural_rank = EMPTY ;
     Common->numerical_rank = EMPTY ;
     Common->noffdiag = EMPTY ;
+    Common->nrefine = 0 ;
     Common->flops = EMPTY ;
     Common->rcond = EMPTY ;
     Common->condest = EMPTY ;
@@ -50,5 +55,11 @@ Int KLU_defaults
     Common->memusage = 0 ;
     Common->mempeak = 0 ;
 
+    /* no memory arena */
+    Common->arena = NULL ;
+    Common->arena_retained = 0 ;
+    Common->arena_peak = 0 ;
+    Common->arena_nmalloc = 0 ;
+
     return (TRUE) ;
 }
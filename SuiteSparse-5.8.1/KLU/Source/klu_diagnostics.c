@@ -37,6 +37,7 @@ Int KLU_rgrowth         /* return TRUE if successful, FALSE otherwise */
     Int *Q, *Ui, *Uip, *Ulen, *Pinv ;
     Unit *LU ;
     Entry *Aentry, *Ux, *Ukk ;
+    SEntry *Us ;
     double *Rs ;
     Int i, newrow, oldrow, k1, k2, nk, j, oldcol, k, pend, len ;
 
@@ -122,14 +123,31 @@ Int KLU_rgrowth         /* return TRUE if successful, FALSE otherwise */
 
             /* Ui is set but not used.  This is OK, because otherwise the macro
                would have to be redesigned. */
-            GET_POINTER (LU, Uip, Ulen, Ui, Ux, j, len) ;
-            for (k = 0 ; k < len ; k++)
+            if (Numeric->mixed)
             {
-                /* temp = ABS (Ux [k]) */
-                ABS (temp, Ux [k]) ;
-                if (temp > max_ui)
+                /* U is held in single precision */
+                GET_S_POINTER (LU, Uip, Ulen, Ui, Us, j, len) ;
+                for (k = 0 ; k < len ; k++)
                 {
-                    max_ui = temp ;
+                    TO_DOUBLE (aik, Us [k]) ;
+                    ABS (temp, aik) ;
+                    if (temp > max_ui)
+                    {
+                        max_ui = temp ;
+                    }
+                }
+            }
+            else
+            {
+                GET_POINTER (LU, Uip, Ulen, Ui, Ux, j, len) ;
+                for (k = 0 ; k < len ; k++)
+                {
+                    /* temp = ABS (Ux [k]) */
+                    ABS (temp, Ux [k]) ;
+                    if (temp > max_ui)
+                    {
+                        max_ui = temp ;
+                    }
                 }
             }
             /* consider the diagonal element */
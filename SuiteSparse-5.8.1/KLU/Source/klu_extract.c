@@ -61,6 +61,7 @@ Int KLU_extract     /* returns TRUE if successful, FALSE otherwise */
     Int *Lip, *Llen, *Uip, *Ulen, *Li2, *Ui2 ;
     Unit *LU ;
     Entry *Lx2, *Ux2, *Ukk ;
+    SEntry *Ls2, *Us2 ;
     Int i, k, block, nblocks, n, nz, k1, k2, nk, len, kk, p ;
 
     if (Common == NULL)
@@ -180,15 +181,32 @@ Int KLU_extract     /* returns TRUE if successful, FALSE otherwise */
                     Lz [nz] = 0 ;
 #endif
                     nz++ ;
-                    GET_POINTER (LU, Lip, Llen, Li2, Lx2, kk, len) ;
-                    for (p = 0 ; p < len ; p++)
+                    if (Numeric->mixed)
                     {
-                        Li [nz] = k1 + Li2 [p] ;
-                        Lx [nz] = REAL (Lx2 [p]) ;
+                        /* L is held in single precision */
+                        GET_S_POINTER (LU, Lip, Llen, Li2, Ls2, kk, len) ;
+                        for (p = 0 ; p < len ; p++)
+                        {
+                            Li [nz] = k1 + Li2 [p] ;
+                            Lx [nz] = REAL (Ls2 [p]) ;
 #ifdef COMPLEX
-                        Lz [nz] = IMAG (Lx2 [p]) ;
+                            Lz [nz] = IMAG (Ls2 [p]) ;
 #endif
-                        nz++ ;
+                            nz++ ;
+                        }
+                    }
+                    else
+                    {
+                        GET_POINTER (LU, Lip, Llen, Li2, Lx2, kk, len) ;
+                        for (p = 0 ; p < len ; p++)
+                        {
+                            Li [nz] = k1 + Li2 [p] ;
+                            Lx [nz] = REAL (Lx2 [p]) ;
+#ifdef COMPLEX
+                            Lz [nz] = IMAG (Lx2 [p]) ;
+#endif
+                            nz++ ;
+                        }
                     }
                 }
             }
@@ -234,15 +252,32 @@ Int KLU_extract     /* returns TRUE if successful, FALSE otherwise */
                 for (kk = 0 ; kk < nk ; kk++)
                 {
                     Up [k1+kk] = nz ;
-                    GET_POINTER (LU, Uip, Ulen, Ui2, Ux2, kk, len) ;
-                    for (p = 0 ; p < len ; p++)
+                    if (Numeric->mixed)
+                    {
+                        /* U is held in single precision */
+                        GET_S_POINTER (LU, Uip, Ulen, Ui2, Us2, kk, len) ;
+                        for (p = 0 ; p < len ; p++)
+                        {
+                            Ui [nz] = k1 + Ui2 [p] ;
+                            Ux [nz] = REAL (Us2 [p]) ;
+#ifdef COMPLEX
+                            Uz [nz] = IMAG (Us2 [p]) ;
+#endif
+                            nz++ ;
+                        }
+                    }
+                    else
                     {
-                        Ui [nz] = k1 + Ui2 [p] ;
-                        Ux [nz] = REAL (Ux2 [p]) ;
+                        GET_POINTER (LU, Uip, Ulen, Ui2, Ux2, kk, len) ;
+                        for (p = 0 ; p < len ; p++)
+                        {
+                            Ui [nz] = k1 + Ui2 [p] ;
+                            Ux [nz] = REAL (Ux2 [p]) ;
 #ifdef COMPLEX
-                        Uz [nz] = IMAG (Ux2 [p]) ;
+                            Uz [nz] = IMAG (Ux2 [p]) ;
 #endif
-                        nz++ ;
+                            nz++ ;
+                        }
                     }
                     /* add the diagonal entry */
                     Ui [nz] = k1 + kk ;
@@ -8,13 +8,24 @@
 
 #include "klu_internal.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 /* ========================================================================== */
-/* === KLU_factor2 ========================================================== */
+/* === factor_block ========================================================= */
 /* ========================================================================== */
 
-static void factor2
+/* Factorize a single diagonal block of the BTF form.  Offp [k1] must already
+ * be defined on input.  If Oslice is not NULL, the kernel builds the
+ * off-diagonal column pointers of the block there instead of in Numeric->Offp,
+ * which must then already hold them.  Returns FALSE if the factorization must
+ * halt. */
+
+static Int factor_block
 (
     /* inputs, not modified */
+    Int block,          /* the block to factorize */
     Int Ap [ ],         /* size n+1, column pointers */
     Int Ai [ ],         /* size nz, row indices */
     Entry Ax [ ],
@@ -22,43 +33,377 @@ static void factor2
 
     /* inputs, modified on output: */
     KLU_numeric *Numeric,
+
+    /* workspace, not defined on input or output */
+    Entry X [ ],        /* size maxblock, zero on output */
+    Int Iwork [ ],      /* size 5*maxblock */
+    Int Pblock [ ],     /* size maxblock */
+    Int Oslice [ ],     /* size maxblock+1, or NULL */
+
+    /* outputs, not defined on input */
+    Int *p_lnz_block,   /* nz in L for this block, including the diagonal */
+    Int *p_unz_block,   /* nz in U for this block, including the diagonal */
     KLU_common *Common
 )
 {
     double lsize ;
     double *Lnz, *Rs ;
-    Int *P, *Q, *R, *Pnum, *Offp, *Offi, *Pblock, *Pinv, *Iwork,
-        *Lip, *Uip, *Llen, *Ulen ;
-    Entry *Offx, *X, s, *Udiag ;
+    Int *P, *Q, *R, *Pnum, *Offp, *Offi, *Pinv, *Lip, *Uip, *Llen, *Ulen ;
+    Entry *Offx, s, *Udiag ;
     Unit **LUbx ;
-    Int k1, k2, nk, k, block, oldcol, pend, oldrow, n, lnz, unz, p, newrow,
-        nblocks, poff, nzoff, lnz_block, unz_block, scale, max_lnz_block,
-        max_unz_block ;
+    Int k1, k2, nk, k, oldcol, pend, oldrow, p, newrow, poff, lnz_block,
+        unz_block, scale ;
 
-    /* ---------------------------------------------------------------------- */
-    /* initializations */
-    /* ---------------------------------------------------------------------- */
-
-    /* get the contents of the Symbolic object */
-    n = Symbolic->n ;
     P = Symbolic->P ;
     Q = Symbolic->Q ;
     R = Symbolic->R ;
     Lnz = Symbolic->Lnz ;
-    nblocks = Symbolic->nblocks ;
-    nzoff = Symbolic->nzoff ;
 
     Pnum = Numeric->Pnum ;
     Offp = Numeric->Offp ;
     Offi = Numeric->Offi ;
     Offx = (Entry *) Numeric->Offx ;
-
     Lip = Numeric->Lip ;
     Uip = Numeric->Uip ;
     Llen = Numeric->Llen ;
     Ulen = Numeric->Ulen ;
     LUbx = (Unit **) Numeric->LUbx ;
     Udiag = Numeric->Udiag ;
+    Rs = Numeric->Rs ;
+    Pinv = Numeric->Pinv ;
+    scale = Common->scale ;
+
+    /* ---------------------------------------------------------------------- */
+    /* the block is from rows/columns k1 to k2-1 */
+    /* ---------------------------------------------------------------------- */
+
+    k1 = R [block] ;
+    k2 = R [block+1] ;
+    nk = k2 - k1 ;
+    PRINTF (("FACTOR BLOCK %d, k1 %d k2-1 %d nk %d\n", block, k1,k2-1,nk)) ;
+
+    if (nk == 1)
+    {
+
+        /* ------------------------------------------------------------------ */
+        /* singleton case */
+        /* ------------------------------------------------------------------ */
+
+        poff = Offp [k1] ;
+        oldcol = Q [k1] ;
+        pend = Ap [oldcol+1] ;
+        CLEAR (s) ;
+
+        if (scale <= 0)
+        {
+            /* no scaling */
+            for (p = Ap [oldcol] ; p < pend ; p++)
+            {
+                oldrow = Ai [p] ;
+                newrow = Pinv [oldrow] ;
+                if (newrow < k1)
+                {
+                    Offi [poff] = oldrow ;
+                    Offx [poff] = Ax [p] ;
+                    poff++ ;
+                }
+                else
+                {
+                    ASSERT (newrow == k1) ;
+                    PRINTF (("singleton block %d", block)) ;
+                    PRINT_ENTRY (Ax [p]) ;
+                    s = Ax [p] ;
+                }
+            }
+        }
+        else
+        {
+            /* row scaling.  NOTE: scale factors are not yet permuted
+             * according to the pivot row permutation, so Rs [oldrow] is
+             * used below.  When the factorization is done, the scale
+             * factors are permuted, so that Rs [newrow] will be used in
+             * klu_solve, klu_tsolve, and klu_rgrowth */
+            for (p = Ap [oldcol] ; p < pend ; p++)
+            {
+                oldrow = Ai [p] ;
+                newrow = Pinv [oldrow] ;
+                if (newrow < k1)
+                {
+                    Offi [poff] = oldrow ;
+                    /* Offx [poff] = Ax [p] / Rs [oldrow] ; */
+                    SCALE_DIV_ASSIGN (Offx [poff], Ax [p], Rs [oldrow]) ;
+                    poff++ ;
+                }
+                else
+                {
+                    ASSERT (newrow == k1) ;
+                    PRINTF (("singleton block %d ", block)) ;
+                    PRINT_ENTRY (Ax[p]) ;
+                    SCALE_DIV_ASSIGN (s, Ax [p], Rs [oldrow]) ;
+                }
+            }
+        }
+
+        Udiag [k1] = s ;
+
+        if (IS_ZERO (s))
+        {
+            /* singular singleton */
+            Common->status = KLU_SINGULAR ;
+            if (Common->numerical_rank == EMPTY)
+            {
+                Common->numerical_rank = k1 ;
+                Common->singular_col = oldcol ;
+            }
+            if (Common->halt_if_singular)
+            {
+                return (FALSE) ;
+            }
+        }
+
+        Offp [k1+1] = poff ;
+        Pnum [k1] = P [k1] ;
+        lnz_block = 1 ;
+        unz_block = 1 ;
+
+    }
+    else
+    {
+
+        /* ------------------------------------------------------------------ */
+        /* construct and factorize the kth block */
+        /* ------------------------------------------------------------------ */
+
+        if (Lnz [block] < 0)
+        {
+            /* COLAMD was used - no estimate of fill-in */
+            /* use 10 times the nnz in A, plus n */
+            lsize = -(Common->initmem) ;
+        }
+        else
+        {
+            lsize = Common->initmem_amd * Lnz [block] + nk ;
+        }
+
+        if (Oslice != NULL)
+        {
+            Oslice [0] = Offp [k1] ;
+        }
+        else
+        {
+            Oslice = Offp + k1 ;
+        }
+
+        /* allocates 1 arrays: LUbx [block] */
+        Numeric->LUsize [block] = KLU_kernel_factor (nk, Ap, Ai, Ax, Q,
+                lsize, &LUbx [block], Udiag + k1, Llen + k1, Ulen + k1,
+                Lip + k1, Uip + k1, Pblock, &lnz_block, &unz_block,
+                X, Iwork, k1, Pinv, Rs, Oslice, Offi, Offx, Common) ;
+
+        if (Common->status < KLU_OK ||
+           (Common->status == KLU_SINGULAR && Common->halt_if_singular))
+        {
+            /* out of memory, invalid inputs, or singular */
+            return (FALSE) ;
+        }
+
+        PRINTF (("\n----------------------- L %d:\n", block)) ;
+        ASSERT (KLU_valid_LU (nk, TRUE, Lip+k1, Llen+k1, LUbx [block])) ;
+        PRINTF (("\n----------------------- U %d:\n", block)) ;
+        ASSERT (KLU_valid_LU (nk, FALSE, Uip+k1, Ulen+k1, LUbx [block])) ;
+
+        if (Lnz [block] == EMPTY)
+        {
+            /* revise estimate for subsequent factorization */
+            Lnz [block] = MAX (lnz_block, unz_block) ;
+        }
+
+        /* ------------------------------------------------------------------ */
+        /* combine the klu row ordering with the symbolic pre-ordering */
+        /* ------------------------------------------------------------------ */
+
+        PRINTF (("Pnum, 1-based:\n")) ;
+        for (k = 0 ; k < nk ; k++)
+        {
+            ASSERT (k + k1 < Symbolic->n) ;
+            ASSERT (Pblock [k] + k1 < Symbolic->n) ;
+            Pnum [k + k1] = P [Pblock [k] + k1] ;
+            PRINTF (("Pnum (%d + %d + 1 = %d) = %d + 1 = %d\n",
+                k, k1, k+k1+1, Pnum [k+k1], Pnum [k+k1]+1)) ;
+        }
+
+        /* the local pivot row permutation Pblock is no longer needed */
+    }
+
+    *p_lnz_block = lnz_block ;
+    *p_unz_block = unz_block ;
+    return (TRUE) ;
+}
+
+
+#ifdef _OPENMP
+/* ========================================================================== */
+/* === factor_parallel ====================================================== */
+/* ========================================================================== */
+
+/* Factorize the blocks with nthreads threads.  The off-diagonal column
+ * pointers Offp only depend on the pattern of A, so they are computed first
+ * and are only read while the blocks are factorized; the kernel rebuilds the
+ * pointers of each block in a slice private to the thread.  The blocks then
+ * write to disjoint parts of the Numeric object.  Singletons are cheap and
+ * are done by the calling thread.  Each block is factorized exactly as in the
+ * sequential case, so the factors are identical. */
+
+static void factor_parallel
+(
+    Int nthreads,
+    Int Ap [ ],
+    Int Ai [ ],
+    Entry Ax [ ],
+    KLU_symbolic *Symbolic,
+    KLU_numeric *Numeric,
+    Int *p_lnz,
+    Int *p_unz,
+    Int *p_max_lnz_block,
+    Int *p_max_unz_block,
+    KLU_common *Common
+)
+{
+    KLU_common *Tc ;
+    Entry *Xw ;
+    Int *Iw, *Q, *R, *Offp, *Pinv ;
+    Int block, k1, k2, k, p, poff, nblocks, maxblock, iwsize, lnz, unz,
+        max_lnz_block, max_unz_block, lnz_block, unz_block ;
+
+    Q = Symbolic->Q ;
+    R = Symbolic->R ;
+    nblocks = Symbolic->nblocks ;
+    maxblock = Symbolic->maxblock ;
+    Offp = Numeric->Offp ;
+    Pinv = Numeric->Pinv ;
+
+    /* per thread: Iwork (5*maxblock), Pblock (maxblock), Oslice (maxblock+1) */
+    iwsize = 7 * maxblock + 1 ;
+
+    Tc = KLU_malloc (nthreads, sizeof (KLU_common), Common) ;
+    Xw = KLU_malloc (nthreads * maxblock, sizeof (Entry), Common) ;
+    Iw = KLU_malloc (nthreads * iwsize, sizeof (Int), Common) ;
+    if (Common->status < KLU_OK)
+    {
+        /* out of memory */
+        Common->status = KLU_OUT_OF_MEMORY ;
+        goto done ;
+    }
+    KLU_thread_common (nthreads, Tc, Common) ;
+
+    /* ---------------------------------------------------------------------- */
+    /* compute the column pointers of the off-diagonal part */
+    /* ---------------------------------------------------------------------- */
+
+    for (block = 0 ; block < nblocks ; block++)
+    {
+        k1 = R [block] ;
+        k2 = R [block+1] ;
+        for (k = k1 ; k < k2 ; k++)
+        {
+            poff = Offp [k] ;
+            for (p = Ap [Q [k]] ; p < Ap [Q [k]+1] ; p++)
+            {
+                if (Pinv [Ai [p]] < k1) poff++ ;
+            }
+            Offp [k+1] = poff ;
+        }
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* factorize the singletons, then the remaining blocks in parallel */
+    /* ---------------------------------------------------------------------- */
+
+    lnz = 0 ;
+    unz = 0 ;
+    max_lnz_block = 1 ;
+    max_unz_block = 1 ;
+    for (block = 0 ; block < nblocks ; block++)
+    {
+        if (R [block+1] - R [block] == 1)
+        {
+            factor_block (block, Ap, Ai, Ax, Symbolic, Numeric, Xw, Iw,
+                Iw + 5*maxblock, NULL, &lnz_block, &unz_block, Tc) ;
+            lnz++ ;
+            unz++ ;
+        }
+    }
+
+    #pragma omp parallel for num_threads(nthreads) schedule(dynamic,1) \
+        private(lnz_block, unz_block) reduction(+:lnz,unz) \
+        reduction(max:max_lnz_block,max_unz_block)
+    for (block = 0 ; block < nblocks ; block++)
+    {
+        Int t = omp_get_thread_num ( ) ;
+        Int *Iwork = Iw + iwsize * t ;
+        if (R [block+1] - R [block] > 1 &&
+            factor_block (block, Ap, Ai, Ax, Symbolic, Numeric,
+                Xw + maxblock * t, Iwork, Iwork + 5*maxblock,
+                Iwork + 6*maxblock, &lnz_block, &unz_block, &Tc [t]))
+        {
+            lnz += lnz_block ;
+            unz += unz_block ;
+            max_lnz_block = MAX (max_lnz_block, lnz_block) ;
+            max_unz_block = MAX (max_unz_block, unz_block) ;
+        }
+    }
+
+    KLU_merge_common (nthreads, Tc, Common) ;
+    *p_lnz = lnz ;
+    *p_unz = unz ;
+    *p_max_lnz_block = max_lnz_block ;
+    *p_max_unz_block = max_unz_block ;
+
+done:
+    KLU_free (Tc, nthreads, sizeof (KLU_common), Common) ;
+    KLU_free (Xw, nthreads * maxblock, sizeof (Entry), Common) ;
+    KLU_free (Iw, nthreads * iwsize, sizeof (Int), Common) ;
+}
+#endif
+
+
+/* ========================================================================== */
+/* === KLU_factor2 ========================================================== */
+/* ========================================================================== */
+
+static void factor2
+(
+    /* inputs, not modified */
+    Int Ap [ ],         /* size n+1, column pointers */
+    Int Ai [ ],         /* size nz, row indices */
+    Entry Ax [ ],
+    KLU_symbolic *Symbolic,
+
+    /* inputs, modified on output: */
+    KLU_numeric *Numeric,
+    KLU_common *Common
+)
+{
+    double *Rs ;
+    Int *P, *R, *Pnum, *Offp, *Offi, *Pblock, *Pinv, *Iwork ;
+    Entry *X ;
+    Int nk, k, block, n, lnz, unz, p, nblocks, nzoff, lnz_block, unz_block,
+        scale, max_lnz_block, max_unz_block, nthreads ;
+
+    /* ---------------------------------------------------------------------- */
+    /* initializations */
+    /* ---------------------------------------------------------------------- */
+
+    /* get the contents of the Symbolic object */
+    n = Symbolic->n ;
+    P = Symbolic->P ;
+    R = Symbolic->R ;
+    nblocks = Symbolic->nblocks ;
+    nzoff = Symbolic->nzoff ;
+
+    Pnum = Numeric->Pnum ;
+    Offp = Numeric->Offp ;
+    Offi = Numeric->Offi ;
 
     Rs = Numeric->Rs ;
     Pinv = Numeric->Pinv ;
@@ -126,136 +471,37 @@ static void factor2
     /* factor each block using klu */
     /* ---------------------------------------------------------------------- */
 
+    nk = 0 ;
     for (block = 0 ; block < nblocks ; block++)
     {
+        if (R [block+1] - R [block] > 1) nk++ ;
+    }
+    nthreads = KLU_nthreads (nk, Common) ;  /* always 1 without OpenMP */
 
-        /* ------------------------------------------------------------------ */
-        /* the block is from rows/columns k1 to k2-1 */
-        /* ------------------------------------------------------------------ */
-
-        k1 = R [block] ;
-        k2 = R [block+1] ;
-        nk = k2 - k1 ;
-        PRINTF (("FACTOR BLOCK %d, k1 %d k2-1 %d nk %d\n", block, k1,k2-1,nk)) ;
-
-        if (nk == 1)
+    if (nthreads > 1)
+    {
+#ifdef _OPENMP
+        factor_parallel (nthreads, Ap, Ai, Ax, Symbolic, Numeric, &lnz, &unz,
+            &max_lnz_block, &max_unz_block, Common) ;
+        if (Common->status < KLU_OK ||
+           (Common->status == KLU_SINGULAR && Common->halt_if_singular))
         {
-
-            /* -------------------------------------------------------------- */
-            /* singleton case */
-            /* -------------------------------------------------------------- */
-
-            poff = Offp [k1] ;
-            oldcol = Q [k1] ;
-            pend = Ap [oldcol+1] ;
-            CLEAR (s) ;
-
-            if (scale <= 0)
-            {
-                /* no scaling */
-                for (p = Ap [oldcol] ; p < pend ; p++)
-                {
-                    oldrow = Ai [p] ;
-                    newrow = Pinv [oldrow] ;
-                    if (newrow < k1)
-                    {
-                        Offi [poff] = oldrow ;
-                        Offx [poff] = Ax [p] ;
-                        poff++ ;
-                    }
-                    else
-                    {
-                        ASSERT (newrow == k1) ;
-                        PRINTF (("singleton block %d", block)) ;
-                        PRINT_ENTRY (Ax [p]) ;
-                        s = Ax [p] ;
-                    }
-                }
-            }
-            else
-            {
-                /* row scaling.  NOTE: scale factors are not yet permuted
-                 * according to the pivot row permutation, so Rs [oldrow] is
-                 * used below.  When the factorization is done, the scale
-                 * factors are permuted, so that Rs [newrow] will be used in
-                 * klu_solve, klu_tsolve, and klu_rgrowth */
-                for (p = Ap [oldcol] ; p < pend ; p++)
-                {
-                    oldrow = Ai [p] ;
-                    newrow = Pinv [oldrow] ;
-                    if (newrow < k1)
-                    {
-                        Offi [poff] = oldrow ;
-                        /* Offx [poff] = Ax [p] / Rs [oldrow] ; */
-                        SCALE_DIV_ASSIGN (Offx [poff], Ax [p], Rs [oldrow]) ;
-                        poff++ ;
-                    }
-                    else
-                    {
-                        ASSERT (newrow == k1) ;
-                        PRINTF (("singleton block %d ", block)) ;
-                        PRINT_ENTRY (Ax[p]) ;
-                        SCALE_DIV_ASSIGN (s, Ax [p], Rs [oldrow]) ;
-                    }
-                }
-            }
-
-            Udiag [k1] = s ;
-
-            if (IS_ZERO (s))
-            {
-                /* singular singleton */
-                Common->status = KLU_SINGULAR ;
-                Common->numerical_rank = k1 ;
-                Common->singular_col = oldcol ;
-                if (Common->halt_if_singular)
-                {
-                    return ;
-                }
-            }
-
-            Offp [k1+1] = poff ;
-            Pnum [k1] = P [k1] ;
-            lnz++ ;
-            unz++ ;
-
+            /* out of memory, invalid inputs, or singular */
+            return ;
         }
-        else
+#endif
+    }
+    else
+    {
+        for (block = 0 ; block < nblocks ; block++)
         {
-
-            /* -------------------------------------------------------------- */
-            /* construct and factorize the kth block */
-            /* -------------------------------------------------------------- */
-
-            if (Lnz [block] < 0)
-            {
-                /* COLAMD was used - no estimate of fill-in */
-                /* use 10 times the nnz in A, plus n */
-                lsize = -(Common->initmem) ;
-            }
-            else
-            {
-                lsize = Common->initmem_amd * Lnz [block] + nk ;
-            }
-
-            /* allocates 1 arrays: LUbx [block] */
-            Numeric->LUsize [block] = KLU_kernel_factor (nk, Ap, Ai, Ax, Q,
-                    lsize, &LUbx [block], Udiag + k1, Llen + k1, Ulen + k1,
-                    Lip + k1, Uip + k1, Pblock, &lnz_block, &unz_block,
-                    X, Iwork, k1, Pinv, Rs, Offp, Offi, Offx, Common) ;
-
-            if (Common->status < KLU_OK ||
-               (Common->status == KLU_SINGULAR && Common->halt_if_singular))
+            if (!factor_block (block, Ap, Ai, Ax, Symbolic, Numeric, X, Iwork,
+                Pblock, NULL, &lnz_block, &unz_block, Common))
             {
                 /* out of memory, invalid inputs, or singular */
                 return ;
             }
 
-            PRINTF (("\n----------------------- L %d:\n", block)) ;
-            ASSERT (KLU_valid_LU (nk, TRUE, Lip+k1, Llen+k1, LUbx [block])) ;
-            PRINTF (("\n----------------------- U %d:\n", block)) ;
-            ASSERT (KLU_valid_LU (nk, FALSE, Uip+k1, Ulen+k1, LUbx [block])) ;
-
             /* -------------------------------------------------------------- */
             /* get statistics */
             /* -------------------------------------------------------------- */
@@ -264,33 +510,11 @@ static void factor2
             unz += unz_block ;
             max_lnz_block = MAX (max_lnz_block, lnz_block) ;
             max_unz_block = MAX (max_unz_block, unz_block) ;
-
-            if (Lnz [block] == EMPTY)
-            {
-                /* revise estimate for subsequent factorization */
-                Lnz [block] = MAX (lnz_block, unz_block) ;
-            }
-
-            /* -------------------------------------------------------------- */
-            /* combine the klu row ordering with the symbolic pre-ordering */
-            /* -------------------------------------------------------------- */
-
-            PRINTF (("Pnum, 1-based:\n")) ;
-            for (k = 0 ; k < nk ; k++)
-            {
-                ASSERT (k + k1 < n) ;
-                ASSERT (Pblock [k] + k1 < n) ;
-                Pnum [k + k1] = P [Pblock [k] + k1] ;
-                PRINTF (("Pnum (%d + %d + 1 = %d) = %d + 1 = %d\n",
-                    k, k1, k+k1+1, Pnum [k+k1], Pnum [k+k1]+1)) ;
-            }
-
-            /* the local pivot row permutation Pblock is no longer needed */
         }
     }
     ASSERT (nzoff == Offp [n]) ;
     PRINTF (("\n------------------- Off diagonal entries:\n")) ;
-    ASSERT (KLU_valid (n, Offp, Offi, Offx)) ;
+    ASSERT (KLU_valid (n, Offp, Offi, (Entry *) Numeric->Offx)) ;
 
     Numeric->lnz = lnz ;
     Numeric->unz = unz ;
@@ -327,7 +551,7 @@ static void factor2
     }
 
     PRINTF (("\n------------------- Off diagonal entries, old:\n")) ;
-    ASSERT (KLU_valid (n, Offp, Offi, Offx)) ;
+    ASSERT (KLU_valid (n, Offp, Offi, (Entry *) Numeric->Offx)) ;
 
     /* apply the pivot row permutations to the off-diagonal entries */
     for (p = 0 ; p < nzoff ; p++)
@@ -337,12 +561,13 @@ static void factor2
     }
 
     PRINTF (("\n------------------- Off diagonal entries, new:\n")) ;
-    ASSERT (KLU_valid (n, Offp, Offi, Offx)) ;
+    ASSERT (KLU_valid (n, Offp, Offi, (Entry *) Numeric->Offx)) ;
 
 #ifndef NDEBUG
     {
         PRINTF (("\n ############# KLU_BTF_FACTOR done, nblocks %d\n",nblocks));
         Entry ss, *Udiag = Numeric->Udiag ;
+        Int k1, k2 ;
         for (block = 0 ; block < nblocks && Common->status == KLU_OK ; block++)
         {
             k1 = R [block] ;
@@ -451,6 +676,12 @@ KLU_numeric *KLU_factor         /* returns NULL if error, or a valid
     Numeric->n = n ;
     Numeric->nblocks = nblocks ;
     Numeric->nzoff = nzoff ;
+    Numeric->mixed = FALSE ;
+    Numeric->Dp = NULL ;
+    Numeric->Di = NULL ;
+    Numeric->Dx = NULL ;
+    Numeric->nzdiag = 0 ;
+    Numeric->Mwork = NULL ;
     Numeric->Pnum = KLU_malloc (n, sizeof (Int), Common) ;
     Numeric->Offp = KLU_malloc (n1, sizeof (Int), Common) ;
     Numeric->Offi = KLU_malloc (nzoff1, sizeof (Int), Common) ;
@@ -539,5 +770,11 @@ KLU_numeric *KLU_factor         /* returns NULL if error, or a valid
         Common->numerical_rank = n ;
         Common->singular_col = n ;
     }
+
+    /* hold L and U in single precision, if requested */
+    if (Numeric != NULL && Common->mixed && Common->status == KLU_OK)
+    {
+        KLU_mixed_demote (Ap, Ai, (Entry *) Ax, Symbolic, Numeric, Common) ;
+    }
     return (Numeric) ;
 }
@@ -64,6 +64,12 @@ Int KLU_free_numeric
 
     KLU_free (Numeric->Work, Numeric->worksize, 1, Common) ;
 
+    KLU_free (Numeric->Dp, n+1, sizeof (Int), Common) ;
+    KLU_free (Numeric->Di, Numeric->nzdiag+1, sizeof (Int), Common) ;
+    KLU_free (Numeric->Dx, Numeric->nzdiag+1, sizeof (Entry), Common) ;
+    KLU_free (Numeric->Mwork, n * (3 * sizeof (Entry) + sizeof (double)), 1,
+        Common) ;
+
     KLU_free (Numeric, 1, sizeof (KLU_numeric), Common) ;
 
     *NumericHandle = NULL ;
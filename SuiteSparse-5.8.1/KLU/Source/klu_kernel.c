@@ -4,7 +4,10 @@
 
 /* Sparse left-looking LU factorization, with partial pivoting.  Based on
  * Gilbert & Peierl's method, with a non-recursive DFS and with Eisenstat &
- * Liu's symmetric pruning.  No user-callable routines are in this file.
+ * Liu's symmetric pruning.  Optionally, adjacent columns of L with identical
+ * patterns are grouped into dense panels (see Common->panel_density), which
+ * are applied to X with a dense kernel.  No user-callable routines are in this
+ * file.
  */
 
 #include "klu_internal.h"
@@ -226,7 +229,8 @@ static void construct_column
     Int scale,      /* 0: no scaling, nonzero: scale the rows with Rs */
 
     /* inputs, modified on output */
-    Int Offp [ ],   /* off-diagonal matrix (modified by this routine) */
+    Int Offp [ ],   /* off-diagonal column pointers of the block, Offp [k]
+                     * defined on input, Offp [k+1] defined on output */
     Int Offi [ ],
     Entry Offx [ ]
 )
@@ -239,7 +243,7 @@ static void construct_column
     /* ---------------------------------------------------------------------- */
 
     kglobal = k + k1 ;          /* column k of the block is col kglobal of A */
-    poff = Offp [kglobal] ;     /* start of off-diagonal column */
+    poff = Offp [k] ;           /* start of off-diagonal column */
     oldcol = Q [kglobal] ;
     pend = Ap [oldcol+1] ;
 
@@ -289,7 +293,131 @@ static void construct_column
         }
     }
 
-    Offp [kglobal+1] = poff ;   /* start of the next col of off-diag part */
+    Offp [k+1] = poff ;         /* start of the next col of off-diag part */
+}
+
+
+/* ========================================================================== */
+/* === lsolve_panel ========================================================= */
+/* ========================================================================== */
+
+/* Forward solve with the columns j1 to j1+m-1 of L, which are adjacent columns
+ * of one dense panel (see panel_extend).  Column j1+i holds the pivot rows of
+ * columns j1+i+1 to j1+m-1 in its first m-1-i entries, followed by the rest of
+ * the pattern of the panel, in the same order in every column.  So once the
+ * small triangular system of columns j1+i to j1+i+3 is solved, these columns
+ * update the same rows, which are those of column j1+i+3.  This is done with
+ * up to 4 columns at a time, so that Li [p] and X [Li [p]] are loaded once for
+ * every 4 columns.  Each entry of X is updated in the same order as when the
+ * columns are applied one at a time, so the result is the same. */
+
+static void lsolve_panel
+(
+    /* input, not modified on output: */
+    Int j1,             /* first column of L */
+    Int m,              /* number of columns of L */
+    Int Piv [ ],        /* size m, Piv [i] is the pivot row of column j1+i */
+    Unit *LU,           /* LU factors (pattern and values) */
+    Int Lip [ ],        /* size n, Lip [k] is position in LU of column k of L */
+    Int Llen [ ],       /* size n, Llen [k] = # nonzeros in column k of L */
+
+    /* input/output: */
+    Entry X [ ]         /* size n */
+)
+{
+    Entry x0, x1, x2, x3, xr ;
+    Entry *L0, *L1, *L2, *L3 ;
+    Int *Li ;
+    Int i, p, len, nc ;
+
+    for (i = 0 ; i < m ; i += nc)
+    {
+        nc = MIN (m-i, 4) ;
+        switch (nc)
+        {
+
+            case 1:
+
+                GET_POINTER (LU, Lip, Llen, Li, L0, j1+i, len) ;
+                x0 = X [Piv [i]] ;
+                for (p = 0 ; p < len ; p++)
+                {
+                    /* X [Li [p]] -= L0 [p] * x0 ; */
+                    MULT_SUB (X [Li [p]], L0 [p], x0) ;
+                }
+                break ;
+
+            case 2:
+
+                GET_POINTER (LU, Lip, Llen, Li, L0, j1+i, len) ;
+                GET_POINTER (LU, Lip, Llen, Li, L1, j1+i+1, len) ;
+                x0 = X [Piv [i]] ;
+                MULT_SUB (X [Piv [i+1]], L0 [0], x0) ;
+                x1 = X [Piv [i+1]] ;
+                L0 += 1 ;
+                for (p = 0 ; p < len ; p++)
+                {
+                    xr = X [Li [p]] ;
+                    MULT_SUB (xr, L0 [p], x0) ;
+                    MULT_SUB (xr, L1 [p], x1) ;
+                    X [Li [p]] = xr ;
+                }
+                break ;
+
+            case 3:
+
+                GET_POINTER (LU, Lip, Llen, Li, L0, j1+i, len) ;
+                GET_POINTER (LU, Lip, Llen, Li, L1, j1+i+1, len) ;
+                GET_POINTER (LU, Lip, Llen, Li, L2, j1+i+2, len) ;
+                x0 = X [Piv [i]] ;
+                MULT_SUB (X [Piv [i+1]], L0 [0], x0) ;
+                MULT_SUB (X [Piv [i+2]], L0 [1], x0) ;
+                x1 = X [Piv [i+1]] ;
+                MULT_SUB (X [Piv [i+2]], L1 [0], x1) ;
+                x2 = X [Piv [i+2]] ;
+                L0 += 2 ;
+                L1 += 1 ;
+                for (p = 0 ; p < len ; p++)
+                {
+                    xr = X [Li [p]] ;
+                    MULT_SUB (xr, L0 [p], x0) ;
+                    MULT_SUB (xr, L1 [p], x1) ;
+                    MULT_SUB (xr, L2 [p], x2) ;
+                    X [Li [p]] = xr ;
+                }
+                break ;
+
+            case 4:
+
+                GET_POINTER (LU, Lip, Llen, Li, L0, j1+i, len) ;
+                GET_POINTER (LU, Lip, Llen, Li, L1, j1+i+1, len) ;
+                GET_POINTER (LU, Lip, Llen, Li, L2, j1+i+2, len) ;
+                GET_POINTER (LU, Lip, Llen, Li, L3, j1+i+3, len) ;
+                x0 = X [Piv [i]] ;
+                MULT_SUB (X [Piv [i+1]], L0 [0], x0) ;
+                MULT_SUB (X [Piv [i+2]], L0 [1], x0) ;
+                MULT_SUB (X [Piv [i+3]], L0 [2], x0) ;
+                x1 = X [Piv [i+1]] ;
+                MULT_SUB (X [Piv [i+2]], L1 [0], x1) ;
+                MULT_SUB (X [Piv [i+3]], L1 [1], x1) ;
+                x2 = X [Piv [i+2]] ;
+                MULT_SUB (X [Piv [i+3]], L2 [0], x2) ;
+                x3 = X [Piv [i+3]] ;
+                L0 += 3 ;
+                L1 += 2 ;
+                L2 += 1 ;
+                for (p = 0 ; p < len ; p++)
+                {
+                    xr = X [Li [p]] ;
+                    MULT_SUB (xr, L0 [p], x0) ;
+                    MULT_SUB (xr, L1 [p], x1) ;
+                    MULT_SUB (xr, L2 [p], x2) ;
+                    MULT_SUB (xr, L3 [p], x3) ;
+                    X [Li [p]] = xr ;
+                }
+                break ;
+        }
+    }
 }
 
 
@@ -300,7 +428,11 @@ static void construct_column
 /* Computes the numerical values of x, for the solution of Lx=b.  Note that x
  * may include explicit zeros if numerical cancelation occurs.  L is assumed
  * to be unit-diagonal, with possibly unsorted columns (but the first entry in
- * the column must always be the diagonal entry). */
+ * the column must always be the diagonal entry).  Adjacent columns of a dense
+ * panel that are also adjacent in the topological order are applied together
+ * by lsolve_panel.  Columns of a panel need not be adjacent in the
+ * topological order, since another column may have to update a pivot row of
+ * the panel first; these are applied one at a time. */
 
 static void lsolve_numeric
 (
@@ -313,6 +445,8 @@ static void lsolve_numeric
     Int top,            /* top of stack on input */
     Int n,              /* A is n-by-n */
     Int Llen [ ],       /* size n, Llen [k] = # nonzeros in column k of L */
+    Int Super [ ],      /* Super [j] is the first column of the dense panel
+                         * that contains column j, or NULL if no panels */
 
     /* output, must be zero on input: */
     Entry X [ ] /* size n, initially zero.  On output,
@@ -324,7 +458,7 @@ static void lsolve_numeric
     Entry xj ;
     Entry *Lx ;
     Int *Li ;
-    Int p, s, j, jnew, len ;
+    Int p, s, j, jnew, len, m ;
 
     /* solve Lx=b */
     for (s = top ; s < n ; s++)
@@ -333,6 +467,21 @@ static void lsolve_numeric
         j = Stack [s] ;
         jnew = Pinv [j] ;
         ASSERT (jnew >= 0) ;
+        if (Super != NULL)
+        {
+            /* find the adjacent columns of the same panel */
+            for (m = 1 ; s+m < n ; m++)
+            {
+                p = Pinv [Stack [s+m]] ;
+                if (p != jnew+m || Super [p] != Super [jnew]) break ;
+            }
+            if (m > 1)
+            {
+                lsolve_panel (jnew, m, Stack + s, LU, Lip, Llen, X) ;
+                s += m-1 ;
+                continue ;
+            }
+        }
         xj = X [j] ;
         GET_POINTER (LU, Lip, Llen, Li, Lx, jnew, len) ;
         ASSERT (Lip [jnew] <= Lip [jnew+1]) ;
@@ -507,6 +656,106 @@ static Int lpivot
 }
 
 
+/* ========================================================================== */
+/* === panel_extend ========================================================= */
+/* ========================================================================== */
+
+/* Adds column k of L to the dense panel of column k-1, if the pattern of
+ * column k is the pattern of column k-1 less the pivot row of column k.  The
+ * columns f to k-1 of the panel keep the pivot rows of the later columns of
+ * the panel first, followed by the remaining rows in the same order in every
+ * column (see lsolve_panel).  To add column k, its pivot row is moved to the
+ * front of the remaining rows of each column of the panel, and the entries of
+ * column k are put in the order of the remaining rows.  Columns of a panel are
+ * never pruned, so they keep this order.  Column k-1 is the pivot row of
+ * column k followed by the pattern of column k, so the DFS only needs to scan
+ * its first entry (this takes the place of pruning).  X is zero on input and
+ * output. */
+
+static void panel_extend
+(
+    Int k,              /* column of L to add to the panel */
+    Int pivrow,         /* pivot row of column k */
+
+    /* input, not modified on output: */
+    Int Flag [ ],       /* Flag [i] == k if i is in the pattern of column k */
+    Int Lip [ ],        /* size n, column pointers for L */
+    Int Llen [ ],       /* size n, column length of L */
+
+    /* input/output: */
+    Unit *LU,           /* LU factors (pattern and values) */
+    Int Super [ ],      /* Super [j] is the first column of the panel of j */
+    Int Lpend [ ],      /* Lpend [j] marks symmetric pruning point for L(:,j) */
+
+    /* workspace, zero on input and output */
+    Entry X [ ]
+)
+{
+    Entry x, *Lx, *Lkx ;
+    Int *Li, *Lki ;
+    Int i, j, p, q, f, len, klen ;
+
+    GET_POINTER (LU, Lip, Llen, Li, Lx, k-1, len) ;
+    GET_POINTER (LU, Lip, Llen, Lki, Lkx, k, klen) ;
+    if (len != klen + 1)
+    {
+        return ;
+    }
+
+    /* find the pivot row in column k-1, and check the pattern of column k */
+    q = EMPTY ;
+    for (p = 0 ; p < len ; p++)
+    {
+        i = Li [p] ;
+        if (i == pivrow)
+        {
+            q = p ;
+        }
+        else if (Flag [i] != k)
+        {
+            /* row i of column k-1 is not in column k */
+            return ;
+        }
+    }
+    if (q == EMPTY)
+    {
+        return ;
+    }
+
+    /* move the pivot row to the front of the remaining rows of the panel */
+    f = Super [k-1] ;
+    for (j = f ; j < k ; j++)
+    {
+        GET_POINTER (LU, Lip, Llen, Li, Lx, j, len) ;
+        p = k-1-j ;
+        ASSERT (Li [p+q] == pivrow) ;
+        i = Li [p] ;
+        Li [p] = Li [p+q] ;
+        Li [p+q] = i ;
+        x = Lx [p] ;
+        Lx [p] = Lx [p+q] ;
+        Lx [p+q] = x ;
+    }
+
+    /* put column k in the order of the remaining rows of column k-1 */
+    GET_POINTER (LU, Lip, Llen, Li, Lx, k-1, len) ;
+    for (p = 0 ; p < klen ; p++)
+    {
+        X [Lki [p]] = Lkx [p] ;
+    }
+    for (p = 0 ; p < klen ; p++)
+    {
+        i = Li [p+1] ;
+        Lki [p] = i ;
+        Lkx [p] = X [i] ;
+        CLEAR (X [i]) ;
+    }
+    Super [k] = f ;
+    Lpend [k-1] = 1 ;
+    PRINTF (("column %d added to the panel at %d\n", k, f)) ;
+}
+
+
 /* ========================================================================== */
 /* === prune ================================================================ */
 /* ========================================================================== */
@@ -530,7 +779,8 @@ static void prune
     Int Uip [ ],        /* size n, column pointers for U */
     Int Lip [ ],        /* size n, column pointers for L */
     Int Ulen [ ],       /* size n, column length of U */
-    Int Llen [ ]        /* size n, column length of L */
+    Int Llen [ ],       /* size n, column length of L */
+    Int Super [ ]       /* first column of the panel of each column, or NULL */
 )
 {
     Entry x ;
@@ -547,6 +797,11 @@ static void prune
         ASSERT (j < k) ;
         PRINTF (("%d is pruned: %d. Lpend[j] %d Lip[j+1] %d\n",
             j, Lpend [j] != EMPTY, Lpend [j], Lip [j+1])) ;
+        if (Super != NULL && (Super [j] != j || Super [j+1] == j))
+        {
+            /* column j is in a dense panel, which must keep its order */
+            continue ;
+        }
         if (Lpend [j] == EMPTY)
         {
             /* scan column j of L for the pivot row */
@@ -657,6 +912,8 @@ size_t KLU_kernel   /* final size of LU on output */
 
     /* other workspace: */
     Int Lpend [ ],                  /* size n workspace, for pruning only */
+    Int Super [ ],                  /* size n workspace, for dense panels only,
+                                     * or NULL */
 
     /* inputs, not modified on output */
     Int k1,             /* the block of A is from k1 to k2-1 */
@@ -664,7 +921,8 @@ size_t KLU_kernel   /* final size of LU on output */
     double Rs [ ],      /* scale factors for A */
 
     /* inputs, modified on output */
-    Int Offp [ ],   /* off-diagonal matrix (modified by this routine) */
+    Int Offp [ ],   /* size n+1, off-diagonal column pointers of the block,
+                     * Offp [0] defined on input (modified by this routine) */
     Int Offi [ ],
     Entry Offx [ ],
     /* --------------- */
@@ -672,7 +930,7 @@ size_t KLU_kernel   /* final size of LU on output */
 )
 {
     Entry pivot ;
-    double abs_pivot, xsize, nunits, tol, memgrow ;
+    double abs_pivot, xsize, nunits, tol, memgrow, panel_density ;
     Entry *Ux ;
     Int *Li, *Ui ;
     Unit *LU ;          /* LU factors (pattern and values) */
@@ -687,6 +945,7 @@ size_t KLU_kernel   /* final size of LU on output */
     scale = Common->scale ;
     tol = Common->tol ;
     memgrow = Common->memgrow ;
+    panel_density = Common->panel_density ;
     *lnz = 0 ;
     *unz = 0 ;
     CLEAR (pivot) ;
@@ -724,9 +983,6 @@ size_t KLU_kernel   /* final size of LU on output */
         P [k] = k ;
         Pinv [k] = FLIP (k) ;   /* mark all rows as non-pivotal */
     }
-    /* initialize the construction of the off-diagonal matrix */
-    Offp [0] = 0 ;
-
     /* P [k] = row means that UNFLIP (Pinv [row]) = k, and visa versa.
      * If row is pivotal, then Pinv [row] >= 0.  A row is initially "flipped"
      * (Pinv [k] < EMPTY), and then marked "unflipped" when it becomes
@@ -841,7 +1097,7 @@ size_t KLU_kernel   /* final size of LU on output */
         /* compute the numerical values of the kth column (s = L \ A (:,k)) */
         /* ------------------------------------------------------------------ */
 
-        lsolve_numeric (Pinv, LU, Stack, Lip, top, n, Llen, X) ;
+        lsolve_numeric (Pinv, LU, Stack, Lip, top, n, Llen, Super, X) ;
 
 #ifndef NDEBUG
         for (p = top ; p < n ; p++)
@@ -959,11 +1215,26 @@ size_t KLU_kernel   /* final size of LU on output */
         }
 #endif
 
+        /* ------------------------------------------------------------------ */
+        /* dense panels */
+        /* ------------------------------------------------------------------ */
+
+        if (Super != NULL)
+        {
+            Super [k] = k ;
+            if (k > 0 && Llen [k] > 0 &&
+                Llen [k] >= panel_density * (double) (n-k-1))
+            {
+                panel_extend (k, pivrow, Flag, Lip, Llen, LU, Super, Lpend,
+                    X) ;
+            }
+        }
+
         /* ------------------------------------------------------------------ */
         /* symmetric pruning */
         /* ------------------------------------------------------------------ */
 
-        prune (Lpend, Pinv, k, pivrow, LU, Uip, Lip, Ulen, Llen) ;
+        prune (Lpend, Pinv, k, pivrow, LU, Uip, Lip, Ulen, Llen, Super) ;
 
         *lnz += Llen [k] + 1 ; /* 1 added to lnz for diagonal */
         *unz += Ulen [k] + 1 ; /* 1 added to unz for diagonal */
@@ -7,6 +7,9 @@
  * KLU_malloc                   malloc wrapper
  * KLU_free                     free wrapper
  * KLU_realloc                  realloc wrapper
+ *
+ * If Common->arena is not NULL, the memory is obtained from the arena instead
+ * of the heap (see klu_arena.c).
  */
 
 #include "klu_internal.h"
@@ -88,7 +91,16 @@ void *KLU_malloc        /* returns pointer to the newly malloc'd block */
     else
     {
         /* call malloc, or its equivalent */
-        p = SuiteSparse_malloc (n, size) ;
+        if (Common->arena != NULL)
+        {
+            Int ok = TRUE ;
+            size_t s = KLU_mult_size_t (MAX (1,n), size, &ok) ;
+            p = ok ? KLU_arena_malloc (s, Common) : NULL ;
+        }
+        else
+        {
+            p = SuiteSparse_malloc (n, size) ;
+        }
         if (p == NULL)
         {
             /* failure: out of memory */
@@ -129,7 +141,14 @@ void *KLU_free          /* always returns NULL */
     {
         /* only free the object if the pointer is not NULL */
         /* call free, or its equivalent */
-        SuiteSparse_free (p) ;
+        if (Common->arena != NULL)
+        {
+            KLU_arena_free (p, Common) ;
+        }
+        else
+        {
+            SuiteSparse_free (p) ;
+        }
         Common->memusage -= (MAX (1,n) * size) ;
     }
     /* return NULL, and the caller should assign this to p.  This avoids
@@ -198,7 +217,18 @@ void *KLU_realloc       /* returns pointer to reallocated block */
     {
         /* The object exists, and is changing to some other nonzero size. */
         /* call realloc, or its equivalent */
-        pnew = SuiteSparse_realloc (nnew, nold, size, p, &ok) ;
+        if (Common->arena != NULL)
+        {
+            Int aok = TRUE ;
+            size_t snew = KLU_mult_size_t (MAX (1,nnew), size, &aok) ;
+            size_t sold = KLU_mult_size_t (MAX (1,nold), size, &aok) ;
+            pnew = aok ? KLU_arena_realloc (snew, sold, p, &aok, Common) : p ;
+            ok = (int) aok ;
+        }
+        else
+        {
+            pnew = SuiteSparse_realloc (nnew, nold, size, p, &ok) ;
+        }
         if (ok)
         {
             /* success: return the new p and change the size of the block */
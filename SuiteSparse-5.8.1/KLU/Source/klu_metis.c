@@ -0,0 +1,245 @@
+/* ========================================================================== */
+/* === KLU_metis ============================================================ */
+/* ========================================================================== */
+
+/* Order a block of the BTF form with METIS nested dissection (ordering 4 in
+ * klu_analyze).  METIS_NodeND is applied to the graph of C+C', where C is the
+ * block.  Also returns estimates of nnz(L) and of the flop count, computed
+ * from the elimination tree of C+C' in the same way as AMD's, so that the
+ * orderings can be compared.  Requires KLU to be compiled with METIS; if it
+ * is compiled with -DNPARTITION, KLU_INVALID is returned.  No user-callable
+ * routines are in this file.
+ */
+
+#include "klu_internal.h"
+
+#ifndef NPARTITION
+#include "metis.h"
+#endif
+
+Int KLU_metis           /* returns KLU_OK or < 0 if error */
+(
+    /* inputs, not modified */
+    Int n,              /* C is n-by-n */
+    Int Cp [ ],         /* size n+1, column pointers */
+    Int Ci [ ],         /* size nz, row indices */
+
+    /* outputs, not defined on input */
+    Int Perm [ ],       /* size n, fill-reducing ordering */
+    double *lnz,        /* estimate of nnz(L), including the diagonal */
+    double *flops,      /* estimate of the flop count of the factorization */
+
+    KLU_common *Common
+)
+{
+#ifndef NPARTITION
+    double lnz1, flops1, c ;
+    idx_t options [METIS_NOPTIONS], *Mp, *Mi, *Mperm, *Miperm, nn ;
+    Int *Parent, *Ancestor, *Flag, *Lcount ;
+    Int i, j, k, p, pnew, r, next, nz, result ;
+
+    nz = Cp [n] ;
+    *lnz = EMPTY ;
+    *flops = EMPTY ;
+
+    /* METIS is compiled with a fixed integer size */
+    if ((double) n >= (double) IDX_MAX || 2 * (double) nz >= (double) IDX_MAX)
+    {
+        return (KLU_TOO_LARGE) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* allocate workspace */
+    /* ---------------------------------------------------------------------- */
+
+    Mp = KLU_malloc (n+1, sizeof (idx_t), Common) ;
+    Mi = KLU_malloc (2*nz+1, sizeof (idx_t), Common) ;
+    Mperm = KLU_malloc (n, sizeof (idx_t), Common) ;
+    Miperm = KLU_malloc (n, sizeof (idx_t), Common) ;
+    Flag = KLU_malloc (4*n, sizeof (Int), Common) ;
+    if (Common->status < KLU_OK)
+    {
+        KLU_free (Mp, n+1, sizeof (idx_t), Common) ;
+        KLU_free (Mi, 2*nz+1, sizeof (idx_t), Common) ;
+        KLU_free (Mperm, n, sizeof (idx_t), Common) ;
+        KLU_free (Miperm, n, sizeof (idx_t), Common) ;
+        KLU_free (Flag, 4*n, sizeof (Int), Common) ;
+        return (KLU_OUT_OF_MEMORY) ;
+    }
+    Parent = Flag + n ;
+    Ancestor = Flag + 2*n ;
+    Lcount = Flag + 3*n ;
+
+    /* ---------------------------------------------------------------------- */
+    /* construct the graph of C+C', with no diagonal or duplicate entries */
+    /* ---------------------------------------------------------------------- */
+
+    for (i = 0 ; i <= n ; i++)
+    {
+        Mp [i] = 0 ;
+    }
+    for (j = 0 ; j < n ; j++)
+    {
+        for (p = Cp [j] ; p < Cp [j+1] ; p++)
+        {
+            i = Ci [p] ;
+            if (i != j)
+            {
+                Mp [i+1]++ ;
+                Mp [j+1]++ ;
+            }
+        }
+    }
+    for (i = 0 ; i < n ; i++)
+    {
+        Mp [i+1] += Mp [i] ;
+        Flag [i] = Mp [i] ;
+    }
+    for (j = 0 ; j < n ; j++)
+    {
+        for (p = Cp [j] ; p < Cp [j+1] ; p++)
+        {
+            i = Ci [p] ;
+            if (i != j)
+            {
+                Mi [Flag [i]++] = j ;
+                Mi [Flag [j]++] = i ;
+            }
+        }
+    }
+    for (i = 0 ; i < n ; i++)
+    {
+        Flag [i] = EMPTY ;
+    }
+    pnew = 0 ;
+    for (i = 0 ; i < n ; i++)
+    {
+        p = Mp [i] ;
+        Mp [i] = pnew ;
+        for ( ; p < Mp [i+1] ; p++)
+        {
+            j = Mi [p] ;
+            if (Flag [j] != i)
+            {
+                Flag [j] = i ;
+                Mi [pnew++] = j ;
+            }
+        }
+    }
+    Mp [n] = pnew ;
+
+    /* ---------------------------------------------------------------------- */
+    /* order the graph */
+    /* ---------------------------------------------------------------------- */
+
+    if (Mp [n] == 0)
+    {
+        /* METIS_NodeND fails if the graph has no edges */
+        for (k = 0 ; k < n ; k++)
+        {
+            Mperm [k] = k ;
+            Miperm [k] = k ;
+        }
+        result = METIS_OK ;
+    }
+    else
+    {
+        METIS_SetDefaultOptions (options) ;
+        nn = n ;
+        result = METIS_NodeND (&nn, Mp, Mi, NULL, options, Mperm, Miperm) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* estimate nnz(L) and the flop count */
+    /* ---------------------------------------------------------------------- */
+
+    if (result == METIS_OK)
+    {
+        for (k = 0 ; k < n ; k++)
+        {
+            Perm [k] = Mperm [k] ;
+        }
+
+        /* elimination tree of the permuted C+C' (Liu's algorithm) */
+        for (k = 0 ; k < n ; k++)
+        {
+            Parent [k] = EMPTY ;
+            Ancestor [k] = EMPTY ;
+            i = Mperm [k] ;
+            for (p = Mp [i] ; p < Mp [i+1] ; p++)
+            {
+                for (r = Miperm [Mi [p]] ; r != EMPTY && r < k ; r = next)
+                {
+                    next = Ancestor [r] ;
+                    Ancestor [r] = k ;
+                    if (next == EMPTY)
+                    {
+                        Parent [r] = k ;
+                    }
+                }
+            }
+        }
+
+        /* row k of L is the union of the paths from each entry of row k of
+         * the lower triangular part up to k in the elimination tree */
+        for (k = 0 ; k < n ; k++)
+        {
+            Flag [k] = EMPTY ;
+            Lcount [k] = 0 ;
+        }
+        for (k = 0 ; k < n ; k++)
+        {
+            Flag [k] = k ;
+            i = Mperm [k] ;
+            for (p = Mp [i] ; p < Mp [i+1] ; p++)
+            {
+                r = Miperm [Mi [p]] ;
+                if (r < k)
+                {
+                    for ( ; Flag [r] != k ; r = Parent [r])
+                    {
+                        Flag [r] = k ;
+                        Lcount [r]++ ;
+                    }
+                }
+            }
+        }
+
+        /* same as AMD: lnz = n + sum (Lcount), flops = 2*sum (Lcount^2) +
+         * sum (Lcount) */
+        lnz1 = n ;
+        flops1 = 0 ;
+        for (k = 0 ; k < n ; k++)
+        {
+            c = Lcount [k] ;
+            lnz1 += c ;
+            flops1 += 2 * c * c + c ;
+        }
+        *lnz = lnz1 ;
+        *flops = flops1 ;
+    }
+
+    KLU_free (Mp, n+1, sizeof (idx_t), Common) ;
+    KLU_free (Mi, 2*nz+1, sizeof (idx_t), Common) ;
+    KLU_free (Mperm, n, sizeof (idx_t), Common) ;
+    KLU_free (Miperm, n, sizeof (idx_t), Common) ;
+    KLU_free (Flag, 4*n, sizeof (Int), Common) ;
+
+    if (result == METIS_ERROR_MEMORY)
+    {
+        return (KLU_OUT_OF_MEMORY) ;
+    }
+    return ((result == METIS_OK) ? KLU_OK : KLU_INVALID) ;
+
+#else
+    /* METIS is not available */
+    (void) n ;
+    (void) Cp ;
+    (void) Ci ;
+    (void) Perm ;
+    (void) lnz ;
+    (void) flops ;
+    (void) Common ;
+    return (KLU_INVALID) ;
+#endif
+}
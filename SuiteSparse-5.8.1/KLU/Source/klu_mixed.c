@@ -0,0 +1,1248 @@
+/* ========================================================================== */
+/* === KLU_mixed ============================================================ */
+/* ========================================================================== */
+
+/* Mixed precision factorization and solve (see Common->mixed).  The entries
+ * of L and U (excluding the diagonal of U) are held in single precision,
+ * which halves the memory for the values of L and U, and the memory traffic
+ * of KLU_refactor and KLU_solve.  All arithmetic is done in double precision;
+ * only the stored values are rounded.
+ *
+ * The entries of the diagonal blocks of the scaled and permuted matrix,
+ * M = P*(R\A)*Q, are kept in double precision in Numeric->Dp, Di, and Dx
+ * (the entries of the off-diagonal blocks are already in Numeric->Offx).
+ * KLU_solve and KLU_tsolve then solve My=c with the single precision factors
+ * and improve y with iterative refinement, until the componentwise backward
+ * error of y is at the level of the double precision roundoff.  If the
+ * refinement stalls before that (the matrix is too ill-conditioned for the
+ * single precision factors), the factors are converted back to double
+ * precision by refactorizing M with the same pivot ordering, Numeric->mixed
+ * is set to FALSE, and the system is solved as if Common->mixed were FALSE.
+ *
+ * KLU_mixed_demote:  converts the factors computed by KLU_factor to single
+ *      precision, if the memory saved on L and U exceeds the memory needed
+ *      for D and the workspace of the solve.
+ * KLU_mixed_refactor_block:  KLU_refactor for one block of the BTF form, if
+ *      Numeric->mixed is TRUE.
+ * KLU_mixed_solve:  KLU_solve and KLU_tsolve, if Numeric->mixed is TRUE.
+ *
+ * No user-callable routines are in this file.
+ */
+
+#include "klu_internal.h"
+#include <float.h>
+
+/* maximum number of steps of iterative refinement */
+#define REFINE_MAX 10
+
+/* refinement that stalls at a componentwise backward error above this
+ * tolerance triggers the conversion of the factors to double precision */
+#define REFINE_TOL (1e3 * DBL_EPSILON)
+
+/* size of Numeric->Mwork, in bytes: C, Y, and Rw, of size n Entry's each,
+ * and W, of size n double's */
+#define MWORK_SIZE(n) ((n) * (3 * sizeof (Entry) + sizeof (double)))
+
+
+/* ========================================================================== */
+/* === lsolve, usolve, ltsolve, utsolve ===================================== */
+/* ========================================================================== */
+
+/* Same as KLU_lsolve, KLU_usolve, KLU_ltsolve, and KLU_utsolve for a single
+ * right-hand-side, with the entries of L and U in single precision. */
+
+static void lsolve
+(
+    Int n,
+    Int Lip [ ],
+    Int Llen [ ],
+    Unit LU [ ],
+    Entry X [ ]
+)
+{
+    Entry x, lik ;
+    SEntry *Ls ;
+    Int *Li ;
+    Int k, p, len ;
+
+    for (k = 0 ; k < n ; k++)
+    {
+        x = X [k] ;
+        GET_S_POINTER (LU, Lip, Llen, Li, Ls, k, len) ;
+        for (p = 0 ; p < len ; p++)
+        {
+            /* X [Li [p]] -= Ls [p] * x */
+            TO_DOUBLE (lik, Ls [p]) ;
+            MULT_SUB (X [Li [p]], lik, x) ;
+        }
+    }
+}
+
+static void usolve
+(
+    Int n,
+    Int Uip [ ],
+    Int Ulen [ ],
+    Unit LU [ ],
+    Entry Udiag [ ],
+    Entry X [ ]
+)
+{
+    Entry x, uik ;
+    SEntry *Us ;
+    Int *Ui ;
+    Int k, p, len ;
+
+    for (k = n-1 ; k >= 0 ; k--)
+    {
+        GET_S_POINTER (LU, Uip, Ulen, Ui, Us, k, len) ;
+        /* x = X [k] / Udiag [k] */
+        DIV (x, X [k], Udiag [k]) ;
+        X [k] = x ;
+        for (p = 0 ; p < len ; p++)
+        {
+            /* X [Ui [p]] -= Us [p] * x */
+            TO_DOUBLE (uik, Us [p]) ;
+            MULT_SUB (X [Ui [p]], uik, x) ;
+        }
+    }
+}
+
+static void ltsolve
+(
+    Int n,
+    Int Lip [ ],
+    Int Llen [ ],
+    Unit LU [ ],
+#ifdef COMPLEX
+    Int conj_solve,
+#endif
+    Entry X [ ]
+)
+{
+    Entry x, lik ;
+    SEntry *Ls ;
+    Int *Li ;
+    Int k, p, len ;
+
+    for (k = n-1 ; k >= 0 ; k--)
+    {
+        GET_S_POINTER (LU, Lip, Llen, Li, Ls, k, len) ;
+        x = X [k] ;
+        for (p = 0 ; p < len ; p++)
+        {
+            TO_DOUBLE (lik, Ls [p]) ;
+#ifdef COMPLEX
+            if (conj_solve)
+            {
+                /* x -= CONJ (Ls [p]) * X [Li [p]] */
+                MULT_SUB_CONJ (x, X [Li [p]], lik) ;
+            }
+            else
+#endif
+            {
+                /* x -= Ls [p] * X [Li [p]] */
+                MULT_SUB (x, lik, X [Li [p]]) ;
+            }
+        }
+        X [k] = x ;
+    }
+}
+
+static void utsolve
+(
+    Int n,
+    Int Uip [ ],
+    Int Ulen [ ],
+    Unit LU [ ],
+    Entry Udiag [ ],
+#ifdef COMPLEX
+    Int conj_solve,
+#endif
+    Entry X [ ]
+)
+{
+    Entry x, uik, ukk ;
+    SEntry *Us ;
+    Int *Ui ;
+    Int k, p, len ;
+
+    for (k = 0 ; k < n ; k++)
+    {
+        GET_S_POINTER (LU, Uip, Ulen, Ui, Us, k, len) ;
+        x = X [k] ;
+        for (p = 0 ; p < len ; p++)
+        {
+            TO_DOUBLE (uik, Us [p]) ;
+#ifdef COMPLEX
+            if (conj_solve)
+            {
+                /* x -= CONJ (Us [p]) * X [Ui [p]] */
+                MULT_SUB_CONJ (x, X [Ui [p]], uik) ;
+            }
+            else
+#endif
+            {
+                /* x -= Us [p] * X [Ui [p]] */
+                MULT_SUB (x, uik, X [Ui [p]]) ;
+            }
+        }
+#ifdef COMPLEX
+        if (conj_solve)
+        {
+            CONJ (ukk, Udiag [k]) ;
+        }
+        else
+#endif
+        {
+            ukk = Udiag [k] ;
+        }
+        DIV (X [k], x, ukk) ;
+    }
+}
+
+
+/* ========================================================================== */
+/* === block_solve ========================================================== */
+/* ========================================================================== */
+
+/* Solve My=x, or M'y=x if transpose is TRUE, with the single precision
+ * factors.  X is overwritten with y. */
+
+static void block_solve
+(
+    KLU_symbolic *Symbolic,
+    KLU_numeric *Numeric,
+    Int transpose,
+#ifdef COMPLEX
+    Int conj_solve,
+#endif
+    Entry X [ ]
+)
+{
+    Entry x, s, offik ;
+    Entry *Offx, *Udiag ;
+    Int *R, *Offp, *Offi, *Lip, *Uip, *Llen, *Ulen ;
+    Unit **LUbx ;
+    Int k1, k2, nk, k, block, nblocks, p, pend ;
+
+    nblocks = Symbolic->nblocks ;
+    R = Symbolic->R ;
+    Offp = Numeric->Offp ;
+    Offi = Numeric->Offi ;
+    Offx = (Entry *) Numeric->Offx ;
+    Lip  = Numeric->Lip ;
+    Llen = Numeric->Llen ;
+    Uip  = Numeric->Uip ;
+    Ulen = Numeric->Ulen ;
+    LUbx = (Unit **) Numeric->LUbx ;
+    Udiag = Numeric->Udiag ;
+
+    if (!transpose)
+    {
+        for (block = nblocks-1 ; block >= 0 ; block--)
+        {
+            k1 = R [block] ;
+            k2 = R [block+1] ;
+            nk = k2 - k1 ;
+            if (nk == 1)
+            {
+                s = Udiag [k1] ;
+                DIV (x, X [k1], s) ;
+                X [k1] = x ;
+            }
+            else
+            {
+                lsolve (nk, Lip + k1, Llen + k1, LUbx [block], X + k1) ;
+                usolve (nk, Uip + k1, Ulen + k1, LUbx [block], Udiag + k1,
+                    X + k1) ;
+            }
+            if (block > 0)
+            {
+                for (k = k1 ; k < k2 ; k++)
+                {
+                    pend = Offp [k+1] ;
+                    x = X [k] ;
+                    for (p = Offp [k] ; p < pend ; p++)
+                    {
+                        MULT_SUB (X [Offi [p]], Offx [p], x) ;
+                    }
+                }
+            }
+        }
+    }
+    else
+    {
+        for (block = 0 ; block < nblocks ; block++)
+        {
+            k1 = R [block] ;
+            k2 = R [block+1] ;
+            nk = k2 - k1 ;
+            if (block > 0)
+            {
+                for (k = k1 ; k < k2 ; k++)
+                {
+                    pend = Offp [k+1] ;
+                    x = X [k] ;
+                    for (p = Offp [k] ; p < pend ; p++)
+                    {
+#ifdef COMPLEX
+                        if (conj_solve)
+                        {
+                            CONJ (offik, Offx [p]) ;
+                        }
+                        else
+#endif
+                        {
+                            offik = Offx [p] ;
+                        }
+                        MULT_SUB (x, offik, X [Offi [p]]) ;
+                    }
+                    X [k] = x ;
+                }
+            }
+            if (nk == 1)
+            {
+#ifdef COMPLEX
+                if (conj_solve)
+                {
+                    CONJ (s, Udiag [k1]) ;
+                }
+                else
+#endif
+                {
+                    s = Udiag [k1] ;
+                }
+                DIV (x, X [k1], s) ;
+                X [k1] = x ;
+            }
+            else
+            {
+                utsolve (nk, Uip + k1, Ulen + k1, LUbx [block], Udiag + k1,
+#ifdef COMPLEX
+                    conj_solve,
+#endif
+                    X + k1) ;
+                ltsolve (nk, Lip + k1, Llen + k1, LUbx [block],
+#ifdef COMPLEX
+                    conj_solve,
+#endif
+                    X + k1) ;
+            }
+        }
+    }
+}
+
+
+/* ========================================================================== */
+/* === residual ============================================================= */
+/* ========================================================================== */
+
+/* Compute Rw = C - M*Y (or C - M'*Y if transpose is TRUE) in double precision
+ * and return the componentwise backward error of Y,
+ * max (|Rw [i]| / (|M|*|Y| + |C|) [i]).  W is workspace of size n. */
+
+static double residual
+(
+    KLU_numeric *Numeric,
+    Int transpose,
+#ifdef COMPLEX
+    Int conj_solve,
+#endif
+    Entry C [ ],
+    Entry Y [ ],
+    Entry Rw [ ],
+    double W [ ]
+)
+{
+    Entry yk, r, mik ;
+    Entry *Dx, *Offx ;
+    double omega, a, b ;
+    Int *Dp, *Di, *Offp, *Offi ;
+    Int n, k, p, pend, i ;
+
+    n = Numeric->n ;
+    Dp = Numeric->Dp ;
+    Di = Numeric->Di ;
+    Dx = (Entry *) Numeric->Dx ;
+    Offp = Numeric->Offp ;
+    Offi = Numeric->Offi ;
+    Offx = (Entry *) Numeric->Offx ;
+
+    if (!transpose)
+    {
+        /* M = D + Off is held by columns, so scatter the products */
+        for (k = 0 ; k < n ; k++)
+        {
+            Rw [k] = C [k] ;
+            APPROX_ABS (W [k], C [k]) ;
+        }
+        for (k = 0 ; k < n ; k++)
+        {
+            yk = Y [k] ;
+            APPROX_ABS (b, yk) ;
+            pend = Dp [k+1] ;
+            for (p = Dp [k] ; p < pend ; p++)
+            {
+                i = Di [p] ;
+                MULT_SUB (Rw [i], Dx [p], yk) ;
+                APPROX_ABS (a, Dx [p]) ;
+                W [i] += a * b ;
+            }
+            pend = Offp [k+1] ;
+            for (p = Offp [k] ; p < pend ; p++)
+            {
+                i = Offi [p] ;
+                MULT_SUB (Rw [i], Offx [p], yk) ;
+                APPROX_ABS (a, Offx [p]) ;
+                W [i] += a * b ;
+            }
+        }
+    }
+    else
+    {
+        /* row k of M' is column k of M, so gather the products */
+        for (k = 0 ; k < n ; k++)
+        {
+            r = C [k] ;
+            APPROX_ABS (W [k], C [k]) ;
+            pend = Dp [k+1] ;
+            for (p = Dp [k] ; p < pend ; p++)
+            {
+#ifdef COMPLEX
+                if (conj_solve)
+                {
+                    CONJ (mik, Dx [p]) ;
+                }
+                else
+#endif
+                {
+                    mik = Dx [p] ;
+                }
+                MULT_SUB (r, mik, Y [Di [p]]) ;
+                APPROX_ABS (a, mik) ;
+                APPROX_ABS (b, Y [Di [p]]) ;
+                W [k] += a * b ;
+            }
+            pend = Offp [k+1] ;
+            for (p = Offp [k] ; p < pend ; p++)
+            {
+#ifdef COMPLEX
+                if (conj_solve)
+                {
+                    CONJ (mik, Offx [p]) ;
+                }
+                else
+#endif
+                {
+                    mik = Offx [p] ;
+                }
+                MULT_SUB (r, mik, Y [Offi [p]]) ;
+                APPROX_ABS (a, mik) ;
+                APPROX_ABS (b, Y [Offi [p]]) ;
+                W [k] += a * b ;
+            }
+            Rw [k] = r ;
+        }
+    }
+
+    omega = 0 ;
+    for (k = 0 ; k < n ; k++)
+    {
+        APPROX_ABS (a, Rw [k]) ;
+        if (W [k] > 0)
+        {
+            a /= W [k] ;
+        }
+        else if (a > 0 || SCALAR_IS_NAN (a))
+        {
+            /* nonzero residual in a row where |M|*|Y| + |C| is zero */
+            return (a) ;
+        }
+        omega = MAX (omega, a) ;
+    }
+    return (omega) ;
+}
+
+
+/* ========================================================================== */
+/* === free_mixed =========================================================== */
+/* ========================================================================== */
+
+/* Free D and the workspace of the mixed precision solve */
+
+static void free_mixed
+(
+    KLU_numeric *Numeric,
+    KLU_common *Common
+)
+{
+    Int n, nzdiag ;
+    n = Numeric->n ;
+    nzdiag = Numeric->nzdiag ;
+    Numeric->Dp = KLU_free (Numeric->Dp, n+1, sizeof (Int), Common) ;
+    Numeric->Di = KLU_free (Numeric->Di, nzdiag+1, sizeof (Int), Common) ;
+    Numeric->Dx = KLU_free (Numeric->Dx, nzdiag+1, sizeof (Entry), Common) ;
+    Numeric->Mwork = KLU_free (Numeric->Mwork, MWORK_SIZE (n), 1, Common) ;
+    Numeric->nzdiag = 0 ;
+}
+
+
+/* ========================================================================== */
+/* === promote ============================================================== */
+/* ========================================================================== */
+
+/* Convert the factors back to double precision.  New blocks of L and U are
+ * allocated with the same pattern, and M is refactorized from D with the same
+ * pivot ordering, as KLU_refactor would (the single precision values of L and
+ * U are not used).  The blocks are all allocated first, so that the Numeric
+ * object is left unchanged if it runs out of memory.  Returns TRUE if
+ * successful, FALSE otherwise. */
+
+static Int promote
+(
+    KLU_symbolic *Symbolic,
+    KLU_numeric *Numeric,
+    KLU_common *Common
+)
+{
+    Entry ukk, ujk, lik ;
+    Entry *X, *Dx, *Lx, *Ux, *Udiag ;
+    Int *R, *Dp, *Di, *Li, *Ui, *Li2, *Ui2, *Lip, *Uip, *Llen, *Ulen, *Lip1,
+        *Uip1, *Llen1, *Ulen1 ;
+    Unit **LUbx, **NewLU, *LU, *LU2 ;
+    size_t *LUsize, *NewSize ;
+    Int k1, k2, nk, k, block, nblocks, p, pend, i, j, up, llen, ulen, lup ;
+
+    nblocks = Symbolic->nblocks ;
+    R = Symbolic->R ;
+    Dp = Numeric->Dp ;
+    Di = Numeric->Di ;
+    Dx = (Entry *) Numeric->Dx ;
+    Lip  = Numeric->Lip ;
+    Llen = Numeric->Llen ;
+    Uip  = Numeric->Uip ;
+    Ulen = Numeric->Ulen ;
+    LUbx = (Unit **) Numeric->LUbx ;
+    LUsize = Numeric->LUsize ;
+    Udiag = Numeric->Udiag ;
+    X = (Entry *) Numeric->Xwork ;
+
+    /* ---------------------------------------------------------------------- */
+    /* allocate the new blocks */
+    /* ---------------------------------------------------------------------- */
+
+    NewLU = KLU_malloc (nblocks, sizeof (Unit *), Common) ;
+    NewSize = KLU_malloc (nblocks, sizeof (size_t), Common) ;
+    if (Common->status < KLU_OK)
+    {
+        KLU_free (NewLU, nblocks, sizeof (Unit *), Common) ;
+        KLU_free (NewSize, nblocks, sizeof (size_t), Common) ;
+        Common->status = KLU_OUT_OF_MEMORY ;
+        return (FALSE) ;
+    }
+    for (block = 0 ; block < nblocks ; block++)
+    {
+        k1 = R [block] ;
+        k2 = R [block+1] ;
+        NewLU [block] = NULL ;
+        NewSize [block] = 0 ;
+        if (k2 - k1 == 1)
+        {
+            continue ;
+        }
+        for (k = k1 ; k < k2 ; k++)
+        {
+            NewSize [block] += UNITS (Int, Llen [k]) + UNITS (Entry, Llen [k])
+                + UNITS (Int, Ulen [k]) + UNITS (Entry, Ulen [k]) ;
+        }
+        NewLU [block] = KLU_malloc (NewSize [block], sizeof (Unit), Common) ;
+        if (Common->status < KLU_OK)
+        {
+            for (block = 0 ; block < nblocks ; block++)
+            {
+                KLU_free (NewLU [block], NewSize [block], sizeof (Unit),
+                    Common) ;
+            }
+            KLU_free (NewLU, nblocks, sizeof (Unit *), Common) ;
+            KLU_free (NewSize, nblocks, sizeof (size_t), Common) ;
+            Common->status = KLU_OUT_OF_MEMORY ;
+            return (FALSE) ;
+        }
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* copy the pattern and refactorize each block in double precision */
+    /* ---------------------------------------------------------------------- */
+
+    for (block = 0 ; block < nblocks ; block++)
+    {
+        k1 = R [block] ;
+        k2 = R [block+1] ;
+        nk = k2 - k1 ;
+        if (nk == 1)
+        {
+            /* Udiag [k1] is already in double precision */
+            continue ;
+        }
+        LU = LUbx [block] ;
+        LU2 = NewLU [block] ;
+
+        /* copy the row indices of L and U into the new block */
+        lup = 0 ;
+        for (k = k1 ; k < k2 ; k++)
+        {
+            GET_I_POINTER (LU, Lip, Li, k) ;
+            Li2 = (Int *) (LU2 + lup) ;
+            for (p = 0 ; p < Llen [k] ; p++)
+            {
+                Li2 [p] = Li [p] ;
+            }
+            GET_I_POINTER (LU, Uip, Ui, k) ;
+            Lip [k] = lup ;
+            lup += UNITS (Int, Llen [k]) + UNITS (Entry, Llen [k]) ;
+            Ui2 = (Int *) (LU2 + lup) ;
+            for (p = 0 ; p < Ulen [k] ; p++)
+            {
+                Ui2 [p] = Ui [p] ;
+            }
+            Uip [k] = lup ;
+            lup += UNITS (Int, Ulen [k]) + UNITS (Entry, Ulen [k]) ;
+        }
+        ASSERT (lup == (Int) NewSize [block]) ;
+        KLU_free (LU, LUsize [block], sizeof (Unit), Common) ;
+        LUbx [block] = LU2 ;
+        LUsize [block] = NewSize [block] ;
+        LU = LU2 ;
+
+        /* refactorize the block from D, with X zero on input and output */
+        Lip1  = Lip  + k1 ;
+        Llen1 = Llen + k1 ;
+        Uip1  = Uip  + k1 ;
+        Ulen1 = Ulen + k1 ;
+        for (k = 0 ; k < nk ; k++)
+        {
+            CLEAR (X [k]) ;
+        }
+        for (k = 0 ; k < nk ; k++)
+        {
+            pend = Dp [k+k1+1] ;
+            for (p = Dp [k+k1] ; p < pend ; p++)
+            {
+                X [Di [p] - k1] = Dx [p] ;
+            }
+            GET_POINTER (LU, Uip1, Ulen1, Ui, Ux, k, ulen) ;
+            for (up = 0 ; up < ulen ; up++)
+            {
+                j = Ui [up] ;
+                ujk = X [j] ;
+                CLEAR (X [j]) ;
+                Ux [up] = ujk ;
+                GET_POINTER (LU, Lip1, Llen1, Li, Lx, j, llen) ;
+                for (p = 0 ; p < llen ; p++)
+                {
+                    MULT_SUB (X [Li [p]], Lx [p], ujk) ;
+                }
+            }
+            ukk = X [k] ;
+            CLEAR (X [k]) ;
+            Udiag [k+k1] = ukk ;
+            GET_POINTER (LU, Lip1, Llen1, Li, Lx, k, llen) ;
+            for (p = 0 ; p < llen ; p++)
+            {
+                i = Li [p] ;
+                DIV (lik, X [i], ukk) ;
+                Lx [p] = lik ;
+                CLEAR (X [i]) ;
+            }
+        }
+    }
+
+    KLU_free (NewLU, nblocks, sizeof (Unit *), Common) ;
+    KLU_free (NewSize, nblocks, sizeof (size_t), Common) ;
+    free_mixed (Numeric, Common) ;
+    Numeric->mixed = FALSE ;
+    return (TRUE) ;
+}
+
+
+/* ========================================================================== */
+/* === KLU_mixed_demote ===================================================== */
+/* ========================================================================== */
+
+/* Convert the factors computed by KLU_factor to single precision, and
+ * construct D.  This is done only if the memory saved on the values of L and
+ * U exceeds the memory needed for D and the workspace of the solve; nothing
+ * is changed otherwise, or if it runs out of memory.  Must be called after Rs
+ * and Offi are permuted into pivotal order.  Returns TRUE if the factors were
+ * converted, FALSE otherwise.  Common->status is not modified. */
+
+Int KLU_mixed_demote
+(
+    /* inputs, not modified */
+    Int Ap [ ],
+    Int Ai [ ],
+    Entry Ax [ ],
+    KLU_symbolic *Symbolic,
+
+    /* input/output */
+    KLU_numeric *Numeric,
+    KLU_common *Common
+)
+{
+    Entry lik ;
+    Entry *Dx, *Lx ;
+    SEntry *Ls ;
+    double saved, cost, *Rs ;
+    Int *Q, *R, *Pinv, *Dp, *Di, *Li, *Lip, *Uip, *Llen, *Ulen, *Xip ;
+    Unit **LUbx, *LU ;
+    size_t *LUsize ;
+    Int n, nblocks, k1, k2, nk, k, block, oldcol, oldrow, newrow, p, pend,
+        nzdiag, nzlu, status, len, lup, old, q ;
+
+    n = Symbolic->n ;
+    nblocks = Symbolic->nblocks ;
+    Q = Symbolic->Q ;
+    R = Symbolic->R ;
+    Pinv = Numeric->Pinv ;
+    Rs = Numeric->Rs ;
+    Lip  = Numeric->Lip ;
+    Llen = Numeric->Llen ;
+    Uip  = Numeric->Uip ;
+    Ulen = Numeric->Ulen ;
+    LUbx = (Unit **) Numeric->LUbx ;
+    LUsize = Numeric->LUsize ;
+
+    /* ---------------------------------------------------------------------- */
+    /* count the entries in the diagonal blocks, and in L and U */
+    /* ---------------------------------------------------------------------- */
+
+    nzdiag = 0 ;
+    nzlu = 0 ;
+    for (block = 0 ; block < nblocks ; block++)
+    {
+        k1 = R [block] ;
+        k2 = R [block+1] ;
+        for (k = k1 ; k < k2 ; k++)
+        {
+            oldcol = Q [k] ;
+            pend = Ap [oldcol+1] ;
+            for (p = Ap [oldcol] ; p < pend ; p++)
+            {
+                if (Pinv [Ai [p]] >= k1)
+                {
+                    nzdiag++ ;
+                }
+            }
+            if (k2 - k1 > 1)
+            {
+                nzlu += Llen [k] + Ulen [k] ;
+            }
+        }
+    }
+
+    saved = ((double) nzlu) * (sizeof (Entry) - sizeof (SEntry)) ;
+    cost = ((double) nzdiag) * (sizeof (Int) + sizeof (Entry))
+         + ((double) n + 1) * sizeof (Int) + (double) MWORK_SIZE (n) ;
+    if (saved <= cost)
+    {
+        /* keep the factors in double precision */
+        return (FALSE) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* allocate D and the workspace of the solve */
+    /* ---------------------------------------------------------------------- */
+
+    status = Common->status ;
+    Common->status = KLU_OK ;
+    Numeric->nzdiag = nzdiag ;
+    Numeric->Dp = KLU_malloc (n+1, sizeof (Int), Common) ;
+    Numeric->Di = KLU_malloc (nzdiag+1, sizeof (Int), Common) ;
+    Numeric->Dx = KLU_malloc (nzdiag+1, sizeof (Entry), Common) ;
+    Numeric->Mwork = KLU_malloc (MWORK_SIZE (n), 1, Common) ;
+    if (Common->status < KLU_OK)
+    {
+        /* out of memory; keep the factors in double precision */
+        free_mixed (Numeric, Common) ;
+        Common->status = status ;
+        return (FALSE) ;
+    }
+    Common->status = status ;
+
+    /* ---------------------------------------------------------------------- */
+    /* construct D, in the same order as KLU_mixed_refactor_block */
+    /* ---------------------------------------------------------------------- */
+
+    Dp = Numeric->Dp ;
+    Di = Numeric->Di ;
+    Dx = (Entry *) Numeric->Dx ;
+    nzdiag = 0 ;
+    for (block = 0 ; block < nblocks ; block++)
+    {
+        k1 = R [block] ;
+        k2 = R [block+1] ;
+        for (k = k1 ; k < k2 ; k++)
+        {
+            Dp [k] = nzdiag ;
+            oldcol = Q [k] ;
+            pend = Ap [oldcol+1] ;
+            for (p = Ap [oldcol] ; p < pend ; p++)
+            {
+                oldrow = Ai [p] ;
+                newrow = Pinv [oldrow] ;
+                if (newrow < k1)
+                {
+                    continue ;
+                }
+                Di [nzdiag] = newrow ;
+                if (Rs != NULL)
+                {
+                    /* Rs is already in pivotal order */
+                    SCALE_DIV_ASSIGN (Dx [nzdiag], Ax [p], Rs [newrow]) ;
+                }
+                else
+                {
+                    Dx [nzdiag] = Ax [p] ;
+                }
+                nzdiag++ ;
+            }
+        }
+    }
+    Dp [n] = nzdiag ;
+
+    /* ---------------------------------------------------------------------- */
+    /* convert each block of L and U to single precision, in place */
+    /* ---------------------------------------------------------------------- */
+
+    /* The columns of L and U are stored in the order L(:,k1), U(:,k1),
+     * L(:,k1+1), ...  in increasing position in the block.  A column in single
+     * precision is never larger than in double precision, so each one can be
+     * moved down to its new position in turn, and converted from its first
+     * entry to its last, without overwriting any entry not yet read. */
+
+    for (block = 0 ; block < nblocks ; block++)
+    {
+        k1 = R [block] ;
+        k2 = R [block+1] ;
+        nk = k2 - k1 ;
+        if (nk == 1)
+        {
+            continue ;
+        }
+        LU = LUbx [block] ;
+        lup = 0 ;
+        for (k = k1 ; k < k2 ; k++)
+        {
+            for (q = 0 ; q < 2 ; q++)
+            {
+                /* column k of L if q is 0, column k of U if q is 1 */
+                Xip = (q == 0) ? Lip : Uip ;
+                len = (q == 0) ? Llen [k] : Ulen [k] ;
+                ASSERT (Xip [k] >= lup) ;
+                old = Xip [k] ;
+                Li = (Int *) (LU + old) ;
+                Lx = (Entry *) (LU + old + UNITS (Int, len)) ;
+                for (p = 0 ; p < len ; p++)
+                {
+                    ((Int *) (LU + lup)) [p] = Li [p] ;
+                }
+                Ls = (SEntry *) (LU + lup + UNITS (Int, len)) ;
+                for (p = 0 ; p < len ; p++)
+                {
+                    lik = Lx [p] ;
+                    TO_SINGLE (Ls [p], lik) ;
+                }
+                Xip [k] = lup ;
+                lup += UNITS (Int, len) + UNITS (SEntry, len) ;
+            }
+        }
+
+        /* shrink the block; if this fails, the block is left as it is */
+        Common->status = KLU_OK ;
+        LUbx [block] = KLU_realloc (lup, LUsize [block], sizeof (Unit), LU,
+            Common) ;
+        if (Common->status == KLU_OK)
+        {
+            LUsize [block] = lup ;
+        }
+        Common->status = status ;
+    }
+
+    Numeric->mixed = TRUE ;
+    return (TRUE) ;
+}
+
+
+/* ========================================================================== */
+/* === KLU_mixed_refactor_block ============================================= */
+/* ========================================================================== */
+
+/* Same as refactor_block in KLU_refactor, with the factors of the block held
+ * in single precision.  The entries of the block of the scaled matrix are
+ * also copied into D.  Returns FALSE if the refactorization must halt. */
+
+Int KLU_mixed_refactor_block
+(
+    /* inputs, not modified */
+    Int block,          /* the block to refactorize */
+    Int Ap [ ],         /* size n+1, column pointers */
+    Int Ai [ ],         /* size nz, row indices */
+    Entry Az [ ],
+    KLU_symbolic *Symbolic,
+
+    /* input/output */
+    KLU_numeric *Numeric,
+
+    /* workspace, zero on input and output */
+    Entry X [ ],        /* size maxblock */
+    KLU_common *Common
+)
+{
+    Entry ukk, ujk, lij, lik, s ;
+    Entry *Offx, *Udiag, *Dx ;
+    SEntry *Ls, *Us ;
+    double *Rs ;
+    Int *Q, *R, *Ui, *Li, *Pinv, *Lip, *Uip, *Llen, *Ulen, *Dp ;
+    Unit *LU ;
+    Int k1, k2, nk, k, oldcol, pend, oldrow, p, newrow, scale, poff, i, j, up,
+        ulen, llen, nzoff, d ;
+
+    Q = Symbolic->Q ;
+    R = Symbolic->R ;
+    nzoff = Symbolic->nzoff ;
+    Offx = (Entry *) Numeric->Offx ;
+    Udiag = Numeric->Udiag ;
+    Pinv = Numeric->Pinv ;
+    Rs = Numeric->Rs ;
+    Dp = Numeric->Dp ;
+    Dx = (Entry *) Numeric->Dx ;
+    scale = Common->scale ;
+
+    /* ---------------------------------------------------------------------- */
+    /* the block is from rows/columns k1 to k2-1 */
+    /* ---------------------------------------------------------------------- */
+
+    k1 = R [block] ;
+    k2 = R [block+1] ;
+    nk = k2 - k1 ;
+    poff = Numeric->Offp [k1] ;
+
+    if (nk == 1)
+    {
+
+        /* ------------------------------------------------------------------ */
+        /* singleton case */
+        /* ------------------------------------------------------------------ */
+
+        oldcol = Q [k1] ;
+        pend = Ap [oldcol+1] ;
+        CLEAR (s) ;
+        for (p = Ap [oldcol] ; p < pend ; p++)
+        {
+            oldrow = Ai [p] ;
+            newrow = Pinv [oldrow] - k1 ;
+            if (newrow < 0 && poff < nzoff)
+            {
+                /* entry in off-diagonal block */
+                if (scale <= 0)
+                {
+                    Offx [poff] = Az [p] ;
+                }
+                else
+                {
+                    SCALE_DIV_ASSIGN (Offx [poff], Az [p], Rs [oldrow]) ;
+                }
+                poff++ ;
+            }
+            else if (scale <= 0)
+            {
+                s = Az [p] ;
+            }
+            else
+            {
+                SCALE_DIV_ASSIGN (s, Az [p], Rs [oldrow]) ;
+            }
+        }
+        Udiag [k1] = s ;
+        if (Dp [k1] < Dp [k1+1])
+        {
+            Dx [Dp [k1]] = s ;
+        }
+        return (TRUE) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* construct and factor the kth block */
+    /* ---------------------------------------------------------------------- */
+
+    Lip  = Numeric->Lip  + k1 ;
+    Llen = Numeric->Llen + k1 ;
+    Uip  = Numeric->Uip  + k1 ;
+    Ulen = Numeric->Ulen + k1 ;
+    LU = ((Unit **) Numeric->LUbx) [block] ;
+
+    for (k = 0 ; k < nk ; k++)
+    {
+
+        /* ------------------------------------------------------------------ */
+        /* scatter kth column of the block into workspace X, and into D */
+        /* ------------------------------------------------------------------ */
+
+        oldcol = Q [k+k1] ;
+        pend = Ap [oldcol+1] ;
+        d = Dp [k+k1] ;
+        for (p = Ap [oldcol] ; p < pend ; p++)
+        {
+            oldrow = Ai [p] ;
+            newrow = Pinv [oldrow] - k1 ;
+            if (newrow < 0 && poff < nzoff)
+            {
+                /* entry in off-diagonal block */
+                if (scale <= 0)
+                {
+                    Offx [poff] = Az [p] ;
+                }
+                else
+                {
+                    SCALE_DIV_ASSIGN (Offx [poff], Az [p], Rs [oldrow]) ;
+                }
+                poff++ ;
+            }
+            else
+            {
+                /* (newrow,k) is an entry in the block */
+                if (scale <= 0)
+                {
+                    X [newrow] = Az [p] ;
+                }
+                else
+                {
+                    SCALE_DIV_ASSIGN (X [newrow], Az [p], Rs [oldrow]) ;
+                }
+                Dx [d++] = X [newrow] ;
+            }
+        }
+        ASSERT (d == Dp [k+k1+1]) ;
+
+        /* ------------------------------------------------------------------ */
+        /* compute kth column of U, and update kth column of A */
+        /* ------------------------------------------------------------------ */
+
+        GET_S_POINTER (LU, Uip, Ulen, Ui, Us, k, ulen) ;
+        for (up = 0 ; up < ulen ; up++)
+        {
+            j = Ui [up] ;
+            ujk = X [j] ;
+            CLEAR (X [j]) ;
+            TO_SINGLE (Us [up], ujk) ;
+            GET_S_POINTER (LU, Lip, Llen, Li, Ls, j, llen) ;
+            for (p = 0 ; p < llen ; p++)
+            {
+                /* X [Li [p]] -= Ls [p] * ujk */
+                TO_DOUBLE (lij, Ls [p]) ;
+                MULT_SUB (X [Li [p]], lij, ujk) ;
+            }
+        }
+        /* get the diagonal entry of U */
+        ukk = X [k] ;
+        CLEAR (X [k]) ;
+        /* singular case */
+        if (IS_ZERO (ukk))
+        {
+            /* matrix is numerically singular */
+            Common->status = KLU_SINGULAR ;
+            if (Common->numerical_rank == EMPTY)
+            {
+                Common->numerical_rank = k+k1 ;
+                Common->singular_col = Q [k+k1] ;
+            }
+            if (Common->halt_if_singular)
+            {
+                /* do not continue the factorization */
+                return (FALSE) ;
+            }
+        }
+        Udiag [k+k1] = ukk ;
+        /* gather and divide by pivot to get kth column of L */
+        GET_S_POINTER (LU, Lip, Llen, Li, Ls, k, llen) ;
+        for (p = 0 ; p < llen ; p++)
+        {
+            i = Li [p] ;
+            DIV (lik, X [i], ukk) ;
+            TO_SINGLE (Ls [p], lik) ;
+            CLEAR (X [i]) ;
+        }
+    }
+    return (TRUE) ;
+}
+
+
+/* ========================================================================== */
+/* === KLU_mixed_solve ====================================================== */
+/* ========================================================================== */
+
+/* Solve Ax=b (or A'x=b if transpose is TRUE) with the single precision
+ * factors and iterative refinement.  Each column of B is refined until the
+ * componentwise backward error is below DBL_EPSILON, or until it fails to
+ * halve in one step, or REFINE_MAX steps are done.  If the refinement stalls
+ * with a backward error above REFINE_TOL, the factors are converted to double
+ * precision and the remaining columns of B are solved with KLU_solve or
+ * KLU_tsolve.  The inputs have already been checked by the caller.
+ * Common->nrefine is the total number of refinement steps done. */
+
+Int KLU_mixed_solve
+(
+    /* inputs, not modified */
+    KLU_symbolic *Symbolic,
+    KLU_numeric *Numeric,
+    Int d,                  /* leading dimension of B */
+    Int nrhs,               /* number of right-hand-sides */
+
+    /* right-hand-side on input, overwritten with solution on output */
+    double B [ ],           /* size n*nrhs, in column-oriented form, with
+                             * leading dimension d. */
+    Int transpose,          /* TRUE: solve A'x=b, FALSE: solve Ax=b */
+#ifdef COMPLEX
+    Int conj_solve,         /* TRUE for conjugate transpose solve */
+#endif
+    /* --------------- */
+    KLU_common *Common
+)
+{
+    Entry *C, *Y, *Rw, *Bz ;
+    double omega, omega_old, *Rs, *W ;
+    Int *Q, *Pnum ;
+    Int n, k, j, iter, nrefine ;
+
+    n = Symbolic->n ;
+    Q = Symbolic->Q ;
+    Pnum = Numeric->Pnum ;
+    Rs = Numeric->Rs ;
+    C  = (Entry *) Numeric->Mwork ;
+    Y  = C + n ;
+    Rw = C + 2*n ;
+    W  = (double *) (C + 3*n) ;
+    nrefine = 0 ;
+    Common->status = KLU_OK ;
+
+    for (j = 0 ; j < nrhs ; j++)
+    {
+        Bz = ((Entry *) B) + j*d ;
+
+        /* ------------------------------------------------------------------ */
+        /* C = P*(R\B) or C = Q'*B, and Y = M\C */
+        /* ------------------------------------------------------------------ */
+
+        for (k = 0 ; k < n ; k++)
+        {
+            if (transpose)
+            {
+                C [k] = Bz [Q [k]] ;
+            }
+            else if (Rs == NULL)
+            {
+                C [k] = Bz [Pnum [k]] ;
+            }
+            else
+            {
+                SCALE_DIV_ASSIGN (C [k], Bz [Pnum [k]], Rs [k]) ;
+            }
+            Y [k] = C [k] ;
+        }
+        block_solve (Symbolic, Numeric, transpose,
+#ifdef COMPLEX
+            conj_solve,
+#endif
+            Y) ;
+
+        /* ------------------------------------------------------------------ */
+        /* iterative refinement */
+        /* ------------------------------------------------------------------ */
+
+        omega_old = 0 ;
+        for (iter = 0 ; ; iter++)
+        {
+            omega = residual (Numeric, transpose,
+#ifdef COMPLEX
+                conj_solve,
+#endif
+                C, Y, Rw, W) ;
+            if (omega <= DBL_EPSILON)
+            {
+                /* converged */
+                break ;
+            }
+            if (iter == REFINE_MAX || (iter > 0 && !(omega <= omega_old / 2)))
+            {
+                /* stalled */
+                break ;
+            }
+            omega_old = omega ;
+            block_solve (Symbolic, Numeric, transpose,
+#ifdef COMPLEX
+                conj_solve,
+#endif
+                Rw) ;
+            for (k = 0 ; k < n ; k++)
+            {
+                /* Y [k] += Rw [k] */
+                ASSEMBLE (Y [k], Rw [k]) ;
+            }
+            nrefine++ ;
+        }
+
+        if (!(omega <= REFINE_TOL))
+        {
+
+            /* -------------------------------------------------------------- */
+            /* the refinement stalled; solve in double precision */
+            /* -------------------------------------------------------------- */
+
+            PRINTF (("mixed solve stalled: omega %g\n", omega)) ;
+            Common->nrefine = nrefine ;
+            if (!promote (Symbolic, Numeric, Common))
+            {
+                return (FALSE) ;
+            }
+            if (transpose)
+            {
+                KLU_tsolve (Symbolic, Numeric, d, nrhs - j, (double *) Bz,
+#ifdef COMPLEX
+                    conj_solve,
+#endif
+                    Common) ;
+            }
+            else
+            {
+                KLU_solve (Symbolic, Numeric, d, nrhs - j, (double *) Bz,
+                    Common) ;
+            }
+            Common->nrefine = nrefine ;
+            return (Common->status == KLU_OK) ;
+        }
+
+        /* ------------------------------------------------------------------ */
+        /* B = Q*Y or B = P'*(R\Y) */
+        /* ------------------------------------------------------------------ */
+
+        for (k = 0 ; k < n ; k++)
+        {
+            if (!transpose)
+            {
+                Bz [Q [k]] = Y [k] ;
+            }
+            else if (Rs == NULL)
+            {
+                Bz [Pnum [k]] = Y [k] ;
+            }
+            else
+            {
+                SCALE_DIV_ASSIGN (Bz [Pnum [k]], Y [k], Rs [k]) ;
+            }
+        }
+    }
+
+    Common->nrefine = nrefine ;
+    return (TRUE) ;
+}
@@ -0,0 +1,118 @@
+/* ========================================================================== */
+/* === KLU_parallel ========================================================= */
+/* ========================================================================== */
+
+/* Support routines for the block-parallel factorization.  The diagonal blocks
+ * of the BTF form are numerically independent, so klu_factor and klu_refactor
+ * may factorize them concurrently (see Common->nthreads).  Each thread works
+ * with a private copy of the Common object, so that the statistics and the
+ * memory usage can be updated without locking.  The private copies are merged
+ * back into Common once all blocks are done.  No user-callable routines are
+ * in this file.
+ */
+
+#include "klu_internal.h"
+
+/* ========================================================================== */
+/* === KLU_nthreads ========================================================= */
+/* ========================================================================== */
+
+/* Returns the number of threads to use for nwork independent tasks: 1 if KLU
+ * is not compiled with OpenMP, or if Common->nthreads <= 1. */
+
+Int KLU_nthreads
+(
+    Int nwork,              /* # of independent tasks */
+    KLU_common *Common
+)
+{
+#ifdef _OPENMP
+    Int nthreads = Common->nthreads ;
+    nthreads = MIN (nthreads, nwork) ;
+    return (MAX (nthreads, 1)) ;
+#else
+    (void) nwork ;
+    (void) Common ;
+    return (1) ;
+#endif
+}
+
+
+/* ========================================================================== */
+/* === KLU_thread_common ==================================================== */
+/* ========================================================================== */
+
+/* Initializes Tc [0..nthreads-1] as private copies of Common, with cleared
+ * statistics. */
+
+void KLU_thread_common
+(
+    Int nthreads,
+    KLU_common Tc [ ],      /* size nthreads, undefined on input */
+    KLU_common *Common
+)
+{
+    Int t ;
+    for (t = 0 ; t < nthreads ; t++)
+    {
+        Tc [t] = *Common ;
+        Tc [t].status = KLU_OK ;
+        Tc [t].nrealloc = 0 ;
+        Tc [t].noffdiag = 0 ;
+        Tc [t].numerical_rank = EMPTY ;
+        Tc [t].singular_col = EMPTY ;
+        Tc [t].memusage = 0 ;
+        Tc [t].mempeak = 0 ;
+    }
+}
+
+
+/* ========================================================================== */
+/* === KLU_merge_common ===================================================== */
+/* ========================================================================== */
+
+/* Merges the private copies Tc [0..nthreads-1] back into Common.  An error in
+ * any thread takes precedence over a singular matrix.  The numerical rank is
+ * the first zero pivot found by any thread, which is the one the sequential
+ * factorization would have found.  The peak memory usage is bounded by
+ * assuming that all threads reached their peak at the same time. */
+
+void KLU_merge_common
+(
+    Int nthreads,
+    KLU_common Tc [ ],      /* size nthreads */
+    KLU_common *Common
+)
+{
+    size_t peak ;
+    Int t ;
+
+    peak = Common->memusage ;
+    for (t = 0 ; t < nthreads ; t++)
+    {
+        peak += Tc [t].mempeak ;
+        Common->memusage += Tc [t].memusage ;
+        Common->nrealloc += Tc [t].nrealloc ;
+        if (Tc [t].noffdiag > 0)
+        {
+            Common->noffdiag = MAX (Common->noffdiag, 0) + Tc [t].noffdiag ;
+        }
+        if (Tc [t].status < KLU_OK)
+        {
+            Common->status = Tc [t].status ;
+        }
+        else if (Tc [t].status == KLU_SINGULAR && Common->status == KLU_OK)
+        {
+            Common->status = KLU_SINGULAR ;
+        }
+        if (Tc [t].numerical_rank != EMPTY &&
+           (Common->numerical_rank == EMPTY ||
+            Tc [t].numerical_rank < Common->numerical_rank))
+        {
+            Common->numerical_rank = Tc [t].numerical_rank ;
+            Common->singular_col = Tc [t].singular_col ;
+        }
+    }
+    Common->mempeak = MAX (Common->mempeak, peak) ;
+    KLU_arena_stats (Common) ;
+}
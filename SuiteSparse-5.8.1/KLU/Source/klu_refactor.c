@@ -10,6 +10,301 @@
 
 #include "klu_internal.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/* ========================================================================== */
+/* === refactor_block ======================================================= */
+/* ========================================================================== */
+
+/* Refactorize a single diagonal block of the BTF form, using the pattern and
+ * pivot ordering of the prior KLU_factor.  Returns FALSE if the
+ * refactorization must halt. */
+
+static Int refactor_block
+(
+    /* inputs, not modified */
+    Int block,          /* the block to refactorize */
+    Int Ap [ ],         /* size n+1, column pointers */
+    Int Ai [ ],         /* size nz, row indices */
+    Entry Az [ ],
+    KLU_symbolic *Symbolic,
+
+    /* input/output */
+    KLU_numeric *Numeric,
+
+    /* workspace, zero on input and output */
+    Entry X [ ],        /* size maxblock */
+    KLU_common *Common
+)
+{
+    Entry ukk, ujk, s ;
+    Entry *Offx, *Lx, *Ux, *Udiag ;
+    double *Rs ;
+    Int *Q, *R, *Ui, *Li, *Pinv, *Lip, *Uip, *Llen, *Ulen ;
+    Unit *LU ;
+    Int k1, k2, nk, k, oldcol, pend, oldrow, p, newrow, scale, poff, i, j, up,
+        ulen, llen, nzoff ;
+
+    if (Numeric->mixed)
+    {
+        /* L and U are held in single precision */
+        return (KLU_mixed_refactor_block (block, Ap, Ai, Az, Symbolic, Numeric,
+            X, Common)) ;
+    }
+
+    Q = Symbolic->Q ;
+    R = Symbolic->R ;
+    nzoff = Symbolic->nzoff ;
+    Offx = (Entry *) Numeric->Offx ;
+    Udiag = Numeric->Udiag ;
+    Pinv = Numeric->Pinv ;
+    Rs = Numeric->Rs ;
+    scale = Common->scale ;
+
+    /* ---------------------------------------------------------------------- */
+    /* the block is from rows/columns k1 to k2-1 */
+    /* ---------------------------------------------------------------------- */
+
+    k1 = R [block] ;
+    k2 = R [block+1] ;
+    nk = k2 - k1 ;
+    poff = Numeric->Offp [k1] ;
+
+    if (nk == 1)
+    {
+
+        /* ------------------------------------------------------------------ */
+        /* singleton case */
+        /* ------------------------------------------------------------------ */
+
+        oldcol = Q [k1] ;
+        pend = Ap [oldcol+1] ;
+        CLEAR (s) ;
+        if (scale <= 0)
+        {
+            /* no scaling */
+            for (p = Ap [oldcol] ; p < pend ; p++)
+            {
+                newrow = Pinv [Ai [p]] - k1 ;
+                if (newrow < 0 && poff < nzoff)
+                {
+                    /* entry in off-diagonal block */
+                    Offx [poff] = Az [p] ;
+                    poff++ ;
+                }
+                else
+                {
+                    /* singleton */
+                    s = Az [p] ;
+                }
+            }
+        }
+        else
+        {
+            /* scaling */
+            for (p = Ap [oldcol] ; p < pend ; p++)
+            {
+                oldrow = Ai [p] ;
+                newrow = Pinv [oldrow] - k1 ;
+                if (newrow < 0 && poff < nzoff)
+                {
+                    /* entry in off-diagonal block */
+                    /* Offx [poff] = Az [p] / Rs [oldrow] */
+                    SCALE_DIV_ASSIGN (Offx [poff], Az [p], Rs [oldrow]) ;
+                    poff++ ;
+                }
+                else
+                {
+                    /* singleton */
+                    /* s = Az [p] / Rs [oldrow] */
+                    SCALE_DIV_ASSIGN (s, Az [p], Rs [oldrow]) ;
+                }
+            }
+        }
+        Udiag [k1] = s ;
+        return (TRUE) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* construct and factor the kth block */
+    /* ---------------------------------------------------------------------- */
+
+    Lip  = Numeric->Lip  + k1 ;
+    Llen = Numeric->Llen + k1 ;
+    Uip  = Numeric->Uip  + k1 ;
+    Ulen = Numeric->Ulen + k1 ;
+    LU = ((Unit **) Numeric->LUbx) [block] ;
+
+    for (k = 0 ; k < nk ; k++)
+    {
+
+        /* ------------------------------------------------------------------ */
+        /* scatter kth column of the block into workspace X */
+        /* ------------------------------------------------------------------ */
+
+        oldcol = Q [k+k1] ;
+        pend = Ap [oldcol+1] ;
+        if (scale <= 0)
+        {
+            /* no scaling */
+            for (p = Ap [oldcol] ; p < pend ; p++)
+            {
+                newrow = Pinv [Ai [p]] - k1 ;
+                if (newrow < 0 && poff < nzoff)
+                {
+                    /* entry in off-diagonal block */
+                    Offx [poff] = Az [p] ;
+                    poff++ ;
+                }
+                else
+                {
+                    /* (newrow,k) is an entry in the block */
+                    X [newrow] = Az [p] ;
+                }
+            }
+        }
+        else
+        {
+            /* scaling */
+            for (p = Ap [oldcol] ; p < pend ; p++)
+            {
+                oldrow = Ai [p] ;
+                newrow = Pinv [oldrow] - k1 ;
+                if (newrow < 0 && poff < nzoff)
+                {
+                    /* entry in off-diagonal part */
+                    /* Offx [poff] = Az [p] / Rs [oldrow] */
+                    SCALE_DIV_ASSIGN (Offx [poff], Az [p], Rs [oldrow]);
+                    poff++ ;
+                }
+                else
+                {
+                    /* (newrow,k) is an entry in the block */
+                    /* X [newrow] = Az [p] / Rs [oldrow] */
+                    SCALE_DIV_ASSIGN (X [newrow], Az [p], Rs [oldrow]) ;
+                }
+            }
+        }
+
+        /* ------------------------------------------------------------------ */
+        /* compute kth column of U, and update kth column of A */
+        /* ------------------------------------------------------------------ */
+
+        GET_POINTER (LU, Uip, Ulen, Ui, Ux, k, ulen) ;
+        for (up = 0 ; up < ulen ; up++)
+        {
+            j = Ui [up] ;
+            ujk = X [j] ;
+            /* X [j] = 0 */
+            CLEAR (X [j]) ;
+            Ux [up] = ujk ;
+            GET_POINTER (LU, Lip, Llen, Li, Lx, j, llen) ;
+            for (p = 0 ; p < llen ; p++)
+            {
+                /* X [Li [p]] -= Lx [p] * ujk */
+                MULT_SUB (X [Li [p]], Lx [p], ujk) ;
+            }
+        }
+        /* get the diagonal entry of U */
+        ukk = X [k] ;
+        /* X [k] = 0 */
+        CLEAR (X [k]) ;
+        /* singular case */
+        if (IS_ZERO (ukk))
+        {
+            /* matrix is numerically singular */
+            Common->status = KLU_SINGULAR ;
+            if (Common->numerical_rank == EMPTY)
+            {
+                Common->numerical_rank = k+k1 ;
+                Common->singular_col = Q [k+k1] ;
+            }
+            if (Common->halt_if_singular)
+            {
+                /* do not continue the factorization */
+                return (FALSE) ;
+            }
+        }
+        Udiag [k+k1] = ukk ;
+        /* gather and divide by pivot to get kth column of L */
+        GET_POINTER (LU, Lip, Llen, Li, Lx, k, llen) ;
+        for (p = 0 ; p < llen ; p++)
+        {
+            i = Li [p] ;
+            DIV (Lx [p], X [i], ukk) ;
+            CLEAR (X [i]) ;
+        }
+    }
+    return (TRUE) ;
+}
+
+
+#ifdef _OPENMP
+/* ========================================================================== */
+/* === refactor_parallel ==================================================== */
+/* ========================================================================== */
+
+/* Refactorize the blocks with nthreads threads.  The blocks write to disjoint
+ * parts of the Numeric object, and each one is refactorized exactly as in the
+ * sequential case.  Returns FALSE if the refactorization halted. */
+
+static Int refactor_parallel
+(
+    Int nthreads,
+    Int Ap [ ],
+    Int Ai [ ],
+    Entry Az [ ],
+    KLU_symbolic *Symbolic,
+    KLU_numeric *Numeric,
+    KLU_common *Common
+)
+{
+    KLU_common *Tc ;
+    Entry *Xw ;
+    Int block, k, nblocks, maxblock, ok ;
+
+    nblocks = Symbolic->nblocks ;
+    maxblock = Symbolic->maxblock ;
+
+    Tc = KLU_malloc (nthreads, sizeof (KLU_common), Common) ;
+    Xw = KLU_malloc (nthreads * maxblock, sizeof (Entry), Common) ;
+    ok = (Common->status == KLU_OK) ;
+    if (ok)
+    {
+        KLU_thread_common (nthreads, Tc, Common) ;
+        for (k = 0 ; k < nthreads * maxblock ; k++)
+        {
+            /* X [k] = 0 */
+            CLEAR (Xw [k]) ;
+        }
+
+        #pragma omp parallel for num_threads(nthreads) schedule(dynamic,1)
+        for (block = 0 ; block < nblocks ; block++)
+        {
+            Int t = omp_get_thread_num ( ) ;
+            if (Tc [t].status == KLU_OK || !Tc [t].halt_if_singular)
+            {
+                refactor_block (block, Ap, Ai, Az, Symbolic, Numeric,
+                    Xw + maxblock * t, &Tc [t]) ;
+            }
+        }
+
+        KLU_merge_common (nthreads, Tc, Common) ;
+        ok = (Common->status == KLU_OK || !Common->halt_if_singular) ;
+    }
+    else
+    {
+        /* out of memory */
+        Common->status = KLU_OUT_OF_MEMORY ;
+    }
+    KLU_free (Tc, nthreads, sizeof (KLU_common), Common) ;
+    KLU_free (Xw, nthreads * maxblock, sizeof (Entry), Common) ;
+    return (ok) ;
+}
+#endif
+
 
 /* ========================================================================== */
 /* === KLU_refactor ========================================================= */
@@ -28,14 +323,16 @@ Int KLU_refactor        /* returns TRUE if successful, FALSE otherwise */
     KLU_common  *Common
 )
 {
-    Entry ukk, ujk, s ;
-    Entry *Offx, *Lx, *Ux, *X, *Az, *Udiag ;
+    Entry *X, *Az ;
     double *Rs ;
-    Int *Q, *R, *Pnum, *Ui, *Li, *Pinv, *Lip, *Uip, *Llen, *Ulen ;
-    Unit **LUbx ;
+    Int *Pnum ;
+    Int k, block, n, scale, nblocks, maxblock, nthreads ;
+#ifndef NDEBUG
+    Entry *Offx, *Udiag ;
+    Int *R, *Lip, *Uip, *Llen, *Ulen ;
     Unit *LU ;
-    Int k1, k2, nk, k, block, oldcol, pend, oldrow, n, p, newrow, scale,
-        nblocks, poff, i, j, up, ulen, llen, maxblock, nzoff ;
+    Int k1, k2, nk ;
+#endif
 
     /* ---------------------------------------------------------------------- */
     /* check inputs */
@@ -64,8 +361,6 @@ Int KLU_refactor        /* returns TRUE if successful, FALSE otherwise */
     /* ---------------------------------------------------------------------- */
 
     n = Symbolic->n ;
-    Q = Symbolic->Q ;
-    R = Symbolic->R ;
     nblocks = Symbolic->nblocks ;
     maxblock = Symbolic->maxblock ;
 
@@ -74,9 +369,6 @@ Int KLU_refactor        /* returns TRUE if successful, FALSE otherwise */
     /* ---------------------------------------------------------------------- */
 
     Pnum = Numeric->Pnum ;
-    Offx = (Entry *) Numeric->Offx ;
-
-    LUbx = (Unit **) Numeric->LUbx ;
 
     scale = Common->scale ;
     if (scale > 0)
@@ -100,11 +392,8 @@ Int KLU_refactor        /* returns TRUE if successful, FALSE otherwise */
     }
     Rs = Numeric->Rs ;
 
-    Pinv = Numeric->Pinv ;
     X = (Entry *) Numeric->Xwork ;
     Common->nrealloc = 0 ;
-    Udiag = Numeric->Udiag ;
-    nzoff = Symbolic->nzoff ;
 
     /* ---------------------------------------------------------------------- */
     /* check the input matrix compute the row scale factors, Rs */
@@ -120,299 +409,41 @@ Int KLU_refactor        /* returns TRUE if successful, FALSE otherwise */
         }
     }
 
-    /* ---------------------------------------------------------------------- */
-    /* clear workspace X */
-    /* ---------------------------------------------------------------------- */
-
-    for (k = 0 ; k < maxblock ; k++)
-    {
-        /* X [k] = 0 */
-        CLEAR (X [k]) ;
-    }
-
-    poff = 0 ;
-
     /* ---------------------------------------------------------------------- */
     /* factor each block */
     /* ---------------------------------------------------------------------- */
 
-    if (scale <= 0)
-    {
-
-        /* ------------------------------------------------------------------ */
-        /* no scaling */
-        /* ------------------------------------------------------------------ */
+    nthreads = KLU_nthreads (nblocks, Common) ;   /* always 1 without OpenMP */
 
-        for (block = 0 ; block < nblocks ; block++)
+    if (nthreads > 1)
+    {
+#ifdef _OPENMP
+        if (!refactor_parallel (nthreads, Ap, Ai, Az, Symbolic, Numeric,
+            Common))
         {
-
-            /* -------------------------------------------------------------- */
-            /* the block is from rows/columns k1 to k2-1 */
-            /* -------------------------------------------------------------- */
-
-            k1 = R [block] ;
-            k2 = R [block+1] ;
-            nk = k2 - k1 ;
-
-            if (nk == 1)
-            {
-
-                /* ---------------------------------------------------------- */
-                /* singleton case */
-                /* ---------------------------------------------------------- */
-
-                oldcol = Q [k1] ;
-                pend = Ap [oldcol+1] ;
-                CLEAR (s) ;
-                for (p = Ap [oldcol] ; p < pend ; p++)
-                {
-                    newrow = Pinv [Ai [p]] - k1 ;
-                    if (newrow < 0 && poff < nzoff)
-                    {
-                        /* entry in off-diagonal block */
-                        Offx [poff] = Az [p] ;
-                        poff++ ;
-                    }
-                    else
-                    {
-                        /* singleton */
-                        s = Az [p] ;
-                    }
-                }
-                Udiag [k1] = s ;
-
-            }
-            else
-            {
-
-                /* ---------------------------------------------------------- */
-                /* construct and factor the kth block */
-                /* ---------------------------------------------------------- */
-
-                Lip  = Numeric->Lip  + k1 ;
-                Llen = Numeric->Llen + k1 ;
-                Uip  = Numeric->Uip  + k1 ;
-                Ulen = Numeric->Ulen + k1 ;
-                LU = LUbx [block] ;
-
-                for (k = 0 ; k < nk ; k++)
-                {
-
-                    /* ------------------------------------------------------ */
-                    /* scatter kth column of the block into workspace X */
-                    /* ------------------------------------------------------ */
-
-                    oldcol = Q [k+k1] ;
-                    pend = Ap [oldcol+1] ;
-                    for (p = Ap [oldcol] ; p < pend ; p++)
-                    {
-                        newrow = Pinv [Ai [p]] - k1 ;
-                        if (newrow < 0 && poff < nzoff)
-                        {
-                            /* entry in off-diagonal block */
-                            Offx [poff] = Az [p] ;
-                            poff++ ;
-                        }
-                        else
-                        {
-                            /* (newrow,k) is an entry in the block */
-                            X [newrow] = Az [p] ;
-                        }
-                    }
-
-                    /* ------------------------------------------------------ */
-                    /* compute kth column of U, and update kth column of A */
-                    /* ------------------------------------------------------ */
-
-                    GET_POINTER (LU, Uip, Ulen, Ui, Ux, k, ulen) ;
-                    for (up = 0 ; up < ulen ; up++)
-                    {
-                        j = Ui [up] ;
-                        ujk = X [j] ;
-                        /* X [j] = 0 */
-                        CLEAR (X [j]) ;
-                        Ux [up] = ujk ;
-                        GET_POINTER (LU, Lip, Llen, Li, Lx, j, llen) ;
-                        for (p = 0 ; p < llen ; p++)
-                        {
-                            /* X [Li [p]] -= Lx [p] * ujk */
-                            MULT_SUB (X [Li [p]], Lx [p], ujk) ;
-                        }
-                    }
-                    /* get the diagonal entry of U */
-                    ukk = X [k] ;
-                    /* X [k] = 0 */
-                    CLEAR (X [k]) ;
-                    /* singular case */
-                    if (IS_ZERO (ukk))
-                    {
-                        /* matrix is numerically singular */
-                        Common->status = KLU_SINGULAR ;
-                        if (Common->numerical_rank == EMPTY)
-                        {
-                            Common->numerical_rank = k+k1 ;
-                            Common->singular_col = Q [k+k1] ;
-                        }
-                        if (Common->halt_if_singular)
-                        {
-                            /* do not continue the factorization */
-                            return (FALSE) ;
-                        }
-                    }
-                    Udiag [k+k1] = ukk ;
-                    /* gather and divide by pivot to get kth column of L */
-                    GET_POINTER (LU, Lip, Llen, Li, Lx, k, llen) ;
-                    for (p = 0 ; p < llen ; p++)
-                    {
-                        i = Li [p] ;
-                        DIV (Lx [p], X [i], ukk) ;
-                        CLEAR (X [i]) ;
-                    }
-
-                }
-            }
+            return (FALSE) ;
         }
-
+#endif
     }
     else
     {
 
         /* ------------------------------------------------------------------ */
-        /* scaling */
+        /* clear workspace X */
         /* ------------------------------------------------------------------ */
 
-        for (block = 0 ; block < nblocks ; block++)
+        for (k = 0 ; k < maxblock ; k++)
         {
+            /* X [k] = 0 */
+            CLEAR (X [k]) ;
+        }
 
-            /* -------------------------------------------------------------- */
-            /* the block is from rows/columns k1 to k2-1 */
-            /* -------------------------------------------------------------- */
-
-            k1 = R [block] ;
-            k2 = R [block+1] ;
-            nk = k2 - k1 ;
-
-            if (nk == 1)
-            {
-
-                /* ---------------------------------------------------------- */
-                /* singleton case */
-                /* ---------------------------------------------------------- */
-
-                oldcol = Q [k1] ;
-                pend = Ap [oldcol+1] ;
-                CLEAR (s) ;
-                for (p = Ap [oldcol] ; p < pend ; p++)
-                {
-                    oldrow = Ai [p] ;
-                    newrow = Pinv [oldrow] - k1 ;
-                    if (newrow < 0 && poff < nzoff)
-                    {
-                        /* entry in off-diagonal block */
-                        /* Offx [poff] = Az [p] / Rs [oldrow] */
-                        SCALE_DIV_ASSIGN (Offx [poff], Az [p], Rs [oldrow]) ;
-                        poff++ ;
-                    }
-                    else
-                    {
-                        /* singleton */
-                        /* s = Az [p] / Rs [oldrow] */
-                        SCALE_DIV_ASSIGN (s, Az [p], Rs [oldrow]) ;
-                    }
-                }
-                Udiag [k1] = s ;
-
-            }
-            else
+        for (block = 0 ; block < nblocks ; block++)
+        {
+            if (!refactor_block (block, Ap, Ai, Az, Symbolic, Numeric, X,
+                Common))
             {
-
-                /* ---------------------------------------------------------- */
-                /* construct and factor the kth block */
-                /* ---------------------------------------------------------- */
-
-                Lip  = Numeric->Lip  + k1 ;
-                Llen = Numeric->Llen + k1 ;
-                Uip  = Numeric->Uip  + k1 ;
-                Ulen = Numeric->Ulen + k1 ;
-                LU = LUbx [block] ;
-
-                for (k = 0 ; k < nk ; k++)
-                {
-
-                    /* ------------------------------------------------------ */
-                    /* scatter kth column of the block into workspace X */
-                    /* ------------------------------------------------------ */
-
-                    oldcol = Q [k+k1] ;
-                    pend = Ap [oldcol+1] ;
-                    for (p = Ap [oldcol] ; p < pend ; p++)
-                    {
-                        oldrow = Ai [p] ;
-                        newrow = Pinv [oldrow] - k1 ;
-                        if (newrow < 0 && poff < nzoff)
-                        {
-                            /* entry in off-diagonal part */
-                            /* Offx [poff] = Az [p] / Rs [oldrow] */
-                            SCALE_DIV_ASSIGN (Offx [poff], Az [p], Rs [oldrow]);
-                            poff++ ;
-                        }
-                        else
-                        {
-                            /* (newrow,k) is an entry in the block */
-                            /* X [newrow] = Az [p] / Rs [oldrow] */
-                            SCALE_DIV_ASSIGN (X [newrow], Az [p], Rs [oldrow]) ;
-                        }
-                    }
-
-                    /* ------------------------------------------------------ */
-                    /* compute kth column of U, and update kth column of A */
-                    /* ------------------------------------------------------ */
-
-                    GET_POINTER (LU, Uip, Ulen, Ui, Ux, k, ulen) ;
-                    for (up = 0 ; up < ulen ; up++)
-                    {
-                        j = Ui [up] ;
-                        ujk = X [j] ;
-                        /* X [j] = 0 */
-                        CLEAR (X [j]) ;
-                        Ux [up] = ujk ;
-                        GET_POINTER (LU, Lip, Llen, Li, Lx, j, llen) ;
-                        for (p = 0 ; p < llen ; p++)
-                        {
-                            /* X [Li [p]] -= Lx [p] * ujk */
-                            MULT_SUB (X [Li [p]], Lx [p], ujk) ;
-                        }
-                    }
-                    /* get the diagonal entry of U */
-                    ukk = X [k] ;
-                    /* X [k] = 0 */
-                    CLEAR (X [k]) ;
-                    /* singular case */
-                    if (IS_ZERO (ukk))
-                    {
-                        /* matrix is numerically singular */
-                        Common->status = KLU_SINGULAR ;
-                        if (Common->numerical_rank == EMPTY)
-                        {
-                            Common->numerical_rank = k+k1 ;
-                            Common->singular_col = Q [k+k1] ;
-                        }
-                        if (Common->halt_if_singular)
-                        {
-                            /* do not continue the factorization */
-                            return (FALSE) ;
-                        }
-                    }
-                    Udiag [k+k1] = ukk ;
-                    /* gather and divide by pivot to get kth column of L */
-                    GET_POINTER (LU, Lip, Llen, Li, Lx, k, llen) ;
-                    for (p = 0 ; p < llen ; p++)
-                    {
-                        i = Li [p] ;
-                        DIV (Lx [p], X [i], ukk) ;
-                        CLEAR (X [i]) ;
-                    }
-                }
+                return (FALSE) ;
             }
         }
     }
@@ -434,8 +465,10 @@ Int KLU_refactor        /* returns TRUE if successful, FALSE otherwise */
     }
 
 #ifndef NDEBUG
-    ASSERT (Numeric->Offp [n] == poff) ;
-    ASSERT (Symbolic->nzoff == poff) ;
+    R = Symbolic->R ;
+    Offx = (Entry *) Numeric->Offx ;
+    Udiag = Numeric->Udiag ;
+    ASSERT (Symbolic->nzoff == Numeric->Offp [n]) ;
     PRINTF (("\n------------------- Off diagonal entries, new:\n")) ;
     ASSERT (KLU_valid (n, Numeric->Offp, Numeric->Offi, Offx)) ;
     if (Common->status == KLU_OK)
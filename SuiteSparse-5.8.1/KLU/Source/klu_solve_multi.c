@@ -0,0 +1,708 @@
+/* ========================================================================== */
+/* === KLU_solve_multi ====================================================== */
+/* ========================================================================== */
+
+/* Solve Ax=b or A'x=b with many right-hand-sides, using the symbolic and
+ * numeric objects from KLU_analyze (or KLU_analyze_given) and KLU_factor.  The
+ * result is the same as that of KLU_solve and KLU_tsolve, but the columns of B
+ * are solved in panels of up to KLU_PANEL columns rather than in chunks of 4.
+ * A panel is held in row form, so the innermost loops run over the contiguous
+ * columns of a single row and each entry of L and U is loaded once per panel.
+ * If KLU is compiled with OpenMP and Common->nthreads > 1, the panels are
+ * solved concurrently.  Numeric->Xwork is not used (it is shared by all
+ * threads); KLU_PANEL*n Entry's of workspace are allocated per thread instead.
+ * Note that no iterative refinement is performed.  If L and U are held in
+ * single precision (see KLU_mixed), this is the same as KLU_solve and
+ * KLU_tsolve.
+ */
+
+#include "klu_internal.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/* maximum number of right-hand-sides in a panel.  A row of a full panel is 16
+ * doubles (two cache lines).  The transposed solves accumulate a row of the
+ * panel in x, so full panels are passed to them with a constant width; the
+ * compiler can then keep x in registers.  The other solves update X in place
+ * and gain nothing from it. */
+#define KLU_PANEL 16
+
+/* ========================================================================== */
+/* === lsolve_panel ========================================================= */
+/* ========================================================================== */
+
+/* Solve Lx=b.  Like KLU_lsolve, except that X is n-by-nr in row form with
+ * 1 <= nr <= KLU_PANEL. */
+
+static void lsolve_panel
+(
+    /* inputs, not modified: */
+    Int n,
+    Int Lip [ ],
+    Int Llen [ ],
+    Unit LU [ ],
+    Int nr,
+    /* right-hand-side on input, solution to Lx=b on output */
+    Entry X [ ]
+)
+{
+    Entry x [KLU_PANEL], lik ;
+    Entry *Lx, *Xi, *Xk ;
+    Int *Li ;
+    Int k, p, len, j ;
+
+    for (k = 0 ; k < n ; k++)
+    {
+        GET_POINTER (LU, Lip, Llen, Li, Lx, k, len) ;
+        Xk = X + (size_t) nr * k ;
+        for (j = 0 ; j < nr ; j++)
+        {
+            x [j] = Xk [j] ;
+        }
+        for (p = 0 ; p < len ; p++)
+        {
+            /* X [Li [p]] -= Lx [p] * x ; */
+            lik = Lx [p] ;
+            Xi = X + (size_t) nr * Li [p] ;
+            for (j = 0 ; j < nr ; j++)
+            {
+                MULT_SUB (Xi [j], lik, x [j]) ;
+            }
+        }
+    }
+}
+
+
+/* ========================================================================== */
+/* === usolve_panel ========================================================= */
+/* ========================================================================== */
+
+/* Solve Ux=b.  Like KLU_usolve, except that X is n-by-nr in row form with
+ * 1 <= nr <= KLU_PANEL. */
+
+static void usolve_panel
+(
+    /* inputs, not modified: */
+    Int n,
+    Int Uip [ ],
+    Int Ulen [ ],
+    Unit LU [ ],
+    Entry Udiag [ ],
+    Int nr,
+    /* right-hand-side on input, solution to Ux=b on output */
+    Entry X [ ]
+)
+{
+    Entry x [KLU_PANEL], uik, ukk ;
+    Entry *Ux, *Xi, *Xk ;
+    Int *Ui ;
+    Int k, p, len, j ;
+
+    for (k = n-1 ; k >= 0 ; k--)
+    {
+        GET_POINTER (LU, Uip, Ulen, Ui, Ux, k, len) ;
+        ukk = Udiag [k] ;
+        Xk = X + (size_t) nr * k ;
+        for (j = 0 ; j < nr ; j++)
+        {
+            /* x = X [k] = X [k] / Udiag [k] ; */
+            DIV (x [j], Xk [j], ukk) ;
+            Xk [j] = x [j] ;
+        }
+        for (p = 0 ; p < len ; p++)
+        {
+            /* X [Ui [p]] -= Ux [p] * x ; */
+            uik = Ux [p] ;
+            Xi = X + (size_t) nr * Ui [p] ;
+            for (j = 0 ; j < nr ; j++)
+            {
+                MULT_SUB (Xi [j], uik, x [j]) ;
+            }
+        }
+    }
+}
+
+
+/* ========================================================================== */
+/* === ltsolve_panel ======================================================== */
+/* ========================================================================== */
+
+/* Solve L'x=b.  Like KLU_ltsolve, except that X is n-by-nr in row form with
+ * 1 <= nr <= KLU_PANEL. */
+
+static void ltsolve_panel
+(
+    /* inputs, not modified: */
+    Int n,
+    Int Lip [ ],
+    Int Llen [ ],
+    Unit LU [ ],
+    Int nr,
+#ifdef COMPLEX
+    Int conj_solve,
+#endif
+    /* right-hand-side on input, solution to L'x=b on output */
+    Entry X [ ]
+)
+{
+    Entry x [KLU_PANEL], lik ;
+    Entry *Lx, *Xi, *Xk ;
+    Int *Li ;
+    Int k, p, len, j ;
+
+    for (k = n-1 ; k >= 0 ; k--)
+    {
+        GET_POINTER (LU, Lip, Llen, Li, Lx, k, len) ;
+        Xk = X + (size_t) nr * k ;
+        for (j = 0 ; j < nr ; j++)
+        {
+            x [j] = Xk [j] ;
+        }
+        for (p = 0 ; p < len ; p++)
+        {
+            Xi = X + (size_t) nr * Li [p] ;
+#ifdef COMPLEX
+            if (conj_solve)
+            {
+                /* x -= CONJ (Lx [p]) * X [Li [p]] ; */
+                for (j = 0 ; j < nr ; j++)
+                {
+                    MULT_SUB_CONJ (x [j], Xi [j], Lx [p]) ;
+                }
+            }
+            else
+#endif
+            {
+                /* x -= Lx [p] * X [Li [p]] ; */
+                lik = Lx [p] ;
+                for (j = 0 ; j < nr ; j++)
+                {
+                    MULT_SUB (x [j], lik, Xi [j]) ;
+                }
+            }
+        }
+        for (j = 0 ; j < nr ; j++)
+        {
+            Xk [j] = x [j] ;
+        }
+    }
+}
+
+
+/* ========================================================================== */
+/* === utsolve_panel ======================================================== */
+/* ========================================================================== */
+
+/* Solve U'x=b.  Like KLU_utsolve, except that X is n-by-nr in row form with
+ * 1 <= nr <= KLU_PANEL. */
+
+static void utsolve_panel
+(
+    /* inputs, not modified: */
+    Int n,
+    Int Uip [ ],
+    Int Ulen [ ],
+    Unit LU [ ],
+    Entry Udiag [ ],
+    Int nr,
+#ifdef COMPLEX
+    Int conj_solve,
+#endif
+    /* right-hand-side on input, solution to U'x=b on output */
+    Entry X [ ]
+)
+{
+    Entry x [KLU_PANEL], uik, ukk ;
+    Entry *Ux, *Xi, *Xk ;
+    Int *Ui ;
+    Int k, p, len, j ;
+
+    for (k = 0 ; k < n ; k++)
+    {
+        GET_POINTER (LU, Uip, Ulen, Ui, Ux, k, len) ;
+        Xk = X + (size_t) nr * k ;
+        for (j = 0 ; j < nr ; j++)
+        {
+            x [j] = Xk [j] ;
+        }
+        for (p = 0 ; p < len ; p++)
+        {
+            Xi = X + (size_t) nr * Ui [p] ;
+#ifdef COMPLEX
+            if (conj_solve)
+            {
+                /* x -= CONJ (Ux [p]) * X [Ui [p]] ; */
+                for (j = 0 ; j < nr ; j++)
+                {
+                    MULT_SUB_CONJ (x [j], Xi [j], Ux [p]) ;
+                }
+            }
+            else
+#endif
+            {
+                /* x -= Ux [p] * X [Ui [p]] ; */
+                uik = Ux [p] ;
+                for (j = 0 ; j < nr ; j++)
+                {
+                    MULT_SUB (x [j], uik, Xi [j]) ;
+                }
+            }
+        }
+#ifdef COMPLEX
+        if (conj_solve)
+        {
+            CONJ (ukk, Udiag [k]) ;
+        }
+        else
+#endif
+        {
+            ukk = Udiag [k] ;
+        }
+        for (j = 0 ; j < nr ; j++)
+        {
+            DIV (Xk [j], x [j], ukk) ;
+        }
+    }
+}
+
+
+/* ========================================================================== */
+/* === solve_panel ========================================================== */
+/* ========================================================================== */
+
+/* Solve AX=B or A'X=B for the nr columns of one panel of B, using X (size
+ * n*nr) as workspace. */
+
+static void solve_panel
+(
+    /* inputs, not modified */
+    KLU_symbolic *Symbolic,
+    KLU_numeric *Numeric,
+    Int d,                  /* leading dimension of B */
+    Int nr,                 /* number of columns in the panel */
+    Int transpose,          /* TRUE: solve A'X=B, FALSE: solve AX=B */
+#ifdef COMPLEX
+    Int conj_solve,         /* TRUE: solve A^H X = B if transpose is TRUE */
+#endif
+
+    /* right-hand-side on input, overwritten with the solution on output */
+    Entry B [ ],            /* first column of the panel */
+
+    /* workspace */
+    Entry X [ ]             /* size n*nr */
+)
+{
+    Entry s ;
+    double rs, *Rs ;
+    Entry *Offx, *Udiag, *Xi, *Xk, *Bk ;
+    Int *Q, *R, *Pnum, *Offp, *Offi, *Lip, *Uip, *Llen, *Ulen, *Pin, *Pout ;
+    Unit **LUbx ;
+    Int k1, k2, nk, k, block, pend, n, p, nblocks, j ;
+
+    n = Symbolic->n ;
+    nblocks = Symbolic->nblocks ;
+    Q = Symbolic->Q ;
+    R = Symbolic->R ;
+
+    Pnum = Numeric->Pnum ;
+    Offp = Numeric->Offp ;
+    Offi = Numeric->Offi ;
+    Offx = (Entry *) Numeric->Offx ;
+    Lip  = Numeric->Lip ;
+    Llen = Numeric->Llen ;
+    Uip  = Numeric->Uip ;
+    Ulen = Numeric->Ulen ;
+    LUbx = (Unit **) Numeric->LUbx ;
+    Udiag = Numeric->Udiag ;
+    Rs = Numeric->Rs ;
+
+    /* ---------------------------------------------------------------------- */
+    /* X = P*(R\B) for AX=B, or X = Q'*B for A'X=B */
+    /* ---------------------------------------------------------------------- */
+
+    Pin = transpose ? Q : Pnum ;
+    for (k = 0 ; k < n ; k++)
+    {
+        Xk = X + (size_t) nr * k ;
+        Bk = B + Pin [k] ;
+        if (Rs == NULL || transpose)
+        {
+            for (j = 0 ; j < nr ; j++)
+            {
+                Xk [j] = Bk [(size_t) d * j] ;
+            }
+        }
+        else
+        {
+            rs = Rs [k] ;
+            for (j = 0 ; j < nr ; j++)
+            {
+                SCALE_DIV_ASSIGN (Xk [j], Bk [(size_t) d * j], rs) ;
+            }
+        }
+    }
+
+    if (!transpose)
+    {
+
+        /* ------------------------------------------------------------------ */
+        /* solve X = (L*U + Off)\X */
+        /* ------------------------------------------------------------------ */
+
+        for (block = nblocks-1 ; block >= 0 ; block--)
+        {
+            k1 = R [block] ;
+            k2 = R [block+1] ;
+            nk = k2 - k1 ;
+            PRINTF (("solve_multi %d, k1 %d k2-1 %d nk %d\n", block, k1, k2-1,
+                nk)) ;
+
+            /* solve the block system */
+            if (nk == 1)
+            {
+                s = Udiag [k1] ;
+                Xk = X + (size_t) nr * k1 ;
+                for (j = 0 ; j < nr ; j++)
+                {
+                    DIV (Xk [j], Xk [j], s) ;
+                }
+            }
+            else
+            {
+                lsolve_panel (nk, Lip + k1, Llen + k1, LUbx [block], nr,
+                    X + (size_t) nr * k1) ;
+                usolve_panel (nk, Uip + k1, Ulen + k1, LUbx [block],
+                    Udiag + k1, nr, X + (size_t) nr * k1) ;
+            }
+
+            /* block back-substitution for the off-diagonal-block entries */
+            if (block > 0)
+            {
+                for (k = k1 ; k < k2 ; k++)
+                {
+                    Xk = X + (size_t) nr * k ;
+                    pend = Offp [k+1] ;
+                    for (p = Offp [k] ; p < pend ; p++)
+                    {
+                        s = Offx [p] ;
+                        Xi = X + (size_t) nr * Offi [p] ;
+                        for (j = 0 ; j < nr ; j++)
+                        {
+                            MULT_SUB (Xi [j], s, Xk [j]) ;
+                        }
+                    }
+                }
+            }
+        }
+
+    }
+    else
+    {
+
+        /* ------------------------------------------------------------------ */
+        /* solve X = (L*U + Off)'\X */
+        /* ------------------------------------------------------------------ */
+
+        for (block = 0 ; block < nblocks ; block++)
+        {
+            k1 = R [block] ;
+            k2 = R [block+1] ;
+            nk = k2 - k1 ;
+            PRINTF (("tsolve_multi %d, k1 %d k2-1 %d nk %d\n", block, k1, k2-1,
+                nk)) ;
+
+            /* block back-substitution for the off-diagonal-block entries */
+            if (block > 0)
+            {
+                for (k = k1 ; k < k2 ; k++)
+                {
+                    Xk = X + (size_t) nr * k ;
+                    pend = Offp [k+1] ;
+                    for (p = Offp [k] ; p < pend ; p++)
+                    {
+                        Xi = X + (size_t) nr * Offi [p] ;
+#ifdef COMPLEX
+                        if (conj_solve)
+                        {
+                            for (j = 0 ; j < nr ; j++)
+                            {
+                                MULT_SUB_CONJ (Xk [j], Xi [j], Offx [p]) ;
+                            }
+                        }
+                        else
+#endif
+                        {
+                            s = Offx [p] ;
+                            for (j = 0 ; j < nr ; j++)
+                            {
+                                MULT_SUB (Xk [j], s, Xi [j]) ;
+                            }
+                        }
+                    }
+                }
+            }
+
+            /* solve the block system */
+            if (nk == 1)
+            {
+#ifdef COMPLEX
+                if (conj_solve)
+                {
+                    CONJ (s, Udiag [k1]) ;
+                }
+                else
+#endif
+                {
+                    s = Udiag [k1] ;
+                }
+                Xk = X + (size_t) nr * k1 ;
+                for (j = 0 ; j < nr ; j++)
+                {
+                    DIV (Xk [j], Xk [j], s) ;
+                }
+            }
+            else if (nr == KLU_PANEL)
+            {
+                /* full panel: the width is a constant */
+                utsolve_panel (nk, Uip + k1, Ulen + k1, LUbx [block],
+                    Udiag + k1, KLU_PANEL,
+#ifdef COMPLEX
+                    conj_solve,
+#endif
+                    X + KLU_PANEL*k1) ;
+                ltsolve_panel (nk, Lip + k1, Llen + k1, LUbx [block],
+                    KLU_PANEL,
+#ifdef COMPLEX
+                    conj_solve,
+#endif
+                    X + KLU_PANEL*k1) ;
+            }
+            else
+            {
+                utsolve_panel (nk, Uip + k1, Ulen + k1, LUbx [block],
+                    Udiag + k1, nr,
+#ifdef COMPLEX
+                    conj_solve,
+#endif
+                    X + (size_t) nr * k1) ;
+                ltsolve_panel (nk, Lip + k1, Llen + k1, LUbx [block], nr,
+#ifdef COMPLEX
+                    conj_solve,
+#endif
+                    X + (size_t) nr * k1) ;
+            }
+        }
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* B = Q*X for AX=B, or B = P'(R\X) for A'X=B */
+    /* ---------------------------------------------------------------------- */
+
+    Pout = transpose ? Pnum : Q ;
+    for (k = 0 ; k < n ; k++)
+    {
+        Xk = X + (size_t) nr * k ;
+        Bk = B + Pout [k] ;
+        if (Rs == NULL || !transpose)
+        {
+            for (j = 0 ; j < nr ; j++)
+            {
+                Bk [(size_t) d * j] = Xk [j] ;
+            }
+        }
+        else
+        {
+            rs = Rs [k] ;
+            for (j = 0 ; j < nr ; j++)
+            {
+                SCALE_DIV_ASSIGN (Bk [(size_t) d * j], Xk [j], rs) ;
+            }
+        }
+    }
+}
+
+
+/* ========================================================================== */
+/* === solve_multi ========================================================== */
+/* ========================================================================== */
+
+/* Splits the right-hand-sides into panels and solves them, concurrently if
+ * possible.  The panels are made narrower than KLU_PANEL if that is needed to
+ * give each thread at least one panel. */
+
+static Int solve_multi
+(
+    KLU_symbolic *Symbolic,
+    KLU_numeric *Numeric,
+    Int d,
+    Int nrhs,
+    double B [ ],
+    Int transpose,
+#ifdef COMPLEX
+    Int conj_solve,
+#endif
+    KLU_common *Common
+)
+{
+    Entry *Bz, *X ;
+    size_t s ;
+    Int n, nb, npanels, nthreads, panel, ok ;
+
+    /* ---------------------------------------------------------------------- */
+    /* check inputs */
+    /* ---------------------------------------------------------------------- */
+
+    if (Common == NULL)
+    {
+        return (FALSE) ;
+    }
+    if (Numeric == NULL || Symbolic == NULL || d < Symbolic->n || nrhs < 0 ||
+        B == NULL)
+    {
+        Common->status = KLU_INVALID ;
+        return (FALSE) ;
+    }
+    Common->status = KLU_OK ;
+
+    if (Numeric->mixed)
+    {
+        /* L and U are held in single precision; the right-hand-sides are
+         * refined one at a time */
+        return (KLU_mixed_solve (Symbolic, Numeric, d, nrhs, B, transpose,
+#ifdef COMPLEX
+            conj_solve,
+#endif
+            Common)) ;
+    }
+
+    n = Symbolic->n ;
+    if (n == 0 || nrhs == 0)
+    {
+        /* nothing to do */
+        return (TRUE) ;
+    }
+    ASSERT (Symbolic->nblocks == Numeric->nblocks) ;
+    ASSERT (KLU_valid (n, Numeric->Offp, Numeric->Offi,
+        (Entry *) Numeric->Offx)) ;
+
+    /* ---------------------------------------------------------------------- */
+    /* determine the panels and allocate workspace for each thread */
+    /* ---------------------------------------------------------------------- */
+
+    nthreads = KLU_nthreads (nrhs, Common) ;
+    nb = MIN (KLU_PANEL, (nrhs + nthreads - 1) / nthreads) ;
+    npanels = (nrhs + nb - 1) / nb ;
+    nthreads = MIN (nthreads, npanels) ;
+
+    ok = TRUE ;
+    s = KLU_mult_size_t (n, nb * nthreads, &ok) ;
+    if (!ok)
+    {
+        Common->status = KLU_TOO_LARGE ;
+        return (FALSE) ;
+    }
+    X = KLU_malloc (s, sizeof (Entry), Common) ;
+    if (Common->status < KLU_OK)
+    {
+        /* out of memory, or problem too large */
+        return (FALSE) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* solve each panel */
+    /* ---------------------------------------------------------------------- */
+
+    Bz = (Entry *) B ;
+
+#ifdef _OPENMP
+    if (nthreads > 1)
+    {
+        #pragma omp parallel for num_threads(nthreads) schedule(dynamic,1)
+        for (panel = 0 ; panel < npanels ; panel++)
+        {
+            solve_panel (Symbolic, Numeric, d, MIN (nrhs - panel*nb, nb),
+                transpose,
+#ifdef COMPLEX
+                conj_solve,
+#endif
+                Bz + (size_t) d * panel * nb,
+                X + (size_t) n * nb * omp_get_thread_num ()) ;
+        }
+    }
+    else
+#endif
+    {
+        for (panel = 0 ; panel < npanels ; panel++)
+        {
+            solve_panel (Symbolic, Numeric, d, MIN (nrhs - panel*nb, nb),
+                transpose,
+#ifdef COMPLEX
+                conj_solve,
+#endif
+                Bz + (size_t) d * panel * nb, X) ;
+        }
+    }
+
+    KLU_free (X, s, sizeof (Entry), Common) ;
+    return (TRUE) ;
+}
+
+
+/* ========================================================================== */
+/* === KLU_solve_multi ====================================================== */
+/* ========================================================================== */
+
+Int KLU_solve_multi
+(
+    /* inputs, not modified */
+    KLU_symbolic *Symbolic,
+    KLU_numeric *Numeric,
+    Int d,                  /* leading dimension of B */
+    Int nrhs,               /* number of right-hand-sides */
+
+    /* right-hand-side on input, overwritten with solution to Ax=b on output */
+    double B [ ],           /* size n*nrhs, in column-oriented form, with
+                             * leading dimension d. */
+    /* --------------- */
+    KLU_common *Common
+)
+{
+    return (solve_multi (Symbolic, Numeric, d, nrhs, B, FALSE,
+#ifdef COMPLEX
+        FALSE,
+#endif
+        Common)) ;
+}
+
+
+/* ========================================================================== */
+/* === KLU_tsolve_multi ===================================================== */
+/* ========================================================================== */
+
+Int KLU_tsolve_multi
+(
+    /* inputs, not modified */
+    KLU_symbolic *Symbolic,
+    KLU_numeric *Numeric,
+    Int d,                  /* leading dimension of B */
+    Int nrhs,               /* number of right-hand-sides */
+
+    /* right-hand-side on input, overwritten with solution to A'x=b on output */
+    double B [ ],           /* size n*nrhs, in column-oriented form, with
+                             * leading dimension d. */
+#ifdef COMPLEX
+    Int conj_solve,         /* TRUE for conjugate transpose solve, FALSE for
+                             * array transpose solve.  Used for the complex
+                             * case only. */
+#endif
+    /* --------------- */
+    KLU_common *Common
+)
+{
+    return (solve_multi (Symbolic, Numeric, d, nrhs, B, TRUE,
+#ifdef COMPLEX
+        conj_solve,
+#endif
+        Common)) ;
+}
@@ -12,13 +12,15 @@
 /* === sort ================================================================= */
 /* ========================================================================== */
 
-/* Sort L or U using a double-transpose */
+/* Sort L or U using a double-transpose.  If mixed is TRUE, the entries of L
+ * and U are in single precision. */
 
 static void sort (Int n, Int *Xip, Int *Xlen, Unit *LU, Int *Tp, Int *Tj,
-    Entry *Tx, Int *W)
+    Entry *Tx, Int *W, Int mixed)
 {
     Int *Xi ;
     Entry *Xx ;
+    SEntry *Xs ;
     Int p, i, j, len, nz, tp, xlen, pend ;
 
     ASSERT (KLU_valid_LU (n, FALSE, Xip, Xlen, LU)) ;
@@ -53,12 +55,25 @@ static void sort (Int n, Int *Xip, Int *Xlen, Unit *LU, Int *Tp, Int *Tj,
     /* transpose the matrix into Tp, Ti, Tx */
     for (j = 0 ; j < n ; j++)
     {
-        GET_POINTER (LU, Xip, Xlen, Xi, Xx, j, len) ;
-        for (p = 0 ; p < len ; p++)
+        if (mixed)
         {
-            tp = W [Xi [p]]++ ;
-            Tj [tp] = j ;
-            Tx [tp] = Xx [p] ;
+            GET_S_POINTER (LU, Xip, Xlen, Xi, Xs, j, len) ;
+            for (p = 0 ; p < len ; p++)
+            {
+                tp = W [Xi [p]]++ ;
+                Tj [tp] = j ;
+                TO_DOUBLE (Tx [tp], Xs [p]) ;
+            }
+        }
+        else
+        {
+            GET_POINTER (LU, Xip, Xlen, Xi, Xx, j, len) ;
+            for (p = 0 ; p < len ; p++)
+            {
+                tp = W [Xi [p]]++ ;
+                Tj [tp] = j ;
+                Tx [tp] = Xx [p] ;
+            }
         }
     }
 
@@ -73,10 +88,19 @@ static void sort (Int n, Int *Xip, Int *Xlen, Unit *LU, Int *Tp, Int *Tj,
         for (p = Tp [i] ; p < pend ; p++)
         {
             j = Tj [p] ;
-            GET_POINTER (LU, Xip, Xlen, Xi, Xx, j, len) ;
             xlen = W [j]++ ;
-            Xi [xlen] = i ;
-            Xx [xlen] = Tx [p] ;
+            if (mixed)
+            {
+                GET_S_POINTER (LU, Xip, Xlen, Xi, Xs, j, len) ;
+                Xi [xlen] = i ;
+                TO_SINGLE (Xs [xlen], Tx [p]) ;
+            }
+            else
+            {
+                GET_POINTER (LU, Xip, Xlen, Xi, Xx, j, len) ;
+                Xi [xlen] = i ;
+                Xx [xlen] = Tx [p] ;
+            }
         }
     }
 
@@ -139,8 +163,10 @@ Int KLU_sort
             if (nk > 1)
             {
                 PRINTF (("\n-------------------block: %d nk %d\n", block, nk)) ;
-                sort (nk, Lip + k1, Llen + k1, LUbx [block], Tp, Ti, Tx, W) ;
-                sort (nk, Uip + k1, Ulen + k1, LUbx [block], Tp, Ti, Tx, W) ;
+                sort (nk, Lip + k1, Llen + k1, LUbx [block], Tp, Ti, Tx, W,
+                    Numeric->mixed) ;
+                sort (nk, Uip + k1, Ulen + k1, LUbx [block], Tp, Ti, Tx, W,
+                    Numeric->mixed) ;
             }
         }
     }
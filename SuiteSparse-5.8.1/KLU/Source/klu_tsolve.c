@@ -4,9 +4,9 @@
 
 /* Solve A'x=b using the symbolic and numeric objects from KLU_analyze
  * (or KLU_analyze_given) and KLU_factor.  Note that no iterative refinement is
- * performed.  Uses Numeric->Xwork as workspace (undefined on input and output),
- * of size 4n Entry's (note that columns 2 to 4 of Xwork overlap with
- * Numeric->Iwork).
+ * performed, unless L and U are held in single precision (see KLU_mixed).
+ * Uses Numeric->Xwork as workspace (undefined on input and output), of size
+ * 4n Entry's (note that columns 2 to 4 of Xwork overlap with Numeric->Iwork).
  */
 
 #include "klu_internal.h"
@@ -54,6 +54,16 @@ Int KLU_tsolve
     }
     Common->status = KLU_OK ;
 
+    if (Numeric->mixed)
+    {
+        /* L and U are held in single precision */
+        return (KLU_mixed_solve (Symbolic, Numeric, d, nrhs, B, TRUE,
+#ifdef COMPLEX
+            conj_solve,
+#endif
+            Common)) ;
+    }
+
     /* ---------------------------------------------------------------------- */
     /* get the contents of the Symbolic object */
     /* ---------------------------------------------------------------------- */
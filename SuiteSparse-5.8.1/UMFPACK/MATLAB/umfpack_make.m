@@ -122,7 +122,7 @@ end
 
 % non-user-callable umf_*.[ch] files:
 umfch = { 'assemble', 'blas3_update', ...
-        'build_tuples', 'create_element', ...
+        'build_tuples', 'create_element', 'dense', ...
         'dump', 'extend_front', 'garbage_collection', ...
         'get_memory', 'init_front', 'kernel', ...
         'kernel_init', 'kernel_wrapup', ...
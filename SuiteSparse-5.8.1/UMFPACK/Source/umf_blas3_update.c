@@ -9,6 +9,7 @@
 
 #include "umf_internal.h"
 #include "umf_blas3_update.h"
+#include "umf_dense.h"
 
 GLOBAL void UMF_blas3_update
 (
@@ -20,7 +21,7 @@ GLOBAL void UMF_blas3_update
     /* ---------------------------------------------------------------------- */
 
     Entry *L, *U, *C, *LU ;
-    Int i, j, s, k, m, n, d, nb, dc ;
+    Int k, m, n, d, nb, dc ;
     
 #ifndef NBLAS
     Int blas_ok = TRUE ;
@@ -68,25 +69,10 @@ GLOBAL void UMF_blas3_update
 
 	if (!blas_ok)
 	{
-	    /* rank-1 outer product to update the C block */
-	    for (j = 0 ; j < n ; j++)
-	    {
-		Entry u_j = U [j] ;
-		if (IS_NONZERO (u_j))
-		{
-		    Entry *c_ij, *l_is ;
-		    c_ij = & C [j*d] ;
-		    l_is = & L [0] ;
-#pragma ivdep
-		    for (i = 0 ; i < m ; i++)
-		    {
-			/* C [i+j*d]-= L [i] * U [j] */
-			MULT_SUB (*c_ij, *l_is, u_j) ;
-			c_ij++ ;
-			l_is++ ;
-		    }
-		}
-	    }
+	    /* rank-1 outer product to update the C block, with the bundled
+	     * kernel if no BLAS at compile time, or if integer overflow has
+	     * occurred */
+	    UMF_dense_gemm (m, n, 1, L, U, dc, C, d) ;
 	}
 
     }
@@ -101,29 +87,9 @@ GLOBAL void UMF_blas3_update
 
 	if (!blas_ok)
 	{
-	    /* use plain C code if no BLAS at compile time, or if integer
+	    /* use the bundled kernel if no BLAS at compile time, or if integer
 	     * overflow has occurred */
-	    for (s = 0 ; s < k ; s++)
-	    {
-		for (i = s+1 ; i < k ; i++)
-		{
-		    Entry l_is = LU [i+s*nb] ;
-		    if (IS_NONZERO (l_is))
-		    {
-			Entry *u_ij, *u_sj ;
-			u_ij = & U [i*dc] ;
-			u_sj = & U [s*dc] ;
-#pragma ivdep
-			for (j = 0 ; j < n ; j++)
-			{
-			    /* U [i*dc+j] -= LU [i+s*nb] * U [s*dc+j] ; */
-			    MULT_SUB (*u_ij, l_is, *u_sj) ;
-			    u_ij++ ;
-			    u_sj++ ;
-			}
-		    }
-		}
-	    }
+	    UMF_dense_trsm (n, k, LU, nb, U, dc) ;
 	}
 
 	/* rank-k outer product to update the C block */
@@ -135,30 +101,9 @@ GLOBAL void UMF_blas3_update
 
 	if (!blas_ok)
 	{
-	    /* use plain C code if no BLAS at compile time, or if integer
+	    /* use the bundled kernel if no BLAS at compile time, or if integer
 	     * overflow has occurred */
-
-	    for (s = 0 ; s < k ; s++)
-	    {
-		for (j = 0 ; j < n ; j++)
-		{
-		    Entry u_sj = U [j+s*dc] ;
-		    if (IS_NONZERO (u_sj))
-		    {
-			Entry *c_ij, *l_is ;
-			c_ij = & C [j*d] ;
-			l_is = & L [s*d] ;
-#pragma ivdep
-			for (i = 0 ; i < m ; i++)
-			{
-			    /* C [i+j*d]-= L [i+s*d] * U [s*dc+j] */
-			    MULT_SUB (*c_ij, *l_is, u_sj) ;
-			    c_ij++ ;
-			    l_is++ ;
-			}
-		    }
-		}
-	    }
+	    UMF_dense_gemm (m, n, k, L, U, dc, C, d) ;
 	}
     }
 
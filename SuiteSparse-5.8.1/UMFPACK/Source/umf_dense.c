@@ -0,0 +1,248 @@
+/* ========================================================================== */
+/* === UMF_dense ============================================================ */
+/* ========================================================================== */
+
+/* -------------------------------------------------------------------------- */
+/* All Rights Reserved.  See ../Doc/License.txt for License.                  */
+/* -------------------------------------------------------------------------- */
+
+/* Dense kernels for the frontal matrix updates in UMF_blas3_update, used when
+ * UMFPACK is compiled without the BLAS (-DNBLAS), or when the BLAS cannot be
+ * used because of integer overflow.  They replace the plain triple loops with
+ * cache-blocked, register-blocked loops whose innermost loop has stride 1 and
+ * no dependencies, so that the compiler can vectorize it.  Each entry of the
+ * result is computed with the same sequence of operations as the plain
+ * loops, except that zero entries in the multipliers are not skipped.
+ *
+ * UMF_dense_gemm:  C = C - A*B', where A is m-by-k with leading dimension
+ *	ldac, B is n-by-k with leading dimension ldb, and C is m-by-n with
+ *	leading dimension ldac (as BLAS_GEMM).  With k = 1 this is also the
+ *	rank-1 update of BLAS_GER.
+ *
+ * UMF_dense_trsm:  solve X*A' = B, where B is m-by-n with leading dimension
+ *	ldb and is overwritten with X, and A is n-by-n unit lower triangular
+ *	with leading dimension lda (as BLAS_TRSM_RIGHT).
+ */
+
+#include "umf_internal.h"
+#include "umf_dense.h"
+
+/* rows of C (or of B, for the triangular solve) in each block, chosen so
+ * that the block of A (or of B) that is reused stays in the cache */
+#define DENSE_MB 128
+
+/* -------------------------------------------------------------------------- */
+/* gemm4: C (i1:i2-1, 0:3) -= A (i1:i2-1, 0:k-1) * B (0:3, 0:k-1)' */
+/* -------------------------------------------------------------------------- */
+
+PRIVATE void gemm4
+(
+    Int i1,
+    Int i2,
+    Int k,
+    Entry A [ ],
+    Entry B [ ],
+    Int ldb,
+    Entry C [ ],
+    Int ldac
+)
+{
+    Entry x0, x1, x2, x3, a0, a1, b00, b10, b20, b30, b01, b11, b21, b31 ;
+    Entry *c0, *c1, *c2, *c3, *as0, *as1 ;
+    Int i, s ;
+
+    c0 = C ;
+    c1 = C + ldac ;
+    c2 = C + 2*ldac ;
+    c3 = C + 3*ldac ;
+
+    /* two columns of A at a time */
+    for (s = 0 ; s+1 < k ; s += 2)
+    {
+	as0 = A + s*ldac ;
+	as1 = as0 + ldac ;
+	b00 = B [  s*ldb] ; b01 = B [  (s+1)*ldb] ;
+	b10 = B [1+s*ldb] ; b11 = B [1+(s+1)*ldb] ;
+	b20 = B [2+s*ldb] ; b21 = B [2+(s+1)*ldb] ;
+	b30 = B [3+s*ldb] ; b31 = B [3+(s+1)*ldb] ;
+#pragma ivdep
+	for (i = i1 ; i < i2 ; i++)
+	{
+	    a0 = as0 [i] ;
+	    a1 = as1 [i] ;
+	    x0 = c0 [i] ; MULT_SUB (x0, a0, b00) ; MULT_SUB (x0, a1, b01) ;
+	    x1 = c1 [i] ; MULT_SUB (x1, a0, b10) ; MULT_SUB (x1, a1, b11) ;
+	    x2 = c2 [i] ; MULT_SUB (x2, a0, b20) ; MULT_SUB (x2, a1, b21) ;
+	    x3 = c3 [i] ; MULT_SUB (x3, a0, b30) ; MULT_SUB (x3, a1, b31) ;
+	    c0 [i] = x0 ;
+	    c1 [i] = x1 ;
+	    c2 [i] = x2 ;
+	    c3 [i] = x3 ;
+	}
+    }
+
+    /* last column of A, if k is odd */
+    if (s < k)
+    {
+	as0 = A + s*ldac ;
+	b00 = B [  s*ldb] ;
+	b10 = B [1+s*ldb] ;
+	b20 = B [2+s*ldb] ;
+	b30 = B [3+s*ldb] ;
+#pragma ivdep
+	for (i = i1 ; i < i2 ; i++)
+	{
+	    a0 = as0 [i] ;
+	    MULT_SUB (c0 [i], a0, b00) ;
+	    MULT_SUB (c1 [i], a0, b10) ;
+	    MULT_SUB (c2 [i], a0, b20) ;
+	    MULT_SUB (c3 [i], a0, b30) ;
+	}
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+/* gemm1: C (i1:i2-1, 0) -= A (i1:i2-1, 0:k-1) * B (0, 0:k-1)' */
+/* -------------------------------------------------------------------------- */
+
+PRIVATE void gemm1
+(
+    Int i1,
+    Int i2,
+    Int k,
+    Entry A [ ],
+    Entry B [ ],
+    Int ldb,
+    Entry C [ ],
+    Int ldac
+)
+{
+    Entry x0, b00, b01 ;
+    Entry *as0, *as1 ;
+    Int i, s ;
+
+    for (s = 0 ; s+1 < k ; s += 2)
+    {
+	as0 = A + s*ldac ;
+	as1 = as0 + ldac ;
+	b00 = B [s*ldb] ;
+	b01 = B [(s+1)*ldb] ;
+#pragma ivdep
+	for (i = i1 ; i < i2 ; i++)
+	{
+	    x0 = C [i] ;
+	    MULT_SUB (x0, as0 [i], b00) ;
+	    MULT_SUB (x0, as1 [i], b01) ;
+	    C [i] = x0 ;
+	}
+    }
+
+    if (s < k)
+    {
+	as0 = A + s*ldac ;
+	b00 = B [s*ldb] ;
+#pragma ivdep
+	for (i = i1 ; i < i2 ; i++)
+	{
+	    MULT_SUB (C [i], as0 [i], b00) ;
+	}
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+/* UMF_dense_gemm */
+/* -------------------------------------------------------------------------- */
+
+GLOBAL void UMF_dense_gemm
+(
+    Int m,
+    Int n,
+    Int k,
+    Entry A [ ],	/* m-by-k, leading dimension ldac */
+    Entry B [ ],	/* n-by-k, leading dimension ldb */
+    Int ldb,
+    Entry C [ ],	/* m-by-n, leading dimension ldac */
+    Int ldac
+)
+{
+    Int i1, i2, j ;
+
+    /* the rows i1:i2-1 of A are reused for all columns of C */
+    for (i1 = 0 ; i1 < m ; i1 += DENSE_MB)
+    {
+	i2 = MIN (i1 + DENSE_MB, m) ;
+	for (j = 0 ; j+3 < n ; j += 4)
+	{
+	    gemm4 (i1, i2, k, A, B + j, ldb, C + j*ldac, ldac) ;
+	}
+	for ( ; j < n ; j++)
+	{
+	    gemm1 (i1, i2, k, A, B + j, ldb, C + j*ldac, ldac) ;
+	}
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+/* UMF_dense_trsm */
+/* -------------------------------------------------------------------------- */
+
+GLOBAL void UMF_dense_trsm
+(
+    Int m,
+    Int n,
+    Entry A [ ],	/* n-by-n unit lower triangular, leading dimension lda */
+    Int lda,
+    Entry B [ ],	/* m-by-n, leading dimension ldb */
+    Int ldb
+)
+{
+    Entry x, l0, l1, l2, l3 ;
+    Entry *bi, *b0, *b1, *b2, *b3 ;
+    Int i, i1, i2, j, s ;
+
+    /* B (j, i) -= A (i, s) * B (j, s) for s = 0:i-1 in increasing order, for
+     * each block of DENSE_MB rows of B at a time */
+    for (i1 = 0 ; i1 < m ; i1 += DENSE_MB)
+    {
+	i2 = MIN (i1 + DENSE_MB, m) ;
+	for (i = 1 ; i < n ; i++)
+	{
+	    bi = B + i*ldb ;
+
+	    /* four columns of B at a time */
+	    for (s = 0 ; s+3 < i ; s += 4)
+	    {
+		l0 = A [i+s*lda] ;
+		l1 = A [i+(s+1)*lda] ;
+		l2 = A [i+(s+2)*lda] ;
+		l3 = A [i+(s+3)*lda] ;
+		b0 = B + s*ldb ;
+		b1 = b0 + ldb ;
+		b2 = b1 + ldb ;
+		b3 = b2 + ldb ;
+#pragma ivdep
+		for (j = i1 ; j < i2 ; j++)
+		{
+		    x = bi [j] ;
+		    MULT_SUB (x, l0, b0 [j]) ;
+		    MULT_SUB (x, l1, b1 [j]) ;
+		    MULT_SUB (x, l2, b2 [j]) ;
+		    MULT_SUB (x, l3, b3 [j]) ;
+		    bi [j] = x ;
+		}
+	    }
+
+	    /* remaining columns of B */
+	    for ( ; s < i ; s++)
+	    {
+		l0 = A [i+s*lda] ;
+		b0 = B + s*ldb ;
+#pragma ivdep
+		for (j = i1 ; j < i2 ; j++)
+		{
+		    MULT_SUB (bi [j], l0, b0 [j]) ;
+		}
+	    }
+	}
+    }
+}
@@ -0,0 +1,25 @@
+/* -------------------------------------------------------------------------- */
+/* All Rights Reserved.  See ../Doc/License.txt for License.                  */
+/* -------------------------------------------------------------------------- */
+
+GLOBAL void UMF_dense_gemm
+(
+    Int m,
+    Int n,
+    Int k,
+    Entry A [ ],
+    Entry B [ ],
+    Int ldb,
+    Entry C [ ],
+    Int ldac
+) ;
+
+GLOBAL void UMF_dense_trsm
+(
+    Int m,
+    Int n,
+    Entry A [ ],
+    Int lda,
+    Entry B [ ],
+    Int ldb
+) ;
@@ -430,6 +430,8 @@ typedef struct
 #define UMF_colamd		 umf_i_colamd
 #define UMF_colamd_set_defaults	 umf_i_colamd_set_defaults
 #define UMF_create_element	 umfdi_create_element
+#define UMF_dense_gemm		 umfdi_dense_gemm
+#define UMF_dense_trsm		 umfdi_dense_trsm
 #define UMF_extend_front	 umfdi_extend_front
 #define UMF_free		 umf_i_free
 #define UMF_fsize		 umf_i_fsize
@@ -546,6 +548,8 @@ typedef struct
 #define UMF_colamd		 umf_l_colamd
 #define UMF_colamd_set_defaults	 umf_l_colamd_set_defaults
 #define UMF_create_element	 umfdl_create_element
+#define UMF_dense_gemm		 umfdl_dense_gemm
+#define UMF_dense_trsm		 umfdl_dense_trsm
 #define UMF_extend_front	 umfdl_extend_front
 #define UMF_free		 umf_l_free
 #define UMF_fsize		 umf_l_fsize
@@ -662,6 +666,8 @@ typedef struct
 #define UMF_colamd		 umf_i_colamd
 #define UMF_colamd_set_defaults	 umf_i_colamd_set_defaults
 #define UMF_create_element	 umfzi_create_element
+#define UMF_dense_gemm		 umfzi_dense_gemm
+#define UMF_dense_trsm		 umfzi_dense_trsm
 #define UMF_extend_front	 umfzi_extend_front
 #define UMF_free		 umf_i_free
 #define UMF_fsize		 umf_i_fsize
@@ -778,6 +784,8 @@ typedef struct
 #define UMF_colamd		 umf_l_colamd
 #define UMF_colamd_set_defaults	 umf_l_colamd_set_defaults
 #define UMF_create_element	 umfzl_create_element
+#define UMF_dense_gemm		 umfzl_dense_gemm
+#define UMF_dense_trsm		 umfzl_dense_trsm
 #define UMF_extend_front	 umfzl_extend_front
 #define UMF_free		 umf_l_free
 #define UMF_fsize		 umf_l_fsize
@@ -50,7 +50,7 @@
 #define LIS_BINARY_LITTLE      1
 
 
-#define LIS_OPTIONS_LEN          27
+#define LIS_OPTIONS_LEN          30
 #define LIS_OPTIONS_SOLVER        0
 #define LIS_OPTIONS_PRECON        1
 #define LIS_OPTIONS_MAXITER        2
@@ -78,6 +78,9 @@
 #define LIS_OPTIONS_CONV_COND      24
 #define LIS_OPTIONS_INIT_SHADOW_RESID  25
 #define LIS_OPTIONS_IDRS_RESTART      26
+#define LIS_OPTIONS_PRECON_REUSE      27
+#define LIS_OPTIONS_ILU_LEVELSET      28
+#define LIS_OPTIONS_CAGMRES_S        29
 
 #define LIS_EOPTIONS_LEN             11
 #define LIS_EOPTIONS_ESOLVER        0
@@ -92,7 +95,7 @@
 #define LIS_EOPTIONS_PRECISION              9
 #define LIS_EOPTIONS_SWITCH_MAXITER           10
 
-#define LIS_PARAMS_LEN        15
+#define LIS_PARAMS_LEN        16
 #define LIS_PARAMS_RESID      LIS_OPTIONS_LEN+0
 #define LIS_PARAMS_W        LIS_OPTIONS_LEN+1
 #define LIS_PARAMS_RELAX      LIS_OPTIONS_LEN+2
@@ -108,6 +111,7 @@
 #define LIS_PARAMS_RATE        LIS_OPTIONS_LEN+12
 #define LIS_PARAMS_RESID_WEIGHT      LIS_OPTIONS_LEN+13
 #define LIS_PARAMS_SAAMG_THETA      LIS_OPTIONS_LEN+14
+#define LIS_PARAMS_PRECON_REUSE_RATIO  LIS_OPTIONS_LEN+15
 
 #define LIS_EPARAMS_LEN        2
 #define LIS_EPARAMS_RESID      LIS_EOPTIONS_LEN+0
@@ -137,7 +141,7 @@
 #define LIS_CONV_COND_NRM2_B    1
 #define LIS_CONV_COND_NRM1_B    2
 
-#define LIS_SOLVER_LEN        23
+#define LIS_SOLVER_LEN        25
 #define LIS_SOLVER_CG        1
 #define LIS_SOLVER_BICG        2
 #define LIS_SOLVER_CGS        3
@@ -162,6 +166,8 @@
 #define LIS_SOLVER_IDRS              21
 #define LIS_SOLVER_MINRES      22
 #define LIS_SOLVER_IDR1              23
+#define LIS_SOLVER_PCG        24
+#define LIS_SOLVER_CAGMRES      25
 
 #define LIS_ESOLVER_LEN        8
 #define LIS_ESOLVER_PI               1
@@ -248,6 +254,7 @@
 #define LIS_MATRIX_LBSR      19
 #define LIS_MATRIX_CDIA      20
 #define LIS_MATRIX_MSC      21
+#define LIS_MATRIX_SELL     22
 #define LIS_MATRIX_DECIDING_SIZE   -(LIS_MATRIX_RCO+1)
 #define LIS_MATRIX_NULL        -(LIS_MATRIX_RCO+2)
 
@@ -556,6 +563,20 @@ struct LIS_MATRIX_ILU_STRUCT
 };
 typedef struct LIS_MATRIX_ILU_STRUCT *LIS_MATRIX_ILU;
 
+struct LIS_MATRIX_LEVEL_STRUCT
+{
+  LIS_INT      n;
+  LIS_INT      nlevel;
+  LIS_INT      trans;
+  LIS_INT      *level;
+  LIS_INT      *row;
+  LIS_INT      *ptr;
+  LIS_INT      *index;
+  LIS_SCALAR  *value;
+  LIS_SCALAR  *diag;
+};
+typedef struct LIS_MATRIX_LEVEL_STRUCT *LIS_MATRIX_LEVEL;
+
 struct LIS_PRECON_STRUCT
 {
   LIS_INT      precon_type;
@@ -563,6 +584,8 @@ struct LIS_PRECON_STRUCT
   LIS_MATRIX  At;
   LIS_MATRIX_ILU  L;            /* ilu(k),ilut,iluc,sainv */
   LIS_MATRIX_ILU  U;            /* ilu(k),ilut,iluc,sainv */
+  LIS_MATRIX_LEVEL Llev;          /* ilu(k),ilut,iluc level sets */
+  LIS_MATRIX_LEVEL Ulev;          /* ilu(k),ilut,iluc level sets */
   LIS_MATRIX_DIAG WD;            /* bilu(k),bilut,biluc,bjacobi */
   LIS_VECTOR  D;              /* ilu(k),ilut,iluc,jacobi,sainv */
   LIS_VECTOR  Pb;              /* i+s */
@@ -606,6 +629,8 @@ struct LIS_SOLVER_STRUCT
   LIS_REAL  bnrm;
   LIS_REAL  tol;
   LIS_REAL  tol_switch;
+  LIS_PRECON  reuse_precon;        /* precon_reuse */
+  LIS_INT    reuse_iter;          /* precon_reuse */
 };
 typedef struct LIS_SOLVER_STRUCT *LIS_SOLVER;
 
@@ -731,6 +756,8 @@ extern "C"
   extern LIS_INT lis_matrix_malloc_msr(LIS_INT n, LIS_INT nnz, LIS_INT ndz, LIS_INT **index, LIS_SCALAR **value);
   extern LIS_INT lis_matrix_set_ell(LIS_INT maxnzr, LIS_INT *index, LIS_SCALAR *value, LIS_MATRIX A);
   extern LIS_INT lis_matrix_malloc_ell(LIS_INT n, LIS_INT maxnzr, LIS_INT **index, LIS_SCALAR **value);
+  extern LIS_INT lis_matrix_set_sell(LIS_INT maxnzr, LIS_INT *perm, LIS_INT *ptr, LIS_INT *index, LIS_SCALAR *value, LIS_MATRIX A);
+  extern LIS_INT lis_matrix_malloc_sell(LIS_INT n, LIS_INT len, LIS_INT **perm, LIS_INT **ptr, LIS_INT **index, LIS_SCALAR **value);
   extern LIS_INT lis_matrix_set_jad(LIS_INT nnz, LIS_INT maxnzr, LIS_INT *perm, LIS_INT *ptr, LIS_INT *index, LIS_SCALAR *value, LIS_MATRIX A);
   extern LIS_INT lis_matrix_malloc_jad(LIS_INT n, LIS_INT nnz, LIS_INT maxnzr, LIS_INT **perm, LIS_INT **ptr, LIS_INT **index, LIS_SCALAR **value);
   extern LIS_INT lis_matrix_set_dia(LIS_INT nnd, LIS_INT *index, LIS_SCALAR *value, LIS_MATRIX A);
@@ -818,6 +845,7 @@ extern "C"
   extern void lis_free(void *p);
   extern void lis_free2(LIS_INT n, ...);
   extern LIS_INT lis_is_malloc( void *p );
+  extern LIS_INT lis_malloc_pool( size_t size );
   extern void lis_date(char *date);
 
 
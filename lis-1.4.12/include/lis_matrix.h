@@ -40,8 +40,12 @@
 #define LIS_MATRIX_VBR_STR    "vbr"
 #define LIS_MATRIX_DNS_STR    "dns"
 #define LIS_MATRIX_COO_STR    "coo"
+#define LIS_MATRIX_SELL_STR   "sell"
 #define LIS_MATRIX_TJD_STR    "tjd"
 
+#define LIS_MATRIX_SELL_C      8
+#define LIS_MATRIX_SELL_SIGMA  256
+
 #define LIS_MATRIX_CHECK_ALL      0
 #define LIS_MATRIX_CHECK_SIZE      1
 #define LIS_MATRIX_CHECK_NULL      2
@@ -90,6 +94,7 @@ extern "C"
   extern LIS_INT lis_matrix_shift_diagonal_dns(LIS_MATRIX A, LIS_SCALAR shift);
   extern LIS_INT lis_matrix_shift_diagonal_coo(LIS_MATRIX A, LIS_SCALAR shift);
   extern LIS_INT lis_matrix_shift_diagonal_vbr(LIS_MATRIX A, LIS_SCALAR shift);
+  extern LIS_INT lis_matrix_shift_diagonal_sell(LIS_MATRIX A, LIS_SCALAR shift);
 
   /*******************/
   /* Array           */
@@ -221,6 +226,21 @@ extern "C"
   extern LIS_INT lis_matrix_convert_csr2ell(LIS_MATRIX Ain, LIS_MATRIX Aout);
   extern LIS_INT lis_matrix_convert_ell2csr(LIS_MATRIX Ain, LIS_MATRIX Aout);
   /*******************/
+  /* SELL            */
+  /*******************/
+  extern LIS_INT lis_matrix_setDLU_sell(LIS_INT lmaxnzr, LIS_INT umaxnzr, LIS_SCALAR *diag, LIS_INT *lperm, LIS_INT *lptr, LIS_INT *lindex, LIS_SCALAR *lvalue, LIS_INT *uperm, LIS_INT *uptr, LIS_INT *uindex, LIS_SCALAR *uvalue, LIS_MATRIX A);
+  extern LIS_INT lis_matrix_elements_copy_sell(LIS_INT n, LIS_INT *perm, LIS_INT *ptr, LIS_INT *index, LIS_SCALAR *value, LIS_INT *o_perm, LIS_INT *o_ptr, LIS_INT *o_index, LIS_SCALAR *o_value);
+  extern LIS_INT lis_matrix_copy_sell(LIS_MATRIX Ain, LIS_MATRIX Aout);
+  extern LIS_INT lis_matrix_merge_sell(LIS_MATRIX A);
+  extern LIS_INT lis_matrix_split_sell(LIS_MATRIX A);
+  extern LIS_INT lis_matrix_get_diagonal_sell(LIS_MATRIX A, LIS_SCALAR d[]);
+  extern LIS_INT lis_matrix_scaling_sell(LIS_MATRIX A, LIS_SCALAR d[]);
+  extern LIS_INT lis_matrix_scaling_symm_sell(LIS_MATRIX A, LIS_SCALAR d[]);
+  extern LIS_INT lis_matrix_solve_sell(LIS_MATRIX A, LIS_VECTOR B, LIS_VECTOR X, LIS_INT flag);
+  extern LIS_INT lis_matrix_solvet_sell(LIS_MATRIX A, LIS_VECTOR B, LIS_VECTOR X, LIS_INT flag);
+  extern LIS_INT lis_matrix_convert_csr2sell(LIS_MATRIX Ain, LIS_MATRIX Aout);
+  extern LIS_INT lis_matrix_convert_sell2csr(LIS_MATRIX Ain, LIS_MATRIX Aout);
+  /*******************/
   /* JAD             */
   /*******************/
   extern LIS_INT lis_matrix_setDLU_jad(LIS_INT lnnz, LIS_INT unnz, LIS_INT lmaxnzr, LIS_INT umaxnzr, LIS_SCALAR *diag, LIS_INT *lperm, LIS_INT *lptr, LIS_INT *lindex, LIS_SCALAR *lvalue, LIS_INT *uperm, LIS_INT *uptr, LIS_INT *uindex, LIS_SCALAR *uvalue, LIS_MATRIX A);
@@ -112,6 +112,11 @@ extern "C"
   extern void lis_matvec_ell(LIS_MATRIX A, LIS_SCALAR x[], LIS_SCALAR y[]);
   extern void lis_matvect_ell(LIS_MATRIX A, LIS_SCALAR x[], LIS_SCALAR y[]);
   /*******************/
+  /* SELL            */
+  /*******************/
+  extern void lis_matvec_sell(LIS_MATRIX A, LIS_SCALAR x[], LIS_SCALAR y[]);
+  extern void lis_matvect_sell(LIS_MATRIX A, LIS_SCALAR x[], LIS_SCALAR y[]);
+  /*******************/
   /* DIA             */
   /*******************/
   extern void lis_matvec_dia(LIS_MATRIX A, LIS_SCALAR x[], LIS_SCALAR y[]);
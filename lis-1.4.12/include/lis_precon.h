@@ -32,6 +32,9 @@
 #define lis_psolve(solver,b,x)    lis_psolve_xxx[solver->precon->precon_type](solver,b,x)
 #define lis_psolvet(solver,b,x)    lis_psolvet_xxx[solver->precon->precon_type](solver,b,x)
 
+/* ILU factors built over the whole matrix and applied by level sets */
+#define LIS_ILU_LEVELSET(solver)  ((solver)->options[LIS_OPTIONS_ILU_LEVELSET] && (solver)->options[LIS_OPTIONS_PRECISION]==LIS_PRECISION_DOUBLE)
+
 
 
 
@@ -41,9 +44,11 @@ extern "C"
 #endif
   extern LIS_INT lis_precon_init(LIS_PRECON precon);
   extern LIS_INT lis_precon_create(LIS_SOLVER solver, LIS_PRECON *precon);
+  extern LIS_INT lis_precon_reuse(LIS_SOLVER solver, LIS_PRECON *precon);
   extern LIS_INT lis_precon_destroy(LIS_PRECON precon);
 
   extern LIS_PRECON_CREATE_XXX lis_precon_create_xxx[];
+  extern LIS_PRECON_CREATE_XXX lis_precon_refresh_xxx[];
   extern LIS_PSOLVE_XXX lis_psolve_xxx[];
   extern LIS_PSOLVET_XXX lis_psolvet_xxx[];
   /*******************/
@@ -65,11 +70,17 @@ extern "C"
   /* ILU             */
   /*******************/
   extern LIS_INT lis_precon_create_iluk(LIS_SOLVER solver, LIS_PRECON precon);
+  extern LIS_INT lis_precon_refresh_iluk(LIS_SOLVER solver, LIS_PRECON precon);
+  extern LIS_INT lis_numerical_fact_csr(LIS_SOLVER solver, LIS_PRECON precon);
   extern LIS_INT lis_psolve_iluk_csr(LIS_SOLVER solver, LIS_VECTOR B, LIS_VECTOR X);
   extern LIS_INT lis_psolve_iluk_bsr(LIS_SOLVER solver, LIS_VECTOR B, LIS_VECTOR X);
   extern LIS_INT lis_psolve_iluk_vbr(LIS_SOLVER solver, LIS_VECTOR B, LIS_VECTOR X);
   extern LIS_INT lis_psolvet_iluk_csr(LIS_SOLVER solver, LIS_VECTOR B, LIS_VECTOR X);
   extern LIS_INT lis_psolvet_iluk_bsr(LIS_SOLVER solver, LIS_VECTOR B, LIS_VECTOR X);
+  extern LIS_INT lis_precon_create_level(LIS_PRECON precon, LIS_INT ltrans);
+  extern LIS_INT lis_precon_update_level(LIS_PRECON precon);
+  extern LIS_INT lis_matrix_level_destroy(LIS_MATRIX_LEVEL M);
+  extern LIS_INT lis_psolve_level(LIS_SOLVER solver, LIS_VECTOR B, LIS_VECTOR X);
   /*******************/
   /* SSOR            */
   /*******************/
@@ -100,6 +111,7 @@ extern "C"
   /* SAAMG           */
   /*******************/
   extern LIS_INT lis_precon_create_saamg(LIS_SOLVER solver, LIS_PRECON precon);
+  extern LIS_INT lis_precon_refresh_saamg(LIS_SOLVER solver, LIS_PRECON precon);
   extern LIS_INT lis_psolve_saamg(LIS_SOLVER solver, LIS_VECTOR B, LIS_VECTOR X);
   extern LIS_INT lis_psolvet_saamg(LIS_SOLVER solver, LIS_VECTOR B, LIS_VECTOR X);
   /*******************/
@@ -108,6 +120,7 @@ extern "C"
   extern LIS_INT lis_precon_create_iluc(LIS_SOLVER solver, LIS_PRECON precon);
   extern LIS_INT lis_precon_create_iluc_csr(LIS_SOLVER solver, LIS_PRECON precon);
   extern LIS_INT lis_precon_create_iluc_bsr(LIS_SOLVER solver, LIS_PRECON precon);
+  extern LIS_INT lis_precon_refresh_iluc(LIS_SOLVER solver, LIS_PRECON precon);
   extern LIS_INT lis_psolve_iluc(LIS_SOLVER solver, LIS_VECTOR B, LIS_VECTOR X);
   extern LIS_INT lis_psolvet_iluc(LIS_SOLVER solver, LIS_VECTOR B, LIS_VECTOR X);
   extern LIS_INT lis_psolve_iluc_bsr(LIS_SOLVER solver, LIS_VECTOR B, LIS_VECTOR X);
@@ -117,6 +130,7 @@ extern "C"
   extern LIS_INT lis_precon_create_ilut(LIS_SOLVER solver, LIS_PRECON precon);
   extern LIS_INT lis_precon_create_ilut_csr(LIS_SOLVER solver, LIS_PRECON precon);
   extern LIS_INT lis_precon_create_ilut_bsr(LIS_SOLVER solver, LIS_PRECON precon);
+  extern LIS_INT lis_precon_refresh_ilut(LIS_SOLVER solver, LIS_PRECON precon);
   extern LIS_INT lis_psolve_ilut_csr(LIS_SOLVER solver, LIS_VECTOR B, LIS_VECTOR X);
   extern LIS_INT lis_psolve_ilut_bsr(LIS_SOLVER solver, LIS_VECTOR B, LIS_VECTOR X);
   extern LIS_INT lis_psolvet_ilut_csr(LIS_SOLVER solver, LIS_VECTOR B, LIS_VECTOR X);
@@ -224,6 +224,18 @@ extern "C"
   extern LIS_INT lis_minres(LIS_SOLVER solver);
   extern LIS_INT lis_minres_check_params(LIS_SOLVER solver);
   extern LIS_INT lis_minres_malloc_work(LIS_SOLVER solver);
+  /*******************/
+  /* Pipelined CG    */
+  /*******************/
+  extern LIS_INT lis_pcg(LIS_SOLVER solver);
+  extern LIS_INT lis_pcg_check_params(LIS_SOLVER solver);
+  extern LIS_INT lis_pcg_malloc_work(LIS_SOLVER solver);
+  /*******************/
+  /* CA-GMRES(m)     */
+  /*******************/
+  extern LIS_INT lis_cagmres(LIS_SOLVER solver);
+  extern LIS_INT lis_cagmres_check_params(LIS_SOLVER solver);
+  extern LIS_INT lis_cagmres_malloc_work(LIS_SOLVER solver);
 
 #ifdef __cplusplus
 }
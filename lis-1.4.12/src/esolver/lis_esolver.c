@@ -93,7 +93,7 @@ LIS_ESOLVER_MALLOC_WORK lis_esolver_malloc_work[] = {
 #define LIS_ESOLVERS_LEN 8
 #define LIS_EPRINT_LEN 4
 #define LIS_TRUEFALSE_LEN 2
-#define LIS_ESTORAGE_LEN  11
+#define LIS_ESTORAGE_LEN  12
 #define LIS_PRECISION_LEN 3
 
 char *LIS_ESOLVER_OPTNAME[] = {
@@ -111,12 +111,12 @@ LIS_EOPTIONS_STORAGE_BLOCK, LIS_EOPTIONS_PRECISION
 char *lis_esolver_atoi[] = {"pi", "ii", "aii", "rqi", "si", "li", "cg", "cr"};
 char *lis_eprint_atoi[] = {"none", "mem", "out", "all"};
 char *lis_etruefalse_atoi[] = {"false", "true"};
-char *lis_estorage_atoi[] = {"csr", "csc", "msr", "dia", "ell", "jad", "bsr", "bsc", "vbr", "coo", "dns"};
+char *lis_estorage_atoi[] = {"csr", "csc", "msr", "dia", "ell", "jad", "bsr", "bsc", "vbr", "coo", "dns", "sell"};
 char *lis_eprecision_atoi[] = {"double", "quad", "switch"};
 
 char *lis_esolvername[] = {"", "Power", "Inverse", "Approximate Inverse", "Rayleigh Quotient", "Subspace", "Lanczos", "CG", "CR"};
 
-char *lis_estoragename[]   = {"CSR", "CSC", "MSR", "DIA", "ELL", "JAD", "BSR", "BSC", "VBR", "COO", "DNS"};
+char *lis_estoragename[]   = {"CSR", "CSC", "MSR", "DIA", "ELL", "JAD", "BSR", "BSC", "VBR", "COO", "DNS", "TJAD", "BJAD", "BCR", "CJAD", "PCSR", "LCSR", "LJAD", "LBSR", "CDIA", "MSC", "SELL"};
 
 char *lis_ereturncode[] = {"LIS_SUCCESS", "LIS_ILL_OPTION", "LIS_BREAKDOWN", "LIS_OUT_OF_MEMORY", "LIS_MAXITER", "LIS_NOT_IMPLEMENTED", "LIS_ERR_FILE_IO"};
 
@@ -877,7 +877,7 @@ LIS_INT lis_esolver_set_option_storage(char *argv, LIS_ESOLVER esolver)
     {
       if( strcmp(argv,lis_estorage_atoi[i])==0 )
       {
-        esolver->options[LIS_EOPTIONS_STORAGE] = i+1;
+        esolver->options[LIS_EOPTIONS_STORAGE] = i<LIS_MATRIX_DNS ? i+1 : LIS_MATRIX_SELL;
         break;
       }
     }
@@ -787,9 +787,9 @@ LIS_INT lis_matrix_set_type(LIS_MATRIX A, LIS_INT matrix_type)
 
   err = lis_matrix_check(A,LIS_MATRIX_CHECK_NOT_ASSEMBLED);
   if( err ) return err;
-  if( matrix_type < LIS_MATRIX_CSR || matrix_type > LIS_MATRIX_DNS )
+  if( (matrix_type < LIS_MATRIX_CSR || matrix_type > LIS_MATRIX_DNS) && matrix_type != LIS_MATRIX_SELL )
   {
-    LIS_SETERR2(LIS_ERR_ILL_ARG,"matrix_type is %d (Set between 1 to %d)\n", matrix_type, LIS_MATRIX_DNS);
+    LIS_SETERR3(LIS_ERR_ILL_ARG,"matrix_type is %d (Set between 1 to %d, or %d)\n", matrix_type, LIS_MATRIX_DNS, LIS_MATRIX_SELL);
     return LIS_ERR_ILL_ARG;
   }
 
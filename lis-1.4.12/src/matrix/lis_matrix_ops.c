@@ -226,6 +226,11 @@ LIS_INT lis_matrix_convert(LIS_MATRIX Ain, LIS_MATRIX Aout)
       if( err ) return err;
       err = lis_matrix_convert_ell2csr(Ain,Atmp);
       break;
+    case LIS_MATRIX_SELL:
+      err = lis_matrix_duplicate(Ain,&Atmp);
+      if( err ) return err;
+      err = lis_matrix_convert_sell2csr(Ain,Atmp);
+      break;
     case LIS_MATRIX_JAD:
       err = lis_matrix_duplicate(Ain,&Atmp);
       if( err ) return err;
@@ -297,6 +302,9 @@ LIS_INT lis_matrix_convert(LIS_MATRIX Ain, LIS_MATRIX Aout)
   case LIS_MATRIX_ELL:
     err = lis_matrix_convert_csr2ell(Atmp,Aout);
     break;
+  case LIS_MATRIX_SELL:
+    err = lis_matrix_convert_csr2sell(Atmp,Aout);
+    break;
   case LIS_MATRIX_DIA:
     err = lis_matrix_convert_csr2dia(Atmp,Aout);
     break;
@@ -412,6 +420,9 @@ LIS_INT lis_matrix_get_diagonal(LIS_MATRIX A, LIS_VECTOR D)
   case LIS_MATRIX_ELL:
     lis_matrix_get_diagonal_ell(A, d);
     break;
+  case LIS_MATRIX_SELL:
+    lis_matrix_get_diagonal_sell(A, d);
+    break;
   case LIS_MATRIX_JAD:
     lis_matrix_get_diagonal_jad(A, d);
     break;
@@ -492,6 +503,9 @@ LIS_INT lis_matrix_scaling(LIS_MATRIX A, LIS_VECTOR B, LIS_VECTOR D, LIS_INT act
     case LIS_MATRIX_ELL:
       lis_matrix_scaling_symm_ell(A, d);
       break;
+    case LIS_MATRIX_SELL:
+      lis_matrix_scaling_symm_sell(A, d);
+      break;
     case LIS_MATRIX_JAD:
       lis_matrix_scaling_symm_jad(A, d);
       break;
@@ -542,6 +556,9 @@ LIS_INT lis_matrix_scaling(LIS_MATRIX A, LIS_VECTOR B, LIS_VECTOR D, LIS_INT act
     case LIS_MATRIX_ELL:
       lis_matrix_scaling_ell(A, d);
       break;
+    case LIS_MATRIX_SELL:
+      lis_matrix_scaling_sell(A, d);
+      break;
     case LIS_MATRIX_JAD:
       lis_matrix_scaling_jad(A, d);
       break;
@@ -609,6 +626,9 @@ LIS_INT lis_matrix_split(LIS_MATRIX A)
   case LIS_MATRIX_ELL:
     err = lis_matrix_split_ell(A);
     break;
+  case LIS_MATRIX_SELL:
+    err = lis_matrix_split_sell(A);
+    break;
   case LIS_MATRIX_DIA:
     err = lis_matrix_split_dia(A);
     break;
@@ -676,6 +696,9 @@ LIS_INT lis_matrix_merge(LIS_MATRIX A)
   case LIS_MATRIX_ELL:
     err = lis_matrix_merge_ell(A);
     break;
+  case LIS_MATRIX_SELL:
+    err = lis_matrix_merge_sell(A);
+    break;
   case LIS_MATRIX_JAD:
     err = lis_matrix_merge_jad(A);
     break;
@@ -742,6 +765,9 @@ LIS_INT lis_matrix_copy(LIS_MATRIX Ain, LIS_MATRIX Aout)
   case LIS_MATRIX_ELL:
     err = lis_matrix_copy_ell(Ain,Aout);
     break;
+  case LIS_MATRIX_SELL:
+    err = lis_matrix_copy_sell(Ain,Aout);
+    break;
   case LIS_MATRIX_JAD:
     err = lis_matrix_copy_jad(Ain,Aout);
     break;
@@ -798,6 +824,9 @@ LIS_INT lis_matrix_copyDLU(LIS_MATRIX Ain, LIS_MATRIX_DIAG *D, LIS_MATRIX *L, LI
   case LIS_MATRIX_ELL:
     err = lis_matrix_copy_ell(Ain,Aout);
     break;
+  case LIS_MATRIX_SELL:
+    err = lis_matrix_copy_sell(Ain,Aout);
+    break;
   case LIS_MATRIX_JAD:
     err = lis_matrix_copy_jad(Ain,Aout);
     break;
@@ -854,6 +883,9 @@ LIS_INT lis_matrix_solve(LIS_MATRIX A, LIS_VECTOR b, LIS_VECTOR x, LIS_INT flag)
   case LIS_MATRIX_ELL:
     lis_matrix_solve_ell(A,b,x,flag);
     break;
+  case LIS_MATRIX_SELL:
+    lis_matrix_solve_sell(A,b,x,flag);
+    break;
   case LIS_MATRIX_JAD:
     lis_matrix_solve_jad(A,b,x,flag);
     break;
@@ -904,6 +936,9 @@ LIS_INT lis_matrix_solvet(LIS_MATRIX A, LIS_VECTOR b, LIS_VECTOR x, LIS_INT flag
   case LIS_MATRIX_ELL:
     lis_matrix_solvet_ell(A,b,x,flag);
     break;
+  case LIS_MATRIX_SELL:
+    lis_matrix_solvet_sell(A,b,x,flag);
+    break;
   case LIS_MATRIX_JAD:
     lis_matrix_solvet_jad(A,b,x,flag);
     break;
@@ -1819,6 +1854,9 @@ LIS_INT lis_matrix_shift_diagonal(LIS_MATRIX A, LIS_SCALAR shift)
   case LIS_MATRIX_ELL:
     lis_matrix_shift_diagonal_ell(A, shift);
     break;
+  case LIS_MATRIX_SELL:
+    lis_matrix_shift_diagonal_sell(A, shift);
+    break;
   case LIS_MATRIX_JAD:
     lis_matrix_shift_diagonal_jad(A, shift);
     break;
@@ -2390,3 +2428,45 @@ LIS_INT lis_matrix_shift_diagonal_vbr(LIS_MATRIX A, LIS_SCALAR shift)
   return LIS_SUCCESS;
 }
 
+#undef __FUNC__
+#define __FUNC__ "lis_matrix_shift_diagonal_sell"
+LIS_INT lis_matrix_shift_diagonal_sell(LIS_MATRIX A, LIS_SCALAR shift)
+{
+  LIS_INT i,j,je,p;
+  LIS_INT n;
+
+  LIS_DEBUG_FUNC_IN;
+
+  n    = A->n;
+  if( A->is_splited )
+  {
+    #ifdef _OPENMP
+    #pragma omp parallel for private(i)
+    #endif
+    for(i=0; i<n; i++)
+    {
+      A->D->value[i] += shift;
+    }
+  }
+  else
+  {
+    #ifdef _OPENMP
+    #pragma omp parallel for private(i,j,je,p)
+    #endif
+    for(i=0; i<n; i++)
+    {
+      p  = A->col[i];
+      je = A->ptr[p/LIS_MATRIX_SELL_C+1];
+      for(j=A->ptr[p/LIS_MATRIX_SELL_C]+p%LIS_MATRIX_SELL_C;j<je;j+=LIS_MATRIX_SELL_C)
+      {
+        if( i==A->index[j] )
+        {
+          A->value[j] += shift;
+          break;
+        }
+      }
+    }
+  }
+  LIS_DEBUG_FUNC_OUT;
+  return LIS_SUCCESS;
+}
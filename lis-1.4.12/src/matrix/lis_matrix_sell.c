@@ -0,0 +1,1261 @@
+/* Copyright (C) The Scalable Software Infrastructure Project. All rights reserved.
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+   1. Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+   3. Neither the name of the project nor the names of its contributors 
+      may be used to endorse or promote products derived from this software 
+      without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE SCALABLE SOFTWARE INFRASTRUCTURE PROJECT
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+   TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+   PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE SCALABLE SOFTWARE INFRASTRUCTURE
+   PROJECT BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+   OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifdef HAVE_CONFIG_H
+  #include "lis_config.h"
+#else
+#ifdef HAVE_CONFIG_WIN_H
+  #include "lis_config_win.h"
+#endif
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#ifdef HAVE_MALLOC_H
+        #include <malloc.h>
+#endif
+#include <string.h>
+#include <stdarg.h>
+#include <math.h>
+#ifdef _OPENMP
+  #include <omp.h>
+#endif
+#ifdef USE_MPI
+  #include <mpi.h>
+#endif
+#include "lislib.h"
+
+/************************************************
+ * function                    | SOM |
+ *-----------------------------+-----+
+ * lis_matrix_set              | o   |
+ * lis_matrix_setDLU           | o   |
+ * lis_matrix_malloc           | o   |
+ * lis_matrix_elements_copy    | o   |
+ * lis_matrix_transpose        | xxx |
+ * lis_matrix_split            | o   |
+ * lis_matrix_merge            | o   |
+ *-----------------------------+-----+-----+
+ * function                    |merge|split|
+ *-----------------------------+-----+-----|
+ * lis_matrix_convert          | o   |     |
+ * lis_matrix_copy             | o   | o   |
+ * lis_matrix_get_diagonal     | o   | o   |
+ * lis_matrix_scaling          | o   | o   |
+ * lis_matrix_scaling_symm     | o   | o   |
+ * lis_matrix_normf            | xxx | xxx |
+ * lis_matrix_sort             | xxx | xxx |
+ * lis_matrix_solve            | xxx | o   |
+ * lis_matrix_solvet           | xxx | o   |
+ ************************************************/
+
+/*
+ * SELL-C-sigma stores the rows in slices of LIS_MATRIX_SELL_C rows. Within
+ * each window of LIS_MATRIX_SELL_SIGMA rows the rows are sorted by length,
+ * so that the rows of a slice have similar lengths. perm[p] is the row
+ * stored at position p and col[i] is the position of row i. Slice s holds
+ * ptr[s+1]-ptr[s] entries stored column by column, i.e. the k-th entry of
+ * position p is at ptr[p/C] + k*C + p%C. Short rows are padded with zeros
+ * whose column index is the row itself.
+ */
+
+#undef __FUNC__
+#define __FUNC__ "lis_matrix_create_sell"
+static LIS_INT lis_matrix_create_sell(LIS_INT n, LIS_INT maxnzr, LIS_INT *len, LIS_INT **perm, LIS_INT **ptr, LIS_INT **index, LIS_SCALAR **value)
+{
+  LIS_INT      i,j,k,p,s,is,ie,nw,nslice,nnz;
+
+  LIS_DEBUG_FUNC_IN;
+
+  nslice  = (n+LIS_MATRIX_SELL_C-1)/LIS_MATRIX_SELL_C;
+  nw      = (n+LIS_MATRIX_SELL_SIGMA-1)/LIS_MATRIX_SELL_SIGMA;
+  *perm   = NULL;
+  *ptr    = NULL;
+  *index  = NULL;
+  *value  = NULL;
+
+  *perm = (LIS_INT *)lis_malloc( n*sizeof(LIS_INT),"lis_matrix_create_sell::perm" );
+  if( *perm==NULL )
+  {
+    LIS_SETERR_MEM(n*sizeof(LIS_INT));
+    return LIS_OUT_OF_MEMORY;
+  }
+  *ptr = (LIS_INT *)lis_malloc( (nslice+1)*sizeof(LIS_INT),"lis_matrix_create_sell::ptr" );
+  if( *ptr==NULL )
+  {
+    LIS_SETERR_MEM((nslice+1)*sizeof(LIS_INT));
+    lis_free2(2,*perm,*ptr);
+    return LIS_OUT_OF_MEMORY;
+  }
+
+  /* sort rows by length within each sigma window */
+  #ifdef _OPENMP
+  #pragma omp parallel for private(i,is,ie)
+  #endif
+  for(i=0;i<nw;i++)
+  {
+    is = i*LIS_MATRIX_SELL_SIGMA;
+    ie = is + LIS_MATRIX_SELL_SIGMA;
+    if( ie>n ) ie = n;
+    lis_sort_jad(is,ie,maxnzr,len,*perm);
+  }
+
+  /* the first row of a slice is its longest */
+  (*ptr)[0] = 0;
+  for(s=0;s<nslice;s++)
+  {
+    (*ptr)[s+1] = (*ptr)[s] + len[s*LIS_MATRIX_SELL_C]*LIS_MATRIX_SELL_C;
+  }
+  nnz = (*ptr)[nslice];
+
+  *index = (LIS_INT *)lis_malloc( nnz*sizeof(LIS_INT),"lis_matrix_create_sell::index" );
+  if( *index==NULL )
+  {
+    LIS_SETERR_MEM(nnz*sizeof(LIS_INT));
+    lis_free2(4,*perm,*ptr,*index,*value);
+    return LIS_OUT_OF_MEMORY;
+  }
+  *value = (LIS_SCALAR *)lis_malloc( nnz*sizeof(LIS_SCALAR),"lis_matrix_create_sell::value" );
+  if( *value==NULL )
+  {
+    LIS_SETERR_MEM(nnz*sizeof(LIS_SCALAR));
+    lis_free2(4,*perm,*ptr,*index,*value);
+    return LIS_OUT_OF_MEMORY;
+  }
+
+  #ifdef _OPENMP
+  #pragma omp parallel for private(s,j,k,p)
+  #endif
+  for(s=0;s<nslice;s++)
+  {
+    for(j=(*ptr)[s];j<(*ptr)[s+1];j+=LIS_MATRIX_SELL_C)
+    {
+      for(k=0;k<LIS_MATRIX_SELL_C;k++)
+      {
+        p = s*LIS_MATRIX_SELL_C + k;
+        (*index)[j+k] = p<n ? (*perm)[p] : 0;
+        (*value)[j+k] = (LIS_SCALAR)0.0;
+      }
+    }
+  }
+
+  LIS_DEBUG_FUNC_OUT;
+  return LIS_SUCCESS;
+}
+
+#undef __FUNC__
+#define __FUNC__ "lis_matrix_set_sell"
+LIS_INT lis_matrix_set_sell(LIS_INT maxnzr, LIS_INT *perm, LIS_INT *ptr, LIS_INT *index, LIS_SCALAR *value, LIS_MATRIX A)
+{
+  LIS_INT i,n;
+  LIS_INT *col;
+  LIS_INT err;
+
+  LIS_DEBUG_FUNC_IN;
+
+#if 0
+  err = lis_matrix_check(A,LIS_MATRIX_CHECK_SET);
+  if( err ) return err;
+#else
+  if(lis_matrix_is_assembled(A))  return LIS_SUCCESS;
+  else {
+    err = lis_matrix_check(A,LIS_MATRIX_CHECK_SET);
+    if( err ) return err;
+  }
+#endif
+
+  n = A->n;
+  col = (LIS_INT *)lis_malloc(n*sizeof(LIS_INT),"lis_matrix_set_sell::col");
+  if( col==NULL )
+  {
+    LIS_SETERR_MEM(n*sizeof(LIS_INT));
+    return LIS_OUT_OF_MEMORY;
+  }
+
+  for(i=0;i<n;i++)
+  {
+    col[perm[i]] = i;
+  }
+
+  A->col         = col;
+  A->row         = perm;
+  A->ptr         = ptr;
+  A->index       = index;
+  A->value       = value;
+  A->is_copy     = LIS_FALSE;
+  A->status      = -LIS_MATRIX_SELL;
+  A->maxnzr      = maxnzr;
+
+  LIS_DEBUG_FUNC_OUT;
+  return LIS_SUCCESS;
+}
+
+#undef __FUNC__
+#define __FUNC__ "lis_matrix_setDLU_sell"
+LIS_INT lis_matrix_setDLU_sell(LIS_INT lmaxnzr, LIS_INT umaxnzr, LIS_SCALAR *diag, LIS_INT *lperm, LIS_INT *lptr, LIS_INT *lindex, LIS_SCALAR *lvalue,
+              LIS_INT *uperm, LIS_INT *uptr, LIS_INT *uindex, LIS_SCALAR *uvalue, LIS_MATRIX A)
+{
+  LIS_INT        n,i,err;
+  LIS_INT        *lcol,*ucol;
+  LIS_MATRIX_DIAG  D;
+
+  LIS_DEBUG_FUNC_IN;
+
+  n = A->n;
+
+#if 0
+  err = lis_matrix_check(A,LIS_MATRIX_CHECK_SET);
+  if( err ) return err;
+#else
+  if(lis_matrix_is_assembled(A))  return LIS_SUCCESS;
+  else {
+    err = lis_matrix_check(A,LIS_MATRIX_CHECK_SET);
+    if( err ) return err;
+  }
+#endif
+
+  A->L = (LIS_MATRIX_CORE)lis_calloc(sizeof(struct LIS_MATRIX_CORE_STRUCT),"lis_matrix_setDLU_sell::A->L");
+  if( A->L==NULL )
+  {
+    LIS_SETERR_MEM(sizeof(struct LIS_MATRIX_CORE_STRUCT));
+    return LIS_OUT_OF_MEMORY;
+  }
+  A->U = (LIS_MATRIX_CORE)lis_calloc(sizeof(struct LIS_MATRIX_CORE_STRUCT),"lis_matrix_setDLU_sell::A->U");
+  if( A->U==NULL )
+  {
+    LIS_SETERR_MEM(sizeof(struct LIS_MATRIX_CORE_STRUCT));
+    lis_matrix_DLU_destroy(A);
+    return LIS_OUT_OF_MEMORY;
+  }
+  err = lis_matrix_diag_create(A->n,0,A->comm,&D);
+  if( err )
+  {
+    lis_matrix_DLU_destroy(A);
+    return err;
+  }
+  lcol = (LIS_INT *)lis_malloc(n*sizeof(LIS_INT),"lis_matrix_setDLU_sell::lcol");
+  if( lcol==NULL )
+  {
+    LIS_SETERR_MEM(n*sizeof(LIS_INT));
+    lis_matrix_DLU_destroy(A);
+    return LIS_OUT_OF_MEMORY;
+  }
+  ucol = (LIS_INT *)lis_malloc(n*sizeof(LIS_INT),"lis_matrix_setDLU_sell::ucol");
+  if( ucol==NULL )
+  {
+    LIS_SETERR_MEM(n*sizeof(LIS_INT));
+    lis_matrix_DLU_destroy(A);
+    lis_free(lcol);
+    return LIS_OUT_OF_MEMORY;
+  }
+
+  for(i=0;i<n;i++)
+  {
+    lcol[lperm[i]] = i;
+    ucol[uperm[i]] = i;
+  }
+
+  lis_free(D->value);
+  D->value       = diag;
+  A->D           = D;
+  A->L->maxnzr   = lmaxnzr;
+  A->L->col      = lcol;
+  A->L->row      = lperm;
+  A->L->ptr      = lptr;
+  A->L->index    = lindex;
+  A->L->value    = lvalue;
+  A->U->maxnzr   = umaxnzr;
+  A->U->col      = ucol;
+  A->U->row      = uperm;
+  A->U->ptr      = uptr;
+  A->U->index    = uindex;
+  A->U->value    = uvalue;
+  A->is_copy     = LIS_FALSE;
+  A->status      = -LIS_MATRIX_SELL;
+  A->is_splited  = LIS_TRUE;
+
+  LIS_DEBUG_FUNC_OUT;
+  return LIS_SUCCESS;
+}
+
+#undef __FUNC__
+#define __FUNC__ "lis_matrix_malloc_sell"
+LIS_INT lis_matrix_malloc_sell(LIS_INT n, LIS_INT len, LIS_INT **perm, LIS_INT **ptr, LIS_INT **index, LIS_SCALAR **value)
+{
+  LIS_INT nslice;
+
+  LIS_DEBUG_FUNC_IN;
+
+  nslice  = (n+LIS_MATRIX_SELL_C-1)/LIS_MATRIX_SELL_C;
+  *perm   = NULL;
+  *ptr    = NULL;
+  *index  = NULL;
+  *value  = NULL;
+
+  *perm = (LIS_INT *)lis_malloc( n*sizeof(LIS_INT),"lis_matrix_malloc_sell::perm" );
+  if( *perm==NULL )
+  {
+    LIS_SETERR_MEM(n*sizeof(LIS_INT));
+    lis_free2(4,*perm,*ptr,*index,*value);
+    return LIS_OUT_OF_MEMORY;
+  }
+  *ptr = (LIS_INT *)lis_malloc( (nslice+1)*sizeof(LIS_INT),"lis_matrix_malloc_sell::ptr" );
+  if( *ptr==NULL )
+  {
+    LIS_SETERR_MEM((nslice+1)*sizeof(LIS_INT));
+    lis_free2(4,*perm,*ptr,*index,*value);
+    return LIS_OUT_OF_MEMORY;
+  }
+  *index = (LIS_INT *)lis_malloc( len*sizeof(LIS_INT),"lis_matrix_malloc_sell::index" );
+  if( *index==NULL )
+  {
+    LIS_SETERR_MEM(len*sizeof(LIS_INT));
+    lis_free2(4,*perm,*ptr,*index,*value);
+    return LIS_OUT_OF_MEMORY;
+  }
+  *value = (LIS_SCALAR *)lis_malloc( len*sizeof(LIS_SCALAR),"lis_matrix_malloc_sell::value" );
+  if( *value==NULL )
+  {
+    LIS_SETERR_MEM(len*sizeof(LIS_SCALAR));
+    lis_free2(4,*perm,*ptr,*index,*value);
+    return LIS_OUT_OF_MEMORY;
+  }
+  LIS_DEBUG_FUNC_OUT;
+  return LIS_SUCCESS;
+}
+
+#undef __FUNC__
+#define __FUNC__ "lis_matrix_elements_copy_sell"
+LIS_INT lis_matrix_elements_copy_sell(LIS_INT n, LIS_INT *perm, LIS_INT *ptr, LIS_INT *index, LIS_SCALAR *value,
+                 LIS_INT *o_perm, LIS_INT *o_ptr, LIS_INT *o_index, LIS_SCALAR *o_value)
+{
+  LIS_INT      i,j,nslice;
+
+  LIS_DEBUG_FUNC_IN;
+
+  nslice = (n+LIS_MATRIX_SELL_C-1)/LIS_MATRIX_SELL_C;
+
+  #ifdef _OPENMP
+  #pragma omp parallel private(i,j)
+  #endif
+  {
+    #ifdef _OPENMP
+    #pragma omp for
+    #endif
+    for(i=0;i<n;i++)
+    {
+      o_perm[i] = perm[i];
+    }
+    #ifdef _OPENMP
+    #pragma omp for
+    #endif
+    for(i=0;i<nslice+1;i++)
+    {
+      o_ptr[i] = ptr[i];
+    }
+    #ifdef _OPENMP
+    #pragma omp for
+    #endif
+    for(i=0;i<nslice;i++)
+    {
+      for(j=ptr[i];j<ptr[i+1];j++)
+      {
+        o_value[j] = value[j];
+        o_index[j] = index[j];
+      }
+    }
+  }
+
+  LIS_DEBUG_FUNC_OUT;
+  return LIS_SUCCESS;
+}
+
+#undef __FUNC__
+#define __FUNC__ "lis_matrix_copy_sell"
+LIS_INT lis_matrix_copy_sell(LIS_MATRIX Ain, LIS_MATRIX Aout)
+{
+  LIS_INT      err;
+  LIS_INT      i,n,nslice,maxnzr,lmaxnzr,umaxnzr;
+  LIS_INT      *perm,*ptr,*index;
+  LIS_INT      *lperm,*lptr,*lindex;
+  LIS_INT      *uperm,*uptr,*uindex;
+  LIS_SCALAR  *value,*lvalue,*uvalue,*diag;
+
+  LIS_DEBUG_FUNC_IN;
+
+  n       = Ain->n;
+  nslice  = (n+LIS_MATRIX_SELL_C-1)/LIS_MATRIX_SELL_C;
+
+  if( Ain->is_splited )
+  {
+    lmaxnzr  = Ain->L->maxnzr;
+    umaxnzr  = Ain->U->maxnzr;
+    lperm    = NULL;
+    lptr     = NULL;
+    lindex   = NULL;
+    lvalue   = NULL;
+    uperm    = NULL;
+    uptr     = NULL;
+    uindex   = NULL;
+    uvalue   = NULL;
+    diag     = NULL;
+
+    err = lis_matrix_malloc_sell(n,Ain->L->ptr[nslice],&lperm,&lptr,&lindex,&lvalue);
+    if( err )
+    {
+      return err;
+    }
+    err = lis_matrix_malloc_sell(n,Ain->U->ptr[nslice],&uperm,&uptr,&uindex,&uvalue);
+    if( err )
+    {
+      lis_free2(4,lperm,lptr,lindex,lvalue);
+      return err;
+    }
+    diag = (LIS_SCALAR *)lis_malloc(n*sizeof(LIS_SCALAR),"lis_matrix_copy_sell::diag");
+    if( diag==NULL )
+    {
+      LIS_SETERR_MEM(n*sizeof(LIS_SCALAR));
+      lis_free2(8,lperm,lptr,lindex,lvalue,uperm,uptr,uindex,uvalue);
+      return LIS_OUT_OF_MEMORY;
+    }
+
+    #ifdef _OPENMP
+    #pragma omp parallel for private(i)
+    #endif
+    for(i=0;i<n;i++)
+    {
+      diag[i] = Ain->D->value[i];
+    }
+    lis_matrix_elements_copy_sell(n,Ain->L->row,Ain->L->ptr,Ain->L->index,Ain->L->value,lperm,lptr,lindex,lvalue);
+    lis_matrix_elements_copy_sell(n,Ain->U->row,Ain->U->ptr,Ain->U->index,Ain->U->value,uperm,uptr,uindex,uvalue);
+
+    err = lis_matrix_setDLU_sell(lmaxnzr,umaxnzr,diag,lperm,lptr,lindex,lvalue,uperm,uptr,uindex,uvalue,Aout);
+    if( err )
+    {
+      lis_free2(9,diag,lperm,lptr,lindex,lvalue,uperm,uptr,uindex,uvalue);
+      return err;
+    }
+  }
+  if( !Ain->is_splited || (Ain->is_splited && Ain->is_save) )
+  {
+    perm    = NULL;
+    ptr     = NULL;
+    index   = NULL;
+    value   = NULL;
+    maxnzr  = Ain->maxnzr;
+
+    err = lis_matrix_malloc_sell(n,Ain->ptr[nslice],&perm,&ptr,&index,&value);
+    if( err )
+    {
+      return err;
+    }
+
+    lis_matrix_elements_copy_sell(n,Ain->row,Ain->ptr,Ain->index,Ain->value,perm,ptr,index,value);
+
+    err = lis_matrix_set_sell(maxnzr,perm,ptr,index,value,Aout);
+    if( err )
+    {
+      lis_free2(4,perm,ptr,index,value);
+      return err;
+    }
+  }
+
+  err = lis_matrix_assemble(Aout);
+  if( err )
+  {
+    lis_matrix_storage_destroy(Aout);
+    return err;
+  }
+  LIS_DEBUG_FUNC_OUT;
+  return LIS_SUCCESS;
+}
+
+#undef __FUNC__
+#define __FUNC__ "lis_matrix_split_sell"
+LIS_INT lis_matrix_split_sell(LIS_MATRIX A)
+{
+  LIS_INT        i,j,k,p,w,n;
+  LIS_INT        lmaxnzr,umaxnzr,lcount,ucount;
+  LIS_INT        err;
+  LIS_INT        *liw,*uiw;
+  LIS_INT        *lperm,*lptr,*lindex,*lcol;
+  LIS_INT        *uperm,*uptr,*uindex,*ucol;
+  LIS_SCALAR    *lvalue,*uvalue;
+  LIS_MATRIX_DIAG  D;
+
+  LIS_DEBUG_FUNC_IN;
+
+  n        = A->n;
+  lmaxnzr  = 0;
+  umaxnzr  = 0;
+  D        = NULL;
+  liw      = NULL;
+  uiw      = NULL;
+  lperm    = NULL;
+  lptr     = NULL;
+  lindex   = NULL;
+  lvalue   = NULL;
+  lcol     = NULL;
+  uperm    = NULL;
+  uptr     = NULL;
+  uindex   = NULL;
+  uvalue   = NULL;
+  ucol     = NULL;
+
+  liw = (LIS_INT *)lis_malloc(n*sizeof(LIS_INT),"lis_matrix_split_sell::liw");
+  if( liw==NULL )
+  {
+    LIS_SETERR_MEM(n*sizeof(LIS_INT));
+    return LIS_OUT_OF_MEMORY;
+  }
+  uiw = (LIS_INT *)lis_malloc(n*sizeof(LIS_INT),"lis_matrix_split_sell::uiw");
+  if( uiw==NULL )
+  {
+    LIS_SETERR_MEM(n*sizeof(LIS_INT));
+    lis_free(liw);
+    return LIS_OUT_OF_MEMORY;
+  }
+  lcol = (LIS_INT *)lis_malloc(n*sizeof(LIS_INT),"lis_matrix_split_sell::lcol");
+  if( lcol==NULL )
+  {
+    LIS_SETERR_MEM(n*sizeof(LIS_INT));
+    lis_free2(2,liw,uiw);
+    return LIS_OUT_OF_MEMORY;
+  }
+  ucol = (LIS_INT *)lis_malloc(n*sizeof(LIS_INT),"lis_matrix_split_sell::ucol");
+  if( ucol==NULL )
+  {
+    LIS_SETERR_MEM(n*sizeof(LIS_INT));
+    lis_free2(3,liw,uiw,lcol);
+    return LIS_OUT_OF_MEMORY;
+  }
+
+  #ifdef _OPENMP
+  #pragma omp parallel for private(i,j,k,p,w,lcount,ucount)
+  #endif
+  for(i=0;i<n;i++)
+  {
+    p = A->col[i];
+    j = A->ptr[p/LIS_MATRIX_SELL_C] + p%LIS_MATRIX_SELL_C;
+    w = (A->ptr[p/LIS_MATRIX_SELL_C+1] - A->ptr[p/LIS_MATRIX_SELL_C])/LIS_MATRIX_SELL_C;
+    lcount = 0;
+    ucount = 0;
+    for(k=0;k<w;k++)
+    {
+      if( A->index[j+k*LIS_MATRIX_SELL_C]<i )
+      {
+        lcount++;
+      }
+      else if( A->index[j+k*LIS_MATRIX_SELL_C]>i )
+      {
+        ucount++;
+      }
+    }
+    liw[i] = lcount;
+    uiw[i] = ucount;
+  }
+  for(i=0;i<n;i++)
+  {
+    if( liw[i]>lmaxnzr ) lmaxnzr = liw[i];
+    if( uiw[i]>umaxnzr ) umaxnzr = uiw[i];
+  }
+
+  err = lis_matrix_LU_create(A);
+  if( err )
+  {
+    lis_free2(4,liw,uiw,lcol,ucol);
+    return err;
+  }
+  err = lis_matrix_create_sell(n,lmaxnzr,liw,&lperm,&lptr,&lindex,&lvalue);
+  if( err )
+  {
+    lis_free2(4,liw,uiw,lcol,ucol);
+    return err;
+  }
+  err = lis_matrix_create_sell(n,umaxnzr,uiw,&uperm,&uptr,&uindex,&uvalue);
+  if( err )
+  {
+    lis_free2(8,liw,uiw,lcol,ucol,lperm,lptr,lindex,lvalue);
+    return err;
+  }
+  err = lis_matrix_diag_duplicateM(A,&D);
+  if( err )
+  {
+    lis_free2(12,liw,uiw,lcol,ucol,lperm,lptr,lindex,lvalue,uperm,uptr,uindex,uvalue);
+    return err;
+  }
+  lis_free2(2,liw,uiw);
+
+  #ifdef _OPENMP
+  #pragma omp parallel for private(i)
+  #endif
+  for(i=0;i<n;i++)
+  {
+    lcol[lperm[i]] = i;
+    ucol[uperm[i]] = i;
+  }
+
+  #ifdef _OPENMP
+  #pragma omp parallel for private(i,j,k,p,w,lcount,ucount)
+  #endif
+  for(i=0;i<n;i++)
+  {
+    p = A->col[i];
+    j = A->ptr[p/LIS_MATRIX_SELL_C] + p%LIS_MATRIX_SELL_C;
+    w = (A->ptr[p/LIS_MATRIX_SELL_C+1] - A->ptr[p/LIS_MATRIX_SELL_C])/LIS_MATRIX_SELL_C;
+    p = lcol[i];
+    lcount = lptr[p/LIS_MATRIX_SELL_C] + p%LIS_MATRIX_SELL_C;
+    p = ucol[i];
+    ucount = uptr[p/LIS_MATRIX_SELL_C] + p%LIS_MATRIX_SELL_C;
+    D->value[i] = 0.0;
+    for(k=0;k<w;k++,j+=LIS_MATRIX_SELL_C)
+    {
+      if( A->index[j]<i )
+      {
+        lindex[lcount] = A->index[j];
+        lvalue[lcount] = A->value[j];
+        lcount += LIS_MATRIX_SELL_C;
+      }
+      else if( A->index[j]>i )
+      {
+        uindex[ucount] = A->index[j];
+        uvalue[ucount] = A->value[j];
+        ucount += LIS_MATRIX_SELL_C;
+      }
+      else
+      {
+        if( A->value[j]!=0.0 ) D->value[i] = A->value[j];
+      }
+    }
+  }
+  A->L->maxnzr  = lmaxnzr;
+  A->L->row     = lperm;
+  A->L->col     = lcol;
+  A->L->ptr     = lptr;
+  A->L->index   = lindex;
+  A->L->value   = lvalue;
+  A->U->maxnzr  = umaxnzr;
+  A->U->row     = uperm;
+  A->U->col     = ucol;
+  A->U->ptr     = uptr;
+  A->U->index   = uindex;
+  A->U->value   = uvalue;
+  A->D          = D;
+  A->is_splited = LIS_TRUE;
+
+  LIS_DEBUG_FUNC_OUT;
+  return LIS_SUCCESS;
+}
+
+#undef __FUNC__
+#define __FUNC__ "lis_matrix_merge_sell"
+LIS_INT lis_matrix_merge_sell(LIS_MATRIX A)
+{
+  LIS_INT        i,j,k,p,w,n;
+  LIS_INT        maxnzr,count;
+  LIS_INT        err;
+  LIS_INT        *iw;
+  LIS_INT        *perm,*ptr,*index,*col;
+  LIS_SCALAR    *value;
+
+  LIS_DEBUG_FUNC_IN;
+
+  n       = A->n;
+  maxnzr  = 0;
+  perm    = NULL;
+  ptr     = NULL;
+  index   = NULL;
+  value   = NULL;
+
+  iw = (LIS_INT *)lis_malloc(n*sizeof(LIS_INT),"lis_matrix_merge_sell::iw");
+  if( iw==NULL )
+  {
+    LIS_SETERR_MEM(n*sizeof(LIS_INT));
+    return LIS_OUT_OF_MEMORY;
+  }
+  col = (LIS_INT *)lis_malloc(n*sizeof(LIS_INT),"lis_matrix_merge_sell::col");
+  if( col==NULL )
+  {
+    LIS_SETERR_MEM(n*sizeof(LIS_INT));
+    lis_free(iw);
+    return LIS_OUT_OF_MEMORY;
+  }
+
+  for(i=0;i<n;i++)
+  {
+    count = 1;
+    p = A->L->col[i];
+    j = A->L->ptr[p/LIS_MATRIX_SELL_C] + p%LIS_MATRIX_SELL_C;
+    w = (A->L->ptr[p/LIS_MATRIX_SELL_C+1] - A->L->ptr[p/LIS_MATRIX_SELL_C])/LIS_MATRIX_SELL_C;
+    for(k=0;k<w;k++,j+=LIS_MATRIX_SELL_C)
+    {
+      if( A->L->index[j]<i ) count++;
+    }
+    p = A->U->col[i];
+    j = A->U->ptr[p/LIS_MATRIX_SELL_C] + p%LIS_MATRIX_SELL_C;
+    w = (A->U->ptr[p/LIS_MATRIX_SELL_C+1] - A->U->ptr[p/LIS_MATRIX_SELL_C])/LIS_MATRIX_SELL_C;
+    for(k=0;k<w;k++,j+=LIS_MATRIX_SELL_C)
+    {
+      if( A->U->index[j]>i ) count++;
+    }
+    iw[i] = count;
+    if( count>maxnzr ) maxnzr = count;
+  }
+
+  err = lis_matrix_create_sell(n,maxnzr,iw,&perm,&ptr,&index,&value);
+  lis_free(iw);
+  if( err )
+  {
+    lis_free(col);
+    return err;
+  }
+
+  for(i=0;i<n;i++)
+  {
+    col[perm[i]] = i;
+  }
+  for(i=0;i<n;i++)
+  {
+    p = col[i];
+    count = ptr[p/LIS_MATRIX_SELL_C] + p%LIS_MATRIX_SELL_C;
+    p = A->L->col[i];
+    j = A->L->ptr[p/LIS_MATRIX_SELL_C] + p%LIS_MATRIX_SELL_C;
+    w = (A->L->ptr[p/LIS_MATRIX_SELL_C+1] - A->L->ptr[p/LIS_MATRIX_SELL_C])/LIS_MATRIX_SELL_C;
+    for(k=0;k<w;k++,j+=LIS_MATRIX_SELL_C)
+    {
+      if( A->L->index[j]<i )
+      {
+        index[count] = A->L->index[j];
+        value[count] = A->L->value[j];
+        count += LIS_MATRIX_SELL_C;
+      }
+    }
+    index[count] = i;
+    value[count] = A->D->value[i];
+    count += LIS_MATRIX_SELL_C;
+    p = A->U->col[i];
+    j = A->U->ptr[p/LIS_MATRIX_SELL_C] + p%LIS_MATRIX_SELL_C;
+    w = (A->U->ptr[p/LIS_MATRIX_SELL_C+1] - A->U->ptr[p/LIS_MATRIX_SELL_C])/LIS_MATRIX_SELL_C;
+    for(k=0;k<w;k++,j+=LIS_MATRIX_SELL_C)
+    {
+      if( A->U->index[j]>i )
+      {
+        index[count] = A->U->index[j];
+        value[count] = A->U->value[j];
+        count += LIS_MATRIX_SELL_C;
+      }
+    }
+  }
+
+  lis_free2(5,A->row,A->col,A->ptr,A->index,A->value);
+  A->maxnzr     = maxnzr;
+  A->row        = perm;
+  A->col        = col;
+  A->ptr        = ptr;
+  A->value      = value;
+  A->index      = index;
+
+  LIS_DEBUG_FUNC_OUT;
+  return LIS_SUCCESS;
+}
+
+#undef __FUNC__
+#define __FUNC__ "lis_matrix_get_diagonal_sell"
+LIS_INT lis_matrix_get_diagonal_sell(LIS_MATRIX A, LIS_SCALAR d[])
+{
+  LIS_INT i,j,k,p,w;
+  LIS_INT n;
+
+  LIS_DEBUG_FUNC_IN;
+
+  n    = A->n;
+  if( A->is_splited )
+  {
+    #ifdef _OPENMP
+    #pragma omp parallel for private(i)
+    #endif
+    for(i=0; i<n; i++)
+    {
+      d[i] = A->D->value[i];
+    }
+  }
+  else
+  {
+    #ifdef _OPENMP
+    #pragma omp parallel for private(i,j,k,p,w)
+    #endif
+    for(i=0; i<n; i++)
+    {
+      d[i] = (LIS_SCALAR)0.0;
+      p = A->col[i];
+      j = A->ptr[p/LIS_MATRIX_SELL_C] + p%LIS_MATRIX_SELL_C;
+      w = (A->ptr[p/LIS_MATRIX_SELL_C+1] - A->ptr[p/LIS_MATRIX_SELL_C])/LIS_MATRIX_SELL_C;
+      for(k=0;k<w;k++,j+=LIS_MATRIX_SELL_C)
+      {
+        if( i==A->index[j] )
+        {
+          d[i] = A->value[j];
+          break;
+        }
+      }
+    }
+  }
+  LIS_DEBUG_FUNC_OUT;
+  return LIS_SUCCESS;
+}
+
+#undef __FUNC__
+#define __FUNC__ "lis_matrix_scaling_sell"
+LIS_INT lis_matrix_scaling_sell(LIS_MATRIX A, LIS_SCALAR d[])
+{
+  LIS_INT i,j,k,n;
+
+  LIS_DEBUG_FUNC_IN;
+
+  n      = A->n;
+  if( A->is_splited )
+  {
+    #ifdef _OPENMP
+    #pragma omp parallel private(i,j,k)
+    #endif
+    {
+      #ifdef _OPENMP
+      #pragma omp for
+      #endif
+      for(i=0;i<n;i++)
+      {
+        A->D->value[i] = 1.0;
+      }
+      #ifdef _OPENMP
+      #pragma omp for
+      #endif
+      for(i=0;i<n;i++)
+      {
+        k = A->L->row[i];
+        for(j=A->L->ptr[i/LIS_MATRIX_SELL_C]+i%LIS_MATRIX_SELL_C;j<A->L->ptr[i/LIS_MATRIX_SELL_C+1];j+=LIS_MATRIX_SELL_C)
+        {
+          A->L->value[j] *= d[k];
+        }
+        k = A->U->row[i];
+        for(j=A->U->ptr[i/LIS_MATRIX_SELL_C]+i%LIS_MATRIX_SELL_C;j<A->U->ptr[i/LIS_MATRIX_SELL_C+1];j+=LIS_MATRIX_SELL_C)
+        {
+          A->U->value[j] *= d[k];
+        }
+      }
+    }
+  }
+  else
+  {
+    #ifdef _OPENMP
+    #pragma omp parallel for private(i,j,k)
+    #endif
+    for(i=0;i<n;i++)
+    {
+      k = A->row[i];
+      for(j=A->ptr[i/LIS_MATRIX_SELL_C]+i%LIS_MATRIX_SELL_C;j<A->ptr[i/LIS_MATRIX_SELL_C+1];j+=LIS_MATRIX_SELL_C)
+      {
+        A->value[j] *= d[k];
+      }
+    }
+  }
+  LIS_DEBUG_FUNC_OUT;
+  return LIS_SUCCESS;
+}
+
+#undef __FUNC__
+#define __FUNC__ "lis_matrix_scaling_symm_sell"
+LIS_INT lis_matrix_scaling_symm_sell(LIS_MATRIX A, LIS_SCALAR d[])
+{
+  LIS_INT i,j,k,n;
+
+  LIS_DEBUG_FUNC_IN;
+
+  n      = A->n;
+  if( A->is_splited )
+  {
+    #ifdef _OPENMP
+    #pragma omp parallel private(i,j,k)
+    #endif
+    {
+      #ifdef _OPENMP
+      #pragma omp for
+      #endif
+      for(i=0;i<n;i++)
+      {
+        A->D->value[i] = 1.0;
+      }
+      #ifdef _OPENMP
+      #pragma omp for
+      #endif
+      for(i=0;i<n;i++)
+      {
+        k = A->L->row[i];
+        for(j=A->L->ptr[i/LIS_MATRIX_SELL_C]+i%LIS_MATRIX_SELL_C;j<A->L->ptr[i/LIS_MATRIX_SELL_C+1];j+=LIS_MATRIX_SELL_C)
+        {
+          A->L->value[j] *= d[k]*d[A->L->index[j]];
+        }
+        k = A->U->row[i];
+        for(j=A->U->ptr[i/LIS_MATRIX_SELL_C]+i%LIS_MATRIX_SELL_C;j<A->U->ptr[i/LIS_MATRIX_SELL_C+1];j+=LIS_MATRIX_SELL_C)
+        {
+          A->U->value[j] *= d[k]*d[A->U->index[j]];
+        }
+      }
+    }
+  }
+  else
+  {
+    #ifdef _OPENMP
+    #pragma omp parallel for private(i,j,k)
+    #endif
+    for(i=0;i<n;i++)
+    {
+      k = A->row[i];
+      for(j=A->ptr[i/LIS_MATRIX_SELL_C]+i%LIS_MATRIX_SELL_C;j<A->ptr[i/LIS_MATRIX_SELL_C+1];j+=LIS_MATRIX_SELL_C)
+      {
+        A->value[j] *= d[k]*d[A->index[j]];
+      }
+    }
+  }
+  LIS_DEBUG_FUNC_OUT;
+  return LIS_SUCCESS;
+}
+
+#undef __FUNC__
+#define __FUNC__ "lis_matrix_solve_sell"
+LIS_INT lis_matrix_solve_sell(LIS_MATRIX A, LIS_VECTOR B, LIS_VECTOR X, LIS_INT flag)
+{
+  LIS_INT i,j,je,p,n;
+  LIS_SCALAR  t;
+  LIS_SCALAR  *b,*x;
+
+  LIS_DEBUG_FUNC_IN;
+
+  n       = A->n;
+  b       = B->value;
+  x       = X->value;
+
+  switch(flag)
+  {
+  case LIS_MATRIX_LOWER:
+    for(i=0;i<n;i++)
+    {
+      t  = b[i];
+      p  = A->L->col[i];
+      je = A->L->ptr[p/LIS_MATRIX_SELL_C+1];
+      for(j=A->L->ptr[p/LIS_MATRIX_SELL_C]+p%LIS_MATRIX_SELL_C;j<je;j+=LIS_MATRIX_SELL_C)
+      {
+        t -= A->L->value[j] * x[A->L->index[j]];
+      }
+      x[i]   = t * A->WD->value[i];
+    }
+    break;
+  case LIS_MATRIX_UPPER:
+    for(i=n-1;i>=0;i--)
+    {
+      t  = b[i];
+      p  = A->U->col[i];
+      je = A->U->ptr[p/LIS_MATRIX_SELL_C+1];
+      for(j=A->U->ptr[p/LIS_MATRIX_SELL_C]+p%LIS_MATRIX_SELL_C;j<je;j+=LIS_MATRIX_SELL_C)
+      {
+        t -= A->U->value[j] * x[A->U->index[j]];
+      }
+      x[i]   = t * A->WD->value[i];
+    }
+    break;
+  case LIS_MATRIX_SSOR:
+    for(i=0;i<n;i++)
+    {
+      t  = b[i];
+      p  = A->L->col[i];
+      je = A->L->ptr[p/LIS_MATRIX_SELL_C+1];
+      for(j=A->L->ptr[p/LIS_MATRIX_SELL_C]+p%LIS_MATRIX_SELL_C;j<je;j+=LIS_MATRIX_SELL_C)
+      {
+        t -= A->L->value[j] * x[A->L->index[j]];
+      }
+      x[i]   = t * A->WD->value[i];
+    }
+    for(i=n-1;i>=0;i--)
+    {
+      t  = 0.0;
+      p  = A->U->col[i];
+      je = A->U->ptr[p/LIS_MATRIX_SELL_C+1];
+      for(j=A->U->ptr[p/LIS_MATRIX_SELL_C]+p%LIS_MATRIX_SELL_C;j<je;j+=LIS_MATRIX_SELL_C)
+      {
+        if( A->U->index[j]>=n ) continue;
+        t += A->U->value[j] * x[A->U->index[j]];
+      }
+      x[i]  -= t * A->WD->value[i];
+    }
+    break;
+  }
+
+  LIS_DEBUG_FUNC_OUT;
+  return LIS_SUCCESS;
+}
+
+#undef __FUNC__
+#define __FUNC__ "lis_matrix_solvet_sell"
+LIS_INT lis_matrix_solvet_sell(LIS_MATRIX A, LIS_VECTOR B, LIS_VECTOR X, LIS_INT flag)
+{
+  LIS_INT i,j,je,p,n;
+  LIS_SCALAR  t;
+  LIS_SCALAR  *x;
+
+  LIS_DEBUG_FUNC_IN;
+
+  n       = A->n;
+  x       = X->value;
+
+  lis_vector_copy(B,X);
+  switch(flag)
+  {
+  case LIS_MATRIX_LOWER:
+    for(i=0;i<n;i++)
+    {
+      x[i]   = x[i] * A->WD->value[i];
+      p  = A->U->col[i];
+      je = A->U->ptr[p/LIS_MATRIX_SELL_C+1];
+      for(j=A->U->ptr[p/LIS_MATRIX_SELL_C]+p%LIS_MATRIX_SELL_C;j<je;j+=LIS_MATRIX_SELL_C)
+      {
+        x[A->U->index[j]] -= A->U->value[j] * x[i];
+      }
+    }
+    break;
+  case LIS_MATRIX_UPPER:
+    for(i=n-1;i>=0;i--)
+    {
+      x[i]   = x[i] * A->WD->value[i];
+      p  = A->L->col[i];
+      je = A->L->ptr[p/LIS_MATRIX_SELL_C+1];
+      for(j=A->L->ptr[p/LIS_MATRIX_SELL_C]+p%LIS_MATRIX_SELL_C;j<je;j+=LIS_MATRIX_SELL_C)
+      {
+        x[A->L->index[j]] -= A->L->value[j] * x[i];
+      }
+    }
+    break;
+  case LIS_MATRIX_SSOR:
+    for(i=0;i<n;i++)
+    {
+      t   = x[i] * A->WD->value[i];
+      p  = A->U->col[i];
+      je = A->U->ptr[p/LIS_MATRIX_SELL_C+1];
+      for(j=A->U->ptr[p/LIS_MATRIX_SELL_C]+p%LIS_MATRIX_SELL_C;j<je;j+=LIS_MATRIX_SELL_C)
+      {
+        x[A->U->index[j]] -= A->U->value[j] * t;
+      }
+    }
+    for(i=n-1;i>=0;i--)
+    {
+      t    = x[i] * A->WD->value[i];
+      x[i] = t;
+      p  = A->L->col[i];
+      je = A->L->ptr[p/LIS_MATRIX_SELL_C+1];
+      for(j=A->L->ptr[p/LIS_MATRIX_SELL_C]+p%LIS_MATRIX_SELL_C;j<je;j+=LIS_MATRIX_SELL_C)
+      {
+        x[A->L->index[j]] -= A->L->value[j] * t;
+      }
+    }
+    break;
+  }
+
+  LIS_DEBUG_FUNC_OUT;
+  return LIS_SUCCESS;
+}
+
+#undef __FUNC__
+#define __FUNC__ "lis_matrix_convert_csr2sell"
+LIS_INT lis_matrix_convert_csr2sell(LIS_MATRIX Ain, LIS_MATRIX Aout)
+{
+  LIS_INT      i,j,k,p;
+  LIS_INT      err;
+  LIS_INT      n,maxnzr;
+  LIS_INT      *iw;
+  LIS_INT      *perm,*ptr,*index;
+  LIS_SCALAR  *value;
+
+  LIS_DEBUG_FUNC_IN;
+
+  n       = Ain->n;
+
+  perm    = NULL;
+  ptr     = NULL;
+  index   = NULL;
+  value   = NULL;
+  iw      = NULL;
+
+  iw = (LIS_INT *)lis_malloc( n*sizeof(LIS_INT),"lis_matrix_convert_csr2sell::iw" );
+  if( iw==NULL )
+  {
+    LIS_SETERR_MEM(n*sizeof(LIS_INT));
+    return LIS_OUT_OF_MEMORY;
+  }
+
+  /* check maxnzr */
+  maxnzr = 0;
+  for(i=0;i<n;i++)
+  {
+    iw[i] = Ain->ptr[i+1] - Ain->ptr[i];
+    if( iw[i] > maxnzr ) maxnzr = iw[i];
+  }
+
+  err = lis_matrix_create_sell(n,maxnzr,iw,&perm,&ptr,&index,&value);
+  lis_free(iw);
+  if( err )
+  {
+    return err;
+  }
+
+  /* convert sell */
+  #ifdef _OPENMP
+  #pragma omp parallel for private(i,j,k,p)
+  #endif
+  for(p=0;p<n;p++)
+  {
+    i = perm[p];
+    k = ptr[p/LIS_MATRIX_SELL_C] + p%LIS_MATRIX_SELL_C;
+    for(j=Ain->ptr[i];j<Ain->ptr[i+1];j++)
+    {
+      index[k] = Ain->index[j];
+      value[k] = Ain->value[j];
+      k += LIS_MATRIX_SELL_C;
+    }
+  }
+
+  err = lis_matrix_set_sell(maxnzr,perm,ptr,index,value,Aout);
+  if( err )
+  {
+    lis_free2(4,perm,ptr,index,value);
+    return err;
+  }
+  err = lis_matrix_assemble(Aout);
+  if( err )
+  {
+    lis_matrix_storage_destroy(Aout);
+    return err;
+  }
+
+  LIS_DEBUG_FUNC_OUT;
+  return LIS_SUCCESS;
+}
+
+#undef __FUNC__
+#define __FUNC__ "lis_matrix_convert_sell2csr"
+LIS_INT lis_matrix_convert_sell2csr(LIS_MATRIX Ain, LIS_MATRIX Aout)
+{
+  LIS_INT      i,j,k,p,je;
+  LIS_INT      err;
+  LIS_INT      n,nnz;
+  LIS_INT      *ptr,*index;
+  LIS_SCALAR  *value;
+
+  LIS_DEBUG_FUNC_IN;
+
+  n       = Ain->n;
+
+  ptr     = NULL;
+  index   = NULL;
+  value   = NULL;
+
+  ptr = (LIS_INT *)lis_malloc( (n+1)*sizeof(LIS_INT),"lis_matrix_convert_sell2csr::ptr" );
+  if( ptr==NULL )
+  {
+    LIS_SETERR_MEM((n+1)*sizeof(LIS_INT));
+    return LIS_OUT_OF_MEMORY;
+  }
+
+  /* check nnz */
+  #ifdef _OPENMP
+  #pragma omp parallel for private(i,j,k,p,je)
+  #endif
+  for(i=0;i<n;i++)
+  {
+    k  = 0;
+    p  = Ain->col[i];
+    je = Ain->ptr[p/LIS_MATRIX_SELL_C+1];
+    for(j=Ain->ptr[p/LIS_MATRIX_SELL_C]+p%LIS_MATRIX_SELL_C;j<je;j+=LIS_MATRIX_SELL_C)
+    {
+      if( Ain->value[j]!=(LIS_SCALAR)0.0 ) k++;
+    }
+    ptr[i+1] = k;
+  }
+  ptr[0] = 0;
+  for(i=0;i<n;i++)
+  {
+    ptr[i+1] += ptr[i];
+  }
+  nnz = ptr[n];
+
+  index = (LIS_INT *)lis_malloc( nnz*sizeof(LIS_INT),"lis_matrix_convert_sell2csr::index" );
+  if( index==NULL )
+  {
+    LIS_SETERR_MEM(nnz*sizeof(LIS_INT));
+    lis_free2(3,ptr,index,value);
+    return LIS_OUT_OF_MEMORY;
+  }
+  value = (LIS_SCALAR *)lis_malloc( nnz*sizeof(LIS_SCALAR),"lis_matrix_convert_sell2csr::value" );
+  if( value==NULL )
+  {
+    LIS_SETERR_MEM(nnz*sizeof(LIS_SCALAR));
+    lis_free2(3,ptr,index,value);
+    return LIS_OUT_OF_MEMORY;
+  }
+
+  /* convert csr */
+  #ifdef _OPENMP
+  #pragma omp parallel for private(i,j,k,p,je)
+  #endif
+  for(i=0;i<n;i++)
+  {
+    k  = ptr[i];
+    p  = Ain->col[i];
+    je = Ain->ptr[p/LIS_MATRIX_SELL_C+1];
+    for(j=Ain->ptr[p/LIS_MATRIX_SELL_C]+p%LIS_MATRIX_SELL_C;j<je;j+=LIS_MATRIX_SELL_C)
+    {
+      if( Ain->value[j]!=(LIS_SCALAR)0.0 )
+      {
+        value[k] = Ain->value[j];
+        index[k] = Ain->index[j];
+        k++;
+      }
+    }
+  }
+
+  err = lis_matrix_set_csr(nnz,ptr,index,value,Aout);
+  if( err )
+  {
+    lis_free2(3,ptr,index,value);
+    return err;
+  }
+  err = lis_matrix_assemble(Aout);
+  if( err )
+  {
+    lis_matrix_storage_destroy(Aout);
+    return err;
+  }
+
+  LIS_DEBUG_FUNC_OUT;
+  return LIS_SUCCESS;
+}
@@ -110,6 +110,12 @@ LIS_INT lis_matvec(LIS_MATRIX A, LIS_VECTOR X, LIS_VECTOR Y)
       #endif
       lis_matvec_ell(A, x, y);
       break;
+    case LIS_MATRIX_SELL:
+      #ifdef USE_MPI
+        LIS_MATVEC_SENDRECV;
+      #endif
+      lis_matvec_sell(A, x, y);
+      break;
     case LIS_MATRIX_DIA:
       #ifdef USE_MPI
         LIS_MATVEC_SENDRECV;
@@ -257,6 +263,15 @@ LIS_INT lis_matvect(LIS_MATRIX A, LIS_VECTOR X, LIS_VECTOR Y)
         LIS_MATVEC_REDUCE;
       #endif
       break;
+    case LIS_MATRIX_SELL:
+      #ifdef USE_MPI
+        LIS_MATVEC_REDUCE0;
+      #endif
+      lis_matvect_sell(A, x, y);
+      #ifdef USE_MPI
+        LIS_MATVEC_REDUCE;
+      #endif
+      break;
     case LIS_MATRIX_JAD:
       #ifdef USE_MPI
         LIS_MATVEC_REDUCE0;
@@ -364,7 +379,7 @@ LIS_INT lis_matvec_optimize(LIS_MATRIX A, LIS_INT *matrix_type_maxperf)
   double     commtime,comptime,flops,flops_maxperf;
   LIS_MATRIX       A1;
   LIS_VECTOR       X, Y;
-  char             *lis_storagename2[]   = {"CSR", "CSC", "MSR", "DIA", "ELL", "JAD", "BSR", "BSC", "VBR", "COO", "DNS"};
+  char             *lis_storagename2[]   = {"CSR", "CSC", "MSR", "DIA", "ELL", "JAD", "BSR", "BSC", "VBR", "COO", "DNS", "TJAD", "BJAD", "BCR", "CJAD", "PCSR", "LCSR", "LJAD", "LBSR", "CDIA", "MSC", "SELL"};
 
   LIS_DEBUG_FUNC_IN;
 
@@ -379,7 +394,7 @@ LIS_INT lis_matvec_optimize(LIS_MATRIX A, LIS_INT *matrix_type_maxperf)
 #endif
 
   ss = 1;
-  se = 11;
+  se = LIS_MATRIX_SELL+1;
 
   lis_vector_duplicate(A,&X);
   lis_vector_duplicate(A,&Y);
@@ -393,6 +408,7 @@ LIS_INT lis_matvec_optimize(LIS_MATRIX A, LIS_INT *matrix_type_maxperf)
   for (matrix_type=ss;matrix_type<se;matrix_type++)
     {
       if ( nprocs>1 && matrix_type==9 ) continue;
+      if ( matrix_type>=LIS_MATRIX_DNS && matrix_type<LIS_MATRIX_SELL ) continue;
       lis_matrix_duplicate(A,&A1);
       lis_matrix_set_type(A1,matrix_type);
       err = lis_matrix_convert(A,A1);
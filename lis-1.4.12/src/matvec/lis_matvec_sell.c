@@ -0,0 +1,325 @@
+/* Copyright (C) The Scalable Software Infrastructure Project. All rights reserved.
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+   1. Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+   3. Neither the name of the project nor the names of its contributors 
+      may be used to endorse or promote products derived from this software 
+      without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE SCALABLE SOFTWARE INFRASTRUCTURE PROJECT
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+   TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+   PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE SCALABLE SOFTWARE INFRASTRUCTURE
+   PROJECT BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+   OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifdef HAVE_CONFIG_H
+  #include "lis_config.h"
+#else
+#ifdef HAVE_CONFIG_WIN_H
+  #include "lis_config_win.h"
+#endif
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#ifdef HAVE_MALLOC_H
+        #include <malloc.h>
+#endif
+#include <string.h>
+#include <math.h>
+#ifdef _OPENMP
+  #include <omp.h>
+#endif
+#ifdef USE_MPI
+  #include <mpi.h>
+#endif
+#include "lislib.h"
+
+/*
+ * A slice of SELL-C-sigma is LIS_MATRIX_SELL_C rows wide, so one column of a
+ * slice fills one AVX-512 register (or two AVX2 registers) of doubles and
+ * the x entries are fetched with a gather.
+ */
+#if LIS_MATRIX_SELL_C==8 && !defined(_LONG__DOUBLE)
+  #if defined(__AVX512F__)
+    #define USE_SELL_AVX512
+  #elif defined(__AVX2__)
+    #define USE_SELL_AVX2
+  #endif
+#endif
+#if defined(USE_SELL_AVX512) || defined(USE_SELL_AVX2)
+  #include <immintrin.h>
+#endif
+
+static void lis_matvec_sell_slice(LIS_INT len, LIS_INT *index, LIS_SCALAR *value, LIS_SCALAR *x, LIS_SCALAR *t)
+{
+  LIS_INT j;
+#if defined(USE_SELL_AVX512)
+  __m512d vt;
+
+  vt = _mm512_setzero_pd();
+  for(j=0;j<len;j+=8)
+  {
+    #ifdef _LONGLONG
+      vt = _mm512_fmadd_pd(_mm512_loadu_pd(&value[j]),_mm512_i64gather_pd(_mm512_loadu_si512((void *)&index[j]),x,8),vt);
+    #else
+      vt = _mm512_fmadd_pd(_mm512_loadu_pd(&value[j]),_mm512_i32gather_pd(_mm256_loadu_si256((__m256i *)&index[j]),x,8),vt);
+    #endif
+  }
+  _mm512_storeu_pd(t,vt);
+#elif defined(USE_SELL_AVX2)
+  __m256d vt0,vt1,vx0,vx1;
+
+  vt0 = _mm256_setzero_pd();
+  vt1 = _mm256_setzero_pd();
+  for(j=0;j<len;j+=8)
+  {
+    #ifdef _LONGLONG
+      vx0 = _mm256_i64gather_pd(x,_mm256_loadu_si256((__m256i *)&index[j]),8);
+      vx1 = _mm256_i64gather_pd(x,_mm256_loadu_si256((__m256i *)&index[j+4]),8);
+    #else
+      vx0 = _mm256_i32gather_pd(x,_mm_loadu_si128((__m128i *)&index[j]),8);
+      vx1 = _mm256_i32gather_pd(x,_mm_loadu_si128((__m128i *)&index[j+4]),8);
+    #endif
+    #ifdef __FMA__
+      vt0 = _mm256_fmadd_pd(_mm256_loadu_pd(&value[j]),vx0,vt0);
+      vt1 = _mm256_fmadd_pd(_mm256_loadu_pd(&value[j+4]),vx1,vt1);
+    #else
+      vt0 = _mm256_add_pd(vt0,_mm256_mul_pd(_mm256_loadu_pd(&value[j]),vx0));
+      vt1 = _mm256_add_pd(vt1,_mm256_mul_pd(_mm256_loadu_pd(&value[j+4]),vx1));
+    #endif
+  }
+  _mm256_storeu_pd(t,vt0);
+  _mm256_storeu_pd(t+4,vt1);
+#else
+  LIS_INT k;
+
+  for(k=0;k<LIS_MATRIX_SELL_C;k++)
+  {
+    t[k] = 0.0;
+  }
+  for(j=0;j<len;j+=LIS_MATRIX_SELL_C)
+  {
+    #ifdef USE_VEC_COMP
+    #pragma cdir nodep
+    #endif
+    for(k=0;k<LIS_MATRIX_SELL_C;k++)
+    {
+      t[k] += value[j+k] * x[index[j+k]];
+    }
+  }
+#endif
+}
+
+void lis_matvec_sell(LIS_MATRIX A, LIS_SCALAR x[], LIS_SCALAR y[])
+{
+  LIS_INT i,k,p,s,is,ie;
+  LIS_INT n,nslice,nprocs,my_rank;
+  LIS_SCALAR t[LIS_MATRIX_SELL_C];
+
+  n      = A->n;
+  nslice = (n+LIS_MATRIX_SELL_C-1)/LIS_MATRIX_SELL_C;
+  #ifdef _OPENMP
+    nprocs = omp_get_max_threads();
+  #else
+    nprocs = 1;
+  #endif
+  if( A->is_splited )
+  {
+    #ifdef _OPENMP
+    #pragma omp parallel private(i,k,p,s,is,ie,my_rank,t)
+    #endif
+    {
+      #ifdef _OPENMP
+        my_rank = omp_get_thread_num();
+      #else
+        my_rank = 0;
+      #endif
+      LIS_GET_ISIE(my_rank,nprocs,n,is,ie);
+      for(i=is;i<ie;i++)
+      {
+        y[i] = A->D->value[i]*x[i];
+      }
+      LIS_GET_ISIE(my_rank,nprocs,nslice,is,ie);
+      #ifdef _OPENMP
+      #pragma omp barrier
+      #endif
+      for(s=is;s<ie;s++)
+      {
+        lis_matvec_sell_slice(A->L->ptr[s+1]-A->L->ptr[s],&A->L->index[A->L->ptr[s]],&A->L->value[A->L->ptr[s]],x,t);
+        for(k=0;k<LIS_MATRIX_SELL_C;k++)
+        {
+          p = s*LIS_MATRIX_SELL_C + k;
+          if( p<n ) y[A->L->row[p]] += t[k];
+        }
+      }
+      #ifdef _OPENMP
+      #pragma omp barrier
+      #endif
+      for(s=is;s<ie;s++)
+      {
+        lis_matvec_sell_slice(A->U->ptr[s+1]-A->U->ptr[s],&A->U->index[A->U->ptr[s]],&A->U->value[A->U->ptr[s]],x,t);
+        for(k=0;k<LIS_MATRIX_SELL_C;k++)
+        {
+          p = s*LIS_MATRIX_SELL_C + k;
+          if( p<n ) y[A->U->row[p]] += t[k];
+        }
+      }
+    }
+  }
+  else
+  {
+    #ifdef _OPENMP
+    #pragma omp parallel private(k,p,s,is,ie,my_rank,t)
+    #endif
+    {
+      #ifdef _OPENMP
+        my_rank = omp_get_thread_num();
+      #else
+        my_rank = 0;
+      #endif
+      LIS_GET_ISIE(my_rank,nprocs,nslice,is,ie);
+      for(s=is;s<ie;s++)
+      {
+        lis_matvec_sell_slice(A->ptr[s+1]-A->ptr[s],&A->index[A->ptr[s]],&A->value[A->ptr[s]],x,t);
+        for(k=0;k<LIS_MATRIX_SELL_C;k++)
+        {
+          p = s*LIS_MATRIX_SELL_C + k;
+          if( p<n ) y[A->row[p]] = t[k];
+        }
+      }
+    }
+  }
+}
+
+void lis_matvect_sell(LIS_MATRIX A, LIS_SCALAR x[], LIS_SCALAR y[])
+{
+  LIS_INT i,j,k,p,s;
+  LIS_INT n,nslice;
+  LIS_SCALAR xt[LIS_MATRIX_SELL_C];
+  #ifdef _OPENMP
+    LIS_INT is,ie,np,nprocs,my_rank;
+    LIS_SCALAR t;
+    LIS_SCALAR *w;
+  #endif
+
+  n      = A->n;
+  nslice = (n+LIS_MATRIX_SELL_C-1)/LIS_MATRIX_SELL_C;
+  if( A->is_splited )
+  {
+    #ifdef USE_VEC_COMP
+    #pragma cdir nodep
+    #endif
+    for(i=0; i<n; i++)
+    {
+      y[i] = A->D->value[i]*x[i];
+    }
+    for(s=0;s<nslice;s++)
+    {
+      for(k=0;k<LIS_MATRIX_SELL_C;k++)
+      {
+        p = s*LIS_MATRIX_SELL_C + k;
+        xt[k] = p<n ? x[A->L->row[p]] : 0.0;
+      }
+      for(j=A->L->ptr[s];j<A->L->ptr[s+1];j+=LIS_MATRIX_SELL_C)
+      {
+        for(k=0;k<LIS_MATRIX_SELL_C;k++)
+        {
+          y[A->L->index[j+k]] += A->L->value[j+k] * xt[k];
+        }
+      }
+      for(k=0;k<LIS_MATRIX_SELL_C;k++)
+      {
+        p = s*LIS_MATRIX_SELL_C + k;
+        xt[k] = p<n ? x[A->U->row[p]] : 0.0;
+      }
+      for(j=A->U->ptr[s];j<A->U->ptr[s+1];j+=LIS_MATRIX_SELL_C)
+      {
+        for(k=0;k<LIS_MATRIX_SELL_C;k++)
+        {
+          y[A->U->index[j+k]] += A->U->value[j+k] * xt[k];
+        }
+      }
+    }
+  }
+  else
+  {
+    #ifdef _OPENMP
+      np     = A->np;
+      nprocs = omp_get_max_threads();
+      w = (LIS_SCALAR *)lis_malloc( nprocs*np*sizeof(LIS_SCALAR),"lis_matvect_sell::w" );
+      #pragma omp parallel private(i,j,k,p,s,t,is,ie,my_rank,xt)
+      {
+        my_rank = omp_get_thread_num();
+        LIS_GET_ISIE(my_rank,nprocs,nslice,is,ie);
+        #pragma omp for
+        for(j=0;j<nprocs;j++)
+        {
+          memset( &w[j*np], 0, np*sizeof(LIS_SCALAR) );
+        }
+        for(s=is;s<ie;s++)
+        {
+          for(k=0;k<LIS_MATRIX_SELL_C;k++)
+          {
+            p = s*LIS_MATRIX_SELL_C + k;
+            xt[k] = p<n ? x[A->row[p]] : 0.0;
+          }
+          for(j=A->ptr[s];j<A->ptr[s+1];j+=LIS_MATRIX_SELL_C)
+          {
+            for(k=0;k<LIS_MATRIX_SELL_C;k++)
+            {
+              w[my_rank*np + A->index[j+k]] += A->value[j+k] * xt[k];
+            }
+          }
+        }
+        #pragma omp barrier
+        #pragma omp for
+        for(i=0;i<np;i++)
+        {
+          t = 0.0;
+          for(j=0;j<nprocs;j++)
+          {
+            t += w[j*np+i];
+          }
+          y[i] = t;
+        }
+      }
+      lis_free(w);
+    #else
+      #ifdef USE_VEC_COMP
+      #pragma cdir nodep
+      #endif
+      for(i=0; i<n; i++)
+      {
+        y[i] = 0.0;
+      }
+      for(s=0;s<nslice;s++)
+      {
+        for(k=0;k<LIS_MATRIX_SELL_C;k++)
+        {
+          p = s*LIS_MATRIX_SELL_C + k;
+          xt[k] = p<n ? x[A->row[p]] : 0.0;
+        }
+        for(j=A->ptr[s];j<A->ptr[s+1];j+=LIS_MATRIX_SELL_C)
+        {
+          for(k=0;k<LIS_MATRIX_SELL_C;k++)
+          {
+            y[A->index[j+k]] += A->value[j+k] * xt[k];
+          }
+        }
+      }
+    #endif
+  }
+}
@@ -50,6 +50,7 @@
 /************************************************
  * lis_precon_init
  * lis_precon_create
+ * lis_precon_reuse
  * lis_precon_destroy
  * lis_psolve
  * lis_psolvet
@@ -62,6 +63,14 @@ LIS_PRECON_CREATE_XXX lis_precon_create_xxx[] = {
   lis_precon_create_ilut, lis_precon_create_bjacobi
 };
 
+/* numeric refresh on the stored structure, NULL means rebuild */
+LIS_PRECON_CREATE_XXX lis_precon_refresh_xxx[] = {
+  NULL,                    NULL,                     lis_precon_refresh_iluk,
+  NULL,                    NULL,                     NULL,
+  NULL,                    lis_precon_refresh_saamg, lis_precon_refresh_iluc,
+  lis_precon_refresh_ilut, NULL
+};
+
 LIS_PSOLVE_XXX lis_psolve_xxx[] = {
   lis_psolve_none,     lis_psolve_jacobi, lis_psolve_iluk_csr,
   lis_psolve_ssor,     lis_psolve_hybrid, lis_psolve_none,
@@ -142,6 +151,55 @@ LIS_INT lis_precon_create(LIS_SOLVER solver, LIS_PRECON *precon)
   return LIS_SUCCESS;
 }
 
+#undef __FUNC__
+#define __FUNC__ "lis_precon_reuse"
+LIS_INT lis_precon_reuse(LIS_SOLVER solver, LIS_PRECON *precon)
+{
+  LIS_INT      err;
+  LIS_INT      precon_type,stale;
+  LIS_REAL    ratio;
+
+  LIS_DEBUG_FUNC_IN;
+
+  precon_type = solver->options[LIS_OPTIONS_PRECON];
+  ratio       = solver->params[LIS_PARAMS_PRECON_REUSE_RATIO-LIS_OPTIONS_LEN];
+  *precon     = solver->reuse_precon;
+
+  if( *precon )
+  {
+    /*
+     * rebuild when the preconditioner type changed, the previous solve
+     * failed or its iteration count grew beyond ratio times the count
+     * observed right after the last full build
+     */
+    stale = (*precon)->precon_type!=precon_type
+         || solver->retcode!=LIS_SUCCESS
+         || solver->iter > ratio*solver->reuse_iter;
+    if( !stale && precon_type<LIS_PRECON_TYPE_USERDEF && lis_precon_refresh_xxx[precon_type] )
+    {
+      err = lis_precon_refresh_xxx[precon_type](solver,*precon);
+      if( err==LIS_SUCCESS )
+      {
+        LIS_DEBUG_FUNC_OUT;
+        return LIS_SUCCESS;
+      }
+    }
+    lis_precon_destroy(*precon);
+    solver->reuse_precon = NULL;
+  }
+
+  err = lis_precon_create(solver,precon);
+  if( err )
+  {
+    return err;
+  }
+  solver->reuse_precon = *precon;
+  solver->reuse_iter   = 0;
+
+  LIS_DEBUG_FUNC_OUT;
+  return LIS_SUCCESS;
+}
+
 #undef __FUNC__
 #define __FUNC__ "lis_precon_create_none"
 LIS_INT lis_precon_create_none(LIS_SOLVER solver, LIS_PRECON precon)
@@ -171,6 +229,8 @@ LIS_INT lis_precon_destroy(LIS_PRECON precon)
     lis_vector_destroy(precon->temp);
     lis_matrix_ilu_destroy(precon->L);
     lis_matrix_ilu_destroy(precon->U);
+    lis_matrix_level_destroy(precon->Llev);
+    lis_matrix_level_destroy(precon->Ulev);
     lis_matrix_diag_destroy(precon->WD);
     if( precon->solver )
     {
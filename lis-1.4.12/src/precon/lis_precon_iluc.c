@@ -57,6 +57,7 @@
 
 /************************************************
  * lis_precon_create
+ * lis_precon_refresh
  * lis_psolve
  * lis_psolvet
  ************************************************/
@@ -130,6 +131,180 @@ LIS_INT lis_precon_create_iluc(LIS_SOLVER solver, LIS_PRECON precon)
 }
 
 
+#undef __FUNC__
+#define __FUNC__ "lis_precon_refresh_iluc"
+LIS_INT lis_precon_refresh_iluc(LIS_SOLVER solver, LIS_PRECON precon)
+{
+  LIS_INT        err;
+  LIS_INT        i,j,k,l,n,nnz;
+  LIS_INT        col,jpos;
+  LIS_INT        *jw,*ptr,*index,*pos;
+  LIS_SCALAR    gamma,d,t;
+  LIS_SCALAR    *w;
+  LIS_MATRIX    A,B;
+  LIS_MATRIX_ILU  L,U;
+  LIS_VECTOR    D;
+
+  LIS_DEBUG_FUNC_IN;
+
+  if( lis_psolve_xxx[LIS_PRECON_TYPE_ILUC]!=lis_psolve_iluc )
+  {
+    return LIS_ERR_NOT_IMPLEMENTED;
+  }
+
+  B = NULL;
+  A = solver->A;
+  if( A->matrix_type!=LIS_MATRIX_CSR )
+  {
+    err = lis_matrix_duplicate(A,&B);
+    if( err ) return err;
+    lis_matrix_set_type(B,LIS_MATRIX_CSR);
+    err = lis_matrix_convert(A,B);
+    if( err ) return err;
+    A = B;
+  }
+
+  n      = A->n;
+  gamma  = solver->params[LIS_PARAMS_GAMMA-LIS_OPTIONS_LEN];
+  L      = precon->L;
+  U      = precon->U;
+  D      = precon->D;
+
+  nnz = 0;
+  for(k=0;k<n;k++) nnz += L->nnz[k];
+
+  ptr   = (LIS_INT *)lis_malloc((n+1)*sizeof(LIS_INT),"lis_precon_refresh_iluc::ptr");
+  jw    = (LIS_INT *)lis_malloc(n*sizeof(LIS_INT),"lis_precon_refresh_iluc::jw");
+  index = (LIS_INT *)lis_malloc((nnz+1)*sizeof(LIS_INT),"lis_precon_refresh_iluc::index");
+  pos   = (LIS_INT *)lis_malloc((nnz+1)*sizeof(LIS_INT),"lis_precon_refresh_iluc::pos");
+  w     = (LIS_SCALAR *)lis_malloc((nnz+1)*sizeof(LIS_SCALAR),"lis_precon_refresh_iluc::w");
+  if( ptr==NULL || jw==NULL || index==NULL || pos==NULL || w==NULL )
+  {
+    LIS_SETERR_MEM((n+3*nnz)*sizeof(LIS_SCALAR));
+    lis_free2(5,ptr,jw,index,pos,w);
+    if( B ) lis_matrix_destroy(B);
+    return LIS_OUT_OF_MEMORY;
+  }
+
+  /* row pattern of the column oriented L, columns ascending in each row */
+  for(i=0;i<=n;i++) ptr[i] = 0;
+  for(k=0;k<n;k++)
+  {
+    for(j=0;j<L->nnz[k];j++)
+    {
+      ptr[L->index[k][j]+1]++;
+    }
+  }
+  for(i=0;i<n;i++)
+  {
+    ptr[i+1] += ptr[i];
+    jw[i]     = ptr[i];
+  }
+  for(k=0;k<n;k++)
+  {
+    for(j=0;j<L->nnz[k];j++)
+    {
+      i        = L->index[k][j];
+      l        = jw[i]++;
+      index[l] = k;
+      pos[l]   = j;
+    }
+  }
+
+  /* static pattern factorization, row by row */
+  err = LIS_SUCCESS;
+  for(i=0;i<n;i++) jw[i] = -1;
+  for(i=0;i<n;i++)
+  {
+    for(j=ptr[i];j<ptr[i+1];j++)
+    {
+      jw[index[j]] = j;
+      w[j]         = 0;
+    }
+    for(j=0;j<U->nnz[i];j++)
+    {
+      jw[U->index[i][j]] = j;
+      U->value[i][j]     = 0;
+    }
+    d = 0;
+
+    for(j=A->ptr[i];j<A->ptr[i+1];j++)
+    {
+      col = A->index[j];
+      #ifdef USE_MPI
+        if( col>=n ) continue;
+      #endif
+      if( col==i )
+      {
+        d += gamma * A->value[j];
+        continue;
+      }
+      jpos = jw[col];
+      if( jpos==-1 ) continue;
+      if( col<i )
+      {
+        w[jpos] = A->value[j];
+      }
+      else
+      {
+        U->value[i][jpos] = A->value[j];
+      }
+    }
+
+    for(j=ptr[i];j<ptr[i+1];j++)
+    {
+      k    = index[j];
+      t    = w[j] * D->value[k];
+      w[j] = t;
+      for(l=0;l<U->nnz[k];l++)
+      {
+        col = U->index[k][l];
+        if( col==i )
+        {
+          d -= t * U->value[k][l];
+          continue;
+        }
+        jpos = jw[col];
+        if( jpos==-1 ) continue;
+        if( col<i )
+        {
+          w[jpos] -= t * U->value[k][l];
+        }
+        else
+        {
+          U->value[i][jpos] -= t * U->value[k][l];
+        }
+      }
+    }
+
+    for(j=ptr[i];j<ptr[i+1];j++)
+    {
+      L->value[index[j]][pos[j]] = w[j];
+      jw[index[j]]               = -1;
+    }
+    for(j=0;j<U->nnz[i];j++)
+    {
+      jw[U->index[i][j]] = -1;
+    }
+    if( d==0.0 )
+    {
+      err = LIS_BREAKDOWN;
+      break;
+    }
+    D->value[i] = 1.0 / d;
+  }
+
+  lis_free2(5,ptr,jw,index,pos,w);
+  if( B ) lis_matrix_destroy(B);
+  if( err==LIS_SUCCESS && precon->Llev )
+  {
+    err = lis_precon_update_level(precon);
+  }
+
+  LIS_DEBUG_FUNC_OUT;
+  return err;
+}
+
 #undef __FUNC__
 #define __FUNC__ "lis_precon_create_iluc_csr"
 LIS_INT lis_precon_create_iluc_csr(LIS_SOLVER solver, LIS_PRECON precon)
@@ -160,7 +335,7 @@ LIS_INT lis_precon_create_iluc_csr(LIS_SOLVER solver, LIS_PRECON precon)
   gamma  = solver->params[LIS_PARAMS_GAMMA-LIS_OPTIONS_LEN];
   annz   = 10+A->nnz / A->n;
   lfil   = (LIS_INT)((double)A->nnz/(2.0*n))*m;
-  nprocs = omp_get_max_threads();
+  nprocs = LIS_ILU_LEVELSET(solver) ? 1 : omp_get_max_threads();
 
   L      = NULL;
   U      = NULL;
@@ -246,7 +421,7 @@ LIS_INT lis_precon_create_iluc_csr(LIS_SOLVER solver, LIS_PRECON precon)
   err = lis_matrix_malloc_csr(n,nnz,&ptr,&index,&value);
 
 
-  #pragma omp parallel private(i,ii,j,jj,k,kk,l,ll,is,ie,my_rank,cz,cw,toldd,t,nnz,len)
+  #pragma omp parallel private(i,ii,j,jj,k,kk,l,ll,is,ie,my_rank,cz,cw,toldd,t,nnz,len) num_threads(nprocs)
   {
     my_rank  = omp_get_thread_num();
     LIS_GET_ISIE(my_rank,nprocs,n,is,ie);
@@ -556,6 +731,12 @@ LIS_INT lis_precon_create_iluc_csr(LIS_SOLVER solver, LIS_PRECON precon)
 
   lis_free2(13,tmp,w,z,iw,iw2,wc,wl,iz,zc,zl,ptr,index,value);
 
+  if( LIS_ILU_LEVELSET(solver) )
+  {
+    err = lis_precon_create_level(precon,LIS_TRUE);
+    if( err ) return err;
+  }
+
   LIS_DEBUG_FUNC_OUT;
   return LIS_SUCCESS;
 #else
@@ -2025,6 +2206,13 @@ LIS_INT lis_psolve_iluc(LIS_SOLVER solver, LIS_VECTOR B, LIS_VECTOR X)
     xl = X->value_lo;
   #endif
 
+  if( precon->Llev )
+  {
+    lis_psolve_level(solver,B,X);
+    LIS_DEBUG_FUNC_OUT;
+    return LIS_SUCCESS;
+  }
+
   #ifdef USE_QUAD_PRECISION
     if( B->precision==LIS_PRECISION_DEFAULT )
     {
@@ -2377,8 +2565,8 @@ LIS_INT lis_psolvet_iluc(LIS_SOLVER solver, LIS_VECTOR B, LIS_VECTOR X)
     {
   #endif
       lis_vector_copy(B,X);
-      nprocs = omp_get_max_threads();
-      #pragma omp parallel private(i,j,jj,is,ie,my_rank,w)
+      nprocs = precon->Llev ? 1 : omp_get_max_threads();
+      #pragma omp parallel private(i,j,jj,is,ie,my_rank,w) num_threads(nprocs)
       {
         my_rank = omp_get_thread_num();
         LIS_GET_ISIE(my_rank,nprocs,n,is,ie);
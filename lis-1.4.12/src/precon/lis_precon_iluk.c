@@ -133,6 +133,45 @@ LIS_INT lis_precon_create_iluk(LIS_SOLVER solver, LIS_PRECON precon)
 }
 
 
+#undef __FUNC__
+#define __FUNC__ "lis_precon_refresh_iluk"
+LIS_INT lis_precon_refresh_iluk(LIS_SOLVER solver, LIS_PRECON precon)
+{
+  LIS_INT        err;
+  LIS_MATRIX    A,B;
+
+  LIS_DEBUG_FUNC_IN;
+
+  /* only the CSR factor is refreshed in place, block factors are rebuilt */
+  if( lis_psolve_xxx[LIS_PRECON_TYPE_ILU]!=lis_psolve_iluk_csr )
+  {
+    return LIS_ERR_NOT_IMPLEMENTED;
+  }
+
+  if( solver->A->matrix_type==LIS_MATRIX_CSR )
+  {
+    err = lis_numerical_fact_csr(solver,precon);
+    if( err ) return err;
+  }
+  else
+  {
+    A = solver->A;
+    err = lis_matrix_duplicate(A,&B);
+    if( err ) return err;
+    lis_matrix_set_type(B,LIS_MATRIX_CSR);
+    err = lis_matrix_convert(A,B);
+    if( err ) return err;
+    solver->A = B;
+    err = lis_numerical_fact_csr(solver,precon);
+    lis_matrix_destroy(B);
+    solver->A = A;
+    if( err ) return err;
+  }
+
+  LIS_DEBUG_FUNC_OUT;
+  return LIS_SUCCESS;
+}
+
 #undef __FUNC__
 #define __FUNC__ "lis_symbolic_fact_csr"
 LIS_INT lis_symbolic_fact_csr(LIS_SOLVER solver, LIS_PRECON precon)
@@ -154,7 +193,7 @@ LIS_INT lis_symbolic_fact_csr(LIS_SOLVER solver, LIS_PRECON precon)
   A      = solver->A;
   n      = A->n;
   levfill = solver->options[LIS_OPTIONS_FILL];
-  nprocs = omp_get_max_threads();
+  nprocs = LIS_ILU_LEVELSET(solver) ? 1 : omp_get_max_threads();
 
   L      = NULL;
   U      = NULL;
@@ -200,7 +239,7 @@ LIS_INT lis_symbolic_fact_csr(LIS_SOLVER solver, LIS_PRECON precon)
     return LIS_OUT_OF_MEMORY;
   }
 
-  #pragma omp parallel private(i,j,k,is,ie,my_rank,incl,incu,col,jpiv,it,ip,kmin,jmin)
+  #pragma omp parallel private(i,j,k,is,ie,my_rank,incl,incu,col,jpiv,it,ip,kmin,jmin) num_threads(nprocs)
   {
     my_rank  = omp_get_thread_num();
     LIS_GET_ISIE(my_rank,nprocs,n,is,ie);
@@ -528,7 +567,7 @@ LIS_INT lis_numerical_fact_csr(LIS_SOLVER solver, LIS_PRECON precon)
 
   A      = solver->A;
   n      = A->n;
-  nprocs = omp_get_max_threads();
+  nprocs = LIS_ILU_LEVELSET(solver) ? 1 : omp_get_max_threads();
 
   L = precon->L;
   U = precon->U;
@@ -542,7 +581,7 @@ LIS_INT lis_numerical_fact_csr(LIS_SOLVER solver, LIS_PRECON precon)
     return LIS_OUT_OF_MEMORY;
   }
 
-  #pragma omp parallel private(i,j,k,is,ie,my_rank,col,jpos,jrow)
+  #pragma omp parallel private(i,j,k,is,ie,my_rank,col,jpos,jrow) num_threads(nprocs)
   {
     my_rank  = omp_get_thread_num();
     LIS_GET_ISIE(my_rank,nprocs,n,is,ie);
@@ -578,6 +617,7 @@ LIS_INT lis_numerical_fact_csr(LIS_SOLVER solver, LIS_PRECON precon)
         if( col>=is && col<ie )
         {
           jpos = jw[col];
+          if( jpos==-1 ) continue;
           if( col<i )
           {
             L->value[i][jpos] = A->value[j];
@@ -634,6 +674,12 @@ LIS_INT lis_numerical_fact_csr(LIS_SOLVER solver, LIS_PRECON precon)
   }
   lis_free(jw);
 
+  if( LIS_ILU_LEVELSET(solver) )
+  {
+    err = precon->Llev ? lis_precon_update_level(precon) : lis_precon_create_level(precon,LIS_FALSE);
+    if( err ) return err;
+  }
+
   LIS_DEBUG_FUNC_OUT;
   return LIS_SUCCESS;
 #else
@@ -692,6 +738,7 @@ LIS_INT lis_numerical_fact_csr(LIS_SOLVER solver, LIS_PRECON precon)
         if( col>=n ) continue;
       #endif
       jpos = jw[col];
+      if( jpos==-1 ) continue;
       if( col<i )
       {
         L->value[i][jpos] = A->value[j];
@@ -781,6 +828,13 @@ LIS_INT lis_psolve_iluk_csr(LIS_SOLVER solver, LIS_VECTOR B, LIS_VECTOR X)
   n = solver->A->n;
   nprocs = omp_get_max_threads();
 
+  if( precon->Llev )
+  {
+    lis_psolve_level(solver,B,X);
+    LIS_DEBUG_FUNC_OUT;
+    return LIS_SUCCESS;
+  }
+
   #ifdef USE_QUAD_PRECISION
     if( B->precision==LIS_PRECISION_DEFAULT )
     {
@@ -986,14 +1040,14 @@ LIS_INT lis_psolvet_iluk_csr(LIS_SOLVER solver, LIS_VECTOR B, LIS_VECTOR X)
     xl = X->value_lo;
   #endif
   n = solver->A->n;
-  nprocs = omp_get_max_threads();
+  nprocs = precon->Llev ? 1 : omp_get_max_threads();
 
   #ifdef USE_QUAD_PRECISION
     if( B->precision==LIS_PRECISION_DEFAULT )
     {
   #endif
       lis_vector_copy(B,X);
-      #pragma omp parallel private(i,j,jj,is,ie,my_rank)
+      #pragma omp parallel private(i,j,jj,is,ie,my_rank) num_threads(nprocs)
       {
         my_rank = omp_get_thread_num();
         LIS_GET_ISIE(my_rank,nprocs,n,is,ie);
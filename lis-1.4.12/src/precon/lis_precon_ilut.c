@@ -115,6 +115,48 @@ LIS_INT lis_precon_create_ilut(LIS_SOLVER solver, LIS_PRECON precon)
 
 
 
+#undef __FUNC__
+#define __FUNC__ "lis_precon_refresh_ilut"
+LIS_INT lis_precon_refresh_ilut(LIS_SOLVER solver, LIS_PRECON precon)
+{
+  LIS_INT        err;
+  LIS_MATRIX    A,B;
+
+  LIS_DEBUG_FUNC_IN;
+
+  /*
+   * keep the dropping pattern of the last threshold factorization and
+   * recompute the values as a static pattern ILU(0) on L+D+U
+   */
+  if( lis_psolve_xxx[LIS_PRECON_TYPE_ILUT]!=lis_psolve_ilut_csr )
+  {
+    return LIS_ERR_NOT_IMPLEMENTED;
+  }
+
+  if( solver->A->matrix_type==LIS_MATRIX_CSR )
+  {
+    err = lis_numerical_fact_csr(solver,precon);
+    if( err ) return err;
+  }
+  else
+  {
+    A = solver->A;
+    err = lis_matrix_duplicate(A,&B);
+    if( err ) return err;
+    lis_matrix_set_type(B,LIS_MATRIX_CSR);
+    err = lis_matrix_convert(A,B);
+    if( err ) return err;
+    solver->A = B;
+    err = lis_numerical_fact_csr(solver,precon);
+    lis_matrix_destroy(B);
+    solver->A = A;
+    if( err ) return err;
+  }
+
+  LIS_DEBUG_FUNC_OUT;
+  return LIS_SUCCESS;
+}
+
 #undef __FUNC__
 #define __FUNC__ "lis_precon_create_ilut_csr"
 LIS_INT lis_precon_create_ilut_csr(LIS_SOLVER solver, LIS_PRECON precon)
@@ -143,7 +185,7 @@ LIS_INT lis_precon_create_ilut_csr(LIS_SOLVER solver, LIS_PRECON precon)
   m      = solver->params[LIS_PARAMS_RATE-LIS_OPTIONS_LEN];
   gamma  = solver->params[LIS_PARAMS_GAMMA-LIS_OPTIONS_LEN];
   lfil   = (LIS_INT)((double)A->nnz/(2.0*n))*m;
-  nprocs = omp_get_max_threads();
+  nprocs = LIS_ILU_LEVELSET(solver) ? 1 : omp_get_max_threads();
 
   L      = NULL;
   U      = NULL;
@@ -190,7 +232,7 @@ LIS_INT lis_precon_create_ilut_csr(LIS_SOLVER solver, LIS_PRECON precon)
   }
 
 
-  #pragma omp parallel private(is,ie,my_rank,i,j,k,jj,tnorm,tolnorm,len,lenu,lenl,col,t,jpos,jrow,fact,lxu,upos)
+  #pragma omp parallel private(is,ie,my_rank,i,j,k,jj,tnorm,tolnorm,len,lenu,lenl,col,t,jpos,jrow,fact,lxu,upos) num_threads(nprocs)
   {
     my_rank  = omp_get_thread_num();
     LIS_GET_ISIE(my_rank,nprocs,n,is,ie);
@@ -375,6 +417,12 @@ LIS_INT lis_precon_create_ilut_csr(LIS_SOLVER solver, LIS_PRECON precon)
 
   lis_free2(4,w,iw,wn,jbuf);
 
+  if( LIS_ILU_LEVELSET(solver) )
+  {
+    err = lis_precon_create_level(precon,LIS_FALSE);
+    if( err ) return err;
+  }
+
   LIS_DEBUG_FUNC_OUT;
   return LIS_SUCCESS;
 #else
@@ -669,6 +717,13 @@ LIS_INT lis_psolve_ilut_csr(LIS_SOLVER solver, LIS_VECTOR B, LIS_VECTOR X)
   #endif
   n = solver->A->n;
 
+  if( precon->Llev )
+  {
+    lis_psolve_level(solver,B,X);
+    LIS_DEBUG_FUNC_OUT;
+    return LIS_SUCCESS;
+  }
+
   #ifdef USE_QUAD_PRECISION
     if( B->precision==LIS_PRECISION_DEFAULT )
     {
@@ -873,14 +928,14 @@ LIS_INT lis_psolvet_ilut_csr(LIS_SOLVER solver, LIS_VECTOR B, LIS_VECTOR X)
     xl = X->value_lo;
   #endif
   n = solver->A->n;
-  nprocs = omp_get_max_threads();
+  nprocs = precon->Llev ? 1 : omp_get_max_threads();
 
   #ifdef USE_QUAD_PRECISION
     if( B->precision==LIS_PRECISION_DEFAULT )
     {
   #endif
       lis_vector_copy(B,X);
-      #pragma omp parallel private(i,j,jj,is,ie,my_rank)
+      #pragma omp parallel private(i,j,jj,is,ie,my_rank) num_threads(nprocs)
       {
         my_rank = omp_get_thread_num();
         LIS_GET_ISIE(my_rank,nprocs,n,is,ie);
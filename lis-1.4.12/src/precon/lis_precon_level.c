@@ -0,0 +1,419 @@
+/* Copyright (C) The Scalable Software Infrastructure Project. All rights reserved.
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+   1. Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+   3. Neither the name of the project nor the names of its contributors 
+      may be used to endorse or promote products derived from this software 
+      without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE SCALABLE SOFTWARE INFRASTRUCTURE PROJECT
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+   TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+   PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE SCALABLE SOFTWARE INFRASTRUCTURE
+   PROJECT BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+   OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifdef HAVE_CONFIG_H
+  #include "lis_config.h"
+#else
+#ifdef HAVE_CONFIG_WIN_H
+  #include "lis_config_win.h"
+#endif
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#ifdef HAVE_MALLOC_H
+        #include <malloc.h>
+#endif
+#include <string.h>
+#include <stdarg.h>
+#ifdef _OPENMP
+  #include <omp.h>
+#endif
+#ifdef USE_MPI
+  #include <mpi.h>
+#endif
+#include "lislib.h"
+
+/************************************************
+ * lis_precon_create_level
+ * lis_precon_update_level
+ * lis_matrix_level_destroy
+ * lis_psolve_level
+ ************************************************/
+
+/*
+ * The unit lower factor L and the upper factor (D^-1 + U) of ILU(k), ILUT
+ * and Crout ILU are copied row by row into one contiguous array per factor,
+ * with the rows grouped by level set.  Rows in a level only depend on rows
+ * in earlier levels, so a level is solved by all threads at once.
+ */
+
+/* levels narrower than this per thread are run by a single thread */
+#define LIS_LEVEL_MIN_ROWS  64
+
+#undef __FUNC__
+#define __FUNC__ "lis_matrix_level_create"
+static LIS_INT lis_matrix_level_create(LIS_MATRIX_ILU M, LIS_INT trans, LIS_VECTOR D, LIS_MATRIX_LEVEL *Mlev)
+{
+  LIS_INT        i,j,k,l,n,nnz,nlevel;
+  LIS_INT        *rptr,*rindex,*lev,*cnt;
+  LIS_SCALAR    *rvalue;
+  LIS_MATRIX_LEVEL  T;
+
+  LIS_DEBUG_FUNC_IN;
+
+  n      = M->n;
+  *Mlev  = NULL;
+  rindex = NULL;
+  rvalue = NULL;
+
+  nnz = 0;
+  for(i=0;i<n;i++) nnz += M->nnz[i];
+
+  T      = (LIS_MATRIX_LEVEL)lis_malloc(sizeof(struct LIS_MATRIX_LEVEL_STRUCT),"lis_matrix_level_create::T");
+  rptr   = (LIS_INT *)lis_malloc((n+1)*sizeof(LIS_INT),"lis_matrix_level_create::rptr");
+  lev    = (LIS_INT *)lis_malloc(n*sizeof(LIS_INT),"lis_matrix_level_create::lev");
+  cnt    = (LIS_INT *)lis_malloc((n+1)*sizeof(LIS_INT),"lis_matrix_level_create::cnt");
+  rindex = (LIS_INT *)lis_malloc((nnz+1)*sizeof(LIS_INT),"lis_matrix_level_create::rindex");
+  rvalue = (LIS_SCALAR *)lis_malloc((nnz+1)*sizeof(LIS_SCALAR),"lis_matrix_level_create::rvalue");
+  if( T==NULL || rptr==NULL || lev==NULL || cnt==NULL || rindex==NULL || rvalue==NULL )
+  {
+    LIS_SETERR_MEM((3*n+2*nnz)*sizeof(LIS_SCALAR));
+    lis_free2(6,T,rptr,lev,cnt,rindex,rvalue);
+    return LIS_OUT_OF_MEMORY;
+  }
+  memset(T,0,sizeof(struct LIS_MATRIX_LEVEL_STRUCT));
+  T->n     = n;
+  T->trans = trans;
+
+  /* row oriented copy in natural order, the Crout L is stored by columns */
+  for(i=0;i<=n;i++) rptr[i] = 0;
+  if( trans )
+  {
+    for(k=0;k<n;k++)
+    {
+      for(j=0;j<M->nnz[k];j++) rptr[M->index[k][j]+1]++;
+    }
+    for(i=0;i<n;i++)
+    {
+      rptr[i+1] += rptr[i];
+      cnt[i]     = rptr[i];
+    }
+    for(k=0;k<n;k++)
+    {
+      for(j=0;j<M->nnz[k];j++)
+      {
+        l         = cnt[M->index[k][j]]++;
+        rindex[l] = k;
+        rvalue[l] = M->value[k][j];
+      }
+    }
+  }
+  else
+  {
+    for(i=0;i<n;i++)
+    {
+      rptr[i+1] = rptr[i] + M->nnz[i];
+      for(j=0;j<M->nnz[i];j++)
+      {
+        rindex[rptr[i]+j] = M->index[i][j];
+        rvalue[rptr[i]+j] = M->value[i][j];
+      }
+    }
+  }
+
+  /* level of a row is one more than the deepest row it reads, D is only given for U */
+  nlevel = 0;
+  for(k=0;k<n;k++)
+  {
+    i = D==NULL ? k : n-1-k;
+    l = 0;
+    for(j=rptr[i];j<rptr[i+1];j++)
+    {
+      l = _max(l,lev[rindex[j]]+1);
+    }
+    lev[i] = l;
+    nlevel = _max(nlevel,l+1);
+  }
+
+  T->nlevel = nlevel;
+  T->level  = (LIS_INT *)lis_malloc((nlevel+1)*sizeof(LIS_INT),"lis_matrix_level_create::level");
+  T->row    = (LIS_INT *)lis_malloc((n+1)*sizeof(LIS_INT),"lis_matrix_level_create::row");
+  T->ptr    = (LIS_INT *)lis_malloc((n+1)*sizeof(LIS_INT),"lis_matrix_level_create::ptr");
+  T->index  = (LIS_INT *)lis_malloc((nnz+1)*sizeof(LIS_INT),"lis_matrix_level_create::index");
+  T->value  = (LIS_SCALAR *)lis_malloc((nnz+1)*sizeof(LIS_SCALAR),"lis_matrix_level_create::value");
+  if( D ) T->diag = (LIS_SCALAR *)lis_malloc((n+1)*sizeof(LIS_SCALAR),"lis_matrix_level_create::diag");
+  if( T->level==NULL || T->row==NULL || T->ptr==NULL || T->index==NULL || T->value==NULL || (D && T->diag==NULL) )
+  {
+    LIS_SETERR_MEM((3*n+2*nnz)*sizeof(LIS_SCALAR));
+    lis_free2(5,rptr,lev,cnt,rindex,rvalue);
+    lis_matrix_level_destroy(T);
+    return LIS_OUT_OF_MEMORY;
+  }
+
+  /* rows sorted by level, ascending inside a level */
+  for(k=0;k<=nlevel;k++) T->level[k] = 0;
+  for(i=0;i<n;i++) T->level[lev[i]+1]++;
+  for(k=0;k<nlevel;k++) T->level[k+1] += T->level[k];
+  for(k=0;k<nlevel;k++) cnt[k] = T->level[k];
+  for(i=0;i<n;i++) T->row[cnt[lev[i]]++] = i;
+
+  T->ptr[0] = 0;
+  for(k=0;k<n;k++)
+  {
+    i = T->row[k];
+    l = T->ptr[k];
+    for(j=rptr[i];j<rptr[i+1];j++)
+    {
+      T->index[l] = rindex[j];
+      T->value[l] = rvalue[j];
+      l++;
+    }
+    T->ptr[k+1] = l;
+    if( D ) T->diag[k] = D->value[i];
+  }
+
+  lis_free2(5,rptr,lev,cnt,rindex,rvalue);
+  *Mlev = T;
+
+  LIS_DEBUG_FUNC_OUT;
+  return LIS_SUCCESS;
+}
+
+#undef __FUNC__
+#define __FUNC__ "lis_matrix_level_update"
+static LIS_INT lis_matrix_level_update(LIS_MATRIX_ILU M, LIS_VECTOR D, LIS_MATRIX_LEVEL T)
+{
+  LIS_INT        i,j,k,n;
+  LIS_INT        *cnt;
+
+  LIS_DEBUG_FUNC_IN;
+
+  n = T->n;
+  if( T->trans )
+  {
+    cnt = (LIS_INT *)lis_malloc(n*sizeof(LIS_INT),"lis_matrix_level_update::cnt");
+    if( cnt==NULL )
+    {
+      LIS_SETERR_MEM(n*sizeof(LIS_INT));
+      return LIS_OUT_OF_MEMORY;
+    }
+    for(k=0;k<n;k++) cnt[T->row[k]] = T->ptr[k];
+    for(k=0;k<n;k++)
+    {
+      for(j=0;j<M->nnz[k];j++)
+      {
+        T->value[cnt[M->index[k][j]]++] = M->value[k][j];
+      }
+    }
+    lis_free(cnt);
+  }
+  else
+  {
+    #ifdef _OPENMP
+    #pragma omp parallel for private(i,j,k)
+    #endif
+    for(k=0;k<n;k++)
+    {
+      i = T->row[k];
+      for(j=0;j<M->nnz[i];j++)
+      {
+        T->value[T->ptr[k]+j] = M->value[i][j];
+      }
+    }
+  }
+  if( D )
+  {
+    for(k=0;k<n;k++) T->diag[k] = D->value[T->row[k]];
+  }
+
+  LIS_DEBUG_FUNC_OUT;
+  return LIS_SUCCESS;
+}
+
+#undef __FUNC__
+#define __FUNC__ "lis_precon_create_level"
+LIS_INT lis_precon_create_level(LIS_PRECON precon, LIS_INT ltrans)
+{
+  LIS_INT        err;
+
+  LIS_DEBUG_FUNC_IN;
+
+  lis_matrix_level_destroy(precon->Llev);
+  lis_matrix_level_destroy(precon->Ulev);
+  precon->Llev = NULL;
+  precon->Ulev = NULL;
+
+  err = lis_matrix_level_create(precon->L,ltrans,NULL,&precon->Llev);
+  if( err ) return err;
+  err = lis_matrix_level_create(precon->U,LIS_FALSE,precon->D,&precon->Ulev);
+  if( err ) return err;
+
+  LIS_DEBUG_FUNC_OUT;
+  return LIS_SUCCESS;
+}
+
+#undef __FUNC__
+#define __FUNC__ "lis_precon_update_level"
+LIS_INT lis_precon_update_level(LIS_PRECON precon)
+{
+  LIS_INT        err;
+
+  LIS_DEBUG_FUNC_IN;
+
+  err = lis_matrix_level_update(precon->L,NULL,precon->Llev);
+  if( err ) return err;
+  err = lis_matrix_level_update(precon->U,precon->D,precon->Ulev);
+  if( err ) return err;
+
+  LIS_DEBUG_FUNC_OUT;
+  return LIS_SUCCESS;
+}
+
+#undef __FUNC__
+#define __FUNC__ "lis_matrix_level_destroy"
+LIS_INT lis_matrix_level_destroy(LIS_MATRIX_LEVEL M)
+{
+  LIS_DEBUG_FUNC_IN;
+
+  if( M )
+  {
+    lis_free2(6,M->level,M->row,M->ptr,M->index,M->value,M->diag);
+    lis_free(M);
+  }
+
+  LIS_DEBUG_FUNC_OUT;
+  return LIS_SUCCESS;
+}
+
+#undef __FUNC__
+#define __FUNC__ "lis_psolve_level"
+LIS_INT lis_psolve_level(LIS_SOLVER solver, LIS_VECTOR B, LIS_VECTOR X)
+{
+  LIS_INT i,j,k,kk,p,nt;
+  LIS_INT nprocs,minrows;
+  LIS_SCALAR t;
+  LIS_SCALAR *b,*x;
+  LIS_MATRIX_LEVEL L,U;
+  LIS_PRECON  precon;
+
+  /*
+   *  LUx = b
+   *  L is unit lower, U holds the inverted pivots in diag
+   */
+
+  LIS_DEBUG_FUNC_IN;
+
+  precon = solver->precon;
+  L = precon->Llev;
+  U = precon->Ulev;
+  b = B->value;
+  x = X->value;
+  #ifdef _OPENMP
+    nprocs = omp_get_max_threads();
+  #else
+    nprocs = 1;
+  #endif
+  minrows = LIS_LEVEL_MIN_ROWS*nprocs;
+
+  #ifdef _OPENMP
+  #pragma omp parallel private(i,j,k,kk,p,nt,t)
+  #endif
+  {
+    /* forward substitution, a run of narrow levels is done by one thread */
+    for(k=0;k<L->nlevel;k=kk)
+    {
+      kk = k+1;
+      nt = L->level[kk] - L->level[k];
+      if( nt<minrows )
+      {
+        while( kk<L->nlevel && L->level[kk+1]-L->level[kk]<minrows ) kk++;
+        #ifdef _OPENMP
+        #pragma omp single
+        #endif
+        for(p=L->level[k];p<L->level[kk];p++)
+        {
+          i = L->row[p];
+          t = b[i];
+          for(j=L->ptr[p];j<L->ptr[p+1];j++)
+          {
+            t -= L->value[j] * x[L->index[j]];
+          }
+          x[i] = t;
+        }
+      }
+      else
+      {
+        #ifdef _OPENMP
+        #pragma omp for
+        #endif
+        for(p=L->level[k];p<L->level[kk];p++)
+        {
+          i = L->row[p];
+          t = b[i];
+          for(j=L->ptr[p];j<L->ptr[p+1];j++)
+          {
+            t -= L->value[j] * x[L->index[j]];
+          }
+          x[i] = t;
+        }
+      }
+    }
+
+    /* backward substitution */
+    for(k=0;k<U->nlevel;k=kk)
+    {
+      kk = k+1;
+      nt = U->level[kk] - U->level[k];
+      if( nt<minrows )
+      {
+        while( kk<U->nlevel && U->level[kk+1]-U->level[kk]<minrows ) kk++;
+        #ifdef _OPENMP
+        #pragma omp single
+        #endif
+        for(p=U->level[k];p<U->level[kk];p++)
+        {
+          i = U->row[p];
+          t = x[i];
+          for(j=U->ptr[p];j<U->ptr[p+1];j++)
+          {
+            t -= U->value[j] * x[U->index[j]];
+          }
+          x[i] = U->diag[p] * t;
+        }
+      }
+      else
+      {
+        #ifdef _OPENMP
+        #pragma omp for
+        #endif
+        for(p=U->level[k];p<U->level[kk];p++)
+        {
+          i = U->row[p];
+          t = x[i];
+          for(j=U->ptr[p];j<U->ptr[p+1];j++)
+          {
+            t -= U->value[j] * x[U->index[j]];
+          }
+          x[i] = U->diag[p] * t;
+        }
+      }
+    }
+  }
+
+  LIS_DEBUG_FUNC_OUT;
+  return LIS_SUCCESS;
+}
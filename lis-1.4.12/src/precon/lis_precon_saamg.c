@@ -49,6 +49,7 @@
 
 /************************************************
  * lis_precon_create
+ * lis_precon_refresh
  * lis_psolve
  * lis_psolvet
  ************************************************/
@@ -190,6 +191,24 @@ LIS_INT lis_precon_create_saamg(LIS_SOLVER solver, LIS_PRECON precon)
 #endif
 }
 
+#undef __FUNC__
+#define __FUNC__ "lis_precon_refresh_saamg"
+LIS_INT lis_precon_refresh_saamg(LIS_SOLVER solver, LIS_PRECON precon)
+{
+  LIS_DEBUG_FUNC_IN;
+
+  /*
+   * The aggregates, smoothed prolongators and Galerkin operators live in
+   * the Fortran hierarchy and cannot be updated separately, so the whole
+   * hierarchy is kept as a lagged preconditioner until lis_precon_reuse
+   * finds it stale and builds a new one.
+   */
+  precon->A = solver->A;
+
+  LIS_DEBUG_FUNC_OUT;
+  return LIS_SUCCESS;
+}
+
 #undef __FUNC__
 #define __FUNC__ "lis_psolve_saamg"
 LIS_INT lis_psolve_saamg(LIS_SOLVER solver, LIS_VECTOR b, LIS_VECTOR x)
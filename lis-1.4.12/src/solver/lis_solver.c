@@ -58,7 +58,7 @@
  * lis_solve
  ************************************************/
 
-#define LIS_SOLVERS_LEN      23
+#define LIS_SOLVERS_LEN      25
 #define LIS_PRECON_TYPE_LEN    12
 
 
@@ -71,7 +71,8 @@ LIS_SOLVER_CHECK_PARAMS lis_solver_check_params[] = {
   lis_bicgsafe_check_params , lis_cr_check_params        , lis_bicr_check_params,
   lis_crs_check_params      , lis_bicrstab_check_params  , lis_gpbicr_check_params,
   lis_bicrsafe_check_params , lis_fgmres_check_params    , lis_idrs_check_params,
-  lis_minres_check_params   , lis_idr1_check_params
+  lis_minres_check_params   , lis_idr1_check_params      , lis_pcg_check_params,
+  lis_cagmres_check_params
 };
 
 LIS_SOLVER_MALLOC_WORK lis_solver_malloc_work[] = {
@@ -83,7 +84,8 @@ LIS_SOLVER_MALLOC_WORK lis_solver_malloc_work[] = {
   lis_bicgsafe_malloc_work , lis_cr_malloc_work        , lis_bicr_malloc_work,
   lis_crs_malloc_work      , lis_bicrstab_malloc_work  , lis_gpbicr_malloc_work,
   lis_bicrsafe_malloc_work , lis_fgmres_malloc_work    , lis_idrs_malloc_work,
-  lis_minres_malloc_work   , lis_idr1_malloc_work
+  lis_minres_malloc_work   , lis_idr1_malloc_work      , lis_pcg_malloc_work,
+  lis_cagmres_malloc_work
 };
 
 LIS_SOLVER_EXECUTE lis_solver_execute[] = {
@@ -95,7 +97,8 @@ LIS_SOLVER_EXECUTE lis_solver_execute[] = {
   lis_bicgsafe , lis_cr        , lis_bicr,
   lis_crs      , lis_bicrstab  , lis_gpbicr,
   lis_bicrsafe , lis_fgmres    , lis_idrs, 
-  lis_minres   , lis_idr1
+  lis_minres   , lis_idr1      , lis_pcg,
+  lis_cagmres
 };
 
 #ifdef USE_QUAD_PRECISION
@@ -107,7 +110,9 @@ LIS_SOLVER_EXECUTE lis_solver_execute[] = {
     NULL              , NULL               , NULL,
     lis_bicgsafe_quad , lis_cr_quad        , lis_bicr_quad,
     lis_crs_quad      , lis_bicrstab_quad  , lis_gpbicr_quad,
-    lis_bicrsafe_quad , lis_fgmres_quad    , NULL
+    lis_bicrsafe_quad , lis_fgmres_quad    , NULL,
+    NULL              , NULL               , NULL,
+    NULL
   };
   LIS_SOLVER_EXECUTE lis_solver_execute_switch[] = {
     NULL,
@@ -117,7 +122,9 @@ LIS_SOLVER_EXECUTE lis_solver_execute[] = {
     NULL                , NULL            , NULL,
     NULL                , NULL            , NULL,
     NULL                , NULL            , NULL,
-    NULL                , NULL            , NULL
+    NULL                , NULL            , NULL,
+    NULL                , NULL            , NULL,
+    NULL
   };
   /*
   LIS_SOLVER_EXECUTE lis_solver_execute_periodic[] = {
@@ -141,12 +148,12 @@ LIS_INT LIS_USE_AT_TYPE[] = {
   0,
   LIS_MATRIX_CSC,LIS_MATRIX_CSR
   };
-#define LIS_SOLVER_OPTION_LEN  46
+#define LIS_SOLVER_OPTION_LEN  50
 #define LIS_PRINT_LEN      4
 #define LIS_SCALE_LEN      3
 #define LIS_TRUEFALSE_LEN    2
 #define LIS_PRECISION_LEN    3
-#define LIS_STORAGE_LEN      11
+#define LIS_STORAGE_LEN      12
 #define LIS_CONV_COND_LEN    3
 
 char *LIS_SOLVER_OPTNAME[] = {
@@ -158,7 +165,8 @@ char *LIS_SOLVER_OPTNAME[] = {
   "-f",                 "-h",             "-ver",            "-hybrid_p",      "-initx_zeros",
   "-adds",              "-adds_iter",     "-f",              "-use_at",        "-switch_tol",
   "-switch_maxiter",    "-saamg_unsym",   "-iluc_drop",      "-iluc_gamma",    "-iluc_rate",
-  "-storage",           "-storage_block", "-conv_cond",      "-tol_w",         "-saamg_theta",  "-irestart"
+  "-storage",           "-storage_block", "-conv_cond",      "-tol_w",         "-saamg_theta",  "-irestart",
+  "-precon_reuse",      "-precon_reuse_ratio", "-ilu_levelset", "-cagmres_s"
 };
 
 LIS_INT LIS_SOLVER_OPTACT[] = {
@@ -170,24 +178,25 @@ LIS_INT LIS_SOLVER_OPTACT[] = {
   LIS_OPTIONS_FILE             , LIS_OPTIONS_HELP          , LIS_OPTIONS_VER           , LIS_OPTIONS_PPRECON      , LIS_OPTIONS_INITGUESS_ZEROS,
   LIS_OPTIONS_ADDS             , LIS_OPTIONS_ADDS_ITER     , LIS_OPTIONS_PRECISION     , LIS_OPTIONS_USE_AT       , LIS_PARAMS_SWITCH_RESID,
   LIS_OPTIONS_SWITCH_MAXITER   , LIS_OPTIONS_SAAMG_UNSYM   , LIS_PARAMS_DROP           , LIS_PARAMS_GAMMA         , LIS_PARAMS_RATE, 
-  LIS_OPTIONS_STORAGE          , LIS_OPTIONS_STORAGE_BLOCK , LIS_OPTIONS_CONV_COND     , LIS_PARAMS_RESID_WEIGHT  , LIS_PARAMS_SAAMG_THETA, LIS_OPTIONS_IDRS_RESTART
+  LIS_OPTIONS_STORAGE          , LIS_OPTIONS_STORAGE_BLOCK , LIS_OPTIONS_CONV_COND     , LIS_PARAMS_RESID_WEIGHT  , LIS_PARAMS_SAAMG_THETA, LIS_OPTIONS_IDRS_RESTART,
+  LIS_OPTIONS_PRECON_REUSE     , LIS_PARAMS_PRECON_REUSE_RATIO, LIS_OPTIONS_ILU_LEVELSET, LIS_OPTIONS_CAGMRES_S
 };
 
-char *lis_solver_atoi[]    = {"cg", "bicg", "cgs", "bicgstab", "bicgstabl", "gpbicg", "tfqmr","orthomin", "gmres", "jacobi", "gs", "sor", "bicgsafe", "cr", "bicr", "crs", "bicrstab", "gpbicr", "bicrsafe", "fgmres", "idrs", "minres", "idr1"};
+char *lis_solver_atoi[]    = {"cg", "bicg", "cgs", "bicgstab", "bicgstabl", "gpbicg", "tfqmr","orthomin", "gmres", "jacobi", "gs", "sor", "bicgsafe", "cr", "bicr", "crs", "bicrstab", "gpbicr", "bicrsafe", "fgmres", "idrs", "minres", "idr1", "pcg", "cagmres"};
 char *lis_precon_atoi[]    = {"none", "jacobi", "ilu", "ssor", "hybrid", "is", "sainv", "saamg", "iluc", "ilut", "bjacobi", ""};
-char *lis_storage_atoi[]   = {"csr", "csc", "msr", "dia", "ell", "jad", "bsr", "bsc", "vbr", "coo", "dns"};
+char *lis_storage_atoi[]   = {"csr", "csc", "msr", "dia", "ell", "jad", "bsr", "bsc", "vbr", "coo", "dns", "sell"};
 char *lis_print_atoi[]     = {"none", "mem", "out", "all"};
 char *lis_scale_atoi[]     = {"none", "jacobi", "symm_diag"};
 char *lis_truefalse_atoi[] = {"false", "true"};
 char *lis_precision_atoi[] = {"double", "quad", "switch"};
 char *lis_conv_cond_atoi[] = {"nrm2_r", "nrm2_b", "nrm1_b"};
 
-char *lis_solvername[] = {"", "CG", "BiCG", "CGS", "BiCGSTAB", "BiCGSTAB(l)", "GPBiCG", "TFQMR", "Orthomin", "GMRES", "Jacobi",  "Gauss-Seidel", "SOR", "BiCGSafe", "CR", "BiCR", "CRS", "BiCRSTAB", "GPBiCR", "BiCRSafe", "FGMRES", "IDR(s)", "MINRES", "IDR(1)"};
+char *lis_solvername[] = {"", "CG", "BiCG", "CGS", "BiCGSTAB", "BiCGSTAB(l)", "GPBiCG", "TFQMR", "Orthomin", "GMRES", "Jacobi",  "Gauss-Seidel", "SOR", "BiCGSafe", "CR", "BiCR", "CRS", "BiCRSTAB", "GPBiCR", "BiCRSafe", "FGMRES", "IDR(s)", "MINRES", "IDR(1)", "Pipelined CG", "CA-GMRES"};
 char *lis_preconname[] = {"none", "Jacobi", "ILU", "SSOR", "Hybrid", "I+S", "SAINV", "SAAMG", "Crout ILU", "ILUT", "Block Jacobi"};
 
 char *lis_returncode[] = {"LIS_SUCCESS", "LIS_ILL_OPTION", "LIS_BREAKDOWN", "LIS_OUT_OF_MEMORY", "LIS_MAXITER", "LIS_NOT_IMPLEMENTED", "LIS_ERR_FILE_IO"};
 char *lis_precisionname[] = {"double", "quad", "switch"};
-char *lis_storagename[]   = {"CSR", "CSC", "MSR", "DIA", "ELL", "JAD", "BSR", "BSC", "VBR", "COO", "DNS"};
+char *lis_storagename[]   = {"CSR", "CSC", "MSR", "DIA", "ELL", "JAD", "BSR", "BSC", "VBR", "COO", "DNS", "TJAD", "BJAD", "BCR", "CJAD", "PCSR", "LCSR", "LJAD", "LBSR", "CDIA", "MSC", "SELL"};
 
 LIS_VECTOR lis_solver_residual_history = NULL;
 
@@ -207,6 +216,9 @@ LIS_INT lis_solver_init(LIS_SOLVER solver)
   solver->residual = NULL;
   solver->precon   = NULL;
 
+  solver->reuse_precon = NULL;
+  solver->reuse_iter   = 0;
+
   solver->worklen   = 0;
   solver->iter      = 0;
   solver->iter2     = 0;
@@ -243,6 +255,9 @@ LIS_INT lis_solver_init(LIS_SOLVER solver)
   solver->options[LIS_OPTIONS_CONV_COND]            = 0;
   solver->options[LIS_OPTIONS_INIT_SHADOW_RESID]    = LIS_RESID;
   solver->options[LIS_OPTIONS_IDRS_RESTART]         = 2;
+  solver->options[LIS_OPTIONS_PRECON_REUSE]         = LIS_FALSE;
+  solver->options[LIS_OPTIONS_ILU_LEVELSET]         = LIS_FALSE;
+  solver->options[LIS_OPTIONS_CAGMRES_S]            = 2;
 
   solver->params[LIS_PARAMS_RESID        -LIS_OPTIONS_LEN] = 1.0e-12;
   solver->params[LIS_PARAMS_RESID_WEIGHT -LIS_OPTIONS_LEN] = 1.0;
@@ -259,6 +274,7 @@ LIS_INT lis_solver_init(LIS_SOLVER solver)
   solver->params[LIS_PARAMS_SWITCH_RESID -LIS_OPTIONS_LEN] = 1.0e-12;
   solver->params[LIS_PARAMS_RATE         -LIS_OPTIONS_LEN] = 5.0;
   solver->params[LIS_PARAMS_SAAMG_THETA  -LIS_OPTIONS_LEN] = 0.05;
+  solver->params[LIS_PARAMS_PRECON_REUSE_RATIO-LIS_OPTIONS_LEN] = 2.0;
 
   LIS_DEBUG_FUNC_OUT;
   return LIS_SUCCESS;
@@ -313,6 +329,7 @@ LIS_INT lis_solver_destroy(LIS_SOLVER solver)
   if( solver )
   {
     lis_solver_work_destroy(solver);
+    lis_precon_destroy(solver->reuse_precon);
     lis_vector_destroy(solver->d);
     if( solver->At ) lis_matrix_destroy(solver->At);
     if( solver->residual ) lis_free(solver->residual);
@@ -343,7 +360,16 @@ LIS_INT lis_solve(LIS_MATRIX A, LIS_VECTOR b, LIS_VECTOR x, LIS_SOLVER solver)
     return LIS_ERR_ILL_ARG;
   }
 
-  err = lis_precon_create(solver, &precon);
+  if( solver->options[LIS_OPTIONS_PRECON_REUSE] )
+  {
+    err = lis_precon_reuse(solver, &precon);
+  }
+  else
+  {
+    lis_precon_destroy(solver->reuse_precon);
+    solver->reuse_precon = NULL;
+    err = lis_precon_create(solver, &precon);
+  }
   if( err )
   {
     lis_solver_work_destroy(solver);
@@ -354,7 +380,15 @@ LIS_INT lis_solve(LIS_MATRIX A, LIS_VECTOR b, LIS_VECTOR x, LIS_SOLVER solver)
   /* Core Kernel of lis_solve() */
   lis_solve_kernel(A, b, x, solver, precon);
 
-  lis_precon_destroy(precon);
+  if( solver->options[LIS_OPTIONS_PRECON_REUSE] )
+  {
+    /* iteration count of the first solve with a freshly built preconditioner */
+    if( solver->reuse_iter==0 ) solver->reuse_iter = _max(solver->iter,1);
+  }
+  else
+  {
+    lis_precon_destroy(precon);
+  }
 
   LIS_DEBUG_FUNC_OUT;
   return LIS_SUCCESS;
@@ -1102,6 +1136,12 @@ LIS_INT lis_solver_set_option2(char* arg1, char *arg2, LIS_SOLVER solver)
       case LIS_OPTIONS_USE_AT:
         lis_solver_set_option_truefalse(arg2,LIS_OPTIONS_USE_AT,solver);
         break;
+      case LIS_OPTIONS_PRECON_REUSE:
+        lis_solver_set_option_truefalse(arg2,LIS_OPTIONS_PRECON_REUSE,solver);
+        break;
+      case LIS_OPTIONS_ILU_LEVELSET:
+        lis_solver_set_option_truefalse(arg2,LIS_OPTIONS_ILU_LEVELSET,solver);
+        break;
       case LIS_OPTIONS_SAAMG_UNSYM:
         lis_solver_set_option_truefalse(arg2,LIS_OPTIONS_SAAMG_UNSYM,solver);
         if (solver->options[LIS_OPTIONS_SAAMG_UNSYM])
@@ -1430,7 +1470,7 @@ LIS_INT lis_solver_set_option_storage(char *argv, LIS_SOLVER solver)
     {
       if( strcmp(argv,lis_storage_atoi[i])==0 )
       {
-        solver->options[LIS_OPTIONS_STORAGE] = i+1;
+        solver->options[LIS_OPTIONS_STORAGE] = i<LIS_MATRIX_DNS ? i+1 : LIS_MATRIX_SELL;
         break;
       }
     }
@@ -0,0 +1,570 @@
+/* Copyright (C) The Scalable Software Infrastructure Project. All rights reserved.
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+   1. Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+   3. Neither the name of the project nor the names of its contributors 
+      may be used to endorse or promote products derived from this software 
+      without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE SCALABLE SOFTWARE INFRASTRUCTURE PROJECT
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+   TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+   PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE SCALABLE SOFTWARE INFRASTRUCTURE
+   PROJECT BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+   OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifdef HAVE_CONFIG_H
+  #include "lis_config.h"
+#else
+#ifdef HAVE_CONFIG_WIN_H
+  #include "lis_config_win.h"
+#endif
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#ifdef HAVE_MALLOC_H
+        #include <malloc.h>
+#endif
+#include <string.h>
+#include <stdarg.h>
+#include <math.h>
+#ifdef _OPENMP
+  #include <omp.h>
+#endif
+#ifdef USE_MPI
+  #include <mpi.h>
+#endif
+#include "lislib.h"
+
+/***************************************
+ * CA-GMRES(m)                         *
+ ***************************************
+ r(0)    = b - Ax(0)
+ v(0)    = r(0) / ||r(0)||_2
+ ***************************************
+ for j=0,s,2s,... while j<m
+   v(j+i)     = A * M^-1 * v(j+i-1), i=1,...,s
+   W          = (v(j+1),...,v(j+s))
+   C          = (v(0),...,v(j))^T * W
+   R^T * R    = W^T * W - C^T * C
+   W          = (W - (v(0),...,v(j)) * C) * R^-1
+   H(:,j:j+s-1) is obtained from C, R and H(:,0:j-1)
+   Givens rotations and convergence check
+   for each new column of H
+ ***************************************
+ C and W^T * W are computed in one sweep
+ and reduced once per block of s vectors.
+ s is given by -cagmres_s (default 2,
+ at most 16). The monomial basis is used,
+ so the block is truncated when R^T * R
+ loses too much accuracy; a block of one
+ vector is orthogonalized again.
+ ***************************************/
+
+#define NWORK                4
+#define LIS_CAGMRES_SMAX     16
+#define LIS_CAGMRES_TRUNC    1.0e-8
+#undef __FUNC__
+#define __FUNC__ "lis_cagmres_check_params"
+LIS_INT lis_cagmres_check_params(LIS_SOLVER solver)
+{
+  LIS_INT restart,s;
+
+  LIS_DEBUG_FUNC_IN;
+
+  restart = solver->options[LIS_OPTIONS_RESTART];
+  if( restart<1 )
+  {
+    LIS_SETERR1(LIS_ERR_ILL_ARG,"Parameter LIS_OPTIONS_RESTART(=%d) is less than 1\n",restart);
+    return LIS_ERR_ILL_ARG;
+  }
+  s = solver->options[LIS_OPTIONS_CAGMRES_S];
+  if( s<1 || s>LIS_CAGMRES_SMAX )
+  {
+    LIS_SETERR2(LIS_ERR_ILL_ARG,"Parameter LIS_OPTIONS_CAGMRES_S(=%d) is not between 1 and %d\n",s,LIS_CAGMRES_SMAX);
+    return LIS_ERR_ILL_ARG;
+  }
+
+  LIS_DEBUG_FUNC_OUT;
+  return LIS_SUCCESS;
+}
+
+#undef __FUNC__
+#define __FUNC__ "lis_cagmres_malloc_work"
+LIS_INT lis_cagmres_malloc_work(LIS_SOLVER solver)
+{
+  LIS_VECTOR  *work;
+  LIS_INT      i,j,restart,worklen,err;
+
+  LIS_DEBUG_FUNC_IN;
+
+  restart = solver->options[LIS_OPTIONS_RESTART];
+  worklen = NWORK + (restart+1);
+  work    = (LIS_VECTOR *)lis_malloc( worklen*sizeof(LIS_VECTOR),"lis_cagmres_malloc_work::work" );
+  if( work==NULL )
+  {
+    LIS_SETERR_MEM(worklen*sizeof(LIS_VECTOR));
+    return LIS_ERR_OUT_OF_MEMORY;
+  }
+  for(i=1;i<worklen;i++)
+  {
+    err = lis_vector_duplicate(solver->A,&work[i]);
+    if( err ) break;
+  }
+  if( i<worklen )
+  {
+    for(j=1;j<i;j++) lis_vector_destroy(work[j]);
+    lis_free(work);
+    return err;
+  }
+  lis_vector_create(solver->A->comm,&work[0]);
+  lis_vector_set_size(work[0],restart+1,0);
+  solver->worklen = worklen;
+  solver->work    = work;
+
+  LIS_DEBUG_FUNC_OUT;
+  return LIS_SUCCESS;
+}
+
+/*****************************************
+ * W = (v(nq),...,v(nq+t-1))             *
+ * g(k*t+j)      = <v(k),W(j)>, k<nq     *
+ * g(nq*t+i*t+j) = <W(i),W(j)>, i<=j     *
+ *****************************************/
+#undef __FUNC__
+#define __FUNC__ "lis_cagmres_gram"
+static void lis_cagmres_gram(LIS_INT n, LIS_INT nq, LIS_INT t, LIS_SCALAR **vp, LIS_SCALAR *acc, LIS_INT stride, LIS_SCALAR *g)
+{
+  LIS_INT i,j,k,l,nval;
+  LIS_SCALAR *c,qk;
+  LIS_SCALAR wl[LIS_CAGMRES_SMAX];
+  #ifdef _OPENMP
+    LIS_INT nprocs,my_rank;
+    LIS_SCALAR *a;
+  #endif
+
+  nval = nq*t + t*t;
+  #ifdef _OPENMP
+    nprocs = omp_get_max_threads();
+    #pragma omp parallel private(i,j,k,l,a,c,qk,wl,my_rank)
+    {
+      my_rank = omp_get_thread_num();
+      a       = &acc[my_rank*stride];
+      for(k=0;k<nval;k++) a[k] = 0.0;
+      #pragma omp for
+      for(l=0;l<n;l++)
+      {
+        for(j=0;j<t;j++) wl[j] = vp[nq+j][l];
+        c = a;
+        for(k=0;k<nq;k++)
+        {
+          qk = vp[k][l];
+          for(j=0;j<t;j++) c[j] += qk*wl[j];
+          c += t;
+        }
+        for(i=0;i<t;i++)
+        {
+          for(j=i;j<t;j++) c[i*t+j] += wl[i]*wl[j];
+        }
+      }
+    }
+    for(k=0;k<nval;k++) g[k] = 0.0;
+    for(i=0;i<nprocs;i++)
+    {
+      for(k=0;k<nval;k++) g[k] += acc[i*stride+k];
+    }
+  #else
+    for(k=0;k<nval;k++) g[k] = 0.0;
+    for(l=0;l<n;l++)
+    {
+      for(j=0;j<t;j++) wl[j] = vp[nq+j][l];
+      c = g;
+      for(k=0;k<nq;k++)
+      {
+        qk = vp[k][l];
+        for(j=0;j<t;j++) c[j] += qk*wl[j];
+        c += t;
+      }
+      for(i=0;i<t;i++)
+      {
+        for(j=i;j<t;j++) c[i*t+j] += wl[i]*wl[j];
+      }
+    }
+  #endif
+}
+
+/*****************************************
+ * W(j) = (W(j) - sum_k c(k*ld+j)v(k)    *
+ *        - sum_i<j r(i*ld+j)W(i))*d(j)  *
+ *****************************************/
+#undef __FUNC__
+#define __FUNC__ "lis_cagmres_orth"
+static void lis_cagmres_orth(LIS_INT n, LIS_INT nq, LIS_INT t, LIS_INT ld, LIS_SCALAR **vp, LIS_SCALAR *c, LIS_SCALAR *r, LIS_SCALAR *d)
+{
+  LIS_INT i,j,k,l;
+  LIS_SCALAR tmp;
+
+  #ifdef _OPENMP
+  #pragma omp parallel for private(i,j,k,l,tmp)
+  #endif
+  for(l=0;l<n;l++)
+  {
+    for(j=0;j<t;j++)
+    {
+      tmp = vp[nq+j][l];
+      for(k=0;k<nq;k++) tmp -= c[k*ld+j]*vp[k][l];
+      for(i=0;i<j;i++)  tmp -= r[i*ld+j]*vp[nq+i][l];
+      vp[nq+j][l] = tmp*d[j];
+    }
+  }
+}
+
+/*****************************************
+ * z = sum_j<k y(j)v(j)                  *
+ *****************************************/
+#undef __FUNC__
+#define __FUNC__ "lis_cagmres_lincomb"
+static void lis_cagmres_lincomb(LIS_INT n, LIS_INT k, LIS_SCALAR **vp, LIS_SCALAR *y, LIS_SCALAR *z)
+{
+  LIS_INT j,l;
+  LIS_SCALAR tmp;
+
+  #ifdef _OPENMP
+  #pragma omp parallel for private(j,l,tmp)
+  #endif
+  for(l=0;l<n;l++)
+  {
+    tmp = 0.0;
+    for(j=0;j<k;j++) tmp += y[j]*vp[j][l];
+    z[l] = tmp;
+  }
+}
+
+#undef __FUNC__
+#define __FUNC__ "lis_cagmres"
+LIS_INT lis_cagmres(LIS_SOLVER solver)
+{
+  LIS_MATRIX A;
+  LIS_VECTOR x;
+  LIS_VECTOR r,s,z,*v;
+  LIS_SCALAR **vp;
+  LIS_SCALAR *h,*hr,*g,*c,*gram,*rf,*cacc,*xcol,*acc;
+  LIS_SCALAR aa,bb,rr,a2,b2,t,d;
+  LIS_SCALAR rinv[LIS_CAGMRES_SMAX];
+
+  LIS_REAL   bnrm2, nrm2, tol;
+  LIS_INT iter,maxiter,n,output;
+  double times,ptimes;
+
+  LIS_REAL   rnorm;
+  LIS_INT i,j,k,m,sb,nt,nb,nq,jc,col,cl,pass,happy;
+  LIS_INT ii,i1,iih,jj;
+  LIS_INT h_dim,nvalmax,stride,nprocs,wsize;
+  LIS_INT cs,sn;
+  #ifdef USE_MPI
+    LIS_SCALAR *gl;
+    MPI_Comm   comm;
+  #endif
+
+  LIS_DEBUG_FUNC_IN;
+
+  A       = solver->A;
+  x       = solver->x;
+  n       = A->n;
+  maxiter = solver->options[LIS_OPTIONS_MAXITER];
+  output  = solver->options[LIS_OPTIONS_OUTPUT];
+  m       = solver->options[LIS_OPTIONS_RESTART];
+  sb      = solver->options[LIS_OPTIONS_CAGMRES_S];
+  h_dim   = m+1;
+  ptimes  = 0.0;
+  nrm2    = 0.0;
+  #ifdef USE_MPI
+    comm  = A->comm;
+  #endif
+  #ifdef _OPENMP
+    nprocs = omp_get_max_threads();
+  #else
+    nprocs = 0;
+  #endif
+
+  s       = solver->work[0];
+  r       = solver->work[1];
+  z       = solver->work[2];
+  v       = &solver->work[3];
+
+  nvalmax = h_dim*sb + sb*sb;
+  stride  = nvalmax + LIS_VEC_TMP_PADD;
+  wsize   = (h_dim+1)*(h_dim+2) + h_dim*h_dim + 2*nvalmax + sb*sb + h_dim*sb + h_dim+1 + nprocs*stride;
+  h       = (LIS_SCALAR *)lis_malloc( sizeof(LIS_SCALAR) * wsize,"lis_cagmres::h" );
+  vp      = (LIS_SCALAR **)lis_malloc( sizeof(LIS_SCALAR *) * (h_dim+1),"lis_cagmres::vp" );
+  if( h==NULL || vp==NULL )
+  {
+    LIS_SETERR_MEM(sizeof(LIS_SCALAR) * wsize);
+    lis_free2(2,h,vp);
+    return LIS_ERR_OUT_OF_MEMORY;
+  }
+  hr      = h    + (h_dim+1)*(h_dim+2);
+  g       = hr   + h_dim*h_dim;
+  rf      = g    + 2*nvalmax;
+  cacc    = rf   + sb*sb;
+  xcol    = cacc + h_dim*sb;
+  acc     = xcol + h_dim+1;
+  #ifdef USE_MPI
+    gl    = g    + nvalmax;
+  #endif
+  cs      = (m+1)*h_dim;
+  sn      = (m+2)*h_dim;
+  for(k=0;k<=m;k++) vp[k] = v[k]->value;
+
+
+  /* Initial Residual */
+  if( lis_solver_get_initial_residual(solver,NULL,NULL,v[0],&bnrm2) )
+  {
+    lis_free2(2,h,vp);
+    LIS_DEBUG_FUNC_OUT;
+    return LIS_SUCCESS;
+  }
+  tol     = solver->tol;
+
+
+  iter=0;
+  while( iter<maxiter )
+  {
+    /* first column of V */
+    /* v = r / ||r||_2 */
+    lis_vector_nrm2(v[0],&rnorm);
+    lis_vector_scale(1.0/rnorm,v[0]);
+
+    /* s = ||r||_2 e_1 */
+    lis_vector_set_all(0,s);
+    s->value[0] = rnorm;
+
+    col   = 0;
+    happy = 0;
+    do
+    {
+      nq = col+1;
+      nt = sb;
+      if( nt>m-col ) nt = m-col;
+      if( nt>maxiter-iter ) nt = maxiter-iter;
+
+      /* v[col+i] = A * M^-1 * v[col+i-1] */
+      for(i=1;i<=nt;i++)
+      {
+        times = lis_wtime();
+        lis_psolve(solver, v[col+i-1], z);
+        ptimes += lis_wtime()-times;
+
+        LIS_MATVEC(A,z,v[col+i]);
+      }
+
+      /* C = V^T * W, W = W - V * C, twice */
+      /* R^T * R = W^T * W - C^T * C       */
+      for(k=0;k<nq*nt;k++) cacc[k] = 0.0;
+      for(pass=0;;pass++)
+      {
+        #ifdef USE_MPI
+          lis_cagmres_gram(n,nq,nt,vp,acc,stride,gl);
+          MPI_Allreduce(gl,g,nq*nt+nt*nt,MPI_DOUBLE,MPI_SUM,comm);
+        #else
+          lis_cagmres_gram(n,nq,nt,vp,acc,stride,g);
+        #endif
+        c    = g;
+        gram = g + nq*nt;
+        d    = 0.0;
+        if( pass>0 )
+        {
+          for(j=0;j<nt;j++)
+          {
+            for(i=0;i<j;i++)
+            {
+              t = gram[i*nt+j];
+              for(k=0;k<nq;k++) t -= c[k*nt+i]*c[k*nt+j];
+              for(k=0;k<i;k++)  t -= rf[k*nt+i]*rf[k*nt+j];
+              rf[i*nt+j] = t / rf[i*nt+i];
+            }
+            d = gram[j*nt+j];
+            for(k=0;k<nq;k++) d -= c[k*nt+j]*c[k*nt+j];
+            for(k=0;k<j;k++)  d -= rf[k*nt+j]*rf[k*nt+j];
+            if( d<=LIS_CAGMRES_TRUNC*gram[j*nt+j] ) break;
+            rf[j*nt+j] = sqrt(d);
+          }
+          if( j>0 || pass==3 ) break;
+
+          /* v[col+1] is nearly in span(V): keep only */
+          /* it and project it out once more          */
+          for(k=0;k<nq;k++)
+          {
+            c[k]    = c[k*nt];
+            cacc[k] = cacc[k*nt];
+          }
+          nt = 1;
+        }
+
+        /* W = W - V * C */
+        for(k=0;k<nq*nt;k++) cacc[k] += c[k];
+        for(k=0;k<nt*nt;k++) rf[k] = 0.0;
+        for(j=0;j<nt;j++)    rinv[j] = 1.0;
+        lis_cagmres_orth(n,nq,nt,nt,vp,c,rf,rinv);
+      }
+      nb = j;
+      if( nb==0 )
+      {
+        /* breakdown: A * M^-1 * v[col] is in span(V) */
+        rf[0] = d>0.0 ? sqrt(d) : 0.0;
+        nb    = 1;
+        happy = 1;
+      }
+      for(j=0;j<nb;j++)
+      {
+        rinv[j] = rf[j*nt+j]!=0.0 ? 1.0/rf[j*nt+j] : 1.0;
+      }
+      lis_cagmres_orth(n,nq,nb,nt,vp,c,rf,rinv);
+      for(k=0;k<nq*nt;k++) c[k] += cacc[k];
+
+      for(jc=0;jc<nb;jc++)
+      {
+        iter++;
+        cl  = col+jc;
+        ii  = cl;
+        i1  = cl+1;
+        iih = cl*h_dim;
+
+        /* H(:,cl) = ((C;R)(:,jc) - H(:,0:col-1)*C(0:col-1,jc-1) */
+        /*            - H(:,col:cl-1)*T(0:jc-1,jc)) / T(jc,jc)    */
+        for(k=0;k<nq;k++)  xcol[k]    = c[k*nt+jc];
+        for(k=0;k<=jc;k++) xcol[nq+k] = rf[k*nt+jc];
+        if( jc>0 )
+        {
+          for(j=0;j<col;j++)
+          {
+            t = c[j*nt+jc-1];
+            for(k=0;k<=j+1;k++) xcol[k] -= hr[k + j*h_dim]*t;
+          }
+          for(j=0;j<jc;j++)
+          {
+            t = j==0 ? c[col*nt+jc-1] : rf[(j-1)*nt+jc-1];
+            for(k=0;k<=col+j+1;k++) xcol[k] -= hr[k + (col+j)*h_dim]*t;
+          }
+          t = rf[(jc-1)*nt+jc-1];
+          for(k=0;k<=i1;k++) xcol[k] /= t;
+        }
+        for(k=0;k<=i1;k++)
+        {
+          hr[k + iih] = xcol[k];
+          h[k + iih]  = xcol[k];
+        }
+
+        for(k=1;k<=ii;k++)
+        {
+          jj  = k-1;
+          t   =  h[jj + iih];
+          aa  =  h[jj + cs]*t;
+          aa +=  h[jj + sn]*h[k  + iih];
+          bb  = -h[jj + sn]*t;
+          bb +=  h[jj + cs]*h[k  + iih];
+          h[jj + iih] = aa;
+          h[k  + iih] = bb;
+        }
+        aa = h[ii + iih];
+        bb = h[i1 + iih];
+        a2 = aa*aa;
+        b2 = bb*bb;
+        rr = sqrt(a2 + b2);
+        if( rr==0.0 ) rr=1.0e-17;
+        h[ii + cs] = aa / rr;
+        h[ii + sn] = bb / rr;
+        s->value[i1] = -h[ii + sn]*s->value[ii];
+        s->value[ii] =  h[ii + cs]*s->value[ii];
+
+        aa  =  h[ii + cs]*h[ii + iih];
+        aa +=  h[ii + sn]*h[i1 + iih];
+        h[ii   + iih] = aa;
+
+        /* convergence check */
+        nrm2 = fabs(s->value[i1]) * bnrm2;
+
+        if( output )
+        {
+          if( output & LIS_PRINT_MEM ) solver->residual[iter] = nrm2;
+          if( output & LIS_PRINT_OUT && A->my_rank==0 ) lis_print_rhistory(iter,nrm2);
+        }
+
+        if( tol >= nrm2 ) break;
+      }
+      if( jc<nb )
+      {
+        col += jc+1;
+        break;
+      }
+      col += nb;
+    } while( col<m && iter<maxiter && !happy );
+
+    /* Solve H*Y =S for upper triangular H */
+    ii = col-1;
+    i  = col;
+    i1 = col;
+    iih = ii*h_dim;
+    s->value[ii] = s->value[ii] / h[ii + iih];
+    for(k=1;k<=ii;k++)
+    {
+      jj = ii-k;
+      t  = s->value[jj];
+      for(j=jj+1;j<=ii;j++)
+      {
+        t -= h[jj + j*h_dim]*s->value[j];
+      }
+      s->value[jj] = t / h[jj + jj*h_dim];
+    }
+    /* z = yv */
+    lis_cagmres_lincomb(n,col,vp,s->value,z->value);
+
+    /* r = M^-1 z */
+    times = lis_wtime();
+    lis_psolve(solver, z, r);
+    ptimes += lis_wtime()-times;
+
+    /* x = x + r */
+    lis_vector_axpy(1,r,x);
+
+    if( tol >= nrm2 )
+    {
+      solver->retcode    = LIS_SUCCESS;
+      solver->iter       = iter;
+      solver->resid      = nrm2;
+      solver->ptimes     = ptimes;
+      lis_free2(2,h,vp);
+      LIS_DEBUG_FUNC_OUT;
+      return LIS_SUCCESS;
+    }
+
+    for(j=1;j<=i;j++)
+    {
+      jj = i1-j+1;
+      s->value[jj-1] = -h[jj-1 + sn] * s->value[jj];
+      s->value[jj]   =  h[jj-1 + cs] * s->value[jj];
+    }
+
+    /* v[0] = sum s_j v[j] */
+    lis_cagmres_lincomb(n,i1+1,vp,s->value,vp[0]);
+  }
+
+  solver->retcode   = LIS_MAXITER;
+  solver->iter      = iter+1;
+  solver->resid     = nrm2;
+  lis_free2(2,h,vp);
+  LIS_DEBUG_FUNC_OUT;
+  return LIS_MAXITER;
+}
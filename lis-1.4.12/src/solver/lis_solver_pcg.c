@@ -0,0 +1,395 @@
+/* Copyright (C) The Scalable Software Infrastructure Project. All rights reserved.
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+   1. Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+   3. Neither the name of the project nor the names of its contributors 
+      may be used to endorse or promote products derived from this software 
+      without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE SCALABLE SOFTWARE INFRASTRUCTURE PROJECT
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+   TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+   PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE SCALABLE SOFTWARE INFRASTRUCTURE
+   PROJECT BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+   OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifdef HAVE_CONFIG_H
+  #include "lis_config.h"
+#else
+#ifdef HAVE_CONFIG_WIN_H
+  #include "lis_config_win.h"
+#endif
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#ifdef HAVE_MALLOC_H
+        #include <malloc.h>
+#endif
+#include <string.h>
+#include <stdarg.h>
+#include <math.h>
+#ifdef _OPENMP
+  #include <omp.h>
+#endif
+#ifdef USE_MPI
+  #include <mpi.h>
+#endif
+#include "lislib.h"
+
+/***************************************
+ * Pipelined Conjugate Gradient        *
+ ***************************************
+ r(0)    = b - Ax(0)
+ u(0)    = M^-1 * r(0)
+ w(0)    = A * u(0)
+ ***************************************
+ for k=0,1,...
+   gamma(k)  = <r(k),u(k)>
+   delta     = <w(k),u(k)>
+   m(k)      = M^-1 * w(k)
+   n(k)      = A * m(k)
+   if k>0
+     beta    = gamma(k) / gamma(k-1)
+     alpha   = gamma(k) / (delta - beta*gamma(k)/alpha(k-1))
+   else
+     beta    = 0
+     alpha   = gamma(k) / delta
+   z(k)      = n(k) + beta*z(k-1)
+   q(k)      = m(k) + beta*q(k-1)
+   s(k)      = w(k) + beta*s(k-1)
+   p(k)      = u(k) + beta*p(k-1)
+   x(k+1)    = x(k) + alpha*p(k)
+   r(k+1)    = r(k) - alpha*s(k)
+   u(k+1)    = u(k) - alpha*q(k)
+   w(k+1)    = w(k) - alpha*z(k)
+ ***************************************
+ gamma, delta and the residual norm are
+ accumulated in the same sweep as the
+ vector updates and reduced once per
+ iteration. With MPI-3 the reduction is
+ started before m(k) and n(k) are
+ computed and completed after them.
+ ***************************************/
+
+#define NWORK        9
+#undef __FUNC__
+#define __FUNC__ "lis_pcg_check_params"
+LIS_INT lis_pcg_check_params(LIS_SOLVER solver)
+{
+  LIS_DEBUG_FUNC_IN;
+  LIS_DEBUG_FUNC_OUT;
+  return LIS_SUCCESS;
+}
+
+#undef __FUNC__
+#define __FUNC__ "lis_pcg_malloc_work"
+LIS_INT lis_pcg_malloc_work(LIS_SOLVER solver)
+{
+  LIS_VECTOR  *work;
+  LIS_INT      i,j,worklen,err;
+
+  LIS_DEBUG_FUNC_IN;
+
+  worklen = NWORK;
+  work    = (LIS_VECTOR *)lis_malloc( worklen*sizeof(LIS_VECTOR),"lis_pcg_malloc_work::work" );
+  if( work==NULL )
+  {
+    LIS_SETERR_MEM(worklen*sizeof(LIS_VECTOR));
+    return LIS_ERR_OUT_OF_MEMORY;
+  }
+  for(i=0;i<worklen;i++)
+  {
+    err = lis_vector_duplicate(solver->A,&work[i]);
+    if( err ) break;
+  }
+  if( i<worklen )
+  {
+    for(j=0;j<i;j++) lis_vector_destroy(work[j]);
+    lis_free(work);
+    return err;
+  }
+  solver->worklen = worklen;
+  solver->work    = work;
+
+  LIS_DEBUG_FUNC_OUT;
+  return LIS_SUCCESS;
+}
+
+/*****************************************
+ * z = n + beta*z    q = m + beta*q      *
+ * s = w + beta*s    p = u + beta*p      *
+ * x = x + alpha*p   r = r - alpha*s     *
+ * u = u - alpha*q   w = w - alpha*z     *
+ * val = <r,u>, <w,u>, <r,r>, ||r||_1    *
+ *****************************************/
+#undef __FUNC__
+#define __FUNC__ "lis_pcg_update"
+static void lis_pcg_update(LIS_INT n, LIS_SCALAR alpha, LIS_SCALAR beta, LIS_VECTOR *v, LIS_SCALAR *val)
+{
+  LIS_INT i;
+  LIS_SCALAR *x,*r,*u,*w,*m,*nn,*z,*q,*s,*p;
+  LIS_SCALAR t0,t1,t2,t3;
+  #ifdef _OPENMP
+    LIS_INT k,nprocs,my_rank;
+  #endif
+
+  x  = v[0]->value;
+  r  = v[1]->value;
+  u  = v[2]->value;
+  w  = v[3]->value;
+  m  = v[4]->value;
+  nn = v[5]->value;
+  z  = v[6]->value;
+  q  = v[7]->value;
+  s  = v[8]->value;
+  p  = v[9]->value;
+
+  #ifdef _OPENMP
+    nprocs = omp_get_max_threads();
+    #pragma omp parallel private(i,t0,t1,t2,t3,my_rank)
+    {
+      my_rank = omp_get_thread_num();
+      t0 = t1 = t2 = t3 = 0.0;
+      #pragma omp for
+      for(i=0;i<n;i++)
+      {
+        z[i]  = nn[i] + beta*z[i];
+        q[i]  = m[i]  + beta*q[i];
+        s[i]  = w[i]  + beta*s[i];
+        p[i]  = u[i]  + beta*p[i];
+        x[i] += alpha*p[i];
+        r[i] -= alpha*s[i];
+        u[i] -= alpha*q[i];
+        w[i] -= alpha*z[i];
+        t0   += r[i]*u[i];
+        t1   += w[i]*u[i];
+        t2   += r[i]*r[i];
+        t3   += fabs(r[i]);
+      }
+      lis_vec_tmp[my_rank*LIS_VEC_TMP_PADD  ] = t0;
+      lis_vec_tmp[my_rank*LIS_VEC_TMP_PADD+1] = t1;
+      lis_vec_tmp[my_rank*LIS_VEC_TMP_PADD+2] = t2;
+      lis_vec_tmp[my_rank*LIS_VEC_TMP_PADD+3] = t3;
+    }
+    val[0] = val[1] = val[2] = val[3] = 0.0;
+    for(i=0;i<nprocs;i++)
+    {
+      for(k=0;k<4;k++)
+      {
+        val[k] += lis_vec_tmp[i*LIS_VEC_TMP_PADD+k];
+      }
+    }
+  #else
+    t0 = t1 = t2 = t3 = 0.0;
+    for(i=0;i<n;i++)
+    {
+      z[i]  = nn[i] + beta*z[i];
+      q[i]  = m[i]  + beta*q[i];
+      s[i]  = w[i]  + beta*s[i];
+      p[i]  = u[i]  + beta*p[i];
+      x[i] += alpha*p[i];
+      r[i] -= alpha*s[i];
+      u[i] -= alpha*q[i];
+      w[i] -= alpha*z[i];
+      t0   += r[i]*u[i];
+      t1   += w[i]*u[i];
+      t2   += r[i]*r[i];
+      t3   += fabs(r[i]);
+    }
+    val[0] = t0;
+    val[1] = t1;
+    val[2] = t2;
+    val[3] = t3;
+  #endif
+}
+
+#undef __FUNC__
+#define __FUNC__ "lis_pcg"
+LIS_INT lis_pcg(LIS_SOLVER solver)
+{
+  LIS_MATRIX A;
+  LIS_VECTOR x;
+  LIS_VECTOR r,u,w,m,nn,z,q,s,p;
+  LIS_VECTOR v[10];
+  LIS_SCALAR alpha, beta, gamma, gamma_old, delta;
+  LIS_SCALAR dots[4];
+  LIS_REAL   bnrm2, nrm2, tol;
+  LIS_INT iter,maxiter,n,output,conv;
+  double times,ptimes;
+  #ifdef USE_MPI
+    LIS_SCALAR ldots[4];
+    MPI_Comm   comm;
+    #if MPI_VERSION>=3
+      MPI_Request req;
+    #endif
+  #endif
+
+  LIS_DEBUG_FUNC_IN;
+
+  A       = solver->A;
+  x       = solver->x;
+  n       = A->n;
+  maxiter = solver->options[LIS_OPTIONS_MAXITER];
+  output  = solver->options[LIS_OPTIONS_OUTPUT];
+  conv    = solver->options[LIS_OPTIONS_CONV_COND];
+  ptimes  = 0.0;
+  #ifdef USE_MPI
+    comm  = A->comm;
+  #endif
+
+  r       = solver->work[0];
+  u       = solver->work[1];
+  w       = solver->work[2];
+  m       = solver->work[3];
+  nn      = solver->work[4];
+  z       = solver->work[5];
+  q       = solver->work[6];
+  s       = solver->work[7];
+  p       = solver->work[8];
+  v[0] = x; v[1] = r; v[2] = u; v[3] = w; v[4] = m;
+  v[5] = nn; v[6] = z; v[7] = q; v[8] = s; v[9] = p;
+  alpha     = (LIS_SCALAR)0.0;
+  gamma_old = (LIS_SCALAR)1.0;
+
+
+  if( lis_solver_get_initial_residual(solver,NULL,NULL,r,&bnrm2) )
+  {
+    LIS_DEBUG_FUNC_OUT;
+    return LIS_SUCCESS;
+  }
+  tol     = solver->tol;
+
+  /* u = M^-1 * r */
+  times = lis_wtime();
+  lis_psolve(solver,r,u);
+  ptimes += lis_wtime() - times;
+
+  /* w = Au */
+  LIS_MATVEC(A,u,w);
+
+  /* with alpha=beta=0 this only sets s=w, p=u and */
+  /* computes <r,u>, <w,u> and ||r||               */
+  lis_vector_set_all(0.0,m);
+  lis_vector_set_all(0.0,nn);
+  lis_vector_set_all(0.0,z);
+  lis_vector_set_all(0.0,q);
+  lis_vector_set_all(0.0,s);
+  lis_vector_set_all(0.0,p);
+  #ifdef USE_MPI
+    lis_pcg_update(n,0.0,0.0,v,ldots);
+    #if MPI_VERSION>=3
+      MPI_Iallreduce(ldots,dots,4,MPI_DOUBLE,MPI_SUM,comm,&req);
+    #else
+      MPI_Allreduce(ldots,dots,4,MPI_DOUBLE,MPI_SUM,comm);
+    #endif
+  #else
+    lis_pcg_update(n,0.0,0.0,v,dots);
+  #endif
+
+  iter = 0;
+  for(;;)
+  {
+    /* m and n are computed while the reduction is pending. */
+    /* They are wasted on the iteration that converges.     */
+    if( iter<maxiter )
+    {
+      /* m = M^-1 * w */
+      times = lis_wtime();
+      lis_psolve(solver,w,m);
+      ptimes += lis_wtime() - times;
+
+      /* n = Am */
+      LIS_MATVEC(A,m,nn);
+    }
+    #if defined(USE_MPI) && MPI_VERSION>=3
+      MPI_Wait(&req,MPI_STATUS_IGNORE);
+    #endif
+
+    /* convergence check */
+    if( conv==LIS_CONV_COND_NRM1_B )
+    {
+      nrm2 = dots[3];
+    }
+    else
+    {
+      nrm2 = sqrt(dots[2]) * bnrm2;
+    }
+    if( iter>0 )
+    {
+      if( output )
+      {
+        if( output & LIS_PRINT_MEM ) solver->residual[iter] = nrm2;
+        if( output & LIS_PRINT_OUT && A->my_rank==0 ) lis_print_rhistory(iter,nrm2);
+      }
+
+      if( tol >= nrm2 )
+      {
+        solver->retcode    = LIS_SUCCESS;
+        solver->iter       = iter;
+        solver->resid      = nrm2;
+        solver->ptimes     = ptimes;
+        LIS_DEBUG_FUNC_OUT;
+        return LIS_SUCCESS;
+      }
+    }
+    if( iter==maxiter ) break;
+    iter++;
+
+    /* gamma = <r,u>, delta = <w,u> */
+    gamma = dots[0];
+    delta = dots[1];
+
+    /* beta  = gamma / gamma_old                      */
+    /* alpha = gamma / (delta - beta*gamma/alpha_old) */
+    if( iter>1 )
+    {
+      beta  = gamma / gamma_old;
+      delta = delta - beta*gamma/alpha;
+    }
+    else
+    {
+      beta  = 0.0;
+    }
+
+    /* breakdown check */
+    if( delta==0.0 )
+    {
+      solver->retcode   = LIS_BREAKDOWN;
+      solver->iter      = iter;
+      solver->resid     = nrm2;
+      LIS_DEBUG_FUNC_OUT;
+      return LIS_BREAKDOWN;
+    }
+    alpha = gamma / delta;
+
+    #ifdef USE_MPI
+      lis_pcg_update(n,alpha,beta,v,ldots);
+      #if MPI_VERSION>=3
+        MPI_Iallreduce(ldots,dots,4,MPI_DOUBLE,MPI_SUM,comm,&req);
+      #else
+        MPI_Allreduce(ldots,dots,4,MPI_DOUBLE,MPI_SUM,comm);
+      #endif
+    #else
+      lis_pcg_update(n,alpha,beta,v,dots);
+    #endif
+    gamma_old = gamma;
+  }
+
+  solver->retcode   = LIS_MAXITER;
+  solver->iter      = iter+1;
+  solver->resid     = nrm2;
+  LIS_DEBUG_FUNC_OUT;
+  return LIS_MAXITER;
+}
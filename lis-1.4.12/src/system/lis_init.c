@@ -77,14 +77,15 @@ LIS_SCALAR  *lis_vec_tmp = NULL;
   extern void lis_mpi_msum(LIS_QUAD *invec, LIS_QUAD *inoutvec, LIS_INT *len, MPI_Datatype *datatype);
 #endif
 
-#define LIS_INIT_OPTIONS_LEN  1
+#define LIS_INIT_OPTIONS_LEN  2
 #define LIS_INIT_OPTIONS_OMPNUMTHREADS    1
+#define LIS_INIT_OPTIONS_MALLOCPOOL       2
 
 char *LIS_INIT_OPTNAME[] = {
-  "-omp_num_threads"
+  "-omp_num_threads", "-malloc_pool"
 };
 LIS_INT LIS_INIT_OPTACT[] = {
-  LIS_INIT_OPTIONS_OMPNUMTHREADS
+  LIS_INIT_OPTIONS_OMPNUMTHREADS, LIS_INIT_OPTIONS_MALLOCPOOL
 };
 
 
@@ -110,6 +111,7 @@ LIS_INT lis_initialize(LIS_INT* argc, char** argv[])
 {
   LIS_ARGS  p;
   LIS_INT    i,nprocs;
+  unsigned long pool = 0;
 
   LIS_DEBUG_FUNC_IN;
 
@@ -147,6 +149,14 @@ LIS_INT lis_initialize(LIS_INT* argc, char** argv[])
           sscanf(p->arg2, "%d", &nprocs);
 #endif
           break;
+        case LIS_INIT_OPTIONS_MALLOCPOOL:
+          if( sscanf(p->arg2, "%lu", &pool)!=1 )
+          {
+            LIS_SETERR1(LIS_ERR_ILL_ARG,"Option -malloc_pool (=%s) is not a size in bytes\n",p->arg2);
+            return LIS_ERR_ILL_ARG;
+          }
+          lis_malloc_pool((size_t)pool);
+          break;
         }
       }
     }
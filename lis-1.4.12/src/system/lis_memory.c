@@ -51,40 +51,70 @@
  * lis_free2
  * lis_free_all
  * lis_is_malloc
- * lis_free2
- * lis_is_malloc
+ * lis_malloc_pool
  ************************************************/
 
 #ifdef _DEBUG
   #define USE_MALLOC_TAG  1
 #endif
 
-#if 1
+/*
+ * Every block returned by lis_malloc is preceded by its malloc_address
+ * record, and the records are kept in a hash table keyed by the returned
+ * address. The table is split into LIS_MALLOC_SHARDS shards with a lock
+ * each, so lookups are O(1) and threads rarely contend. The records of
+ * one shard are chained through next, and the buckets grow with the
+ * number of records.
+ *
+ * Freed blocks of at least LIS_MALLOC_POOL_MIN bytes can be kept in a
+ * pool, sorted into power-of-two size classes, and handed out again by
+ * lis_malloc. The pool is off until lis_malloc_pool sets its size.
+ */
+
+#define LIS_MALLOC_ALIGN        16
+#define LIS_MALLOC_SHARDS       64
+#define LIS_MALLOC_BUCKETS      64
+#define LIS_MALLOC_POOL_MIN     4096
+#define LIS_MALLOC_POOL_CLASSES (8*sizeof(size_t))
+
+#if defined(__GNUC__)
+  typedef int malloc_lock;
+  #define LIS_MALLOC_LOCK(l)    while( __atomic_exchange_n(&(l),1,__ATOMIC_ACQUIRE) ) { while( __atomic_load_n(&(l),__ATOMIC_RELAXED) ) ; }
+  #define LIS_MALLOC_UNLOCK(l)  __atomic_store_n(&(l),0,__ATOMIC_RELEASE)
+#elif defined(_MSC_VER)
+  #include <intrin.h>
+  typedef volatile long malloc_lock;
+  #define LIS_MALLOC_LOCK(l)    while( _InterlockedExchange(&(l),1) ) { while( l ) ; }
+  #define LIS_MALLOC_UNLOCK(l)  _InterlockedExchange(&(l),0)
+#else
+  typedef int malloc_lock;
+  #define LIS_MALLOC_LOCK(l)
+  #define LIS_MALLOC_UNLOCK(l)
+#endif
+
 typedef struct _malloc_address {
-  struct _malloc_address *next, *prev;
-  void *address, *real_address;
-  size_t size;
+  struct _malloc_address *next;
+  void *address;
+  size_t size, capacity;
   #ifdef USE_MALLOC_TAG
     char *tag;
   #endif
 } malloc_address;
 
-malloc_address malloc_address_top = 
-  {&malloc_address_top, &malloc_address_top, NULL, NULL};
-#else
-#define MALLOC_ADDRESS_SIZE  1021
+typedef struct _malloc_shard {
+  malloc_lock lock;
+  malloc_address **bucket;
+  size_t nbuckets, count;
+} malloc_shard;
 
-typedef struct _malloc_address {
-  struct _malloc_address *next, *prev;
-  void *address, *real_address;
-  size_t size;
-} malloc_address;
+#define LIS_MALLOC_HEADER \
+  ((sizeof(malloc_address)+LIS_MALLOC_ALIGN-1) & ~(size_t)(LIS_MALLOC_ALIGN-1))
 
-malloc_address malloc_address_top = 
-  {&malloc_address_top, &malloc_address_top, NULL, NULL};
+static malloc_shard malloc_shards[LIS_MALLOC_SHARDS];
 
-malloc_address *malloc_address_table;
-#endif
+static malloc_lock malloc_pool_lock = 0;
+static malloc_address *malloc_pool_list[LIS_MALLOC_POOL_CLASSES];
+static size_t malloc_pool_size = 0, malloc_pool_used = 0;
 
 /*
 void *malloc ();
@@ -97,121 +127,226 @@ void *rpl_malloc( size_t n )
 }
 */
 
-void *lis_malloc( size_t size, char *tag )
+static size_t lis_malloc_hash( void *p )
+{
+  size_t h;
+
+  h  = ((size_t)p / LIS_MALLOC_ALIGN) * (size_t)0x9e3779b97f4a7c15ULL;
+  h ^= h >> 17;
+  return h;
+}
+
+static LIS_INT lis_malloc_class( size_t size )
+{
+  LIS_INT c;
+
+  c = 0;
+  while( size>>=1 ) c++;
+  return c;
+}
+
+/* the shard lock must be held */
+static void lis_malloc_rehash( malloc_shard *sh )
+{
+  malloc_address **bucket, *ma, *next;
+  size_t i, j, nbuckets;
+
+  nbuckets = sh->nbuckets ? 2*sh->nbuckets : LIS_MALLOC_BUCKETS;
+  bucket = (malloc_address **)calloc(nbuckets,sizeof(malloc_address *));
+  if( bucket==NULL ) return;
+  for(i=0;i<sh->nbuckets;i++)
+  {
+    for(ma=sh->bucket[i];ma;ma=next)
+    {
+      next = ma->next;
+      j = (lis_malloc_hash(ma->address) / LIS_MALLOC_SHARDS) & (nbuckets-1);
+      ma->next = bucket[j];
+      bucket[j] = ma;
+    }
+  }
+  free(sh->bucket);
+  sh->bucket   = bucket;
+  sh->nbuckets = nbuckets;
+}
+
+static LIS_INT lis_malloc_insert( malloc_address *ma )
+{
+  malloc_shard *sh;
+  size_t h, j;
+
+  h  = lis_malloc_hash(ma->address);
+  sh = &malloc_shards[h % LIS_MALLOC_SHARDS];
+  LIS_MALLOC_LOCK(sh->lock);
+  if( sh->count>=sh->nbuckets ) lis_malloc_rehash(sh);
+  if( sh->nbuckets==0 )
+  {
+    LIS_MALLOC_UNLOCK(sh->lock);
+    return LIS_FALSE;
+  }
+  j = (h / LIS_MALLOC_SHARDS) & (sh->nbuckets-1);
+  ma->next = sh->bucket[j];
+  sh->bucket[j] = ma;
+  sh->count++;
+  LIS_MALLOC_UNLOCK(sh->lock);
+  return LIS_TRUE;
+}
+
+/* looks up p and unlinks its record if remove is set */
+static malloc_address *lis_malloc_find( void *p, LIS_INT remove )
+{
+  malloc_shard *sh;
+  malloc_address **pma, *ma;
+  size_t h;
+
+  h  = lis_malloc_hash(p);
+  sh = &malloc_shards[h % LIS_MALLOC_SHARDS];
+  LIS_MALLOC_LOCK(sh->lock);
+  ma = NULL;
+  if( sh->nbuckets )
+  {
+    pma = &sh->bucket[(h / LIS_MALLOC_SHARDS) & (sh->nbuckets-1)];
+    while( *pma && (*pma)->address!=p ) pma = &(*pma)->next;
+    ma = *pma;
+    if( ma && remove )
+    {
+      *pma = ma->next;
+      sh->count--;
+    }
+  }
+  LIS_MALLOC_UNLOCK(sh->lock);
+  return ma;
+}
+
+static malloc_address *lis_malloc_block( size_t size )
 {
   union {
     void *ptr;
-    unsigned long l;
+    size_t l;
   } addr;
-  malloc_address *ma;
-  LIS_INT sz;
-
-  addr.ptr = malloc(size + 16);
-  ma = (malloc_address *)malloc(sizeof(malloc_address));
-  ma->next = &malloc_address_top;
-  ma->prev = malloc_address_top.prev;
-  ma->prev->next = ma;
-  ma->next->prev = ma;
-  ma->real_address = addr.ptr;
-  ma->size = size;
-  addr.l += 0xf;
-  addr.l &= ~0xf;
-  ma->address = addr.ptr;
+  malloc_address *ma, **pma;
+  LIS_INT c;
+
+  if( malloc_pool_size && size>=LIS_MALLOC_POOL_MIN )
+  {
+    c  = lis_malloc_class(size);
+    ma = NULL;
+    LIS_MALLOC_LOCK(malloc_pool_lock);
+    pma = &malloc_pool_list[c];
+    while( *pma && (*pma)->capacity<size ) pma = &(*pma)->next;
+    if( *pma )
+    {
+      ma   = *pma;
+      *pma = ma->next;
+      malloc_pool_used -= ma->capacity;
+    }
+    LIS_MALLOC_UNLOCK(malloc_pool_lock);
+    if( ma ) return ma;
+  }
+
+  addr.ptr = malloc(LIS_MALLOC_HEADER + size + LIS_MALLOC_ALIGN);
+  if( addr.ptr==NULL ) return NULL;
+  ma = (malloc_address *)addr.ptr;
+  addr.l += LIS_MALLOC_HEADER + LIS_MALLOC_ALIGN-1;
+  addr.l &= ~(size_t)(LIS_MALLOC_ALIGN-1);
+  ma->address  = addr.ptr;
+  ma->capacity = size;
+  return ma;
+}
+
+static void lis_malloc_release( malloc_address *ma )
+{
+  LIS_INT c;
 
   #ifdef USE_MALLOC_TAG
-    sz = (LIS_INT)strlen(tag);
-    ma->tag = (char *)malloc(sz+1);
-    strcpy(ma->tag,tag);
+    free(ma->tag);
   #endif
- 
-  return addr.ptr;
+  if( malloc_pool_size && ma->capacity>=LIS_MALLOC_POOL_MIN )
+  {
+    c = lis_malloc_class(ma->capacity);
+    LIS_MALLOC_LOCK(malloc_pool_lock);
+    if( malloc_pool_used + ma->capacity<=malloc_pool_size )
+    {
+      ma->next = malloc_pool_list[c];
+      malloc_pool_list[c] = ma;
+      malloc_pool_used += ma->capacity;
+      ma = NULL;
+    }
+    LIS_MALLOC_UNLOCK(malloc_pool_lock);
+    if( ma==NULL ) return;
+  }
+  free(ma);
 }
 
-void *lis_calloc( size_t size, char *tag )
+void *lis_malloc( size_t size, char *tag )
 {
-  union {
-    void *ptr;
-    unsigned long l;
-  } addr;
   malloc_address *ma;
-  LIS_INT sz;
-
-  addr.ptr = malloc(size + 16);
-  ma = (malloc_address *)malloc(sizeof(malloc_address));
-  ma->next = &malloc_address_top;
-  ma->prev = malloc_address_top.prev;
-  ma->prev->next = ma;
-  ma->next->prev = ma;
-  ma->real_address = addr.ptr;
+
+  ma = lis_malloc_block(size);
+  if( ma==NULL ) return NULL;
   ma->size = size;
-  addr.l += 0xf;
-  addr.l &= ~0xf;
-  ma->address = addr.ptr;
-  memset(addr.ptr,0,size);
 
   #ifdef USE_MALLOC_TAG
-    sz = (LIS_INT)strlen(tag);
-    ma->tag = (char *)malloc(sz+1);
-    strcpy(ma->tag,tag);
+    ma->tag = (char *)malloc(strlen(tag)+1);
+    if( ma->tag ) strcpy(ma->tag,tag);
   #endif
 
-  return addr.ptr;
+  if( !lis_malloc_insert(ma) )
+  {
+    lis_malloc_release(ma);
+    return NULL;
+  }
+  return ma->address;
+}
+
+void *lis_calloc( size_t size, char *tag )
+{
+  void *p;
+
+  p = lis_malloc(size,tag);
+  if( p ) memset(p,0,size);
+  return p;
 }
 
 void *lis_realloc( void *p, size_t size )
 {
-  union {
-    void *ptr;
-    unsigned long l;
-  } addr;
-  malloc_address *ma;
-  size_t old_size;
-  void *real_address,*address;
+  malloc_address *ma, *mb;
 
-  ma = malloc_address_top.next;
-  while (ma->address)
+  ma = lis_malloc_find(p,LIS_FALSE);
+  if( ma )
   {
-      if (ma->address == p) break;
-    ma = ma->next;
-  }
-  if (ma->address)
-  {
-    old_size       = ma->size;
-    addr.ptr       = malloc(size + 16);
-    real_address   = addr.ptr;
-    addr.l        += 0xf;
-    addr.l        &= ~0xf;
-    address        = addr.ptr;
-
-    memcpy(address,p,old_size);
-    free(ma->real_address);
-
-    ma->address      = address;
-    ma->real_address = real_address;
-    ma->size         = size;
-    return address;
+    if( size<=ma->capacity )
+    {
+      ma->size = size;
+      return p;
+    }
+    mb = lis_malloc_block(size);
+    if( mb==NULL ) return NULL;
+    mb->size = size;
+    memcpy(mb->address,p,ma->size);
+    #ifdef USE_MALLOC_TAG
+      mb->tag = ma->tag;
+      ma->tag = NULL;
+    #endif
+    if( !lis_malloc_insert(mb) )
+    {
+      lis_malloc_release(mb);
+      return NULL;
+    }
+    lis_malloc_find(p,LIS_TRUE);
+    lis_malloc_release(ma);
+    return mb->address;
   }
-  address = realloc(p,size);
-  return address;
+  return realloc(p,size);
 }
 
 void lis_free(void *p)
 {
   malloc_address *ma;
 
-  ma = malloc_address_top.next;
-  while (ma->address) {
-    if (ma->address == p) break;
-    ma = ma->next;
-  }
-  if (ma->address) {
-    ma->next->prev = ma->prev;
-    ma->prev->next = ma->next;
-    free(ma->real_address);
-#ifdef USE_MALLOC_TAG
-    free(ma->tag);
-#endif
-    free(ma); 
+  ma = lis_malloc_find(p,LIS_TRUE);
+  if( ma )
+  {
+    lis_malloc_release(ma);
     return;
   }
   free(p);
@@ -221,43 +356,15 @@ void lis_free(void *p)
 void lis_free_mat(LIS_MATRIX A)
 {
   malloc_address *ma;
-  malloc_address *ma_bak;
   LIS_INT i;
 
-  ma = malloc_address_top.next;
   for(i=0;i<A->n;i++)
   {
     if( A->w_index[i]==NULL ) continue;
-    while (ma->address) {
-      if (ma->address == A->w_index[i]) break;
-      ma = ma->next;
-    }
-    if (ma->address) {
-      ma->next->prev = ma->prev;
-      ma->prev->next = ma->next;
-      ma_bak         = ma->next;
-      free(ma->real_address);
-      #ifdef USE_MALLOC_TAG
-        free(ma->tag);
-      #endif
-      free(ma);
-      ma = ma_bak;
-    }
-    while (ma->address) {
-      if (ma->address == A->w_value[i]) break;
-      ma = ma->next;
-    }
-    if (ma->address) {
-      ma->next->prev = ma->prev;
-      ma->prev->next = ma->next;
-      ma_bak         = ma->next;
-      free(ma->real_address);
-      #ifdef USE_MALLOC_TAG
-        free(ma->tag);
-      #endif
-      free(ma);
-      ma = ma_bak;
-    }
+    ma = lis_malloc_find(A->w_index[i],LIS_TRUE);
+    if( ma ) lis_malloc_release(ma);
+    ma = lis_malloc_find(A->w_value[i],LIS_TRUE);
+    if( ma ) lis_malloc_release(ma);
   }
   return;
 }
@@ -280,46 +387,83 @@ void lis_free2(LIS_INT n, ...)
   va_end(vvlist);
 }
 
+/* Forgets all allocations without freeing them, and empties the pool. */
 void lis_free_all()
 {
+  malloc_shard *sh;
   malloc_address *ma;
   malloc_address *ma_bak;
+  size_t i, j;
 
-  ma = malloc_address_top.next;
-    while (ma->address) {
-  #ifdef USE_MALLOC_TAG
-    lis_printf(LIS_COMM_WORLD,"memory leak: address = %x size=%d (%s)\n",ma->address,ma->size,ma->tag);
-  #endif
-    ma_bak = ma->next;
-    /*          if (ma->real_address) free(ma->real_address); */
-  ma->real_address = NULL;
-  #ifdef USE_MALLOC_TAG
-    if (ma->tag) lis_free(ma->tag);
-    ma->tag = NULL;
-  #endif
-  ma = ma_bak;
+  for(i=0;i<LIS_MALLOC_SHARDS;i++)
+  {
+    sh = &malloc_shards[i];
+    LIS_MALLOC_LOCK(sh->lock);
+    for(j=0;j<sh->nbuckets;j++)
+    {
+      for(ma=sh->bucket[j];ma;ma=ma_bak)
+      {
+        ma_bak = ma->next;
+        #ifdef USE_MALLOC_TAG
+          lis_printf(LIS_COMM_WORLD,"memory leak: address = %p size=%lu (%s)\n",ma->address,(unsigned long)ma->size,ma->tag ? ma->tag : "");
+          free(ma->tag);
+          ma->tag = NULL;
+        #endif
+      }
+    }
+    free(sh->bucket);
+    sh->bucket   = NULL;
+    sh->nbuckets = 0;
+    sh->count    = 0;
+    LIS_MALLOC_UNLOCK(sh->lock);
+  }
+
+  LIS_MALLOC_LOCK(malloc_pool_lock);
+  for(i=0;i<LIS_MALLOC_POOL_CLASSES;i++)
+  {
+    for(ma=malloc_pool_list[i];ma;ma=ma_bak)
+    {
+      ma_bak = ma->next;
+      free(ma);
+    }
+    malloc_pool_list[i] = NULL;
   }
-  malloc_address_top.next         = &malloc_address_top;
-  malloc_address_top.prev         = &malloc_address_top;
-  malloc_address_top.address      = NULL;
-  malloc_address_top.real_address = NULL;
-  malloc_address_top.size         = 0;
+  malloc_pool_used = 0;
+  LIS_MALLOC_UNLOCK(malloc_pool_lock);
   return;
 }
 
 LIS_INT lis_is_malloc( void *p )
 {
-  malloc_address *ma;
-
-  ma = malloc_address_top.next;
-  while (ma->address)
-  {
-      if (ma->address == p) break;
-    ma = ma->next;
-  }
-  if (ma->address)
+  if( p && lis_malloc_find(p,LIS_FALSE) )
   {
     return LIS_TRUE;
   }
   return LIS_FALSE;
 }
+
+/* Sets the number of bytes the pool may hold. 0 turns the pool off. */
+LIS_INT lis_malloc_pool( size_t size )
+{
+  malloc_address *ma;
+  malloc_address *ma_bak;
+  size_t i;
+
+  LIS_MALLOC_LOCK(malloc_pool_lock);
+  malloc_pool_size = size;
+  if( malloc_pool_used>size )
+  {
+    for(i=0;i<LIS_MALLOC_POOL_CLASSES;i++)
+    {
+      for(ma=malloc_pool_list[i];ma;ma=ma_bak)
+      {
+        ma_bak = ma->next;
+        free(ma);
+      }
+      malloc_pool_list[i] = NULL;
+    }
+    malloc_pool_used = 0;
+  }
+  LIS_MALLOC_UNLOCK(malloc_pool_lock);
+  return LIS_SUCCESS;
+}
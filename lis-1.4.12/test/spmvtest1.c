@@ -43,7 +43,7 @@
 #endif
 #include "lislib.h"
 
-char *lis_storagename2[]   = {"CSR", "CSC", "MSR", "DIA", "ELL", "JAD", "BSR", "BSC", "VBR", "COO", "DNS"};
+char *lis_storagename2[]   = {"CSR", "CSC", "MSR", "DIA", "ELL", "JAD", "BSR", "BSC", "VBR", "COO", "DNS", "TJAD", "BJAD", "BCR", "CJAD", "PCSR", "LCSR", "LJAD", "LBSR", "CDIA", "MSC", "SELL"};
 
 #undef __FUNC__
 #define __FUNC__ "main"
@@ -119,12 +119,12 @@ LIS_INT main(LIS_INT argc, char* argv[])
 #endif
       CHKERR(1);
     }
-  if( s<0 || s>11 )
+  if( s<0 || (s>11 && s!=LIS_MATRIX_SELL) )
     {
 #ifdef _LONGLONG
-      if( my_rank==0 ) printf("matrix_type=%lld < 0 or matrix_type=%lld > 11\n",s,s);
+      if( my_rank==0 ) printf("matrix_type=%lld < 0 or matrix_type=%lld > 11 (SELL is %lld)\n",s,s,(LIS_INT)LIS_MATRIX_SELL);
 #else
-      if( my_rank==0 ) printf("matrix_type=%d < 0 or matrix_type=%d > 11\n",s,s);
+      if( my_rank==0 ) printf("matrix_type=%d < 0 or matrix_type=%d > 11 (SELL is %d)\n",s,s,LIS_MATRIX_SELL);
 #endif
       CHKERR(1);
     }
@@ -219,7 +219,7 @@ LIS_INT main(LIS_INT argc, char* argv[])
   if (s==0) 
     {
       ss = 1;
-      se = 11;
+      se = LIS_MATRIX_SELL+1;
     }
   else
     {
@@ -230,6 +230,7 @@ LIS_INT main(LIS_INT argc, char* argv[])
   for (matrix_type=ss;matrix_type<se;matrix_type++)
     {
       if ( nprocs>1 && matrix_type==9 ) continue;
+      if ( s==0 && matrix_type>=11 && matrix_type<LIS_MATRIX_SELL ) continue;
       lis_matrix_duplicate(A0,&A);
       lis_matrix_set_type(A,matrix_type);
       err = lis_matrix_convert(A0,A);
@@ -43,7 +43,7 @@
 #endif
 #include "lislib.h"
 
-char *lis_storagename2[]   = {"CSR", "CSC", "MSR", "DIA", "ELL", "JAD", "BSR", "BSC", "VBR", "COO", "DNS"};
+char *lis_storagename2[]   = {"CSR", "CSC", "MSR", "DIA", "ELL", "JAD", "BSR", "BSC", "VBR", "COO", "DNS", "TJAD", "BJAD", "BCR", "CJAD", "PCSR", "LCSR", "LJAD", "LBSR", "CDIA", "MSC", "SELL"};
 
 #undef __FUNC__
 #define __FUNC__ "main"
@@ -198,9 +198,10 @@ LIS_INT main(LIS_INT argc, char* argv[])
    DNS is also excluded to reduce memory usage.
       */
 
-      for (matrix_type=1;matrix_type<11;matrix_type++)
+      for (matrix_type=1;matrix_type<=LIS_MATRIX_SELL;matrix_type++)
   {
     if ( nprocs>1 && matrix_type==9 ) continue;
+    if ( matrix_type>=11 && matrix_type<LIS_MATRIX_SELL ) continue;
     lis_matrix_duplicate(A0,&A);
     lis_matrix_set_type(A,matrix_type);
     err = lis_matrix_convert(A0,A);
@@ -43,7 +43,7 @@
 #endif
 #include "lislib.h"
 
-char *lis_storagename2[]   = {"CSR", "CSC", "MSR", "DIA", "ELL", "JAD", "BSR", "BSC", "VBR", "COO", "DNS"};
+char *lis_storagename2[]   = {"CSR", "CSC", "MSR", "DIA", "ELL", "JAD", "BSR", "BSC", "VBR", "COO", "DNS", "TJAD", "BJAD", "BCR", "CJAD", "PCSR", "LCSR", "LJAD", "LBSR", "CDIA", "MSC", "SELL"};
 
 #undef __FUNC__
 #define __FUNC__ "main"
@@ -107,12 +107,12 @@ LIS_INT main(LIS_INT argc, char* argv[])
     block = atoi(argv[4]);
   }
 
-  if( matrix_type<1 || matrix_type>11 )
+  if( matrix_type<1 || (matrix_type>11 && matrix_type!=LIS_MATRIX_SELL) )
     {
 #ifdef _LONGLONG
-      if( my_rank==0 ) printf("matrix_type=%lld <1 or matrix_type=%lld >11\n",matrix_type,matrix_type);
+      if( my_rank==0 ) printf("matrix_type=%lld <1 or matrix_type=%lld >11 (SELL is %lld)\n",matrix_type,matrix_type,(LIS_INT)LIS_MATRIX_SELL);
 #else
-      if( my_rank==0 ) printf("matrix_type=%d <1 or matrix_type=%d >11\n",matrix_type,matrix_type);
+      if( my_rank==0 ) printf("matrix_type=%d <1 or matrix_type=%d >11 (SELL is %d)\n",matrix_type,matrix_type,LIS_MATRIX_SELL);
 #endif
       CHKERR(1);
     }
@@ -29,6 +29,82 @@ echo ' '
 echo 'checking linear solvers...'
 $MPIRUN $srcdir/test1 $srcdir/testmat.mtx 0 /dev/null /dev/null
 
+# run test2 on the 30x30 2-D Poisson problem with the options in $1 and
+# in $2, and fail unless both converge in the same number of iterations
+check_iters()
+{
+  for opts in "$1" "$2"; do
+    out=`$MPIRUN $srcdir/test2 30 30 1 /dev/null /dev/null $opts`
+    if echo "$out" | grep 'lis_solve : normal end' > /dev/null; then :; else
+      echo "test2 $opts did not converge"
+      exit 1
+    fi
+    iters2=$iters1
+    iters1=`echo "$out" | sed -n 's/^.*number of iterations *= *\([0-9]*\).*$/\1/p'`
+  done
+  if test "$iters1" != "$iters2"; then
+    echo "test2 $1 took $iters2 iterations, test2 $2 took $iters1"
+    exit 1
+  fi
+  echo "$1 / $2: $iters1 iterations"
+}
+
+echo 'checking pipelined CG and CA-GMRES...'
+for p in none ilu ssor; do
+  check_iters "-i cg -p $p" "-i pcg -p $p"
+done
+for s in 1 2 4; do
+  check_iters "-i gmres" "-i cagmres -cagmres_s $s"
+done
+for s in 8 16; do
+  check_iters "-i gmres -p ilu" "-i cagmres -p ilu -cagmres_s $s"
+  check_iters "-i gmres -p ilu -restart 5" "-i cagmres -p ilu -restart 5 -cagmres_s $s"
+done
+
+echo 'checking preconditioner reuse...'
+for p in ilu ilut iluc; do
+  $MPIRUN $srcdir/test7 30 -i bicg -p $p || exit 1
+done
+
+# solve the 30x30 2-D Poisson problem with the options in $2 and
+# OMP_NUM_THREADS=$1, write the solution to $3 and the number of
+# iterations to $iters
+solve_sol()
+{
+  out=`OMP_NUM_THREADS=$1 $MPIRUN $srcdir/test2 30 30 1 $3 /dev/null -i bicg -tol 1.0e-12 $2`
+  if echo "$out" | grep 'lis_solve : normal end' > /dev/null; then :; else
+    echo "test2 $2 on $1 threads did not converge"
+    exit 1
+  fi
+  iters=`echo "$out" | sed -n 's/^.*number of iterations *= *\([0-9]*\).*$/\1/p'`
+}
+
+# fail unless the solutions in $1 and $2 agree to 1.0e-8
+check_sol()
+{
+  awk 'NR==FNR { if( FNR>2 ) x[$1] = $2; next }
+       FNR>2 { d = $2 - x[$1]; if( d<0 ) d = -d; if( d>m ) m = d }
+       END { exit !(m<1.0e-8) }' $1 $2 || { echo "$3: solutions differ"; exit 1; }
+}
+
+if test "$enable_omp" = "yes"; then
+  echo 'checking level-scheduled ILU...'
+  for p in ilu ilut iluc; do
+    solve_sol 1 "-p $p" levelset_ref.mtx
+    iters_ref=$iters
+    solve_sol 4 "-p $p -ilu_levelset true" levelset_on.mtx
+    if test "$iters" != "$iters_ref"; then
+      echo "-p $p -ilu_levelset true took $iters iterations on 4 threads, $iters_ref on 1"
+      exit 1
+    fi
+    check_sol levelset_ref.mtx levelset_on.mtx "-p $p -ilu_levelset true"
+    solve_sol 4 "-p $p -ilu_levelset false" levelset_off.mtx
+    check_sol levelset_ref.mtx levelset_off.mtx "-p $p -ilu_levelset false"
+    echo "-p $p: $iters_ref iterations with -ilu_levelset true, $iters without"
+  done
+  rm -f levelset_ref.mtx levelset_on.mtx levelset_off.mtx
+fi
+
 echo 'checking eigensolvers...'
 $MPIRUN $srcdir/etest1 $srcdir/testmat.mtx /dev/null /dev/null
 
@@ -0,0 +1,233 @@
+/* Copyright (C) The Scalable Software Infrastructure Project. All rights reserved.
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+   1. Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+   3. Neither the name of the project nor the names of its contributors
+      may be used to endorse or promote products derived from this software
+      without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE SCALABLE SOFTWARE INFRASTRUCTURE PROJECT
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+   TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+   PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE SCALABLE SOFTWARE INFRASTRUCTURE
+   PROJECT BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+   OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifdef HAVE_CONFIG_H
+        #include "lis_config.h"
+#else
+#ifdef HAVE_CONFIG_WIN_H
+        #include "lis_config_win.h"
+#endif
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "lis.h"
+
+/*
+ * Solves three m^2 x m^2 convection-diffusion systems of the same
+ * pattern with one solver, -precon_reuse true and -precon_reuse_ratio
+ * 1.5. The convection coefficient changes from one system to the next.
+ *
+ *   system 0, -tol 1.0e-4  : the preconditioner is built
+ *   system 1, -tol 1.0e-12 : it is refreshed, since the iteration count
+ *                            of system 0 is within the ratio
+ *   system 2, -tol 1.0e-12 : it is rebuilt, since system 1 took more
+ *                            than 1.5 times the iterations of system 0
+ *
+ * A rebuild restarts the iteration count that later solves are measured
+ * against, so solver->reuse_iter tells a refresh from a rebuild. With
+ * ILU(k), a refresh gives the same factors as a new build, so system 1
+ * must also take as many iterations as a solver without reuse.
+ * The program returns 1 if any check fails.
+ */
+
+#undef __FUNC__
+#define __FUNC__ "make_matrix"
+LIS_INT make_matrix(LIS_INT m, LIS_SCALAR c, LIS_MATRIX *A)
+{
+  LIS_INT      i,j,k,ii,is,ie,err;
+  LIS_INT      *ptr,*index;
+  LIS_SCALAR    *value;
+
+  err = lis_matrix_create(LIS_COMM_WORLD,A);
+  if( err ) return err;
+  err = lis_matrix_set_size(*A,0,m*m);
+  if( err ) return err;
+
+  ptr   = (LIS_INT *)malloc(((*A)->n+1)*sizeof(LIS_INT));
+  index = (LIS_INT *)malloc(5*(*A)->n*sizeof(LIS_INT));
+  value = (LIS_SCALAR *)malloc(5*(*A)->n*sizeof(LIS_SCALAR));
+  if( ptr==NULL || index==NULL || value==NULL ) return LIS_OUT_OF_MEMORY;
+
+  lis_matrix_get_range(*A,&is,&ie);
+  k = 0;
+  for(ii=is;ii<ie;ii++)
+  {
+    i = ii/m;
+    j = ii - i*m;
+    if( i>0 )   { index[k] = ii - m; value[k++] = -1.0 - c;}
+    if( i<m-1 ) { index[k] = ii + m; value[k++] = -1.0 + c;}
+    if( j>0 )   { index[k] = ii - 1; value[k++] = -1.0 - 0.5*c;}
+    if( j<m-1 ) { index[k] = ii + 1; value[k++] = -1.0 + 0.5*c;}
+    index[k] = ii; value[k++] = 4.0;
+    ptr[ii-is+1] = k;
+  }
+  ptr[0] = 0;
+  err = lis_matrix_set_csr(ptr[ie-is],ptr,index,value,*A);
+  if( err ) return err;
+  return lis_matrix_assemble(*A);
+}
+
+#undef __FUNC__
+#define __FUNC__ "solve"
+LIS_INT solve(LIS_INT m, LIS_SCALAR c, char *tol, LIS_SOLVER solver, LIS_INT *iter)
+{
+  LIS_MATRIX    A;
+  LIS_VECTOR    x,b,u;
+  LIS_INT      err,status;
+
+  err = make_matrix(m,c,&A);
+  if( err ) return err;
+  lis_vector_duplicate(A,&u);
+  lis_vector_duplicate(A,&b);
+  lis_vector_duplicate(A,&x);
+  lis_vector_set_all(1.0,u);
+  lis_matvec(A,u,b);
+
+  lis_solver_set_option(tol,solver);
+  err = lis_solve(A,b,x,solver);
+  lis_solver_get_status(solver,&status);
+  lis_solver_get_iters(solver,iter);
+
+  lis_matrix_destroy(A);
+  lis_vector_destroy(b);
+  lis_vector_destroy(x);
+  lis_vector_destroy(u);
+  return err ? err : status;
+}
+
+#undef __FUNC__
+#define __FUNC__ "main"
+LIS_INT main(LIS_INT argc, char* argv[])
+{
+  LIS_SOLVER    solver,solver2;
+  LIS_PRECON    precon;
+  LIS_INT      m,iter0,iter1,iter2,iter_new,precon_type;
+  LIS_INT      my_rank,fails;
+  int                     int_my_rank;
+
+  LIS_DEBUG_FUNC_IN;
+
+  lis_initialize(&argc, &argv);
+
+  #ifdef USE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD,&int_my_rank);
+    my_rank = int_my_rank;
+  #else
+    my_rank = 0;
+  #endif
+
+  if( argc < 2 )
+  {
+    if( my_rank==0 )
+      {
+        printf("Usage: %s m [options]\n", argv[0]);
+      }
+    CHKERR(1);
+  }
+
+  m = atoi(argv[1]);
+  if( m<=0 )
+  {
+#ifdef _LONGLONG
+    if( my_rank==0 ) printf("m=%lld <=0\n",m);
+#else
+    if( my_rank==0 ) printf("m=%d <=0\n",m);
+#endif
+    CHKERR(1);
+  }
+
+  fails = 0;
+  lis_solver_create(&solver);
+  lis_solver_set_option("-p ilu",solver);
+  lis_solver_set_optionC(solver);
+  lis_solver_set_option("-precon_reuse true -precon_reuse_ratio 1.5",solver);
+  lis_solver_get_precon(solver,&precon_type);
+
+  /* system 0: the preconditioner is built */
+  CHKERR(solve(m,0.1,"-tol 1.0e-4",solver,&iter0));
+  precon = solver->reuse_precon;
+  if( precon==NULL || solver->reuse_iter!=iter0 )
+  {
+    if( my_rank==0 ) printf("system 0: the preconditioner was not kept\n");
+    fails++;
+  }
+
+  /* system 1: the preconditioner is refreshed */
+  CHKERR(solve(m,0.2,"-tol 1.0e-12",solver,&iter1));
+  if( solver->reuse_precon!=precon || solver->reuse_iter!=iter0 )
+  {
+    if( my_rank==0 ) printf("system 1: the preconditioner was rebuilt, not refreshed\n");
+    fails++;
+  }
+  if( precon_type==LIS_PRECON_TYPE_ILU )
+  {
+    lis_solver_create(&solver2);
+    lis_solver_set_option("-p ilu",solver2);
+    lis_solver_set_optionC(solver2);
+    lis_solver_set_option("-precon_reuse false",solver2);
+    CHKERR(solve(m,0.2,"-tol 1.0e-12",solver2,&iter_new));
+    lis_solver_destroy(solver2);
+    if( iter1!=iter_new )
+    {
+#ifdef _LONGLONG
+      if( my_rank==0 ) printf("system 1: %lld iterations with the refreshed ILU, %lld with a new one\n",iter1,iter_new);
+#else
+      if( my_rank==0 ) printf("system 1: %d iterations with the refreshed ILU, %d with a new one\n",iter1,iter_new);
+#endif
+      fails++;
+    }
+  }
+  if( 2*iter1<=3*iter0 )
+  {
+    if( my_rank==0 ) printf("system 1: too few iterations to exceed the reuse ratio\n");
+    fails++;
+  }
+
+  /* system 2: the preconditioner is rebuilt */
+  CHKERR(solve(m,0.3,"-tol 1.0e-12",solver,&iter2));
+  if( solver->reuse_precon==NULL || solver->reuse_iter!=iter2 )
+  {
+    if( my_rank==0 ) printf("system 2: the preconditioner was not rebuilt\n");
+    fails++;
+  }
+
+  if( my_rank==0 )
+  {
+#ifdef _LONGLONG
+    printf("iterations: built %lld, refreshed %lld, rebuilt %lld\n",iter0,iter1,iter2);
+#else
+    printf("iterations: built %d, refreshed %d, rebuilt %d\n",iter0,iter1,iter2);
+#endif
+  }
+
+  lis_solver_destroy(solver);
+  lis_finalize();
+
+  LIS_DEBUG_FUNC_OUT;
+  return fails ? 1 : 0;
+}
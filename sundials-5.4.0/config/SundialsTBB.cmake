@@ -0,0 +1,73 @@
+# ------------------------------------------------------------------------------
+# SUNDIALS Copyright Start
+# Copyright (c) 2002-2020, Lawrence Livermore National Security
+# and Southern Methodist University.
+# All rights reserved.
+#
+# See the top-level LICENSE and NOTICE files for details.
+#
+# SPDX-License-Identifier: BSD-3-Clause
+# SUNDIALS Copyright End
+# ------------------------------------------------------------------------------
+# Sundials module to find and configure Intel TBB correctly.
+#
+# If a tbb_static or tbb target exists (TBB is built in the same project, as in
+# the OpenModelica 3rdParty tree) it is used. Otherwise TBB is searched for
+# in TBB_INCLUDE_DIR and TBB_LIBRARY_DIR, or TBB_LIBRARIES may be given
+# directly. Sets TBB_FOUND and the imported target SUNDIALS::TBB.
+# ------------------------------------------------------------------------------
+
+set(TBB_FOUND FALSE)
+
+# TBB needs the system thread library
+find_package(Threads REQUIRED)
+
+if(TARGET tbb_static OR TARGET tbb)
+
+  # TBB built with SUNDIALS
+  if(TARGET tbb_static)
+    set(TBB_LIBRARIES tbb_static)
+  else()
+    set(TBB_LIBRARIES tbb)
+  endif()
+  # the OpenModelica TBB is built for the Boehm GC
+  if(TARGET omcgc)
+    list(APPEND TBB_LIBRARIES omcgc)
+  endif()
+  message(STATUS "Using the TBB target ${TBB_LIBRARIES}")
+
+else()
+
+  # find the TBB headers and library
+  find_path(TBB_INCLUDE_DIR tbb/task_arena.h
+    HINTS ${TBB_INCLUDE_DIR} ${TBB_DIR}/include)
+
+  if(NOT TBB_LIBRARIES)
+    find_library(TBB_LIBRARY NAMES tbb tbb_static NAMES_PER_DIR
+      HINTS ${TBB_LIBRARY_DIR} ${TBB_DIR}/lib)
+    if(TBB_LIBRARY)
+      set(TBB_LIBRARIES ${TBB_LIBRARY})
+    endif()
+    mark_as_advanced(TBB_LIBRARY)
+  endif()
+
+  if(NOT (TBB_INCLUDE_DIR AND TBB_LIBRARIES))
+    print_error("TBB not found. Set TBB_INCLUDE_DIR and TBB_LIBRARY_DIR (or TBB_LIBRARIES).")
+  endif()
+  message(STATUS "TBB include directory: ${TBB_INCLUDE_DIR}")
+  message(STATUS "TBB libraries: ${TBB_LIBRARIES}")
+
+endif()
+
+# create an imported target for the NVECTOR_TBB library to link against
+if(NOT TARGET SUNDIALS::TBB)
+  add_library(SUNDIALS::TBB INTERFACE IMPORTED)
+  if(TBB_INCLUDE_DIR)
+    set_target_properties(SUNDIALS::TBB PROPERTIES
+      INTERFACE_INCLUDE_DIRECTORIES "${TBB_INCLUDE_DIR}")
+  endif()
+  set_target_properties(SUNDIALS::TBB PROPERTIES
+    INTERFACE_LINK_LIBRARIES "${TBB_LIBRARIES};Threads::Threads")
+endif()
+
+set(TBB_FOUND TRUE)
@@ -0,0 +1,39 @@
+# ------------------------------------------------------------------------------
+# SUNDIALS Copyright Start
+# Copyright (c) 2002-2020, Lawrence Livermore National Security
+# and Southern Methodist University.
+# All rights reserved.
+#
+# See the top-level LICENSE and NOTICE files for details.
+#
+# SPDX-License-Identifier: BSD-3-Clause
+# SUNDIALS Copyright End
+# ------------------------------------------------------------------------------
+# Sundials module to find zlib, used by the compressed check point store of the
+# CVODES and IDAS adjoint modules.
+#
+# If a zlib target exists (zlib is built in the same project, as in the
+# OpenModelica 3rdParty tree) it is used. Otherwise zlib is searched for with
+# the standard FindZLIB module. Sets ZLIB_FOUND, ZLIB_LIBRARIES and
+# ZLIB_INCLUDE_DIR.
+# ------------------------------------------------------------------------------
+
+if(TARGET zlib)
+
+  # zlib built with SUNDIALS, the target carries its include directory
+  set(ZLIB_LIBRARIES zlib)
+  set(ZLIB_INCLUDE_DIR "")
+  set(ZLIB_FOUND TRUE)
+  message(STATUS "Using the zlib target ${ZLIB_LIBRARIES}")
+
+else()
+
+  find_package(ZLIB)
+  if(NOT ZLIB_FOUND)
+    print_error("zlib not found. Set ZLIB_ROOT or disable ZLIB_ENABLE.")
+  endif()
+  set(ZLIB_INCLUDE_DIR ${ZLIB_INCLUDE_DIRS})
+  message(STATUS "zlib include directory: ${ZLIB_INCLUDE_DIR}")
+  message(STATUS "zlib libraries: ${ZLIB_LIBRARIES}")
+
+endif()
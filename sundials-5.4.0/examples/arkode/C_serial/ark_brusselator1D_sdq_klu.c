@@ -0,0 +1,367 @@
+/*---------------------------------------------------------------
+ * Programmer(s): based on ark_brusselator1D_klu.c
+ *---------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2020, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ *---------------------------------------------------------------
+ * Example problem:
+ *
+ * The following test simulates a two-component brusselator
+ * problem from chemical kinetics, Y = [u,v], satisfying
+ *    u_t = d*u_xx + a - (b+1)*u + v*u^2
+ *    v_t = d*v_xx + b*u - v*u^2
+ * for t in [0, 10], x in [0, 1], with initial conditions
+ *    u(0,x) =  a  + 0.5*sin(pi*x)
+ *    v(0,x) = b/a,
+ * and with Dirichlet boundary conditions u = a, v = b/a.
+ *
+ * The spatial derivatives are computed using second-order
+ * centered differences on MX interior points, with the unknowns
+ * interleaved (u_1, v_1, u_2, v_2, ...), so the Jacobian is banded
+ * with half-bandwidths ml = mu = 2, but each row only has four
+ * nonzeros.
+ *
+ * This program solves the problem twice with the DIRK method,
+ * using a Newton iteration and internal difference quotient (DQ)
+ * Jacobians: first with the band DQ Jacobian and the band linear
+ * solver, then with the colored sparse DQ Jacobian enabled by
+ * ARKStepSetSparseDQJac and the SUNLinSol_KLU linear solver. The
+ * two DQ Jacobians are the same matrix, so the two solutions must
+ * agree to well within the integration tolerances, and the sparse
+ * DQ Jacobian must not use more RHS evaluations per Jacobian than
+ * the band one (ml+mu+1). The program returns 1 if either check
+ * fails.
+ *---------------------------------------------------------------*/
+
+/* Header files */
+#include <stdio.h>
+#include <math.h>
+#include <arkode/arkode_arkstep.h>       /* prototypes for ARKStep fcts., consts */
+#include <nvector/nvector_serial.h>      /* serial N_Vector types, fcts., macros */
+#include <sunmatrix/sunmatrix_band.h>    /* access to band SUNMatrix             */
+#include <sunmatrix/sunmatrix_sparse.h>  /* access to sparse SUNMatrix           */
+#include <sunlinsol/sunlinsol_band.h>    /* access to band SUNLinearSolver       */
+#include <sunlinsol/sunlinsol_klu.h>     /* access to KLU SUNLinearSolver        */
+#include <sundials/sundials_types.h>     /* defs. of realtype, sunindextype, etc */
+#include <sundials/sundials_math.h>      /* def. of SUNRabs, SUNMAX, etc.        */
+
+#if defined(SUNDIALS_EXTENDED_PRECISION)
+#define GSYM "Lg"
+#define ESYM "Le"
+#define FSYM "Lf"
+#else
+#define GSYM "g"
+#define ESYM "e"
+#define FSYM "f"
+#endif
+
+/* accessor macros between (x,v) location and 1D NVector array */
+#define IDX(x,v) (2*(x)+v)
+
+/* problem constants */
+#define MX      50               /* number of interior points     */
+#define NEQ     (2*MX)           /* number of equations           */
+#define MU      2                /* half-bandwidths of the band   */
+#define ML      2                /* Jacobian                      */
+#define A_PAR   RCONST(1.0)      /* brusselator parameters a, b   */
+#define B_PAR   RCONST(3.0)
+#define DIFF    RCONST(0.1)      /* diffusion coefficient d       */
+#define RTOL    RCONST(1.0e-6)   /* scalar relative tolerance     */
+#define ATOL    RCONST(1.0e-9)   /* scalar absolute tolerance     */
+#define T0      RCONST(0.0)      /* initial time                  */
+#define T1      RCONST(2.0)      /* first output time             */
+#define DTOUT   RCONST(2.0)      /* output time increment         */
+#define NOUT    5                /* number of output times        */
+#define DIFFTOL RCONST(1.0e-6)   /* allowed difference of the two
+                                    solutions, relative to |y|    */
+
+/* constants */
+#define ZERO (RCONST(0.0))
+#define HALF (RCONST(0.5))
+#define ONE  (RCONST(1.0))
+#define TWO  (RCONST(2.0))
+
+/* User-supplied Functions Called by the Solver */
+static int f(realtype t, N_Vector y, N_Vector ydot, void *user_data);
+
+/* Private helper functions  */
+static void SetIC(N_Vector y);
+static int SetPattern(SUNMatrix S);
+static void PrintFinalStats(void *arkode_mem, const char *name);
+
+/* Private function to check function return values */
+static int check_flag(void *flagvalue, const char *funcname, int opt);
+
+/* Main Program */
+int main()
+{
+  realtype t, tout, dy, maxdiff;
+  N_Vector yb = NULL, ys = NULL;
+  SUNMatrix Ab = NULL, As = NULL, Jpat = NULL;
+  SUNLinearSolver LSb = NULL, LSs = NULL;
+  void *arkb_mem = NULL, *arks_mem = NULL;
+  long int njeb, njes, nfeLSb, nfeLSs;
+  sunindextype i;
+  int flag, iout, passed;
+
+  /* Create serial vectors of length NEQ for the two solutions */
+  yb = N_VNew_Serial(NEQ);
+  if (check_flag((void *)yb, "N_VNew_Serial", 0)) return 1;
+  ys = N_VNew_Serial(NEQ);
+  if (check_flag((void *)ys, "N_VNew_Serial", 0)) return 1;
+  SetIC(yb);
+  SetIC(ys);
+
+  /* Band DQ Jacobian with the band linear solver.  Note: since this
+     problem is fully implicit, we set f_E to NULL and f_I to f. */
+  arkb_mem = ARKStepCreate(NULL, f, T0, yb);
+  if (check_flag((void *) arkb_mem, "ARKStepCreate", 0)) return 1;
+  flag = ARKStepSStolerances(arkb_mem, RTOL, ATOL);
+  if (check_flag(&flag, "ARKStepSStolerances", 1)) return 1;
+  Ab = SUNBandMatrix(NEQ, MU, ML);
+  if (check_flag((void *)Ab, "SUNBandMatrix", 0)) return 1;
+  LSb = SUNLinSol_Band(yb, Ab);
+  if (check_flag((void *)LSb, "SUNLinSol_Band", 0)) return 1;
+  flag = ARKStepSetLinearSolver(arkb_mem, LSb, Ab);
+  if (check_flag(&flag, "ARKStepSetLinearSolver", 1)) return 1;
+
+  /* Colored sparse DQ Jacobian with the KLU linear solver */
+  arks_mem = ARKStepCreate(NULL, f, T0, ys);
+  if (check_flag((void *) arks_mem, "ARKStepCreate", 0)) return 1;
+  flag = ARKStepSStolerances(arks_mem, RTOL, ATOL);
+  if (check_flag(&flag, "ARKStepSStolerances", 1)) return 1;
+  As = SUNSparseMatrix(NEQ, NEQ, 4*NEQ, CSC_MAT);
+  if (check_flag((void *)As, "SUNSparseMatrix", 0)) return 1;
+  LSs = SUNLinSol_KLU(ys, As);
+  if (check_flag((void *)LSs, "SUNLinSol_KLU", 0)) return 1;
+  flag = ARKStepSetLinearSolver(arks_mem, LSs, As);
+  if (check_flag(&flag, "ARKStepSetLinearSolver", 1)) return 1;
+
+  /* The sparsity pattern of the Jacobian, used to color its columns */
+  Jpat = SUNSparseMatrix(NEQ, NEQ, 4*NEQ, CSC_MAT);
+  if (check_flag((void *)Jpat, "SUNSparseMatrix", 0)) return 1;
+  flag = SetPattern(Jpat);
+  if (check_flag(&flag, "SetPattern", 1)) return 1;
+  flag = ARKStepSetSparseDQJac(arks_mem, Jpat, 1);
+  if (check_flag(&flag, "ARKStepSetSparseDQJac", 1)) return 1;
+
+  /* Main time-stepping loop: advance both solutions and compare */
+  printf("\n1D Brusselator PDE test problem, band vs. sparse DQ Jacobian:\n");
+  printf("    N = %i,  NEQ = %i\n", MX, NEQ);
+  printf("        t        u(mid)      v(mid)\n");
+  printf("   ----------------------------------\n");
+
+  maxdiff = ZERO;
+  for (iout = 1, tout = T1; iout <= NOUT; iout++, tout += DTOUT) {
+    flag = ARKStepEvolve(arkb_mem, tout, yb, &t, ARK_NORMAL);
+    if (check_flag(&flag, "ARKStepEvolve", 1)) return 1;
+    flag = ARKStepEvolve(arks_mem, tout, ys, &t, ARK_NORMAL);
+    if (check_flag(&flag, "ARKStepEvolve", 1)) return 1;
+
+    /* max |yb - ys| / (|yb| + ATOL) */
+    dy = ZERO;
+    for (i = 0; i < NEQ; i++)
+      dy = SUNMAX(dy, SUNRabs(NV_Ith_S(yb,i) - NV_Ith_S(ys,i)) /
+                      (SUNRabs(NV_Ith_S(yb,i)) + ATOL));
+    maxdiff = SUNMAX(maxdiff, dy);
+
+    printf("  %10.6"FSYM"  %10.6"FSYM"  %10.6"FSYM"\n", t,
+           NV_Ith_S(yb,IDX(MX/2,0)), NV_Ith_S(yb,IDX(MX/2,1)));
+  }
+  printf("   ----------------------------------\n");
+
+  PrintFinalStats(arkb_mem, "band DQ Jacobian");
+  PrintFinalStats(arks_mem, "colored sparse DQ Jacobian");
+
+  /* Check the solutions and the cost of the sparse DQ Jacobian */
+  flag = ARKStepGetNumJacEvals(arkb_mem, &njeb);
+  check_flag(&flag, "ARKStepGetNumJacEvals", 1);
+  flag = ARKStepGetNumLinRhsEvals(arkb_mem, &nfeLSb);
+  check_flag(&flag, "ARKStepGetNumLinRhsEvals", 1);
+  flag = ARKStepGetNumJacEvals(arks_mem, &njes);
+  check_flag(&flag, "ARKStepGetNumJacEvals", 1);
+  flag = ARKStepGetNumLinRhsEvals(arks_mem, &nfeLSs);
+  check_flag(&flag, "ARKStepGetNumLinRhsEvals", 1);
+
+  passed = 1;
+  if (maxdiff > DIFFTOL) {
+    printf("FAIL: the solutions differ by more than %"GSYM"\n", DIFFTOL);
+    passed = 0;
+  }
+  if ((njes < 1) || (nfeLSs > (ML+MU+1)*njes) || (nfeLSb != (ML+MU+1)*njeb)) {
+    printf("FAIL: unexpected number of RHS evaluations for DQ Jacobians\n");
+    passed = 0;
+  }
+  if (passed) printf("PASSED: the sparse DQ Jacobian matches the band DQ\n");
+
+  /* Clean up and return */
+  N_VDestroy(yb);               /* Free vectors */
+  N_VDestroy(ys);
+  ARKStepFree(&arkb_mem);       /* Free integrator memory */
+  ARKStepFree(&arks_mem);
+  SUNLinSolFree(LSb);           /* Free linear solvers */
+  SUNLinSolFree(LSs);
+  SUNMatDestroy(Ab);            /* Free matrices */
+  SUNMatDestroy(As);
+  SUNMatDestroy(Jpat);
+  return (passed ? 0 : 1);
+}
+
+/*-------------------------------
+ * Functions called by the solver
+ *-------------------------------*/
+
+/* f routine to compute the ODE RHS function f(t,y). */
+static int f(realtype t, N_Vector y, N_Vector ydot, void *user_data)
+{
+  realtype *Ydata, *dYdata;
+  realtype u, v, ul, ur, vl, vr, c;
+  sunindextype i;
+
+  Ydata = N_VGetArrayPointer(y);
+  if (check_flag((void *) Ydata, "N_VGetArrayPointer", 0)) return 1;
+  dYdata = N_VGetArrayPointer(ydot);
+  if (check_flag((void *) dYdata, "N_VGetArrayPointer", 0)) return 1;
+
+  c = DIFF * (MX+1) * (MX+1);   /* d / dx^2 */
+
+  /* iterate over domain, computing all equations */
+  for (i=0; i<MX; i++) {
+    u  = Ydata[IDX(i,0)];
+    v  = Ydata[IDX(i,1)];
+    ul = (i > 0)    ? Ydata[IDX(i-1,0)] : A_PAR;
+    vl = (i > 0)    ? Ydata[IDX(i-1,1)] : B_PAR/A_PAR;
+    ur = (i < MX-1) ? Ydata[IDX(i+1,0)] : A_PAR;
+    vr = (i < MX-1) ? Ydata[IDX(i+1,1)] : B_PAR/A_PAR;
+
+    dYdata[IDX(i,0)] = c*(ul - TWO*u + ur) + A_PAR - (B_PAR+ONE)*u + v*u*u;
+    dYdata[IDX(i,1)] = c*(vl - TWO*v + vr) + B_PAR*u - v*u*u;
+  }
+
+  return 0;                     /* Return with success */
+}
+
+/*-------------------------------
+ * Private helper functions
+ *-------------------------------*/
+
+/* Perturbed steady state as initial condition */
+static void SetIC(N_Vector y)
+{
+  realtype *data, x;
+  sunindextype i;
+
+  data = N_VGetArrayPointer(y);
+  for (i=0; i<MX; i++) {
+    x = (i+1) / (realtype) (MX+1);
+    data[IDX(i,0)] = A_PAR + HALF*sin(RCONST(3.14159265358979)*x);
+    data[IDX(i,1)] = B_PAR/A_PAR;
+  }
+}
+
+/* Column pattern of df/dy: the column of u_i (or v_i) appears in the
+   rows of u (or v) at the neighbouring points and in both rows at
+   point i */
+static int SetPattern(SUNMatrix S)
+{
+  sunindextype *colptrs, *rowvals;
+  sunindextype i, c, nz;
+
+  colptrs = SUNSparseMatrix_IndexPointers(S);
+  rowvals = SUNSparseMatrix_IndexValues(S);
+
+  nz = 0;
+  for (i=0; i<MX; i++) {
+    for (c=0; c<2; c++) {
+      colptrs[IDX(i,c)] = nz;
+      if (i > 0)    rowvals[nz++] = IDX(i-1,c);
+      rowvals[nz++] = IDX(i,0);
+      rowvals[nz++] = IDX(i,1);
+      if (i < MX-1) rowvals[nz++] = IDX(i+1,c);
+    }
+  }
+  colptrs[NEQ] = nz;
+
+  return 0;
+}
+
+/* Print some final statistics */
+static void PrintFinalStats(void *arkode_mem, const char *name)
+{
+  long int nst, nst_a, nfe, nfi, nsetups, nje, nfeLS, nni, ncfn, netf;
+  int flag;
+
+  flag = ARKStepGetNumSteps(arkode_mem, &nst);
+  check_flag(&flag, "ARKStepGetNumSteps", 1);
+  flag = ARKStepGetNumStepAttempts(arkode_mem, &nst_a);
+  check_flag(&flag, "ARKStepGetNumStepAttempts", 1);
+  flag = ARKStepGetNumRhsEvals(arkode_mem, &nfe, &nfi);
+  check_flag(&flag, "ARKStepGetNumRhsEvals", 1);
+  flag = ARKStepGetNumLinSolvSetups(arkode_mem, &nsetups);
+  check_flag(&flag, "ARKStepGetNumLinSolvSetups", 1);
+  flag = ARKStepGetNumErrTestFails(arkode_mem, &netf);
+  check_flag(&flag, "ARKStepGetNumErrTestFails", 1);
+  flag = ARKStepGetNumNonlinSolvIters(arkode_mem, &nni);
+  check_flag(&flag, "ARKStepGetNumNonlinSolvIters", 1);
+  flag = ARKStepGetNumNonlinSolvConvFails(arkode_mem, &ncfn);
+  check_flag(&flag, "ARKStepGetNumNonlinSolvConvFails", 1);
+  flag = ARKStepGetNumJacEvals(arkode_mem, &nje);
+  check_flag(&flag, "ARKStepGetNumJacEvals", 1);
+  flag = ARKStepGetNumLinRhsEvals(arkode_mem, &nfeLS);
+  check_flag(&flag, "ARKStepGetNumLinRhsEvals", 1);
+
+  printf("\nFinal Solver Statistics, %s:\n", name);
+  printf("   Internal solver steps = %li (attempted = %li)\n", nst, nst_a);
+  printf("   Total RHS evals:  Fe = %li,  Fi = %li\n", nfe, nfi);
+  printf("   Total linear solver setups = %li\n", nsetups);
+  printf("   Total RHS evals for setting up the linear system = %li\n", nfeLS);
+  printf("   Total number of Jacobian evaluations = %li\n", nje);
+  printf("   Total number of nonlinear iterations = %li\n", nni);
+  printf("   Total number of nonlinear solver convergence failures = %li\n", ncfn);
+  printf("   Total number of error test failures = %li\n", netf);
+}
+
+/* Check function return value...
+    opt == 0 means SUNDIALS function allocates memory so check if
+             returned NULL pointer
+    opt == 1 means SUNDIALS function returns a flag so check if
+             flag >= 0
+    opt == 2 means function allocates memory so check if returned
+             NULL pointer
+*/
+static int check_flag(void *flagvalue, const char *funcname, int opt)
+{
+  int *errflag;
+
+  /* Check if SUNDIALS function returned NULL pointer - no memory allocated */
+  if (opt == 0 && flagvalue == NULL) {
+    fprintf(stderr, "\nSUNDIALS_ERROR: %s() failed - returned NULL pointer\n\n",
+            funcname);
+    return 1; }
+
+  /* Check if flag < 0 */
+  else if (opt == 1) {
+    errflag = (int *) flagvalue;
+    if (*errflag < 0) {
+      fprintf(stderr, "\nSUNDIALS_ERROR: %s() failed with flag = %d\n\n",
+              funcname, *errflag);
+      return 1; }}
+
+  /* Check if function returned NULL pointer - no memory allocated */
+  else if (opt == 2 && flagvalue == NULL) {
+    fprintf(stderr, "\nMEMORY_ERROR: %s() failed - returned NULL pointer\n\n",
+            funcname);
+    return 1; }
+
+  return 0;
+}
+
+
+/*---- end of file ----*/
@@ -0,0 +1,339 @@
+/*---------------------------------------------------------------
+ * Programmer(s): based on ark_robertson_root.c
+ *---------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2020, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ *---------------------------------------------------------------
+ * Example problem:
+ *
+ * The Robertson problem of ark_robertson_root,
+ *    du/dt = -0.04*u + 1e4*v*w
+ *    dv/dt = 0.04*u - 1e4*v*w - 3e7*v^2
+ *    dw/dt = 3e7*v^2
+ * for t in the interval [0.0, 4e10], with initial conditions
+ * Y0 = [1,0,0] and the root functions
+ *    g1 = u - 1e-4,  g2 = w - 1e-2,
+ * is solved with the default DIRK method of ARKStep, a Newton
+ * iteration and the dense linear solver with its difference
+ * quotient Jacobian.
+ *
+ * This example requires SUNDIALS to be built with
+ * SUNDIALS_BUILD_WITH_PROFILING. After the integration, the phase
+ * timers are fetched with ARKStepGetProfile and written as JSON to
+ * the file ark_robertson_prof.json with SUNProfile_WriteJSON. The
+ * times vary from run to run, so only the number of calls of each
+ * phase is printed. These must agree with the integrator counters:
+ * the RHS phase counts the fe and fi calls of the integrator and of
+ * the DQ Jacobian, the Jacobian and linear setup phases count the
+ * Jacobian evaluations and linear solver setups, the step phase
+ * counts the steps, and each phase name must appear in the JSON
+ * file. The program returns 1 if a check fails.
+ *---------------------------------------------------------------*/
+
+/* Header files */
+#include <stdio.h>
+#include <string.h>
+#include <arkode/arkode_arkstep.h>      /* prototypes for ARKStep fcts., consts */
+#include <nvector/nvector_serial.h>     /* serial N_Vector types, fcts., macros */
+#include <sunmatrix/sunmatrix_dense.h>  /* access to dense SUNMatrix            */
+#include <sunlinsol/sunlinsol_dense.h>  /* access to dense SUNLinearSolver      */
+#include <sundials/sundials_types.h>    /* defs. of 'realtype', 'sunindextype'  */
+#include <sundials/sundials_profile.h>  /* defs. of SUNProfile                  */
+
+#if defined(SUNDIALS_EXTENDED_PRECISION)
+#define GSYM "Lg"
+#define ESYM "Le"
+#define FSYM "Lf"
+#else
+#define GSYM "g"
+#define ESYM "e"
+#define FSYM "f"
+#endif
+
+#define JSONFILE "ark_robertson_prof.json"
+#define MAXLINE  1024                   /* maximum length of the JSON text */
+
+/* User-supplied Functions Called by the Solver */
+static int f(realtype t, N_Vector y, N_Vector ydot, void *user_data);
+static int g(realtype t, N_Vector y, realtype *gout, void *user_data);
+
+/* Private helper functions */
+static int CheckProfile(void *arkode_mem, SUNProfile *prof);
+static int CheckJSON(const char *fname);
+
+/* Private function to check function return values */
+static int check_flag(void *flagvalue, const char *funcname, int opt);
+
+/* Main Program */
+int main()
+{
+  /* general problem parameters */
+  realtype T0 = RCONST(0.0);     /* initial time */
+  realtype T1 = RCONST(0.4);     /* first output time */
+  realtype TMult = RCONST(10.0); /* output time multiplication factor */
+  int Nt = 12;                   /* total number of output times */
+  sunindextype NEQ = 3;          /* number of dependent vars. */
+  realtype reltol;
+  int flag, fails;               /* reusable error-checking flags */
+  realtype t, tout;
+  int iout;
+  SUNProfile prof;
+  FILE *fp;
+
+  /* general problem variables */
+  N_Vector y = NULL;             /* empty vector for storing solution */
+  N_Vector atols = NULL;         /* empty vector for absolute tolerances */
+  SUNMatrix A = NULL;            /* empty matrix for linear solver */
+  SUNLinearSolver LS = NULL;     /* empty linear solver object */
+  void *arkode_mem = NULL;       /* empty ARKode memory structure */
+
+  /* Initialize data structures */
+  y = N_VNew_Serial(NEQ);        /* Create serial vector for solution */
+  if (check_flag((void *) y, "N_VNew_Serial", 0)) return 1;
+  atols = N_VNew_Serial(NEQ);    /* Create serial vector absolute tolerances */
+  if (check_flag((void *) atols, "N_VNew_Serial", 0)) return 1;
+  NV_Ith_S(y,0) = RCONST(1.0);   /* Set initial conditions into y */
+  NV_Ith_S(y,1) = RCONST(0.0);
+  NV_Ith_S(y,2) = RCONST(0.0);
+
+  /* Call ARKStepCreate to initialize the ARK timestepper module; the
+     problem is fully implicit, so f_E is NULL and f_I is f */
+  arkode_mem = ARKStepCreate(NULL, f, T0, y);
+  if (check_flag((void *)arkode_mem, "ARKStepCreate", 0)) return 1;
+
+  /* Set tolerances */
+  reltol = RCONST(1.0e-4);
+  NV_Ith_S(atols,0) = RCONST(1.0e-8);
+  NV_Ith_S(atols,1) = RCONST(1.0e-11);
+  NV_Ith_S(atols,2) = RCONST(1.0e-8);
+
+  /* Set routines */
+  flag = ARKStepSetMaxErrTestFails(arkode_mem, 20);        /* Increase max error test fails */
+  if (check_flag(&flag, "ARKStepSetMaxErrTestFails", 1)) return 1;
+  flag = ARKStepSetMaxNonlinIters(arkode_mem, 8);          /* Increase max nonlinear iterations  */
+  if (check_flag(&flag, "ARKStepSetMaxNonlinIters", 1)) return 1;
+  flag = ARKStepSetNonlinConvCoef(arkode_mem, 1.e-7);      /* Update nonlinear solver convergence coeff. */
+  if (check_flag(&flag, "ARKStepSetNonlinConvCoef", 1)) return 1;
+  flag = ARKStepSetMaxNumSteps(arkode_mem, 100000);        /* Increase max number of steps */
+  if (check_flag(&flag, "ARKStepSetMaxNumSteps", 1)) return 1;
+  flag = ARKStepSVtolerances(arkode_mem, reltol, atols);   /* Specify tolerances */
+  if (check_flag(&flag, "ARKStepSVtolerances", 1)) return 1;
+
+  /* Specify the root-finding function, having 2 equations */
+  flag = ARKStepRootInit(arkode_mem, 2, g);
+  if (check_flag(&flag, "ARKStepRootInit", 1)) return 1;
+
+  /* Attach the dense linear solver with its DQ Jacobian */
+  A = SUNDenseMatrix(NEQ, NEQ);
+  if (check_flag((void *)A, "SUNDenseMatrix", 0)) return 1;
+  LS = SUNLinSol_Dense(y, A);
+  if (check_flag((void *)LS, "SUNLinSol_Dense", 0)) return 1;
+  flag = ARKStepSetLinearSolver(arkode_mem, LS, A);
+  if (check_flag(&flag, "ARKStepSetLinearSolver", 1)) return 1;
+
+  /* Integrate to the output times, returning at roots as well */
+  printf("\nRobertson ODE test problem, profiled\n\n");
+
+  tout = T1;
+  iout = 0;
+  while (iout < Nt) {
+    flag = ARKStepEvolve(arkode_mem, tout, y, &t, ARK_NORMAL);
+    if (check_flag(&flag, "ARKStepEvolve", 1)) return 1;
+    if (flag == ARK_SUCCESS) {
+      iout++;
+      tout *= TMult;
+    }
+  }
+
+  printf("y = %14.6"ESYM"  %14.6"ESYM"  %14.6"ESYM" at t = %0.4"ESYM"\n\n",
+         NV_Ith_S(y,0), NV_Ith_S(y,1), NV_Ith_S(y,2), t);
+
+  /* Fetch the profile, check the calls and write it as JSON */
+  flag = ARKStepGetProfile(arkode_mem, &prof);
+  if (check_flag(&flag, "ARKStepGetProfile", 1)) return 1;
+
+  fails = CheckProfile(arkode_mem, &prof);
+
+  fp = fopen(JSONFILE, "w");
+  if (check_flag((void *)fp, "fopen", 0)) return 1;
+  flag = SUNProfile_WriteJSON(&prof, fp);
+  fclose(fp);
+  if (check_flag(&flag, "SUNProfile_WriteJSON", 1)) return 1;
+
+  fails += CheckJSON(JSONFILE);
+
+  /* Clean up and return with successful completion */
+  N_VDestroy(y);
+  N_VDestroy(atols);
+  ARKStepFree(&arkode_mem);
+  SUNLinSolFree(LS);
+  SUNMatDestroy(A);
+
+  if (fails) return 1;
+
+  printf("\nPASSED\n");
+  return 0;
+}
+
+/*-------------------------------
+ * Functions called by the solver
+ *-------------------------------*/
+
+/* f routine to compute the ODE RHS function f(t,y). */
+static int f(realtype t, N_Vector y, N_Vector ydot, void *user_data)
+{
+  realtype u = NV_Ith_S(y,0);   /* access current solution */
+  realtype v = NV_Ith_S(y,1);
+  realtype w = NV_Ith_S(y,2);
+
+  /* Fill in ODE RHS function */
+  NV_Ith_S(ydot,0) = -0.04*u + 1.e4*v*w;
+  NV_Ith_S(ydot,1) = 0.04*u - 1.e4*v*w - 3.e7*v*v;
+  NV_Ith_S(ydot,2) = 3.e7*v*v;
+
+  return 0;                     /* Return with success */
+}
+
+/* g routine to compute the root-finding function g(t,y). */
+static int g(realtype t, N_Vector y, realtype *gout, void *user_data)
+{
+  realtype u = NV_Ith_S(y,0);   /* access current solution */
+  realtype w = NV_Ith_S(y,2);
+
+  gout[0] = u - RCONST(0.0001);  /* check for u == 1e-4 */
+  gout[1] = w - RCONST(0.01);    /* check for w == 1e-2 */
+
+  return 0;                      /* Return with success */
+}
+
+/*-------------------------------
+ * Private helper functions
+ *-------------------------------*/
+
+/* Prints the number of calls of each phase and checks them against
+   the integrator counters. Returns the number of failed checks. */
+static int CheckProfile(void *arkode_mem, SUNProfile *prof)
+{
+  long int nst, nfe, nfi, nfeLS, nje, nsetups;
+  int flag, i, fails;
+
+  flag = ARKStepGetNumSteps(arkode_mem, &nst);
+  check_flag(&flag, "ARKStepGetNumSteps", 1);
+  flag = ARKStepGetNumRhsEvals(arkode_mem, &nfe, &nfi);
+  check_flag(&flag, "ARKStepGetNumRhsEvals", 1);
+  flag = ARKStepGetNumLinRhsEvals(arkode_mem, &nfeLS);
+  check_flag(&flag, "ARKStepGetNumLinRhsEvals", 1);
+  flag = ARKStepGetNumJacEvals(arkode_mem, &nje);
+  check_flag(&flag, "ARKStepGetNumJacEvals", 1);
+  flag = ARKStepGetNumLinSolvSetups(arkode_mem, &nsetups);
+  check_flag(&flag, "ARKStepGetNumLinSolvSetups", 1);
+
+  printf("Phase calls:\n");
+  for (i = 0; i < SUN_PROFILE_NPHASES; i++)
+    printf("  %-10s %ld\n", SUNProfile_PhaseName(i), prof->ncalls[i]);
+  printf("nst = %ld, nfe = %ld, nfi = %ld, nfeLS = %ld, nje = %ld, nsetups = %ld\n",
+         nst, nfe, nfi, nfeLS, nje, nsetups);
+
+  fails = 0;
+  if (prof->ncalls[SUN_PROFILE_RHS] != nfe + nfi + nfeLS) {
+    printf("FAIL: rhs calls differ from nfe + nfi + nfeLS\n");
+    fails++;
+  }
+  if (prof->ncalls[SUN_PROFILE_JAC] != nje) {
+    printf("FAIL: jac calls differ from nje\n");
+    fails++;
+  }
+  if (prof->ncalls[SUN_PROFILE_LSETUP] != nsetups) {
+    printf("FAIL: lsetup calls differ from nsetups\n");
+    fails++;
+  }
+  if (prof->ncalls[SUN_PROFILE_STEP] != nst) {
+    printf("FAIL: step calls differ from nst\n");
+    fails++;
+  }
+  for (i = 0; i < SUN_PROFILE_NPHASES; i++) {
+    if (prof->time[i] < 0.0 || (prof->ncalls[i] == 0 && prof->time[i] != 0.0)) {
+      printf("FAIL: bad time for phase %s\n", SUNProfile_PhaseName(i));
+      fails++;
+    }
+  }
+
+  return fails;
+}
+
+/* Reads back the JSON file and checks that it holds one object with
+   an entry for each phase. Returns the number of failed checks. */
+static int CheckJSON(const char *fname)
+{
+  char text[MAXLINE], key[32];
+  FILE *fp;
+  size_t len;
+  int i, fails;
+
+  fp = fopen(fname, "r");
+  if (check_flag((void *)fp, "fopen", 0)) return 1;
+  len = fread(text, 1, MAXLINE-1, fp);
+  fclose(fp);
+  text[len] = '\0';
+
+  fails = 0;
+  if (len < 2 || text[0] != '{' || strchr(text, '}') == NULL) {
+    printf("FAIL: %s does not hold a JSON object\n", fname);
+    fails++;
+  }
+  for (i = 0; i < SUN_PROFILE_NPHASES; i++) {
+    sprintf(key, "\"%s\": {", SUNProfile_PhaseName(i));
+    if (strstr(text, key) == NULL) {
+      printf("FAIL: phase %s missing from %s\n", SUNProfile_PhaseName(i), fname);
+      fails++;
+    }
+  }
+  if (fails == 0) printf("Profile written to %s\n", fname);
+
+  return fails;
+}
+
+/* Check function return value...
+    opt == 0 means SUNDIALS function allocates memory so check if
+             returned NULL pointer
+    opt == 1 means SUNDIALS function returns a flag so check if
+             flag >= 0
+    opt == 2 means function allocates memory so check if returned
+             NULL pointer
+*/
+static int check_flag(void *flagvalue, const char *funcname, int opt)
+{
+  int *errflag;
+
+  /* Check if SUNDIALS function returned NULL pointer - no memory allocated */
+  if (opt == 0 && flagvalue == NULL) {
+    fprintf(stderr, "\nSUNDIALS_ERROR: %s() failed - returned NULL pointer\n\n",
+            funcname);
+    return 1; }
+
+  /* Check if flag < 0 */
+  else if (opt == 1) {
+    errflag = (int *) flagvalue;
+    if (*errflag < 0) {
+      fprintf(stderr, "\nSUNDIALS_ERROR: %s() failed with flag = %d\n\n",
+              funcname, *errflag);
+      return 1; }}
+
+  /* Check if function returned NULL pointer - no memory allocated */
+  else if (opt == 2 && flagvalue == NULL) {
+    fprintf(stderr, "\nMEMORY_ERROR: %s() failed - returned NULL pointer\n\n",
+            funcname);
+    return 1; }
+
+  return 0;
+}
+
+
+/*---- end of file ----*/
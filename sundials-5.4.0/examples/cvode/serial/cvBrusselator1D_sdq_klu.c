@@ -0,0 +1,377 @@
+/* -----------------------------------------------------------------
+ * Programmer(s): based on cvAdvDiff_bnd.c and cvRoberts_klu.c
+ * -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2020, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * Example problem:
+ *
+ * The 1D Brusselator reaction-diffusion system
+ *    du/dt = d u_xx + a - (b+1) u + u^2 v
+ *    dv/dt = d v_xx + b u - u^2 v
+ * for 0 < x < 1, with Dirichlet boundary values u = a, v = b/a,
+ * is discretized with central differences on MX interior nodes.
+ * The unknowns are interleaved (u_1, v_1, u_2, v_2, ...), so the
+ * Jacobian is banded with half-bandwidths ml = mu = 2, but each row
+ * only has four nonzeros.
+ *
+ * The problem is solved twice with the BDF method and Newton
+ * iteration, both times with internal difference quotient (DQ)
+ * Jacobians: first with the band DQ Jacobian and the band linear
+ * solver, then with the colored sparse DQ Jacobian enabled by
+ * CVodeSetSparseDQJac and the KLU sparse direct linear solver. The
+ * two DQ Jacobians are the same matrix, so the two solutions must
+ * agree to well within the integration tolerances, and the sparse
+ * DQ Jacobian must not use more f evaluations per Jacobian than the
+ * band one (ml+mu+1). The program returns 1 if either check fails.
+ * -----------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <math.h>
+
+#include <cvode/cvode.h>                /* prototypes for CVODE fcts., consts.  */
+#include <nvector/nvector_serial.h>     /* access to serial N_Vector            */
+#include <sunmatrix/sunmatrix_band.h>   /* access to band SUNMatrix             */
+#include <sunmatrix/sunmatrix_sparse.h> /* access to sparse SUNMatrix           */
+#include <sunlinsol/sunlinsol_band.h>   /* access to band SUNLinearSolver       */
+#include <sunlinsol/sunlinsol_klu.h>    /* access to KLU sparse direct solver   */
+#include <sundials/sundials_types.h>    /* defs. of realtype, sunindextype      */
+#include <sundials/sundials_math.h>     /* defs. of SUNRabs, SUNMAX, etc.       */
+
+/* Problem Constants */
+
+#define MX      50               /* number of interior nodes      */
+#define NEQ     (2*MX)           /* number of equations           */
+#define MU      2                /* half-bandwidths of the band   */
+#define ML      2                /* Jacobian                      */
+#define ALPHA   RCONST(1.0)      /* Brusselator parameters a, b   */
+#define BETA    RCONST(3.0)
+#define DIFF    RCONST(0.1)      /* diffusion coefficient d       */
+#define RTOL    RCONST(1.0e-6)   /* scalar relative tolerance     */
+#define ATOL    RCONST(1.0e-9)   /* scalar absolute tolerance     */
+#define T0      RCONST(0.0)      /* initial time                  */
+#define T1      RCONST(2.0)      /* first output time             */
+#define DTOUT   RCONST(2.0)      /* output time increment         */
+#define NOUT    5                /* number of output times        */
+#define DIFFTOL RCONST(1.0e-6)   /* allowed difference of the two
+                                    solutions, relative to |y|    */
+
+#define ZERO    RCONST(0.0)
+#define HALF    RCONST(0.5)
+#define ONE     RCONST(1.0)
+#define TWO     RCONST(2.0)
+
+/* Functions Called by the Solver */
+
+static int f(realtype t, N_Vector y, N_Vector ydot, void *user_data);
+
+/* Private helper functions */
+
+static void SetIC(N_Vector y);
+static int SetPattern(SUNMatrix S);
+static void PrintFinalStats(void *cvode_mem, const char *name);
+
+/* Private function to check function return values */
+
+static int check_retval(void *returnvalue, const char *funcname, int opt);
+
+
+/*
+ *-------------------------------
+ * Main Program
+ *-------------------------------
+ */
+
+int main()
+{
+  realtype t, tout, dy, maxdiff;
+  N_Vector yb, ys;
+  SUNMatrix Ab, As, Jpat;
+  SUNLinearSolver LSb, LSs;
+  void *cvb_mem, *cvs_mem;
+  long int njeb, njes, nfeLSb, nfeLSs;
+  sunindextype i;
+  int retval, iout, passed;
+
+  yb = ys = NULL;
+  Ab = As = Jpat = NULL;
+  LSb = LSs = NULL;
+  cvb_mem = cvs_mem = NULL;
+
+  /* Create serial vectors of length NEQ for the two solutions */
+  yb = N_VNew_Serial(NEQ);
+  if (check_retval((void *)yb, "N_VNew_Serial", 0)) return(1);
+  ys = N_VNew_Serial(NEQ);
+  if (check_retval((void *)ys, "N_VNew_Serial", 0)) return(1);
+  SetIC(yb);
+  SetIC(ys);
+
+  /* Band DQ Jacobian with the band linear solver */
+  cvb_mem = CVodeCreate(CV_BDF);
+  if (check_retval((void *)cvb_mem, "CVodeCreate", 0)) return(1);
+  retval = CVodeInit(cvb_mem, f, T0, yb);
+  if (check_retval(&retval, "CVodeInit", 1)) return(1);
+  retval = CVodeSStolerances(cvb_mem, RTOL, ATOL);
+  if (check_retval(&retval, "CVodeSStolerances", 1)) return(1);
+  Ab = SUNBandMatrix(NEQ, MU, ML);
+  if (check_retval((void *)Ab, "SUNBandMatrix", 0)) return(1);
+  LSb = SUNLinSol_Band(yb, Ab);
+  if (check_retval((void *)LSb, "SUNLinSol_Band", 0)) return(1);
+  retval = CVodeSetLinearSolver(cvb_mem, LSb, Ab);
+  if (check_retval(&retval, "CVodeSetLinearSolver", 1)) return(1);
+
+  /* Colored sparse DQ Jacobian with the KLU linear solver */
+  cvs_mem = CVodeCreate(CV_BDF);
+  if (check_retval((void *)cvs_mem, "CVodeCreate", 0)) return(1);
+  retval = CVodeInit(cvs_mem, f, T0, ys);
+  if (check_retval(&retval, "CVodeInit", 1)) return(1);
+  retval = CVodeSStolerances(cvs_mem, RTOL, ATOL);
+  if (check_retval(&retval, "CVodeSStolerances", 1)) return(1);
+  As = SUNSparseMatrix(NEQ, NEQ, 4*NEQ, CSC_MAT);
+  if (check_retval((void *)As, "SUNSparseMatrix", 0)) return(1);
+  LSs = SUNLinSol_KLU(ys, As);
+  if (check_retval((void *)LSs, "SUNLinSol_KLU", 0)) return(1);
+  retval = CVodeSetLinearSolver(cvs_mem, LSs, As);
+  if (check_retval(&retval, "CVodeSetLinearSolver", 1)) return(1);
+
+  /* The sparsity pattern of the Jacobian, used to color its columns */
+  Jpat = SUNSparseMatrix(NEQ, NEQ, 4*NEQ, CSC_MAT);
+  if (check_retval((void *)Jpat, "SUNSparseMatrix", 0)) return(1);
+  retval = SetPattern(Jpat);
+  if (check_retval(&retval, "SetPattern", 1)) return(1);
+  retval = CVodeSetSparseDQJac(cvs_mem, Jpat, 1);
+  if (check_retval(&retval, "CVodeSetSparseDQJac", 1)) return(1);
+
+  /* In loop over output points, advance both solutions and compare */
+  printf(" \n1-D Brusselator, band vs. colored sparse DQ Jacobian\n\n");
+  printf("            t        u(mid)        v(mid)\n");
+  printf("   ---------------------------------------\n");
+
+  maxdiff = ZERO;
+  for (iout = 1, tout = T1; iout <= NOUT; iout++, tout += DTOUT) {
+    retval = CVode(cvb_mem, tout, yb, &t, CV_NORMAL);
+    if (check_retval(&retval, "CVode", 1)) return(1);
+    retval = CVode(cvs_mem, tout, ys, &t, CV_NORMAL);
+    if (check_retval(&retval, "CVode", 1)) return(1);
+
+    /* max |yb - ys| / (|yb| + ATOL) */
+    dy = ZERO;
+    for (i = 0; i < NEQ; i++)
+      dy = SUNMAX(dy, SUNRabs(NV_Ith_S(yb,i) - NV_Ith_S(ys,i)) /
+                      (SUNRabs(NV_Ith_S(yb,i)) + ATOL));
+    maxdiff = SUNMAX(maxdiff, dy);
+
+#if defined(SUNDIALS_EXTENDED_PRECISION)
+    printf("   %10.4Lf  %12.6Lf  %12.6Lf\n", t,
+           NV_Ith_S(yb,2*(MX/2)), NV_Ith_S(yb,2*(MX/2)+1));
+#else
+    printf("   %10.4f  %12.6f  %12.6f\n", t,
+           NV_Ith_S(yb,2*(MX/2)), NV_Ith_S(yb,2*(MX/2)+1));
+#endif
+  }
+
+  PrintFinalStats(cvb_mem, "band DQ Jacobian");
+  PrintFinalStats(cvs_mem, "colored sparse DQ Jacobian");
+
+  /* Check the solutions and the cost of the sparse DQ Jacobian */
+  retval = CVodeGetNumJacEvals(cvb_mem, &njeb);
+  check_retval(&retval, "CVodeGetNumJacEvals", 1);
+  retval = CVodeGetNumLinRhsEvals(cvb_mem, &nfeLSb);
+  check_retval(&retval, "CVodeGetNumLinRhsEvals", 1);
+  retval = CVodeGetNumJacEvals(cvs_mem, &njes);
+  check_retval(&retval, "CVodeGetNumJacEvals", 1);
+  retval = CVodeGetNumLinRhsEvals(cvs_mem, &nfeLSs);
+  check_retval(&retval, "CVodeGetNumLinRhsEvals", 1);
+
+  passed = 1;
+  if (maxdiff > DIFFTOL) {
+    printf("FAIL: the solutions differ by more than %g\n", (double) DIFFTOL);
+    passed = 0;
+  }
+  if ((njes < 1) || (nfeLSs > (ML+MU+1)*njes) || (nfeLSb != (ML+MU+1)*njeb)) {
+    printf("FAIL: unexpected number of f evaluations for DQ Jacobians\n");
+    passed = 0;
+  }
+  if (passed) printf("PASSED: the sparse DQ Jacobian matches the band DQ\n");
+
+  /* Free memory */
+  N_VDestroy(yb);
+  N_VDestroy(ys);
+  CVodeFree(&cvb_mem);
+  CVodeFree(&cvs_mem);
+  SUNLinSolFree(LSb);
+  SUNLinSolFree(LSs);
+  SUNMatDestroy(Ab);
+  SUNMatDestroy(As);
+  SUNMatDestroy(Jpat);
+
+  return(passed ? 0 : 1);
+}
+
+
+/*
+ *-------------------------------
+ * Functions called by the solver
+ *-------------------------------
+ */
+
+/*
+ * f routine. Compute f(t,y).
+ */
+
+static int f(realtype t, N_Vector y, N_Vector ydot, void *user_data)
+{
+  realtype *ydata, *dydata;
+  realtype u, v, ul, ur, vl, vr, c;
+  sunindextype i;
+
+  ydata  = N_VGetArrayPointer(y);
+  dydata = N_VGetArrayPointer(ydot);
+
+  c = DIFF * (MX+1) * (MX+1);   /* d / dx^2 */
+
+  for (i = 0; i < MX; i++) {
+    u  = ydata[2*i];
+    v  = ydata[2*i+1];
+    ul = (i > 0)    ? ydata[2*i-2] : ALPHA;
+    vl = (i > 0)    ? ydata[2*i-1] : BETA/ALPHA;
+    ur = (i < MX-1) ? ydata[2*i+2] : ALPHA;
+    vr = (i < MX-1) ? ydata[2*i+3] : BETA/ALPHA;
+
+    dydata[2*i]   = c*(ul - TWO*u + ur) + ALPHA - (BETA+ONE)*u + u*u*v;
+    dydata[2*i+1] = c*(vl - TWO*v + vr) + BETA*u - u*u*v;
+  }
+
+  return(0);
+}
+
+
+/*
+ *-------------------------------
+ * Private helper functions
+ *-------------------------------
+ */
+
+/* Perturbed steady state as initial condition */
+
+static void SetIC(N_Vector y)
+{
+  realtype *ydata, x;
+  sunindextype i;
+
+  ydata = N_VGetArrayPointer(y);
+
+  for (i = 0; i < MX; i++) {
+    x = (i+1) / (realtype) (MX+1);
+    ydata[2*i]   = ALPHA + HALF*sin(RCONST(3.14159265358979) * x);
+    ydata[2*i+1] = BETA/ALPHA;
+  }
+}
+
+/* Column pattern of df/dy: column 2i (u_i) appears in rows u_{i-1},
+   u_i, v_i and u_{i+1}, column 2i+1 (v_i) in rows v_{i-1}, u_i, v_i
+   and v_{i+1} */
+
+static int SetPattern(SUNMatrix S)
+{
+  sunindextype *colptrs, *rowvals;
+  sunindextype i, j, nz;
+
+  colptrs = SUNSparseMatrix_IndexPointers(S);
+  rowvals = SUNSparseMatrix_IndexValues(S);
+
+  nz = 0;
+  for (j = 0; j < NEQ; j++) {
+    i = j/2;
+    colptrs[j] = nz;
+    if (i > 0) rowvals[nz++] = j-2;
+    if (j % 2 == 0) {
+      rowvals[nz++] = j;
+      rowvals[nz++] = j+1;
+    } else {
+      rowvals[nz++] = j-1;
+      rowvals[nz++] = j;
+    }
+    if (i < MX-1) rowvals[nz++] = j+2;
+  }
+  colptrs[NEQ] = nz;
+
+  return(0);
+}
+
+/*
+ * Get and print some final statistics
+ */
+
+static void PrintFinalStats(void *cvode_mem, const char *name)
+{
+  long int nst, nfe, nsetups, nje, nfeLS, nni, ncfn, netf;
+  int retval;
+
+  retval = CVodeGetNumSteps(cvode_mem, &nst);
+  check_retval(&retval, "CVodeGetNumSteps", 1);
+  retval = CVodeGetNumRhsEvals(cvode_mem, &nfe);
+  check_retval(&retval, "CVodeGetNumRhsEvals", 1);
+  retval = CVodeGetNumLinSolvSetups(cvode_mem, &nsetups);
+  check_retval(&retval, "CVodeGetNumLinSolvSetups", 1);
+  retval = CVodeGetNumErrTestFails(cvode_mem, &netf);
+  check_retval(&retval, "CVodeGetNumErrTestFails", 1);
+  retval = CVodeGetNumNonlinSolvIters(cvode_mem, &nni);
+  check_retval(&retval, "CVodeGetNumNonlinSolvIters", 1);
+  retval = CVodeGetNumNonlinSolvConvFails(cvode_mem, &ncfn);
+  check_retval(&retval, "CVodeGetNumNonlinSolvConvFails", 1);
+  retval = CVodeGetNumJacEvals(cvode_mem, &nje);
+  check_retval(&retval, "CVodeGetNumJacEvals", 1);
+  retval = CVodeGetNumLinRhsEvals(cvode_mem, &nfeLS);
+  check_retval(&retval, "CVodeGetNumLinRhsEvals", 1);
+
+  printf("\nFinal Statistics, %s:\n", name);
+  printf("nst = %-6ld nfe  = %-6ld nsetups = %-6ld nfeLS = %-6ld nje = %ld\n",
+         nst, nfe, nsetups, nfeLS, nje);
+  printf("nni = %-6ld ncfn = %-6ld netf = %ld\n",
+         nni, ncfn, netf);
+}
+
+/*
+ * Check function return value...
+ *   opt == 0 means SUNDIALS function allocates memory so check if
+ *            returned NULL pointer
+ *   opt == 1 means SUNDIALS function returns an integer value so check if
+ *            retval < 0
+ *   opt == 2 means function allocates memory so check if returned
+ *            NULL pointer
+ */
+
+static int check_retval(void *returnvalue, const char *funcname, int opt)
+{
+  int *retval;
+
+  /* Check if SUNDIALS function returned NULL pointer - no memory allocated */
+  if (opt == 0 && returnvalue == NULL) {
+    fprintf(stderr, "\nSUNDIALS_ERROR: %s() failed - returned NULL pointer\n\n",
+            funcname);
+    return(1); }
+
+  /* Check if retval < 0 */
+  else if (opt == 1) {
+    retval = (int *) returnvalue;
+    if (*retval < 0) {
+      fprintf(stderr, "\nSUNDIALS_ERROR: %s() failed with retval = %d\n\n",
+              funcname, *retval);
+      return(1); }}
+
+  /* Check if function returned NULL pointer - no memory allocated */
+  else if (opt == 2 && returnvalue == NULL) {
+    fprintf(stderr, "\nMEMORY_ERROR: %s() failed - returned NULL pointer\n\n",
+            funcname);
+    return(1); }
+
+  return(0);
+}
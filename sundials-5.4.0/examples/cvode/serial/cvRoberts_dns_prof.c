@@ -0,0 +1,354 @@
+/* -----------------------------------------------------------------
+ * Programmer(s): based on cvRoberts_dns.c
+ * -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2020, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * Example problem:
+ *
+ * The Robertson chemical kinetics problem of cvRoberts_dns,
+ *    dy1/dt = -.04*y1 + 1.e4*y2*y3
+ *    dy2/dt = .04*y1 - 1.e4*y2*y3 - 3.e7*(y2)^2
+ *    dy3/dt = 3.e7*(y2)^2
+ * on the interval from t = 0.0 to t = 4.e10, with initial
+ * conditions: y1 = 1.0, y2 = y3 = 0, and the root functions
+ *    g1 = y1 - 0.0001,  g2 = y3 - 0.01,
+ * is solved with the BDF method, Newton iteration and the dense
+ * linear solver with its difference quotient Jacobian.
+ *
+ * This example requires SUNDIALS to be built with
+ * SUNDIALS_BUILD_WITH_PROFILING. After the integration, the phase
+ * timers are fetched with CVodeGetProfile and written as JSON to
+ * the file cvRoberts_dns_prof.json with SUNProfile_WriteJSON. The
+ * times vary from run to run, so only the number of calls of each
+ * phase is printed. These must agree with the integrator counters:
+ * the RHS phase counts the f calls of the integrator and of the DQ
+ * Jacobian, the Jacobian and linear setup phases count the Jacobian
+ * evaluations and linear solver setups, the step phase counts the
+ * steps, and each phase name must appear in the JSON file. The
+ * program returns 1 if a check fails.
+ * -----------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <string.h>
+
+#include <cvode/cvode.h>               /* prototypes for CVODE fcts., consts.  */
+#include <nvector/nvector_serial.h>    /* access to serial N_Vector            */
+#include <sunmatrix/sunmatrix_dense.h> /* access to dense SUNMatrix            */
+#include <sunlinsol/sunlinsol_dense.h> /* access to dense SUNLinearSolver      */
+#include <sundials/sundials_types.h>   /* defs. of realtype, sunindextype      */
+#include <sundials/sundials_profile.h> /* defs. of SUNProfile                  */
+
+/* Problem Constants */
+
+#define NEQ   3                /* number of equations  */
+#define Y1    RCONST(1.0)      /* initial y components */
+#define Y2    RCONST(0.0)
+#define Y3    RCONST(0.0)
+#define RTOL  RCONST(1.0e-4)   /* scalar relative tolerance            */
+#define ATOL1 RCONST(1.0e-8)   /* vector absolute tolerance components */
+#define ATOL2 RCONST(1.0e-14)
+#define ATOL3 RCONST(1.0e-6)
+#define T0    RCONST(0.0)      /* initial time           */
+#define T1    RCONST(0.4)      /* first output time      */
+#define TMULT RCONST(10.0)     /* output time factor     */
+#define NOUT  12               /* number of output times */
+
+#define JSONFILE "cvRoberts_dns_prof.json"
+#define MAXLINE  1024          /* maximum length of the JSON text */
+
+/* Functions Called by the Solver */
+
+static int f(realtype t, N_Vector y, N_Vector ydot, void *user_data);
+
+static int g(realtype t, N_Vector y, realtype *gout, void *user_data);
+
+/* Private helper functions */
+
+static int CheckProfile(void *cvode_mem, SUNProfile *prof);
+static int CheckJSON(const char *fname);
+
+/* Private function to check function return values */
+
+static int check_retval(void *returnvalue, const char *funcname, int opt);
+
+/*
+ *-------------------------------
+ * Main Program
+ *-------------------------------
+ */
+
+int main()
+{
+  realtype t, tout;
+  N_Vector y, abstol;
+  SUNMatrix A;
+  SUNLinearSolver LS;
+  void *cvode_mem;
+  SUNProfile prof;
+  FILE *fp;
+  int retval, iout, fails;
+
+  y = abstol = NULL;
+  A = NULL;
+  LS = NULL;
+  cvode_mem = NULL;
+
+  /* Create serial vectors and set the initial conditions and tolerances */
+  y = N_VNew_Serial(NEQ);
+  if (check_retval((void *)y, "N_VNew_Serial", 0)) return(1);
+  abstol = N_VNew_Serial(NEQ);
+  if (check_retval((void *)abstol, "N_VNew_Serial", 0)) return(1);
+
+  NV_Ith_S(y,0) = Y1;
+  NV_Ith_S(y,1) = Y2;
+  NV_Ith_S(y,2) = Y3;
+
+  NV_Ith_S(abstol,0) = ATOL1;
+  NV_Ith_S(abstol,1) = ATOL2;
+  NV_Ith_S(abstol,2) = ATOL3;
+
+  /* Create and initialize CVODE with the BDF method */
+  cvode_mem = CVodeCreate(CV_BDF);
+  if (check_retval((void *)cvode_mem, "CVodeCreate", 0)) return(1);
+
+  retval = CVodeInit(cvode_mem, f, T0, y);
+  if (check_retval(&retval, "CVodeInit", 1)) return(1);
+
+  retval = CVodeSVtolerances(cvode_mem, RTOL, abstol);
+  if (check_retval(&retval, "CVodeSVtolerances", 1)) return(1);
+
+  retval = CVodeRootInit(cvode_mem, 2, g);
+  if (check_retval(&retval, "CVodeRootInit", 1)) return(1);
+
+  /* Attach the dense linear solver with its DQ Jacobian */
+  A = SUNDenseMatrix(NEQ, NEQ);
+  if (check_retval((void *)A, "SUNDenseMatrix", 0)) return(1);
+
+  LS = SUNLinSol_Dense(y, A);
+  if (check_retval((void *)LS, "SUNLinSol_Dense", 0)) return(1);
+
+  retval = CVodeSetLinearSolver(cvode_mem, LS, A);
+  if (check_retval(&retval, "CVodeSetLinearSolver", 1)) return(1);
+
+  /* Integrate to the output times, returning at roots as well */
+  printf("\n3-species kinetics problem, profiled\n\n");
+
+  iout = 0;
+  tout = T1;
+  while (iout < NOUT) {
+    retval = CVode(cvode_mem, tout, y, &t, CV_NORMAL);
+    if (check_retval(&retval, "CVode", 1)) return(1);
+
+    if (retval == CV_SUCCESS) {
+      iout++;
+      tout *= TMULT;
+    }
+  }
+
+  printf("y = %14.6e  %14.6e  %14.6e at t = %0.4e\n\n",
+         NV_Ith_S(y,0), NV_Ith_S(y,1), NV_Ith_S(y,2), t);
+
+  /* Fetch the profile, check the calls and write it as JSON */
+  retval = CVodeGetProfile(cvode_mem, &prof);
+  if (check_retval(&retval, "CVodeGetProfile", 1)) return(1);
+
+  fails = CheckProfile(cvode_mem, &prof);
+
+  fp = fopen(JSONFILE, "w");
+  if (check_retval((void *)fp, "fopen", 2)) return(1);
+  retval = SUNProfile_WriteJSON(&prof, fp);
+  fclose(fp);
+  if (check_retval(&retval, "SUNProfile_WriteJSON", 1)) return(1);
+
+  fails += CheckJSON(JSONFILE);
+
+  /* Free memory */
+  N_VDestroy(y);
+  N_VDestroy(abstol);
+  CVodeFree(&cvode_mem);
+  SUNLinSolFree(LS);
+  SUNMatDestroy(A);
+
+  if (fails) return(1);
+
+  printf("\nPASSED\n");
+  return(0);
+}
+
+/*
+ *-------------------------------
+ * Functions called by the solver
+ *-------------------------------
+ */
+
+/*
+ * f routine. Compute function f(t,y).
+ */
+
+static int f(realtype t, N_Vector y, N_Vector ydot, void *user_data)
+{
+  realtype y1, y2, y3, yd1, yd3;
+
+  y1 = NV_Ith_S(y,0); y2 = NV_Ith_S(y,1); y3 = NV_Ith_S(y,2);
+
+  yd1 = NV_Ith_S(ydot,0) = RCONST(-0.04)*y1 + RCONST(1.0e4)*y2*y3;
+  yd3 = NV_Ith_S(ydot,2) = RCONST(3.0e7)*y2*y2;
+        NV_Ith_S(ydot,1) = -yd1 - yd3;
+
+  return(0);
+}
+
+/*
+ * g routine. Compute functions g_i(t,y) for i = 0,1.
+ */
+
+static int g(realtype t, N_Vector y, realtype *gout, void *user_data)
+{
+  realtype y1, y3;
+
+  y1 = NV_Ith_S(y,0); y3 = NV_Ith_S(y,2);
+  gout[0] = y1 - RCONST(0.0001);
+  gout[1] = y3 - RCONST(0.01);
+
+  return(0);
+}
+
+/*
+ *-------------------------------
+ * Private helper functions
+ *-------------------------------
+ */
+
+/*
+ * Prints the number of calls of each phase and checks them against
+ * the integrator counters. Returns the number of failed checks.
+ */
+
+static int CheckProfile(void *cvode_mem, SUNProfile *prof)
+{
+  long int nst, nfe, nfeLS, nje, nsetups;
+  int retval, i, fails;
+
+  retval = CVodeGetNumRhsEvals(cvode_mem, &nfe);
+  check_retval(&retval, "CVodeGetNumRhsEvals", 1);
+  retval = CVodeGetNumLinRhsEvals(cvode_mem, &nfeLS);
+  check_retval(&retval, "CVodeGetNumLinRhsEvals", 1);
+  retval = CVodeGetNumJacEvals(cvode_mem, &nje);
+  check_retval(&retval, "CVodeGetNumJacEvals", 1);
+  retval = CVodeGetNumLinSolvSetups(cvode_mem, &nsetups);
+  check_retval(&retval, "CVodeGetNumLinSolvSetups", 1);
+  retval = CVodeGetNumSteps(cvode_mem, &nst);
+  check_retval(&retval, "CVodeGetNumSteps", 1);
+
+  printf("Phase calls:\n");
+  for (i = 0; i < SUN_PROFILE_NPHASES; i++)
+    printf("  %-10s %ld\n", SUNProfile_PhaseName(i), prof->ncalls[i]);
+  printf("nst = %ld, nfe = %ld, nfeLS = %ld, nje = %ld, nsetups = %ld\n",
+         nst, nfe, nfeLS, nje, nsetups);
+
+  fails = 0;
+  if (prof->ncalls[SUN_PROFILE_RHS] != nfe + nfeLS) {
+    printf("FAIL: rhs calls differ from nfe + nfeLS\n");
+    fails++;
+  }
+  if (prof->ncalls[SUN_PROFILE_JAC] != nje) {
+    printf("FAIL: jac calls differ from nje\n");
+    fails++;
+  }
+  if (prof->ncalls[SUN_PROFILE_LSETUP] != nsetups) {
+    printf("FAIL: lsetup calls differ from nsetups\n");
+    fails++;
+  }
+  if (prof->ncalls[SUN_PROFILE_STEP] != nst) {
+    printf("FAIL: step calls differ from nst\n");
+    fails++;
+  }
+  for (i = 0; i < SUN_PROFILE_NPHASES; i++) {
+    if (prof->time[i] < 0.0 || (prof->ncalls[i] == 0 && prof->time[i] != 0.0)) {
+      printf("FAIL: bad time for phase %s\n", SUNProfile_PhaseName(i));
+      fails++;
+    }
+  }
+
+  return(fails);
+}
+
+/*
+ * Reads back the JSON file and checks that it holds one object with
+ * an entry for each phase. Returns the number of failed checks.
+ */
+
+static int CheckJSON(const char *fname)
+{
+  char text[MAXLINE], key[32];
+  FILE *fp;
+  size_t len;
+  int i, fails;
+
+  fp = fopen(fname, "r");
+  if (check_retval((void *)fp, "fopen", 2)) return(1);
+  len = fread(text, 1, MAXLINE-1, fp);
+  fclose(fp);
+  text[len] = '\0';
+
+  fails = 0;
+  if (len < 2 || text[0] != '{' || strchr(text, '}') == NULL) {
+    printf("FAIL: %s does not hold a JSON object\n", fname);
+    fails++;
+  }
+  for (i = 0; i < SUN_PROFILE_NPHASES; i++) {
+    sprintf(key, "\"%s\": {", SUNProfile_PhaseName(i));
+    if (strstr(text, key) == NULL) {
+      printf("FAIL: phase %s missing from %s\n", SUNProfile_PhaseName(i), fname);
+      fails++;
+    }
+  }
+  if (fails == 0) printf("Profile written to %s\n", fname);
+
+  return(fails);
+}
+
+/*
+ * Check function return value...
+ *   opt == 0 means SUNDIALS function allocates memory so check if
+ *            returned NULL pointer
+ *   opt == 1 means SUNDIALS function returns an integer value so check if
+ *            retval < 0
+ *   opt == 2 means function allocates memory so check if returned
+ *            NULL pointer
+ */
+
+static int check_retval(void *returnvalue, const char *funcname, int opt)
+{
+  int *retval;
+
+  /* Check if SUNDIALS function returned NULL pointer - no memory allocated */
+  if (opt == 0 && returnvalue == NULL) {
+    fprintf(stderr, "\nSUNDIALS_ERROR: %s() failed - returned NULL pointer\n\n",
+            funcname);
+    return(1); }
+
+  /* Check if retval < 0 */
+  else if (opt == 1) {
+    retval = (int *) returnvalue;
+    if (*retval < 0) {
+      fprintf(stderr, "\nSUNDIALS_ERROR: %s() failed with retval = %d\n\n",
+              funcname, *retval);
+      return(1); }}
+
+  /* Check if function returned NULL pointer - no memory allocated */
+  else if (opt == 2 && returnvalue == NULL) {
+    fprintf(stderr, "\nMEMORY_ERROR: %s() failed - returned NULL pointer\n\n",
+            funcname);
+    return(1); }
+
+  return(0);
+}
@@ -0,0 +1,299 @@
+/* -----------------------------------------------------------------
+ * Programmer(s): based on cvRoberts_dns.c
+ * -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2020, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * Example problem:
+ *
+ * The scalar ODE dy/dt = 1, y(0) = 0, is integrated to t = 4 with
+ * the root function
+ *    g(t,y) = (y - R1)(y - R2),   R1 = 1.03, R2 = 1.21,
+ * which changes sign twice, at t = R1 and t = R2. The initial and
+ * maximum step sizes are set to 2, so that the first step covers
+ * both roots and g has the same sign at both of its ends.
+ *
+ * The problem is solved twice, with CV_ONE_STEP and the dense linear
+ * solver. With the default of one root search point, only the sign
+ * of g at the end of each step is checked, and both roots are
+ * missed. With NPTS points set by CVodeSetRootSearchPoints, g is
+ * also sampled inside the step, and both roots must be reported.
+ *
+ * The root finding counters of CVodeGetRootfindStats are checked
+ * after each return: the passes and g evaluations of all steps, as
+ * reported at the last return in each step, must add up to the
+ * total number of passes and to CVodeGetNumGEvals (less the g
+ * evaluation at t0). The program returns 1 if any check fails.
+ * -----------------------------------------------------------------*/
+
+#include <stdio.h>
+
+#include <cvode/cvode.h>               /* prototypes for CVODE fcts., consts.  */
+#include <nvector/nvector_serial.h>    /* access to serial N_Vector            */
+#include <sunmatrix/sunmatrix_dense.h> /* access to dense SUNMatrix            */
+#include <sunlinsol/sunlinsol_dense.h> /* access to dense SUNLinearSolver      */
+#include <sundials/sundials_types.h>   /* defs. of realtype, sunindextype      */
+#include <sundials/sundials_math.h>    /* defs. of SUNRabs, etc.               */
+
+/* Problem Constants */
+
+#define NEQ     1                /* number of equations           */
+#define R1      RCONST(1.03)     /* the two roots of g            */
+#define R2      RCONST(1.21)
+#define RTOL    RCONST(1.0e-6)   /* scalar relative tolerance     */
+#define ATOL    RCONST(1.0e-8)   /* scalar absolute tolerance     */
+#define T0      RCONST(0.0)      /* initial time                  */
+#define TEND    RCONST(4.0)      /* final time                    */
+#define HSTEP   RCONST(2.0)      /* initial and maximum step size */
+#define NPTS    8                /* root search points            */
+#define MAXRT   4                /* maximum number of roots kept  */
+#define ROOTTOL RCONST(1.0e-6)   /* allowed error in the roots    */
+
+#define ZERO    RCONST(0.0)
+#define ONE     RCONST(1.0)
+
+/* Functions Called by the Solver */
+
+static int f(realtype t, N_Vector y, N_Vector ydot, void *user_data);
+
+static int g(realtype t, N_Vector y, realtype *gout, void *user_data);
+
+/* Private helper functions */
+
+static int RunRoots(int npoints, realtype *troots, int *nroots);
+
+/* Private function to check function return values */
+
+static int check_retval(void *returnvalue, const char *funcname, int opt);
+
+/*
+ *-------------------------------
+ * Main Program
+ *-------------------------------
+ */
+
+int main()
+{
+  realtype troots[MAXRT];
+  int nroots, fails;
+
+  printf("\ndy/dt = 1, g = (y - %g)(y - %g), first step [0, %g]\n",
+         R1, R2, HSTEP);
+
+  fails = 0;
+
+  /* With one search point, the two roots in the first step are missed */
+  printf("\nRoot search points = 1\n");
+  if (RunRoots(1, troots, &nroots)) return(1);
+  if (nroots != 0) {
+    printf("FAIL: %d roots found with one search point, expected 0\n",
+           nroots);
+    fails++;
+  }
+
+  /* With NPTS search points, both roots must be found */
+  printf("\nRoot search points = %d\n", NPTS);
+  if (RunRoots(NPTS, troots, &nroots)) return(1);
+  if (nroots != 2 ||
+      SUNRabs(troots[0] - R1) > ROOTTOL || SUNRabs(troots[1] - R2) > ROOTTOL) {
+    printf("FAIL: expected roots at t = %g and t = %g\n", R1, R2);
+    fails++;
+  }
+
+  if (fails) return(1);
+
+  printf("\nPASSED\n");
+  return(0);
+}
+
+/*
+ *-------------------------------
+ * Functions called by the solver
+ *-------------------------------
+ */
+
+/*
+ * f routine. Compute function f(t,y).
+ */
+
+static int f(realtype t, N_Vector y, N_Vector ydot, void *user_data)
+{
+  NV_Ith_S(ydot,0) = ONE;
+  return(0);
+}
+
+/*
+ * g routine. Compute the root function g(t,y).
+ */
+
+static int g(realtype t, N_Vector y, realtype *gout, void *user_data)
+{
+  realtype y1 = NV_Ith_S(y,0);
+
+  gout[0] = (y1 - R1)*(y1 - R2);
+  return(0);
+}
+
+/*
+ *-------------------------------
+ * Private helper functions
+ *-------------------------------
+ */
+
+/*
+ * Integrates the problem with npoints root search points, returning
+ * the roots found in troots[0..nroots-1]. Returns 1 if a SUNDIALS
+ * function fails or if the root finding counters do not add up.
+ */
+
+static int RunRoots(int npoints, realtype *troots, int *nroots)
+{
+  void *cvode_mem;
+  N_Vector y;
+  SUNMatrix A;
+  SUNLinearSolver LS;
+  realtype t;
+  long int nst, nstprev, nge, nrtiters;
+  long int ngevals_step, nrtiters_step, nge_last, nrt_last;
+  long int nge_sum, nrt_sum;
+  int retval, flag, rootsfound[1], ok;
+
+  y = N_VNew_Serial(NEQ);
+  if (check_retval((void *)y, "N_VNew_Serial", 0)) return(1);
+  NV_Ith_S(y,0) = ZERO;
+
+  cvode_mem = CVodeCreate(CV_BDF);
+  if (check_retval((void *)cvode_mem, "CVodeCreate", 0)) return(1);
+
+  retval = CVodeInit(cvode_mem, f, T0, y);
+  if (check_retval(&retval, "CVodeInit", 1)) return(1);
+
+  retval = CVodeSStolerances(cvode_mem, RTOL, ATOL);
+  if (check_retval(&retval, "CVodeSStolerances", 1)) return(1);
+
+  retval = CVodeSetInitStep(cvode_mem, HSTEP);
+  if (check_retval(&retval, "CVodeSetInitStep", 1)) return(1);
+
+  retval = CVodeSetMaxStep(cvode_mem, HSTEP);
+  if (check_retval(&retval, "CVodeSetMaxStep", 1)) return(1);
+
+  retval = CVodeSetStopTime(cvode_mem, TEND);
+  if (check_retval(&retval, "CVodeSetStopTime", 1)) return(1);
+
+  retval = CVodeRootInit(cvode_mem, 1, g);
+  if (check_retval(&retval, "CVodeRootInit", 1)) return(1);
+
+  retval = CVodeSetRootSearchPoints(cvode_mem, npoints);
+  if (check_retval(&retval, "CVodeSetRootSearchPoints", 1)) return(1);
+
+  A = SUNDenseMatrix(NEQ, NEQ);
+  if (check_retval((void *)A, "SUNDenseMatrix", 0)) return(1);
+
+  LS = SUNLinSol_Dense(y, A);
+  if (check_retval((void *)LS, "SUNLinSol_Dense", 0)) return(1);
+
+  retval = CVodeSetLinearSolver(cvode_mem, LS, A);
+  if (check_retval(&retval, "CVodeSetLinearSolver", 1)) return(1);
+
+  /* Step to TEND. The counters of a step are added up at the first
+     return from the next step, when they are final. */
+  *nroots = 0;
+  nstprev = 0;
+  nge_last = nrt_last = 0;
+  nge_sum = nrt_sum = 0;
+  t = T0;
+  while (t < TEND) {
+    flag = CVode(cvode_mem, TEND, y, &t, CV_ONE_STEP);
+    if (check_retval(&flag, "CVode", 1)) return(1);
+
+    retval = CVodeGetNumSteps(cvode_mem, &nst);
+    check_retval(&retval, "CVodeGetNumSteps", 1);
+    retval = CVodeGetRootfindStats(cvode_mem, &nrtiters, &ngevals_step,
+                                   &nrtiters_step);
+    check_retval(&retval, "CVodeGetRootfindStats", 1);
+
+    if (nst != nstprev) {
+      nge_sum += nge_last;
+      nrt_sum += nrt_last;
+      nstprev = nst;
+    }
+    nge_last = ngevals_step;
+    nrt_last = nrtiters_step;
+
+    printf("t = %-8.4f nst = %ld  step: passes = %ld, g evals = %ld",
+           t, nst, nrtiters_step, ngevals_step);
+
+    if (flag == CV_ROOT_RETURN) {
+      retval = CVodeGetRootInfo(cvode_mem, rootsfound);
+      if (check_retval(&retval, "CVodeGetRootInfo", 1)) return(1);
+      printf("  root, direction %d", rootsfound[0]);
+      if (*nroots < MAXRT) troots[*nroots] = t;
+      (*nroots)++;
+    }
+    printf("\n");
+  }
+  nge_sum += nge_last;
+  nrt_sum += nrt_last;
+
+  retval = CVodeGetNumGEvals(cvode_mem, &nge);
+  check_retval(&retval, "CVodeGetNumGEvals", 1);
+
+  printf("Roots found = %d, passes = %ld, g evals = %ld\n",
+         *nroots, nrtiters, nge);
+
+  ok = (nrt_sum == nrtiters) && (nge_sum + 1 == nge);
+  if (!ok)
+    printf("FAIL: per step counters add up to %ld passes and %ld g evals\n",
+           nrt_sum, nge_sum + 1);
+
+  N_VDestroy(y);
+  CVodeFree(&cvode_mem);
+  SUNLinSolFree(LS);
+  SUNMatDestroy(A);
+
+  return(ok ? 0 : 1);
+}
+
+/*
+ * Check function return value...
+ *   opt == 0 means SUNDIALS function allocates memory so check if
+ *            returned NULL pointer
+ *   opt == 1 means SUNDIALS function returns an integer value so check if
+ *            retval < 0
+ *   opt == 2 means function allocates memory so check if returned
+ *            NULL pointer
+ */
+
+static int check_retval(void *returnvalue, const char *funcname, int opt)
+{
+  int *retval;
+
+  /* Check if SUNDIALS function returned NULL pointer - no memory allocated */
+  if (opt == 0 && returnvalue == NULL) {
+    fprintf(stderr, "\nSUNDIALS_ERROR: %s() failed - returned NULL pointer\n\n",
+            funcname);
+    return(1); }
+
+  /* Check if retval < 0 */
+  else if (opt == 1) {
+    retval = (int *) returnvalue;
+    if (*retval < 0) {
+      fprintf(stderr, "\nSUNDIALS_ERROR: %s() failed with retval = %d\n\n",
+              funcname, *retval);
+      return(1); }}
+
+  /* Check if function returned NULL pointer - no memory allocated */
+  else if (opt == 2 && returnvalue == NULL) {
+    fprintf(stderr, "\nMEMORY_ERROR: %s() failed - returned NULL pointer\n\n",
+            funcname);
+    return(1); }
+
+  return(0);
+}
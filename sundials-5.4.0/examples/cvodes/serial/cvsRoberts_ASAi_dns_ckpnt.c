@@ -0,0 +1,594 @@
+/* -----------------------------------------------------------------
+ * Programmer(s): based on cvsRoberts_ASAi_dns.c by Radu Serban @ LLNL
+ * -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2020, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * Adjoint sensitivity example problem with non-default check point
+ * handling.
+ *
+ * This is the chemical kinetics problem of cvsRoberts_ASAi_dns,
+ *    dy1/dt = -p1*y1 + p2*y2*y3
+ *    dy2/dt =  p1*y1 - p2*y2*y3 - p3*(y2)^2
+ *    dy3/dt =  p3*(y2)^2
+ * with y1 = 1.0, y2 = y3 = 0 at t = 0, for which CVODES computes
+ * the gradient dG/dp of
+ *   G = int_t0^t1 y3 dt
+ * with respect to p1, p2 and p3 by a backward integration from
+ * t1 = 4.e7 to t0 = 0.
+ *
+ * The adjoint problem is solved twice. The first run uses the
+ * default check point handling (every check point kept in memory).
+ * The second run uses the variant given on the command line:
+ *   max  : keep at most MAXCKPNTS check points in memory
+ *          (CVodeSetAdjMaxCheckPoints); the dropped check points
+ *          are recomputed during the backward integration.
+ *   file : keep the check point data in a temporary file
+ *          (CVodeSetAdjCheckPointStorage with CV_CKPNT_FILE).
+ * Both variants only change where the forward solution is stored,
+ * not how it is computed, so lambda(t0) and dG/dp must match the
+ * default run. The program returns 1 if they do not.
+ * -----------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <cvodes/cvodes.h>             /* prototypes for CVODE fcts., consts.  */
+#include <nvector/nvector_serial.h>    /* access to serial N_Vector            */
+#include <sunmatrix/sunmatrix_dense.h> /* access to dense SUNMatrix            */
+#include <sunlinsol/sunlinsol_dense.h> /* access to dense SUNLinearSolver      */
+#include <sundials/sundials_types.h>   /* defs. of realtype, sunindextype      */
+#include <sundials/sundials_math.h>    /* defs. of SUNRabs, SUNRexp, etc.      */
+
+/* Accessor macros */
+
+#define Ith(v,i)    NV_Ith_S(v,i-1)         /* i-th vector component, i=1..NEQ */
+#define IJth(A,i,j) SM_ELEMENT_D(A,i-1,j-1) /* (i,j)-th matrix el., i,j=1..NEQ */
+
+/* Problem Constants */
+
+#define NEQ      3             /* number of equations                  */
+
+#define RTOL     RCONST(1e-6)  /* scalar relative tolerance            */
+
+#define ATOL1    RCONST(1e-8)  /* vector absolute tolerance components */
+#define ATOL2    RCONST(1e-14)
+#define ATOL3    RCONST(1e-6)
+
+#define ATOLl    RCONST(1e-8)  /* absolute tolerance for adjoint vars. */
+#define ATOLq    RCONST(1e-6)  /* absolute tolerance for quadratures   */
+
+#define T0       RCONST(0.0)   /* initial time                         */
+#define TOUT     RCONST(4e7)   /* final time                           */
+
+#define TB1      RCONST(4e7)   /* starting point for adjoint problem   */
+
+#define STEPS    20            /* number of steps between check points */
+#define MAXCKPNTS 4            /* check point budget for variant 'max' */
+
+#define NP       3             /* number of problem parameters         */
+
+#define ZERO     RCONST(0.0)
+#define DIFFTOL  RCONST(1e-10) /* allowed relative difference between
+                                  the default and the variant run      */
+
+/* Check point handling of a run */
+
+enum { CKPNT_DEFAULT, CKPNT_MAX, CKPNT_FILE };
+
+/* Type : UserData */
+
+typedef struct {
+  realtype p[3];
+} *UserData;
+
+/* Prototypes of user-supplied functions */
+
+static int f(realtype t, N_Vector y, N_Vector ydot, void *user_data);
+static int Jac(realtype t, N_Vector y, N_Vector fy, SUNMatrix J,
+               void *user_data, N_Vector tmp1, N_Vector tmp2, N_Vector tmp3);
+static int fQ(realtype t, N_Vector y, N_Vector qdot, void *user_data);
+static int ewt(N_Vector y, N_Vector w, void *user_data);
+
+static int fB(realtype t, N_Vector y,
+              N_Vector yB, N_Vector yBdot, void *user_dataB);
+static int JacB(realtype t, N_Vector y, N_Vector yB, N_Vector fyB, SUNMatrix JB,
+                void *user_dataB, N_Vector tmp1B, N_Vector tmp2B, N_Vector tmp3B);
+static int fQB(realtype t, N_Vector y, N_Vector yB,
+               N_Vector qBdot, void *user_dataB);
+
+
+/* Prototypes of private functions */
+
+static int RunASA(int ckpnt, UserData data, N_Vector yB, N_Vector qB);
+static realtype MaxRelDiff(N_Vector u, N_Vector v);
+static void PrintOutput(N_Vector yB, N_Vector qB);
+static int check_retval(void *returnvalue, const char *funcname, int opt);
+
+/*
+ *--------------------------------------------------------------------
+ * MAIN PROGRAM
+ *--------------------------------------------------------------------
+ */
+
+int main(int argc, char *argv[])
+{
+  UserData data;
+  N_Vector yB0, qB0, yB1, qB1;
+  realtype diff;
+  int ckpnt, retval;
+
+  data = NULL;
+  yB0 = qB0 = yB1 = qB1 = NULL;
+
+  /* Parse the check point variant */
+  ckpnt = -1;
+  if (argc > 1) {
+    if (strcmp(argv[1], "max") == 0)  ckpnt = CKPNT_MAX;
+    if (strcmp(argv[1], "file") == 0) ckpnt = CKPNT_FILE;
+  }
+  if (ckpnt < 0) {
+    printf("\nUsage: %s max|file\n", argv[0]);
+    printf("  max  : at most %d check points in memory\n", MAXCKPNTS);
+    printf("  file : check points stored in a temporary file\n\n");
+    return(1);
+  }
+
+  /* Print problem description */
+  printf("\nAdjoint Sensitivity Example for Chemical Kinetics\n");
+  printf("-------------------------------------------------\n\n");
+  printf("ODE: dy1/dt = -p1*y1 + p2*y2*y3\n");
+  printf("     dy2/dt =  p1*y1 - p2*y2*y3 - p3*(y2)^2\n");
+  printf("     dy3/dt =  p3*(y2)^2\n\n");
+  printf("Find dG/dp for\n");
+  printf("     G = int_t0^tB0 g(t,p,y) dt\n");
+  printf("     g(t,p,y) = y3\n\n");
+  if (ckpnt == CKPNT_MAX)
+    printf("Check points: default vs. at most %d in memory\n\n", MAXCKPNTS);
+  else
+    printf("Check points: default vs. stored in a file\n\n");
+
+  /* User data structure */
+  data = (UserData) malloc(sizeof *data);
+  if (check_retval((void *)data, "malloc", 2)) return(1);
+  data->p[0] = RCONST(0.04);
+  data->p[1] = RCONST(1.0e4);
+  data->p[2] = RCONST(3.0e7);
+
+  /* Adjoint solutions and quadratures at t0 of the two runs */
+  yB0 = N_VNew_Serial(NEQ);
+  if (check_retval((void *)yB0, "N_VNew_Serial", 0)) return(1);
+  qB0 = N_VNew_Serial(NP);
+  if (check_retval((void *)qB0, "N_VNew_Serial", 0)) return(1);
+  yB1 = N_VNew_Serial(NEQ);
+  if (check_retval((void *)yB1, "N_VNew_Serial", 0)) return(1);
+  qB1 = N_VNew_Serial(NP);
+  if (check_retval((void *)qB1, "N_VNew_Serial", 0)) return(1);
+
+  /* Default run */
+  printf("Default check points:\n");
+  retval = RunASA(CKPNT_DEFAULT, data, yB0, qB0);
+  if (check_retval(&retval, "RunASA", 1)) return(1);
+  PrintOutput(yB0, qB0);
+
+  /* Variant run */
+  printf("%s check points:\n", (ckpnt == CKPNT_MAX) ? "Limited" : "File");
+  retval = RunASA(ckpnt, data, yB1, qB1);
+  if (check_retval(&retval, "RunASA", 1)) return(1);
+  PrintOutput(yB1, qB1);
+
+  /* Compare lambda(t0) and dG/dp */
+  diff = SUNMAX(MaxRelDiff(yB0, yB1), MaxRelDiff(qB0, qB1));
+  if (diff > DIFFTOL) {
+    printf("FAIL: the adjoint sensitivities differ from the default run\n");
+    retval = 1;
+  } else {
+    printf("PASSED: the adjoint sensitivities match the default run\n");
+    retval = 0;
+  }
+
+  /* Free memory */
+  N_VDestroy(yB0);
+  N_VDestroy(qB0);
+  N_VDestroy(yB1);
+  N_VDestroy(qB1);
+  free(data);
+
+  return(retval);
+}
+
+/*
+ * RunASA: forward run with the given check point handling, then the
+ * backward run from TB1 to T0. Returns lambda(t0) in yB and the
+ * backward quadratures (-dG/dp) in qB.
+ */
+
+static int RunASA(int ckpnt, UserData data, N_Vector yB, N_Vector qB)
+{
+  SUNMatrix A, AB;
+  SUNLinearSolver LS, LSB;
+  void *cvode_mem;
+  N_Vector y, q;
+  realtype time;
+  long int nst, nstB;
+  int indexB, ncheck, retval;
+
+  /* Initialize y and q */
+  y = N_VNew_Serial(NEQ);
+  if (check_retval((void *)y, "N_VNew_Serial", 0)) return(-1);
+  Ith(y,1) = RCONST(1.0);
+  Ith(y,2) = ZERO;
+  Ith(y,3) = ZERO;
+
+  q = N_VNew_Serial(1);
+  if (check_retval((void *)q, "N_VNew_Serial", 0)) return(-1);
+  Ith(q,1) = ZERO;
+
+  /* Create and allocate CVODES memory for the forward run */
+  cvode_mem = CVodeCreate(CV_BDF);
+  if (check_retval((void *)cvode_mem, "CVodeCreate", 0)) return(-1);
+  retval = CVodeInit(cvode_mem, f, T0, y);
+  if (check_retval(&retval, "CVodeInit", 1)) return(-1);
+  retval = CVodeWFtolerances(cvode_mem, ewt);
+  if (check_retval(&retval, "CVodeWFtolerances", 1)) return(-1);
+  retval = CVodeSetUserData(cvode_mem, data);
+  if (check_retval(&retval, "CVodeSetUserData", 1)) return(-1);
+  A = SUNDenseMatrix(NEQ, NEQ);
+  if (check_retval((void *)A, "SUNDenseMatrix", 0)) return(-1);
+  LS = SUNLinSol_Dense(y, A);
+  if (check_retval((void *)LS, "SUNLinSol_Dense", 0)) return(-1);
+  retval = CVodeSetLinearSolver(cvode_mem, LS, A);
+  if (check_retval(&retval, "CVodeSetLinearSolver", 1)) return(-1);
+  retval = CVodeSetJacFn(cvode_mem, Jac);
+  if (check_retval(&retval, "CVodeSetJacFn", 1)) return(-1);
+  retval = CVodeQuadInit(cvode_mem, fQ, q);
+  if (check_retval(&retval, "CVodeQuadInit", 1)) return(-1);
+  retval = CVodeSetQuadErrCon(cvode_mem, SUNTRUE);
+  if (check_retval(&retval, "CVodeSetQuadErrCon", 1)) return(-1);
+  retval = CVodeQuadSStolerances(cvode_mem, RTOL, ATOLq);
+  if (check_retval(&retval, "CVodeQuadSStolerances", 1)) return(-1);
+  retval = CVodeSetMaxNumSteps(cvode_mem, 2500);
+  if (check_retval(&retval, "CVodeSetMaxNumSteps", 1)) return(-1);
+
+  /* Allocate global memory for the adjoint problem and set the check
+     point handling */
+  retval = CVodeAdjInit(cvode_mem, STEPS, CV_HERMITE);
+  if (check_retval(&retval, "CVodeAdjInit", 1)) return(-1);
+  if (ckpnt == CKPNT_MAX) {
+    retval = CVodeSetAdjMaxCheckPoints(cvode_mem, MAXCKPNTS);
+    if (check_retval(&retval, "CVodeSetAdjMaxCheckPoints", 1)) return(-1);
+  } else if (ckpnt == CKPNT_FILE) {
+    retval = CVodeSetAdjCheckPointStorage(cvode_mem, CV_CKPNT_FILE, NULL);
+    if (check_retval(&retval, "CVodeSetAdjCheckPointStorage", 1)) return(-1);
+  }
+
+  /* Perform the forward run */
+  retval = CVodeF(cvode_mem, TOUT, y, &time, CV_NORMAL, &ncheck);
+  if (check_retval(&retval, "CVodeF", 1)) return(-1);
+  retval = CVodeGetNumSteps(cvode_mem, &nst);
+  if (check_retval(&retval, "CVodeGetNumSteps", 1)) return(-1);
+  printf("  forward:  nst = %ld, ncheck = %d\n", nst, ncheck);
+
+  /* Backward problem */
+  N_VConst(ZERO, yB);
+  N_VConst(ZERO, qB);
+
+  retval = CVodeCreateB(cvode_mem, CV_BDF, &indexB);
+  if (check_retval(&retval, "CVodeCreateB", 1)) return(-1);
+  retval = CVodeInitB(cvode_mem, indexB, fB, TB1, yB);
+  if (check_retval(&retval, "CVodeInitB", 1)) return(-1);
+  retval = CVodeSStolerancesB(cvode_mem, indexB, RTOL, ATOLl);
+  if (check_retval(&retval, "CVodeSStolerancesB", 1)) return(-1);
+  retval = CVodeSetUserDataB(cvode_mem, indexB, data);
+  if (check_retval(&retval, "CVodeSetUserDataB", 1)) return(-1);
+  AB = SUNDenseMatrix(NEQ, NEQ);
+  if (check_retval((void *)AB, "SUNDenseMatrix", 0)) return(-1);
+  LSB = SUNLinSol_Dense(yB, AB);
+  if (check_retval((void *)LSB, "SUNLinSol_Dense", 0)) return(-1);
+  retval = CVodeSetLinearSolverB(cvode_mem, indexB, LSB, AB);
+  if (check_retval(&retval, "CVodeSetLinearSolverB", 1)) return(-1);
+  retval = CVodeSetJacFnB(cvode_mem, indexB, JacB);
+  if (check_retval(&retval, "CVodeSetJacFnB", 1)) return(-1);
+  retval = CVodeQuadInitB(cvode_mem, indexB, fQB, qB);
+  if (check_retval(&retval, "CVodeQuadInitB", 1)) return(-1);
+  retval = CVodeSetQuadErrConB(cvode_mem, indexB, SUNTRUE);
+  if (check_retval(&retval, "CVodeSetQuadErrConB", 1)) return(-1);
+  retval = CVodeQuadSStolerancesB(cvode_mem, indexB, RTOL, ATOLq);
+  if (check_retval(&retval, "CVodeQuadSStolerancesB", 1)) return(-1);
+
+  /* Integrate the backward problem to t0 */
+  retval = CVodeB(cvode_mem, T0, CV_NORMAL);
+  if (check_retval(&retval, "CVodeB", 1)) return(-1);
+  retval = CVodeGetNumSteps(CVodeGetAdjCVodeBmem(cvode_mem, indexB), &nstB);
+  if (check_retval(&retval, "CVodeGetNumSteps", 1)) return(-1);
+  printf("  backward: nst = %ld\n", nstB);
+
+  retval = CVodeGetB(cvode_mem, indexB, &time, yB);
+  if (check_retval(&retval, "CVodeGetB", 1)) return(-1);
+  retval = CVodeGetQuadB(cvode_mem, indexB, &time, qB);
+  if (check_retval(&retval, "CVodeGetQuadB", 1)) return(-1);
+
+  /* Free memory */
+  CVodeFree(&cvode_mem);
+  N_VDestroy(y);
+  N_VDestroy(q);
+  SUNLinSolFree(LS);
+  SUNMatDestroy(A);
+  SUNLinSolFree(LSB);
+  SUNMatDestroy(AB);
+
+  return(0);
+}
+
+/*
+ *--------------------------------------------------------------------
+ * FUNCTIONS CALLED BY CVODES
+ *--------------------------------------------------------------------
+ */
+
+/*
+ * f routine. Compute f(t,y).
+*/
+
+static int f(realtype t, N_Vector y, N_Vector ydot, void *user_data)
+{
+  realtype y1, y2, y3, yd1, yd3;
+  UserData data;
+  realtype p1, p2, p3;
+
+  y1 = Ith(y,1); y2 = Ith(y,2); y3 = Ith(y,3);
+  data = (UserData) user_data;
+  p1 = data->p[0]; p2 = data->p[1]; p3 = data->p[2];
+
+  yd1 = Ith(ydot,1) = -p1*y1 + p2*y2*y3;
+  yd3 = Ith(ydot,3) = p3*y2*y2;
+        Ith(ydot,2) = -yd1 - yd3;
+
+  return(0);
+}
+
+/*
+ * Jacobian routine. Compute J(t,y).
+*/
+
+static int Jac(realtype t, N_Vector y, N_Vector fy, SUNMatrix J,
+               void *user_data, N_Vector tmp1, N_Vector tmp2, N_Vector tmp3)
+{
+  realtype y2, y3;
+  UserData data;
+  realtype p1, p2, p3;
+
+  y2 = Ith(y,2); y3 = Ith(y,3);
+  data = (UserData) user_data;
+  p1 = data->p[0]; p2 = data->p[1]; p3 = data->p[2];
+
+  IJth(J,1,1) = -p1;  IJth(J,1,2) = p2*y3;          IJth(J,1,3) = p2*y2;
+  IJth(J,2,1) =  p1;  IJth(J,2,2) = -p2*y3-2*p3*y2; IJth(J,2,3) = -p2*y2;
+  IJth(J,3,1) = ZERO; IJth(J,3,2) = 2*p3*y2;        IJth(J,3,3) = ZERO;
+
+  return(0);
+}
+
+/*
+ * fQ routine. Compute fQ(t,y).
+*/
+
+static int fQ(realtype t, N_Vector y, N_Vector qdot, void *user_data)
+{
+  Ith(qdot,1) = Ith(y,3);
+
+  return(0);
+}
+
+/*
+ * EwtSet function. Computes the error weights at the current solution.
+ */
+
+static int ewt(N_Vector y, N_Vector w, void *user_data)
+{
+  int i;
+  realtype yy, ww, rtol, atol[3];
+
+  rtol    = RTOL;
+  atol[0] = ATOL1;
+  atol[1] = ATOL2;
+  atol[2] = ATOL3;
+
+  for (i=1; i<=3; i++) {
+    yy = Ith(y,i);
+    ww = rtol * SUNRabs(yy) + atol[i-1];
+    if (ww <= 0.0) return (-1);
+    Ith(w,i) = 1.0/ww;
+  }
+
+  return(0);
+}
+
+/*
+ * fB routine. Compute fB(t,y,yB).
+*/
+
+static int fB(realtype t, N_Vector y, N_Vector yB, N_Vector yBdot, void *user_dataB)
+{
+  UserData data;
+  realtype y2, y3;
+  realtype p1, p2, p3;
+  realtype l1, l2, l3;
+  realtype l21, l32;
+
+  data = (UserData) user_dataB;
+
+  /* The p vector */
+  p1 = data->p[0]; p2 = data->p[1]; p3 = data->p[2];
+
+  /* The y vector */
+  y2 = Ith(y,2); y3 = Ith(y,3);
+
+  /* The lambda vector */
+  l1 = Ith(yB,1); l2 = Ith(yB,2); l3 = Ith(yB,3);
+
+  /* Temporary variables */
+  l21 = l2-l1;
+  l32 = l3-l2;
+
+  /* Load yBdot */
+  Ith(yBdot,1) = - p1*l21;
+  Ith(yBdot,2) = p2*y3*l21 - RCONST(2.0)*p3*y2*l32;
+  Ith(yBdot,3) = p2*y2*l21 - RCONST(1.0);
+
+  return(0);
+}
+
+/*
+ * JacB routine. Compute JB(t,y,yB).
+ */
+
+static int JacB(realtype t, N_Vector y, N_Vector yB, N_Vector fyB, SUNMatrix JB,
+                void *user_dataB, N_Vector tmp1B, N_Vector tmp2B, N_Vector tmp3B)
+{
+  UserData data;
+  realtype y2, y3;
+  realtype p1, p2, p3;
+
+  data = (UserData) user_dataB;
+
+  /* The p vector */
+  p1 = data->p[0]; p2 = data->p[1]; p3 = data->p[2];
+
+  /* The y vector */
+  y2 = Ith(y,2); y3 = Ith(y,3);
+
+  /* Load JB */
+  IJth(JB,1,1) = p1;     IJth(JB,1,2) = -p1;             IJth(JB,1,3) = ZERO;
+  IJth(JB,2,1) = -p2*y3; IJth(JB,2,2) = p2*y3+2.0*p3*y2; IJth(JB,2,3) = RCONST(-2.0)*p3*y2;
+  IJth(JB,3,1) = -p2*y2; IJth(JB,3,2) = p2*y2;           IJth(JB,3,3) = ZERO;
+
+  return(0);
+}
+
+/*
+ * fQB routine. Compute integrand for quadratures
+*/
+
+static int fQB(realtype t, N_Vector y, N_Vector yB,
+               N_Vector qBdot, void *user_dataB)
+{
+  realtype y1, y2, y3;
+  realtype l1, l2, l3;
+  realtype l21, l32, y23;
+
+  /* The y vector */
+  y1 = Ith(y,1); y2 = Ith(y,2); y3 = Ith(y,3);
+
+  /* The lambda vector */
+  l1 = Ith(yB,1); l2 = Ith(yB,2); l3 = Ith(yB,3);
+
+  /* Temporary variables */
+  l21 = l2-l1;
+  l32 = l3-l2;
+  y23 = y2*y3;
+
+  Ith(qBdot,1) = y1*l21;
+  Ith(qBdot,2) = - y23*l21;
+  Ith(qBdot,3) = y2*y2*l32;
+
+  return(0);
+}
+
+/*
+ *--------------------------------------------------------------------
+ * PRIVATE FUNCTIONS
+ *--------------------------------------------------------------------
+ */
+
+/*
+ *--------------------------------------------------------------------
+ * PRIVATE FUNCTIONS
+ *--------------------------------------------------------------------
+ */
+
+/*
+ * Maximum relative difference between two vectors
+ */
+
+static realtype MaxRelDiff(N_Vector u, N_Vector v)
+{
+  realtype *ud, *vd, d;
+  sunindextype i, n;
+
+  ud = N_VGetArrayPointer(u);
+  vd = N_VGetArrayPointer(v);
+  n  = N_VGetLength(u);
+
+  d = ZERO;
+  for (i = 0; i < n; i++)
+    d = SUNMAX(d, SUNRabs(ud[i] - vd[i]) /
+                  SUNMAX(SUNRabs(ud[i]), SMALL_REAL));
+  return(d);
+}
+
+/*
+ * Print final results of backward integration
+ */
+
+static void PrintOutput(N_Vector yB, N_Vector qB)
+{
+  printf("--------------------------------------------------------\n");
+#if defined(SUNDIALS_EXTENDED_PRECISION)
+  printf("lambda(t0): %12.4Le %12.4Le %12.4Le\n",
+         Ith(yB,1), Ith(yB,2), Ith(yB,3));
+  printf("dG/dp:      %12.4Le %12.4Le %12.4Le\n",
+         -Ith(qB,1), -Ith(qB,2), -Ith(qB,3));
+#else
+  printf("lambda(t0): %12.4e %12.4e %12.4e\n",
+         Ith(yB,1), Ith(yB,2), Ith(yB,3));
+  printf("dG/dp:      %12.4e %12.4e %12.4e\n",
+         -Ith(qB,1), -Ith(qB,2), -Ith(qB,3));
+#endif
+  printf("--------------------------------------------------------\n\n");
+}
+
+/*
+ * Check function return value.
+ *    opt == 0 means SUNDIALS function allocates memory so check if
+ *             returned NULL pointer
+ *    opt == 1 means SUNDIALS function returns an integer value so check if
+ *             retval < 0
+ *    opt == 2 means function allocates memory so check if returned
+ *             NULL pointer
+ */
+
+static int check_retval(void *returnvalue, const char *funcname, int opt)
+{
+  int *retval;
+
+  /* Check if SUNDIALS function returned NULL pointer - no memory allocated */
+  if (opt == 0 && returnvalue == NULL) {
+    fprintf(stderr, "\nSUNDIALS_ERROR: %s() failed - returned NULL pointer\n\n",
+	    funcname);
+    return(1); }
+
+  /* Check if retval < 0 */
+  else if (opt == 1) {
+    retval = (int *) returnvalue;
+    if (*retval < 0) {
+      fprintf(stderr, "\nSUNDIALS_ERROR: %s() failed with retval = %d\n\n",
+	      funcname, *retval);
+      return(1); }}
+
+  /* Check if function returned NULL pointer - no memory allocated */
+  else if (opt == 2 && returnvalue == NULL) {
+    fprintf(stderr, "\nMEMORY_ERROR: %s() failed - returned NULL pointer\n\n",
+	    funcname);
+    return(1); }
+
+  return(0);
+}
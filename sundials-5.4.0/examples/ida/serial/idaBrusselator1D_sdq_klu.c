@@ -0,0 +1,433 @@
+/* -----------------------------------------------------------------
+ * Programmer(s): based on idaHeat2D_bnd.c and idaHeat2D_klu.c
+ * -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2020, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * Example problem for IDA: 1D Brusselator, band vs. sparse DQ.
+ *
+ * The DAE system solved is a spatial discretization of the
+ * Brusselator reaction-diffusion system
+ *    du/dt = d u_xx + a - (b+1) u + u^2 v
+ *    dv/dt = d v_xx + b u - u^2 v
+ * for 0 < x < 1, with Dirichlet boundary values u = a, v = b/a.
+ * The PDE is treated with central differences on a uniform grid of
+ * MX+2 nodes. The values of u and v at the interior nodes satisfy
+ * ODEs, and equations u = a, v = b/a at the two boundary nodes are
+ * appended, to form a DAE system of size N = 2*(MX+2). The unknowns
+ * are ordered by species (u_0, ..., u_{MX+1}, v_0, ..., v_{MX+1}),
+ * so the Jacobian is banded with half-bandwidths ml = mu = MX+2,
+ * but each column only has up to four nonzeros.
+ *
+ * The system is solved twice with IDA, both times with internal
+ * difference quotient (DQ) Jacobians: first with the band DQ
+ * Jacobian and the band linear solver, then with the colored sparse
+ * DQ Jacobian enabled by IDASetSparseDQJac and the KLU sparse
+ * direct linear solver. The two DQ Jacobians are the same matrix,
+ * so the two solutions must agree to well within the integration
+ * tolerances, and the sparse DQ Jacobian must not use more residual
+ * evaluations per Jacobian than the band one (here N, since
+ * ml+mu+1 > N). The program returns 1 if either check fails.
+ * -----------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <math.h>
+
+#include <ida/ida.h>                       /* prototypes for IDA fcts., consts.    */
+#include <nvector/nvector_serial.h>        /* access to serial N_Vector            */
+#include <sunmatrix/sunmatrix_band.h>      /* access to band SUNMatrix             */
+#include <sunmatrix/sunmatrix_sparse.h>    /* access to sparse SUNMatrix           */
+#include <sunlinsol/sunlinsol_band.h>      /* access to band SUNLinearSolver       */
+#include <sunlinsol/sunlinsol_klu.h>       /* access to KLU linear solver          */
+#include <sundials/sundials_types.h>       /* defs. of realtype, sunindextype      */
+#include <sundials/sundials_math.h>        /* defs. of SUNRabs, SUNMAX, etc.       */
+
+/* Problem Constants */
+
+#define MX      50                  /* number of interior nodes        */
+#define NX      (MX+2)              /* number of nodes                 */
+#define NEQ     (2*NX)              /* number of equations             */
+#define MU      NX                  /* half-bandwidths of the band     */
+#define ML      NX                  /* Jacobian                        */
+#define ALPHA   RCONST(1.0)         /* Brusselator parameters a, b     */
+#define BETA    RCONST(3.0)
+#define DIFF    RCONST(0.1)         /* diffusion coefficient d         */
+#define RTOL    RCONST(1.0e-6)      /* scalar relative tolerance       */
+#define ATOL    RCONST(1.0e-9)      /* scalar absolute tolerance       */
+#define T0      RCONST(0.0)         /* initial time                    */
+#define T1      RCONST(2.0)         /* first output time               */
+#define DTOUT   RCONST(2.0)         /* output time increment           */
+#define NOUT    5                   /* number of output times          */
+#define DIFFTOL RCONST(1.0e-6)      /* allowed difference of the two
+                                       solutions, relative to |y|      */
+
+#define ZERO    RCONST(0.0)
+#define HALF    RCONST(0.5)
+#define ONE     RCONST(1.0)
+#define TWO     RCONST(2.0)
+
+/* Indices of u and v at node i */
+
+#define IU(i)   (i)
+#define IV(i)   (NX+(i))
+
+/* Prototypes of functions called by IDA */
+
+int resBruss(realtype tres, N_Vector yy, N_Vector yp, N_Vector resval,
+             void *user_data);
+
+/* Prototypes of private functions */
+
+static void Reaction(realtype u, realtype v, realtype *f);
+static void SetInitialProfile(N_Vector yy, N_Vector yp);
+static int SetPattern(SUNMatrix S);
+static void PrintFinalStats(void *mem, const char *name);
+static int check_retval(void *returnvalue, const char *funcname, int opt);
+
+/*
+ *--------------------------------------------------------------------
+ * MAIN PROGRAM
+ *--------------------------------------------------------------------
+ */
+
+int main()
+{
+  void *memb, *mems;
+  N_Vector yyb, ypb, yys, yps;
+  SUNMatrix Ab, As, Jpat;
+  SUNLinearSolver LSb, LSs;
+  realtype t, tout, dy, maxdiff;
+  long int njeb, njes, nreLSb, nreLSs;
+  sunindextype i;
+  int retval, iout, passed;
+
+  memb = mems = NULL;
+  yyb = ypb = yys = yps = NULL;
+  Ab = As = Jpat = NULL;
+  LSb = LSs = NULL;
+
+  /* Create vectors for the two solutions and set consistent
+     initial values */
+  yyb = N_VNew_Serial(NEQ);
+  if(check_retval((void *)yyb, "N_VNew_Serial", 0)) return(1);
+  ypb = N_VNew_Serial(NEQ);
+  if(check_retval((void *)ypb, "N_VNew_Serial", 0)) return(1);
+  yys = N_VNew_Serial(NEQ);
+  if(check_retval((void *)yys, "N_VNew_Serial", 0)) return(1);
+  yps = N_VNew_Serial(NEQ);
+  if(check_retval((void *)yps, "N_VNew_Serial", 0)) return(1);
+
+  SetInitialProfile(yyb, ypb);
+  SetInitialProfile(yys, yps);
+
+  /* Band DQ Jacobian with the band linear solver */
+  memb = IDACreate();
+  if(check_retval((void *)memb, "IDACreate", 0)) return(1);
+  retval = IDAInit(memb, resBruss, T0, yyb, ypb);
+  if(check_retval(&retval, "IDAInit", 1)) return(1);
+  retval = IDASStolerances(memb, RTOL, ATOL);
+  if(check_retval(&retval, "IDASStolerances", 1)) return(1);
+  Ab = SUNBandMatrix(NEQ, MU, ML);
+  if(check_retval((void *)Ab, "SUNBandMatrix", 0)) return(1);
+  LSb = SUNLinSol_Band(yyb, Ab);
+  if(check_retval((void *)LSb, "SUNLinSol_Band", 0)) return(1);
+  retval = IDASetLinearSolver(memb, LSb, Ab);
+  if(check_retval(&retval, "IDASetLinearSolver", 1)) return(1);
+
+  /* Colored sparse DQ Jacobian with the KLU linear solver */
+  mems = IDACreate();
+  if(check_retval((void *)mems, "IDACreate", 0)) return(1);
+  retval = IDAInit(mems, resBruss, T0, yys, yps);
+  if(check_retval(&retval, "IDAInit", 1)) return(1);
+  retval = IDASStolerances(mems, RTOL, ATOL);
+  if(check_retval(&retval, "IDASStolerances", 1)) return(1);
+  As = SUNSparseMatrix(NEQ, NEQ, 4*NEQ, CSC_MAT);
+  if(check_retval((void *)As, "SUNSparseMatrix", 0)) return(1);
+  LSs = SUNLinSol_KLU(yys, As);
+  if(check_retval((void *)LSs, "SUNLinSol_KLU", 0)) return(1);
+  retval = IDASetLinearSolver(mems, LSs, As);
+  if(check_retval(&retval, "IDASetLinearSolver", 1)) return(1);
+
+  /* The sparsity pattern of the Jacobian, used to color its columns */
+  Jpat = SUNSparseMatrix(NEQ, NEQ, 4*NEQ, CSC_MAT);
+  if(check_retval((void *)Jpat, "SUNSparseMatrix", 0)) return(1);
+  retval = SetPattern(Jpat);
+  if(check_retval(&retval, "SetPattern", 1)) return(1);
+  retval = IDASetSparseDQJac(mems, Jpat, 1);
+  if(check_retval(&retval, "IDASetSparseDQJac", 1)) return(1);
+
+  /* Loop over output times, advance both solutions and compare */
+  printf("\nidaBrusselator1D_sdq_klu: band vs. colored sparse DQ Jacobian\n\n");
+  printf("            t        u(mid)        v(mid)\n");
+  printf("   ---------------------------------------\n");
+
+  maxdiff = ZERO;
+  for (iout = 1, tout = T1; iout <= NOUT; iout++, tout += DTOUT) {
+    retval = IDASolve(memb, tout, &t, yyb, ypb, IDA_NORMAL);
+    if(check_retval(&retval, "IDASolve", 1)) return(1);
+    retval = IDASolve(mems, tout, &t, yys, yps, IDA_NORMAL);
+    if(check_retval(&retval, "IDASolve", 1)) return(1);
+
+    /* max |yb - ys| / (|yb| + ATOL) */
+    dy = ZERO;
+    for (i = 0; i < NEQ; i++)
+      dy = SUNMAX(dy, SUNRabs(NV_Ith_S(yyb,i) - NV_Ith_S(yys,i)) /
+                      (SUNRabs(NV_Ith_S(yyb,i)) + ATOL));
+    maxdiff = SUNMAX(maxdiff, dy);
+
+#if defined(SUNDIALS_EXTENDED_PRECISION)
+    printf("   %10.4Lf  %12.6Lf  %12.6Lf\n", t,
+           NV_Ith_S(yyb,IU(NX/2)), NV_Ith_S(yyb,IV(NX/2)));
+#else
+    printf("   %10.4f  %12.6f  %12.6f\n", t,
+           NV_Ith_S(yyb,IU(NX/2)), NV_Ith_S(yyb,IV(NX/2)));
+#endif
+  }
+
+  PrintFinalStats(memb, "band DQ Jacobian");
+  PrintFinalStats(mems, "colored sparse DQ Jacobian");
+
+  /* Check the solutions and the cost of the sparse DQ Jacobian */
+  retval = IDAGetNumJacEvals(memb, &njeb);
+  check_retval(&retval, "IDAGetNumJacEvals", 1);
+  retval = IDAGetNumLinResEvals(memb, &nreLSb);
+  check_retval(&retval, "IDAGetNumLinResEvals", 1);
+  retval = IDAGetNumJacEvals(mems, &njes);
+  check_retval(&retval, "IDAGetNumJacEvals", 1);
+  retval = IDAGetNumLinResEvals(mems, &nreLSs);
+  check_retval(&retval, "IDAGetNumLinResEvals", 1);
+
+  passed = 1;
+  if (maxdiff > DIFFTOL) {
+    printf("FAIL: the solutions differ by more than %g\n", (double) DIFFTOL);
+    passed = 0;
+  }
+  /* the band DQ Jacobian uses min(ml+mu+1, N) residual evaluations */
+  if ((njes < 1) || (nreLSs > NEQ*njes) || (nreLSb != NEQ*njeb)) {
+    printf("FAIL: unexpected number of residual evaluations for DQ Jacobians\n");
+    passed = 0;
+  }
+  if (passed) printf("PASSED: the sparse DQ Jacobian matches the band DQ\n");
+
+  /* Free memory */
+  IDAFree(&memb);
+  IDAFree(&mems);
+  SUNLinSolFree(LSb);
+  SUNLinSolFree(LSs);
+  SUNMatDestroy(Ab);
+  SUNMatDestroy(As);
+  SUNMatDestroy(Jpat);
+  N_VDestroy(yyb);
+  N_VDestroy(ypb);
+  N_VDestroy(yys);
+  N_VDestroy(yps);
+
+  return(passed ? 0 : 1);
+}
+
+/*
+ *--------------------------------------------------------------------
+ * FUNCTIONS CALLED BY IDA
+ *--------------------------------------------------------------------
+ */
+
+/*
+ * resBruss: Brusselator DAE system residual function.
+ * This uses 3-point central differencing on the interior nodes,
+ * and includes algebraic equations for the boundary values.
+ * So for each interior node, the residual component has the form
+ *    res_i = y'_i - (d/dx^2)(y_{i-1} - 2 y_i + y_{i+1}) - R(y_i)
+ * and for each boundary node, it is res_i = y_i - (boundary value).
+ */
+
+int resBruss(realtype tt, N_Vector yy, N_Vector yp, N_Vector rr,
+             void *user_data)
+{
+  realtype *yv, *ypv, *rv, c, r[2];
+  sunindextype i;
+
+  yv  = N_VGetArrayPointer(yy);
+  ypv = N_VGetArrayPointer(yp);
+  rv  = N_VGetArrayPointer(rr);
+
+  c = DIFF * (MX+1) * (MX+1);   /* d / dx^2 */
+
+  /* Boundary nodes */
+  rv[IU(0)]  = yv[IU(0)]  - ALPHA;
+  rv[IV(0)]  = yv[IV(0)]  - BETA/ALPHA;
+  rv[IU(NX-1)] = yv[IU(NX-1)] - ALPHA;
+  rv[IV(NX-1)] = yv[IV(NX-1)] - BETA/ALPHA;
+
+  /* Interior nodes */
+  for (i = 1; i <= MX; i++) {
+    Reaction(yv[IU(i)], yv[IV(i)], r);
+    rv[IU(i)] = ypv[IU(i)] - r[0]
+      - c*(yv[IU(i-1)] - TWO*yv[IU(i)] + yv[IU(i+1)]);
+    rv[IV(i)] = ypv[IV(i)] - r[1]
+      - c*(yv[IV(i-1)] - TWO*yv[IV(i)] + yv[IV(i+1)]);
+  }
+
+  return(0);
+}
+
+/*
+ *--------------------------------------------------------------------
+ * PRIVATE FUNCTIONS
+ *--------------------------------------------------------------------
+ */
+
+/*
+ * Reaction: the Brusselator reaction terms at one node.
+ */
+
+static void Reaction(realtype u, realtype v, realtype *f)
+{
+  f[0] = ALPHA - (BETA+ONE)*u + u*u*v;
+  f[1] = BETA*u - u*u*v;
+}
+
+/*
+ * SetInitialProfile: routine to initialize y and y' vectors.
+ * The boundary values are set to the Dirichlet data, the interior
+ * values to a perturbed steady state, and y' to the consistent
+ * values y' = f(y) (zero at the boundary).
+ */
+
+static void SetInitialProfile(N_Vector yy, N_Vector yp)
+{
+  realtype *ydata, *ypdata, x;
+  sunindextype i;
+
+  ydata  = N_VGetArrayPointer(yy);
+  ypdata = N_VGetArrayPointer(yp);
+
+  for (i = 0; i < NX; i++) {
+    x = i / (realtype) (NX-1);
+    ydata[IU(i)] = ALPHA + HALF*sin(RCONST(3.14159265358979) * x);
+    ydata[IV(i)] = BETA/ALPHA;
+  }
+  ydata[IU(0)] = ydata[IU(NX-1)] = ALPHA;
+
+  /* with y' = 0 the residual is -f(y) at the interior nodes */
+  N_VConst(ZERO, yp);
+  resBruss(ZERO, yy, yp, yp, NULL);
+  for (i = 1; i <= MX; i++) {
+    ypdata[IU(i)] = -ypdata[IU(i)];
+    ypdata[IV(i)] = -ypdata[IV(i)];
+  }
+  ypdata[IU(0)] = ypdata[IV(0)] = ZERO;
+  ypdata[IU(NX-1)] = ypdata[IV(NX-1)] = ZERO;
+}
+
+/*
+ * SetPattern: column pattern of dF/dy + cj dF/dy'. The column of u
+ * (or v) at node i appears in the rows of u (or v) at nodes i-1 and
+ * i+1 when those nodes are interior, and in its own row. When node i
+ * is interior it also appears in the row of the other species there.
+ */
+
+static int SetPattern(SUNMatrix S)
+{
+  sunindextype *colptrs, *rowvals;
+  sunindextype i, j, nz;
+  int interior;
+
+  colptrs = SUNSparseMatrix_IndexPointers(S);
+  rowvals = SUNSparseMatrix_IndexValues(S);
+
+  nz = 0;
+  for (j = 0; j < NEQ; j++) {
+    i = j % NX;
+    interior = (i >= 1 && i <= MX);
+    colptrs[j] = nz;
+    if (j >= NX && interior) rowvals[nz++] = IU(i);  /* dres_u/dv */
+    if (i-1 >= 1) rowvals[nz++] = j-1;
+    rowvals[nz++] = j;
+    if (i+1 <= MX) rowvals[nz++] = j+1;
+    if (j < NX && interior) rowvals[nz++] = IV(i);   /* dres_v/du */
+  }
+  colptrs[NEQ] = nz;
+
+  return(0);
+}
+
+/*
+ * PrintFinalStats: Print final IDA statistics.
+ */
+
+static void PrintFinalStats(void *mem, const char *name)
+{
+  long int nst, nre, nje, nni, netf, ncfn, nreLS;
+  int retval;
+
+  retval = IDAGetNumSteps(mem, &nst);
+  check_retval(&retval, "IDAGetNumSteps", 1);
+  retval = IDAGetNumResEvals(mem, &nre);
+  check_retval(&retval, "IDAGetNumResEvals", 1);
+  retval = IDAGetNumJacEvals(mem, &nje);
+  check_retval(&retval, "IDAGetNumJacEvals", 1);
+  retval = IDAGetNumNonlinSolvIters(mem, &nni);
+  check_retval(&retval, "IDAGetNumNonlinSolvIters", 1);
+  retval = IDAGetNumErrTestFails(mem, &netf);
+  check_retval(&retval, "IDAGetNumErrTestFails", 1);
+  retval = IDAGetNumNonlinSolvConvFails(mem, &ncfn);
+  check_retval(&retval, "IDAGetNumNonlinSolvConvFails", 1);
+  retval = IDAGetNumLinResEvals(mem, &nreLS);
+  check_retval(&retval, "IDAGetNumLinResEvals", 1);
+
+  printf("\nFinal Run Statistics, %s:\n", name);
+  printf("Number of steps                    = %ld\n", nst);
+  printf("Number of residual evaluations     = %ld\n", nre);
+  printf("Number of Jacobian evaluations     = %ld\n", nje);
+  printf("Number of Jacobian res. evals.     = %ld\n", nreLS);
+  printf("Number of nonlinear iterations     = %ld\n", nni);
+  printf("Number of error test failures      = %ld\n", netf);
+  printf("Number of nonlinear conv. failures = %ld\n", ncfn);
+}
+
+/*
+ * Check function return value...
+ *   opt == 0 means SUNDIALS function allocates memory so check if
+ *            returned NULL pointer
+ *   opt == 1 means SUNDIALS function returns an integer value so check if
+ *            retval < 0
+ *   opt == 2 means function allocates memory so check if returned
+ *            NULL pointer
+ */
+
+static int check_retval(void *returnvalue, const char *funcname, int opt)
+{
+  int *retval;
+
+  if (opt == 0 && returnvalue == NULL) {
+    /* Check if SUNDIALS function returned NULL pointer - no memory allocated */
+    fprintf(stderr,
+            "\nSUNDIALS_ERROR: %s() failed - returned NULL pointer\n\n",
+            funcname);
+    return(1);
+  } else if (opt == 1) {
+    /* Check if retval < 0 */
+    retval = (int *) returnvalue;
+    if (*retval < 0) {
+      fprintf(stderr,
+              "\nSUNDIALS_ERROR: %s() failed with retval = %d\n\n",
+              funcname, *retval);
+      return(1);
+    }
+  } else if (opt == 2 && returnvalue == NULL) {
+    /* Check if function returned NULL pointer - no memory allocated */
+    fprintf(stderr,
+            "\nMEMORY_ERROR: %s() failed - returned NULL pointer\n\n",
+            funcname);
+    return(1);
+  }
+
+  return(0);
+}
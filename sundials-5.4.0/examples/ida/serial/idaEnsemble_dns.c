@@ -0,0 +1,519 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2020, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * Example problem:
+ *
+ * An ensemble of NMEM independent copies of the Robertson DAE of
+ * idaRoberts_dns,
+ *    dy1/dt = -k1*y1 + k2*y2*y3
+ *    dy2/dt =  k1*y1 - k2*y2*y3 - k3*(y2)^2
+ *       0   =  y1 + y2 + y3 - 1
+ * with y1 = 1.0, y2 = y3 = 0 at t = 0. The rate constants k1 and k3
+ * of member m are scaled by a factor between 0.1 and 10, so that the
+ * members differ in stiffness and take different numbers of steps.
+ *
+ * Each member is first integrated on its own with IDASolve and the
+ * dense linear solver. The results at the output times
+ * t = 0.4, 4, ..., 4.e4 are the reference. The ensemble is then
+ * integrated
+ *   - with IDAEnsemble, one IDA memory per member, on the number of
+ *     threads given on the command line. Every member must give the
+ *     same results as its reference, bit for bit.
+ *   - in lockstep, as one system of NMEM*NEQ equations with the
+ *     ensemble SUNMatrix and SUNLinearSolver, whose operations use
+ *     the same number of threads. The members then share the step
+ *     size, so the results must only agree with the references to
+ *     within a small multiple of the tolerances.
+ * The threads are used if SUNDIALS is configured with
+ * SUNDIALS_ENSEMBLE_OPENMP. The program returns 1 if a check fails.
+ * -----------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <ida/ida.h>                      /* prototypes for IDA fcts., consts.   */
+#include <nvector/nvector_serial.h>       /* access to serial N_Vector           */
+#include <sunmatrix/sunmatrix_dense.h>    /* access to dense SUNMatrix           */
+#include <sunlinsol/sunlinsol_dense.h>    /* access to dense SUNLinearSolver     */
+#include <sunmatrix/sunmatrix_ensemble.h> /* access to ensemble SUNMatrix        */
+#include <sunlinsol/sunlinsol_ensemble.h> /* access to ensemble SUNLinearSolver  */
+#include <sundials/sundials_types.h>      /* defs. of realtype, sunindextype     */
+#include <sundials/sundials_math.h>       /* defs. of SUNRabs, SUNRpowerR        */
+
+#if defined(SUNDIALS_EXTENDED_PRECISION)
+#define GSYM "Lg"
+#define ESYM "Le"
+#define FSYM "Lf"
+#else
+#define GSYM "g"
+#define ESYM "e"
+#define FSYM "f"
+#endif
+
+/* Problem Constants */
+
+#define NMEM  32               /* number of members    */
+#define NEQ   3                /* number of equations of a member */
+#define RTOL  RCONST(1.0e-6)   /* scalar relative tolerance */
+#define ATOL1 RCONST(1.0e-10)  /* vector absolute tolerance components */
+#define ATOL2 RCONST(1.0e-14)
+#define ATOL3 RCONST(1.0e-8)
+#define T0    RCONST(0.0)      /* initial time           */
+#define T1    RCONST(0.4)      /* first output time      */
+#define TMULT RCONST(10.0)     /* output time factor     */
+#define NOUT  6                /* number of output times */
+#define LOCKSTEP_FACTOR RCONST(100.0) /* allowed lockstep error, in tolerances */
+
+#define ZERO  RCONST(0.0)
+#define ONE   RCONST(1.0)
+
+/* Rate constants of a member. The lockstep system gets the array of the
+   rate constants of all members. */
+
+typedef struct {
+  realtype k1, k2, k3;
+} *MemberData;
+
+/* Functions Called by the Solver */
+
+static int res(realtype t, N_Vector yy, N_Vector yp, N_Vector rr,
+               void *user_data);
+
+static int Jac(realtype t, realtype cj, N_Vector yy, N_Vector yp,
+               N_Vector rr, SUNMatrix J, void *user_data,
+               N_Vector tmp1, N_Vector tmp2, N_Vector tmp3);
+
+static int resEnsemble(realtype t, N_Vector yy, N_Vector yp, N_Vector rr,
+                       void *user_data);
+
+static int JacEnsemble(realtype t, realtype cj, N_Vector yy, N_Vector yp,
+                       N_Vector rr, SUNMatrix J, void *user_data,
+                       N_Vector tmp1, N_Vector tmp2, N_Vector tmp3);
+
+/* Private functions to set up a member */
+
+static void SetInitialConditions(MemberData data, realtype *y, realtype *yp);
+static void *CreateMember(MemberData data, N_Vector yy, N_Vector yp,
+                          N_Vector abstol, SUNMatrix *A, SUNLinearSolver *LS);
+
+/* Private function to check function return values */
+
+static int check_retval(void *returnvalue, const char *funcname, int opt);
+
+
+/*
+ *-------------------------------
+ * Main Program
+ *-------------------------------
+ */
+
+int main(int argc, char *argv[])
+{
+  MemberData data;
+  realtype ref[NOUT][NMEM][NEQ], y0[NEQ], yp0[NEQ];
+  realtype tout, t, s, err, errmax, tret[NMEM];
+  N_Vector yy[NMEM], yp[NMEM], abstol, yye, ype, abstole;
+  SUNMatrix A[NMEM], Ae;
+  SUNLinearSolver LS[NMEM], LSe;
+  void *ida_mem[NMEM], *ida_mem_e;
+  int nthreads, retval, flags[NMEM], iout, m, i, nfails;
+  long int nst, nstmin, nstmax;
+
+  /* Get the number of threads */
+  nthreads = (argc > 1) ? atoi(argv[1]) : 1;
+  if (nthreads < 1) {
+    fprintf(stderr, "\nUsage: %s [nthreads]\n\n", argv[0]);
+    return(1);
+  }
+
+  nfails = 0;
+
+  /* Set the rate constants of the members */
+  data = (MemberData) malloc(NMEM*sizeof *data);
+  if (check_retval((void *)data, "malloc", 2)) return(1);
+  for (m=0; m<NMEM; m++) {
+    s = SUNRpowerR(RCONST(10.0), RCONST(2.0)*m/(NMEM-1) - ONE);
+    data[m].k1 = RCONST(0.04)*s;
+    data[m].k2 = RCONST(1.0e4);
+    data[m].k3 = RCONST(3.0e7)*s;
+  }
+
+  /* Create the vector of absolute tolerances of a member */
+  abstol = N_VNew_Serial(NEQ);
+  if (check_retval((void *)abstol, "N_VNew_Serial", 0)) return(1);
+  NV_Ith_S(abstol,0) = ATOL1;
+  NV_Ith_S(abstol,1) = ATOL2;
+  NV_Ith_S(abstol,2) = ATOL3;
+
+  printf("\nEnsemble of %d Robertson DAEs, %d thread(s)\n\n",
+         NMEM, nthreads);
+
+  /* ------------------------------------------------------------
+     Reference: each member integrated on its own
+     ------------------------------------------------------------*/
+
+  nstmin = nstmax = 0;
+  for (m=0; m<NMEM; m++) {
+    yy[m] = N_VNew_Serial(NEQ);
+    if (check_retval((void *)yy[m], "N_VNew_Serial", 0)) return(1);
+    yp[m] = N_VNew_Serial(NEQ);
+    if (check_retval((void *)yp[m], "N_VNew_Serial", 0)) return(1);
+    ida_mem[m] = CreateMember(&data[m], yy[m], yp[m], abstol, &A[m], &LS[m]);
+    if (ida_mem[m] == NULL) return(1);
+
+    for (iout=0, tout=T1; iout<NOUT; iout++, tout*=TMULT) {
+      retval = IDASolve(ida_mem[m], tout, &t, yy[m], yp[m], IDA_NORMAL);
+      if (check_retval(&retval, "IDASolve", 1)) return(1);
+      for (i=0; i<NEQ; i++) ref[iout][m][i] = NV_Ith_S(yy[m],i);
+    }
+
+    retval = IDAGetNumSteps(ida_mem[m], &nst);
+    if (check_retval(&retval, "IDAGetNumSteps", 1)) return(1);
+    if (m == 0 || nst < nstmin) nstmin = nst;
+    if (m == 0 || nst > nstmax) nstmax = nst;
+
+    IDAFree(&ida_mem[m]);
+    SUNLinSolFree(LS[m]);
+    SUNMatDestroy(A[m]);
+  }
+  printf("Steps of the members: %ld to %ld\n\n", nstmin, nstmax);
+
+  /* ------------------------------------------------------------
+     Independent members, advanced by IDAEnsemble
+     ------------------------------------------------------------*/
+
+  for (m=0; m<NMEM; m++) {
+    ida_mem[m] = CreateMember(&data[m], yy[m], yp[m], abstol, &A[m], &LS[m]);
+    if (ida_mem[m] == NULL) return(1);
+  }
+
+  printf("IDAEnsemble, largest difference from the reference:\n");
+  for (iout=0, tout=T1; iout<NOUT; iout++, tout*=TMULT) {
+    retval = IDAEnsemble(ida_mem, NMEM, tout, tret, yy, yp, IDA_NORMAL,
+                         nthreads, flags);
+    if (check_retval(&retval, "IDAEnsemble", 1)) return(1);
+
+    errmax = ZERO;
+    for (m=0; m<NMEM; m++) {
+      if (tret[m] != tout) errmax = ONE;
+      for (i=0; i<NEQ; i++) {
+        err = SUNRabs(NV_Ith_S(yy[m],i) - ref[iout][m][i]);
+        if (err > errmax) errmax = err;
+      }
+    }
+    printf("  t = %0.1"ESYM"   %0.1"ESYM"\n", tout, errmax);
+    if (errmax != ZERO) nfails++;
+  }
+  printf("\n");
+
+  for (m=0; m<NMEM; m++) {
+    IDAFree(&ida_mem[m]);
+    SUNLinSolFree(LS[m]);
+    SUNMatDestroy(A[m]);
+    N_VDestroy(yy[m]);
+    N_VDestroy(yp[m]);
+  }
+
+  /* ------------------------------------------------------------
+     All members in lockstep, as one system with the ensemble
+     matrix and linear solver; unknown i of member m is at
+     i*NMEM + m
+     ------------------------------------------------------------*/
+
+  yye = N_VNew_Serial(NMEM*NEQ);
+  if (check_retval((void *)yye, "N_VNew_Serial", 0)) return(1);
+  ype = N_VNew_Serial(NMEM*NEQ);
+  if (check_retval((void *)ype, "N_VNew_Serial", 0)) return(1);
+  abstole = N_VNew_Serial(NMEM*NEQ);
+  if (check_retval((void *)abstole, "N_VNew_Serial", 0)) return(1);
+
+  Ae = SUNEnsembleMatrix(NMEM, NEQ);
+  if (check_retval((void *)Ae, "SUNEnsembleMatrix", 0)) return(1);
+  retval = SUNEnsembleMatrix_SetNumThreads(Ae, nthreads);
+  if (check_retval(&retval, "SUNEnsembleMatrix_SetNumThreads", 1)) return(1);
+
+  for (m=0; m<NMEM; m++) {
+    SetInitialConditions(&data[m], y0, yp0);
+    for (i=0; i<NEQ; i++) {
+      NV_Ith_S(yye,SM_VINDEX_E(Ae,m,i))     = y0[i];
+      NV_Ith_S(ype,SM_VINDEX_E(Ae,m,i))     = yp0[i];
+      NV_Ith_S(abstole,SM_VINDEX_E(Ae,m,i)) = NV_Ith_S(abstol,i);
+    }
+  }
+
+  LSe = SUNLinSol_Ensemble(yye, Ae);
+  if (check_retval((void *)LSe, "SUNLinSol_Ensemble", 0)) return(1);
+
+  ida_mem_e = IDACreate();
+  if (check_retval((void *)ida_mem_e, "IDACreate", 0)) return(1);
+  retval = IDAInit(ida_mem_e, resEnsemble, T0, yye, ype);
+  if (check_retval(&retval, "IDAInit", 1)) return(1);
+  retval = IDASVtolerances(ida_mem_e, RTOL, abstole);
+  if (check_retval(&retval, "IDASVtolerances", 1)) return(1);
+  retval = IDASetUserData(ida_mem_e, data);
+  if (check_retval(&retval, "IDASetUserData", 1)) return(1);
+  retval = IDASetLinearSolver(ida_mem_e, LSe, Ae);
+  if (check_retval(&retval, "IDASetLinearSolver", 1)) return(1);
+  retval = IDASetJacFn(ida_mem_e, JacEnsemble);
+  if (check_retval(&retval, "IDASetJacFn", 1)) return(1);
+  retval = IDASetMaxNumSteps(ida_mem_e, 5000);
+  if (check_retval(&retval, "IDASetMaxNumSteps", 1)) return(1);
+
+  printf("Lockstep, largest difference from the reference, in tolerances:\n");
+  for (iout=0, tout=T1; iout<NOUT; iout++, tout*=TMULT) {
+    retval = IDASolve(ida_mem_e, tout, &t, yye, ype, IDA_NORMAL);
+    if (check_retval(&retval, "IDASolve", 1)) return(1);
+
+    errmax = ZERO;
+    for (m=0; m<NMEM; m++) {
+      for (i=0; i<NEQ; i++) {
+        err = SUNRabs(NV_Ith_S(yye,SM_VINDEX_E(Ae,m,i)) - ref[iout][m][i]) /
+          (RTOL*SUNRabs(ref[iout][m][i]) + NV_Ith_S(abstol,i));
+        if (err > errmax) errmax = err;
+      }
+    }
+    printf("  t = %0.1"ESYM"   %0.1"ESYM"\n", tout, errmax);
+    if (!(errmax < LOCKSTEP_FACTOR)) nfails++;
+  }
+
+  retval = IDAGetNumSteps(ida_mem_e, &nst);
+  if (check_retval(&retval, "IDAGetNumSteps", 1)) return(1);
+  printf("\nSteps in lockstep: %s the largest number of steps of a member\n",
+         (nst >= nstmax) ? "at least" : "fewer than");
+
+  IDAFree(&ida_mem_e);
+  SUNLinSolFree(LSe);
+  SUNMatDestroy(Ae);
+  N_VDestroy(yye);
+  N_VDestroy(ype);
+  N_VDestroy(abstole);
+  N_VDestroy(abstol);
+  free(data);
+
+  if (nfails) {
+    printf("\nSUNDIALS_ERROR: %d check(s) failed\n\n", nfails);
+    return(1);
+  }
+  printf("\nAll members agree with the reference\n\n");
+
+  return(0);
+}
+
+
+/*
+ *-------------------------------
+ * Functions called by the solver
+ *-------------------------------
+ */
+
+/*
+ * Residual routine of a member. Compute F(t,y,y').
+ */
+
+static int res(realtype t, N_Vector yy, N_Vector yp, N_Vector rr,
+               void *user_data)
+{
+  MemberData data = (MemberData) user_data;
+  realtype y1, y2, y3, r1;
+
+  y1 = NV_Ith_S(yy,0); y2 = NV_Ith_S(yy,1); y3 = NV_Ith_S(yy,2);
+
+  r1 = -data->k1*y1 + data->k2*y2*y3;
+  NV_Ith_S(rr,0) = r1 - NV_Ith_S(yp,0);
+  NV_Ith_S(rr,1) = -r1 - data->k3*y2*y2 - NV_Ith_S(yp,1);
+  NV_Ith_S(rr,2) = y1 + y2 + y3 - ONE;
+
+  return(0);
+}
+
+/*
+ * Jacobian routine of a member. Compute J = dF/dy + cj*dF/dy'.
+ */
+
+static int Jac(realtype t, realtype cj, N_Vector yy, N_Vector yp,
+               N_Vector rr, SUNMatrix J, void *user_data,
+               N_Vector tmp1, N_Vector tmp2, N_Vector tmp3)
+{
+  MemberData data = (MemberData) user_data;
+  realtype y2, y3;
+
+  y2 = NV_Ith_S(yy,1); y3 = NV_Ith_S(yy,2);
+
+  SM_ELEMENT_D(J,0,0) = -data->k1 - cj;
+  SM_ELEMENT_D(J,0,1) = data->k2*y3;
+  SM_ELEMENT_D(J,0,2) = data->k2*y2;
+
+  SM_ELEMENT_D(J,1,0) = data->k1;
+  SM_ELEMENT_D(J,1,1) = -data->k2*y3 - RCONST(2.0)*data->k3*y2 - cj;
+  SM_ELEMENT_D(J,1,2) = -data->k2*y2;
+
+  SM_ELEMENT_D(J,2,0) = ONE;
+  SM_ELEMENT_D(J,2,1) = ONE;
+  SM_ELEMENT_D(J,2,2) = ONE;
+
+  return(0);
+}
+
+/*
+ * Residual routine of the lockstep system, member after member
+ */
+
+static int resEnsemble(realtype t, N_Vector yy, N_Vector yp, N_Vector rr,
+                       void *user_data)
+{
+  MemberData data = (MemberData) user_data;
+  realtype *yd, *ypd, *rd, y1, y2, y3, r1;
+  int m;
+
+  yd  = N_VGetArrayPointer(yy);
+  ypd = N_VGetArrayPointer(yp);
+  rd  = N_VGetArrayPointer(rr);
+
+  for (m=0; m<NMEM; m++) {
+    y1 = yd[m]; y2 = yd[NMEM+m]; y3 = yd[2*NMEM+m];
+
+    r1 = -data[m].k1*y1 + data[m].k2*y2*y3;
+    rd[m]        = r1 - ypd[m];
+    rd[NMEM+m]   = -r1 - data[m].k3*y2*y2 - ypd[NMEM+m];
+    rd[2*NMEM+m] = y1 + y2 + y3 - ONE;
+  }
+
+  return(0);
+}
+
+/*
+ * Jacobian routine of the lockstep system. Block m of J is the
+ * Jacobian of member m.
+ */
+
+static int JacEnsemble(realtype t, realtype cj, N_Vector yy, N_Vector yp,
+                       N_Vector rr, SUNMatrix J, void *user_data,
+                       N_Vector tmp1, N_Vector tmp2, N_Vector tmp3)
+{
+  MemberData data = (MemberData) user_data;
+  realtype *yd, y2, y3;
+  int m;
+
+  yd = N_VGetArrayPointer(yy);
+
+  for (m=0; m<NMEM; m++) {
+    y2 = yd[NMEM+m]; y3 = yd[2*NMEM+m];
+
+    SM_ELEMENT_E(J,m,0,0) = -data[m].k1 - cj;
+    SM_ELEMENT_E(J,m,0,1) = data[m].k2*y3;
+    SM_ELEMENT_E(J,m,0,2) = data[m].k2*y2;
+
+    SM_ELEMENT_E(J,m,1,0) = data[m].k1;
+    SM_ELEMENT_E(J,m,1,1) = -data[m].k2*y3 - RCONST(2.0)*data[m].k3*y2 - cj;
+    SM_ELEMENT_E(J,m,1,2) = -data[m].k2*y2;
+
+    SM_ELEMENT_E(J,m,2,0) = ONE;
+    SM_ELEMENT_E(J,m,2,1) = ONE;
+    SM_ELEMENT_E(J,m,2,2) = ONE;
+  }
+
+  return(0);
+}
+
+
+/*
+ *-------------------------------
+ * Private helper functions
+ *-------------------------------
+ */
+
+/*
+ * Consistent initial conditions of a member
+ */
+
+static void SetInitialConditions(MemberData data, realtype *y, realtype *yp)
+{
+  y[0] = ONE;
+  y[1] = ZERO;
+  y[2] = ZERO;
+
+  yp[0] = -data->k1;
+  yp[1] = data->k1;
+  yp[2] = ZERO;
+}
+
+/*
+ * Create the IDA memory, matrix and linear solver of a member, and
+ * set yy and yp to the initial conditions
+ */
+
+static void *CreateMember(MemberData data, N_Vector yy, N_Vector yp,
+                          N_Vector abstol, SUNMatrix *A, SUNLinearSolver *LS)
+{
+  void *ida_mem;
+  int retval;
+
+  SetInitialConditions(data, N_VGetArrayPointer(yy), N_VGetArrayPointer(yp));
+
+  ida_mem = IDACreate();
+  if (check_retval((void *)ida_mem, "IDACreate", 0)) return(NULL);
+  retval = IDAInit(ida_mem, res, T0, yy, yp);
+  if (check_retval(&retval, "IDAInit", 1)) return(NULL);
+  retval = IDASVtolerances(ida_mem, RTOL, abstol);
+  if (check_retval(&retval, "IDASVtolerances", 1)) return(NULL);
+  retval = IDASetUserData(ida_mem, data);
+  if (check_retval(&retval, "IDASetUserData", 1)) return(NULL);
+
+  *A = SUNDenseMatrix(NEQ, NEQ);
+  if (check_retval((void *)*A, "SUNDenseMatrix", 0)) return(NULL);
+  *LS = SUNLinSol_Dense(yy, *A);
+  if (check_retval((void *)*LS, "SUNLinSol_Dense", 0)) return(NULL);
+  retval = IDASetLinearSolver(ida_mem, *LS, *A);
+  if (check_retval(&retval, "IDASetLinearSolver", 1)) return(NULL);
+  retval = IDASetJacFn(ida_mem, Jac);
+  if (check_retval(&retval, "IDASetJacFn", 1)) return(NULL);
+  retval = IDASetMaxNumSteps(ida_mem, 5000);
+  if (check_retval(&retval, "IDASetMaxNumSteps", 1)) return(NULL);
+
+  return(ida_mem);
+}
+
+/*
+ * Check function return value...
+ *   opt == 0 means SUNDIALS function allocates memory so check if
+ *            returned NULL pointer
+ *   opt == 1 means SUNDIALS function returns an integer value so check if
+ *            retval < 0
+ *   opt == 2 means function allocates memory so check if returned
+ *            NULL pointer
+ */
+
+static int check_retval(void *returnvalue, const char *funcname, int opt)
+{
+  int *retval;
+
+  /* Check if SUNDIALS function returned NULL pointer - no memory allocated */
+  if (opt == 0 && returnvalue == NULL) {
+    fprintf(stderr, "\nSUNDIALS_ERROR: %s() failed - returned NULL pointer\n\n",
+            funcname);
+    return(1); }
+
+  /* Check if retval < 0 */
+  else if (opt == 1) {
+    retval = (int *) returnvalue;
+    if (*retval < 0) {
+      fprintf(stderr, "\nSUNDIALS_ERROR: %s() failed with retval = %d\n\n",
+              funcname, *retval);
+      return(1); }}
+
+  /* Check if function returned NULL pointer - no memory allocated */
+  else if (opt == 2 && returnvalue == NULL) {
+    fprintf(stderr, "\nMEMORY_ERROR: %s() failed - returned NULL pointer\n\n",
+            funcname);
+    return(1); }
+
+  return(0);
+}
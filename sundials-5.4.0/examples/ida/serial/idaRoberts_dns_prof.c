@@ -0,0 +1,409 @@
+/* -----------------------------------------------------------------
+ * Programmer(s): based on idaRoberts_dns.c
+ * -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2020, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * Example problem:
+ *
+ * The Robertson chemical kinetics problem of idaRoberts_dns, in
+ * DAE form,
+ *    dy1/dt = -.04*y1 + 1.e4*y2*y3
+ *    dy2/dt = .04*y1 - 1.e4*y2*y3 - 3.e7*(y2)^2
+ *       0   = y1 + y2 + y3 - 1
+ * on the interval from t = 0.0 to t = 4.e10, with initial
+ * conditions: y1 = 1.0, y2 = y3 = 0, and the root functions
+ *    g1 = y1 - 0.0001,  g2 = y3 - 0.01,
+ * is solved with Newton iteration, the dense linear solver and the
+ * Jacobian function jacrob.
+ *
+ * This example requires SUNDIALS to be built with
+ * SUNDIALS_BUILD_WITH_PROFILING. After the integration, the phase
+ * timers are fetched with IDAGetProfile and written as JSON to
+ * the file idaRoberts_dns_prof.json with SUNProfile_WriteJSON. The
+ * times vary from run to run, so only the number of calls of each
+ * phase is printed. These must agree with the integrator counters:
+ * the RHS phase counts the residual calls of the integrator and of
+ * the linear solver (none here), the Jacobian and linear setup
+ * phases count the Jacobian evaluations and linear solver setups,
+ * the step phase counts the steps, and each phase name must appear
+ * in the JSON file. The program returns 1 if a check fails.
+ * -----------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <string.h>
+
+#include <ida/ida.h>                   /* prototypes for IDA fcts., consts.    */
+#include <nvector/nvector_serial.h>    /* access to serial N_Vector            */
+#include <sunmatrix/sunmatrix_dense.h> /* access to dense SUNMatrix            */
+#include <sunlinsol/sunlinsol_dense.h> /* access to dense SUNLinearSolver      */
+#include <sundials/sundials_types.h>   /* defs. of realtype, sunindextype      */
+#include <sundials/sundials_profile.h> /* defs. of SUNProfile                  */
+
+/* Problem Constants */
+
+#define NEQ   3                /* number of equations  */
+#define Y1    RCONST(1.0)      /* initial y components */
+#define Y2    RCONST(0.0)
+#define Y3    RCONST(0.0)
+#define RTOL  RCONST(1.0e-4)   /* scalar relative tolerance            */
+#define ATOL1 RCONST(1.0e-8)   /* vector absolute tolerance components */
+#define ATOL2 RCONST(1.0e-6)
+#define ATOL3 RCONST(1.0e-6)
+#define T0    RCONST(0.0)      /* initial time           */
+#define T1    RCONST(0.4)      /* first output time      */
+#define TMULT RCONST(10.0)     /* output time factor     */
+#define NOUT  12               /* number of output times */
+
+#define JSONFILE "idaRoberts_dns_prof.json"
+#define MAXLINE  1024          /* maximum length of the JSON text */
+
+/* Macro to define dense matrix elements, indexed from 1. */
+
+#define IJth(A,i,j) SM_ELEMENT_D(A,i-1,j-1)
+
+/* Functions Called by the Solver */
+
+static int resrob(realtype t, N_Vector yy, N_Vector yp, N_Vector rr,
+                  void *user_data);
+
+static int grob(realtype t, N_Vector yy, N_Vector yp, realtype *gout,
+                void *user_data);
+
+static int jacrob(realtype tt, realtype cj,
+                  N_Vector yy, N_Vector yp, N_Vector resvec,
+                  SUNMatrix JJ, void *user_data,
+                  N_Vector tempv1, N_Vector tempv2, N_Vector tempv3);
+
+/* Private helper functions */
+
+static int CheckProfile(void *mem, SUNProfile *prof);
+static int CheckJSON(const char *fname);
+
+/* Private function to check function return values */
+
+static int check_retval(void *returnvalue, const char *funcname, int opt);
+
+/*
+ *-------------------------------
+ * Main Program
+ *-------------------------------
+ */
+
+int main()
+{
+  realtype t, tout;
+  N_Vector yy, yp, abstol;
+  SUNMatrix A;
+  SUNLinearSolver LS;
+  void *mem;
+  SUNProfile prof;
+  FILE *fp;
+  int retval, iout, fails;
+
+  yy = yp = abstol = NULL;
+  A = NULL;
+  LS = NULL;
+  mem = NULL;
+
+  /* Create serial vectors and set the initial conditions and tolerances */
+  yy = N_VNew_Serial(NEQ);
+  if (check_retval((void *)yy, "N_VNew_Serial", 0)) return(1);
+  yp = N_VNew_Serial(NEQ);
+  if (check_retval((void *)yp, "N_VNew_Serial", 0)) return(1);
+  abstol = N_VNew_Serial(NEQ);
+  if (check_retval((void *)abstol, "N_VNew_Serial", 0)) return(1);
+
+  NV_Ith_S(yy,0) = Y1;
+  NV_Ith_S(yy,1) = Y2;
+  NV_Ith_S(yy,2) = Y3;
+
+  NV_Ith_S(yp,0) = RCONST(-0.04);
+  NV_Ith_S(yp,1) = RCONST(0.04);
+  NV_Ith_S(yp,2) = RCONST(0.0);
+
+  NV_Ith_S(abstol,0) = ATOL1;
+  NV_Ith_S(abstol,1) = ATOL2;
+  NV_Ith_S(abstol,2) = ATOL3;
+
+  /* Create and initialize IDA */
+  mem = IDACreate();
+  if (check_retval((void *)mem, "IDACreate", 0)) return(1);
+
+  retval = IDAInit(mem, resrob, T0, yy, yp);
+  if (check_retval(&retval, "IDAInit", 1)) return(1);
+
+  retval = IDASVtolerances(mem, RTOL, abstol);
+  if (check_retval(&retval, "IDASVtolerances", 1)) return(1);
+
+  retval = IDARootInit(mem, 2, grob);
+  if (check_retval(&retval, "IDARootInit", 1)) return(1);
+
+  /* Attach the dense linear solver and the Jacobian function */
+  A = SUNDenseMatrix(NEQ, NEQ);
+  if (check_retval((void *)A, "SUNDenseMatrix", 0)) return(1);
+
+  LS = SUNLinSol_Dense(yy, A);
+  if (check_retval((void *)LS, "SUNLinSol_Dense", 0)) return(1);
+
+  retval = IDASetLinearSolver(mem, LS, A);
+  if (check_retval(&retval, "IDASetLinearSolver", 1)) return(1);
+
+  retval = IDASetJacFn(mem, jacrob);
+  if (check_retval(&retval, "IDASetJacFn", 1)) return(1);
+
+  /* Integrate to the output times, returning at roots as well */
+  printf("\n3-species kinetics problem, profiled\n\n");
+
+  iout = 0;
+  tout = T1;
+  while (iout < NOUT) {
+    retval = IDASolve(mem, tout, &t, yy, yp, IDA_NORMAL);
+    if (check_retval(&retval, "IDASolve", 1)) return(1);
+
+    if (retval == IDA_SUCCESS) {
+      iout++;
+      tout *= TMULT;
+    }
+  }
+
+  printf("y = %14.6e  %14.6e  %14.6e at t = %0.4e\n\n",
+         NV_Ith_S(yy,0), NV_Ith_S(yy,1), NV_Ith_S(yy,2), t);
+
+  /* Fetch the profile, check the calls and write it as JSON */
+  retval = IDAGetProfile(mem, &prof);
+  if (check_retval(&retval, "IDAGetProfile", 1)) return(1);
+
+  fails = CheckProfile(mem, &prof);
+
+  fp = fopen(JSONFILE, "w");
+  if (check_retval((void *)fp, "fopen", 2)) return(1);
+  retval = SUNProfile_WriteJSON(&prof, fp);
+  fclose(fp);
+  if (check_retval(&retval, "SUNProfile_WriteJSON", 1)) return(1);
+
+  fails += CheckJSON(JSONFILE);
+
+  /* Free memory */
+  N_VDestroy(yy);
+  N_VDestroy(yp);
+  N_VDestroy(abstol);
+  IDAFree(&mem);
+  SUNLinSolFree(LS);
+  SUNMatDestroy(A);
+
+  if (fails) return(1);
+
+  printf("\nPASSED\n");
+  return(0);
+}
+
+/*
+ *-------------------------------
+ * Functions called by the solver
+ *-------------------------------
+ */
+
+/*
+ * Define the system residual function.
+ */
+
+static int resrob(realtype t, N_Vector yy, N_Vector yp, N_Vector rr,
+                  void *user_data)
+{
+  realtype *yval, *ypval, *rval;
+
+  yval = N_VGetArrayPointer(yy);
+  ypval = N_VGetArrayPointer(yp);
+  rval = N_VGetArrayPointer(rr);
+
+  rval[0]  = RCONST(-0.04)*yval[0] + RCONST(1.0e4)*yval[1]*yval[2];
+  rval[1]  = -rval[0] - RCONST(3.0e7)*yval[1]*yval[1] - ypval[1];
+  rval[0] -=  ypval[0];
+  rval[2]  =  yval[0] + yval[1] + yval[2] - RCONST(1.0);
+
+  return(0);
+}
+
+/*
+ * Root function routine. Compute functions g_i(t,y) for i = 0,1.
+ */
+
+static int grob(realtype t, N_Vector yy, N_Vector yp, realtype *gout,
+                void *user_data)
+{
+  realtype y1, y3;
+
+  y1 = NV_Ith_S(yy,0); y3 = NV_Ith_S(yy,2);
+  gout[0] = y1 - RCONST(0.0001);
+  gout[1] = y3 - RCONST(0.01);
+
+  return(0);
+}
+
+/*
+ * Define the Jacobian function.
+ */
+
+static int jacrob(realtype tt, realtype cj,
+                  N_Vector yy, N_Vector yp, N_Vector resvec,
+                  SUNMatrix JJ, void *user_data,
+                  N_Vector tempv1, N_Vector tempv2, N_Vector tempv3)
+{
+  realtype *yval;
+
+  yval = N_VGetArrayPointer(yy);
+
+  IJth(JJ,1,1) = RCONST(-0.04) - cj;
+  IJth(JJ,2,1) = RCONST(0.04);
+  IJth(JJ,3,1) = RCONST(1.0);
+  IJth(JJ,1,2) = RCONST(1.0e4)*yval[2];
+  IJth(JJ,2,2) = RCONST(-1.0e4)*yval[2] - RCONST(6.0e7)*yval[1] - cj;
+  IJth(JJ,3,2) = RCONST(1.0);
+  IJth(JJ,1,3) = RCONST(1.0e4)*yval[1];
+  IJth(JJ,2,3) = RCONST(-1.0e4)*yval[1];
+  IJth(JJ,3,3) = RCONST(1.0);
+
+  return(0);
+}
+
+/*
+ *-------------------------------
+ * Private helper functions
+ *-------------------------------
+ */
+
+/*
+ * Prints the number of calls of each phase and checks them against
+ * the integrator counters. Returns the number of failed checks.
+ */
+
+static int CheckProfile(void *mem, SUNProfile *prof)
+{
+  long int nst, nre, nreLS, nje, nsetups;
+  int retval, i, fails;
+
+  retval = IDAGetNumResEvals(mem, &nre);
+  check_retval(&retval, "IDAGetNumResEvals", 1);
+  retval = IDAGetNumLinResEvals(mem, &nreLS);
+  check_retval(&retval, "IDAGetNumLinResEvals", 1);
+  retval = IDAGetNumJacEvals(mem, &nje);
+  check_retval(&retval, "IDAGetNumJacEvals", 1);
+  retval = IDAGetNumLinSolvSetups(mem, &nsetups);
+  check_retval(&retval, "IDAGetNumLinSolvSetups", 1);
+  retval = IDAGetNumSteps(mem, &nst);
+  check_retval(&retval, "IDAGetNumSteps", 1);
+
+  printf("Phase calls:\n");
+  for (i = 0; i < SUN_PROFILE_NPHASES; i++)
+    printf("  %-10s %ld\n", SUNProfile_PhaseName(i), prof->ncalls[i]);
+  printf("nst = %ld, nre = %ld, nreLS = %ld, nje = %ld, nsetups = %ld\n",
+         nst, nre, nreLS, nje, nsetups);
+
+  fails = 0;
+  if (prof->ncalls[SUN_PROFILE_RHS] != nre + nreLS) {
+    printf("FAIL: rhs calls differ from nre + nreLS\n");
+    fails++;
+  }
+  if (prof->ncalls[SUN_PROFILE_JAC] != nje) {
+    printf("FAIL: jac calls differ from nje\n");
+    fails++;
+  }
+  if (prof->ncalls[SUN_PROFILE_LSETUP] != nsetups) {
+    printf("FAIL: lsetup calls differ from nsetups\n");
+    fails++;
+  }
+  if (prof->ncalls[SUN_PROFILE_STEP] != nst) {
+    printf("FAIL: step calls differ from nst\n");
+    fails++;
+  }
+  for (i = 0; i < SUN_PROFILE_NPHASES; i++) {
+    if (prof->time[i] < 0.0 || (prof->ncalls[i] == 0 && prof->time[i] != 0.0)) {
+      printf("FAIL: bad time for phase %s\n", SUNProfile_PhaseName(i));
+      fails++;
+    }
+  }
+
+  return(fails);
+}
+
+/*
+ * Reads back the JSON file and checks that it holds one object with
+ * an entry for each phase. Returns the number of failed checks.
+ */
+
+static int CheckJSON(const char *fname)
+{
+  char text[MAXLINE], key[32];
+  FILE *fp;
+  size_t len;
+  int i, fails;
+
+  fp = fopen(fname, "r");
+  if (check_retval((void *)fp, "fopen", 2)) return(1);
+  len = fread(text, 1, MAXLINE-1, fp);
+  fclose(fp);
+  text[len] = '\0';
+
+  fails = 0;
+  if (len < 2 || text[0] != '{' || strchr(text, '}') == NULL) {
+    printf("FAIL: %s does not hold a JSON object\n", fname);
+    fails++;
+  }
+  for (i = 0; i < SUN_PROFILE_NPHASES; i++) {
+    sprintf(key, "\"%s\": {", SUNProfile_PhaseName(i));
+    if (strstr(text, key) == NULL) {
+      printf("FAIL: phase %s missing from %s\n", SUNProfile_PhaseName(i), fname);
+      fails++;
+    }
+  }
+  if (fails == 0) printf("Profile written to %s\n", fname);
+
+  return(fails);
+}
+
+/*
+ * Check function return value...
+ *   opt == 0 means SUNDIALS function allocates memory so check if
+ *            returned NULL pointer
+ *   opt == 1 means SUNDIALS function returns an integer value so check if
+ *            retval < 0
+ *   opt == 2 means function allocates memory so check if returned
+ *            NULL pointer
+ */
+
+static int check_retval(void *returnvalue, const char *funcname, int opt)
+{
+  int *retval;
+  /* Check if SUNDIALS function returned NULL pointer - no memory allocated */
+  if (opt == 0 && returnvalue == NULL) {
+    fprintf(stderr,
+            "\nSUNDIALS_ERROR: %s() failed - returned NULL pointer\n\n",
+            funcname);
+    return(1);
+  } else if (opt == 1) {
+    /* Check if retval < 0 */
+    retval = (int *) returnvalue;
+    if (*retval < 0) {
+      fprintf(stderr,
+              "\nSUNDIALS_ERROR: %s() failed with retval = %d\n\n",
+              funcname, *retval);
+      return(1);
+    }
+  } else if (opt == 2 && returnvalue == NULL) {
+    /* Check if function returned NULL pointer - no memory allocated */
+    fprintf(stderr,
+            "\nMEMORY_ERROR: %s() failed - returned NULL pointer\n\n",
+            funcname);
+    return(1);
+  }
+
+  return(0);
+}
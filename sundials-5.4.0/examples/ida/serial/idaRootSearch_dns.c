@@ -0,0 +1,309 @@
+/* -----------------------------------------------------------------
+ * Programmer(s): based on idaRoberts_dns.c
+ * -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2020, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * Example problem:
+ *
+ * The scalar DAE y' - 1 = 0, y(0) = 0, is integrated to t = 4 with
+ * the root function
+ *    g(t,y) = (y - R1)(y - R2),   R1 = 1.03, R2 = 1.21,
+ * which changes sign twice, at t = R1 and t = R2. The initial and
+ * maximum step sizes are set to 2, so that the first step covers
+ * both roots and g has the same sign at both of its ends.
+ *
+ * The problem is solved twice, with IDA_ONE_STEP and the dense linear
+ * solver. With the default of one root search point, only the sign
+ * of g at the end of each step is checked, and both roots are
+ * missed. With NPTS points set by IDASetRootSearchPoints, g is
+ * also sampled inside the step, and both roots must be reported.
+ *
+ * The root finding counters of IDAGetRootfindStats are checked
+ * after each return: the passes and g evaluations of all steps, as
+ * reported at the last return in each step, must add up to the
+ * total number of passes and to IDAGetNumGEvals (less the g
+ * evaluation at t0). The program returns 1 if any check fails.
+ * -----------------------------------------------------------------*/
+
+#include <stdio.h>
+
+#include <ida/ida.h>                   /* prototypes for IDA fcts., consts.    */
+#include <nvector/nvector_serial.h>    /* access to serial N_Vector            */
+#include <sunmatrix/sunmatrix_dense.h> /* access to dense SUNMatrix            */
+#include <sunlinsol/sunlinsol_dense.h> /* access to dense SUNLinearSolver      */
+#include <sundials/sundials_types.h>   /* defs. of realtype, sunindextype      */
+#include <sundials/sundials_math.h>    /* defs. of SUNRabs, etc.               */
+
+/* Problem Constants */
+
+#define NEQ     1                /* number of equations           */
+#define R1      RCONST(1.03)     /* the two roots of g            */
+#define R2      RCONST(1.21)
+#define RTOL    RCONST(1.0e-6)   /* scalar relative tolerance     */
+#define ATOL    RCONST(1.0e-8)   /* scalar absolute tolerance     */
+#define T0      RCONST(0.0)      /* initial time                  */
+#define TEND    RCONST(4.0)      /* final time                    */
+#define HSTEP   RCONST(2.0)      /* initial and maximum step size */
+#define NPTS    8                /* root search points            */
+#define MAXRT   4                /* maximum number of roots kept  */
+#define ROOTTOL RCONST(1.0e-6)   /* allowed error in the roots    */
+
+#define ZERO    RCONST(0.0)
+#define ONE     RCONST(1.0)
+
+/* Functions Called by the Solver */
+
+static int res(realtype t, N_Vector yy, N_Vector yp, N_Vector rr,
+               void *user_data);
+
+static int g(realtype t, N_Vector yy, N_Vector yp, realtype *gout,
+             void *user_data);
+
+/* Private helper functions */
+
+static int RunRoots(int npoints, realtype *troots, int *nroots);
+
+/* Private function to check function return values */
+
+static int check_retval(void *returnvalue, const char *funcname, int opt);
+
+/*
+ *-------------------------------
+ * Main Program
+ *-------------------------------
+ */
+
+int main()
+{
+  realtype troots[MAXRT];
+  int nroots, fails;
+
+  printf("\ny' - 1 = 0, g = (y - %g)(y - %g), first step [0, %g]\n",
+         R1, R2, HSTEP);
+
+  fails = 0;
+
+  /* With one search point, the two roots in the first step are missed */
+  printf("\nRoot search points = 1\n");
+  if (RunRoots(1, troots, &nroots)) return(1);
+  if (nroots != 0) {
+    printf("FAIL: %d roots found with one search point, expected 0\n",
+           nroots);
+    fails++;
+  }
+
+  /* With NPTS search points, both roots must be found */
+  printf("\nRoot search points = %d\n", NPTS);
+  if (RunRoots(NPTS, troots, &nroots)) return(1);
+  if (nroots != 2 ||
+      SUNRabs(troots[0] - R1) > ROOTTOL || SUNRabs(troots[1] - R2) > ROOTTOL) {
+    printf("FAIL: expected roots at t = %g and t = %g\n", R1, R2);
+    fails++;
+  }
+
+  if (fails) return(1);
+
+  printf("\nPASSED\n");
+  return(0);
+}
+
+/*
+ *-------------------------------
+ * Functions called by the solver
+ *-------------------------------
+ */
+
+/*
+ * Define the system residual function.
+ */
+
+static int res(realtype t, N_Vector yy, N_Vector yp, N_Vector rr,
+               void *user_data)
+{
+  NV_Ith_S(rr,0) = NV_Ith_S(yp,0) - ONE;
+  return(0);
+}
+
+/*
+ * g routine. Compute the root function g(t,y).
+ */
+
+static int g(realtype t, N_Vector yy, N_Vector yp, realtype *gout,
+             void *user_data)
+{
+  realtype y1 = NV_Ith_S(yy,0);
+
+  gout[0] = (y1 - R1)*(y1 - R2);
+  return(0);
+}
+
+/*
+ *-------------------------------
+ * Private helper functions
+ *-------------------------------
+ */
+
+/*
+ * Integrates the problem with npoints root search points, returning
+ * the roots found in troots[0..nroots-1]. Returns 1 if a SUNDIALS
+ * function fails or if the root finding counters do not add up.
+ */
+
+static int RunRoots(int npoints, realtype *troots, int *nroots)
+{
+  void *mem;
+  N_Vector yy, yp;
+  SUNMatrix A;
+  SUNLinearSolver LS;
+  realtype t;
+  long int nst, nstprev, nge, nrtiters;
+  long int ngevals_step, nrtiters_step, nge_last, nrt_last;
+  long int nge_sum, nrt_sum;
+  int retval, flag, rootsfound[1], ok;
+
+  yy = N_VNew_Serial(NEQ);
+  if (check_retval((void *)yy, "N_VNew_Serial", 0)) return(1);
+  yp = N_VNew_Serial(NEQ);
+  if (check_retval((void *)yp, "N_VNew_Serial", 0)) return(1);
+  NV_Ith_S(yy,0) = ZERO;
+  NV_Ith_S(yp,0) = ONE;
+
+  mem = IDACreate();
+  if (check_retval((void *)mem, "IDACreate", 0)) return(1);
+
+  retval = IDAInit(mem, res, T0, yy, yp);
+  if (check_retval(&retval, "IDAInit", 1)) return(1);
+
+  retval = IDASStolerances(mem, RTOL, ATOL);
+  if (check_retval(&retval, "IDASStolerances", 1)) return(1);
+
+  retval = IDASetInitStep(mem, HSTEP);
+  if (check_retval(&retval, "IDASetInitStep", 1)) return(1);
+
+  retval = IDASetMaxStep(mem, HSTEP);
+  if (check_retval(&retval, "IDASetMaxStep", 1)) return(1);
+
+  retval = IDASetStopTime(mem, TEND);
+  if (check_retval(&retval, "IDASetStopTime", 1)) return(1);
+
+  retval = IDARootInit(mem, 1, g);
+  if (check_retval(&retval, "IDARootInit", 1)) return(1);
+
+  retval = IDASetRootSearchPoints(mem, npoints);
+  if (check_retval(&retval, "IDASetRootSearchPoints", 1)) return(1);
+
+  A = SUNDenseMatrix(NEQ, NEQ);
+  if (check_retval((void *)A, "SUNDenseMatrix", 0)) return(1);
+
+  LS = SUNLinSol_Dense(yy, A);
+  if (check_retval((void *)LS, "SUNLinSol_Dense", 0)) return(1);
+
+  retval = IDASetLinearSolver(mem, LS, A);
+  if (check_retval(&retval, "IDASetLinearSolver", 1)) return(1);
+
+  /* Step to TEND. The counters of a step are added up at the first
+     return from the next step, when they are final. */
+  *nroots = 0;
+  nstprev = 0;
+  nge_last = nrt_last = 0;
+  nge_sum = nrt_sum = 0;
+  t = T0;
+  while (t < TEND) {
+    flag = IDASolve(mem, TEND, &t, yy, yp, IDA_ONE_STEP);
+    if (check_retval(&flag, "IDASolve", 1)) return(1);
+
+    retval = IDAGetNumSteps(mem, &nst);
+    check_retval(&retval, "IDAGetNumSteps", 1);
+    retval = IDAGetRootfindStats(mem, &nrtiters, &ngevals_step,
+                                 &nrtiters_step);
+    check_retval(&retval, "IDAGetRootfindStats", 1);
+
+    if (nst != nstprev) {
+      nge_sum += nge_last;
+      nrt_sum += nrt_last;
+      nstprev = nst;
+    }
+    nge_last = ngevals_step;
+    nrt_last = nrtiters_step;
+
+    printf("t = %-8.4f nst = %ld  step: passes = %ld, g evals = %ld",
+           t, nst, nrtiters_step, ngevals_step);
+
+    if (flag == IDA_ROOT_RETURN) {
+      retval = IDAGetRootInfo(mem, rootsfound);
+      if (check_retval(&retval, "IDAGetRootInfo", 1)) return(1);
+      printf("  root, direction %d", rootsfound[0]);
+      if (*nroots < MAXRT) troots[*nroots] = t;
+      (*nroots)++;
+    }
+    printf("\n");
+  }
+  nge_sum += nge_last;
+  nrt_sum += nrt_last;
+
+  retval = IDAGetNumGEvals(mem, &nge);
+  check_retval(&retval, "IDAGetNumGEvals", 1);
+
+  printf("Roots found = %d, passes = %ld, g evals = %ld\n",
+         *nroots, nrtiters, nge);
+
+  ok = (nrt_sum == nrtiters) && (nge_sum + 1 == nge);
+  if (!ok)
+    printf("FAIL: per step counters add up to %ld passes and %ld g evals\n",
+           nrt_sum, nge_sum + 1);
+
+  N_VDestroy(yy);
+  N_VDestroy(yp);
+  IDAFree(&mem);
+  SUNLinSolFree(LS);
+  SUNMatDestroy(A);
+
+  return(ok ? 0 : 1);
+}
+
+/*
+ * Check function return value...
+ *   opt == 0 means SUNDIALS function allocates memory so check if
+ *            returned NULL pointer
+ *   opt == 1 means SUNDIALS function returns an integer value so check if
+ *            retval < 0
+ *   opt == 2 means function allocates memory so check if returned
+ *            NULL pointer
+ */
+
+static int check_retval(void *returnvalue, const char *funcname, int opt)
+{
+  int *retval;
+  /* Check if SUNDIALS function returned NULL pointer - no memory allocated */
+  if (opt == 0 && returnvalue == NULL) {
+    fprintf(stderr,
+            "\nSUNDIALS_ERROR: %s() failed - returned NULL pointer\n\n",
+            funcname);
+    return(1);
+  } else if (opt == 1) {
+    /* Check if retval < 0 */
+    retval = (int *) returnvalue;
+    if (*retval < 0) {
+      fprintf(stderr,
+              "\nSUNDIALS_ERROR: %s() failed with retval = %d\n\n",
+              funcname, *retval);
+      return(1);
+    }
+  } else if (opt == 2 && returnvalue == NULL) {
+    /* Check if function returned NULL pointer - no memory allocated */
+    fprintf(stderr,
+            "\nMEMORY_ERROR: %s() failed - returned NULL pointer\n\n",
+            funcname);
+    return(1);
+  }
+
+  return(0);
+}
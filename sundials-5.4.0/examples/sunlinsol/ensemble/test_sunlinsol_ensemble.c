@@ -0,0 +1,197 @@
+/*
+ * -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2020, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the testing routine to check the SUNLinSol Ensemble module
+ * implementation.
+ * -----------------------------------------------------------------
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sundials/sundials_types.h>
+#include <sunlinsol/sunlinsol_ensemble.h>
+#include <sunmatrix/sunmatrix_ensemble.h>
+#include <nvector/nvector_serial.h>
+#include <sundials/sundials_math.h>
+#include "test_sunlinsol.h"
+
+#if defined(SUNDIALS_EXTENDED_PRECISION)
+#define GSYM "Lg"
+#define ESYM "Le"
+#define FSYM "Lf"
+#else
+#define GSYM "g"
+#define ESYM "e"
+#define FSYM "f"
+#endif
+
+/* ----------------------------------------------------------------------
+ * SUNLinSol_Ensemble Testing Routine
+ * --------------------------------------------------------------------*/
+int main(int argc, char *argv[])
+{
+  int             fails = 0;          /* counter for test failures  */
+  sunindextype    nmembers, n;        /* ensemble and block sizes   */
+  SUNLinearSolver LS;                 /* solver object              */
+  SUNMatrix       A, B;               /* test matrices              */
+  N_Vector        x, y, b;            /* test vectors               */
+  int             print_timing, nthreads;
+  sunindextype    i, j, k;
+  realtype        *xdata;
+
+  /* check input and set sizes */
+  if (argc < 5){
+    printf("ERROR: FOUR (4) Inputs required: members, block size, threads, print timing \n");
+    return(-1);
+  }
+
+  nmembers = (sunindextype) atol(argv[1]);
+  if (nmembers <= 0) {
+    printf("ERROR: number of members must be a positive integer \n");
+    return(-1);
+  }
+
+  n = (sunindextype) atol(argv[2]);
+  if (n <= 0) {
+    printf("ERROR: block size must be a positive integer \n");
+    return(-1);
+  }
+
+  nthreads = atoi(argv[3]);
+  if (nthreads <= 0) {
+    printf("ERROR: number of threads must be a positive integer \n");
+    return(-1);
+  }
+
+  print_timing = atoi(argv[4]);
+  SetTiming(print_timing);
+
+  printf("\nEnsemble linear solver test: %ld members of size %ld, %d threads\n\n",
+         (long int) nmembers, (long int) n, nthreads);
+
+  /* Create matrices and vectors */
+  A = SUNEnsembleMatrix(nmembers, n);
+  B = SUNEnsembleMatrix(nmembers, n);
+  SUNEnsembleMatrix_SetNumThreads(A, nthreads);
+  x = N_VNew_Serial(nmembers*n);
+  y = N_VNew_Serial(nmembers*n);
+  b = N_VNew_Serial(nmembers*n);
+
+  /* Fill every block with uniform random data in [0,1/n] and add the
+     anti-identity to ensure the solver needs to do row-swapping. Every
+     other member also gets half the identity, so that the members pivot
+     differently. */
+  for (k=0; k<nmembers; k++) {
+    for (j=0; j<n; j++) {
+      for (i=0; i<n; i++)
+        SM_ELEMENT_E(A,k,i,j) = (realtype) rand() / (realtype) RAND_MAX / n;
+      SM_ELEMENT_E(A,k,n-1-j,j) += ONE;
+      if (k % 2) SM_ELEMENT_E(A,k,j,j) += ONE/2;
+    }
+  }
+
+  /* Fill x vector with uniform random data in [0,1] */
+  xdata = N_VGetArrayPointer(x);
+  for (i=0; i<nmembers*n; i++) {
+    xdata[i] = (realtype) rand() / (realtype) RAND_MAX;
+  }
+
+  /* copy A and x into B and y to print in case of solver failure */
+  SUNMatCopy(A, B);
+  N_VScale(ONE, x, y);
+
+  /* create right-hand side vector for linear solve */
+  fails = SUNMatMatvec(A, x, b);
+  if (fails) {
+    printf("FAIL: SUNLinSol SUNMatMatvec failure\n");
+
+    /* Free matrices and vectors */
+    SUNMatDestroy(A);
+    SUNMatDestroy(B);
+    N_VDestroy(x);
+    N_VDestroy(y);
+    N_VDestroy(b);
+
+    return(1);
+  }
+
+  /* Create ensemble linear solver */
+  LS = SUNLinSol_Ensemble(x, A);
+
+  /* Run Tests */
+  fails += Test_SUNLinSolInitialize(LS, 0);
+  fails += Test_SUNLinSolSetup(LS, A, 0);
+  fails += Test_SUNLinSolSolve(LS, A, x, b, 100*UNIT_ROUNDOFF, 0);
+
+  fails += Test_SUNLinSolGetType(LS, SUNLINEARSOLVER_DIRECT, 0);
+  fails += Test_SUNLinSolGetID(LS, SUNLINEARSOLVER_ENSEMBLE, 0);
+  fails += Test_SUNLinSolLastFlag(LS, 0);
+  fails += Test_SUNLinSolSpace(LS, 0);
+
+  /* Print result */
+  if (fails) {
+    printf("FAIL: SUNLinSol module failed %i tests \n \n", fails);
+    printf("\nA (original) =\n");
+    SUNEnsembleMatrix_Print(B,stdout);
+    printf("\nA (factored) =\n");
+    SUNEnsembleMatrix_Print(A,stdout);
+    printf("\nx (original) =\n");
+    N_VPrint_Serial(y);
+    printf("\nx (computed) =\n");
+    N_VPrint_Serial(x);
+  } else {
+    printf("SUCCESS: SUNLinSol module passed all tests \n \n");
+  }
+
+  /* Free solver, matrix and vectors */
+  SUNLinSolFree(LS);
+  SUNMatDestroy(A);
+  SUNMatDestroy(B);
+  N_VDestroy(x);
+  N_VDestroy(y);
+  N_VDestroy(b);
+
+  return(fails);
+}
+
+/* ----------------------------------------------------------------------
+ * Implementation-specific 'check' routines
+ * --------------------------------------------------------------------*/
+int check_vector(N_Vector X, N_Vector Y, realtype tol)
+{
+  int failure = 0;
+  sunindextype i, local_length;
+  realtype *Xdata, *Ydata, maxerr;
+
+  Xdata = N_VGetArrayPointer(X);
+  Ydata = N_VGetArrayPointer(Y);
+  local_length = N_VGetLength_Serial(X);
+
+  /* check vector data */
+  for(i=0; i < local_length; i++)
+    failure += FNEQ(Xdata[i], Ydata[i], tol);
+
+  if (failure > ZERO) {
+    maxerr = ZERO;
+    for(i=0; i < local_length; i++)
+      maxerr = SUNMAX(SUNRabs(Xdata[i]-Ydata[i]), maxerr);
+    printf("check err failure: maxerr = %"GSYM" (tol = %"GSYM")\n",
+	   maxerr, tol);
+    return(1);
+  }
+  else
+    return(0);
+}
+
+void sync_device()
+{
+}
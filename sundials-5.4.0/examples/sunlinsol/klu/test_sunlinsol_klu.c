@@ -35,7 +35,7 @@ int main(int argc, char *argv[])
 {
   int             fails = 0;          /* counter for test failures  */
   sunindextype    N;                  /* matrix columns, rows       */
-  SUNLinearSolver LS;                 /* linear solver object       */
+  SUNLinearSolver LS, LS2;            /* linear solver objects      */
   SUNMatrix       A, B;               /* test matrices              */
   N_Vector        x, y, b;            /* test vectors               */
   realtype        *matdata, *xdata;
@@ -44,6 +44,8 @@ int main(int argc, char *argv[])
   sun_klu_symbolic *symbolic;
   sun_klu_numeric  *numeric;
   sun_klu_common   *common;
+  long int         hits, misses, evictions;
+  long int         nrefactor, nrepivot, nreanalyze, nrejected;
 
   /* check input and set matrix dimensions */
   if (argc < 4){
@@ -146,6 +148,47 @@ int main(int argc, char *argv[])
     printf("    PASSED test -- SUNLinSol_KLUGetCommon \n");
   }
 
+  /* Test the symbolic cache: a second solver for the same pattern reuses
+     the analysis of the first one */
+  fails += SUNLinSol_KLUSetSymbolicCache(4);
+  fails += SUNLinSol_KLUReInit(LS, A, 0, SUNKLU_REINIT_PARTIAL);
+  fails += Test_SUNLinSolSetup(LS, A, 0);
+  LS2 = SUNLinSol_KLU(x, A);
+  fails += Test_SUNLinSolInitialize(LS2, 0);
+  fails += Test_SUNLinSolSetup(LS2, A, 0);
+  fails += Test_SUNLinSolSolve(LS2, A, x, b, 1000*UNIT_ROUNDOFF, 0);
+  fails += SUNLinSol_KLUGetSymbolicCacheStats(&hits, &misses, &evictions);
+  if ((hits != 1) || (misses != 1) ||
+      (SUNLinSol_KLUGetSymbolic(LS2) != SUNLinSol_KLUGetSymbolic(LS))) {
+    printf("FAIL: SUNLinSol_KLUSetSymbolicCache failure\n");
+    fails += 1;
+  } else {
+    printf("    PASSED test -- SUNLinSol_KLUSetSymbolicCache \n");
+  }
+  SUNLinSolFree(LS2);
+  fails += SUNLinSol_KLUSetSymbolicCache(0);
+  fails += SUNLinSol_KLUFreeSymbolicCache();
+
+  /* Test the pivot policy: with an unchanged matrix a second setup keeps
+     the pivot sequence, while a poor solve forces new pivoting */
+  fails += SUNLinSol_KLUSetPivotPolicy(LS, RCONST(1.0e-3), ONE);
+  fails += Test_SUNLinSolSetup(LS, A, 0);
+  fails += Test_SUNLinSolSolve(LS, A, x, b, 1000*UNIT_ROUNDOFF, 0);
+  fails += SUNLinSol_KLUSetPivotPolicy(LS, RCONST(1.0e-3), RCONST(1.0e-300));
+  fails += Test_SUNLinSolSolve(LS, A, x, b, 1000*UNIT_ROUNDOFF, 0);
+  fails += SUNLinSol_KLUSetPivotPolicy(LS, RCONST(1.0e-3), ZERO);
+  fails += Test_SUNLinSolSetup(LS, A, 0);
+  fails += Test_SUNLinSolSolve(LS, A, x, b, 1000*UNIT_ROUNDOFF, 0);
+  fails += SUNLinSol_KLUGetPivotStats(LS, &nrefactor, &nrepivot,
+                                      &nreanalyze, &nrejected);
+  if ((nrefactor != 1) || (nrepivot != 1) || (nreanalyze != 2) ||
+      (nrejected != 0)) {
+    printf("FAIL: SUNLinSol_KLUGetPivotStats failure\n");
+    fails += 1;
+  } else {
+    printf("    PASSED test -- SUNLinSol_KLUGetPivotStats \n");
+  }
+
   /* Print result */
   if (fails) {
     printf("FAIL: SUNLinSol module failed %i tests \n \n", fails);
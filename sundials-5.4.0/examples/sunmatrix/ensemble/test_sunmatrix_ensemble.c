@@ -0,0 +1,259 @@
+/*
+ * -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2020, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the testing routine to check the SUNMatrix Ensemble module
+ * implementation.
+ * -----------------------------------------------------------------
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <sundials/sundials_types.h>
+#include <sunmatrix/sunmatrix_ensemble.h>
+#include <nvector/nvector_serial.h>
+#include <sundials/sundials_math.h>
+#include "test_sunmatrix.h"
+
+#if defined(SUNDIALS_EXTENDED_PRECISION)
+#define GSYM "Lg"
+#define ESYM "Le"
+#define FSYM "Lf"
+#else
+#define GSYM "g"
+#define ESYM "e"
+#define FSYM "f"
+#endif
+
+/* ----------------------------------------------------------------------
+ * Main SUNMatrix Testing Routine
+ * --------------------------------------------------------------------*/
+int main(int argc, char *argv[])
+{
+  int          fails = 0;        /* counter for test failures  */
+  sunindextype nmembers, n;      /* ensemble and block sizes   */
+  N_Vector     x, y;             /* test vectors               */
+  realtype     *xdata, *ydata;   /* pointers to vector data    */
+  SUNMatrix    A, I;             /* test matrices              */
+  int          print_timing, nthreads;
+  sunindextype i, j, k;
+
+  /* check input and set sizes */
+  if (argc < 5){
+    printf("ERROR: FOUR (4) Input required: members, block size, threads, print timing \n");
+    return(-1);
+  }
+
+  nmembers = (sunindextype) atol(argv[1]);
+  if (nmembers <= 0) {
+    printf("ERROR: number of members must be a positive integer \n");
+    return(-1);
+  }
+
+  n = (sunindextype) atol(argv[2]);
+  if (n <= 0) {
+    printf("ERROR: block size must be a positive integer \n");
+    return(-1);
+  }
+
+  nthreads = atoi(argv[3]);
+  if (nthreads <= 0) {
+    printf("ERROR: number of threads must be a positive integer \n");
+    return(-1);
+  }
+
+  print_timing = atoi(argv[4]);
+  SetTiming(print_timing);
+
+  printf("\nEnsemble matrix test: %ld members of size %ld, %d threads\n\n",
+         (long int) nmembers, (long int) n, nthreads);
+
+  /* Create vectors and matrices */
+  x = N_VNew_Serial(nmembers*n);
+  y = N_VNew_Serial(nmembers*n);
+  A = SUNEnsembleMatrix(nmembers, n);
+  I = SUNEnsembleMatrix(nmembers, n);
+  SUNEnsembleMatrix_SetNumThreads(A, nthreads);
+  SUNEnsembleMatrix_SetNumThreads(I, nthreads);
+
+  /* Fill matrices and vectors, every member with a different block */
+  for (k=0; k < nmembers; k++) {
+    for (j=0; j < n; j++) {
+      for (i=0; i < n; i++) {
+        SM_ELEMENT_E(A,k,i,j) = (j+1)*(i+j) + k;
+      }
+      SM_ELEMENT_E(I,k,j,j) = ONE;
+    }
+  }
+
+  xdata = N_VGetArrayPointer(x);
+  ydata = N_VGetArrayPointer(y);
+  for (k=0; k < nmembers; k++) {
+    for (i=0; i < n; i++) {
+      xdata[SM_VINDEX_E(A,k,i)] = ONE / (i+1);
+    }
+    for (i=0; i < n; i++) {
+      ydata[SM_VINDEX_E(A,k,i)] = ZERO;
+      for (j=0; j < n; j++)
+        ydata[SM_VINDEX_E(A,k,i)] += SM_ELEMENT_E(A,k,i,j) / (j+1);
+    }
+  }
+
+  /* SUNMatrix Tests */
+  fails += Test_SUNMatGetID(A, SUNMATRIX_ENSEMBLE, 0);
+  fails += Test_SUNMatClone(A, 0);
+  fails += Test_SUNMatCopy(A, 0);
+  fails += Test_SUNMatZero(A, 0);
+  fails += Test_SUNMatScaleAdd(A, I, 0);
+  fails += Test_SUNMatScaleAddI(A, I, 0);
+  fails += Test_SUNMatMatvec(A, x, y, 0);
+  fails += Test_SUNMatSpace(A, 0);
+
+  /* Print result */
+  if (fails) {
+    printf("FAIL: SUNMatrix module failed %i tests \n \n", fails);
+    printf("\nA =\n");
+    SUNEnsembleMatrix_Print(A,stdout);
+    printf("\nI =\n");
+    SUNEnsembleMatrix_Print(I,stdout);
+    printf("\nx =\n");
+    N_VPrint_Serial(x);
+    printf("\ny =\n");
+    N_VPrint_Serial(y);
+  } else {
+    printf("SUCCESS: SUNMatrix module passed all tests \n \n");
+  }
+
+  /* Free vectors and matrices */
+  N_VDestroy(x);
+  N_VDestroy(y);
+  SUNMatDestroy(A);
+  SUNMatDestroy(I);
+
+  return(fails);
+}
+
+/* ----------------------------------------------------------------------
+ * Check matrix
+ * --------------------------------------------------------------------*/
+int check_matrix(SUNMatrix A, SUNMatrix B, realtype tol)
+{
+  int failure = 0;
+  realtype *Adata, *Bdata;
+  sunindextype Aldata, Bldata;
+  sunindextype i;
+
+  /* get data pointers */
+  Adata = SUNEnsembleMatrix_Data(A);
+  Bdata = SUNEnsembleMatrix_Data(B);
+
+  /* get and check data lengths */
+  Aldata = SUNEnsembleMatrix_LData(A);
+  Bldata = SUNEnsembleMatrix_LData(B);
+
+  if (Aldata != Bldata) {
+    printf(">>> ERROR: check_matrix: Different data array lengths \n");
+    return(1);
+  }
+
+  /* compare data */
+  for(i=0; i < Aldata; i++){
+    failure += FNEQ(Adata[i], Bdata[i], tol);
+  }
+
+  if (failure > ZERO)
+    return(1);
+  else
+    return(0);
+}
+
+int check_matrix_entry(SUNMatrix A, realtype val, realtype tol)
+{
+  int failure = 0;
+  realtype *Adata;
+  sunindextype Aldata;
+  sunindextype i;
+
+  /* get data pointer */
+  Adata = SUNEnsembleMatrix_Data(A);
+
+  /* compare data */
+  Aldata = SUNEnsembleMatrix_LData(A);
+  for(i=0; i < Aldata; i++){
+    failure += FNEQ(Adata[i], val, tol);
+  }
+
+  if (failure > ZERO) {
+    printf("Check_matrix_entry failures:\n");
+    for(i=0; i < Aldata; i++)
+      if (FNEQ(Adata[i], val, tol) != 0)
+        printf("  Adata[%ld] = %"GSYM" != %"GSYM" (err = %"GSYM")\n", (long int) i,
+               Adata[i], val, SUNRabs(Adata[i]-val));
+  }
+
+  if (failure > ZERO)
+    return(1);
+  else
+    return(0);
+}
+
+int check_vector(N_Vector x, N_Vector y, realtype tol)
+{
+  int failure = 0;
+  realtype *xdata, *ydata;
+  sunindextype xldata, yldata;
+  sunindextype i;
+
+  /* get vector data */
+  xdata = N_VGetArrayPointer(x);
+  ydata = N_VGetArrayPointer(y);
+
+  /* check data lengths */
+  xldata = N_VGetLength(x);
+  yldata = N_VGetLength(y);
+
+  if (xldata != yldata) {
+    printf(">>> ERROR: check_vector: Different data array lengths \n");
+    return(1);
+  }
+
+  /* check vector data */
+  for(i=0; i < xldata; i++)
+    failure += FNEQ(xdata[i], ydata[i], tol);
+
+  if (failure > ZERO) {
+    printf("Check_vector failures:\n");
+    for(i=0; i < xldata; i++)
+      if (FNEQ(xdata[i], ydata[i], tol) != 0)
+        printf("  xdata[%ld] = %"GSYM" != %"GSYM" (err = %"GSYM")\n", (long int) i,
+               xdata[i], ydata[i], SUNRabs(xdata[i]-ydata[i]));
+  }
+
+  if (failure > ZERO)
+    return(1);
+  else
+    return(0);
+}
+
+booleantype has_data(SUNMatrix A)
+{
+  realtype *Adata = SUNEnsembleMatrix_Data(A);
+  if (Adata == NULL)
+    return SUNFALSE;
+  else
+    return SUNTRUE;
+}
+
+booleantype is_square(SUNMatrix A)
+{
+  return SUNTRUE;
+}
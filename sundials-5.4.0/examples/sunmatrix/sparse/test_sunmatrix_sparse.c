@@ -32,8 +32,12 @@
 int Test_SUNMatScaleAdd2(SUNMatrix A, SUNMatrix B, N_Vector x,
                          N_Vector y, N_Vector z);
 int Test_SUNMatScaleAddI2(SUNMatrix A, N_Vector x, N_Vector y);
+int Test_SUNMatScaleAdd3(SUNMatrix A, SUNMatrix B, N_Vector x,
+                         N_Vector y, N_Vector z);
+int Test_SUNMatScaleAddI3(SUNMatrix A, N_Vector x, N_Vector y);
 int Test_SUNSparseMatrixToCSC(SUNMatrix A);
 int Test_SUNSparseMatrixToCSR(SUNMatrix A);
+int Test_SUNSparseMatrixColumnColoring(SUNMatrix A);
 
 /* ----------------------------------------------------------------------
  * Main SUNMatrix Testing Routine
@@ -51,10 +55,11 @@ int main(int argc, char *argv[])
   sunindextype *colptrs, *rowindices;
   sunindextype *rowptrs, *colindices;
   int          print_timing, square;
+  int          nthreads;                   /* matrix operation threads   */
 
   /* check input and set vector length */
   if (argc < 5){
-    printf("ERROR: FOUR (4) Input required: matrix rows, matrix cols, matrix type (0/1), print timing \n");
+    printf("ERROR: FOUR (4) Input required: matrix rows, matrix cols, matrix type (0/1), print timing [, threads] \n");
     return(-1);
   }
 
@@ -80,9 +85,15 @@ int main(int argc, char *argv[])
   print_timing = atoi(argv[4]);
   SetTiming(print_timing);
 
+  nthreads = (argc > 5) ? atoi(argv[5]) : 1;
+  if (nthreads < 1) {
+    printf("ERROR: number of threads must be a positive integer\n");
+    return(-1);
+  }
+
   square = (matrows == matcols) ? 1 : 0;
-  printf("\nSparse matrix test: size %ld by %ld, type = %i\n\n",
-         (long int) matrows, (long int) matcols, mattype);
+  printf("\nSparse matrix test: size %ld by %ld, type = %i, threads = %i\n\n",
+         (long int) matrows, (long int) matcols, mattype, nthreads);
 
   /* Initialize vectors and matrices to NULL */
   x = NULL;
@@ -307,6 +318,7 @@ int main(int argc, char *argv[])
       rowptrs[i] = i;
     }
     rowptrs[matrows] = matrows;
+    SUNSparseMatrix_SetNumThreads(I, nthreads);
   }
 
   /* Create/fill random dense matrices, create sparse from them */
@@ -326,6 +338,8 @@ int main(int argc, char *argv[])
   }
   A = SUNSparseFromDenseMatrix(C, ZERO, mattype);
   B = SUNSparseFromDenseMatrix(D, ZERO, mattype);
+  SUNSparseMatrix_SetNumThreads(A, nthreads);
+  SUNSparseMatrix_SetNumThreads(B, nthreads);
 
   /* Create vectors and fill */
   x = N_VNew_Serial(matcols);
@@ -360,9 +374,11 @@ int main(int argc, char *argv[])
   fails += Test_SUNMatZero(A, 0);
   fails += Test_SUNMatScaleAdd(A, I, 0);
   fails += Test_SUNMatScaleAdd2(A, B, x, y, z);
+  fails += Test_SUNMatScaleAdd3(A, B, x, y, z);
   if (square) {
     fails += Test_SUNMatScaleAddI(A, I, 0);
     fails += Test_SUNMatScaleAddI2(A, x, y);
+    fails += Test_SUNMatScaleAddI3(A, x, y);
   }
   fails += Test_SUNMatMatvec(A, x, y, 0);
   fails += Test_SUNMatSpace(A, 0);
@@ -371,6 +387,7 @@ int main(int argc, char *argv[])
   } else {
     fails += Test_SUNSparseMatrixToCSR(A);
   }
+  fails += Test_SUNSparseMatrixColumnColoring(A);
 
   /* Print result */
   if (fails) {
@@ -731,6 +748,127 @@ int Test_SUNMatScaleAddI2(SUNMatrix A, N_Vector x, N_Vector y)
   return(0);
 }
 
+/* ----------------------------------------------------------------------
+ * Repeated ScaleAdd tests for sparse matrices, as done in every Newton
+ * iteration of the integrators (these reuse the merged pattern):
+ *    A and B should have different sparsity patterns
+ *    y should already equal A*x
+ *    z should already equal B*x
+ * --------------------------------------------------------------------*/
+int Test_SUNMatScaleAdd3(SUNMatrix A, SUNMatrix B, N_Vector x,
+                         N_Vector y, N_Vector z)
+{
+  int       failure, iter;
+  SUNMatrix C;
+  N_Vector  u, v;
+  realtype  tol=100*UNIT_ROUNDOFF;
+
+  /* create clones for test */
+  C = SUNMatClone(A);
+  u = N_VClone(y);
+  v = N_VClone(y);
+
+  for (iter=0; iter<3; iter++) {
+
+    /* C = A+B, starting from the pattern of A */
+    failure = SUNMatCopy(A, C);
+    if (!failure) failure = SUNMatScaleAdd(ONE, C, B);
+    if (!failure) failure = SUNMatMatvec(C, x, u);    /* u = Ax+Bx */
+    if (failure) {
+      printf(">>> FAILED test -- SUNMatScaleAdd3 returned %d \n",
+             failure);
+      SUNMatDestroy(C);  N_VDestroy(u);  N_VDestroy(v);  return(1);
+    }
+    N_VLinearSum(ONE,y,ONE,z,v);                      /* v = y+z */
+    if (check_vector(u, v, tol)) {
+      printf(">>> FAILED test -- SUNMatScaleAdd3 check 1, iteration %i \n",
+             iter);
+      SUNMatDestroy(C);  N_VDestroy(u);  N_VDestroy(v);  return(1);
+    }
+
+    /* C = 2A+3B, with C already holding the merged pattern */
+    failure = SUNMatScaleAdd(TWO, C, B);
+    if (!failure) failure = SUNMatMatvec(C, x, u);    /* u = 2Ax+3Bx */
+    if (failure) {
+      printf(">>> FAILED test -- SUNMatScaleAdd3 returned %d \n",
+             failure);
+      SUNMatDestroy(C);  N_VDestroy(u);  N_VDestroy(v);  return(1);
+    }
+    N_VLinearSum(TWO,y,RCONST(3.0),z,v);              /* v = 2y+3z */
+    if (check_vector(u, v, 3*tol)) {
+      printf(">>> FAILED test -- SUNMatScaleAdd3 check 2, iteration %i \n",
+             iter);
+      SUNMatDestroy(C);  N_VDestroy(u);  N_VDestroy(v);  return(1);
+    }
+  }
+
+  printf("    PASSED test -- SUNMatScaleAdd3 \n");
+
+  SUNMatDestroy(C);
+  N_VDestroy(u);
+  N_VDestroy(v);
+  return(0);
+}
+
+/* ----------------------------------------------------------------------
+ * Repeated ScaleAddI tests for sparse matrices (these reuse the merged
+ * pattern):
+ *    y should already equal A*x
+ * --------------------------------------------------------------------*/
+int Test_SUNMatScaleAddI3(SUNMatrix A, N_Vector x, N_Vector y)
+{
+  int       failure, iter;
+  SUNMatrix B;
+  N_Vector  w, z;
+  realtype  tol=200*UNIT_ROUNDOFF;
+
+  /* create clones for test */
+  B = SUNMatClone(A);
+  z = N_VClone(x);
+  w = N_VClone(x);
+
+  for (iter=0; iter<3; iter++) {
+
+    /* B = I-A, starting from the pattern of A */
+    failure = SUNMatCopy(A, B);
+    if (!failure) failure = SUNMatScaleAddI(NEG_ONE, B);
+    if (!failure) failure = SUNMatMatvec(B, x, z);
+    if (failure) {
+      printf(">>> FAILED test -- SUNMatScaleAddI3 returned %d \n",
+             failure);
+      SUNMatDestroy(B);  N_VDestroy(z);  N_VDestroy(w);  return(1);
+    }
+    N_VLinearSum(ONE,x,NEG_ONE,y,w);   /* w = x-y */
+    if (check_vector(z, w, tol)) {
+      printf(">>> FAILED test -- SUNMatScaleAddI3 check 1, iteration %i \n",
+             iter);
+      SUNMatDestroy(B);  N_VDestroy(z);  N_VDestroy(w);  return(1);
+    }
+
+    /* B = I - 2(I-A) = 2A-I, with B already holding the merged pattern */
+    failure = SUNMatScaleAddI(-TWO, B);
+    if (!failure) failure = SUNMatMatvec(B, x, z);
+    if (failure) {
+      printf(">>> FAILED test -- SUNMatScaleAddI3 returned %d \n",
+             failure);
+      SUNMatDestroy(B);  N_VDestroy(z);  N_VDestroy(w);  return(1);
+    }
+    N_VLinearSum(TWO,y,NEG_ONE,x,w);   /* w = 2y-x */
+    if (check_vector(z, w, 3*tol)) {
+      printf(">>> FAILED test -- SUNMatScaleAddI3 check 2, iteration %i \n",
+             iter);
+      SUNMatDestroy(B);  N_VDestroy(z);  N_VDestroy(w);  return(1);
+    }
+  }
+
+  printf("    PASSED test -- SUNMatScaleAddI3 \n");
+
+  SUNMatDestroy(B);
+  N_VDestroy(z);
+  N_VDestroy(w);
+  return(0);
+}
+
 int Test_SUNSparseMatrixToCSR(SUNMatrix A)
 {
   int       failure;
@@ -803,6 +941,77 @@ int Test_SUNSparseMatrixToCSC(SUNMatrix A)
   return(0);
 }
 
+int Test_SUNSparseMatrixColumnColoring(SUNMatrix A)
+{
+  int          failure;
+  SUNMatrix    csr;
+  sunindextype N, M, i, j, k, g, ncolors;
+  sunindextype *colorptrs, *colorcols, *color, *mark, *Ap, *Aj;
+
+  M = SUNSparseMatrix_Rows(A);
+  N = SUNSparseMatrix_Columns(A);
+  colorptrs = (sunindextype *) malloc((N+1)*sizeof(sunindextype));
+  colorcols = (sunindextype *) malloc(N*sizeof(sunindextype));
+  color     = (sunindextype *) malloc(N*sizeof(sunindextype));
+  mark      = (sunindextype *) malloc(N*sizeof(sunindextype));
+
+  failure = SUNSparseMatrix_ColumnColoring(A, &ncolors, colorptrs, colorcols);
+  if (failure) {
+    printf(">>> FAILED test -- SUNSparseMatrix_ColumnColoring returned nonzero\n");
+    free(colorptrs); free(colorcols); free(color); free(mark);
+    return(1);
+  }
+
+  /* every column must have exactly one color */
+  for (j=0; j<N; j++)  color[j] = -1;
+  for (g=0; g<ncolors; g++)
+    for (k=colorptrs[g]; k<colorptrs[g+1]; k++) {
+      if (color[colorcols[k]] >= 0)  failure = 1;
+      color[colorcols[k]] = g;
+    }
+  for (j=0; j<N; j++)
+    if (color[j] < 0)  failure = 1;
+  if (failure) {
+    printf(">>> FAILED test -- SUNSparseMatrix_ColumnColoring invalid groups\n");
+    free(colorptrs); free(colorcols); free(color); free(mark);
+    return(1);
+  }
+
+  /* the columns in each row must have distinct colors */
+  if (SUNSparseMatrix_SparseType(A) == CSR_MAT) {
+    csr = SUNMatClone(A);
+    failure = (csr == NULL) ? 1 : SUNMatCopy(A, csr);
+  } else {
+    failure = SUNSparseMatrix_ToCSR(A, &csr);
+  }
+  if (failure) {
+    printf(">>> FAILED test -- unable to form the CSR matrix\n");
+    free(colorptrs); free(colorcols); free(color); free(mark);
+    return(1);
+  }
+  Ap = SUNSparseMatrix_IndexPointers(csr);
+  Aj = SUNSparseMatrix_IndexValues(csr);
+  for (g=0; g<N; g++)  mark[g] = -1;
+  for (i=0; i<M; i++)
+    for (k=Ap[i]; k<Ap[i+1]; k++) {
+      if (mark[color[Aj[k]]] == i)  failure = 1;
+      mark[color[Aj[k]]] = i;
+    }
+
+  SUNMatDestroy(csr);
+  free(colorptrs); free(colorcols); free(color); free(mark);
+
+  if (failure) {
+    printf(">>> FAILED test -- SUNSparseMatrix_ColumnColoring columns share a row\n");
+    return(1);
+  }
+
+  printf("    PASSED test -- SUNSparseMatrix_ColumnColoring (%ld colors)\n",
+         (long int) ncolors);
+
+  return(0);
+}
+
 
 /* ----------------------------------------------------------------------
  * Check matrix
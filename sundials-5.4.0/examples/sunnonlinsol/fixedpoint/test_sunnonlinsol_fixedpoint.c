@@ -118,12 +118,16 @@ int main(int argc, char *argv[])
   int                mxiter  = 20;
   int                maa     = 0;           /* no acceleration */
   realtype           damping = RCONST(1.0); /* no damping      */
+  int                gstype  = MODIFIED_GS; /* QR update       */
+  int                restart = 0;           /* no restarts     */
   long int           niters  = 0;
   realtype*          data    = NULL;
 
   /* Check if a acceleration/dampling values were provided */
   if (argc > 1) maa     = (long int) atoi(argv[1]);
   if (argc > 2) damping = (realtype) atof(argv[2]);
+  if (argc > 3) gstype  = atoi(argv[3]);
+  if (argc > 4) restart = atoi(argv[4]);
 
   /* Print problem description */
   printf("Solve the nonlinear system:\n");
@@ -139,6 +143,8 @@ int main(int argc, char *argv[])
   printf("    max iters = %d\n", mxiter);
   printf("    accel vec = %d\n", maa);
   printf("    damping   = %"GSYM"\n", damping);
+  printf("    GS type   = %d\n", gstype);
+  printf("    restart   = %d\n", restart);
 
   /* create proxy for integrator memory */
   Imem = (IntegratorMem) malloc(sizeof(struct IntegratorMemRec));
@@ -191,6 +197,13 @@ int main(int argc, char *argv[])
   retval = SUNNonlinSolSetDamping_FixedPoint(NLS, damping);
   if (check_retval(&retval, "SUNNonlinSolSetDamping", 1)) return(1);
 
+  /* set the QR update and restart interval */
+  retval = SUNNonlinSolSetGSType_FixedPoint(NLS, gstype);
+  if (check_retval(&retval, "SUNNonlinSolSetGSType", 1)) return(1);
+
+  retval = SUNNonlinSolSetRestart_FixedPoint(NLS, restart);
+  if (check_retval(&retval, "SUNNonlinSolSetRestart", 1)) return(1);
+
   /* solve the nonlinear system */
   retval = SUNNonlinSolSolve(NLS, Imem->y0, Imem->ycor, Imem->w, tol, SUNTRUE,
                              Imem);
@@ -20,6 +20,7 @@
 #include <sundials/sundials_nvector.h>
 #include <sundials/sundials_linearsolver.h>
 #include <sundials/sundials_nonlinearsolver.h>
+#include <sundials/sundials_profile.h>
 #include <arkode/arkode.h>
 #include <arkode/arkode_ls.h>
 #include <arkode/arkode_butcher_erk.h>
@@ -247,6 +248,8 @@ SUNDIALS_EXPORT int ARKStepSetMassTimes(void *arkode_mem,
                                         ARKLsMassTimesVecFn mtimes,
                                         void *mtimes_data);
 SUNDIALS_EXPORT int ARKStepSetLinSysFn(void *arkode_mem, ARKLsLinSysFn linsys);
+SUNDIALS_EXPORT int ARKStepSetSparseDQJac(void *arkode_mem, SUNMatrix S,
+                                          int nthreads);
 
 /* Integrate the ODE over an interval in t */
 SUNDIALS_EXPORT int ARKStepEvolve(void *arkode_mem, realtype tout,
@@ -311,6 +314,7 @@ SUNDIALS_EXPORT int ARKStepGetRootInfo(void *arkode_mem,
                                        int *rootsfound);
 SUNDIALS_EXPORT int ARKStepGetNumConstrFails(void *arkode_mem,
                                              long int *nconstrfails);
+SUNDIALS_EXPORT int ARKStepGetProfile(void *arkode_mem, SUNProfile *prof);
 SUNDIALS_EXPORT char *ARKStepGetReturnFlagName(long int flag);
 
 SUNDIALS_EXPORT int ARKStepWriteParameters(void *arkode_mem, FILE *fp);
@@ -229,6 +229,8 @@ SUNDIALS_EXPORT int MRIStepSetJacTimes(void *arkode_mem,
 SUNDIALS_EXPORT int MRIStepSetJacTimesRhsFn(void *arkode_mem,
                                             ARKRhsFn jtimesRhsFn);
 SUNDIALS_EXPORT int MRIStepSetLinSysFn(void *arkode_mem, ARKLsLinSysFn linsys);
+SUNDIALS_EXPORT int MRIStepSetSparseDQJac(void *arkode_mem, SUNMatrix S,
+                                          int nthreads);
 
 /* Integrate the ODE over an interval in t */
 SUNDIALS_EXPORT int MRIStepEvolve(void *arkode_mem, realtype tout,
@@ -21,6 +21,7 @@
 #include <stdio.h>
 #include <sundials/sundials_nvector.h>
 #include <sundials/sundials_nonlinearsolver.h>
+#include <sundials/sundials_profile.h>
 #include <cvode/cvode_ls.h>
 #include <cvode/cvode_proj.h>
 
@@ -40,6 +41,10 @@ extern "C" {
 #define CV_NORMAL         1
 #define CV_ONE_STEP       2
 
+/* batch dense output layout */
+#define CV_ROW_MAJOR      0
+#define CV_COL_MAJOR      1
+
 
 /* return values */
 
@@ -151,17 +156,27 @@ SUNDIALS_EXPORT int CVodeRootInit(void *cvode_mem, int nrtfn, CVRootFn g);
 /* Rootfinding optional input functions */
 SUNDIALS_EXPORT int CVodeSetRootDirection(void *cvode_mem, int *rootdir);
 SUNDIALS_EXPORT int CVodeSetNoInactiveRootWarn(void *cvode_mem);
+SUNDIALS_EXPORT int CVodeSetRootSearchPoints(void *cvode_mem, int npoints);
 
 /* Solver function */
 SUNDIALS_EXPORT int CVode(void *cvode_mem, realtype tout, N_Vector yout,
                           realtype *tret, int itask);
 
+/* Ensemble solver function */
+SUNDIALS_EXPORT int CVodeEnsemble(void **cvode_mems, int nmembers,
+                                  realtype tout, N_Vector *yout,
+                                  realtype *tret, int itask, int nthreads,
+                                  int *flags);
+
 /* Utility functions to update/compute y based on ycor */
 SUNDIALS_EXPORT int CVodeComputeState(void *cvode_mem, N_Vector ycor, N_Vector y);
 
 /* Dense output function */
 SUNDIALS_EXPORT int CVodeGetDky(void *cvode_mem, realtype t, int k,
                                 N_Vector dky);
+SUNDIALS_EXPORT int CVodeGetDkyBatch(void *cvode_mem, int ntimes,
+                                     realtype *times, int k, int layout,
+                                     realtype *dky);
 
 /* Optional output functions */
 SUNDIALS_EXPORT int CVodeGetWorkSpace(void *cvode_mem, long int *lenrw,
@@ -187,6 +202,9 @@ SUNDIALS_EXPORT int CVodeGetErrWeights(void *cvode_mem, N_Vector eweight);
 SUNDIALS_EXPORT int CVodeGetEstLocalErrors(void *cvode_mem, N_Vector ele);
 SUNDIALS_EXPORT int CVodeGetNumGEvals(void *cvode_mem, long int *ngevals);
 SUNDIALS_EXPORT int CVodeGetRootInfo(void *cvode_mem, int *rootsfound);
+SUNDIALS_EXPORT int CVodeGetRootfindStats(void *cvode_mem, long int *nrtiters,
+                                          long int *ngevals_step,
+                                          long int *nrtiters_step);
 SUNDIALS_EXPORT int CVodeGetIntegratorStats(void *cvode_mem, long int *nsteps,
                                             long int *nfevals,
                                             long int *nlinsetups,
@@ -205,6 +223,7 @@ SUNDIALS_EXPORT int CVodeGetNumNonlinSolvConvFails(void *cvode_mem,
                                                    long int *nncfails);
 SUNDIALS_EXPORT int CVodeGetNonlinSolvStats(void *cvode_mem, long int *nniters,
                                             long int *nncfails);
+SUNDIALS_EXPORT int CVodeGetProfile(void *cvode_mem, SUNProfile *prof);
 SUNDIALS_EXPORT char *CVodeGetReturnFlagName(long int flag);
 
 /* Free function */
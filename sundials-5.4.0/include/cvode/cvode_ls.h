@@ -102,6 +102,8 @@ SUNDIALS_EXPORT int CVodeSetJacTimes(void *cvode_mem,
                                      CVLsJacTimesSetupFn jtsetup,
                                      CVLsJacTimesVecFn jtimes);
 SUNDIALS_EXPORT int CVodeSetLinSysFn(void *cvode_mem, CVLsLinSysFn linsys);
+SUNDIALS_EXPORT int CVodeSetSparseDQJac(void *cvode_mem, SUNMatrix S,
+                                        int nthreads);
 
 /*-----------------------------------------------------------------
   Optional outputs from the CVLS linear solver interface
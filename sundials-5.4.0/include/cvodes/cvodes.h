@@ -51,6 +51,11 @@ extern "C" {
 #define CV_HERMITE        1
 #define CV_POLYNOMIAL     2
 
+/* check point storage */
+#define CV_CKPNT_MEMORY   0
+#define CV_CKPNT_FILE     1
+#define CV_CKPNT_ZLIB     2
+
 /* return values */
 
 #define CV_SUCCESS               0
@@ -518,6 +523,9 @@ SUNDIALS_EXPORT int CVodeB(void *cvode_mem, realtype tBout, int itaskB);
 /* Optional Input Functions For Adjoint Problems */
 
 SUNDIALS_EXPORT int CVodeSetAdjNoSensi(void *cvode_mem);
+SUNDIALS_EXPORT int CVodeSetAdjCheckPointStorage(void *cvode_mem, int storage,
+                                                 const char *dir);
+SUNDIALS_EXPORT int CVodeSetAdjMaxCheckPoints(void *cvode_mem, int maxckpnts);
 
 SUNDIALS_EXPORT int CVodeSetUserDataB(void *cvode_mem, int which,
                                       void *user_dataB);
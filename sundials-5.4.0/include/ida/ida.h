@@ -21,6 +21,7 @@
 #include <stdio.h>
 #include <sundials/sundials_nvector.h>
 #include <sundials/sundials_nonlinearsolver.h>
+#include <sundials/sundials_profile.h>
 #include <ida/ida_ls.h>
 
 #ifdef __cplusplus  /* wrapper to enable C++ usage */
@@ -39,6 +40,10 @@ extern "C" {
 #define IDA_YA_YDP_INIT      1
 #define IDA_Y_INIT           2
 
+/* batch dense output layout */
+#define IDA_ROW_MAJOR        0
+#define IDA_COL_MAJOR        1
+
 /* return values */
 
 #define IDA_SUCCESS          0
@@ -154,17 +159,26 @@ SUNDIALS_EXPORT int IDARootInit(void *ida_mem, int nrtfn, IDARootFn g);
 /* Rootfinding optional input functions */
 SUNDIALS_EXPORT int IDASetRootDirection(void *ida_mem, int *rootdir);
 SUNDIALS_EXPORT int IDASetNoInactiveRootWarn(void *ida_mem);
+SUNDIALS_EXPORT int IDASetRootSearchPoints(void *ida_mem, int npoints);
 
 /* Solver function */
 SUNDIALS_EXPORT int IDASolve(void *ida_mem, realtype tout, realtype *tret,
                              N_Vector yret, N_Vector ypret, int itask);
 
+/* Ensemble solver function */
+SUNDIALS_EXPORT int IDAEnsemble(void **ida_mems, int nmembers, realtype tout,
+                                realtype *tret, N_Vector *yret,
+                                N_Vector *ypret, int itask, int nthreads,
+                                int *flags);
+
 /* Utility functions to update/compute y and yp based on ycor */
 SUNDIALS_EXPORT int IDAComputeY(void *ida_mem, N_Vector ycor, N_Vector y);
 SUNDIALS_EXPORT int IDAComputeYp(void *ida_mem, N_Vector ycor, N_Vector yp);
 
 /* Dense output function */
 SUNDIALS_EXPORT int IDAGetDky(void *ida_mem, realtype t, int k, N_Vector dky);
+SUNDIALS_EXPORT int IDAGetDkyBatch(void *ida_mem, int ntimes, realtype *times,
+                                   int k, int layout, realtype *dky);
 
 /* Optional output functions */
 SUNDIALS_EXPORT int IDAGetWorkSpace(void *ida_mem, long int *lenrw,
@@ -190,6 +204,9 @@ SUNDIALS_EXPORT int IDAGetErrWeights(void *ida_mem, N_Vector eweight);
 SUNDIALS_EXPORT int IDAGetEstLocalErrors(void *ida_mem, N_Vector ele);
 SUNDIALS_EXPORT int IDAGetNumGEvals(void *ida_mem, long int *ngevals);
 SUNDIALS_EXPORT int IDAGetRootInfo(void *ida_mem, int *rootsfound);
+SUNDIALS_EXPORT int IDAGetRootfindStats(void *ida_mem, long int *nrtiters,
+                                        long int *ngevals_step,
+                                        long int *nrtiters_step);
 SUNDIALS_EXPORT int IDAGetIntegratorStats(void *ida_mem, long int *nsteps,
                                           long int *nrevals,
                                           long int *nlinsetups,
@@ -208,6 +225,7 @@ SUNDIALS_EXPORT int IDAGetNumNonlinSolvConvFails(void *ida_mem,
                                                  long int *nncfails);
 SUNDIALS_EXPORT int IDAGetNonlinSolvStats(void *ida_mem, long int *nniters,
                                           long int *nncfails);
+SUNDIALS_EXPORT int IDAGetProfile(void *ida_mem, SUNProfile *prof);
 SUNDIALS_EXPORT char *IDAGetReturnFlagName(long int flag);
 
 /* Free function */
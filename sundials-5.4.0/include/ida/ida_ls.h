@@ -103,6 +103,8 @@ SUNDIALS_EXPORT int IDASetLinearSolutionScaling(void *ida_mem,
                                                 booleantype onoff);
 SUNDIALS_EXPORT int IDASetIncrementFactor(void *ida_mem,
                                           realtype dqincfac);
+SUNDIALS_EXPORT int IDASetSparseDQJac(void *ida_mem, SUNMatrix S,
+                                      int nthreads);
 
 /*-----------------------------------------------------------------
   Optional outputs from the IDALS linear solver interface
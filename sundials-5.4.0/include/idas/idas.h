@@ -50,6 +50,11 @@ extern "C" {
 #define IDA_HERMITE          1
 #define IDA_POLYNOMIAL       2
 
+/* check point storage */
+#define IDA_CKPNT_MEMORY     0
+#define IDA_CKPNT_FILE       1
+#define IDA_CKPNT_ZLIB       2
+
 /* return values */
 
 #define IDA_SUCCESS          0
@@ -519,6 +524,9 @@ SUNDIALS_EXPORT int IDASolveB(void *ida_mem, realtype tBout, int itaskB);
 /* Optional Input Functions For Adjoint Problems */
 
 SUNDIALS_EXPORT int IDAAdjSetNoSensi(void *ida_mem);
+SUNDIALS_EXPORT int IDAAdjSetCheckPointStorage(void *ida_mem, int storage,
+                                               const char *dir);
+SUNDIALS_EXPORT int IDAAdjSetMaxCheckPoints(void *ida_mem, int maxckpnts);
 
 SUNDIALS_EXPORT int IDASetUserDataB(void *ida_mem, int which, void *user_dataB);
 SUNDIALS_EXPORT int IDASetMaxOrdB(void *ida_mem, int which, int maxordB);
@@ -38,6 +38,15 @@
  *
  *     (which stores the result of the operation a*x+b*y in y)
  *     is legal.
+ *
+ *   - The threads that carry out the vector operations are created
+ *     with a new vector (N_VNew_Pthreads, N_VNewEmpty_Pthreads or
+ *     N_VMake_Pthreads) and shared by its clones, and they are kept
+ *     until the last of these vectors is destroyed. Between
+ *     operations they spin briefly and then sleep. Operations on
+ *     vectors that share a pool are run one at a time, and the
+ *     number of threads of a vector must not be changed after it
+ *     is created.
  * -----------------------------------------------------------------*/
 
 #ifndef _NVECTOR_PTHREADS_H
@@ -57,11 +66,19 @@ extern "C" {
  * -----------------------------------------------------------------
  */
 
+/* Persistent pool of worker threads that runs the vector operations. It
+   is created with a new vector, shared by the clones of that vector, and
+   destroyed with the last of them. Its definition is private to the
+   implementation. */
+
+struct _Pthreads_Pool;
+
 struct _N_VectorContent_Pthreads {
-  sunindextype length;   /* vector length           */
-  booleantype own_data;  /* data ownership flag     */
-  realtype *data;        /* data array              */
-  int num_threads;       /* number of POSIX threads */
+  sunindextype length;         /* vector length           */
+  booleantype own_data;        /* data ownership flag     */
+  realtype *data;              /* data array              */
+  int num_threads;             /* number of POSIX threads */
+  struct _Pthreads_Pool *pool; /* pool of worker threads  */
 };
 
 typedef struct _N_VectorContent_Pthreads *N_VectorContent_Pthreads;
@@ -0,0 +1,225 @@
+/* -----------------------------------------------------------------
+ * Acknowledgements: This NVECTOR module is based on the NVECTOR
+ *                   OpenMP module by David J. Gardner and Carol S.
+ *                   Woodward @ LLNL
+ * -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2020, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the header file for the Intel TBB implementation of the
+ * NVECTOR module.
+ *
+ * Notes:
+ *
+ *   - The definition of the generic N_Vector structure can be found
+ *     in the header file sundials_nvector.h.
+ *
+ *   - The definition of the type 'realtype' can be found in the
+ *     header file sundials_types.h, and it may be changed (at the
+ *     configuration stage) according to the user's needs.
+ *     The sundials_types.h file also contains the definition
+ *     for the type 'booleantype'.
+ *
+ *   - The vector operations run with tbb::parallel_for and
+ *     tbb::parallel_reduce. Each vector has its own
+ *     tbb::affinity_partitioner, so that repeated operations on the
+ *     same vector are given to the same threads. As a consequence,
+ *     two operations on the same vector must not run concurrently
+ *     from different application threads.
+ *
+ *   - The arena argument of the constructors is a pointer to a
+ *     tbb::task_arena (or NULL). If it is not NULL, the vector
+ *     operations are executed in that arena, which limits the
+ *     number of threads they use; otherwise they run in the default
+ *     arena. The arena is not owned by the vector, and must outlive
+ *     it and all of its clones. Programs written in C may use
+ *     N_VNewTaskArena_Tbb and N_VFreeTaskArena_Tbb to create and
+ *     free an arena.
+ *
+ *   - N_Vector arguments to arithmetic vector operations need not
+ *     be distinct. For example, the following call:
+ *
+ *       N_VLinearSum_Tbb(a,x,b,y,y);
+ *
+ *     (which stores the result of the operation a*x+b*y in y)
+ *     is legal.
+ * -----------------------------------------------------------------*/
+
+#ifndef _NVECTOR_TBB_H
+#define _NVECTOR_TBB_H
+
+#include <stdio.h>
+#include <sundials/sundials_nvector.h>
+
+#ifdef __cplusplus  /* wrapper to enable C++ usage */
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------
+ * TBB implementation of N_Vector
+ * -----------------------------------------------------------------
+ */
+
+struct _N_VectorContent_Tbb {
+  sunindextype length;   /* vector length                          */
+  booleantype own_data;  /* data ownership flag                    */
+  realtype *data;        /* data array                             */
+  void *arena;           /* tbb::task_arena to run in (or NULL)    */
+  void *partitioner;     /* tbb::affinity_partitioner of the vector */
+};
+
+typedef struct _N_VectorContent_Tbb *N_VectorContent_Tbb;
+
+/*
+ * -----------------------------------------------------------------
+ * Macros NV_CONTENT_TBB, NV_DATA_TBB, NV_OWN_DATA_TBB,
+ *        NV_LENGTH_TBB, NV_ARENA_TBB, and NV_Ith_TBB
+ * -----------------------------------------------------------------
+ */
+
+#define NV_CONTENT_TBB(v)  ( (N_VectorContent_Tbb)(v->content) )
+
+#define NV_LENGTH_TBB(v)   ( NV_CONTENT_TBB(v)->length )
+
+#define NV_ARENA_TBB(v)    ( NV_CONTENT_TBB(v)->arena )
+
+#define NV_OWN_DATA_TBB(v) ( NV_CONTENT_TBB(v)->own_data )
+
+#define NV_DATA_TBB(v)     ( NV_CONTENT_TBB(v)->data )
+
+#define NV_Ith_TBB(v,i)    ( NV_DATA_TBB(v)[i] )
+
+/*
+ * -----------------------------------------------------------------
+ * Functions exported by nvector_tbb
+ * -----------------------------------------------------------------
+ */
+
+SUNDIALS_EXPORT N_Vector N_VNew_Tbb(sunindextype vec_length, void *arena);
+
+SUNDIALS_EXPORT N_Vector N_VNewEmpty_Tbb(sunindextype vec_length, void *arena);
+
+SUNDIALS_EXPORT N_Vector N_VMake_Tbb(sunindextype vec_length, realtype *v_data,
+                                     void *arena);
+
+SUNDIALS_EXPORT N_Vector* N_VCloneVectorArray_Tbb(int count, N_Vector w);
+
+SUNDIALS_EXPORT N_Vector* N_VCloneVectorArrayEmpty_Tbb(int count, N_Vector w);
+
+SUNDIALS_EXPORT void N_VDestroyVectorArray_Tbb(N_Vector* vs, int count);
+
+SUNDIALS_EXPORT sunindextype N_VGetLength_Tbb(N_Vector v);
+
+SUNDIALS_EXPORT void N_VPrint_Tbb(N_Vector v);
+
+SUNDIALS_EXPORT void N_VPrintFile_Tbb(N_Vector v, FILE *outfile);
+
+SUNDIALS_EXPORT void *N_VNewTaskArena_Tbb(int max_concurrency);
+
+SUNDIALS_EXPORT void N_VFreeTaskArena_Tbb(void *arena);
+
+
+SUNDIALS_EXPORT N_Vector_ID N_VGetVectorID_Tbb(N_Vector v);
+SUNDIALS_EXPORT N_Vector N_VCloneEmpty_Tbb(N_Vector w);
+SUNDIALS_EXPORT N_Vector N_VClone_Tbb(N_Vector w);
+SUNDIALS_EXPORT void N_VDestroy_Tbb(N_Vector v);
+SUNDIALS_EXPORT void N_VSpace_Tbb(N_Vector v, sunindextype *lrw, sunindextype *liw);
+SUNDIALS_EXPORT realtype *N_VGetArrayPointer_Tbb(N_Vector v);
+SUNDIALS_EXPORT void N_VSetArrayPointer_Tbb(realtype *v_data, N_Vector v);
+
+/* standard vector operations */
+SUNDIALS_EXPORT void N_VLinearSum_Tbb(realtype a, N_Vector x, realtype b, N_Vector y, N_Vector z);
+SUNDIALS_EXPORT void N_VConst_Tbb(realtype c, N_Vector z);
+SUNDIALS_EXPORT void N_VProd_Tbb(N_Vector x, N_Vector y, N_Vector z);
+SUNDIALS_EXPORT void N_VDiv_Tbb(N_Vector x, N_Vector y, N_Vector z);
+SUNDIALS_EXPORT void N_VScale_Tbb(realtype c, N_Vector x, N_Vector z);
+SUNDIALS_EXPORT void N_VAbs_Tbb(N_Vector x, N_Vector z);
+SUNDIALS_EXPORT void N_VInv_Tbb(N_Vector x, N_Vector z);
+SUNDIALS_EXPORT void N_VAddConst_Tbb(N_Vector x, realtype b, N_Vector z);
+SUNDIALS_EXPORT realtype N_VDotProd_Tbb(N_Vector x, N_Vector y);
+SUNDIALS_EXPORT realtype N_VMaxNorm_Tbb(N_Vector x);
+SUNDIALS_EXPORT realtype N_VWrmsNorm_Tbb(N_Vector x, N_Vector w);
+SUNDIALS_EXPORT realtype N_VWrmsNormMask_Tbb(N_Vector x, N_Vector w, N_Vector id);
+SUNDIALS_EXPORT realtype N_VMin_Tbb(N_Vector x);
+SUNDIALS_EXPORT realtype N_VWL2Norm_Tbb(N_Vector x, N_Vector w);
+SUNDIALS_EXPORT realtype N_VL1Norm_Tbb(N_Vector x);
+SUNDIALS_EXPORT void N_VCompare_Tbb(realtype c, N_Vector x, N_Vector z);
+SUNDIALS_EXPORT booleantype N_VInvTest_Tbb(N_Vector x, N_Vector z);
+SUNDIALS_EXPORT booleantype N_VConstrMask_Tbb(N_Vector c, N_Vector x, N_Vector m);
+SUNDIALS_EXPORT realtype N_VMinQuotient_Tbb(N_Vector num, N_Vector denom);
+
+/* fused vector operations */
+SUNDIALS_EXPORT int N_VLinearCombination_Tbb(int nvec, realtype* c,
+                                             N_Vector* V, N_Vector z);
+SUNDIALS_EXPORT int N_VScaleAddMulti_Tbb(int nvec, realtype* a, N_Vector x,
+                                         N_Vector* Y, N_Vector* Z);
+SUNDIALS_EXPORT int N_VDotProdMulti_Tbb(int nvec, N_Vector x,
+                                        N_Vector* Y, realtype* dotprods);
+
+/* vector array operations */
+SUNDIALS_EXPORT int N_VLinearSumVectorArray_Tbb(int nvec,
+                                                realtype a, N_Vector* X,
+                                                realtype b, N_Vector* Y,
+                                                N_Vector* Z);
+SUNDIALS_EXPORT int N_VScaleVectorArray_Tbb(int nvec, realtype* c,
+                                            N_Vector* X, N_Vector* Z);
+SUNDIALS_EXPORT int N_VConstVectorArray_Tbb(int nvecs, realtype c,
+                                            N_Vector* Z);
+SUNDIALS_EXPORT int N_VWrmsNormVectorArray_Tbb(int nvecs, N_Vector* X,
+                                               N_Vector* W, realtype* nrm);
+SUNDIALS_EXPORT int N_VWrmsNormMaskVectorArray_Tbb(int nvecs, N_Vector* X,
+                                                   N_Vector* W, N_Vector id,
+                                                   realtype* nrm);
+SUNDIALS_EXPORT int N_VScaleAddMultiVectorArray_Tbb(int nvec, int nsum,
+                                                    realtype* a,
+                                                    N_Vector* X,
+                                                    N_Vector** Y,
+                                                    N_Vector** Z);
+SUNDIALS_EXPORT int N_VLinearCombinationVectorArray_Tbb(int nvec, int nsum,
+                                                        realtype* c,
+                                                        N_Vector** X,
+                                                        N_Vector* Z);
+
+/* OPTIONAL local reduction kernels (no parallel communication) */
+SUNDIALS_EXPORT realtype N_VWSqrSumLocal_Tbb(N_Vector x, N_Vector w);
+SUNDIALS_EXPORT realtype N_VWSqrSumMaskLocal_Tbb(N_Vector x, N_Vector w,
+                                                 N_Vector id);
+
+/* OPTIONAL XBraid interface operations */
+SUNDIALS_EXPORT int N_VBufSize_Tbb(N_Vector x, sunindextype *size);
+SUNDIALS_EXPORT int N_VBufPack_Tbb(N_Vector x, void *buf);
+SUNDIALS_EXPORT int N_VBufUnpack_Tbb(N_Vector x, void *buf);
+
+/*
+ * -----------------------------------------------------------------
+ * Enable / disable fused vector operations
+ * -----------------------------------------------------------------
+ */
+
+SUNDIALS_EXPORT int N_VEnableFusedOps_Tbb(N_Vector v, booleantype tf);
+
+SUNDIALS_EXPORT int N_VEnableLinearCombination_Tbb(N_Vector v, booleantype tf);
+SUNDIALS_EXPORT int N_VEnableScaleAddMulti_Tbb(N_Vector v, booleantype tf);
+SUNDIALS_EXPORT int N_VEnableDotProdMulti_Tbb(N_Vector v, booleantype tf);
+
+SUNDIALS_EXPORT int N_VEnableLinearSumVectorArray_Tbb(N_Vector v, booleantype tf);
+SUNDIALS_EXPORT int N_VEnableScaleVectorArray_Tbb(N_Vector v, booleantype tf);
+SUNDIALS_EXPORT int N_VEnableConstVectorArray_Tbb(N_Vector v, booleantype tf);
+SUNDIALS_EXPORT int N_VEnableWrmsNormVectorArray_Tbb(N_Vector v, booleantype tf);
+SUNDIALS_EXPORT int N_VEnableWrmsNormMaskVectorArray_Tbb(N_Vector v, booleantype tf);
+SUNDIALS_EXPORT int N_VEnableScaleAddMultiVectorArray_Tbb(N_Vector v, booleantype tf);
+SUNDIALS_EXPORT int N_VEnableLinearCombinationVectorArray_Tbb(N_Vector v, booleantype tf);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -87,6 +87,7 @@ typedef enum {
   SUNLINEARSOLVER_SUPERLUDIST,
   SUNLINEARSOLVER_SUPERLUMT,
   SUNLINEARSOLVER_CUSOLVERSP_BATCHQR,
+  SUNLINEARSOLVER_ENSEMBLE,
   SUNLINEARSOLVER_CUSTOM
 } SUNLinearSolver_ID;
 
@@ -73,6 +73,7 @@ typedef enum {
   SUNDIALS_NVEC_MANYVECTOR,
   SUNDIALS_NVEC_MPIMANYVECTOR,
   SUNDIALS_NVEC_MPIPLUSX,
+  SUNDIALS_NVEC_TBB,
   SUNDIALS_NVEC_CUSTOM
 } N_Vector_ID;
 
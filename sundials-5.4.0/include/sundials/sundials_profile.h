@@ -0,0 +1,68 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2020, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the header file for the phase timers of the SUNDIALS
+ * integrators. If SUNDIALS is built with
+ * SUNDIALS_BUILD_WITH_PROFILING, the integrators time the phases
+ * below with a monotonic clock, and the totals are returned by
+ * CVodeGetProfile, IDAGetProfile and ARKStepGetProfile. Otherwise
+ * the timers are compiled out.
+ *
+ * The phases are timed where they are called, so nested phases
+ * are counted in both: a step includes all the other phases except
+ * root finding and interpolation, the Jacobian time is part of the
+ * linear setup time, and difference quotient Jacobians and
+ * preconditioners add to the RHS/residual time (except for the
+ * colored sparse Jacobian, which may call f on several threads).
+ * -----------------------------------------------------------------*/
+
+#ifndef _SUNDIALS_PROFILE_H
+#define _SUNDIALS_PROFILE_H
+
+#include <stdio.h>
+#include <sundials/sundials_config.h>
+
+#ifdef __cplusplus  /* wrapper to enable C++ usage */
+extern "C" {
+#endif
+
+/* Timed phases */
+typedef enum {
+  SUN_PROFILE_RHS,       /* RHS (CVODE, ARKODE) or residual (IDA)    */
+  SUN_PROFILE_JAC,       /* Jacobian function or approximation       */
+  SUN_PROFILE_LSETUP,    /* linear solver setup                      */
+  SUN_PROFILE_LSOLVE,    /* linear solver solve                      */
+  SUN_PROFILE_ERRTEST,   /* local error test                         */
+  SUN_PROFILE_ROOTFIND,  /* root finding, incl. calls to g           */
+  SUN_PROFILE_INTERP,    /* interpolation of the solution (GetDky)   */
+  SUN_PROFILE_NLSOLVE,   /* nonlinear solve of a step or stage       */
+  SUN_PROFILE_STEP,      /* internal step, incl. failed attempts     */
+  SUN_PROFILE_NPHASES
+} SUNProfilePhase;
+
+/* Times (in seconds) and number of calls of each phase */
+typedef struct SUNProfileRec {
+  double   time[SUN_PROFILE_NPHASES];
+  long int ncalls[SUN_PROFILE_NPHASES];
+  double   tstart[SUN_PROFILE_NPHASES];  /* start of a running phase */
+} SUNProfile;
+
+/* Returns the name of a phase, e.g. "rhs" */
+SUNDIALS_EXPORT const char *SUNProfile_PhaseName(int phase);
+
+/* Writes the times and calls of all phases to fp as a JSON object */
+SUNDIALS_EXPORT int SUNProfile_WriteJSON(SUNProfile *prof, FILE *fp);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,82 @@
+/*
+ * -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2020, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the header file for the ensemble implementation of the
+ * SUNLINSOL module, SUNLINSOL_ENSEMBLE.
+ *
+ * The solver factors the blocks of a SUNMATRIX_ENSEMBLE matrix
+ * all at once: each step of the LU factorization (with partial
+ * pivoting in every member) and of the triangular solves is done
+ * for all members in an innermost loop over the interleaved
+ * members.
+ *
+ * Notes:
+ *   - The definition of the generic SUNLinearSolver structure can
+ *     be found in the header file sundials_linearsolver.h.
+ *   - The definition of the type 'realtype' can be found in the
+ *     header file sundials_types.h, and it may be changed (at the
+ *     configuration stage) according to the user's needs.
+ *     The sundials_types.h file also contains the definition
+ *     for the type 'booleantype' and 'indextype'.
+ *   - The members are split over the number of threads set for
+ *     the matrix with SUNEnsembleMatrix_SetNumThreads.
+ * -----------------------------------------------------------------
+ */
+
+#ifndef _SUNLINSOL_ENSEMBLE_H
+#define _SUNLINSOL_ENSEMBLE_H
+
+#include <sundials/sundials_linearsolver.h>
+#include <sundials/sundials_matrix.h>
+#include <sundials/sundials_nvector.h>
+#include <sunmatrix/sunmatrix_ensemble.h>
+
+#ifdef __cplusplus  /* wrapper to enable C++ usage */
+extern "C" {
+#endif
+
+/* -------------------------------------------
+ * Ensemble Implementation of SUNLinearSolver
+ * ------------------------------------------- */
+
+struct _SUNLinearSolverContent_Ensemble {
+  sunindextype nmembers;
+  sunindextype blocksize;
+  sunindextype *pivots;    /* interleaved like the matrix rows */
+  sunindextype last_flag;
+};
+
+typedef struct _SUNLinearSolverContent_Ensemble *SUNLinearSolverContent_Ensemble;
+
+/* -------------------------------------------
+ * Exported Functions for SUNLINSOL_ENSEMBLE
+ * ------------------------------------------- */
+
+SUNDIALS_EXPORT SUNLinearSolver SUNLinSol_Ensemble(N_Vector y, SUNMatrix A);
+
+SUNDIALS_EXPORT SUNLinearSolver_Type SUNLinSolGetType_Ensemble(SUNLinearSolver S);
+SUNDIALS_EXPORT SUNLinearSolver_ID SUNLinSolGetID_Ensemble(SUNLinearSolver S);
+SUNDIALS_EXPORT int SUNLinSolInitialize_Ensemble(SUNLinearSolver S);
+SUNDIALS_EXPORT int SUNLinSolSetup_Ensemble(SUNLinearSolver S, SUNMatrix A);
+SUNDIALS_EXPORT int SUNLinSolSolve_Ensemble(SUNLinearSolver S, SUNMatrix A,
+                                            N_Vector x, N_Vector b, realtype tol);
+SUNDIALS_EXPORT sunindextype SUNLinSolLastFlag_Ensemble(SUNLinearSolver S);
+SUNDIALS_EXPORT int SUNLinSolSpace_Ensemble(SUNLinearSolver S,
+                                            long int *lenrwLS,
+                                            long int *leniwLS);
+SUNDIALS_EXPORT int SUNLinSolFree_Ensemble(SUNLinearSolver S);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
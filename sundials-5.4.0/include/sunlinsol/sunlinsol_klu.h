@@ -40,8 +40,12 @@ extern "C" {
 
 /* Default KLU solver parameters */
 #define SUNKLU_ORDERING_DEFAULT  1    /* COLAMD */
+#define SUNKLU_ORDERING_METIS    4    /* METIS nested dissection */
 #define SUNKLU_REINIT_FULL       1
 #define SUNKLU_REINIT_PARTIAL    2
+#define SUNKLU_SYMBOLIC_CACHE_DEFAULT 0  /* no symbolic cache */
+#define SUNKLU_GROWTH_TOL_DEFAULT RCONST(0.0)  /* no pivot growth check */
+#define SUNKLU_RESID_TOL_DEFAULT  RCONST(0.0)  /* no residual check */
 
 /* Interfaces to match 'sunindextype' with the correct KLU types/functions */
 #if defined(SUNDIALS_INT64_T)
@@ -53,6 +57,7 @@ extern "C" {
 #define sun_klu_refactor      klu_l_refactor
 #define sun_klu_rcond         klu_l_rcond
 #define sun_klu_condest       klu_l_condest
+#define sun_klu_rgrowth       klu_l_rgrowth
 #define sun_klu_defaults      klu_l_defaults
 #define sun_klu_free_symbolic klu_l_free_symbolic
 #define sun_klu_free_numeric  klu_l_free_numeric
@@ -65,6 +70,7 @@ extern "C" {
 #define sun_klu_refactor      klu_refactor
 #define sun_klu_rcond         klu_rcond
 #define sun_klu_condest       klu_condest
+#define sun_klu_rgrowth       klu_rgrowth
 #define sun_klu_defaults      klu_defaults
 #define sun_klu_free_symbolic klu_free_symbolic
 #define sun_klu_free_numeric  klu_free_numeric
@@ -92,9 +98,22 @@ struct _SUNLinearSolverContent_KLU {
   int              last_flag;
   int              first_factorize;
   sun_klu_symbolic *symbolic;
+  int              symbolic_cached;  /* symbolic is owned by the cache */
   sun_klu_numeric  *numeric;
   sun_klu_common   common;
   KLUSolveFn       klu_solver;
+  realtype         growth_tol;    /* re-pivot if the pivot growth of a
+                                     refactorization drops below
+                                     growth_tol * rgrowth_ref            */
+  realtype         resid_tol;     /* re-pivot if a solve leaves a relative
+                                     residual above resid_tol            */
+  realtype         rgrowth_ref;   /* pivot growth of last pivoting factor */
+  int              repivot_next;  /* re-pivot on the next setup          */
+  N_Vector         resid;         /* residual workspace                  */
+  long int         nrefactor;     /* accepted refactorizations           */
+  long int         nrepivot;      /* factorizations with new pivoting    */
+  long int         nreanalyze;    /* symbolic analyses and factorizations */
+  long int         nrejected;     /* refactorizations failed or rejected */
 };
 
 typedef struct _SUNLinearSolverContent_KLU *SUNLinearSolverContent_KLU;
@@ -109,6 +128,28 @@ SUNDIALS_EXPORT int SUNLinSol_KLUReInit(SUNLinearSolver S, SUNMatrix A,
                                         sunindextype nnz, int reinit_type);
 SUNDIALS_EXPORT int SUNLinSol_KLUSetOrdering(SUNLinearSolver S,
                                              int ordering_choice);
+SUNDIALS_EXPORT int SUNLinSol_KLUSetPivotPolicy(SUNLinearSolver S,
+                                                realtype growth_tol,
+                                                realtype resid_tol);
+SUNDIALS_EXPORT int SUNLinSol_KLUGetPivotStats(SUNLinearSolver S,
+                                               long int *nrefactor,
+                                               long int *nrepivot,
+                                               long int *nreanalyze,
+                                               long int *nrejected);
+
+/* The symbolic cache is shared by all KLU linear solvers of the process.
+ * When enabled, the symbolic analysis computed on a first factorization is
+ * kept, keyed by the sparsity pattern of the matrix and by the ordering and
+ * BTF settings, and reused by any later first factorization (e.g. after
+ * SUNLinSol_KLUReInit) of a matrix with the same pattern.  At most
+ * max_entries analyses are kept; the least recently used one that is not
+ * in use by a solver is evicted.  The cache is guarded by a lock, so
+ * solvers in different threads may share it. */
+SUNDIALS_EXPORT int SUNLinSol_KLUSetSymbolicCache(int max_entries);
+SUNDIALS_EXPORT int SUNLinSol_KLUGetSymbolicCacheStats(long int *hits,
+                                                       long int *misses,
+                                                       long int *evictions);
+SUNDIALS_EXPORT int SUNLinSol_KLUFreeSymbolicCache(void);
 
 /* deprecated */
 SUNDIALS_EXPORT SUNLinearSolver SUNKLU(N_Vector y, SUNMatrix A);
@@ -0,0 +1,116 @@
+/*
+ * -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2020, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the header file for the ensemble implementation of the
+ * SUNMATRIX module, SUNMATRIX_ENSEMBLE.
+ *
+ * A SUNMATRIX_ENSEMBLE matrix is the block diagonal Jacobian of an
+ * ensemble of nmembers independent copies of one model with
+ * blocksize unknowns each, integrated together by one solver. The
+ * dense blocks are stored interleaved, with the member index
+ * varying fastest, so that operations on all members vectorize:
+ *
+ *   entry (i,j) of member k is data[(j*blocksize + i)*nmembers + k]
+ *
+ * The N_Vectors used with the matrix have the same layout, i.e.
+ * unknown i of member k is entry i*nmembers + k.
+ *
+ * Notes:
+ *   - The definition of the generic SUNMatrix structure can be found
+ *     in the header file sundials_matrix.h.
+ *   - The definition of the type 'realtype' can be found in the
+ *     header file sundials_types.h, and it may be changed (at the
+ *     configuration stage) according to the user's needs.
+ *     The sundials_types.h file also contains the definition
+ *     for the type 'booleantype' and 'indextype'.
+ *   - When SUNDIALS is configured with SUNDIALS_ENSEMBLE_OPENMP, the
+ *     matrix operations split the members over the number of OpenMP
+ *     threads set with SUNEnsembleMatrix_SetNumThreads (default 1).
+ * -----------------------------------------------------------------
+ */
+
+#ifndef _SUNMATRIX_ENSEMBLE_H
+#define _SUNMATRIX_ENSEMBLE_H
+
+#include <stdio.h>
+#include <sundials/sundials_matrix.h>
+
+#ifdef __cplusplus  /* wrapper to enable C++ usage */
+extern "C" {
+#endif
+
+/* -------------------------------------
+ * Ensemble implementation of SUNMatrix
+ * ------------------------------------- */
+
+struct _SUNMatrixContent_Ensemble {
+  sunindextype nmembers;   /* number of ensemble members       */
+  sunindextype blocksize;  /* number of unknowns of a member   */
+  realtype *data;          /* interleaved blocks               */
+  sunindextype ldata;      /* blocksize*blocksize*nmembers     */
+  int nthreads;            /* number of threads for operations */
+};
+
+typedef struct _SUNMatrixContent_Ensemble *SUNMatrixContent_Ensemble;
+
+/* ---------------------------------------
+ * Macros for access to SUNMATRIX_ENSEMBLE
+ * --------------------------------------- */
+
+#define SM_CONTENT_E(A)     ( (SUNMatrixContent_Ensemble)(A->content) )
+
+#define SM_MEMBERS_E(A)     ( SM_CONTENT_E(A)->nmembers )
+
+#define SM_BLOCKSIZE_E(A)   ( SM_CONTENT_E(A)->blocksize )
+
+#define SM_LDATA_E(A)       ( SM_CONTENT_E(A)->ldata )
+
+#define SM_DATA_E(A)        ( SM_CONTENT_E(A)->data )
+
+#define SM_NTHREADS_E(A)    ( SM_CONTENT_E(A)->nthreads )
+
+#define SM_ELEMENT_E(A,k,i,j) ( SM_DATA_E(A)[((j)*SM_BLOCKSIZE_E(A)+(i))*SM_MEMBERS_E(A)+(k)] )
+
+#define SM_VINDEX_E(A,k,i)  ( (i)*SM_MEMBERS_E(A)+(k) )
+
+/* ------------------------------------------
+ * Exported Functions for SUNMATRIX_ENSEMBLE
+ * ------------------------------------------ */
+
+SUNDIALS_EXPORT SUNMatrix SUNEnsembleMatrix(sunindextype nmembers,
+                                            sunindextype blocksize);
+
+SUNDIALS_EXPORT void SUNEnsembleMatrix_Print(SUNMatrix A, FILE* outfile);
+
+SUNDIALS_EXPORT sunindextype SUNEnsembleMatrix_Members(SUNMatrix A);
+SUNDIALS_EXPORT sunindextype SUNEnsembleMatrix_BlockSize(SUNMatrix A);
+SUNDIALS_EXPORT sunindextype SUNEnsembleMatrix_Rows(SUNMatrix A);
+SUNDIALS_EXPORT sunindextype SUNEnsembleMatrix_LData(SUNMatrix A);
+SUNDIALS_EXPORT realtype* SUNEnsembleMatrix_Data(SUNMatrix A);
+SUNDIALS_EXPORT int SUNEnsembleMatrix_SetNumThreads(SUNMatrix A, int nthreads);
+
+SUNDIALS_EXPORT SUNMatrix_ID SUNMatGetID_Ensemble(SUNMatrix A);
+SUNDIALS_EXPORT SUNMatrix SUNMatClone_Ensemble(SUNMatrix A);
+SUNDIALS_EXPORT void SUNMatDestroy_Ensemble(SUNMatrix A);
+SUNDIALS_EXPORT int SUNMatZero_Ensemble(SUNMatrix A);
+SUNDIALS_EXPORT int SUNMatCopy_Ensemble(SUNMatrix A, SUNMatrix B);
+SUNDIALS_EXPORT int SUNMatScaleAdd_Ensemble(realtype c, SUNMatrix A, SUNMatrix B);
+SUNDIALS_EXPORT int SUNMatScaleAddI_Ensemble(realtype c, SUNMatrix A);
+SUNDIALS_EXPORT int SUNMatMatvec_Ensemble(SUNMatrix A, N_Vector x, N_Vector y);
+SUNDIALS_EXPORT int SUNMatSpace_Ensemble(SUNMatrix A, long int *lenrw,
+                                         long int *leniw);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -26,6 +26,13 @@
  *     configuration stage) according to the user's needs. 
  *     The sundials_types.h file also contains the definition
  *     for the type 'booleantype' and 'indextype'.
+ *   - SUNMatScaleAdd and SUNMatScaleAddI cache the merged sparsity
+ *     pattern of their operands in the output matrix. As long as
+ *     the patterns of the operands do not change, later calls only
+ *     scatter values into the cached pattern and do not reallocate.
+ *   - When SUNDIALS is configured with SUNMATRIX_SPARSE_OPENMP, the
+ *     copy, scale-add and matvec operations use the number of OpenMP
+ *     threads set with SUNSparseMatrix_SetNumThreads (default 1).
  * -----------------------------------------------------------------
  */
 
@@ -52,7 +59,9 @@ extern "C" {
 /* ------------------------------------------
  * Sparse Implementation of SUNMATRIX_SPARSE
  * ------------------------------------------ */
-  
+
+struct _SUNMatrixWork_Sparse;
+
 struct _SUNMatrixContent_Sparse {
   sunindextype M;
   sunindextype N;
@@ -68,6 +77,10 @@ struct _SUNMatrixContent_Sparse {
   /* CSR indices */
   sunindextype **colvals;
   sunindextype **rowptrs;
+  /* number of threads used by the matrix operations */
+  int nthreads;
+  /* cached merged pattern and work arrays (private) */
+  struct _SUNMatrixWork_Sparse *work;
 };
 
 typedef struct _SUNMatrixContent_Sparse *SUNMatrixContent_Sparse;
@@ -95,6 +108,8 @@ typedef struct _SUNMatrixContent_Sparse *SUNMatrixContent_Sparse;
 
 #define SM_INDEXPTRS_S(A)   ( SM_CONTENT_S(A)->indexptrs )
 
+#define SM_NTHREADS_S(A)    ( SM_CONTENT_S(A)->nthreads )
+
 /* ----------------------------------------
  * Exported Functions for SUNMATRIX_SPARSE
  * ---------------------------------------- */
@@ -117,6 +132,13 @@ SUNDIALS_EXPORT int SUNSparseMatrix_Realloc(SUNMatrix A);
 
 SUNDIALS_EXPORT int SUNSparseMatrix_Reallocate(SUNMatrix A, sunindextype NNZ);
 
+SUNDIALS_EXPORT int SUNSparseMatrix_SetNumThreads(SUNMatrix A, int nthreads);
+
+SUNDIALS_EXPORT int SUNSparseMatrix_ColumnColoring(SUNMatrix A,
+                                                   sunindextype *ncolors,
+                                                   sunindextype *colorptrs,
+                                                   sunindextype *colorcols);
+
 SUNDIALS_EXPORT void SUNSparseMatrix_Print(SUNMatrix A, FILE* outfile);
 
 SUNDIALS_EXPORT sunindextype SUNSparseMatrix_Rows(SUNMatrix A);
@@ -25,6 +25,7 @@
 #include "sundials/sundials_types.h"
 #include "sundials/sundials_nvector.h"
 #include "sundials/sundials_nonlinearsolver.h"
+#include "sundials/sundials_iterative.h"
 
 #ifdef __cplusplus  /* wrapper to enable C++ usage */
 extern "C" {
@@ -45,8 +46,12 @@ struct _SUNNonlinearSolverContent_FixedPoint {
   int         *imap;       /* array of length m                              */
   booleantype  damping;    /* flag to apply dampling in acceleration         */
   realtype     beta;       /* damping paramter                               */
+  int          gstype;     /* QR update: MODIFIED_GS or CLASSICAL_GS         */
+  int          restart;    /* iterations between restarts (0 = none)         */
+  int          aa_start;   /* iteration at which the current history began   */
   realtype    *R;          /* array of length m*m                            */
   realtype    *gamma;      /* array of length m                              */
+  realtype    *qtf;        /* array of length m, Q^T fold for CLASSICAL_GS   */
   realtype    *cvals;      /* array of length m+1 for fused vector op        */
   N_Vector    *df;         /* vector array of length m                       */
   N_Vector    *dg;         /* vector array of length m                       */
@@ -105,6 +110,12 @@ SUNDIALS_EXPORT int SUNNonlinSolSetMaxIters_FixedPoint(SUNNonlinearSolver NLS,
 SUNDIALS_EXPORT int SUNNonlinSolSetDamping_FixedPoint(SUNNonlinearSolver NLS,
                                                       realtype beta);
 
+SUNDIALS_EXPORT int SUNNonlinSolSetGSType_FixedPoint(SUNNonlinearSolver NLS,
+                                                     int gstype);
+
+SUNDIALS_EXPORT int SUNNonlinSolSetRestart_FixedPoint(SUNNonlinearSolver NLS,
+                                                      int restart);
+
 /* get functions */
 SUNDIALS_EXPORT int SUNNonlinSolGetNumIters_FixedPoint(SUNNonlinearSolver NLS,
                                                        long int *niters);
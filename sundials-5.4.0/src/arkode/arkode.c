@@ -807,6 +807,7 @@ int arkEvolve(ARKodeMem ark_mem, realtype tout, N_Vector yout,
     }
 
     /* Looping point for step attempts */
+    SUNDIALS_PROFILE_BEGIN(ark_mem->profile, SUN_PROFILE_STEP);
     dsm = ZERO;
     ncf = nef = constrfails = ark_mem->last_kflag = 0;
     nflag = FIRST_CALL;
@@ -841,7 +842,9 @@ int arkEvolve(ARKodeMem ark_mem, realtype tout, N_Vector yout,
 
       /* check temporal error (if checks above passed) */
       if (kflag == ARK_SUCCESS) {
+        SUNDIALS_PROFILE_BEGIN(ark_mem->profile, SUN_PROFILE_ERRTEST);
         kflag = arkCheckTemporalError(ark_mem, &nflag, &nef, dsm);
+        SUNDIALS_PROFILE_END(ark_mem->profile, SUN_PROFILE_ERRTEST);
         if (kflag < 0)  break;
       }
 
@@ -875,6 +878,7 @@ int arkEvolve(ARKodeMem ark_mem, realtype tout, N_Vector yout,
        error stepsize history arrays; call user-supplied step postprocessing function)
        (added stuff from arkStep_PrepareNextStep -- revisit) */
     if (kflag == ARK_SUCCESS)  kflag = arkCompleteStep(ark_mem, dsm);
+    SUNDIALS_PROFILE_END(ark_mem->profile, SUN_PROFILE_STEP);
 
     /* If step attempt loop failed, process flag and return to user */
     if (kflag != ARK_SUCCESS) {
@@ -890,7 +894,9 @@ int arkEvolve(ARKodeMem ark_mem, realtype tout, N_Vector yout,
     if (ark_mem->root_mem != NULL) {
       if (ark_mem->root_mem->nrtfn > 0) {
 
+        SUNDIALS_PROFILE_BEGIN(ark_mem->profile, SUN_PROFILE_ROOTFIND);
         retval = arkRootCheck3((void*) ark_mem);
+        SUNDIALS_PROFILE_END(ark_mem->profile, SUN_PROFILE_ROOTFIND);
         if (retval == RTFOUND) {  /* A new root was found */
           ark_mem->root_mem->irfnd = 1;
           istate = ARK_ROOT_RETURN;
@@ -1025,8 +1031,10 @@ int arkGetDky(ARKodeMem ark_mem, realtype t, int k, N_Vector dky)
 
   /* call arkInterpEvaluate to evaluate result */
   s = (t - ark_mem->tcur) / ark_mem->h;
+  SUNDIALS_PROFILE_BEGIN(ark_mem->profile, SUN_PROFILE_INTERP);
   retval = arkInterpEvaluate(ark_mem, ark_mem->interp, s,
                              k, ARK_INTERP_MAX_DEGREE, dky);
+  SUNDIALS_PROFILE_END(ark_mem->profile, SUN_PROFILE_INTERP);
   if (retval != ARK_SUCCESS) {
     arkProcessError(ark_mem, retval, "ARKode", "arkGetDky",
                     "Error calling arkInterpEvaluate");
@@ -1274,6 +1282,8 @@ int arkInit(ARKodeMem ark_mem, realtype t0, N_Vector y0,
     ark_mem->netf         = 0;
     ark_mem->nconstrfails = 0;
 
+    SUNProfile_Reset(&(ark_mem->profile));
+
     /* Initial, old, and next step sizes */
     ark_mem->h0u    = ZERO;
     ark_mem->hold   = ZERO;
@@ -1873,7 +1883,9 @@ int arkInitialSetup(ARKodeMem ark_mem, realtype tout)
   /* Check for zeros of root function g at and near t0. */
   if (ark_mem->root_mem != NULL) {
     if (ark_mem->root_mem->nrtfn > 0) {
+      SUNDIALS_PROFILE_BEGIN(ark_mem->profile, SUN_PROFILE_ROOTFIND);
       retval = arkRootCheck1((void*) ark_mem);
+      SUNDIALS_PROFILE_END(ark_mem->profile, SUN_PROFILE_ROOTFIND);
 
       if (retval == ARK_RTFUNC_FAIL) {
         arkProcessError(ark_mem, ARK_RTFUNC_FAIL, "ARKode", "arkRootCheck1",
@@ -1933,7 +1945,9 @@ int arkStopTests(ARKodeMem ark_mem, realtype tout, N_Vector yout,
         }
       }
 
+      SUNDIALS_PROFILE_BEGIN(ark_mem->profile, SUN_PROFILE_ROOTFIND);
       retval = arkRootCheck2((void*) ark_mem);
+      SUNDIALS_PROFILE_END(ark_mem->profile, SUN_PROFILE_ROOTFIND);
 
       if (retval == CLOSERT) {
         arkProcessError(ark_mem, ARK_ILL_INPUT, "ARKode", "arkStopTests",
@@ -1955,7 +1969,9 @@ int arkStopTests(ARKodeMem ark_mem, realtype tout, N_Vector yout,
          check remaining interval for roots */
       if ( SUNRabs(ark_mem->tcur - ark_mem->tretlast) > troundoff ) {
 
+        SUNDIALS_PROFILE_BEGIN(ark_mem->profile, SUN_PROFILE_ROOTFIND);
         retval = arkRootCheck3((void*) ark_mem);
+        SUNDIALS_PROFILE_END(ark_mem->profile, SUN_PROFILE_ROOTFIND);
 
         if (retval == ARK_SUCCESS) {     /* no root found */
           ark_mem->root_mem->irfnd = 0;
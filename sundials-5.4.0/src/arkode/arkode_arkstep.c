@@ -1324,7 +1324,9 @@ int arkStep_FullRHS(void* arkode_mem, realtype t,
 
     /* call fe if the problem has an explicit component */
     if (step_mem->explicit) {
+      SUNDIALS_PROFILE_BEGIN(ark_mem->profile, SUN_PROFILE_RHS);
       retval = step_mem->fe(t, y, step_mem->Fe[0], ark_mem->user_data);
+      SUNDIALS_PROFILE_END(ark_mem->profile, SUN_PROFILE_RHS);
       step_mem->nfe++;
       if (retval != 0) {
         arkProcessError(ark_mem, ARK_RHSFUNC_FAIL, "ARKode::ARKStep",
@@ -1343,7 +1345,9 @@ int arkStep_FullRHS(void* arkode_mem, realtype t,
 
     /* call fi if the problem has an implicit component */
     if (step_mem->implicit) {
+      SUNDIALS_PROFILE_BEGIN(ark_mem->profile, SUN_PROFILE_RHS);
       retval = step_mem->fi(t, y, step_mem->Fi[0], ark_mem->user_data);
+      SUNDIALS_PROFILE_END(ark_mem->profile, SUN_PROFILE_RHS);
       step_mem->nfi++;
       if (retval != 0) {
         arkProcessError(ark_mem, ARK_RHSFUNC_FAIL, "ARKode::ARKStep",
@@ -1390,7 +1394,9 @@ int arkStep_FullRHS(void* arkode_mem, realtype t,
 
       /* call fe if the problem has an explicit component */
       if (step_mem->explicit) {
+        SUNDIALS_PROFILE_BEGIN(ark_mem->profile, SUN_PROFILE_RHS);
         retval = step_mem->fe(t, y, step_mem->Fe[0], ark_mem->user_data);
+        SUNDIALS_PROFILE_END(ark_mem->profile, SUN_PROFILE_RHS);
         step_mem->nfe++;
         if (retval != 0) {
           arkProcessError(ark_mem, ARK_RHSFUNC_FAIL, "ARKode::ARKStep",
@@ -1409,7 +1415,9 @@ int arkStep_FullRHS(void* arkode_mem, realtype t,
 
       /* call fi if the problem has an implicit component */
       if (step_mem->implicit) {
+        SUNDIALS_PROFILE_BEGIN(ark_mem->profile, SUN_PROFILE_RHS);
         retval = step_mem->fi(t, y, step_mem->Fi[0], ark_mem->user_data);
+        SUNDIALS_PROFILE_END(ark_mem->profile, SUN_PROFILE_RHS);
         step_mem->nfi++;
         if (retval != 0) {
           arkProcessError(ark_mem, ARK_RHSFUNC_FAIL, "ARKode::ARKStep",
@@ -1450,7 +1458,9 @@ int arkStep_FullRHS(void* arkode_mem, realtype t,
 
     /* call fe if the problem has an explicit component (store in ark_tempv2) */
     if (step_mem->explicit) {
+      SUNDIALS_PROFILE_BEGIN(ark_mem->profile, SUN_PROFILE_RHS);
       retval = step_mem->fe(t, y, ark_mem->tempv2, ark_mem->user_data);
+      SUNDIALS_PROFILE_END(ark_mem->profile, SUN_PROFILE_RHS);
       step_mem->nfe++;
       if (retval != 0) {
         arkProcessError(ark_mem, ARK_RHSFUNC_FAIL, "ARKode::ARKStep",
@@ -1469,7 +1479,9 @@ int arkStep_FullRHS(void* arkode_mem, realtype t,
 
     /* call fi if the problem has an implicit component (store in sdata) */
     if (step_mem->implicit) {
+      SUNDIALS_PROFILE_BEGIN(ark_mem->profile, SUN_PROFILE_RHS);
       retval = step_mem->fi(t, y, step_mem->sdata, ark_mem->user_data);
+      SUNDIALS_PROFILE_END(ark_mem->profile, SUN_PROFILE_RHS);
       step_mem->nfi++;
       if (retval != 0) {
         arkProcessError(ark_mem, ARK_RHSFUNC_FAIL, "ARKode::ARKStep",
@@ -1646,7 +1658,9 @@ int arkStep_TakeStep_Z(void* arkode_mem, realtype *dsmPtr, int *nflagPtr)
 
       /* implicit solve result is stored in ark_mem->ycur;
          return with positive value on anything but success */
+      SUNDIALS_PROFILE_BEGIN(ark_mem->profile, SUN_PROFILE_NLSOLVE);
       *nflagPtr = arkStep_Nls(ark_mem, *nflagPtr);
+      SUNDIALS_PROFILE_END(ark_mem->profile, SUN_PROFILE_NLSOLVE);
       if (*nflagPtr != ARK_SUCCESS)  return(TRY_AGAIN);
 
 #ifdef SUNDIALS_DEBUG_PRINTVEC
@@ -1691,8 +1705,10 @@ int arkStep_TakeStep_Z(void* arkode_mem, realtype *dsmPtr, int *nflagPtr)
     /* successful stage solve */
     /*    store implicit RHS (value in Fi[is] is from preceding nonlinear iteration) */
     if (step_mem->implicit) {
+      SUNDIALS_PROFILE_BEGIN(ark_mem->profile, SUN_PROFILE_RHS);
       retval = step_mem->fi(ark_mem->tcur, ark_mem->ycur,
                             step_mem->Fi[is], ark_mem->user_data);
+      SUNDIALS_PROFILE_END(ark_mem->profile, SUN_PROFILE_RHS);
       step_mem->nfi++;
       if (retval < 0)  return(ARK_RHSFUNC_FAIL);
       if (retval > 0)  return(ARK_UNREC_RHSFUNC_ERR);
@@ -1708,8 +1724,10 @@ int arkStep_TakeStep_Z(void* arkode_mem, realtype *dsmPtr, int *nflagPtr)
 
     /*    store explicit RHS */
     if (step_mem->explicit) {
+        SUNDIALS_PROFILE_BEGIN(ark_mem->profile, SUN_PROFILE_RHS);
         retval = step_mem->fe(ark_mem->tn + step_mem->Be->c[is]*ark_mem->h,
                               ark_mem->ycur, step_mem->Fe[is], ark_mem->user_data);
+        SUNDIALS_PROFILE_END(ark_mem->profile, SUN_PROFILE_RHS);
         step_mem->nfe++;
         if (retval < 0)  return(ARK_RHSFUNC_FAIL);
         if (retval > 0)  return(ARK_UNREC_RHSFUNC_ERR);
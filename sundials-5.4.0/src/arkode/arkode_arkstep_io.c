@@ -154,6 +154,8 @@ int ARKStepSetMassTimes(void *arkode_mem, ARKLsMassTimesSetupFn msetup,
   return(arkLSSetMassTimes(arkode_mem, msetup, mtimes, mtimes_data)); }
 int ARKStepSetLinSysFn(void *arkode_mem, ARKLsLinSysFn linsys) {
   return(arkLSSetLinSysFn(arkode_mem, linsys)); }
+int ARKStepSetSparseDQJac(void *arkode_mem, SUNMatrix S, int nthreads) {
+  return(arkLSSetSparseDQJac(arkode_mem, S, nthreads)); }
 
 /* deprecated */
 int ARKStepSetMaxStepsBetweenJac(void *arkode_mem, long int msbj) {
@@ -1565,6 +1567,34 @@ int ARKStepGetNonlinSolvStats(void *arkode_mem, long int *nniters,
 }
 
 
+/*---------------------------------------------------------------
+  ARKStepGetProfile:
+
+  Returns the times and number of calls of the integrator phases,
+  if SUNDIALS was built with SUNDIALS_BUILD_WITH_PROFILING
+  ---------------------------------------------------------------*/
+int ARKStepGetProfile(void *arkode_mem, SUNProfile *prof)
+{
+  ARKodeMem ark_mem;
+  ARKodeARKStepMem step_mem;
+  int retval;
+
+  /* access ARKodeARKStepMem structure */
+  retval = arkStep_AccessStepMem(arkode_mem, "ARKStepGetProfile",
+                                 &ark_mem, &step_mem);
+  if (retval != ARK_SUCCESS)  return(retval);
+
+#ifdef SUNDIALS_BUILD_WITH_PROFILING
+  *prof = ark_mem->profile;
+  return(ARK_SUCCESS);
+#else
+  arkProcessError(ark_mem, ARK_ILL_INPUT, "ARKode::ARKStep",
+                  "ARKStepGetProfile", MSG_ARK_NO_PROFILING);
+  return(ARK_ILL_INPUT);
+#endif
+}
+
+
 /*===============================================================
   ARKStep parameter output
   ===============================================================*/
@@ -352,10 +352,12 @@ int arkStep_NlsLSetup(booleantype jbad, booleantype* jcur, void* arkode_mem)
   /* Use ARKode's tempv1, tempv2 and tempv3 as
      temporary vectors for the linear solver setup routine */
   step_mem->nsetups++;
+  SUNDIALS_PROFILE_BEGIN(ark_mem->profile, SUN_PROFILE_LSETUP);
   retval = step_mem->lsetup(ark_mem, step_mem->convfail, ark_mem->tcur,
                             ark_mem->ycur, step_mem->Fi[step_mem->istage],
                             &(step_mem->jcur), ark_mem->tempv1,
                             ark_mem->tempv2, ark_mem->tempv3);
+  SUNDIALS_PROFILE_END(ark_mem->profile, SUN_PROFILE_LSETUP);
 
   /* update Jacobian status */
   *jcur = step_mem->jcur;
@@ -396,9 +398,11 @@ int arkStep_NlsLSolve(N_Vector b, void* arkode_mem)
     return(ARK_NLS_OP_ERR);
 
   /* call linear solver interface, and handle return value */
+  SUNDIALS_PROFILE_BEGIN(ark_mem->profile, SUN_PROFILE_LSOLVE);
   retval = step_mem->lsolve(ark_mem, b, ark_mem->tcur,
                             ark_mem->ycur, step_mem->Fi[step_mem->istage],
                             step_mem->eRNrm, nonlin_iter);
+  SUNDIALS_PROFILE_END(ark_mem->profile, SUN_PROFILE_LSOLVE);
 
   if (retval < 0) return(ARK_LSOLVE_FAIL);
   if (retval > 0) return(CONV_FAIL);
@@ -452,9 +456,11 @@ int arkStep_NlsResidual_MassIdent(N_Vector zcor, N_Vector r, void* arkode_mem)
   N_VLinearSum(ONE, step_mem->zpred, ONE, zcor, ark_mem->ycur);
 
   /* compute implicit RHS */
+  SUNDIALS_PROFILE_BEGIN(ark_mem->profile, SUN_PROFILE_RHS);
   retval = step_mem->fi(ark_mem->tcur, ark_mem->ycur,
                         step_mem->Fi[step_mem->istage],
                         ark_mem->user_data);
+  SUNDIALS_PROFILE_END(ark_mem->profile, SUN_PROFILE_RHS);
   step_mem->nfi++;
   if (retval < 0) return(ARK_RHSFUNC_FAIL);
   if (retval > 0) return(RHSFUNC_RECVR);
@@ -517,9 +523,11 @@ int arkStep_NlsResidual_MassFixed(N_Vector zcor, N_Vector r, void* arkode_mem)
   N_VLinearSum(ONE, step_mem->zpred, ONE, zcor, ark_mem->ycur);
 
   /* compute implicit RHS */
+  SUNDIALS_PROFILE_BEGIN(ark_mem->profile, SUN_PROFILE_RHS);
   retval = step_mem->fi(ark_mem->tcur, ark_mem->ycur,
                         step_mem->Fi[step_mem->istage],
                         ark_mem->user_data);
+  SUNDIALS_PROFILE_END(ark_mem->profile, SUN_PROFILE_RHS);
   step_mem->nfi++;
   if (retval < 0) return(ARK_RHSFUNC_FAIL);
   if (retval > 0) return(RHSFUNC_RECVR);
@@ -593,9 +601,11 @@ int arkStep_NlsResidual_MassTDep(N_Vector zcor, N_Vector r, void* arkode_mem)
   if (retval != ARK_SUCCESS)  return (ARK_MASSMULT_FAIL);
 
   /* compute implicit RHS */
+  SUNDIALS_PROFILE_BEGIN(ark_mem->profile, SUN_PROFILE_RHS);
   retval = step_mem->fi(ark_mem->tcur, ark_mem->ycur,
                         step_mem->Fi[step_mem->istage],
                         ark_mem->user_data);
+  SUNDIALS_PROFILE_END(ark_mem->profile, SUN_PROFILE_RHS);
   step_mem->nfi++;
   if (retval < 0) return(ARK_RHSFUNC_FAIL);
   if (retval > 0) return(RHSFUNC_RECVR);
@@ -656,9 +666,11 @@ int arkStep_NlsFPFunction_MassIdent(N_Vector zcor, N_Vector g, void* arkode_mem)
   N_VLinearSum(ONE, step_mem->zpred, ONE, zcor, ark_mem->ycur);
 
   /* compute implicit RHS and save for later */
+  SUNDIALS_PROFILE_BEGIN(ark_mem->profile, SUN_PROFILE_RHS);
   retval = step_mem->fi(ark_mem->tcur, ark_mem->ycur,
                         step_mem->Fi[step_mem->istage],
                         ark_mem->user_data);
+  SUNDIALS_PROFILE_END(ark_mem->profile, SUN_PROFILE_RHS);
   step_mem->nfi++;
   if (retval < 0) return(ARK_RHSFUNC_FAIL);
   if (retval > 0) return(RHSFUNC_RECVR);
@@ -722,9 +734,11 @@ int arkStep_NlsFPFunction_MassFixed(N_Vector zcor, N_Vector g, void* arkode_mem)
   N_VLinearSum(ONE, step_mem->zpred, ONE, zcor, ark_mem->ycur);
 
   /* compute implicit RHS and save for later */
+  SUNDIALS_PROFILE_BEGIN(ark_mem->profile, SUN_PROFILE_RHS);
   retval = step_mem->fi(ark_mem->tcur, ark_mem->ycur,
                         step_mem->Fi[step_mem->istage],
                         ark_mem->user_data);
+  SUNDIALS_PROFILE_END(ark_mem->profile, SUN_PROFILE_RHS);
   step_mem->nfi++;
   if (retval < 0) return(ARK_RHSFUNC_FAIL);
   if (retval > 0) return(RHSFUNC_RECVR);
@@ -794,9 +808,11 @@ int arkStep_NlsFPFunction_MassTDep(N_Vector zcor, N_Vector g, void* arkode_mem)
   N_VLinearSum(ONE, step_mem->zpred, ONE, zcor, ark_mem->ycur);
 
   /* compute implicit RHS and save for later */
+  SUNDIALS_PROFILE_BEGIN(ark_mem->profile, SUN_PROFILE_RHS);
   retval = step_mem->fi(ark_mem->tcur, ark_mem->ycur,
                         step_mem->Fi[step_mem->istage],
                         ark_mem->user_data);
+  SUNDIALS_PROFILE_END(ark_mem->profile, SUN_PROFILE_RHS);
   step_mem->nfi++;
   if (retval < 0) return(ARK_RHSFUNC_FAIL);
   if (retval > 0) return(RHSFUNC_RECVR);
@@ -526,7 +526,9 @@ static int ARKBandPDQJac(ARKBandPrecData pdata,
     }
 
     /* Evaluate f with incremented y. */
+    SUNDIALS_PROFILE_BEGIN(ark_mem->profile, SUN_PROFILE_RHS);
     retval = fi(t, ytemp, ftemp, ark_mem->user_data);
+    SUNDIALS_PROFILE_END(ark_mem->profile, SUN_PROFILE_RHS);
     pdata->nfeBP++;
     if (retval != 0) return(retval);
 
@@ -22,6 +22,7 @@
 #include <arkode/arkode_butcher.h>
 #include "arkode_adapt_impl.h"
 #include "arkode_root_impl.h"
+#include "sundials_profile_impl.h"
 #include <sundials/sundials_linearsolver.h>
 
 #ifdef __cplusplus  /* wrapper to enable C++ usage */
@@ -351,6 +352,9 @@ typedef struct ARKodeMemRec {
   long int netf;          /* num error test failures                    */
   long int nconstrfails;  /* number of constraint failures              */
 
+  /* Profiling */
+  SUNProfile profile;     /* phase timers, if built with profiling      */
+
   /* Diagnostic output */
   booleantype report;   /* flag to enable/disable diagnostic output    */
   FILE       *diagfp;   /* diagnostic outputs are sent to diagfp   */
@@ -1048,6 +1052,7 @@ int arkGetLastKFlag(void *arkode_mem, int *last_kflag);
 #define MSG_ARK_NULL_DKY       "dky = NULL illegal."
 #define MSG_ARK_BAD_T          "Illegal value for t." MSG_TIME_INT
 #define MSG_ARK_NO_ROOT        "Rootfinding was not initialized."
+#define MSG_ARK_NO_PROFILING   "SUNDIALS was not built with profiling."
 
 /* ARKode Error Messages */
 #define MSG_ARK_YOUT_NULL      "yout = NULL illegal."
@@ -42,6 +42,14 @@ static int arkLsLinSys(realtype t, N_Vector y, N_Vector fy, SUNMatrix A,
                        SUNMatrix M, booleantype jok, booleantype *jcur,
                        realtype gamma, void *user_data, N_Vector tmp1,
                        N_Vector tmp2, N_Vector tmp3);
+static int arkLsSparseDQJacInit(ARKLsMem arkls_mem);
+static void arkLsSparseDQJacFree(ARKLsMem arkls_mem);
+static int arkLsSparseDQJacColor(realtype t, N_Vector y, N_Vector fy,
+                                 N_Vector ytemp, N_Vector ftemp,
+                                 realtype *Jx, realtype srur,
+                                 realtype minInc, sunindextype g,
+                                 ARKodeMem ark_mem, ARKLsMem arkls_mem,
+                                 ARKRhsFn fi);
 
 /*===============================================================
   ARKLS utility routines (called by time-stepper modules)
@@ -822,6 +830,76 @@ int arkLSSetLinSysFn(void *arkode_mem, ARKLsLinSysFn linsys)
 }
 
 
+/* arkLSSetSparseDQJac enables the colored difference quotient
+   Jacobian for a sparse SUNMatrix. S holds the sparsity pattern of
+   the Jacobian of fi (its values are not used); the columns are
+   grouped into colors of structurally orthogonal columns, so that
+   fi is evaluated once per color rather than once per column. If
+   nthreads is larger than one and ARKode is built with OpenMP, the
+   colors are evaluated concurrently, in which case fi must be
+   thread-safe. A NULL S disables the colored approximation. */
+int arkLSSetSparseDQJac(void *arkode_mem, SUNMatrix S, int nthreads)
+{
+  ARKodeMem ark_mem;
+  ARKLsMem  arkls_mem;
+  int       retval;
+
+  /* access ARKLsMem structure */
+  retval = arkLs_AccessLMem(arkode_mem, "arkLSSetSparseDQJac",
+                            &ark_mem, &arkls_mem);
+  if (retval != ARKLS_SUCCESS) return(retval);
+
+  /* return with failure if the linear system matrix is not sparse */
+  if ((arkls_mem->A == NULL) || (arkls_mem->A->ops->getid == NULL) ||
+      (SUNMatGetID(arkls_mem->A) != SUNMATRIX_SPARSE)) {
+    arkProcessError(ark_mem, ARKLS_ILL_INPUT, "ARKLS", "arkLSSetSparseDQJac",
+                    "The linear system matrix is not a sparse SUNMatrix");
+    return(ARKLS_ILL_INPUT);
+  }
+
+  /* check the sparsity pattern and the number of threads */
+  if ((S != NULL) &&
+      ((S->ops->getid == NULL) || (SUNMatGetID(S) != SUNMATRIX_SPARSE) ||
+       (SUNSparseMatrix_Rows(S) != SUNSparseMatrix_Rows(arkls_mem->A)) ||
+       (SUNSparseMatrix_Columns(S) != SUNSparseMatrix_Columns(arkls_mem->A)))) {
+    arkProcessError(ark_mem, ARKLS_ILL_INPUT, "ARKLS", "arkLSSetSparseDQJac",
+                    "The sparsity pattern does not match the linear system matrix");
+    return(ARKLS_ILL_INPUT);
+  }
+  if (nthreads < 1) {
+    arkProcessError(ark_mem, ARKLS_ILL_INPUT, "ARKLS", "arkLSSetSparseDQJac",
+                    "nthreads < 1 illegal.");
+    return(ARKLS_ILL_INPUT);
+  }
+
+  /* free any previously set pattern */
+  arkLsSparseDQJacFree(arkls_mem);
+  if (S == NULL)  return(ARKLS_SUCCESS);
+
+  /* store a copy of the pattern in the storage format of A */
+  if (SUNSparseMatrix_SparseType(S) == SUNSparseMatrix_SparseType(arkls_mem->A)) {
+    arkls_mem->Jpat = SUNMatClone(S);
+    retval = (arkls_mem->Jpat == NULL) ? -1 : SUNMatCopy(S, arkls_mem->Jpat);
+  } else if (SUNSparseMatrix_SparseType(arkls_mem->A) == CSR_MAT) {
+    retval = SUNSparseMatrix_ToCSR(S, &arkls_mem->Jpat);
+  } else {
+    retval = SUNSparseMatrix_ToCSC(S, &arkls_mem->Jpat);
+  }
+
+  /* build the column view and color the columns */
+  if (retval == 0)  retval = arkLsSparseDQJacInit(arkls_mem);
+  if (retval != 0) {
+    arkLsSparseDQJacFree(arkls_mem);
+    arkProcessError(ark_mem, ARKLS_MEM_FAIL, "ARKLS", "arkLSSetSparseDQJac",
+                    MSG_LS_MEM_FAIL);
+    return(ARKLS_MEM_FAIL);
+  }
+  arkls_mem->dqthreads = nthreads;
+
+  return(ARKLS_SUCCESS);
+}
+
+
 /* arkLSSetUserData sets user_data pointers in arkLS */
 int arkLSSetUserData(void *arkode_mem, void* user_data)
 {
@@ -1842,7 +1920,7 @@ int arkLsMPSolve(void *arkode_mem, N_Vector r, N_Vector z,
 /*---------------------------------------------------------------
   arkLsDQJac:
 
-  This routine is a wrapper for the Dense and Band
+  This routine is a wrapper for the Dense, Band and Sparse
   implementations of the difference quotient Jacobian
   approximation routines.
   ---------------------------------------------------------------*/
@@ -1896,6 +1974,10 @@ int arkLsDQJac(realtype t, N_Vector y, N_Vector fy,
   } else if (SUNMatGetID(Jac) == SUNMATRIX_BAND) {
     retval = arkLsBandDQJac(t, y, fy, Jac, ark_mem, arkls_mem,
                             fi, tmp1, tmp2);
+  } else if ((SUNMatGetID(Jac) == SUNMATRIX_SPARSE) &&
+             (arkls_mem->Jpat != NULL)) {
+    retval = arkLsSparseDQJac(t, y, fy, Jac, ark_mem, arkls_mem,
+                              fi, tmp1, tmp2);
   } else {
     arkProcessError(ark_mem, ARKLS_ILL_INPUT, "ARKLS", "arkLsDQJac",
                     "arkLsDQJac not implemented for this SUNMatrix type!");
@@ -1966,7 +2048,9 @@ int arkLsDenseDQJac(realtype t, N_Vector y, N_Vector fy,
 
     y_data[j] += inc;
 
+    SUNDIALS_PROFILE_BEGIN(ark_mem->profile, SUN_PROFILE_RHS);
     retval = fi(t, y, ftemp, ark_mem->user_data);
+    SUNDIALS_PROFILE_END(ark_mem->profile, SUN_PROFILE_RHS);
     arkls_mem->nfeDQ++;
     if (retval != 0) break;
 
@@ -2058,7 +2142,9 @@ int arkLsBandDQJac(realtype t, N_Vector y, N_Vector fy,
     }
 
     /* Evaluate f with incremented y */
+    SUNDIALS_PROFILE_BEGIN(ark_mem->profile, SUN_PROFILE_RHS);
     retval = fi(ark_mem->tcur, ytemp, ftemp, ark_mem->user_data);
+    SUNDIALS_PROFILE_END(ark_mem->profile, SUN_PROFILE_RHS);
     arkls_mem->nfeDQ++;
     if (retval != 0) break;
 
@@ -2087,6 +2173,264 @@ int arkLsBandDQJac(realtype t, N_Vector y, N_Vector fy,
 }
 
 
+/*---------------------------------------------------------------
+  arkLsSparseDQJac:
+
+  This routine generates a sparse difference quotient approximation
+  to the Jacobian of fi(t,y), using the sparsity pattern and column
+  coloring set with arkLSSetSparseDQJac (Curtis-Powell-Reid). All
+  columns of a color have no nonzero in a common row, so they are
+  incremented together and fi is evaluated once per color. If more
+  than one thread was requested, the colors are evaluated
+  concurrently with OpenMP, each thread using its own work vectors.
+  ---------------------------------------------------------------*/
+int arkLsSparseDQJac(realtype t, N_Vector y, N_Vector fy,
+                     SUNMatrix Jac, ARKodeMem ark_mem,
+                     ARKLsMem arkls_mem, ARKRhsFn fi,
+                     N_Vector tmp1, N_Vector tmp2)
+{
+  N_Vector ftemp, ytemp;
+  realtype fnorm, minInc, srur;
+  realtype *Jx;
+  sunindextype g, N;
+  int retval = 0;
+#ifdef _OPENMP
+  long int nfe;
+  int ret;
+#endif
+
+  /* access matrix dimension */
+  N = SUNSparseMatrix_Columns(Jac);
+
+  /* Load the sparsity pattern into Jac */
+  if (SUNMatCopy(arkls_mem->Jpat, Jac) != 0) {
+    arkProcessError(ark_mem, ARKLS_MEM_FAIL, "ARKLS", "arkLsSparseDQJac",
+                    MSG_LS_MEM_FAIL);
+    return(-1);
+  }
+  Jx = SUNSparseMatrix_Data(Jac);
+
+  /* Set minimum increment based on uround and norm of f */
+  srur = SUNRsqrt(ark_mem->uround);
+  fnorm = N_VWrmsNorm(fy, ark_mem->rwt);
+  minInc = (fnorm != ZERO) ?
+    (MIN_INC_MULT * SUNRabs(ark_mem->h) * ark_mem->uround * N * fnorm) : ONE;
+
+#ifdef _OPENMP
+  if (arkls_mem->dqthreads > 1) {
+
+    /* Evaluate the colors concurrently; a negative (unrecoverable)
+       return value from fi takes precedence over a positive one */
+    nfe = 0;
+#pragma omp parallel default(shared) private(g, ftemp, ytemp, ret) \
+  num_threads(arkls_mem->dqthreads)
+    {
+      ftemp = N_VClone(tmp1);
+      ytemp = N_VClone(tmp2);
+      if ((ftemp != NULL) && (ytemp != NULL))
+        N_VScale(ONE, y, ytemp);
+
+#pragma omp for schedule(dynamic) reduction(+:nfe)
+      for (g = 0; g < arkls_mem->ncolors; g++) {
+        if ((ftemp == NULL) || (ytemp == NULL)) {
+          ret = -1;
+        } else {
+          ret = arkLsSparseDQJacColor(t, y, fy, ytemp, ftemp, Jx, srur,
+                                        minInc, g, ark_mem, arkls_mem,
+                                      fi);
+          nfe++;
+        }
+        if (ret != 0) {
+#pragma omp critical (arkLsSparseDQJac_retval)
+          if ((retval == 0) || (ret < 0))  retval = ret;
+        }
+      }
+
+      if (ftemp != NULL)  N_VDestroy(ftemp);
+      if (ytemp != NULL)  N_VDestroy(ytemp);
+    }
+    arkls_mem->nfeDQ += nfe;
+
+    return(retval);
+  }
+#endif
+
+  /* Rename work vectors for use as temporary values of y and f */
+  ftemp = tmp1;
+  ytemp = tmp2;
+
+  /* Load ytemp with y = predicted y vector */
+  N_VScale(ONE, y, ytemp);
+
+  /* Loop over column colors */
+  for (g = 0; g < arkls_mem->ncolors; g++) {
+    retval = arkLsSparseDQJacColor(t, y, fy, ytemp, ftemp, Jx, srur,
+                                    minInc, g, ark_mem, arkls_mem, fi);
+    arkls_mem->nfeDQ++;
+    if (retval != 0) break;
+  }
+
+  return(retval);
+}
+
+
+/*---------------------------------------------------------------
+  arkLsSparseDQJacColor:
+
+  This routine computes the columns of color g of the sparse
+  difference quotient Jacobian. On entry ytemp must equal y; it is
+  restored before returning.
+  ---------------------------------------------------------------*/
+static int arkLsSparseDQJacColor(realtype t, N_Vector y, N_Vector fy,
+                                 N_Vector ytemp, N_Vector ftemp,
+                                 realtype *Jx, realtype srur,
+                                 realtype minInc, sunindextype g,
+                                 ARKodeMem ark_mem, ARKLsMem arkls_mem,
+                                 ARKRhsFn fi)
+{
+  realtype inc, inc_inv, conj;
+  realtype *ewt_data, *fy_data, *ftemp_data;
+  realtype *y_data, *ytemp_data, *cns_data;
+  sunindextype c, j, k;
+  int retval;
+
+  /* Obtain pointers to the data for ewt, fy, ftemp, y, ytemp */
+  ewt_data   = N_VGetArrayPointer(ark_mem->ewt);
+  fy_data    = N_VGetArrayPointer(fy);
+  ftemp_data = N_VGetArrayPointer(ftemp);
+  y_data     = N_VGetArrayPointer(y);
+  ytemp_data = N_VGetArrayPointer(ytemp);
+  cns_data = (ark_mem->constraintsSet) ?
+    N_VGetArrayPointer(ark_mem->constraints) : NULL;
+
+  /* Increment all y_j of color g */
+  for (c = arkls_mem->colorptrs[g]; c < arkls_mem->colorptrs[g+1]; c++) {
+    j = arkls_mem->colorcols[c];
+    inc = SUNMAX(srur*SUNRabs(y_data[j]), minInc/ewt_data[j]);
+
+    /* Adjust sign(inc) if yj has an inequality constraint. */
+    if (ark_mem->constraintsSet) {
+      conj = cns_data[j];
+      if (SUNRabs(conj) == ONE)      {if ((ytemp_data[j]+inc)*conj < ZERO)  inc = -inc;}
+      else if (SUNRabs(conj) == TWO) {if ((ytemp_data[j]+inc)*conj <= ZERO) inc = -inc;}
+    }
+
+    ytemp_data[j] += inc;
+  }
+
+  /* Evaluate fi with incremented y */
+  retval = fi(t, ytemp, ftemp, ark_mem->user_data);
+
+  /* Restore ytemp, then form and load difference quotients */
+  for (c = arkls_mem->colorptrs[g]; c < arkls_mem->colorptrs[g+1]; c++) {
+    j = arkls_mem->colorcols[c];
+    ytemp_data[j] = y_data[j];
+    if (retval != 0) continue;
+
+    inc = SUNMAX(srur*SUNRabs(y_data[j]), minInc/ewt_data[j]);
+
+    /* Adjust sign(inc) as before. */
+    if (ark_mem->constraintsSet) {
+      conj = cns_data[j];
+      if (SUNRabs(conj) == ONE)      {if ((ytemp_data[j]+inc)*conj < ZERO)  inc = -inc;}
+      else if (SUNRabs(conj) == TWO) {if ((ytemp_data[j]+inc)*conj <= ZERO) inc = -inc;}
+    }
+
+    inc_inv = ONE/inc;
+    for (k = arkls_mem->colptrs[j]; k < arkls_mem->colptrs[j+1]; k++)
+      Jx[arkls_mem->colpos[k]] = inc_inv*(ftemp_data[arkls_mem->colrows[k]] -
+                                         fy_data[arkls_mem->colrows[k]]);
+  }
+
+  return(retval);
+}
+
+
+/*---------------------------------------------------------------
+  arkLsSparseDQJacInit:
+
+  This routine builds a column-wise view of the sparsity pattern
+  Jpat (the data positions and rows of the entries of each column)
+  and colors its columns.
+  ---------------------------------------------------------------*/
+static int arkLsSparseDQJacInit(ARKLsMem arkls_mem)
+{
+  sunindextype *Jp, *Ji, *next;
+  sunindextype i, j, k, N, NP, nnz;
+
+  N   = SUNSparseMatrix_Columns(arkls_mem->Jpat);
+  NP  = SUNSparseMatrix_NP(arkls_mem->Jpat);
+  Jp  = SUNSparseMatrix_IndexPointers(arkls_mem->Jpat);
+  Ji  = SUNSparseMatrix_IndexValues(arkls_mem->Jpat);
+  nnz = Jp[NP];
+
+  arkls_mem->colorptrs = (sunindextype *) malloc((N+1)*sizeof(sunindextype));
+  arkls_mem->colorcols = (sunindextype *) malloc(N*sizeof(sunindextype));
+  arkls_mem->colptrs   = (sunindextype *) calloc(N+1, sizeof(sunindextype));
+  arkls_mem->colpos    = (sunindextype *) malloc((nnz+1)*sizeof(sunindextype));
+  arkls_mem->colrows   = (sunindextype *) malloc((nnz+1)*sizeof(sunindextype));
+  if ((arkls_mem->colorptrs == NULL) || (arkls_mem->colorcols == NULL) ||
+      (arkls_mem->colptrs == NULL) || (arkls_mem->colpos == NULL) ||
+      (arkls_mem->colrows == NULL))
+    return(-1);
+
+  if (SUNSparseMatrix_SparseType(arkls_mem->Jpat) == CSC_MAT) {
+
+    /* the pattern is already stored by columns */
+    for (j = 0; j <= N; j++)
+      arkls_mem->colptrs[j] = Jp[j];
+    for (k = 0; k < nnz; k++) {
+      arkls_mem->colpos[k]  = k;
+      arkls_mem->colrows[k] = Ji[k];
+    }
+
+  } else {
+
+    /* count the entries of each column, then fill the columns row by
+       row (colorcols is used as workspace for the next free slot) */
+    for (k = 0; k < nnz; k++)
+      arkls_mem->colptrs[Ji[k]+1]++;
+    for (j = 0; j < N; j++)
+      arkls_mem->colptrs[j+1] += arkls_mem->colptrs[j];
+    next = arkls_mem->colorcols;
+    for (j = 0; j < N; j++)
+      next[j] = arkls_mem->colptrs[j];
+    for (i = 0; i < NP; i++)
+      for (k = Jp[i]; k < Jp[i+1]; k++) {
+        arkls_mem->colpos[next[Ji[k]]]    = k;
+        arkls_mem->colrows[next[Ji[k]]++] = i;
+      }
+
+  }
+
+  return(SUNSparseMatrix_ColumnColoring(arkls_mem->Jpat, &arkls_mem->ncolors,
+                                        arkls_mem->colorptrs,
+                                        arkls_mem->colorcols));
+}
+
+
+/*---------------------------------------------------------------
+  arkLsSparseDQJacFree:
+
+  This routine frees the sparsity pattern and coloring set with
+  arkLSSetSparseDQJac.
+  ---------------------------------------------------------------*/
+static void arkLsSparseDQJacFree(ARKLsMem arkls_mem)
+{
+  if (arkls_mem->Jpat) {
+    SUNMatDestroy(arkls_mem->Jpat);
+    arkls_mem->Jpat = NULL;
+  }
+  free(arkls_mem->colorptrs);  arkls_mem->colorptrs = NULL;
+  free(arkls_mem->colorcols);  arkls_mem->colorcols = NULL;
+  free(arkls_mem->colptrs);    arkls_mem->colptrs   = NULL;
+  free(arkls_mem->colpos);     arkls_mem->colpos    = NULL;
+  free(arkls_mem->colrows);    arkls_mem->colrows   = NULL;
+  arkls_mem->ncolors   = 0;
+  arkls_mem->dqthreads = 1;
+}
+
+
 /*---------------------------------------------------------------
   arkLsDQJtimes:
 
@@ -2190,8 +2534,10 @@ static int arkLsLinSys(realtype t, N_Vector y, N_Vector fy, SUNMatrix A,
     }
 
     /* Compute new Jacobian matrix */
+    SUNDIALS_PROFILE_BEGIN(ark_mem->profile, SUN_PROFILE_JAC);
     retval = arkls_mem->jac(t, y, fy, A, arkls_mem->J_data,
                             vtemp1, vtemp2, vtemp3);
+    SUNDIALS_PROFILE_END(ark_mem->profile, SUN_PROFILE_JAC);
     if (retval < 0) {
       arkProcessError(ark_mem, ARKLS_JACFUNC_UNRECVR, "ARKLS",
                      "arkLsSetup",  MSG_LS_JACFUNC_FAILED);
@@ -2272,12 +2618,14 @@ int arkLsInitialize(void* arkode_mem)
       if (arkls_mem->jacDQ) {
 
         /* Internal difference quotient Jacobian. Check that A is dense or band,
-           otherwise return an error */
+           or sparse with a sparsity pattern, otherwise return an error */
         retval = 0;
         if (arkls_mem->A->ops->getid) {
 
           if ( (SUNMatGetID(arkls_mem->A) == SUNMATRIX_DENSE) ||
-               (SUNMatGetID(arkls_mem->A) == SUNMATRIX_BAND) ) {
+               (SUNMatGetID(arkls_mem->A) == SUNMATRIX_BAND) ||
+               ((SUNMatGetID(arkls_mem->A) == SUNMATRIX_SPARSE) &&
+                (arkls_mem->Jpat != NULL)) ) {
             arkls_mem->jac    = arkLsDQJac;
             arkls_mem->J_data = ark_mem;
           } else {
@@ -2728,6 +3076,9 @@ int arkLsFree(void* arkode_mem)
     arkls_mem->savedJ = NULL;
   }
 
+  /* Free the sparsity pattern and coloring */
+  arkLsSparseDQJacFree(arkls_mem);
+
   /* Nullify other N_Vector pointers */
   arkls_mem->ycur = NULL;
   arkls_mem->fcur = NULL;
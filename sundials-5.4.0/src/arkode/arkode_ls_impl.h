@@ -122,6 +122,23 @@ typedef struct ARKLsMemRec {
   ARKLsLinSysFn linsys;
   void* A_data;
 
+  /* Colored difference quotient Jacobian for a sparse A
+   * (set with arkLSSetSparseDQJac):
+   *     - Jpat      = sparsity pattern of J, in the format of A
+   *     - the columns of color g are colorcols[colorptrs[g]] to
+   *       colorcols[colorptrs[g+1]-1]
+   *     - the entries of column j are Jx[colpos[k]] in row colrows[k],
+   *       colptrs[j] <= k < colptrs[j+1]
+   *     - dqthreads = number of threads evaluating the colors */
+  SUNMatrix Jpat;
+  sunindextype ncolors;
+  sunindextype *colorptrs;
+  sunindextype *colorcols;
+  sunindextype *colptrs;
+  sunindextype *colpos;
+  sunindextype *colrows;
+  int dqthreads;
+
   int last_flag; /* last error flag returned by any function */
 
 } *ARKLsMem;
@@ -220,6 +237,10 @@ int arkLsBandDQJac(realtype t, N_Vector y, N_Vector fy,
                    SUNMatrix Jac, ARKodeMem ark_mem,
                    ARKLsMem arkls_mem, ARKRhsFn fi,
                    N_Vector tmp1, N_Vector tmp2);
+int arkLsSparseDQJac(realtype t, N_Vector y, N_Vector fy,
+                     SUNMatrix Jac, ARKodeMem ark_mem,
+                     ARKLsMem arkls_mem, ARKRhsFn fi,
+                     N_Vector tmp1, N_Vector tmp2);
 
 /* Generic linit/lsetup/lsolve/lfree interface routines for ARKode to call */
 int arkLsInitialize(void* arkode_mem);
@@ -280,6 +301,7 @@ int arkLSSetJacTimesRhsFn(void *arkode_mem, ARKRhsFn jtimesRhsFn);
 int arkLSSetMassTimes(void* arkode_mem, ARKLsMassTimesSetupFn msetup,
                       ARKLsMassTimesVecFn mtimes, void* mtimes_data);
 int arkLSSetLinSysFn(void* arkode_mem, ARKLsLinSysFn linsys);
+int arkLSSetSparseDQJac(void* arkode_mem, SUNMatrix S, int nthreads);
 
 int arkLSSetUserData(void *arkode_mem, void* user_data);
 int arkLSSetMassUserData(void *arkode_mem, void* user_data);
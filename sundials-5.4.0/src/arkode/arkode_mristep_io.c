@@ -137,6 +137,8 @@ int MRIStepSetJacTimesRhsFn(void *arkode_mem, ARKRhsFn jtimesRhsFn) {
   return(arkLSSetJacTimesRhsFn(arkode_mem, jtimesRhsFn)); }
 int MRIStepSetLinSysFn(void *arkode_mem, ARKLsLinSysFn linsys) {
   return(arkLSSetLinSysFn(arkode_mem, linsys)); }
+int MRIStepSetSparseDQJac(void *arkode_mem, SUNMatrix S, int nthreads) {
+  return(arkLSSetSparseDQJac(arkode_mem, S, nthreads)); }
 
 
 /*===============================================================
@@ -28,6 +28,7 @@
 #include <sundials/sundials_math.h>
 #include <sundials/sundials_types.h>
 #include <sunnonlinsol/sunnonlinsol_newton.h>
+#include "sundials_ensemble.h"
 
 /*=================================================================*/
 /* CVODE Private Constants                                         */
@@ -96,6 +97,10 @@
  *
  *    FUZZ_FACTOR fuzz factor used to estimate infinitesimal time intervals
  *
+ * CVodeGetDkyBatch
+ *
+ *    DKY_BLOCK   number of solution components interpolated per block
+ *
  * cvHin
  *
  *    HLB_FACTOR  factor for upper bound on initial step size
@@ -140,6 +145,8 @@
 
 #define FUZZ_FACTOR RCONST(100.0)
 
+#define DKY_BLOCK 256
+
 #define HLB_FACTOR RCONST(100.0)
 #define HUB_FACTOR RCONST(0.1)
 #define H_BIAS     HALF
@@ -234,6 +241,11 @@ static void cvSetBDF(CVodeMem cv_mem);
 static void cvSetTqBDF(CVodeMem cv_mem, realtype hsum, realtype alpha0,
                        realtype alpha0_hat, realtype xi_inv, realtype xistar_inv);
 
+/* Dense output */
+
+static int cvDkyCheckT(CVodeMem cv_mem, realtype t, const char *fname);
+static int cvDkyCoeffs(CVodeMem cv_mem, realtype t, int k, realtype *c);
+
 /* Nonlinear solver functions */
 
 static int cvNls(CVodeMem cv_mem, int nflag);
@@ -280,6 +292,13 @@ static int cvRcheck1(CVodeMem cv_mem);
 static int cvRcheck2(CVodeMem cv_mem);
 static int cvRcheck3(CVodeMem cv_mem);
 static int cvRootfind(CVodeMem cv_mem);
+static int cvRootScan(CVodeMem cv_mem, realtype *g, booleantype *zroot);
+static int cvRootPass(CVodeMem cv_mem, realtype tmid, realtype dtmax,
+                      int *imax, int *side);
+static int cvRootSample(CVodeMem cv_mem);
+static void cvRootPoint(int p, void *cvode_mem);
+static booleantype cvRootPtsAlloc(CVodeMem cv_mem);
+static void cvRootPtsFree(CVodeMem cv_mem);
 
 
 /*
@@ -375,6 +394,9 @@ void *CVodeCreate(int lmm)
   cv_mem->cv_nrtfn      = 0;
   cv_mem->cv_gactive    = NULL;
   cv_mem->cv_mxgnull    = 1;
+  cv_mem->cv_gfrac      = NULL;
+  cv_mem->cv_nrtpts     = 1;
+  cv_mem->cv_rtpts_mem  = NULL;
 
   /* Initialize projection variables */
   cv_mem->proj_mem     = NULL;
@@ -544,6 +566,12 @@ int CVodeInit(void *cvode_mem, CVRhsFn f, realtype t0, N_Vector y0)
   cv_mem->cv_nscon   = 0;
   cv_mem->cv_nge     = 0;
 
+  cv_mem->cv_nrtiters      = 0;
+  cv_mem->cv_nge_step      = 0;
+  cv_mem->cv_nrtiters_step = 0;
+
+  SUNProfile_Reset(&(cv_mem->cv_profile));
+
   cv_mem->cv_irfnd   = 0;
 
   /* Initialize other integrator optional outputs */
@@ -644,6 +672,12 @@ int CVodeReInit(void *cvode_mem, realtype t0, N_Vector y0)
   cv_mem->cv_nscon   = 0;
   cv_mem->cv_nge     = 0;
 
+  cv_mem->cv_nrtiters      = 0;
+  cv_mem->cv_nge_step      = 0;
+  cv_mem->cv_nrtiters_step = 0;
+
+  SUNProfile_Reset(&(cv_mem->cv_profile));
+
   cv_mem->cv_irfnd   = 0;
 
   /* Initialize other integrator optional outputs */
@@ -852,8 +886,10 @@ int CVodeRootInit(void *cvode_mem, int nrtfn, CVRootFn g)
     free(cv_mem->cv_iroots); cv_mem->cv_iroots = NULL;
     free(cv_mem->cv_rootdir); cv_mem->cv_rootdir = NULL;
     free(cv_mem->cv_gactive); cv_mem->cv_gactive = NULL;
+    free(cv_mem->cv_gfrac); cv_mem->cv_gfrac = NULL;
+    cvRootPtsFree(cv_mem);
 
-    cv_mem->cv_lrw -= 3 * (cv_mem->cv_nrtfn);
+    cv_mem->cv_lrw -= 4 * (cv_mem->cv_nrtfn);
     cv_mem->cv_liw -= 3 * (cv_mem->cv_nrtfn);
   }
 
@@ -879,8 +915,10 @@ int CVodeRootInit(void *cvode_mem, int nrtfn, CVRootFn g)
         free(cv_mem->cv_iroots); cv_mem->cv_iroots = NULL;
         free(cv_mem->cv_rootdir); cv_mem->cv_rootdir = NULL;
         free(cv_mem->cv_gactive); cv_mem->cv_gactive = NULL;
+        free(cv_mem->cv_gfrac); cv_mem->cv_gfrac = NULL;
+        cvRootPtsFree(cv_mem);
 
-        cv_mem->cv_lrw -= 3*nrt;
+        cv_mem->cv_lrw -= 4*nrt;
         cv_mem->cv_liw -= 3*nrt;
 
         cvProcessError(cv_mem, CV_ILL_INPUT, "CVODE", "CVodeRootInit",
@@ -968,13 +1006,27 @@ int CVodeRootInit(void *cvode_mem, int nrtfn, CVRootFn g)
     return(CV_MEM_FAIL);
   }
 
+  cv_mem->cv_gfrac = NULL;
+  cv_mem->cv_gfrac = (realtype *) malloc(nrt*sizeof(realtype));
+  if (cv_mem->cv_gfrac == NULL) {
+    free(cv_mem->cv_glo); cv_mem->cv_glo = NULL;
+    free(cv_mem->cv_ghi); cv_mem->cv_ghi = NULL;
+    free(cv_mem->cv_grout); cv_mem->cv_grout = NULL;
+    free(cv_mem->cv_iroots); cv_mem->cv_iroots = NULL;
+    free(cv_mem->cv_rootdir); cv_mem->cv_rootdir = NULL;
+    free(cv_mem->cv_gactive); cv_mem->cv_gactive = NULL;
+    cvProcessError(cv_mem, CV_MEM_FAIL, "CVODE", "CVodeRootInit",
+                   MSGCV_MEM_FAIL);
+    return(CV_MEM_FAIL);
+  }
+
   /* Set default values for rootdir (both directions) */
   for(i=0; i<nrt; i++) cv_mem->cv_rootdir[i] = 0;
 
   /* Set default values for gactive (all active) */
   for(i=0; i<nrt; i++) cv_mem->cv_gactive[i] = SUNTRUE;
 
-  cv_mem->cv_lrw += 3*nrt;
+  cv_mem->cv_lrw += 4*nrt;
   cv_mem->cv_liw += 3*nrt;
 
   return(CV_SUCCESS);
@@ -1076,8 +1128,10 @@ int CVode(void *cvode_mem, realtype tout, N_Vector yout,
 
     /* Call f at (t0,y0), set zn[1] = y'(t0). */
 
+    SUNDIALS_PROFILE_BEGIN(cv_mem->cv_profile, SUN_PROFILE_RHS);
     retval = cv_mem->cv_f(cv_mem->cv_tn, cv_mem->cv_zn[0],
                           cv_mem->cv_zn[1], cv_mem->cv_user_data);
+    SUNDIALS_PROFILE_END(cv_mem->cv_profile, SUN_PROFILE_RHS);
     cv_mem->cv_nfe++;
     if (retval < 0) {
       cvProcessError(cv_mem, CV_RHSFUNC_FAIL, "CVODE", "CVode",
@@ -1142,7 +1196,9 @@ int CVode(void *cvode_mem, realtype tout, N_Vector yout,
 
     if (cv_mem->cv_nrtfn > 0) {
 
+      SUNDIALS_PROFILE_BEGIN(cv_mem->cv_profile, SUN_PROFILE_ROOTFIND);
       retval = cvRcheck1(cv_mem);
+      SUNDIALS_PROFILE_END(cv_mem->cv_profile, SUN_PROFILE_ROOTFIND);
 
       if (retval == CV_RTFUNC_FAIL) {
         cvProcessError(cv_mem, CV_RTFUNC_FAIL, "CVODE", "cvRcheck1",
@@ -1181,7 +1237,9 @@ int CVode(void *cvode_mem, realtype tout, N_Vector yout,
 
       irfndp = cv_mem->cv_irfnd;
 
+      SUNDIALS_PROFILE_BEGIN(cv_mem->cv_profile, SUN_PROFILE_ROOTFIND);
       retval = cvRcheck2(cv_mem);
+      SUNDIALS_PROFILE_END(cv_mem->cv_profile, SUN_PROFILE_ROOTFIND);
 
       if (retval == CLOSERT) {
         cvProcessError(cv_mem, CV_ILL_INPUT, "CVODE", "cvRcheck2",
@@ -1200,7 +1258,9 @@ int CVode(void *cvode_mem, realtype tout, N_Vector yout,
          check remaining interval for roots */
       if ( SUNRabs(cv_mem->cv_tn - cv_mem->cv_tretlast) > troundoff ) {
 
+        SUNDIALS_PROFILE_BEGIN(cv_mem->cv_profile, SUN_PROFILE_ROOTFIND);
         retval = cvRcheck3(cv_mem);
+        SUNDIALS_PROFILE_END(cv_mem->cv_profile, SUN_PROFILE_ROOTFIND);
 
         if (retval == CV_SUCCESS) {     /* no root found */
           cv_mem->cv_irfnd = 0;
@@ -1347,7 +1407,9 @@ int CVode(void *cvode_mem, realtype tout, N_Vector yout,
     }
 
     /* Call cvStep to take a step */
+    SUNDIALS_PROFILE_BEGIN(cv_mem->cv_profile, SUN_PROFILE_STEP);
     kflag = cvStep(cv_mem);
+    SUNDIALS_PROFILE_END(cv_mem->cv_profile, SUN_PROFILE_STEP);
 
     /* Process failed step cases, and exit loop */
     if (kflag != CV_SUCCESS) {
@@ -1359,10 +1421,16 @@ int CVode(void *cvode_mem, realtype tout, N_Vector yout,
 
     nstloc++;
 
+    /* Root finding statistics are reported per step */
+    cv_mem->cv_nge_step      = cv_mem->cv_nge;
+    cv_mem->cv_nrtiters_step = cv_mem->cv_nrtiters;
+
     /* Check for root in last step taken. */
     if (cv_mem->cv_nrtfn > 0) {
 
+      SUNDIALS_PROFILE_BEGIN(cv_mem->cv_profile, SUN_PROFILE_ROOTFIND);
       retval = cvRcheck3(cv_mem);
+      SUNDIALS_PROFILE_END(cv_mem->cv_profile, SUN_PROFILE_ROOTFIND);
 
       if (retval == RTFOUND) {  /* A new root was found */
         cv_mem->cv_irfnd = 1;
@@ -1466,9 +1534,8 @@ int CVode(void *cvode_mem, realtype tout, N_Vector yout,
 
 int CVodeGetDky(void *cvode_mem, realtype t, int k, N_Vector dky)
 {
-  realtype s, r;
-  realtype tfuzz, tp, tn1;
-  int i, j, nvec, ier;
+  realtype r;
+  int j, nvec, ier;
   CVodeMem cv_mem;
 
   /* Check all inputs for legality */
@@ -1489,37 +1556,135 @@ int CVodeGetDky(void *cvode_mem, realtype t, int k, N_Vector dky)
     return(CV_BAD_K);
   }
 
-  /* Allow for some slack */
-  tfuzz = FUZZ_FACTOR * cv_mem->cv_uround *
-    (SUNRabs(cv_mem->cv_tn) + SUNRabs(cv_mem->cv_hu));
-  if (cv_mem->cv_hu < ZERO) tfuzz = -tfuzz;
-  tp = cv_mem->cv_tn - cv_mem->cv_hu - tfuzz;
-  tn1 = cv_mem->cv_tn + tfuzz;
-  if ((t-tp)*(t-tn1) > ZERO) {
-    cvProcessError(cv_mem, CV_BAD_T, "CVODE", "CVodeGetDky", MSGCV_BAD_T,
-                   t, cv_mem->cv_tn-cv_mem->cv_hu, cv_mem->cv_tn);
+  /* Check t against the last step, allowing for some slack */
+  if (cvDkyCheckT(cv_mem, t, "CVodeGetDky") != CV_SUCCESS)
     return(CV_BAD_T);
-  }
 
   /* Sum the differentiated interpolating polynomial */
-  nvec = 0;
 
-  s = (t - cv_mem->cv_tn) / cv_mem->cv_h;
-  for (j=cv_mem->cv_q; j >= k; j--) {
-    cv_mem->cv_cvals[nvec] = ONE;
-    for (i=j; i >= j-k+1; i--)
-      cv_mem->cv_cvals[nvec] *= i;
-    for (i=0; i < j-k; i++)
-      cv_mem->cv_cvals[nvec] *= s;
-    cv_mem->cv_Xvecs[nvec] = cv_mem->cv_zn[j];
-    nvec += 1;
-  }
+  SUNDIALS_PROFILE_BEGIN(cv_mem->cv_profile, SUN_PROFILE_INTERP);
+
+  nvec = cvDkyCoeffs(cv_mem, t, k, cv_mem->cv_cvals);
+  for (j=0; j < nvec; j++)
+    cv_mem->cv_Xvecs[j] = cv_mem->cv_zn[cv_mem->cv_q-j];
   ier = N_VLinearCombination(nvec, cv_mem->cv_cvals, cv_mem->cv_Xvecs, dky);
+
+  if (ier == CV_SUCCESS && k > 0) {
+    r = SUNRpowerI(cv_mem->cv_h, -k);
+    N_VScale(r, dky, dky);
+  }
+
+  SUNDIALS_PROFILE_END(cv_mem->cv_profile, SUN_PROFILE_INTERP);
+
   if (ier != CV_SUCCESS) return (CV_VECTOROP_ERR);
+  return(CV_SUCCESS);
+}
 
-  if (k == 0) return(CV_SUCCESS);
+/*
+ * CVodeGetDkyBatch
+ *
+ * This routine computes the k-th derivative of the interpolating
+ * polynomial at each of the ntimes times in times[], exactly as
+ * CVodeGetDky does, and stores the results in the caller-supplied
+ * array dky, viewed as an ntimes by N matrix whose row p holds the
+ * derivative at times[p]. With layout = CV_ROW_MAJOR component i at
+ * times[p] is stored in dky[p*N+i], with layout = CV_COL_MAJOR it is
+ * stored in dky[i*ntimes+p].
+ *
+ * The history array is traversed once in blocks of DKY_BLOCK
+ * components, and every requested time is evaluated on a block while
+ * it is in cache. The vectors must keep their data in a single local
+ * array (N_VGetArrayPointer), and must not be distributed.
+ */
+
+int CVodeGetDkyBatch(void *cvode_mem, int ntimes, realtype *times, int k,
+                     int layout, realtype *dky)
+{
+  realtype c[L_MAX], tmp[DKY_BLOCK];
+  realtype *zd[L_MAX], *z, *out, r, cj;
+  sunindextype N, ib, nb, i;
+  int j, p, nvec;
+  CVodeMem cv_mem;
+
+  /* Check all inputs for legality */
+
+  if (cvode_mem == NULL) {
+    cvProcessError(NULL, CV_MEM_NULL, "CVODE", "CVodeGetDkyBatch", MSGCV_NO_MEM);
+    return(CV_MEM_NULL);
+  }
+  cv_mem = (CVodeMem) cvode_mem;
+
+  if (dky == NULL) {
+    cvProcessError(cv_mem, CV_BAD_DKY, "CVODE", "CVodeGetDkyBatch",
+                   MSGCV_NULL_DKY);
+    return(CV_BAD_DKY);
+  }
+
+  if ((ntimes < 0) || ((ntimes > 0) && (times == NULL))) {
+    cvProcessError(cv_mem, CV_ILL_INPUT, "CVODE", "CVodeGetDkyBatch",
+                   MSGCV_BAD_NTIMES);
+    return(CV_ILL_INPUT);
+  }
+
+  if ((layout != CV_ROW_MAJOR) && (layout != CV_COL_MAJOR)) {
+    cvProcessError(cv_mem, CV_ILL_INPUT, "CVODE", "CVodeGetDkyBatch",
+                   MSGCV_BAD_LAYOUT);
+    return(CV_ILL_INPUT);
+  }
+
+  if ((k < 0) || (k > cv_mem->cv_q)) {
+    cvProcessError(cv_mem, CV_BAD_K, "CVODE", "CVodeGetDkyBatch", MSGCV_BAD_K);
+    return(CV_BAD_K);
+  }
+
+  for (p=0; p < ntimes; p++)
+    if (cvDkyCheckT(cv_mem, times[p], "CVodeGetDkyBatch") != CV_SUCCESS)
+      return(CV_BAD_T);
+
+  for (j=k; j <= cv_mem->cv_q; j++) {
+    zd[j] = N_VGetArrayPointer(cv_mem->cv_zn[j]);
+    if ((zd[j] == NULL) || (N_VGetCommunicator(cv_mem->cv_zn[j]) != NULL)) {
+      cvProcessError(cv_mem, CV_ILL_INPUT, "CVODE", "CVodeGetDkyBatch",
+                     MSGCV_BAD_DKY_NVECTOR);
+      return(CV_ILL_INPUT);
+    }
+  }
+
+  if (ntimes == 0) return(CV_SUCCESS);
+
+  SUNDIALS_PROFILE_BEGIN(cv_mem->cv_profile, SUN_PROFILE_INTERP);
+
+  N = N_VGetLength(cv_mem->cv_zn[0]);
   r = SUNRpowerI(cv_mem->cv_h, -k);
-  N_VScale(r, dky, dky);
+
+  for (ib=0; ib < N; ib += DKY_BLOCK) {
+    nb = SUNMIN(DKY_BLOCK, N-ib);
+
+    for (p=0; p < ntimes; p++) {
+
+      nvec = cvDkyCoeffs(cv_mem, times[p], k, c);
+
+      /* Row-major output is written in place, otherwise through tmp */
+      out = (layout == CV_ROW_MAJOR) ? dky + p*N + ib : tmp;
+
+      z  = zd[cv_mem->cv_q] + ib;
+      cj = c[0];
+      for (i=0; i < nb; i++) out[i] = cj * z[i];
+      for (j=1; j < nvec; j++) {
+        z  = zd[cv_mem->cv_q-j] + ib;
+        cj = c[j];
+        for (i=0; i < nb; i++) out[i] += cj * z[i];
+      }
+      if (k > 0)
+        for (i=0; i < nb; i++) out[i] *= r;
+
+      if (layout == CV_COL_MAJOR)
+        for (i=0; i < nb; i++) dky[(ib+i)*ntimes + p] = tmp[i];
+    }
+  }
+
+  SUNDIALS_PROFILE_END(cv_mem->cv_profile, SUN_PROFILE_INTERP);
+
   return(CV_SUCCESS);
 }
 
@@ -1581,7 +1746,9 @@ void CVodeFree(void **cvode_mem)
     free(cv_mem->cv_iroots); cv_mem->cv_iroots = NULL;
     free(cv_mem->cv_rootdir); cv_mem->cv_rootdir = NULL;
     free(cv_mem->cv_gactive); cv_mem->cv_gactive = NULL;
+    free(cv_mem->cv_gfrac); cv_mem->cv_gfrac = NULL;
   }
+  cvRootPtsFree(cv_mem);
 
   free(*cvode_mem);
   *cvode_mem = NULL;
@@ -2062,8 +2229,10 @@ static int cvYddNorm(CVodeMem cv_mem, realtype hg, realtype *yddnrm)
   int retval;
 
   N_VLinearSum(hg, cv_mem->cv_zn[1], ONE, cv_mem->cv_zn[0], cv_mem->cv_y);
+  SUNDIALS_PROFILE_BEGIN(cv_mem->cv_profile, SUN_PROFILE_RHS);
   retval = cv_mem->cv_f(cv_mem->cv_tn+hg, cv_mem->cv_y,
                         cv_mem->cv_tempv, cv_mem->cv_user_data);
+  SUNDIALS_PROFILE_END(cv_mem->cv_profile, SUN_PROFILE_RHS);
   cv_mem->cv_nfe++;
   if (retval < 0) return(CV_RHSFUNC_FAIL);
   if (retval > 0) return(RHSFUNC_RECVR);
@@ -2135,7 +2304,9 @@ static int cvStep(CVodeMem cv_mem)
     cvPredict(cv_mem);
     cvSet(cv_mem);
 
+    SUNDIALS_PROFILE_BEGIN(cv_mem->cv_profile, SUN_PROFILE_NLSOLVE);
     nflag = cvNls(cv_mem, nflag);
+    SUNDIALS_PROFILE_END(cv_mem->cv_profile, SUN_PROFILE_NLSOLVE);
     kflag = cvHandleNFlag(cv_mem, &nflag, saved_t, &ncf);
 
     /* Go back in loop if we need to predict again (nflag=PREV_CONV_FAIL) */
@@ -2160,7 +2331,9 @@ static int cvStep(CVodeMem cv_mem)
     }
 
     /* Perform error test (nflag=CV_SUCCESS) */
+    SUNDIALS_PROFILE_BEGIN(cv_mem->cv_profile, SUN_PROFILE_ERRTEST);
     eflag = cvDoErrorTest(cv_mem, &nflag, saved_t, &nef, &dsm);
+    SUNDIALS_PROFILE_END(cv_mem->cv_profile, SUN_PROFILE_ERRTEST);
 
     /* Go back in loop if we need to predict again (nflag=PREV_ERR_FAIL) */
     if (eflag == TRY_AGAIN) continue;
@@ -3040,8 +3213,10 @@ static int cvDoErrorTest(CVodeMem cv_mem, int *nflagPtr, realtype saved_t,
   cv_mem->cv_qwait = LONG_WAIT;
   cv_mem->cv_nscon = 0;
 
+  SUNDIALS_PROFILE_BEGIN(cv_mem->cv_profile, SUN_PROFILE_RHS);
   retval = cv_mem->cv_f(cv_mem->cv_tn, cv_mem->cv_zn[0],
                         cv_mem->cv_tempv, cv_mem->cv_user_data);
+  SUNDIALS_PROFILE_END(cv_mem->cv_profile, SUN_PROFILE_RHS);
   cv_mem->cv_nfe++;
   if (retval < 0) return(CV_RHSFUNC_FAIL);
   if (retval > 0) return(CV_UNREC_RHSFUNC_ERR);
@@ -3972,6 +4147,11 @@ static int cvRcheck3(CVodeMem cv_mem)
  * Defined Output Points for Solutions of ODEs, Sandia National
  * Laboratory Report SAND80-0180, February 1980.
  *
+ * If nrtpts > 1 (see CVodeSetRootSearchPoints), each pass evaluates g
+ * at nrtpts points at once, see cvRootPass. If g has no sign change
+ * at thi, it is then also evaluated at nrtpts points inside (tlo,thi),
+ * see cvRootSample, so that two roots in one interval may be found.
+ *
  * This routine uses the following parameters for communication:
  *
  * nrtfn    = number of functions g_i, or number of components of
@@ -4037,38 +4217,25 @@ static int cvRcheck3(CVodeMem cv_mem)
 
 static int cvRootfind(CVodeMem cv_mem)
 {
-  realtype alph, tmid, gfrac, maxfrac, fracint, fracsub;
+  realtype alph, tmid, tprev, dtmax, fracint, fracsub;
   int i, retval, imax, side, sideprev;
-  booleantype zroot, sgnchg;
-
-  imax = 0;
+  booleantype zroot;
 
   /* First check for change in sign in ghi or for a zero in ghi. */
-  maxfrac = ZERO;
-  zroot = SUNFALSE;
-  sgnchg = SUNFALSE;
-  for (i = 0;  i < cv_mem->cv_nrtfn; i++) {
-    if(!cv_mem->cv_gactive[i]) continue;
-    if (SUNRabs(cv_mem->cv_ghi[i]) == ZERO) {
-      if(cv_mem->cv_rootdir[i]*cv_mem->cv_glo[i] <= ZERO) {
-        zroot = SUNTRUE;
-      }
-    } else {
-      if ( (cv_mem->cv_glo[i]*cv_mem->cv_ghi[i] < ZERO) &&
-           (cv_mem->cv_rootdir[i]*cv_mem->cv_glo[i] <= ZERO) ) {
-        gfrac = SUNRabs(cv_mem->cv_ghi[i]/(cv_mem->cv_ghi[i] - cv_mem->cv_glo[i]));
-        if (gfrac > maxfrac) {
-          sgnchg = SUNTRUE;
-          maxfrac = gfrac;
-          imax = i;
-        }
-      }
-    }
+  imax = cvRootScan(cv_mem, cv_mem->cv_ghi, &zroot);
+
+  /* With several points per pass, look for a sign change or a zero
+     inside (tlo,thi) as well. If one is found, thi is moved there. */
+  if (imax < 0 && !zroot && cv_mem->cv_nrtpts > 1 && cvRootPtsAlloc(cv_mem)) {
+    cv_mem->cv_nrtiters++;
+    retval = cvRootSample(cv_mem);
+    if (retval == CV_RTFUNC_FAIL) return(CV_RTFUNC_FAIL);
+    imax = cvRootScan(cv_mem, cv_mem->cv_ghi, &zroot);
   }
 
   /* If no sign change was found, reset trout and grout.  Then return
      CV_SUCCESS if no zero was found, or set iroots and return RTFOUND.  */
-  if (!sgnchg) {
+  if (imax < 0) {
     cv_mem->cv_trout = cv_mem->cv_thi;
     for (i = 0; i < cv_mem->cv_nrtfn; i++) cv_mem->cv_grout[i] = cv_mem->cv_ghi[i];
     if (!zroot) return(CV_SUCCESS);
@@ -4082,8 +4249,9 @@ static int cvRootfind(CVodeMem cv_mem)
     return(RTFOUND);
   }
 
-  /* Initialize alph to avoid compiler warning */
+  /* Initialize alph and tprev to avoid compiler warning */
   alph = ONE;
+  tprev = cv_mem->cv_tlo;
 
   /* A sign change was found.  Loop to locate nearest root. */
 
@@ -4101,9 +4269,11 @@ static int cvRootfind(CVodeMem cv_mem)
        If the sides were the same, then double alph (if high side),
        or halve alph (if low side).
        The next guess tmid is the secant method value if alph = 1, but
-       is closer to tlo if alph < 1, and closer to thi if alph > 1.    */
+       is closer to tlo if alph < 1, and closer to thi if alph > 1.
+       A pass at several points that moved both ends (side = 0) also
+       resets alph = 1. */
 
-    if (sideprev == side) {
+    if (side != 0 && sideprev == side) {
       alph = (side == 2) ? alph*TWO : alph*HALF;
     } else {
       alph = ONE;
@@ -4125,6 +4295,25 @@ static int cvRootfind(CVodeMem cv_mem)
       tmid = cv_mem->cv_thi - fracsub*(cv_mem->cv_thi - cv_mem->cv_tlo);
     }
 
+    /* The change in tmid from the previous pass estimates the error
+       in tmid (this is used by passes at several points only). */
+    dtmax = (sideprev < 0) ? cv_mem->cv_thi - cv_mem->cv_tlo :
+      SUNRabs(tmid - tprev);
+    tprev = tmid;
+
+    cv_mem->cv_nrtiters++;
+    sideprev = side;
+
+    /* Evaluate g at tmid and at further points in (tlo,thi) at once */
+    if (cv_mem->cv_nrtpts > 1 && cvRootPtsAlloc(cv_mem)) {
+      retval = cvRootPass(cv_mem, tmid, dtmax, &imax, &side);
+      if (retval == CV_RTFUNC_FAIL) return(CV_RTFUNC_FAIL);
+      /* Stop at a zero of g at thi, or at root thi if converged */
+      if (retval == RTFOUND) break;
+      if (SUNRabs(cv_mem->cv_thi - cv_mem->cv_tlo) <= cv_mem->cv_ttol) break;
+      continue;
+    }
+
     (void) CVodeGetDky(cv_mem, tmid, 0, cv_mem->cv_y);
     retval = cv_mem->cv_gfun(tmid, cv_mem->cv_y, cv_mem->cv_grout,
                              cv_mem->cv_user_data);
@@ -4133,29 +4322,10 @@ static int cvRootfind(CVodeMem cv_mem)
 
     /* Check to see in which subinterval g changes sign, and reset imax.
        Set side = 1 if sign change is on low side, or 2 if on high side.  */
-    maxfrac = ZERO;
-    zroot = SUNFALSE;
-    sgnchg = SUNFALSE;
-    sideprev = side;
-    for (i = 0;  i < cv_mem->cv_nrtfn; i++) {
-      if(!cv_mem->cv_gactive[i]) continue;
-      if (SUNRabs(cv_mem->cv_grout[i]) == ZERO) {
-        if(cv_mem->cv_rootdir[i]*cv_mem->cv_glo[i] <= ZERO) zroot = SUNTRUE;
-      } else {
-        if ( (cv_mem->cv_glo[i]*cv_mem->cv_grout[i] < ZERO) &&
-             (cv_mem->cv_rootdir[i]*cv_mem->cv_glo[i] <= ZERO) ) {
-          gfrac = SUNRabs(cv_mem->cv_grout[i] /
-                          (cv_mem->cv_grout[i] - cv_mem->cv_glo[i]));
-          if (gfrac > maxfrac) {
-            sgnchg = SUNTRUE;
-            maxfrac = gfrac;
-            imax = i;
-          }
-        }
-      }
-    }
-    if (sgnchg) {
+    i = cvRootScan(cv_mem, cv_mem->cv_grout, &zroot);
+    if (i >= 0) {
       /* Sign change found in (tlo,tmid); replace thi with tmid. */
+      imax = i;
       cv_mem->cv_thi = tmid;
       for (i = 0; i < cv_mem->cv_nrtfn; i++)
         cv_mem->cv_ghi[i] = cv_mem->cv_grout[i];
@@ -4200,6 +4370,346 @@ static int cvRootfind(CVodeMem cv_mem)
   return(RTFOUND);
 }
 
+/*
+ * cvRootScan
+ *
+ * This routine compares the array g with glo, for the components
+ * that are active and whose direction agrees with rootdir. It sets
+ * gfrac[i] = |g_i/(g_i - glo_i)| > 0 if g_i changed sign, -1 if g_i
+ * is zero and 0 otherwise. The first loop has no branches, so that
+ * it is vectorized for a large number of functions g_i.
+ *
+ * This routine returns the index of the largest gfrac[i], which is
+ * the component whose secant estimate of the root is nearest to tlo,
+ * or -1 if no g_i changed sign. zroot is set if some g_i is zero.
+ */
+
+static int cvRootScan(CVodeMem cv_mem, realtype *g, booleantype *zroot)
+{
+  int i, imax, nrt, chg, zero, ok;
+  int *rootdir;
+  booleantype *gactive;
+  realtype *glo, *gfrac, maxfrac, den;
+
+  nrt     = cv_mem->cv_nrtfn;
+  rootdir = cv_mem->cv_rootdir;
+  gactive = cv_mem->cv_gactive;
+  glo     = cv_mem->cv_glo;
+  gfrac   = cv_mem->cv_gfrac;
+
+  for (i = 0; i < nrt; i++) {
+    ok   = (gactive[i] != 0) & (rootdir[i]*glo[i] <= ZERO);
+    zero = ok & (g[i] == ZERO);
+    chg  = ok & (glo[i]*g[i] < ZERO);
+    den  = chg ? (g[i] - glo[i]) : ONE;
+    gfrac[i] = chg ? SUNRabs(g[i]/den) : (zero ? -ONE : ZERO);
+  }
+
+  imax = -1;
+  maxfrac = ZERO;
+  *zroot = SUNFALSE;
+  for (i = 0; i < nrt; i++) {
+    if (gfrac[i] > maxfrac) {
+      maxfrac = gfrac[i];
+      imax = i;
+    }
+    if (gfrac[i] < ZERO) *zroot = SUNTRUE;
+  }
+
+  return(imax);
+}
+
+/*
+ * cvRootPass
+ *
+ * This routine does one pass of cvRootfind at nrtpts points: tmid and
+ * nrtpts-1 points around it, see below. The values of g at the points
+ * are computed at once (on several threads if SUNDIALS is built with
+ * SUNDIALS_ENSEMBLE_OPENMP), and the interval is reduced to the
+ * subinterval between the last point without and the first point with
+ * a sign change or a zero in g.
+ *
+ * On return, imax is the component to use for the next secant step
+ * and side is 1 if only thi was moved, 2 if only tlo was moved and 0
+ * if both were moved.
+ *
+ * This routine returns an int equal to:
+ *      CV_RTFUNC_FAIL  < 0 if the g function failed, or
+ *      RTFOUND         = 1 if g is zero (with no sign change) at thi, or
+ *      CV_SUCCESS      = 0 otherwise.
+ */
+
+static int cvRootPass(CVodeMem cv_mem, realtype tmid, realtype dtmax,
+                      int *imax, int *side)
+{
+  CVodeRootPtsMem pts_mem;
+  int i, k, n, p, npts, nd, nrt;
+  realtype dt, fmid, frac, h, hmax, r, dir, *g;
+  booleantype zroot;
+
+  pts_mem = cv_mem->cv_rtpts_mem;
+  npts = pts_mem->npts;
+  nrt  = cv_mem->cv_nrtfn;
+
+  /* Set the points: tmid and points at distances h, h*r, h*r^2, ...
+     on both sides of tmid, growing from h = ttol/2 to dtmax, the
+     estimated error in tmid. A good secant estimate tmid is thus
+     bracketed within ttol at once, and a poor one within its error.
+     Distances are used first on the side where the previous pass
+     found the sign change (below tmid unless tlo was moved). Points
+     outside of (tlo,thi) are dropped and the others are sorted from
+     tlo to thi. */
+  dt = cv_mem->cv_thi - cv_mem->cv_tlo;
+  h  = HALF*cv_mem->cv_ttol/SUNRabs(dt);
+  hmax = SUNMIN(SUNRabs(dtmax/dt), ONE);
+  nd = npts/2;
+  r  = (nd > 1 && h < hmax) ? SUNRpowerR(hmax/h, ONE/(nd-1)) : ONE;
+  dir = (*side == 2) ? ONE : -ONE;
+
+  fmid = (tmid - cv_mem->cv_tlo)/dt;
+  pts_mem->tpts[0] = fmid;
+  n = 1;
+  for (k = 1; k < npts; k++) {
+    frac = fmid + ((k % 2) ? dir : -dir)*h;
+    if (k % 2 == 0) h *= r;
+    if (frac <= ZERO || frac >= ONE) continue;
+    for (p = n; p > 0 && pts_mem->tpts[p-1] > frac; p--)
+      pts_mem->tpts[p] = pts_mem->tpts[p-1];
+    pts_mem->tpts[p] = frac;
+    n++;
+  }
+  for (p = 0; p < n; p++)
+    pts_mem->tpts[p] = (pts_mem->tpts[p] == fmid) ?
+      tmid : cv_mem->cv_tlo + pts_mem->tpts[p]*dt;
+
+  /* Interpolate y at all points (this uses the workspace in cv_mem),
+     then evaluate g at all points at once. */
+  for (p = 0; p < n; p++)
+    (void) CVodeGetDky(cv_mem, pts_mem->tpts[p], 0, pts_mem->ypts[p]);
+
+  SUNEnsemble_Run(n, n, cvRootPoint, (void *) cv_mem);
+  cv_mem->cv_nge += n;
+
+  for (p = 0; p < n; p++)
+    if (pts_mem->flags[p] != 0) return(CV_RTFUNC_FAIL);
+
+  /* Find the first point with a sign change or a zero */
+  for (p = 0; p < n; p++) {
+    i = cvRootScan(cv_mem, pts_mem->gpts + p*nrt, &zroot);
+    if (i >= 0 || zroot) break;
+  }
+
+  /* The sign change is in (tlo,thi) for the new tlo = tpts[p-1] and
+     thi = tpts[p] (tlo is not moved if p = 0 and thi is not moved if
+     p = n). The nearest root is then found again for the new tlo. */
+  if (p > 0) {
+    g = pts_mem->gpts + (p-1)*nrt;
+    cv_mem->cv_tlo = pts_mem->tpts[p-1];
+    for (i = 0; i < nrt; i++) cv_mem->cv_glo[i] = g[i];
+  }
+  if (p < n) {
+    g = pts_mem->gpts + p*nrt;
+    cv_mem->cv_thi = pts_mem->tpts[p];
+    for (i = 0; i < nrt; i++) cv_mem->cv_ghi[i] = g[i];
+  }
+
+  *side = (p == 0) ? 1 : ((p == n) ? 2 : 0);
+
+  i = cvRootScan(cv_mem, cv_mem->cv_ghi, &zroot);
+  if (i < 0) return(RTFOUND);
+
+  *imax = i;
+  return(CV_SUCCESS);
+}
+
+/*
+ * cvRootSample
+ *
+ * This routine evaluates g at nrtpts points evenly spaced inside
+ * (tlo,thi), at once as in cvRootPass. It is used when g has no sign
+ * change at thi, to find roots that come in pairs within the interval
+ * (e.g. g_i crosses zero and back within one step). thi is moved to
+ * the first point with a sign change or a zero in g, if any.
+ *
+ * This routine returns an int equal to:
+ *      CV_RTFUNC_FAIL  < 0 if the g function failed, or
+ *      CV_SUCCESS      = 0 otherwise.
+ */
+
+static int cvRootSample(CVodeMem cv_mem)
+{
+  CVodeRootPtsMem pts_mem;
+  int i, p, n, nrt;
+  realtype dt, *g;
+  booleantype zroot;
+
+  pts_mem = cv_mem->cv_rtpts_mem;
+  n   = pts_mem->npts;
+  nrt = cv_mem->cv_nrtfn;
+
+  dt = (cv_mem->cv_thi - cv_mem->cv_tlo)/(n + 1);
+  for (p = 0; p < n; p++) {
+    pts_mem->tpts[p] = cv_mem->cv_tlo + (p + 1)*dt;
+    (void) CVodeGetDky(cv_mem, pts_mem->tpts[p], 0, pts_mem->ypts[p]);
+  }
+
+  SUNEnsemble_Run(n, n, cvRootPoint, (void *) cv_mem);
+  cv_mem->cv_nge += n;
+
+  for (p = 0; p < n; p++)
+    if (pts_mem->flags[p] != 0) return(CV_RTFUNC_FAIL);
+
+  for (p = 0; p < n; p++) {
+    g = pts_mem->gpts + p*nrt;
+    if (cvRootScan(cv_mem, g, &zroot) >= 0 || zroot) {
+      cv_mem->cv_thi = pts_mem->tpts[p];
+      for (i = 0; i < nrt; i++) cv_mem->cv_ghi[i] = g[i];
+      break;
+    }
+  }
+
+  return(CV_SUCCESS);
+}
+
+/*
+ * cvRootPoint
+ *
+ * Evaluates g at the point p of a pass of cvRootPass.
+ */
+
+static void cvRootPoint(int p, void *cvode_mem)
+{
+  CVodeMem cv_mem;
+  CVodeRootPtsMem pts_mem;
+
+  cv_mem = (CVodeMem) cvode_mem;
+  pts_mem = cv_mem->cv_rtpts_mem;
+
+  pts_mem->flags[p] = cv_mem->cv_gfun(pts_mem->tpts[p], pts_mem->ypts[p],
+                                      pts_mem->gpts + p*cv_mem->cv_nrtfn,
+                                      cv_mem->cv_user_data);
+}
+
+/*
+ * cvRootPtsAlloc
+ *
+ * Allocates the workspace of cvRootPass for nrtpts points, if not
+ * done yet. If the allocation fails, cvRootfind uses one point.
+ */
+
+static booleantype cvRootPtsAlloc(CVodeMem cv_mem)
+{
+  CVodeRootPtsMem pts_mem;
+  int npts;
+
+  npts = cv_mem->cv_nrtpts;
+
+  if (cv_mem->cv_rtpts_mem != NULL) {
+    if (cv_mem->cv_rtpts_mem->npts == npts) return(SUNTRUE);
+    cvRootPtsFree(cv_mem);
+  }
+
+  pts_mem = (CVodeRootPtsMem) malloc(sizeof(struct CVodeRootPtsMemRec));
+  if (pts_mem == NULL) return(SUNFALSE);
+
+  pts_mem->npts  = npts;
+  pts_mem->tpts  = (realtype *) malloc(npts*sizeof(realtype));
+  pts_mem->gpts  = (realtype *) malloc(npts*cv_mem->cv_nrtfn*sizeof(realtype));
+  pts_mem->flags = (int *) malloc(npts*sizeof(int));
+  pts_mem->ypts  = N_VCloneVectorArray(npts, cv_mem->cv_ewt);
+
+  cv_mem->cv_rtpts_mem = pts_mem;
+
+  if (pts_mem->tpts == NULL || pts_mem->gpts == NULL ||
+      pts_mem->flags == NULL || pts_mem->ypts == NULL) {
+    cvRootPtsFree(cv_mem);
+    return(SUNFALSE);
+  }
+
+  return(SUNTRUE);
+}
+
+/*
+ * cvRootPtsFree
+ *
+ * Frees the workspace of cvRootPass.
+ */
+
+static void cvRootPtsFree(CVodeMem cv_mem)
+{
+  CVodeRootPtsMem pts_mem;
+
+  pts_mem = cv_mem->cv_rtpts_mem;
+  if (pts_mem == NULL) return;
+
+  if (pts_mem->ypts != NULL) N_VDestroyVectorArray(pts_mem->ypts, pts_mem->npts);
+  free(pts_mem->tpts);
+  free(pts_mem->gpts);
+  free(pts_mem->flags);
+  free(pts_mem);
+  cv_mem->cv_rtpts_mem = NULL;
+}
+
+/*
+ * =================================================================
+ * Dense output helper functions
+ * =================================================================
+ */
+
+/*
+ * cvDkyCheckT
+ *
+ * This routine checks that t lies in the interval of the last step
+ * taken, [tn - hu, tn], allowing for some slack. If not, an error is
+ * reported on behalf of fname and CV_BAD_T is returned.
+ */
+
+static int cvDkyCheckT(CVodeMem cv_mem, realtype t, const char *fname)
+{
+  realtype tfuzz, tp, tn1;
+
+  tfuzz = FUZZ_FACTOR * cv_mem->cv_uround *
+    (SUNRabs(cv_mem->cv_tn) + SUNRabs(cv_mem->cv_hu));
+  if (cv_mem->cv_hu < ZERO) tfuzz = -tfuzz;
+  tp = cv_mem->cv_tn - cv_mem->cv_hu - tfuzz;
+  tn1 = cv_mem->cv_tn + tfuzz;
+  if ((t-tp)*(t-tn1) > ZERO) {
+    cvProcessError(cv_mem, CV_BAD_T, "CVODE", fname, MSGCV_BAD_T,
+                   t, cv_mem->cv_tn-cv_mem->cv_hu, cv_mem->cv_tn);
+    return(CV_BAD_T);
+  }
+
+  return(CV_SUCCESS);
+}
+
+/*
+ * cvDkyCoeffs
+ *
+ * This routine computes the coefficients c[0], ..., c[q-k] of
+ * zn[q], ..., zn[k] in the k-th derivative of the interpolating
+ * polynomial at t, without the factor h^(-k). It returns the number
+ * of coefficients, q-k+1.
+ */
+
+static int cvDkyCoeffs(CVodeMem cv_mem, realtype t, int k, realtype *c)
+{
+  realtype s;
+  int i, j, nvec;
+
+  nvec = 0;
+  s = (t - cv_mem->cv_tn) / cv_mem->cv_h;
+  for (j=cv_mem->cv_q; j >= k; j--) {
+    c[nvec] = ONE;
+    for (i=j; i >= j-k+1; i--)
+      c[nvec] *= i;
+    for (i=0; i < j-k; i++)
+      c[nvec] *= s;
+    nvec += 1;
+  }
+
+  return(nvec);
+}
+
 /*
  * =================================================================
  * Internal EWT function
@@ -534,7 +534,9 @@ static int CVBandPDQJac(CVBandPrecData pdata, realtype t, N_Vector y,
     }
 
     /* Evaluate f with incremented y. */
+    SUNDIALS_PROFILE_BEGIN(cv_mem->cv_profile, SUN_PROFILE_RHS);
     retval = cv_mem->cv_f(t, ytemp, ftemp, cv_mem->cv_user_data);
+    SUNDIALS_PROFILE_END(cv_mem->cv_profile, SUN_PROFILE_RHS);
     pdata->nfeBP++;
     if (retval != 0) return(retval);
 
@@ -369,7 +369,9 @@ static int CVDiagSetup(CVodeMem cv_mem, int convfail, N_Vector ypred,
   }
 
   /* Evaluate f at perturbed y */
+  SUNDIALS_PROFILE_BEGIN(cv_mem->cv_profile, SUN_PROFILE_RHS);
   retval = f(tn, y, M, cv_mem->cv_user_data);
+  SUNDIALS_PROFILE_END(cv_mem->cv_profile, SUN_PROFILE_RHS);
   nfeDI++;
   if (retval < 0) {
     cvProcessError(cv_mem, CVDIAG_RHSFUNC_UNRECVR, "CVDIAG", "CVDiagSetup", MSGDG_RHSFUNC_FAILED);
@@ -0,0 +1,97 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2020, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the implementation file for the ensemble driver of CVODE,
+ * which advances a number of independent CVODE problems to the same
+ * output time on several threads.
+ * -----------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "cvode_impl.h"
+#include "sundials_ensemble.h"
+
+/* Arguments of CVode shared by all members */
+typedef struct _CVEnsembleArgs {
+  void **mems;
+  realtype tout;
+  N_Vector *yout;
+  realtype *tret;
+  int itask;
+  int *flags;
+} *CVEnsembleArgs;
+
+static void cvEnsembleMember(int k, void *user_data)
+{
+  CVEnsembleArgs args = (CVEnsembleArgs) user_data;
+
+  args->flags[k] = CVode(args->mems[k], args->tout, args->yout[k],
+                         &(args->tret[k]), args->itask);
+}
+
+/*
+ * CVodeEnsemble
+ *
+ * Calls CVode(cvode_mems[k], tout, yout[k], &tret[k], itask) for each
+ * of the nmembers members on up to nthreads threads and stores the
+ * return value in flags[k]. The members must not share any memory
+ * they write to (vectors, matrices, linear or nonlinear solvers) and
+ * their user-supplied functions must be thread safe. A member that
+ * fails does not stop the others.
+ *
+ * The return value is CV_SUCCESS if no member failed, the flag of the
+ * failed member with the smallest index otherwise, or CV_MEM_NULL or
+ * CV_ILL_INPUT if the input is illegal (in which case no member is
+ * advanced).
+ */
+
+int CVodeEnsemble(void **cvode_mems, int nmembers, realtype tout,
+                  N_Vector *yout, realtype *tret, int itask, int nthreads,
+                  int *flags)
+{
+  struct _CVEnsembleArgs args;
+  int k;
+
+  if (cvode_mems == NULL) {
+    cvProcessError(NULL, CV_MEM_NULL, "CVODE", "CVodeEnsemble", MSGCV_NO_MEM);
+    return(CV_MEM_NULL);
+  }
+
+  if (nmembers < 1 || nthreads < 1 || yout == NULL || tret == NULL ||
+      flags == NULL) {
+    cvProcessError(NULL, CV_ILL_INPUT, "CVODE", "CVodeEnsemble",
+                   MSGCV_BAD_ENSEMBLE);
+    return(CV_ILL_INPUT);
+  }
+
+  for (k=0; k<nmembers; k++) {
+    if (cvode_mems[k] == NULL) {
+      cvProcessError(NULL, CV_MEM_NULL, "CVODE", "CVodeEnsemble",
+                     MSGCV_NO_MEM);
+      return(CV_MEM_NULL);
+    }
+  }
+
+  args.mems  = cvode_mems;
+  args.tout  = tout;
+  args.yout  = yout;
+  args.tret  = tret;
+  args.itask = itask;
+  args.flags = flags;
+
+  SUNEnsemble_Run(nmembers, nthreads, cvEnsembleMember, (void *) &args);
+
+  for (k=0; k<nmembers; k++)
+    if (flags[k] < 0) return(flags[k]);
+
+  return(CV_SUCCESS);
+}
@@ -23,6 +23,7 @@
 
 #include "cvode/cvode.h"
 #include "cvode_proj_impl.h"
+#include "sundials_profile_impl.h"
 
 #ifdef __cplusplus  /* wrapper to enable C++ usage */
 extern "C" {
@@ -109,6 +110,23 @@ extern "C" {
  */
 
 
+/*
+ * -----------------------------------------------------------------
+ * Types: struct CVodeRootPtsMemRec, CVodeRootPtsMem
+ * -----------------------------------------------------------------
+ * Workspace for the root search passes that evaluate g at several
+ * points at once (see CVodeSetRootSearchPoints).
+ * -----------------------------------------------------------------
+ */
+
+typedef struct CVodeRootPtsMemRec {
+  int npts;          /* number of points the arrays below hold    */
+  realtype *tpts;    /* points of a root search pass              */
+  realtype *gpts;    /* g values at the points (npts*nrtfn)       */
+  N_Vector *ypts;    /* y values at the points                    */
+  int *flags;        /* return values of g at the points          */
+} *CVodeRootPtsMem;
+
 /*
  * -----------------------------------------------------------------
  * Types: struct CVodeMemRec, CVodeMem
@@ -357,6 +375,18 @@ typedef struct CVodeMemRec {
   long int cv_nge;         /* counter for g evaluations                       */
   booleantype *cv_gactive; /* array with active/inactive event functions      */
   int cv_mxgnull;          /* number of warning messages about possible g==0  */
+  realtype *cv_gfrac;      /* array of sign change fractions of a root scan   */
+  int cv_nrtpts;           /* number of g evaluations per root search pass    */
+  CVodeRootPtsMem cv_rtpts_mem; /* workspace for several g evaluations        */
+  long int cv_nrtiters;    /* counter for root search passes                  */
+  long int cv_nge_step;    /* value of nge when the last step was taken       */
+  long int cv_nrtiters_step; /* value of nrtiters when the last step was taken */
+
+  /*-----------
+    Profiling
+    -----------*/
+
+  SUNProfile cv_profile;  /* phase timers, if built with profiling          */
 
   /*---------------
     Projection Data
@@ -588,6 +618,7 @@ void cvRescale(CVodeMem cv_mem);
 #define MSGCV_MEM_FAIL "A memory request failed."
 #define MSGCV_BAD_LMM  "Illegal value for lmm. The legal values are CV_ADAMS and CV_BDF."
 #define MSGCV_NO_MALLOC "Attempt to call before CVodeInit."
+#define MSGCV_BAD_ENSEMBLE "Illegal ensemble input: nmembers < 1, nthreads < 1 or a NULL array."
 #define MSGCV_NEG_MAXORD "maxord <= 0 illegal."
 #define MSGCV_BAD_MAXORD  "Illegal attempt to increase maximum method order."
 #define MSGCV_SET_SLDET  "Attempt to use stability limit detection with the CV_ADAMS method illegal."
@@ -606,7 +637,11 @@ void cvRescale(CVodeMem cv_mem);
 #define MSGCV_BAD_K "Illegal value for k."
 #define MSGCV_NULL_DKY "dky = NULL illegal."
 #define MSGCV_BAD_T "Illegal value for t." MSG_TIME_INT
+#define MSGCV_BAD_NTIMES "ntimes < 0 or times = NULL illegal."
+#define MSGCV_BAD_LAYOUT "Illegal value for layout."
+#define MSGCV_BAD_DKY_NVECTOR "The batch dense output requires node-local vectors with an array pointer."
 #define MSGCV_NO_ROOT "Rootfinding was not initialized."
+#define MSGCV_NO_PROFILING "SUNDIALS was not built with profiling."
 #define MSGCV_NLS_INIT_FAIL "The nonlinear solver's init routine failed."
 
 /* CVode Error Messages */
@@ -585,6 +585,29 @@ int CVodeSetNoInactiveRootWarn(void *cvode_mem)
   return(CV_SUCCESS);
 }
 
+/*
+ * CVodeSetRootSearchPoints
+ *
+ * Specifies the number of points at which g is evaluated in each pass
+ * of the root search. A value <= 0 resets it to the default (1).
+ */
+
+int CVodeSetRootSearchPoints(void *cvode_mem, int npoints)
+{
+  CVodeMem cv_mem;
+
+  if (cvode_mem==NULL) {
+    cvProcessError(NULL, CV_MEM_NULL, "CVODE", "CVodeSetRootSearchPoints", MSGCV_NO_MEM);
+    return(CV_MEM_NULL);
+  }
+
+  cv_mem = (CVodeMem) cvode_mem;
+
+  cv_mem->cv_nrtpts = (npoints <= 0) ? 1 : npoints;
+
+  return(CV_SUCCESS);
+}
+
 /*
  * CVodeSetConstraints
  *
@@ -1121,6 +1144,60 @@ int CVodeGetNumGEvals(void *cvode_mem, long int *ngevals)
   return(CV_SUCCESS);
 }
 
+/*
+ * CVodeGetRootfindStats
+ *
+ * Returns the total number of root search passes, and the number of
+ * g evaluations and of root search passes since the last step.
+ */
+
+int CVodeGetRootfindStats(void *cvode_mem, long int *nrtiters,
+                          long int *ngevals_step, long int *nrtiters_step)
+{
+  CVodeMem cv_mem;
+
+  if (cvode_mem==NULL) {
+    cvProcessError(NULL, CV_MEM_NULL, "CVODE", "CVodeGetRootfindStats", MSGCV_NO_MEM);
+    return(CV_MEM_NULL);
+  }
+
+  cv_mem = (CVodeMem) cvode_mem;
+
+  *nrtiters      = cv_mem->cv_nrtiters;
+  *ngevals_step  = cv_mem->cv_nge - cv_mem->cv_nge_step;
+  *nrtiters_step = cv_mem->cv_nrtiters - cv_mem->cv_nrtiters_step;
+
+  return(CV_SUCCESS);
+}
+
+/*
+ * CVodeGetProfile
+ *
+ * Returns the times and number of calls of the integrator phases,
+ * if SUNDIALS was built with SUNDIALS_BUILD_WITH_PROFILING.
+ */
+
+int CVodeGetProfile(void *cvode_mem, SUNProfile *prof)
+{
+  CVodeMem cv_mem;
+
+  if (cvode_mem==NULL) {
+    cvProcessError(NULL, CV_MEM_NULL, "CVODE", "CVodeGetProfile", MSGCV_NO_MEM);
+    return(CV_MEM_NULL);
+  }
+
+  cv_mem = (CVodeMem) cvode_mem;
+
+#ifdef SUNDIALS_BUILD_WITH_PROFILING
+  *prof = cv_mem->cv_profile;
+  return(CV_SUCCESS);
+#else
+  cvProcessError(cv_mem, CV_ILL_INPUT, "CVODE", "CVodeGetProfile",
+                 MSGCV_NO_PROFILING);
+  return(CV_ILL_INPUT);
+#endif
+}
+
 /*
  * CVodeGetRootInfo
  *
@@ -42,6 +42,13 @@ static int cvLsLinSys(realtype t, N_Vector y, N_Vector fy, SUNMatrix A,
                       booleantype jok, booleantype *jcur, realtype gamma,
                       void *user_data, N_Vector tmp1, N_Vector tmp2,
                       N_Vector tmp3);
+static int cvLsSparseDQJacInit(CVLsMem cvls_mem);
+static void cvLsSparseDQJacFree(CVLsMem cvls_mem);
+static int cvLsSparseDQJacColor(realtype t, N_Vector y, N_Vector fy,
+                                N_Vector ytemp, N_Vector ftemp,
+                                realtype *Jx, realtype srur,
+                                realtype minInc, sunindextype g,
+                                CVodeMem cv_mem);
 
 /*===============================================================
   CVLS Exported functions -- Required
@@ -296,6 +303,76 @@ int CVodeSetJacFn(void *cvode_mem, CVLsJacFn jac)
 }
 
 
+/* CVodeSetSparseDQJac enables the colored difference quotient
+   Jacobian for a sparse SUNMatrix. S holds the sparsity pattern of
+   the Jacobian (its values are not used); the columns are grouped
+   into colors of structurally orthogonal columns, so that f is
+   evaluated once per color rather than once per column. If nthreads
+   is larger than one and CVODE is built with OpenMP, the colors are
+   evaluated concurrently, in which case f must be thread-safe. A NULL
+   S disables the colored approximation. */
+int CVodeSetSparseDQJac(void *cvode_mem, SUNMatrix S, int nthreads)
+{
+  CVodeMem cv_mem;
+  CVLsMem  cvls_mem;
+  int      retval;
+
+  /* access CVLsMem structure */
+  retval = cvLs_AccessLMem(cvode_mem, "CVodeSetSparseDQJac",
+                           &cv_mem, &cvls_mem);
+  if (retval != CVLS_SUCCESS)  return(retval);
+
+  /* return with failure if the linear system matrix is not sparse */
+  if ((cvls_mem->A == NULL) || (cvls_mem->A->ops->getid == NULL) ||
+      (SUNMatGetID(cvls_mem->A) != SUNMATRIX_SPARSE)) {
+    cvProcessError(cv_mem, CVLS_ILL_INPUT, "CVLS", "CVodeSetSparseDQJac",
+                   "The linear system matrix is not a sparse SUNMatrix");
+    return(CVLS_ILL_INPUT);
+  }
+
+  /* check the sparsity pattern and the number of threads */
+  if ((S != NULL) &&
+      ((S->ops->getid == NULL) || (SUNMatGetID(S) != SUNMATRIX_SPARSE) ||
+       (SUNSparseMatrix_Rows(S) != SUNSparseMatrix_Rows(cvls_mem->A)) ||
+       (SUNSparseMatrix_Columns(S) != SUNSparseMatrix_Columns(cvls_mem->A)))) {
+    cvProcessError(cv_mem, CVLS_ILL_INPUT, "CVLS", "CVodeSetSparseDQJac",
+                   "The sparsity pattern does not match the linear system matrix");
+    return(CVLS_ILL_INPUT);
+  }
+  if (nthreads < 1) {
+    cvProcessError(cv_mem, CVLS_ILL_INPUT, "CVLS", "CVodeSetSparseDQJac",
+                   "nthreads < 1 illegal.");
+    return(CVLS_ILL_INPUT);
+  }
+
+  /* free any previously set pattern */
+  cvLsSparseDQJacFree(cvls_mem);
+  if (S == NULL)  return(CVLS_SUCCESS);
+
+  /* store a copy of the pattern in the storage format of A */
+  if (SUNSparseMatrix_SparseType(S) == SUNSparseMatrix_SparseType(cvls_mem->A)) {
+    cvls_mem->Jpat = SUNMatClone(S);
+    retval = (cvls_mem->Jpat == NULL) ? -1 : SUNMatCopy(S, cvls_mem->Jpat);
+  } else if (SUNSparseMatrix_SparseType(cvls_mem->A) == CSR_MAT) {
+    retval = SUNSparseMatrix_ToCSR(S, &cvls_mem->Jpat);
+  } else {
+    retval = SUNSparseMatrix_ToCSC(S, &cvls_mem->Jpat);
+  }
+
+  /* build the column view and color the columns */
+  if (retval == 0)  retval = cvLsSparseDQJacInit(cvls_mem);
+  if (retval != 0) {
+    cvLsSparseDQJacFree(cvls_mem);
+    cvProcessError(cv_mem, CVLS_MEM_FAIL, "CVLS", "CVodeSetSparseDQJac",
+                   MSG_LS_MEM_FAIL);
+    return(CVLS_MEM_FAIL);
+  }
+  cvls_mem->dqthreads = nthreads;
+
+  return(CVLS_SUCCESS);
+}
+
+
 /* CVodeSetEpsLin specifies the nonlinear -> linear tolerance scale factor */
 int CVodeSetEpsLin(void *cvode_mem, realtype eplifac)
 {
@@ -939,7 +1016,7 @@ int cvLsPSolve(void *cvode_mem, N_Vector r, N_Vector z, realtype tol, int lr)
 /*-----------------------------------------------------------------
   cvLsDQJac
 
-  This routine is a wrapper for the Dense and Band
+  This routine is a wrapper for the Dense, Band and Sparse
   implementations of the difference quotient Jacobian
   approximation routines.
   ---------------------------------------------------------------*/
@@ -948,6 +1025,7 @@ int cvLsDQJac(realtype t, N_Vector y, N_Vector fy,
               N_Vector tmp2, N_Vector tmp3)
 {
   CVodeMem cv_mem;
+  CVLsMem  cvls_mem;
   int      retval;
 
   /* access CVodeMem structure */
@@ -957,6 +1035,7 @@ int cvLsDQJac(realtype t, N_Vector y, N_Vector fy,
     return(CVLS_MEM_NULL);
   }
   cv_mem = (CVodeMem) cvode_mem;
+  cvls_mem = (CVLsMem) cv_mem->cv_lmem;
 
   /* verify that Jac is non-NULL */
   if (Jac == NULL) {
@@ -983,6 +1062,9 @@ int cvLsDQJac(realtype t, N_Vector y, N_Vector fy,
     retval = cvLsDenseDQJac(t, y, fy, Jac, cv_mem, tmp1);
   } else if (SUNMatGetID(Jac) == SUNMATRIX_BAND) {
     retval = cvLsBandDQJac(t, y, fy, Jac, cv_mem, tmp1, tmp2);
+  } else if ((SUNMatGetID(Jac) == SUNMATRIX_SPARSE) &&
+             (cvls_mem->Jpat != NULL)) {
+    retval = cvLsSparseDQJac(t, y, fy, Jac, cv_mem, tmp1, tmp2);
   } else {
     cvProcessError(cv_mem, CVLS_ILL_INPUT, "CVLS", "cvLsDQJac",
                    "unrecognized matrix type for cvLsDQJac");
@@ -1058,7 +1140,9 @@ int cvLsDenseDQJac(realtype t, N_Vector y, N_Vector fy,
 
     y_data[j] += inc;
 
+    SUNDIALS_PROFILE_BEGIN(cv_mem->cv_profile, SUN_PROFILE_RHS);
     retval = cv_mem->cv_f(t, y, ftemp, cv_mem->cv_user_data);
+    SUNDIALS_PROFILE_END(cv_mem->cv_profile, SUN_PROFILE_RHS);
     cvls_mem->nfeDQ++;
     if (retval != 0) break;
 
@@ -1155,7 +1239,9 @@ int cvLsBandDQJac(realtype t, N_Vector y, N_Vector fy, SUNMatrix Jac,
     }
 
     /* Evaluate f with incremented y */
+    SUNDIALS_PROFILE_BEGIN(cv_mem->cv_profile, SUN_PROFILE_RHS);
     retval = cv_mem->cv_f(cv_mem->cv_tn, ytemp, ftemp, cv_mem->cv_user_data);
+    SUNDIALS_PROFILE_END(cv_mem->cv_profile, SUN_PROFILE_RHS);
     cvls_mem->nfeDQ++;
     if (retval != 0) break;
 
@@ -1184,6 +1270,271 @@ int cvLsBandDQJac(realtype t, N_Vector y, N_Vector fy, SUNMatrix Jac,
 }
 
 
+/*-----------------------------------------------------------------
+  cvLsSparseDQJac
+
+  This routine generates a sparse difference quotient approximation
+  to the Jacobian of f(t,y), using the sparsity pattern and column
+  coloring set with CVodeSetSparseDQJac (Curtis-Powell-Reid). All
+  columns of a color have no nonzero in a common row, so they are
+  incremented together and f is evaluated once per color. If more
+  than one thread was requested, the colors are evaluated
+  concurrently with OpenMP, each thread using its own work vectors.
+  -----------------------------------------------------------------*/
+int cvLsSparseDQJac(realtype t, N_Vector y, N_Vector fy, SUNMatrix Jac,
+                    CVodeMem cv_mem, N_Vector tmp1, N_Vector tmp2)
+{
+  N_Vector ftemp, ytemp;
+  realtype fnorm, minInc, srur;
+  realtype *Jx;
+  sunindextype g, N;
+  CVLsMem cvls_mem;
+  int retval = 0;
+#ifdef _OPENMP
+  long int nfe;
+  int ret;
+#endif
+
+  /* access LsMem interface structure */
+  cvls_mem = (CVLsMem) cv_mem->cv_lmem;
+
+  /* access matrix dimension */
+  N = SUNSparseMatrix_Columns(Jac);
+
+  /* Load the sparsity pattern into Jac */
+  if (SUNMatCopy(cvls_mem->Jpat, Jac) != 0) {
+    cvProcessError(cv_mem, CVLS_MEM_FAIL, "CVLS", "cvLsSparseDQJac",
+                   MSG_LS_MEM_FAIL);
+    return(-1);
+  }
+  Jx = SUNSparseMatrix_Data(Jac);
+
+  /* Set minimum increment based on uround and norm of f */
+  srur = SUNRsqrt(cv_mem->cv_uround);
+  fnorm = N_VWrmsNorm(fy, cv_mem->cv_ewt);
+  minInc = (fnorm != ZERO) ?
+    (MIN_INC_MULT * SUNRabs(cv_mem->cv_h) * cv_mem->cv_uround * N * fnorm) : ONE;
+
+#ifdef _OPENMP
+  if (cvls_mem->dqthreads > 1) {
+
+    /* Evaluate the colors concurrently; a negative (unrecoverable)
+       return value from f takes precedence over a positive one */
+    nfe = 0;
+#pragma omp parallel default(shared) private(g, ftemp, ytemp, ret) \
+  num_threads(cvls_mem->dqthreads)
+    {
+      ftemp = N_VClone(tmp1);
+      ytemp = N_VClone(tmp2);
+      if ((ftemp != NULL) && (ytemp != NULL))
+        N_VScale(ONE, y, ytemp);
+
+#pragma omp for schedule(dynamic) reduction(+:nfe)
+      for (g = 0; g < cvls_mem->ncolors; g++) {
+        if ((ftemp == NULL) || (ytemp == NULL)) {
+          ret = -1;
+        } else {
+          ret = cvLsSparseDQJacColor(t, y, fy, ytemp, ftemp, Jx, srur,
+                                     minInc, g, cv_mem);
+          nfe++;
+        }
+        if (ret != 0) {
+#pragma omp critical (cvLsSparseDQJac_retval)
+          if ((retval == 0) || (ret < 0))  retval = ret;
+        }
+      }
+
+      if (ftemp != NULL)  N_VDestroy(ftemp);
+      if (ytemp != NULL)  N_VDestroy(ytemp);
+    }
+    cvls_mem->nfeDQ += nfe;
+
+    return(retval);
+  }
+#endif
+
+  /* Rename work vectors for use as temporary values of y and f */
+  ftemp = tmp1;
+  ytemp = tmp2;
+
+  /* Load ytemp with y = predicted y vector */
+  N_VScale(ONE, y, ytemp);
+
+  /* Loop over column colors */
+  for (g = 0; g < cvls_mem->ncolors; g++) {
+    retval = cvLsSparseDQJacColor(t, y, fy, ytemp, ftemp, Jx, srur,
+                                  minInc, g, cv_mem);
+    cvls_mem->nfeDQ++;
+    if (retval != 0) break;
+  }
+
+  return(retval);
+}
+
+
+/*-----------------------------------------------------------------
+  cvLsSparseDQJacColor
+
+  This routine computes the columns of color g of the sparse
+  difference quotient Jacobian. On entry ytemp must equal y; it is
+  restored before returning.
+  -----------------------------------------------------------------*/
+static int cvLsSparseDQJacColor(realtype t, N_Vector y, N_Vector fy,
+                                N_Vector ytemp, N_Vector ftemp,
+                                realtype *Jx, realtype srur,
+                                realtype minInc, sunindextype g,
+                                CVodeMem cv_mem)
+{
+  realtype inc, inc_inv, conj;
+  realtype *ewt_data, *fy_data, *ftemp_data;
+  realtype *y_data, *ytemp_data, *cns_data;
+  sunindextype c, j, k;
+  CVLsMem cvls_mem;
+  int retval;
+
+  /* initialize cns_data to avoid compiler warning */
+  cns_data = NULL;
+
+  /* access LsMem interface structure */
+  cvls_mem = (CVLsMem) cv_mem->cv_lmem;
+
+  /* Obtain pointers to the data for ewt, fy, ftemp, y, ytemp */
+  ewt_data   = N_VGetArrayPointer(cv_mem->cv_ewt);
+  fy_data    = N_VGetArrayPointer(fy);
+  ftemp_data = N_VGetArrayPointer(ftemp);
+  y_data     = N_VGetArrayPointer(y);
+  ytemp_data = N_VGetArrayPointer(ytemp);
+  if (cv_mem->cv_constraintsSet)
+    cns_data = N_VGetArrayPointer(cv_mem->cv_constraints);
+
+  /* Increment all y_j of color g */
+  for (c = cvls_mem->colorptrs[g]; c < cvls_mem->colorptrs[g+1]; c++) {
+    j = cvls_mem->colorcols[c];
+    inc = SUNMAX(srur*SUNRabs(y_data[j]), minInc/ewt_data[j]);
+
+    /* Adjust sign(inc) if yj has an inequality constraint. */
+    if (cv_mem->cv_constraintsSet) {
+      conj = cns_data[j];
+      if (SUNRabs(conj) == ONE)      {if ((ytemp_data[j]+inc)*conj < ZERO)  inc = -inc;}
+      else if (SUNRabs(conj) == TWO) {if ((ytemp_data[j]+inc)*conj <= ZERO) inc = -inc;}
+    }
+
+    ytemp_data[j] += inc;
+  }
+
+  /* Evaluate f with incremented y */
+  retval = cv_mem->cv_f(t, ytemp, ftemp, cv_mem->cv_user_data);
+
+  /* Restore ytemp, then form and load difference quotients */
+  for (c = cvls_mem->colorptrs[g]; c < cvls_mem->colorptrs[g+1]; c++) {
+    j = cvls_mem->colorcols[c];
+    ytemp_data[j] = y_data[j];
+    if (retval != 0) continue;
+
+    inc = SUNMAX(srur*SUNRabs(y_data[j]), minInc/ewt_data[j]);
+
+    /* Adjust sign(inc) as before. */
+    if (cv_mem->cv_constraintsSet) {
+      conj = cns_data[j];
+      if (SUNRabs(conj) == ONE)      {if ((ytemp_data[j]+inc)*conj < ZERO)  inc = -inc;}
+      else if (SUNRabs(conj) == TWO) {if ((ytemp_data[j]+inc)*conj <= ZERO) inc = -inc;}
+    }
+
+    inc_inv = ONE/inc;
+    for (k = cvls_mem->colptrs[j]; k < cvls_mem->colptrs[j+1]; k++)
+      Jx[cvls_mem->colpos[k]] = inc_inv*(ftemp_data[cvls_mem->colrows[k]] -
+                                         fy_data[cvls_mem->colrows[k]]);
+  }
+
+  return(retval);
+}
+
+
+/*-----------------------------------------------------------------
+  cvLsSparseDQJacInit
+
+  This routine builds a column-wise view of the sparsity pattern
+  Jpat (the data positions and rows of the entries of each column)
+  and colors its columns.
+  -----------------------------------------------------------------*/
+static int cvLsSparseDQJacInit(CVLsMem cvls_mem)
+{
+  sunindextype *Jp, *Ji, *next;
+  sunindextype i, j, k, N, NP, nnz;
+
+  N   = SUNSparseMatrix_Columns(cvls_mem->Jpat);
+  NP  = SUNSparseMatrix_NP(cvls_mem->Jpat);
+  Jp  = SUNSparseMatrix_IndexPointers(cvls_mem->Jpat);
+  Ji  = SUNSparseMatrix_IndexValues(cvls_mem->Jpat);
+  nnz = Jp[NP];
+
+  cvls_mem->colorptrs = (sunindextype *) malloc((N+1)*sizeof(sunindextype));
+  cvls_mem->colorcols = (sunindextype *) malloc(N*sizeof(sunindextype));
+  cvls_mem->colptrs   = (sunindextype *) calloc(N+1, sizeof(sunindextype));
+  cvls_mem->colpos    = (sunindextype *) malloc((nnz+1)*sizeof(sunindextype));
+  cvls_mem->colrows   = (sunindextype *) malloc((nnz+1)*sizeof(sunindextype));
+  if ((cvls_mem->colorptrs == NULL) || (cvls_mem->colorcols == NULL) ||
+      (cvls_mem->colptrs == NULL) || (cvls_mem->colpos == NULL) ||
+      (cvls_mem->colrows == NULL))
+    return(-1);
+
+  if (SUNSparseMatrix_SparseType(cvls_mem->Jpat) == CSC_MAT) {
+
+    /* the pattern is already stored by columns */
+    for (j = 0; j <= N; j++)
+      cvls_mem->colptrs[j] = Jp[j];
+    for (k = 0; k < nnz; k++) {
+      cvls_mem->colpos[k]  = k;
+      cvls_mem->colrows[k] = Ji[k];
+    }
+
+  } else {
+
+    /* count the entries of each column, then fill the columns row by
+       row (colorcols is used as workspace for the next free slot) */
+    for (k = 0; k < nnz; k++)
+      cvls_mem->colptrs[Ji[k]+1]++;
+    for (j = 0; j < N; j++)
+      cvls_mem->colptrs[j+1] += cvls_mem->colptrs[j];
+    next = cvls_mem->colorcols;
+    for (j = 0; j < N; j++)
+      next[j] = cvls_mem->colptrs[j];
+    for (i = 0; i < NP; i++)
+      for (k = Jp[i]; k < Jp[i+1]; k++) {
+        cvls_mem->colpos[next[Ji[k]]]    = k;
+        cvls_mem->colrows[next[Ji[k]]++] = i;
+      }
+
+  }
+
+  return(SUNSparseMatrix_ColumnColoring(cvls_mem->Jpat, &cvls_mem->ncolors,
+                                        cvls_mem->colorptrs,
+                                        cvls_mem->colorcols));
+}
+
+
+/*-----------------------------------------------------------------
+  cvLsSparseDQJacFree
+
+  This routine frees the sparsity pattern and coloring set with
+  CVodeSetSparseDQJac.
+  -----------------------------------------------------------------*/
+static void cvLsSparseDQJacFree(CVLsMem cvls_mem)
+{
+  if (cvls_mem->Jpat) {
+    SUNMatDestroy(cvls_mem->Jpat);
+    cvls_mem->Jpat = NULL;
+  }
+  free(cvls_mem->colorptrs);  cvls_mem->colorptrs = NULL;
+  free(cvls_mem->colorcols);  cvls_mem->colorcols = NULL;
+  free(cvls_mem->colptrs);    cvls_mem->colptrs   = NULL;
+  free(cvls_mem->colpos);     cvls_mem->colpos    = NULL;
+  free(cvls_mem->colrows);    cvls_mem->colrows   = NULL;
+  cvls_mem->ncolors   = 0;
+  cvls_mem->dqthreads = 1;
+}
+
+
 /*-----------------------------------------------------------------
   cvLsDQJtimes
 
@@ -1286,8 +1637,10 @@ static int cvLsLinSys(realtype t, N_Vector y, N_Vector fy, SUNMatrix A,
     }
 
     /* Compute new Jacobian matrix */
+    SUNDIALS_PROFILE_BEGIN(cv_mem->cv_profile, SUN_PROFILE_JAC);
     retval = cvls_mem->jac(t, y, fy, A, cvls_mem->J_data,
                            vtemp1, vtemp2, vtemp3);
+    SUNDIALS_PROFILE_END(cv_mem->cv_profile, SUN_PROFILE_JAC);
     if (retval < 0) {
       cvProcessError(cv_mem, CVLS_JACFUNC_UNRECVR, "CVLS",
                      "cvLsSetup",  MSG_LS_JACFUNC_FAILED);
@@ -1362,12 +1715,14 @@ int cvLsInitialize(CVodeMem cv_mem)
       if (cvls_mem->jacDQ) {
 
         /* Internal difference quotient Jacobian. Check that A is dense or band,
-           otherwise return an error */
+           or sparse with a sparsity pattern, otherwise return an error */
         retval = 0;
         if (cvls_mem->A->ops->getid) {
 
           if ( (SUNMatGetID(cvls_mem->A) == SUNMATRIX_DENSE) ||
-               (SUNMatGetID(cvls_mem->A) == SUNMATRIX_BAND) ) {
+               (SUNMatGetID(cvls_mem->A) == SUNMATRIX_BAND) ||
+               ((SUNMatGetID(cvls_mem->A) == SUNMATRIX_SPARSE) &&
+                (cvls_mem->Jpat != NULL)) ) {
             cvls_mem->jac    = cvLsDQJac;
             cvls_mem->J_data = cv_mem;
           } else {
@@ -1737,6 +2092,9 @@ int cvLsFree(CVodeMem cv_mem)
     cvls_mem->savedJ = NULL;
   }
 
+  /* Free the sparsity pattern and coloring */
+  cvLsSparseDQJacFree(cvls_mem);
+
   /* Nullify other N_Vector pointers */
   cvls_mem->ycur = NULL;
   cvls_mem->fcur = NULL;
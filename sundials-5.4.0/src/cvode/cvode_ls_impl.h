@@ -124,6 +124,23 @@ typedef struct CVLsMemRec {
   CVLsLinSysFn linsys;
   void* A_data;
 
+  /* Colored difference quotient Jacobian for a sparse A
+   * (set with CVodeSetSparseDQJac):
+   *     - Jpat      = sparsity pattern of J, in the format of A
+   *     - the columns of color g are colorcols[colorptrs[g]] to
+   *       colorcols[colorptrs[g+1]-1]
+   *     - the entries of column j are Jx[colpos[k]] in row colrows[k],
+   *       colptrs[j] <= k < colptrs[j+1]
+   *     - dqthreads = number of threads evaluating the colors */
+  SUNMatrix Jpat;
+  sunindextype ncolors;
+  sunindextype *colorptrs;
+  sunindextype *colorcols;
+  sunindextype *colptrs;
+  sunindextype *colpos;
+  sunindextype *colrows;
+  int dqthreads;
+
   int last_flag; /* last error flag returned by any function */
 
 } *CVLsMem;
@@ -151,6 +168,9 @@ int cvLsDenseDQJac(realtype t, N_Vector y, N_Vector fy,
 int cvLsBandDQJac(realtype t, N_Vector y, N_Vector fy,
                   SUNMatrix Jac, CVodeMem cv_mem, N_Vector tmp1,
                   N_Vector tmp2);
+int cvLsSparseDQJac(realtype t, N_Vector y, N_Vector fy,
+                    SUNMatrix Jac, CVodeMem cv_mem, N_Vector tmp1,
+                    N_Vector tmp2);
 
 /* Generic linit/lsetup/lsolve/lfree interface routines for CVode to call */
 int cvLsInitialize(CVodeMem cv_mem);
@@ -227,9 +227,11 @@ static int cvNlsLSetup(booleantype jbad, booleantype* jcur, void* cvode_mem)
     cv_mem->convfail = CV_FAIL_BAD_J;
 
   /* setup the linear solver */
+  SUNDIALS_PROFILE_BEGIN(cv_mem->cv_profile, SUN_PROFILE_LSETUP);
   retval = cv_mem->cv_lsetup(cv_mem, cv_mem->convfail, cv_mem->cv_y, cv_mem->cv_ftemp,
                              &(cv_mem->cv_jcur), cv_mem->cv_vtemp1, cv_mem->cv_vtemp2,
                              cv_mem->cv_vtemp3);
+  SUNDIALS_PROFILE_END(cv_mem->cv_profile, SUN_PROFILE_LSETUP);
   cv_mem->cv_nsetups++;
 
   /* update Jacobian status */
@@ -258,7 +260,9 @@ static int cvNlsLSolve(N_Vector delta, void* cvode_mem)
   }
   cv_mem = (CVodeMem) cvode_mem;
 
+  SUNDIALS_PROFILE_BEGIN(cv_mem->cv_profile, SUN_PROFILE_LSOLVE);
   retval = cv_mem->cv_lsolve(cv_mem, delta, cv_mem->cv_ewt, cv_mem->cv_y, cv_mem->cv_ftemp);
+  SUNDIALS_PROFILE_END(cv_mem->cv_profile, SUN_PROFILE_LSOLVE);
 
   if (retval < 0) return(CV_LSOLVE_FAIL);
   if (retval > 0) return(SUN_NLS_CONV_RECVR);
@@ -327,8 +331,10 @@ static int cvNlsResidual(N_Vector ycor, N_Vector res, void* cvode_mem)
   N_VLinearSum(ONE, cv_mem->cv_zn[0], ONE, ycor, cv_mem->cv_y);
 
   /* evaluate the rhs function */
+  SUNDIALS_PROFILE_BEGIN(cv_mem->cv_profile, SUN_PROFILE_RHS);
   retval = cv_mem->cv_f(cv_mem->cv_tn, cv_mem->cv_y, cv_mem->cv_ftemp,
                         cv_mem->cv_user_data);
+  SUNDIALS_PROFILE_END(cv_mem->cv_profile, SUN_PROFILE_RHS);
   cv_mem->cv_nfe++;
   if (retval < 0) return(CV_RHSFUNC_FAIL);
   if (retval > 0) return(RHSFUNC_RECVR);
@@ -365,8 +371,10 @@ static int cvNlsFPFunction(N_Vector ycor, N_Vector res, void* cvode_mem)
   N_VLinearSum(ONE, cv_mem->cv_zn[0], ONE, ycor, cv_mem->cv_y);
 
   /* evaluate the rhs function */
+  SUNDIALS_PROFILE_BEGIN(cv_mem->cv_profile, SUN_PROFILE_RHS);
   retval = cv_mem->cv_f(cv_mem->cv_tn, cv_mem->cv_y, res,
                         cv_mem->cv_user_data);
+  SUNDIALS_PROFILE_END(cv_mem->cv_profile, SUN_PROFILE_RHS);
   cv_mem->cv_nfe++;
   if (retval < 0) return(CV_RHSFUNC_FAIL);
   if (retval > 0) return(RHSFUNC_RECVR);
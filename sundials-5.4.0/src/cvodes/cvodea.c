@@ -50,7 +50,17 @@
 
 static CkpntMem CVAckpntInit(CVodeMem cv_mem);
 static CkpntMem CVAckpntNew(CVodeMem cv_mem);
-static void CVAckpntDelete(CkpntMem *ck_memPtr);
+static void CVAckpntSaveStep(CVodeMem cv_mem, CkpntMem ck_mem);
+static int CVAckpntVecs(CVodeMem cv_mem, CkpntMem ck_mem);
+static int CVAckpntStash(CVodeMem cv_mem, CkpntMem ck_mem);
+static void CVAckpntDelete(CVadjMem ca_mem, CkpntMem *ck_memPtr);
+static void CVAckpntRemove(CVadjMem ca_mem, CkpntMem *ck_memPtr);
+static void CVAckpntThin(CVodeMem cv_mem);
+static void CVAckpntPrune(CVadjMem ca_mem, CkpntMem ck_mem);
+static int CVAckpntRefine(CVodeMem cv_mem, CkpntMem *ck_memPtr,
+                          realtype tBout, int itaskB, int sign);
+static booleantype CVAckpntNeeded(CVadjMem ca_mem, CkpntMem ck_mem,
+                                  realtype tBout, int itaskB, int sign);
 
 static void CVAbckpbDelete(CVodeBMem *cvB_memPtr);
 
@@ -145,6 +155,17 @@ int CVodeAdjInit(void *cvode_mem, long int steps, int interp)
   /* No interpolation data is available */
   ca_mem->ca_ckpntData = NULL;
 
+  /* Check points are kept in N_Vectors */
+  ca_mem->ca_ckstoreType = CV_CKPNT_MEMORY;
+  ca_mem->ca_ckstoreDir  = NULL;
+  ca_mem->ca_ckstore     = NULL;
+  ca_mem->ca_ckvecs      = NULL;
+  ca_mem->ca_nckvecs     = 0;
+
+  /* No limit on the number of check points */
+  ca_mem->ca_maxckpnts = 0;
+  ca_mem->ca_ckstride  = 1;
+
   /* ------------------------------------
    * Initialization of interpolation data
    * ------------------------------------ */
@@ -285,13 +306,14 @@ int CVodeAdjReInit(void *cvode_mem)
 
   /* Free current list of Check Points */
 
-  while (ca_mem->ck_mem != NULL) CVAckpntDelete(&(ca_mem->ck_mem));
+  while (ca_mem->ck_mem != NULL) CVAckpntDelete(ca_mem, &(ca_mem->ck_mem));
 
   /* Initialization of check points */
 
   ca_mem->ck_mem = NULL;
   ca_mem->ca_nckpnts = 0;
   ca_mem->ca_ckpntData = NULL;
+  ca_mem->ca_ckstride = 1;
 
   /* CVodeF and CVodeB not called yet */
 
@@ -322,7 +344,12 @@ void CVodeAdjFree(void *cvode_mem)
     ca_mem = cv_mem->cv_adj_mem;
 
     /* Delete check points one by one */
-    while (ca_mem->ck_mem != NULL) CVAckpntDelete(&(ca_mem->ck_mem));
+    while (ca_mem->ck_mem != NULL) CVAckpntDelete(ca_mem, &(ca_mem->ck_mem));
+
+    /* Free the check point store */
+    SUNAdjStore_Destroy(ca_mem->ca_ckstore);
+    if (ca_mem->ca_ckstoreDir != NULL) free(ca_mem->ca_ckstoreDir);
+    if (ca_mem->ca_ckvecs != NULL) free(ca_mem->ca_ckvecs);
 
     /* Free vectors at all data points */
     if (ca_mem->ca_IMmallocDone) {
@@ -423,6 +450,24 @@ int CVodeF(void *cvode_mem, realtype tout, N_Vector yout,
 
     ca_mem->ca_tinitial = cv_mem->cv_tn;
 
+    /* Create the check point store, if one was requested */
+    if ( (ca_mem->ca_ckstoreType != CV_CKPNT_MEMORY) &&
+         (ca_mem->ca_ckstore == NULL) ) {
+
+      if ( !SUNAdjStore_VectorOK(cv_mem->cv_tempv) ||
+           (cv_mem->cv_quadr && !SUNAdjStore_VectorOK(cv_mem->cv_tempvQ)) ) {
+        cvProcessError(cv_mem, CV_ILL_INPUT, "CVODEA", "CVodeF", MSGCV_CKSTORE_VEC);
+        return(CV_ILL_INPUT);
+      }
+
+      ca_mem->ca_ckstore = SUNAdjStore_Create(ca_mem->ca_ckstoreType,
+                                              ca_mem->ca_ckstoreDir);
+      if (ca_mem->ca_ckstore == NULL) {
+        cvProcessError(cv_mem, CV_MEM_FAIL, "CVODEA", "CVodeF", MSGCV_CKSTORE_FAIL);
+        return(CV_MEM_FAIL);
+      }
+    }
+
     ca_mem->ck_mem = CVAckpntInit(cv_mem);
     if (ca_mem->ck_mem == NULL) {
       cvProcessError(cv_mem, CV_MEM_FAIL, "CVODEA", "CVodeF", MSGCV_MEM_FAIL);
@@ -532,6 +577,9 @@ int CVodeF(void *cvode_mem, realtype tout, N_Vector yout,
       ca_mem->ca_nckpnts++;
       cv_mem->cv_forceSetup = SUNTRUE;
 
+      /* Drop check points to stay within the maximum number */
+      CVAckpntThin(cv_mem);
+
       /* Reset i=0 and load dt_mem[0] */
       dt_mem[0]->t = ca_mem->ck_mem->ck_t0;
       ca_mem->ca_IMstore(cv_mem, dt_mem[0]);
@@ -1310,22 +1358,7 @@ int CVodeB(void *cvode_mem, realtype tBout, int itaskB)
 
   for(;;) {
 
-    tmp_cvB_mem = cvB_mem;
-    while(tmp_cvB_mem != NULL) {
-      tBn = tmp_cvB_mem->cv_mem->cv_tn;
-
-      if ( sign*(tBn-ck_mem->ck_t0) > ZERO ) {
-        gotCheckpoint = SUNTRUE;
-        break;
-      }
-
-      if ( (itaskB==CV_NORMAL) && (tBn == ck_mem->ck_t0) && (sign*(tBout-ck_mem->ck_t0) >= ZERO) ) {
-        gotCheckpoint = SUNTRUE;
-        break;
-      }
-
-      tmp_cvB_mem = tmp_cvB_mem->cv_next;
-    }
+    gotCheckpoint = CVAckpntNeeded(ca_mem, ck_mem, tBout, itaskB, sign);
 
     if (gotCheckpoint) break;
 
@@ -1339,10 +1372,18 @@ int CVodeB(void *cvode_mem, realtype tBout, int itaskB)
 
   for(;;) {
 
+    /* Free the check points recomputed for intervals already done */
+
+    CVAckpntPrune(ca_mem, ck_mem);
+
     /* Store interpolation data if not available.
-       This is the 2nd forward integration pass */
+       This is the 2nd forward integration pass. If CVodeF dropped
+       check points, first recompute them until the interval is
+       short enough. */
 
     if (ck_mem != ca_mem->ca_ckpntData) {
+      flag = CVAckpntRefine(cv_mem, &ck_mem, tBout, itaskB, sign);
+      if (flag != CV_SUCCESS) break;
       flag = CVAdataStore(cv_mem, ck_mem);
       if (flag != CV_SUCCESS) break;
     }
@@ -1566,6 +1607,10 @@ static CkpntMem CVAckpntInit(CVodeMem cv_mem)
   /* ck_mem->ck_zn[qmax] was not allocated */
   ck_mem->ck_zqm = 0;
 
+  /* The initial check point is always kept in N_Vectors */
+  ck_mem->ck_rec  = NULL;
+  ck_mem->ck_temp = SUNFALSE;
+
   /* Load ckdata from cv_mem */
   N_VScale(ONE, cv_mem->cv_zn[0], ck_mem->ck_zn[0]);
   ck_mem->ck_t0    = cv_mem->cv_tn;
@@ -1649,9 +1694,12 @@ static CkpntMem CVAckpntInit(CVodeMem cv_mem)
 
 static CkpntMem CVAckpntNew(CVodeMem cv_mem)
 {
+  CVadjMem ca_mem;
   CkpntMem ck_mem;
   int j, jj, is, qmax;
 
+  ca_mem = cv_mem->cv_adj_mem;
+
   /* Allocate space for ckdata */
   ck_mem = NULL;
   ck_mem = (CkpntMem) malloc(sizeof(struct CkpntMemRec));
@@ -1666,6 +1714,20 @@ static CkpntMem CVAckpntNew(CVodeMem cv_mem)
   qmax = cv_mem->cv_qmax;
   ck_mem->ck_zqm = (cv_mem->cv_q < qmax) ? qmax : 0;
 
+  ck_mem->ck_rec  = NULL;
+  ck_mem->ck_temp = SUNFALSE;
+
+  /* With a check point store, save the arrays there instead of
+     copying them to new N_Vectors */
+  if (ca_mem->ca_ckstore != NULL) {
+    if (CVAckpntStash(cv_mem, ck_mem) != CV_SUCCESS) {
+      free(ck_mem); ck_mem = NULL;
+      return(NULL);
+    }
+    CVAckpntSaveStep(cv_mem, ck_mem);
+    return(ck_mem);
+  }
+
   for (j=0; j<=cv_mem->cv_q; j++) {
     ck_mem->ck_zn[j] = N_VClone(cv_mem->cv_tempv);
     if (ck_mem->ck_zn[j] == NULL) {
@@ -1858,6 +1920,22 @@ static CkpntMem CVAckpntNew(CVodeMem cv_mem)
     }
   }
 
+  CVAckpntSaveStep(cv_mem, ck_mem);
+
+  return(ck_mem);
+}
+
+/*
+ * CVAckpntSaveStep
+ *
+ * This routine loads the step data of a new check point from
+ * current values in cv_mem.
+ */
+
+static void CVAckpntSaveStep(CVodeMem cv_mem, CkpntMem ck_mem)
+{
+  int j;
+
   for (j=0; j<=L_MAX; j++)        ck_mem->ck_tau[j] = cv_mem->cv_tau[j];
   for (j=0; j<=NUM_TESTS; j++)    ck_mem->ck_tq[j] = cv_mem->cv_tq[j];
   for (j=0; j<=cv_mem->cv_q; j++) ck_mem->ck_l[j] = cv_mem->cv_l[j];
@@ -1875,8 +1953,91 @@ static CkpntMem CVAckpntNew(CVodeMem cv_mem)
   ck_mem->ck_etamax    = cv_mem->cv_etamax;
   ck_mem->ck_t0        = cv_mem->cv_tn;
   ck_mem->ck_saved_tq5 = cv_mem->cv_saved_tq5;
+}
 
-  return(ck_mem);
+/*
+ * CVAckpntVecs
+ *
+ * This routine lists in ca_ckvecs the vectors of cv_mem that make up
+ * the Nordsieck arrays of the check point ck_mem, in the order in
+ * which they are saved in the check point store, and returns their
+ * number (or -1 if the list could not be allocated).
+ */
+
+static int CVAckpntVecs(CVodeMem cv_mem, CkpntMem ck_mem)
+{
+  CVadjMem ca_mem;
+  N_Vector *v;
+  int j, is, nv, Ns;
+
+  ca_mem = cv_mem->cv_adj_mem;
+
+  /* At most L_MAX arrays of each kind */
+  Ns = ck_mem->ck_sensi ? ck_mem->ck_Ns : 0;
+  nv = L_MAX*(2 + 2*Ns);
+  if (nv > ca_mem->ca_nckvecs) {
+    v = (N_Vector *) realloc(ca_mem->ca_ckvecs, nv*sizeof(N_Vector));
+    if (v == NULL) return(-1);
+    ca_mem->ca_ckvecs  = v;
+    ca_mem->ca_nckvecs = nv;
+  }
+  v = ca_mem->ca_ckvecs;
+
+  nv = 0;
+
+  for (j=0; j<=ck_mem->ck_q; j++) v[nv++] = cv_mem->cv_zn[j];
+  if (ck_mem->ck_zqm != 0) v[nv++] = cv_mem->cv_zn[ck_mem->ck_zqm];
+
+  if (ck_mem->ck_quadr) {
+    for (j=0; j<=ck_mem->ck_q; j++) v[nv++] = cv_mem->cv_znQ[j];
+    if (ck_mem->ck_zqm != 0) v[nv++] = cv_mem->cv_znQ[ck_mem->ck_zqm];
+  }
+
+  if (ck_mem->ck_sensi) {
+    for (j=0; j<=ck_mem->ck_q; j++)
+      for (is=0; is<Ns; is++) v[nv++] = cv_mem->cv_znS[j][is];
+    if (ck_mem->ck_zqm != 0)
+      for (is=0; is<Ns; is++) v[nv++] = cv_mem->cv_znS[ck_mem->ck_zqm][is];
+  }
+
+  if (ck_mem->ck_quadr_sensi) {
+    for (j=0; j<=ck_mem->ck_q; j++)
+      for (is=0; is<Ns; is++) v[nv++] = cv_mem->cv_znQS[j][is];
+    if (ck_mem->ck_zqm != 0)
+      for (is=0; is<Ns; is++) v[nv++] = cv_mem->cv_znQS[ck_mem->ck_zqm][is];
+  }
+
+  return(nv);
+}
+
+/*
+ * CVAckpntStash
+ *
+ * This routine saves the Nordsieck arrays of cv_mem for the new
+ * check point ck_mem in the check point store.
+ */
+
+static int CVAckpntStash(CVodeMem cv_mem, CkpntMem ck_mem)
+{
+  CVadjMem ca_mem;
+  int nv;
+
+  ca_mem = cv_mem->cv_adj_mem;
+
+  ck_mem->ck_q           = cv_mem->cv_q;
+  ck_mem->ck_quadr       = cv_mem->cv_quadr && cv_mem->cv_errconQ;
+  ck_mem->ck_sensi       = cv_mem->cv_sensi;
+  ck_mem->ck_Ns          = cv_mem->cv_Ns;
+  ck_mem->ck_quadr_sensi = cv_mem->cv_quadr_sensi && cv_mem->cv_errconQS;
+
+  nv = CVAckpntVecs(cv_mem, ck_mem);
+  if (nv < 0) return(CV_MEM_FAIL);
+
+  if (SUNAdjStore_Put(ca_mem->ca_ckstore, ca_mem->ca_ckvecs, nv,
+                      &(ck_mem->ck_rec)) != 0)
+    return(CV_MEM_FAIL);
+
+  return(CV_SUCCESS);
 }
 
 /*
@@ -1886,7 +2047,7 @@ static CkpntMem CVAckpntNew(CVodeMem cv_mem)
  * the new list head
  */
 
-static void CVAckpntDelete(CkpntMem *ck_memPtr)
+static void CVAckpntDelete(CVadjMem ca_mem, CkpntMem *ck_memPtr)
 {
   CkpntMem tmp;
   int j;
@@ -1899,6 +2060,13 @@ static void CVAckpntDelete(CkpntMem *ck_memPtr)
   /* move head of list */
   *ck_memPtr = (*ck_memPtr)->ck_next;
 
+  /* the data of tmp is in the check point store */
+  if (tmp->ck_rec != NULL) {
+    SUNAdjStore_Release(ca_mem->ca_ckstore, tmp->ck_rec);
+    free(tmp); tmp = NULL;
+    return;
+  }
+
   /* free N_Vectors in tmp */
   for (j=0;j<=tmp->ck_q;j++) N_VDestroy(tmp->ck_zn[j]);
   if (tmp->ck_zqm != 0) N_VDestroy(tmp->ck_zn[tmp->ck_zqm]);
@@ -1949,6 +2117,206 @@ static void CVAckpntDelete(CkpntMem *ck_memPtr)
 
 }
 
+/*
+ * CVAckpntRemove
+ *
+ * This routine removes the check point *ck_memPtr from the middle of
+ * the list; the next (older) check point then spans both intervals.
+ */
+
+static void CVAckpntRemove(CVadjMem ca_mem, CkpntMem *ck_memPtr)
+{
+  CkpntMem tmp;
+
+  tmp = *ck_memPtr;
+
+  tmp->ck_next->ck_t1 = tmp->ck_t1;
+
+  if (ca_mem->ca_ckpntData == tmp) ca_mem->ca_ckpntData = NULL;
+  if (!tmp->ck_temp) ca_mem->ca_nckpnts--;
+
+  CVAckpntDelete(ca_mem, ck_memPtr);
+}
+
+/*
+ * CVAckpntThin
+ *
+ * This routine is called by CVodeF after adding a check point. If a
+ * maximum number of check points was set, only the check points at
+ * multiples of ca_ckstride*nsteps steps are kept, besides the first
+ * and the last one. Whenever there are too many, the stride is
+ * doubled, which drops every other check point.
+ *
+ * CVodeB recomputes the dropped check points by bisection, which
+ * needs up to log2(ca_ckstride) more at a time, so these are kept
+ * free. This trades O(log) recomputations of each step for memory,
+ * as a binomial (revolve) schedule would, without knowing the
+ * number of steps in advance.
+ */
+
+static void CVAckpntThin(CVodeMem cv_mem)
+{
+  CVadjMem ca_mem;
+  CkpntMem *ck_memPtr;
+  long int stride, s;
+  int levels;
+
+  ca_mem = cv_mem->cv_adj_mem;
+
+  if (ca_mem->ca_maxckpnts <= 0) return;
+
+  /* The previous last check point is kept only if it is on the stride */
+  stride = ca_mem->ca_ckstride * ca_mem->ca_nsteps;
+  ck_memPtr = &(ca_mem->ck_mem->ck_next);
+  if ( ((*ck_memPtr)->ck_next != NULL) && ((*ck_memPtr)->ck_nst % stride != 0) )
+    CVAckpntRemove(ca_mem, ck_memPtr);
+
+  /* Check points needed: those in the list (nckpnts and the initial one)
+     and those recomputed by CVodeB */
+  levels = 0;
+  for (s=ca_mem->ca_ckstride; s>1; s/=2) levels++;
+
+  if ( (ca_mem->ca_nckpnts + 1 + levels <= ca_mem->ca_maxckpnts) ||
+       (ca_mem->ca_nckpnts < 2) ) return;
+
+  /* Double the stride and drop the check points that are not on it */
+  ca_mem->ca_ckstride *= 2;
+  stride = ca_mem->ca_ckstride * ca_mem->ca_nsteps;
+
+  ck_memPtr = &(ca_mem->ck_mem->ck_next);
+  while ((*ck_memPtr)->ck_next != NULL) {
+    if ((*ck_memPtr)->ck_nst % stride != 0)
+      CVAckpntRemove(ca_mem, ck_memPtr);
+    else
+      ck_memPtr = &((*ck_memPtr)->ck_next);
+  }
+}
+
+/*
+ * CVAckpntPrune
+ *
+ * This routine frees the check points recomputed by CVodeB that are
+ * later than the end of the interval of ck_mem; the backward problems
+ * are done with them.
+ */
+
+static void CVAckpntPrune(CVadjMem ca_mem, CkpntMem ck_mem)
+{
+  CkpntMem *ck_memPtr;
+
+  ck_memPtr = &(ca_mem->ck_mem);
+  while ( (*ck_memPtr != ck_mem) && ((*ck_memPtr)->ck_next != ck_mem) ) {
+    if ((*ck_memPtr)->ck_temp)
+      CVAckpntRemove(ca_mem, ck_memPtr);
+    else
+      ck_memPtr = &((*ck_memPtr)->ck_next);
+  }
+}
+
+/*
+ * CVAckpntRefine
+ *
+ * If the interval of the check point *ck_memPtr spans more than nsteps
+ * steps (because CVodeF dropped check points), this routine integrates
+ * from it to the middle of the interval and adds a check point there.
+ * It continues with the half in which the backward problems are, until
+ * the interval fits in dt_mem, and returns that check point.
+ *
+ * Return values:
+ * CV_SUCCESS
+ * CV_REIFWD_FAIL
+ * CV_FWD_FAIL
+ * CV_MEM_FAIL
+ */
+
+static int CVAckpntRefine(CVodeMem cv_mem, CkpntMem *ck_memPtr,
+                          realtype tBout, int itaskB, int sign)
+{
+  CVadjMem ca_mem;
+  CkpntMem ck_mem, newer, tmp;
+  long int nsteps, nst, nstmid;
+  realtype t;
+  int flag;
+
+  ca_mem = cv_mem->cv_adj_mem;
+  nsteps = ca_mem->ca_nsteps;
+  ck_mem = *ck_memPtr;
+
+  for(;;) {
+
+    /* Find the next (later) check point; the last interval is never
+       longer than nsteps steps */
+    newer = NULL;
+    for (tmp = ca_mem->ck_mem; tmp != ck_mem; tmp = tmp->ck_next) newer = tmp;
+    if (newer == NULL) break;
+
+    nst = newer->ck_nst - ck_mem->ck_nst;
+    if (nst <= nsteps) break;
+
+    /* Integrate to the middle of the interval (on a multiple of nsteps,
+       as CVodeF forced a setup there) */
+    nstmid = ck_mem->ck_nst + ((nst + nsteps - 1) / nsteps / 2) * nsteps;
+
+    flag = CVAckpntGet(cv_mem, ck_mem);
+    if (flag != CV_SUCCESS) return(CV_REIFWD_FAIL);
+
+    if (ca_mem->ca_tstopCVodeFcall)
+      CVodeSetStopTime(cv_mem, ca_mem->ca_tstopCVodeF);
+
+    while (cv_mem->cv_nst < nstmid) {
+      flag = CVode(cv_mem, newer->ck_t0, ca_mem->ca_ytmp, &t, CV_ONE_STEP);
+      if (flag < 0) return(CV_FWD_FAIL);
+      if (cv_mem->cv_nst % nsteps == 0) cv_mem->cv_forceSetup = SUNTRUE;
+    }
+
+    /* Insert the new check point between ck_mem and newer */
+    tmp = CVAckpntNew(cv_mem);
+    if (tmp == NULL) return(CV_MEM_FAIL);
+
+    tmp->ck_temp  = SUNTRUE;
+    tmp->ck_t1    = ck_mem->ck_t1;
+    ck_mem->ck_t1 = tmp->ck_t0;
+    tmp->ck_next  = ck_mem;
+    newer->ck_next = tmp;
+
+    /* Continue with the later half if a backward problem is there */
+    if (CVAckpntNeeded(ca_mem, tmp, tBout, itaskB, sign)) ck_mem = tmp;
+
+  }
+
+  *ck_memPtr = ck_mem;
+
+  return(CV_SUCCESS);
+}
+
+/*
+ * CVAckpntNeeded
+ *
+ * This routine returns SUNTRUE if a backward problem must still be
+ * integrated over (part of) the interval of the check point ck_mem.
+ */
+
+static booleantype CVAckpntNeeded(CVadjMem ca_mem, CkpntMem ck_mem,
+                                  realtype tBout, int itaskB, int sign)
+{
+  CVodeBMem tmp_cvB_mem;
+  realtype tBn;
+
+  tmp_cvB_mem = ca_mem->cvB_mem;
+  while(tmp_cvB_mem != NULL) {
+    tBn = tmp_cvB_mem->cv_mem->cv_tn;
+
+    if ( sign*(tBn-ck_mem->ck_t0) > ZERO ) return(SUNTRUE);
+
+    if ( (itaskB==CV_NORMAL) && (tBn == ck_mem->ck_t0) && (sign*(tBout-ck_mem->ck_t0) >= ZERO) )
+      return(SUNTRUE);
+
+    tmp_cvB_mem = tmp_cvB_mem->cv_next;
+  }
+
+  return(SUNFALSE);
+}
+
 /*
  * =================================================================
  * PRIVATE FUNCTIONS FOR BACKWARD PROBLEMS
@@ -2040,6 +2408,9 @@ static int CVAdataStore(CVodeMem cv_mem, CkpntMem ck_mem)
     flag = CVode(cv_mem, ck_mem->ck_t1, ca_mem->ca_ytmp, &t, CV_ONE_STEP);
     if (flag < 0) return(CV_FWD_FAIL);
 
+    /* The steps of the forward run must be replayed exactly */
+    if (i > ca_mem->ca_nsteps) return(CV_FWD_FAIL);
+
     dt_mem[i]->t = t;
     ca_mem->ca_IMstore(cv_mem, dt_mem[i]);
     i++;
@@ -2063,7 +2434,10 @@ static int CVAdataStore(CVodeMem cv_mem, CkpntMem ck_mem)
 
 static int CVAckpntGet(CVodeMem cv_mem, CkpntMem ck_mem)
 {
-  int flag, j, is, qmax, retval;
+  CVadjMem ca_mem;
+  int flag, j, is, qmax, retval, nv;
+
+  ca_mem = cv_mem->cv_adj_mem;
 
   if (ck_mem->ck_next == NULL) {
 
@@ -2112,6 +2486,25 @@ static int CVAckpntGet(CVodeMem cv_mem, CkpntMem ck_mem)
     cv_mem->cv_tn        = ck_mem->ck_t0;
     cv_mem->cv_saved_tq5 = ck_mem->ck_saved_tq5;
 
+    for (j=0; j<=L_MAX; j++)        cv_mem->cv_tau[j] = ck_mem->ck_tau[j];
+    for (j=0; j<=NUM_TESTS; j++)    cv_mem->cv_tq[j] = ck_mem->ck_tq[j];
+    for (j=0; j<=cv_mem->cv_q; j++) cv_mem->cv_l[j] = ck_mem->ck_l[j];
+
+    /* Force a call to setup */
+
+    cv_mem->cv_forceSetup = SUNTRUE;
+
+    /* Load the arrays from the check point store */
+
+    if (ck_mem->ck_rec != NULL) {
+      nv = CVAckpntVecs(cv_mem, ck_mem);
+      if (nv < 0) return(CV_MEM_FAIL);
+      retval = SUNAdjStore_Get(ca_mem->ca_ckstore, ck_mem->ck_rec,
+                               ca_mem->ca_ckvecs, nv);
+      if (retval != 0) return(CV_VECTOROP_ERR);
+      return(CV_SUCCESS);
+    }
+
     /* Copy the arrays from check point data structure */
 
     for (j=0; j<=cv_mem->cv_q; j++)
@@ -2184,14 +2577,6 @@ static int CVAckpntGet(CVodeMem cv_mem, CkpntMem ck_mem)
       }
     }
 
-    for (j=0; j<=L_MAX; j++)        cv_mem->cv_tau[j] = ck_mem->ck_tau[j];
-    for (j=0; j<=NUM_TESTS; j++)    cv_mem->cv_tq[j] = ck_mem->ck_tq[j];
-    for (j=0; j<=cv_mem->cv_q; j++) cv_mem->cv_l[j] = ck_mem->ck_l[j];
-
-    /* Force a call to setup */
-
-    cv_mem->cv_forceSetup = SUNTRUE;
-
   }
 
   return(CV_SUCCESS);
@@ -28,6 +28,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "cvodes_impl.h"
 #include <sundials/sundials_types.h>
@@ -76,6 +77,110 @@ int CVodeSetAdjNoSensi(void *cvode_mem)
   return(CV_SUCCESS);
 }
 
+/*
+ * CVodeSetAdjCheckPointStorage
+ *
+ * Selects where the Nordsieck arrays of the check points are kept:
+ * in N_Vectors (CV_CKPNT_MEMORY, the default), in a spill file in
+ * the directory dir (CV_CKPNT_FILE), or compressed (CV_CKPNT_ZLIB).
+ * Must be called before the first call to CVodeF.
+ */
+
+int CVodeSetAdjCheckPointStorage(void *cvode_mem, int storage, const char *dir)
+{
+  CVodeMem cv_mem;
+  CVadjMem ca_mem;
+
+  /* Check if cvode_mem exists */
+  if (cvode_mem == NULL) {
+    cvProcessError(NULL, CV_MEM_NULL, "CVODEA", "CVodeSetAdjCheckPointStorage", MSGCV_NO_MEM);
+    return(CV_MEM_NULL);
+  }
+  cv_mem = (CVodeMem) cvode_mem;
+
+  /* Was ASA initialized? */
+  if (cv_mem->cv_adjMallocDone == SUNFALSE) {
+    cvProcessError(cv_mem, CV_NO_ADJ, "CVODEA", "CVodeSetAdjCheckPointStorage", MSGCV_NO_ADJ);
+    return(CV_NO_ADJ);
+  }
+  ca_mem = cv_mem->cv_adj_mem;
+
+  if ( (storage != CV_CKPNT_MEMORY) && (storage != CV_CKPNT_FILE) &&
+       (storage != CV_CKPNT_ZLIB) ) {
+    cvProcessError(cv_mem, CV_ILL_INPUT, "CVODEA", "CVodeSetAdjCheckPointStorage", MSGCV_BAD_CKSTORE);
+    return(CV_ILL_INPUT);
+  }
+
+  if (!SUNAdjStore_Available(storage)) {
+    cvProcessError(cv_mem, CV_ILL_INPUT, "CVODEA", "CVodeSetAdjCheckPointStorage", MSGCV_BAD_CKSTORE);
+    return(CV_ILL_INPUT);
+  }
+
+  if (!ca_mem->ca_firstCVodeFcall) {
+    cvProcessError(cv_mem, CV_ILL_INPUT, "CVODEA", "CVodeSetAdjCheckPointStorage", MSGCV_CKSTORE_SET);
+    return(CV_ILL_INPUT);
+  }
+
+  /* The store is created in the first call to CVodeF */
+  SUNAdjStore_Destroy(ca_mem->ca_ckstore);
+  ca_mem->ca_ckstore = NULL;
+
+  if (ca_mem->ca_ckstoreDir != NULL) {
+    free(ca_mem->ca_ckstoreDir);
+    ca_mem->ca_ckstoreDir = NULL;
+  }
+
+  if (dir != NULL) {
+    ca_mem->ca_ckstoreDir = (char *) malloc(strlen(dir)+1);
+    if (ca_mem->ca_ckstoreDir == NULL) {
+      cvProcessError(cv_mem, CV_MEM_FAIL, "CVODEA", "CVodeSetAdjCheckPointStorage", MSGCV_MEM_FAIL);
+      return(CV_MEM_FAIL);
+    }
+    strcpy(ca_mem->ca_ckstoreDir, dir);
+  }
+
+  ca_mem->ca_ckstoreType = storage;
+
+  return(CV_SUCCESS);
+}
+
+/*
+ * CVodeSetAdjMaxCheckPoints
+ *
+ * Sets the number of check points CVodeF may keep (0 for no limit).
+ * Above it, CVodeF keeps fewer check points further apart and CVodeB
+ * recomputes the missing ones.
+ */
+
+int CVodeSetAdjMaxCheckPoints(void *cvode_mem, int maxckpnts)
+{
+  CVodeMem cv_mem;
+  CVadjMem ca_mem;
+
+  /* Check if cvode_mem exists */
+  if (cvode_mem == NULL) {
+    cvProcessError(NULL, CV_MEM_NULL, "CVODEA", "CVodeSetAdjMaxCheckPoints", MSGCV_NO_MEM);
+    return(CV_MEM_NULL);
+  }
+  cv_mem = (CVodeMem) cvode_mem;
+
+  /* Was ASA initialized? */
+  if (cv_mem->cv_adjMallocDone == SUNFALSE) {
+    cvProcessError(cv_mem, CV_NO_ADJ, "CVODEA", "CVodeSetAdjMaxCheckPoints", MSGCV_NO_ADJ);
+    return(CV_NO_ADJ);
+  }
+  ca_mem = cv_mem->cv_adj_mem;
+
+  if ( (maxckpnts != 0) && (maxckpnts < 2) ) {
+    cvProcessError(cv_mem, CV_ILL_INPUT, "CVODEA", "CVodeSetAdjMaxCheckPoints", MSGCV_BAD_MAXCKPNTS);
+    return(CV_ILL_INPUT);
+  }
+
+  ca_mem->ca_maxckpnts = maxckpnts;
+
+  return(CV_SUCCESS);
+}
+
 /* 
  * -----------------------------------------------------------------
  * Optional input functions for backward integration
@@ -593,6 +698,13 @@ int CVodeGetAdjCheckPointsInfo(void *cvode_mem, CVadjCheckPointRec *ckpnt)
 
   while (ck_mem != NULL) {
 
+    /* Skip check points recomputed by CVodeB, they are not counted
+       in the number of check points returned by CVodeF */
+    if (ck_mem->ck_temp) {
+      ck_mem = ck_mem->ck_next;
+      continue;
+    }
+
     ckpnt[i].my_addr = (void *) ck_mem;
     ckpnt[i].next_addr = (void *) ck_mem->ck_next;
     ckpnt[i].t0 = ck_mem->ck_t0;
@@ -20,6 +20,7 @@
 #include <stdarg.h>
 
 #include "cvodes/cvodes.h"
+#include "sundials_adjstore.h"
 
 #ifdef __cplusplus  /* wrapper to enable C++ usage */
 extern "C" {
@@ -595,6 +596,13 @@ struct CkpntMemRec {
   /* Saved values */
   realtype ck_saved_tq5;
 
+  /* Record holding the Nordsieck arrays if they were moved to the
+     check point store (the N_Vectors above are then not allocated) */
+  SUNAdjRecord ck_rec;
+
+  /* Was the check point created by CVodeB to split an interval? */
+  booleantype ck_temp;
+
   /* Pointer to next structure in list */
   struct CkpntMemRec *ck_next;
 
@@ -771,6 +779,20 @@ struct CVadjMemRec {
   /* address of the check point structure for which data is available */
   struct CkpntMemRec *ca_ckpntData;
 
+  /* Check point store (NULL if check points are kept in N_Vectors) */
+  int ca_ckstoreType;
+  char *ca_ckstoreDir;
+  SUNAdjStore ca_ckstore;
+
+  /* Workspace with the vectors saved in the check point store */
+  N_Vector *ca_ckvecs;
+  int ca_nckvecs;
+
+  /* Maximum number of check points (0 for no limit) and stride, in
+     units of nsteps, of the check points kept by CVodeF */
+  int ca_maxckpnts;
+  long int ca_ckstride;
+
   /* ------------------
    * Interpolation data
    * ------------------ */
@@ -1183,6 +1205,11 @@ int cvSensRhs1InternalDQ(int Ns, realtype t,
 #define MSGCV_BACK_ERROR  "Error occured while integrating backward problem # %d"
 #define MSGCV_BAD_TINTERP "Bad t = %g for interpolation."
 #define MSGCV_WRONG_INTERP "This function cannot be called for the specified interp type."
+#define MSGCV_BAD_CKSTORE "Illegal value for storage, or the storage type is not available."
+#define MSGCV_CKSTORE_SET "The check point storage cannot be changed after the first call to CVodeF."
+#define MSGCV_CKSTORE_VEC "The N_Vector does not provide the buffer operations needed by the check point storage."
+#define MSGCV_CKSTORE_FAIL "The check point storage could not be created."
+#define MSGCV_BAD_MAXCKPNTS "maxckpnts < 2 illegal."
 
 #ifdef __cplusplus
 }
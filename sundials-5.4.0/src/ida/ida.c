@@ -87,6 +87,7 @@
 #include "ida_impl.h"
 #include <sundials/sundials_math.h>
 #include <sunnonlinsol/sunnonlinsol_newton.h>
+#include "sundials_ensemble.h"
 
 /*
  * =================================================================
@@ -144,6 +145,10 @@
 
 #define ERROR_TEST_FAIL  +7
 
+/* IDAGetDkyBatch constants */
+
+#define DKY_BLOCK        256
+
 /*
  * Control constants for lower-level rootfinding functions
  * -------------------------------------------------------
@@ -229,6 +234,11 @@ static void IDACompleteStep(IDAMem IDA_mem, realtype err_k, realtype err_km1);
 
 int IDAGetSolution(void *ida_mem, realtype t, N_Vector yret, N_Vector ypret);
 
+/* Dense output */
+
+static int IDADkyCheckT(IDAMem IDA_mem, realtype t, const char *fname);
+static void IDADkyCoeffs(IDAMem IDA_mem, realtype t, int k, realtype *cjk);
+
 /* Stopping tests and failure handling */
 
 static int IDAStopTest1(IDAMem IDA_mem, realtype tout,realtype *tret,
@@ -243,6 +253,13 @@ static int IDARcheck1(IDAMem IDA_mem);
 static int IDARcheck2(IDAMem IDA_mem);
 static int IDARcheck3(IDAMem IDA_mem);
 static int IDARootfind(IDAMem IDA_mem);
+static int IDARootScan(IDAMem IDA_mem, realtype *g, booleantype *zroot);
+static int IDARootPass(IDAMem IDA_mem, realtype tmid, realtype dtmax,
+                       int *imax, int *side);
+static int IDARootSample(IDAMem IDA_mem);
+static void IDARootPoint(int p, void *ida_mem);
+static booleantype IDARootPtsAlloc(IDAMem IDA_mem);
+static void IDARootPtsFree(IDAMem IDA_mem);
 
 /*
  * =================================================================
@@ -471,6 +488,12 @@ int IDAInit(void *ida_mem, IDAResFn res,
 
   IDA_mem->ida_nge = 0;
 
+  IDA_mem->ida_nrtiters      = 0;
+  IDA_mem->ida_nge_step      = 0;
+  IDA_mem->ida_nrtiters_step = 0;
+
+  SUNProfile_Reset(&(IDA_mem->ida_profile));
+
   IDA_mem->ida_irfnd = 0;
 
   /* Initialize root-finding variables */
@@ -484,6 +507,9 @@ int IDAInit(void *ida_mem, IDAResFn res,
   IDA_mem->ida_nrtfn   = 0;
   IDA_mem->ida_gactive  = NULL;
   IDA_mem->ida_mxgnull  = 1;
+  IDA_mem->ida_gfrac    = NULL;
+  IDA_mem->ida_nrtpts   = 1;
+  IDA_mem->ida_rtpts_mem = NULL;
 
   /* Initial setup not done yet */
 
@@ -568,6 +594,12 @@ int IDAReInit(void *ida_mem,
 
   IDA_mem->ida_nge = 0;
 
+  IDA_mem->ida_nrtiters      = 0;
+  IDA_mem->ida_nge_step      = 0;
+  IDA_mem->ida_nrtiters_step = 0;
+
+  SUNProfile_Reset(&(IDA_mem->ida_profile));
+
   IDA_mem->ida_irfnd = 0;
 
   /* Initial setup not done yet */
@@ -753,8 +785,10 @@ int IDARootInit(void *ida_mem, int nrtfn, IDARootFn g)
     free(IDA_mem->ida_iroots); IDA_mem->ida_iroots = NULL;
     free(IDA_mem->ida_rootdir); IDA_mem->ida_rootdir = NULL;
     free(IDA_mem->ida_gactive); IDA_mem->ida_gactive = NULL;
+    free(IDA_mem->ida_gfrac); IDA_mem->ida_gfrac = NULL;
+    IDARootPtsFree(IDA_mem);
 
-    IDA_mem->ida_lrw -= 3 * (IDA_mem->ida_nrtfn);
+    IDA_mem->ida_lrw -= 4 * (IDA_mem->ida_nrtfn);
     IDA_mem->ida_liw -= 3 * (IDA_mem->ida_nrtfn);
 
   }
@@ -781,8 +815,10 @@ int IDARootInit(void *ida_mem, int nrtfn, IDARootFn g)
 	free(IDA_mem->ida_iroots); IDA_mem->ida_iroots = NULL;
         free(IDA_mem->ida_rootdir); IDA_mem->ida_rootdir = NULL;
         free(IDA_mem->ida_gactive); IDA_mem->ida_gactive = NULL;
+        free(IDA_mem->ida_gfrac); IDA_mem->ida_gfrac = NULL;
+        IDARootPtsFree(IDA_mem);
 
-        IDA_mem->ida_lrw -= 3*nrt;
+        IDA_mem->ida_lrw -= 4*nrt;
         IDA_mem->ida_liw -= 3*nrt;
 
         IDAProcessError(IDA_mem, IDA_ILL_INPUT, "IDA", "IDARootInit", MSG_ROOT_FUNC_NULL);
@@ -862,13 +898,26 @@ int IDARootInit(void *ida_mem, int nrtfn, IDARootFn g)
     return(IDA_MEM_FAIL);
   }
 
+  IDA_mem->ida_gfrac = NULL;
+  IDA_mem->ida_gfrac = (realtype *) malloc(nrt*sizeof(realtype));
+  if (IDA_mem->ida_gfrac == NULL) {
+    free(IDA_mem->ida_glo); IDA_mem->ida_glo = NULL;
+    free(IDA_mem->ida_ghi); IDA_mem->ida_ghi = NULL;
+    free(IDA_mem->ida_grout); IDA_mem->ida_grout = NULL;
+    free(IDA_mem->ida_iroots); IDA_mem->ida_iroots = NULL;
+    free(IDA_mem->ida_rootdir); IDA_mem->ida_rootdir = NULL;
+    free(IDA_mem->ida_gactive); IDA_mem->ida_gactive = NULL;
+    IDAProcessError(IDA_mem, IDA_MEM_FAIL, "IDA", "IDARootInit", MSG_MEM_FAIL);
+    return(IDA_MEM_FAIL);
+  }
+
   /* Set default values for rootdir (both directions) */
   for(i=0; i<nrt; i++) IDA_mem->ida_rootdir[i] = 0;
 
   /* Set default values for gactive (all active) */
   for(i=0; i<nrt; i++) IDA_mem->ida_gactive[i] = SUNTRUE;
 
-  IDA_mem->ida_lrw += 3*nrt;
+  IDA_mem->ida_lrw += 4*nrt;
   IDA_mem->ida_liw += 3*nrt;
 
   return(IDA_SUCCESS);
@@ -1028,7 +1077,9 @@ int IDASolve(void *ida_mem, realtype tout, realtype *tret,
 
     /* Check for exact zeros of the root functions at or near t0. */
     if (IDA_mem->ida_nrtfn > 0) {
+      SUNDIALS_PROFILE_BEGIN(IDA_mem->ida_profile, SUN_PROFILE_ROOTFIND);
       ier = IDARcheck1(IDA_mem);
+      SUNDIALS_PROFILE_END(IDA_mem->ida_profile, SUN_PROFILE_ROOTFIND);
       if (ier == IDA_RTFUNC_FAIL) {
         IDAProcessError(IDA_mem, IDA_RTFUNC_FAIL, "IDA", "IDARcheck1",
                         MSG_RTFUNC_FAILED, IDA_mem->ida_tn);
@@ -1063,7 +1114,9 @@ int IDASolve(void *ida_mem, realtype tout, realtype *tret,
 
       irfndp = IDA_mem->ida_irfnd;
 
+      SUNDIALS_PROFILE_BEGIN(IDA_mem->ida_profile, SUN_PROFILE_ROOTFIND);
       ier = IDARcheck2(IDA_mem);
+      SUNDIALS_PROFILE_END(IDA_mem->ida_profile, SUN_PROFILE_ROOTFIND);
 
       if (ier == CLOSERT) {
         IDAProcessError(IDA_mem, IDA_ILL_INPUT, "IDA", "IDARcheck2",
@@ -1082,7 +1135,9 @@ int IDASolve(void *ida_mem, realtype tout, realtype *tret,
          check remaining interval for roots */
       troundoff = HUNDRED * IDA_mem->ida_uround * (SUNRabs(IDA_mem->ida_tn) + SUNRabs(IDA_mem->ida_hh));
       if ( SUNRabs(IDA_mem->ida_tn - IDA_mem->ida_tretlast) > troundoff ) {
+        SUNDIALS_PROFILE_BEGIN(IDA_mem->ida_profile, SUN_PROFILE_ROOTFIND);
         ier = IDARcheck3(IDA_mem);
+        SUNDIALS_PROFILE_END(IDA_mem->ida_profile, SUN_PROFILE_ROOTFIND);
         if (ier == IDA_SUCCESS) {     /* no root found */
           IDA_mem->ida_irfnd = 0;
           if ((irfndp == 1) && (itask == IDA_ONE_STEP)) {
@@ -1171,7 +1226,9 @@ int IDASolve(void *ida_mem, realtype tout, realtype *tret,
 
     /* Call IDAStep to take a step. */
 
+    SUNDIALS_PROFILE_BEGIN(IDA_mem->ida_profile, SUN_PROFILE_STEP);
     sflag = IDAStep(IDA_mem);
+    SUNDIALS_PROFILE_END(IDA_mem->ida_profile, SUN_PROFILE_STEP);
 
     /* Process all failed-step cases, and exit loop. */
 
@@ -1184,13 +1241,19 @@ int IDASolve(void *ida_mem, realtype tout, realtype *tret,
 
     nstloc++;
 
+    /* Root finding statistics are reported per step */
+    IDA_mem->ida_nge_step      = IDA_mem->ida_nge;
+    IDA_mem->ida_nrtiters_step = IDA_mem->ida_nrtiters;
+
     /* After successful step, check for stop conditions; continue or break. */
 
     /* First check for root in the last step taken. */
 
     if (IDA_mem->ida_nrtfn > 0) {
 
+      SUNDIALS_PROFILE_BEGIN(IDA_mem->ida_profile, SUN_PROFILE_ROOTFIND);
       ier = IDARcheck3(IDA_mem);
+      SUNDIALS_PROFILE_END(IDA_mem->ida_profile, SUN_PROFILE_ROOTFIND);
 
       if (ier == RTFOUND) {  /* A new root was found */
         IDA_mem->ida_irfnd = 1;
@@ -1261,10 +1324,8 @@ int IDASolve(void *ida_mem, realtype tout, realtype *tret,
 int IDAGetDky(void *ida_mem, realtype t, int k, N_Vector dky)
 {
   IDAMem IDA_mem;
-  realtype tfuzz, tp, delt, psij_1;
-  int i, j, retval;
-  realtype cjk  [MXORDP1];
-  realtype cjk_1[MXORDP1];
+  int retval;
+  realtype cjk[MXORDP1];
 
   /* Check ida_mem */
   if (ida_mem == NULL) {
@@ -1284,72 +1345,130 @@ int IDAGetDky(void *ida_mem, realtype t, int k, N_Vector dky)
   }
 
   /* Check t for legality.  Here tn - hused is t_{n-1}. */
-
-  tfuzz = HUNDRED * IDA_mem->ida_uround * (SUNRabs(IDA_mem->ida_tn) + SUNRabs(IDA_mem->ida_hh));
-  if (IDA_mem->ida_hh < ZERO) tfuzz = - tfuzz;
-  tp = IDA_mem->ida_tn - IDA_mem->ida_hused - tfuzz;
-  if ((t - tp)*IDA_mem->ida_hh < ZERO) {
-    IDAProcessError(IDA_mem, IDA_BAD_T, "IDA", "IDAGetDky", MSG_BAD_T, t,
-                    IDA_mem->ida_tn-IDA_mem->ida_hused, IDA_mem->ida_tn);
+  if (IDADkyCheckT(IDA_mem, t, "IDAGetDky") != IDA_SUCCESS)
     return(IDA_BAD_T);
+
+  SUNDIALS_PROFILE_BEGIN(IDA_mem->ida_profile, SUN_PROFILE_INTERP);
+
+  IDADkyCoeffs(IDA_mem, t, k, cjk);
+
+  /* Compute sum (c_j(t) * phi(t)) */
+
+  /* Sum j=k to j<=IDA_mem->ida_kused */
+  retval = N_VLinearCombination(IDA_mem->ida_kused-k+1, cjk+k,
+                                IDA_mem->ida_phi+k, dky);
+
+  SUNDIALS_PROFILE_END(IDA_mem->ida_profile, SUN_PROFILE_INTERP);
+
+  if (retval != IDA_SUCCESS) return(IDA_VECTOROP_ERR);
+
+  return(IDA_SUCCESS);
+}
+
+/*
+ * IDAGetDkyBatch
+ *
+ * This routine evaluates the k-th derivative of the interpolating
+ * polynomial at each of the ntimes times in times[], as IDAGetDky does,
+ * and stores the results in the caller-supplied array dky, viewed as
+ * an ntimes by N matrix whose row p holds the derivative at times[p].
+ * With layout = IDA_ROW_MAJOR component i at times[p] is stored in
+ * dky[p*N+i], with layout = IDA_COL_MAJOR it is stored in
+ * dky[i*ntimes+p].
+ *
+ * The phi array is traversed once in blocks of DKY_BLOCK components,
+ * and every requested time is evaluated on a block while it is in
+ * cache. The vectors must keep their data in a single local array
+ * (N_VGetArrayPointer), and must not be distributed.
+ *
+ * The return values are those of IDAGetDky, except IDA_VECTOROP_ERR,
+ * and in addition:
+ *   IDA_ILL_INPUT     if ntimes, times or layout is illegal, or the
+ *                     vectors do not meet the requirements above
+ */
+
+int IDAGetDkyBatch(void *ida_mem, int ntimes, realtype *times, int k,
+                   int layout, realtype *dky)
+{
+  IDAMem IDA_mem;
+  realtype cjk[MXORDP1], tmp[DKY_BLOCK];
+  realtype *phid[MXORDP1], *z, *out, cj;
+  sunindextype N, ib, nb, i;
+  int j, p;
+
+  /* Check ida_mem */
+  if (ida_mem == NULL) {
+    IDAProcessError(NULL, IDA_MEM_NULL, "IDA", "IDAGetDkyBatch", MSG_NO_MEM);
+    return (IDA_MEM_NULL);
   }
+  IDA_mem = (IDAMem) ida_mem;
 
-  /* Initialize the c_j^(k) and c_k^(k-1) */
-  for(i=0; i<MXORDP1; i++) {
-    cjk  [i] = 0;
-    cjk_1[i] = 0;
+  if (dky == NULL) {
+    IDAProcessError(IDA_mem, IDA_BAD_DKY, "IDA", "IDAGetDkyBatch", MSG_NULL_DKY);
+    return(IDA_BAD_DKY);
   }
 
-  delt = t-IDA_mem->ida_tn;
+  if ((ntimes < 0) || ((ntimes > 0) && (times == NULL))) {
+    IDAProcessError(IDA_mem, IDA_ILL_INPUT, "IDA", "IDAGetDkyBatch",
+                    MSG_BAD_NTIMES);
+    return(IDA_ILL_INPUT);
+  }
 
-  for(i=0; i<=k; i++) {
+  if ((layout != IDA_ROW_MAJOR) && (layout != IDA_COL_MAJOR)) {
+    IDAProcessError(IDA_mem, IDA_ILL_INPUT, "IDA", "IDAGetDkyBatch",
+                    MSG_BAD_LAYOUT);
+    return(IDA_ILL_INPUT);
+  }
 
-    /* The below reccurence is used to compute the k-th derivative of the solution:
-       c_j^(k) = ( k * c_{j-1}^(k-1) + c_{j-1}^{k} (Delta+psi_{j-1}) ) / psi_j
+  if ((k < 0) || (k > IDA_mem->ida_kused)) {
+    IDAProcessError(IDA_mem, IDA_BAD_K, "IDA", "IDAGetDkyBatch", MSG_BAD_K);
+    return(IDA_BAD_K);
+  }
 
-       Translated in indexes notation:
-       cjk[j] = ( k*cjk_1[j-1] + cjk[j-1]*(delt+psi[j-2]) ) / psi[j-1]
+  for (p=0; p < ntimes; p++)
+    if (IDADkyCheckT(IDA_mem, times[p], "IDAGetDkyBatch") != IDA_SUCCESS)
+      return(IDA_BAD_T);
 
-       For k=0, j=1: c_1 = c_0^(-1) + (delt+psi[-1]) / psi[0]
+  for (j=k; j <= IDA_mem->ida_kused; j++) {
+    phid[j] = N_VGetArrayPointer(IDA_mem->ida_phi[j]);
+    if ((phid[j] == NULL) || (N_VGetCommunicator(IDA_mem->ida_phi[j]) != NULL)) {
+      IDAProcessError(IDA_mem, IDA_ILL_INPUT, "IDA", "IDAGetDkyBatch",
+                      MSG_BAD_DKY_NVECTOR);
+      return(IDA_ILL_INPUT);
+    }
+  }
 
-       In order to be able to deal with k=0 in the same way as for k>0, the
-       following conventions were adopted:
-         - c_0(t) = 1 , c_0^(-1)(t)=0
-         - psij_1 stands for psi[-1]=0 when j=1
-                         for psi[j-2]  when j>1
-    */
-    if(i==0) {
+  if (ntimes == 0) return(IDA_SUCCESS);
 
-      cjk[i] = 1;
-      psij_1 = 0;
-    }else {
-      /*                                                i       i-1          1
-        c_i^(i) can be always updated since c_i^(i) = -----  --------  ... -----
-                                                      psi_j  psi_{j-1}     psi_1
-      */
-      cjk[i] = cjk[i-1]*i / IDA_mem->ida_psi[i-1];
-      psij_1 = IDA_mem->ida_psi[i-1];
-    }
+  SUNDIALS_PROFILE_BEGIN(IDA_mem->ida_profile, SUN_PROFILE_INTERP);
 
-    /* update c_j^(i) */
+  N = N_VGetLength(IDA_mem->ida_phi[0]);
 
-    /*j does not need to go till kused */
-    for(j=i+1; j<=IDA_mem->ida_kused-k+i; j++) {
+  for (ib=0; ib < N; ib += DKY_BLOCK) {
+    nb = SUNMIN(DKY_BLOCK, N-ib);
 
-      cjk[j] = ( i* cjk_1[j-1] + cjk[j-1] * (delt + psij_1) ) / IDA_mem->ida_psi[j-1];
-      psij_1 = IDA_mem->ida_psi[j-1];
-    }
+    for (p=0; p < ntimes; p++) {
 
-    /* save existing c_j^(i)'s */
-    for(j=i+1; j<=IDA_mem->ida_kused-k+i; j++) cjk_1[j] = cjk[j];
-  }
+      IDADkyCoeffs(IDA_mem, times[p], k, cjk);
 
-  /* Compute sum (c_j(t) * phi(t)) */
+      /* Row-major output is written in place, otherwise through tmp */
+      out = (layout == IDA_ROW_MAJOR) ? dky + p*N + ib : tmp;
 
-  /* Sum j=k to j<=IDA_mem->ida_kused */
-  retval = N_VLinearCombination(IDA_mem->ida_kused-k+1, cjk+k,
-                                IDA_mem->ida_phi+k, dky);
-  if (retval != IDA_SUCCESS) return(IDA_VECTOROP_ERR);
+      z  = phid[k] + ib;
+      cj = cjk[k];
+      for (i=0; i < nb; i++) out[i] = cj * z[i];
+      for (j=k+1; j <= IDA_mem->ida_kused; j++) {
+        z  = phid[j] + ib;
+        cj = cjk[j];
+        for (i=0; i < nb; i++) out[i] += cj * z[i];
+      }
+
+      if (layout == IDA_COL_MAJOR)
+        for (i=0; i < nb; i++) dky[(ib+i)*ntimes + p] = tmp[i];
+    }
+  }
+
+  SUNDIALS_PROFILE_END(IDA_mem->ida_profile, SUN_PROFILE_INTERP);
 
   return(IDA_SUCCESS);
 }
@@ -1438,7 +1557,9 @@ void IDAFree(void **ida_mem)
     free(IDA_mem->ida_iroots);  IDA_mem->ida_iroots = NULL;
     free(IDA_mem->ida_rootdir); IDA_mem->ida_rootdir = NULL;
     free(IDA_mem->ida_gactive); IDA_mem->ida_gactive = NULL;
+    free(IDA_mem->ida_gfrac);   IDA_mem->ida_gfrac = NULL;
   }
+  IDARootPtsFree(IDA_mem);
 
   free(*ida_mem);
   *ida_mem = NULL;
@@ -2217,11 +2338,15 @@ static int IDAStep(IDAMem IDA_mem)
     IDAPredict(IDA_mem);
 
     /* Nonlinear system solution */
+    SUNDIALS_PROFILE_BEGIN(IDA_mem->ida_profile, SUN_PROFILE_NLSOLVE);
     nflag = IDANls(IDA_mem);
+    SUNDIALS_PROFILE_END(IDA_mem->ida_profile, SUN_PROFILE_NLSOLVE);
 
     /* If NLS was successful, perform error test */
     if (nflag == IDA_SUCCESS)
+      SUNDIALS_PROFILE_BEGIN(IDA_mem->ida_profile, SUN_PROFILE_ERRTEST);
       nflag = IDATestError(IDA_mem, ck, &err_k, &err_km1);
+      SUNDIALS_PROFILE_END(IDA_mem->ida_profile, SUN_PROFILE_ERRTEST);
 
     /* Test for convergence or error test failures */
     if (nflag != IDA_SUCCESS) {
@@ -2914,6 +3039,8 @@ int IDAGetSolution(void *ida_mem, realtype t, N_Vector yret, N_Vector ypret)
 
   /* Accumulate multiples of columns phi[j] into yret and ypret. */
 
+  SUNDIALS_PROFILE_BEGIN(IDA_mem->ida_profile, SUN_PROFILE_INTERP);
+
   delt = t - IDA_mem->ida_tn;
   c = ONE; d = ZERO;
   gam = delt / IDA_mem->ida_psi[0];
@@ -2930,10 +3057,12 @@ int IDAGetSolution(void *ida_mem, realtype t, N_Vector yret, N_Vector ypret)
 
   retval = N_VLinearCombination(kord+1, IDA_mem->ida_cvals,
                                 IDA_mem->ida_phi,  yret);
-  if (retval != IDA_SUCCESS) return(IDA_VECTOROP_ERR);
+  if (retval == IDA_SUCCESS)
+    retval = N_VLinearCombination(kord, IDA_mem->ida_dvals,
+                                  IDA_mem->ida_phi+1, ypret);
+
+  SUNDIALS_PROFILE_END(IDA_mem->ida_profile, SUN_PROFILE_INTERP);
 
-  retval = N_VLinearCombination(kord, IDA_mem->ida_dvals,
-                                IDA_mem->ida_phi+1, ypret);
   if (retval != IDA_SUCCESS) return(IDA_VECTOROP_ERR);
 
   return(IDA_SUCCESS);
@@ -3186,6 +3315,11 @@ static int IDARcheck3(IDAMem IDA_mem)
  * Defined Output Points for Solutions of ODEs, Sandia National
  * Laboratory Report SAND80-0180, February 1980.
  *
+ * If nrtpts > 1 (see IDASetRootSearchPoints), each pass evaluates g
+ * at nrtpts points at once, see IDARootPass. If g has no sign change
+ * at thi, it is then also evaluated at nrtpts points inside (tlo,thi),
+ * see IDARootSample, so that two roots in one interval may be found.
+ *
  * This routine uses the following parameters for communication:
  *
  * nrtfn    = number of functions g_i, or number of components of
@@ -3252,38 +3386,26 @@ static int IDARcheck3(IDAMem IDA_mem)
 
 static int IDARootfind(IDAMem IDA_mem)
 {
-  realtype alph, tmid, gfrac, maxfrac, fracint, fracsub;
+  realtype alph, tmid, tprev, dtmax, fracint, fracsub;
   int i, retval, imax, side, sideprev;
-  booleantype zroot, sgnchg;
-
-  imax = 0;
+  booleantype zroot;
 
   /* First check for change in sign in ghi or for a zero in ghi. */
-  maxfrac = ZERO;
-  zroot = SUNFALSE;
-  sgnchg = SUNFALSE;
-  for (i = 0;  i < IDA_mem->ida_nrtfn; i++) {
-    if(!IDA_mem->ida_gactive[i]) continue;
-    if (SUNRabs(IDA_mem->ida_ghi[i]) == ZERO) {
-      if(IDA_mem->ida_rootdir[i] * IDA_mem->ida_glo[i] <= ZERO) {
-        zroot = SUNTRUE;
-      }
-    } else {
-      if ( (IDA_mem->ida_glo[i] * IDA_mem->ida_ghi[i] < ZERO) &&
-           (IDA_mem->ida_rootdir[i] * IDA_mem->ida_glo[i] <= ZERO) ) {
-        gfrac = SUNRabs(IDA_mem->ida_ghi[i] / (IDA_mem->ida_ghi[i] - IDA_mem->ida_glo[i]));
-        if (gfrac > maxfrac) {
-          sgnchg = SUNTRUE;
-          maxfrac = gfrac;
-          imax = i;
-        }
-      }
-    }
+  imax = IDARootScan(IDA_mem, IDA_mem->ida_ghi, &zroot);
+
+  /* With several points per pass, look for a sign change or a zero
+     inside (tlo,thi) as well. If one is found, thi is moved there. */
+  if (imax < 0 && !zroot && IDA_mem->ida_nrtpts > 1 &&
+      IDARootPtsAlloc(IDA_mem)) {
+    IDA_mem->ida_nrtiters++;
+    retval = IDARootSample(IDA_mem);
+    if (retval == IDA_RTFUNC_FAIL) return(IDA_RTFUNC_FAIL);
+    imax = IDARootScan(IDA_mem, IDA_mem->ida_ghi, &zroot);
   }
 
   /* If no sign change was found, reset trout and grout.  Then return
      IDA_SUCCESS if no zero was found, or set iroots and return RTFOUND.  */
-  if (!sgnchg) {
+  if (imax < 0) {
     IDA_mem->ida_trout = IDA_mem->ida_thi;
     for (i = 0; i < IDA_mem->ida_nrtfn; i++)
       IDA_mem->ida_grout[i] = IDA_mem->ida_ghi[i];
@@ -3298,8 +3420,9 @@ static int IDARootfind(IDAMem IDA_mem)
     return(RTFOUND);
   }
 
-  /* Initialize alph to avoid compiler warning */
+  /* Initialize alph and tprev to avoid compiler warning */
   alph = ONE;
+  tprev = IDA_mem->ida_tlo;
 
   /* A sign change was found.  Loop to locate nearest root. */
 
@@ -3318,9 +3441,11 @@ static int IDARootfind(IDAMem IDA_mem)
        If the sides were the same, then double alph (if high side),
        or halve alph (if low side).
        The next guess tmid is the secant method value if alph = 1, but
-       is closer to tlo if alph < 1, and closer to thi if alph > 1.    */
+       is closer to tlo if alph < 1, and closer to thi if alph > 1.
+       A pass at several points that moved both ends (side = 0) also
+       resets alph = 1. */
 
-    if (sideprev == side) {
+    if (side != 0 && sideprev == side) {
       alph = (side == 2) ? alph*TWO : alph*HALF;
     } else {
       alph = ONE;
@@ -3342,6 +3467,26 @@ static int IDARootfind(IDAMem IDA_mem)
       tmid = IDA_mem->ida_thi - fracsub*(IDA_mem->ida_thi - IDA_mem->ida_tlo);
     }
 
+    /* The change in tmid from the previous pass estimates the error
+       in tmid (this is used by passes at several points only). */
+    dtmax = (sideprev < 0) ? IDA_mem->ida_thi - IDA_mem->ida_tlo :
+      SUNRabs(tmid - tprev);
+    tprev = tmid;
+
+    IDA_mem->ida_nrtiters++;
+    sideprev = side;
+
+    /* Evaluate g at tmid and at further points in (tlo,thi) at once */
+    if (IDA_mem->ida_nrtpts > 1 && IDARootPtsAlloc(IDA_mem)) {
+      retval = IDARootPass(IDA_mem, tmid, dtmax, &imax, &side);
+      if (retval == IDA_RTFUNC_FAIL) return(IDA_RTFUNC_FAIL);
+      /* Stop at a zero of g at thi, or at root thi if converged */
+      if (retval == RTFOUND) break;
+      if (SUNRabs(IDA_mem->ida_thi - IDA_mem->ida_tlo) <= IDA_mem->ida_ttol)
+        break;
+      continue;
+    }
+
     (void) IDAGetSolution(IDA_mem, tmid, IDA_mem->ida_yy, IDA_mem->ida_yp);
     retval = IDA_mem->ida_gfun(tmid, IDA_mem->ida_yy, IDA_mem->ida_yp,
                                IDA_mem->ida_grout, IDA_mem->ida_user_data);
@@ -3350,30 +3495,10 @@ static int IDARootfind(IDAMem IDA_mem)
 
     /* Check to see in which subinterval g changes sign, and reset imax.
        Set side = 1 if sign change is on low side, or 2 if on high side.  */
-    maxfrac = ZERO;
-    zroot = SUNFALSE;
-    sgnchg = SUNFALSE;
-    sideprev = side;
-    for (i = 0;  i < IDA_mem->ida_nrtfn; i++) {
-      if(!IDA_mem->ida_gactive[i]) continue;
-      if (SUNRabs(IDA_mem->ida_grout[i]) == ZERO) {
-        if(IDA_mem->ida_rootdir[i] * IDA_mem->ida_glo[i] <= ZERO)
-          zroot = SUNTRUE;
-      } else {
-        if ( (IDA_mem->ida_glo[i] * IDA_mem->ida_grout[i] < ZERO) &&
-             (IDA_mem->ida_rootdir[i] * IDA_mem->ida_glo[i] <= ZERO) ) {
-          gfrac = SUNRabs(IDA_mem->ida_grout[i] /
-                          (IDA_mem->ida_grout[i] - IDA_mem->ida_glo[i]));
-          if (gfrac > maxfrac) {
-            sgnchg = SUNTRUE;
-            maxfrac = gfrac;
-            imax = i;
-          }
-        }
-      }
-    }
-    if (sgnchg) {
+    i = IDARootScan(IDA_mem, IDA_mem->ida_grout, &zroot);
+    if (i >= 0) {
       /* Sign change found in (tlo,tmid); replace thi with tmid. */
+      imax = i;
       IDA_mem->ida_thi = tmid;
       for (i = 0; i < IDA_mem->ida_nrtfn; i++)
         IDA_mem->ida_ghi[i] = IDA_mem->ida_grout[i];
@@ -3420,6 +3545,387 @@ static int IDARootfind(IDAMem IDA_mem)
   return(RTFOUND);
 }
 
+/*
+ * IDARootScan
+ *
+ * This routine compares the array g with glo, for the components
+ * that are active and whose direction agrees with rootdir. It sets
+ * gfrac[i] = |g_i/(g_i - glo_i)| > 0 if g_i changed sign, -1 if g_i
+ * is zero and 0 otherwise. The first loop has no branches, so that
+ * it is vectorized for a large number of functions g_i.
+ *
+ * This routine returns the index of the largest gfrac[i], which is
+ * the component whose secant estimate of the root is nearest to tlo,
+ * or -1 if no g_i changed sign. zroot is set if some g_i is zero.
+ */
+
+static int IDARootScan(IDAMem IDA_mem, realtype *g, booleantype *zroot)
+{
+  int i, imax, nrt, chg, zero, ok;
+  int *rootdir;
+  booleantype *gactive;
+  realtype *glo, *gfrac, maxfrac, den;
+
+  nrt     = IDA_mem->ida_nrtfn;
+  rootdir = IDA_mem->ida_rootdir;
+  gactive = IDA_mem->ida_gactive;
+  glo     = IDA_mem->ida_glo;
+  gfrac   = IDA_mem->ida_gfrac;
+
+  for (i = 0; i < nrt; i++) {
+    ok   = (gactive[i] != 0) & (rootdir[i]*glo[i] <= ZERO);
+    zero = ok & (g[i] == ZERO);
+    chg  = ok & (glo[i]*g[i] < ZERO);
+    den  = chg ? (g[i] - glo[i]) : ONE;
+    gfrac[i] = chg ? SUNRabs(g[i]/den) : (zero ? -ONE : ZERO);
+  }
+
+  imax = -1;
+  maxfrac = ZERO;
+  *zroot = SUNFALSE;
+  for (i = 0; i < nrt; i++) {
+    if (gfrac[i] > maxfrac) {
+      maxfrac = gfrac[i];
+      imax = i;
+    }
+    if (gfrac[i] < ZERO) *zroot = SUNTRUE;
+  }
+
+  return(imax);
+}
+
+/*
+ * IDARootPass
+ *
+ * This routine does one pass of IDARootfind at nrtpts points: tmid and
+ * nrtpts-1 points around it, see below. The values of g at the points
+ * are computed at once (on several threads if SUNDIALS is built with
+ * SUNDIALS_ENSEMBLE_OPENMP), and the interval is reduced to the
+ * subinterval between the last point without and the first point with
+ * a sign change or a zero in g.
+ *
+ * On return, imax is the component to use for the next secant step
+ * and side is 1 if only thi was moved, 2 if only tlo was moved and 0
+ * if both were moved.
+ *
+ * This routine returns an int equal to:
+ *      IDA_RTFUNC_FAIL < 0 if the g function failed, or
+ *      RTFOUND         = 1 if g is zero (with no sign change) at thi, or
+ *      IDA_SUCCESS     = 0 otherwise.
+ */
+
+static int IDARootPass(IDAMem IDA_mem, realtype tmid, realtype dtmax,
+                       int *imax, int *side)
+{
+  IDARootPtsMem pts_mem;
+  int i, k, n, p, npts, nd, nrt;
+  realtype dt, fmid, frac, h, hmax, r, dir, *g;
+  booleantype zroot;
+
+  pts_mem = IDA_mem->ida_rtpts_mem;
+  npts = pts_mem->npts;
+  nrt  = IDA_mem->ida_nrtfn;
+
+  /* Set the points: tmid and points at distances h, h*r, h*r^2, ...
+     on both sides of tmid, growing from h = ttol/2 to dtmax, the
+     estimated error in tmid. A good secant estimate tmid is thus
+     bracketed within ttol at once, and a poor one within its error.
+     Distances are used first on the side where the previous pass
+     found the sign change (below tmid unless tlo was moved). Points
+     outside of (tlo,thi) are dropped and the others are sorted from
+     tlo to thi. */
+  dt = IDA_mem->ida_thi - IDA_mem->ida_tlo;
+  h  = HALF*IDA_mem->ida_ttol/SUNRabs(dt);
+  hmax = SUNMIN(SUNRabs(dtmax/dt), ONE);
+  nd = npts/2;
+  r  = (nd > 1 && h < hmax) ? SUNRpowerR(hmax/h, ONE/(nd-1)) : ONE;
+  dir = (*side == 2) ? ONE : -ONE;
+
+  fmid = (tmid - IDA_mem->ida_tlo)/dt;
+  pts_mem->tpts[0] = fmid;
+  n = 1;
+  for (k = 1; k < npts; k++) {
+    frac = fmid + ((k % 2) ? dir : -dir)*h;
+    if (k % 2 == 0) h *= r;
+    if (frac <= ZERO || frac >= ONE) continue;
+    for (p = n; p > 0 && pts_mem->tpts[p-1] > frac; p--)
+      pts_mem->tpts[p] = pts_mem->tpts[p-1];
+    pts_mem->tpts[p] = frac;
+    n++;
+  }
+  for (p = 0; p < n; p++)
+    pts_mem->tpts[p] = (pts_mem->tpts[p] == fmid) ?
+      tmid : IDA_mem->ida_tlo + pts_mem->tpts[p]*dt;
+
+  /* Interpolate y and y' at all points (this uses the workspace in
+     IDA_mem), then evaluate g at all points at once. */
+  for (p = 0; p < n; p++)
+    (void) IDAGetSolution(IDA_mem, pts_mem->tpts[p], pts_mem->yypts[p],
+                          pts_mem->yppts[p]);
+
+  SUNEnsemble_Run(n, n, IDARootPoint, (void *) IDA_mem);
+  IDA_mem->ida_nge += n;
+
+  for (p = 0; p < n; p++)
+    if (pts_mem->flags[p] != 0) return(IDA_RTFUNC_FAIL);
+
+  /* Find the first point with a sign change or a zero */
+  for (p = 0; p < n; p++) {
+    i = IDARootScan(IDA_mem, pts_mem->gpts + p*nrt, &zroot);
+    if (i >= 0 || zroot) break;
+  }
+
+  /* The sign change is in (tlo,thi) for the new tlo = tpts[p-1] and
+     thi = tpts[p] (tlo is not moved if p = 0 and thi is not moved if
+     p = n). The nearest root is then found again for the new tlo. */
+  if (p > 0) {
+    g = pts_mem->gpts + (p-1)*nrt;
+    IDA_mem->ida_tlo = pts_mem->tpts[p-1];
+    for (i = 0; i < nrt; i++) IDA_mem->ida_glo[i] = g[i];
+  }
+  if (p < n) {
+    g = pts_mem->gpts + p*nrt;
+    IDA_mem->ida_thi = pts_mem->tpts[p];
+    for (i = 0; i < nrt; i++) IDA_mem->ida_ghi[i] = g[i];
+  }
+
+  *side = (p == 0) ? 1 : ((p == n) ? 2 : 0);
+
+  i = IDARootScan(IDA_mem, IDA_mem->ida_ghi, &zroot);
+  if (i < 0) return(RTFOUND);
+
+  *imax = i;
+  return(IDA_SUCCESS);
+}
+
+/*
+ * IDARootSample
+ *
+ * This routine evaluates g at nrtpts points evenly spaced inside
+ * (tlo,thi), at once as in IDARootPass. It is used when g has no sign
+ * change at thi, to find roots that come in pairs within the interval
+ * (e.g. g_i crosses zero and back within one step). thi is moved to
+ * the first point with a sign change or a zero in g, if any.
+ *
+ * This routine returns an int equal to:
+ *      IDA_RTFUNC_FAIL < 0 if the g function failed, or
+ *      IDA_SUCCESS     = 0 otherwise.
+ */
+
+static int IDARootSample(IDAMem IDA_mem)
+{
+  IDARootPtsMem pts_mem;
+  int i, p, n, nrt;
+  realtype dt, *g;
+  booleantype zroot;
+
+  pts_mem = IDA_mem->ida_rtpts_mem;
+  n   = pts_mem->npts;
+  nrt = IDA_mem->ida_nrtfn;
+
+  dt = (IDA_mem->ida_thi - IDA_mem->ida_tlo)/(n + 1);
+  for (p = 0; p < n; p++) {
+    pts_mem->tpts[p] = IDA_mem->ida_tlo + (p + 1)*dt;
+    (void) IDAGetSolution(IDA_mem, pts_mem->tpts[p], pts_mem->yypts[p],
+                          pts_mem->yppts[p]);
+  }
+
+  SUNEnsemble_Run(n, n, IDARootPoint, (void *) IDA_mem);
+  IDA_mem->ida_nge += n;
+
+  for (p = 0; p < n; p++)
+    if (pts_mem->flags[p] != 0) return(IDA_RTFUNC_FAIL);
+
+  for (p = 0; p < n; p++) {
+    g = pts_mem->gpts + p*nrt;
+    if (IDARootScan(IDA_mem, g, &zroot) >= 0 || zroot) {
+      IDA_mem->ida_thi = pts_mem->tpts[p];
+      for (i = 0; i < nrt; i++) IDA_mem->ida_ghi[i] = g[i];
+      break;
+    }
+  }
+
+  return(IDA_SUCCESS);
+}
+
+/*
+ * IDARootPoint
+ *
+ * Evaluates g at the point p of a pass of IDARootPass.
+ */
+
+static void IDARootPoint(int p, void *ida_mem)
+{
+  IDAMem IDA_mem;
+  IDARootPtsMem pts_mem;
+
+  IDA_mem = (IDAMem) ida_mem;
+  pts_mem = IDA_mem->ida_rtpts_mem;
+
+  pts_mem->flags[p] = IDA_mem->ida_gfun(pts_mem->tpts[p], pts_mem->yypts[p],
+                                        pts_mem->yppts[p],
+                                        pts_mem->gpts + p*IDA_mem->ida_nrtfn,
+                                        IDA_mem->ida_user_data);
+}
+
+/*
+ * IDARootPtsAlloc
+ *
+ * Allocates the workspace of IDARootPass for nrtpts points, if not
+ * done yet. If the allocation fails, IDARootfind uses one point.
+ */
+
+static booleantype IDARootPtsAlloc(IDAMem IDA_mem)
+{
+  IDARootPtsMem pts_mem;
+  int npts;
+
+  npts = IDA_mem->ida_nrtpts;
+
+  if (IDA_mem->ida_rtpts_mem != NULL) {
+    if (IDA_mem->ida_rtpts_mem->npts == npts) return(SUNTRUE);
+    IDARootPtsFree(IDA_mem);
+  }
+
+  pts_mem = (IDARootPtsMem) malloc(sizeof(struct IDARootPtsMemRec));
+  if (pts_mem == NULL) return(SUNFALSE);
+
+  pts_mem->npts  = npts;
+  pts_mem->tpts  = (realtype *) malloc(npts*sizeof(realtype));
+  pts_mem->gpts  = (realtype *) malloc(npts*IDA_mem->ida_nrtfn*sizeof(realtype));
+  pts_mem->flags = (int *) malloc(npts*sizeof(int));
+  pts_mem->yypts = N_VCloneVectorArray(npts, IDA_mem->ida_ewt);
+  pts_mem->yppts = N_VCloneVectorArray(npts, IDA_mem->ida_ewt);
+
+  IDA_mem->ida_rtpts_mem = pts_mem;
+
+  if (pts_mem->tpts == NULL || pts_mem->gpts == NULL ||
+      pts_mem->flags == NULL || pts_mem->yypts == NULL ||
+      pts_mem->yppts == NULL) {
+    IDARootPtsFree(IDA_mem);
+    return(SUNFALSE);
+  }
+
+  return(SUNTRUE);
+}
+
+/*
+ * IDARootPtsFree
+ *
+ * Frees the workspace of IDARootPass.
+ */
+
+static void IDARootPtsFree(IDAMem IDA_mem)
+{
+  IDARootPtsMem pts_mem;
+
+  pts_mem = IDA_mem->ida_rtpts_mem;
+  if (pts_mem == NULL) return;
+
+  if (pts_mem->yypts != NULL) N_VDestroyVectorArray(pts_mem->yypts, pts_mem->npts);
+  if (pts_mem->yppts != NULL) N_VDestroyVectorArray(pts_mem->yppts, pts_mem->npts);
+  free(pts_mem->tpts);
+  free(pts_mem->gpts);
+  free(pts_mem->flags);
+  free(pts_mem);
+  IDA_mem->ida_rtpts_mem = NULL;
+}
+
+/*
+ * =================================================================
+ * Dense output helper functions
+ * =================================================================
+ */
+
+/*
+ * IDADkyCheckT
+ *
+ * This routine checks that t is not behind t_{n-1} = tn - hused, in
+ * the direction of integration, allowing for some slack. If it is, an
+ * error is reported on behalf of fname and IDA_BAD_T is returned.
+ */
+
+static int IDADkyCheckT(IDAMem IDA_mem, realtype t, const char *fname)
+{
+  realtype tfuzz, tp;
+
+  tfuzz = HUNDRED * IDA_mem->ida_uround * (SUNRabs(IDA_mem->ida_tn) + SUNRabs(IDA_mem->ida_hh));
+  if (IDA_mem->ida_hh < ZERO) tfuzz = - tfuzz;
+  tp = IDA_mem->ida_tn - IDA_mem->ida_hused - tfuzz;
+  if ((t - tp)*IDA_mem->ida_hh < ZERO) {
+    IDAProcessError(IDA_mem, IDA_BAD_T, "IDA", fname, MSG_BAD_T, t,
+                    IDA_mem->ida_tn-IDA_mem->ida_hused, IDA_mem->ida_tn);
+    return(IDA_BAD_T);
+  }
+
+  return(IDA_SUCCESS);
+}
+
+/*
+ * IDADkyCoeffs
+ *
+ * This routine computes the coefficients cjk[k], ..., cjk[kused] of
+ * phi[k], ..., phi[kused] in the k-th derivative of the interpolating
+ * polynomial at t.
+ */
+
+static void IDADkyCoeffs(IDAMem IDA_mem, realtype t, int k, realtype *cjk)
+{
+  realtype delt, psij_1;
+  int i, j;
+  realtype cjk_1[MXORDP1];
+
+  /* Initialize the c_j^(k) and c_k^(k-1) */
+  for(i=0; i<MXORDP1; i++) {
+    cjk  [i] = 0;
+    cjk_1[i] = 0;
+  }
+
+  delt = t-IDA_mem->ida_tn;
+
+  for(i=0; i<=k; i++) {
+
+    /* The below reccurence is used to compute the k-th derivative of the solution:
+       c_j^(k) = ( k * c_{j-1}^(k-1) + c_{j-1}^{k} (Delta+psi_{j-1}) ) / psi_j
+
+       Translated in indexes notation:
+       cjk[j] = ( k*cjk_1[j-1] + cjk[j-1]*(delt+psi[j-2]) ) / psi[j-1]
+
+       For k=0, j=1: c_1 = c_0^(-1) + (delt+psi[-1]) / psi[0]
+
+       In order to be able to deal with k=0 in the same way as for k>0, the
+       following conventions were adopted:
+         - c_0(t) = 1 , c_0^(-1)(t)=0
+         - psij_1 stands for psi[-1]=0 when j=1
+                         for psi[j-2]  when j>1
+    */
+    if(i==0) {
+
+      cjk[i] = 1;
+      psij_1 = 0;
+    }else {
+      /*                                                i       i-1          1
+        c_i^(i) can be always updated since c_i^(i) = -----  --------  ... -----
+                                                      psi_j  psi_{j-1}     psi_1
+      */
+      cjk[i] = cjk[i-1]*i / IDA_mem->ida_psi[i-1];
+      psij_1 = IDA_mem->ida_psi[i-1];
+    }
+
+    /* update c_j^(i) */
+
+    /*j does not need to go till kused */
+    for(j=i+1; j<=IDA_mem->ida_kused-k+i; j++) {
+
+      cjk[j] = ( i* cjk_1[j-1] + cjk[j-1] * (delt + psij_1) ) / IDA_mem->ida_psi[j-1];
+      psij_1 = IDA_mem->ida_psi[j-1];
+    }
+
+    /* save existing c_j^(i)'s */
+    for(j=i+1; j<=IDA_mem->ida_kused-k+i; j++) cjk_1[j] = cjk[j];
+  }
+}
+
 /*
  * =================================================================
  * IDA error message handling functions
@@ -0,0 +1,98 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2020, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the implementation file for the ensemble driver of IDA,
+ * which advances a number of independent IDA problems to the same
+ * output time on several threads.
+ * -----------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ida_impl.h"
+#include "sundials_ensemble.h"
+
+/* Arguments of IDASolve shared by all members */
+typedef struct _IDAEnsembleArgs {
+  void **mems;
+  realtype tout;
+  realtype *tret;
+  N_Vector *yret;
+  N_Vector *ypret;
+  int itask;
+  int *flags;
+} *IDAEnsembleArgs;
+
+static void IDAEnsembleMember(int k, void *user_data)
+{
+  IDAEnsembleArgs args = (IDAEnsembleArgs) user_data;
+
+  args->flags[k] = IDASolve(args->mems[k], args->tout, &(args->tret[k]),
+                            args->yret[k], args->ypret[k], args->itask);
+}
+
+/*
+ * IDAEnsemble
+ *
+ * Calls IDASolve(ida_mems[k], tout, &tret[k], yret[k], ypret[k], itask)
+ * for each of the nmembers members on up to nthreads threads and
+ * stores the return value in flags[k]. The members must not share any
+ * memory they write to (vectors, matrices, linear or nonlinear solvers)
+ * and their user-supplied functions must be thread safe. A member that
+ * fails does not stop the others.
+ *
+ * The return value is IDA_SUCCESS if no member failed, the flag of the
+ * failed member with the smallest index otherwise, or IDA_MEM_NULL or
+ * IDA_ILL_INPUT if the input is illegal (in which case no member is
+ * advanced).
+ */
+
+int IDAEnsemble(void **ida_mems, int nmembers, realtype tout, realtype *tret,
+                N_Vector *yret, N_Vector *ypret, int itask, int nthreads,
+                int *flags)
+{
+  struct _IDAEnsembleArgs args;
+  int k;
+
+  if (ida_mems == NULL) {
+    IDAProcessError(NULL, IDA_MEM_NULL, "IDA", "IDAEnsemble", MSG_NO_MEM);
+    return(IDA_MEM_NULL);
+  }
+
+  if (nmembers < 1 || nthreads < 1 || tret == NULL || yret == NULL ||
+      ypret == NULL || flags == NULL) {
+    IDAProcessError(NULL, IDA_ILL_INPUT, "IDA", "IDAEnsemble",
+                    MSG_BAD_ENSEMBLE);
+    return(IDA_ILL_INPUT);
+  }
+
+  for (k=0; k<nmembers; k++) {
+    if (ida_mems[k] == NULL) {
+      IDAProcessError(NULL, IDA_MEM_NULL, "IDA", "IDAEnsemble", MSG_NO_MEM);
+      return(IDA_MEM_NULL);
+    }
+  }
+
+  args.mems  = ida_mems;
+  args.tout  = tout;
+  args.tret  = tret;
+  args.yret  = yret;
+  args.ypret = ypret;
+  args.itask = itask;
+  args.flags = flags;
+
+  SUNEnsemble_Run(nmembers, nthreads, IDAEnsembleMember, (void *) &args);
+
+  for (k=0; k<nmembers; k++)
+    if (flags[k] < 0) return(flags[k]);
+
+  return(IDA_SUCCESS);
+}
@@ -304,9 +304,11 @@ static int IDAnlsIC (IDAMem IDA_mem)
   tv2 = IDA_mem->ida_tempv2;
   tv3 = IDA_mem->ida_phi[2];
 
+  SUNDIALS_PROFILE_BEGIN(IDA_mem->ida_profile, SUN_PROFILE_RHS);
   retval = IDA_mem->ida_res(IDA_mem->ida_t0, IDA_mem->ida_yy0,
                             IDA_mem->ida_yp0, IDA_mem->ida_delta,
                             IDA_mem->ida_user_data);
+  SUNDIALS_PROFILE_END(IDA_mem->ida_profile, SUN_PROFILE_RHS);
   IDA_mem->ida_nre++;
   if(retval < 0) return(IDA_RES_FAIL);
   if(retval > 0) return(IDA_FIRST_RES_FAIL);
@@ -320,9 +322,11 @@ static int IDAnlsIC (IDAMem IDA_mem)
     /* If there is a setup routine, call it. */
     if(IDA_mem->ida_lsetup) {
       IDA_mem->ida_nsetups++;
+      SUNDIALS_PROFILE_BEGIN(IDA_mem->ida_profile, SUN_PROFILE_LSETUP);
       retval = IDA_mem->ida_lsetup(IDA_mem, IDA_mem->ida_yy0,
                                    IDA_mem->ida_yp0, IDA_mem->ida_delta,
                                    tv1, tv2, tv3);
+      SUNDIALS_PROFILE_END(IDA_mem->ida_profile, SUN_PROFILE_LSETUP);
       if(retval < 0) return(IDA_LSETUP_FAIL);
       if(retval > 0) return(IC_FAIL_RECOV);
     }
@@ -380,9 +384,11 @@ static int IDANewtonIC(IDAMem IDA_mem)
   IDA_mem->ida_delnew = IDA_mem->ida_phi[2];
 
   /* Call the linear solve function to get the Newton step, delta. */
+  SUNDIALS_PROFILE_BEGIN(IDA_mem->ida_profile, SUN_PROFILE_LSOLVE);
   retval = IDA_mem->ida_lsolve(IDA_mem, IDA_mem->ida_delta,
                                IDA_mem->ida_ewt, IDA_mem->ida_yy0,
                                IDA_mem->ida_yp0, IDA_mem->ida_savres);
+  SUNDIALS_PROFILE_END(IDA_mem->ida_profile, SUN_PROFILE_LSOLVE);
   if(retval < 0) return(IDA_LSOLVE_FAIL);
   if(retval > 0) return(IC_FAIL_RECOV);
 
@@ -551,9 +557,11 @@ static int IDAfnorm(IDAMem IDA_mem, realtype *fnorm)
   int retval;
 
   /* Get residual vector F, return if failed, and save F in savres. */
+  SUNDIALS_PROFILE_BEGIN(IDA_mem->ida_profile, SUN_PROFILE_RHS);
   retval = IDA_mem->ida_res(IDA_mem->ida_t0, IDA_mem->ida_ynew,
                             IDA_mem->ida_ypnew, IDA_mem->ida_delnew,
                             IDA_mem->ida_user_data);
+  SUNDIALS_PROFILE_END(IDA_mem->ida_profile, SUN_PROFILE_RHS);
   IDA_mem->ida_nre++;
   if(retval < 0) return(IDA_RES_FAIL);
   if(retval > 0) return(IC_FAIL_RECOV);
@@ -561,9 +569,11 @@ static int IDAfnorm(IDAMem IDA_mem, realtype *fnorm)
   N_VScale(ONE, IDA_mem->ida_delnew, IDA_mem->ida_savres);
 
   /* Call the linear solve function to get J-inverse F; return if failed. */
+  SUNDIALS_PROFILE_BEGIN(IDA_mem->ida_profile, SUN_PROFILE_LSOLVE);
   retval = IDA_mem->ida_lsolve(IDA_mem, IDA_mem->ida_delnew,
                                IDA_mem->ida_ewt, IDA_mem->ida_ynew,
                                IDA_mem->ida_ypnew, IDA_mem->ida_savres);
+  SUNDIALS_PROFILE_END(IDA_mem->ida_profile, SUN_PROFILE_LSOLVE);
   if(retval < 0) return(IDA_LSOLVE_FAIL);
   if(retval > 0) return(IC_FAIL_RECOV);
 
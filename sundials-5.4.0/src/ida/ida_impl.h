@@ -22,6 +22,7 @@
 #include <stdarg.h>
 
 #include "ida/ida.h"
+#include "sundials_profile_impl.h"
 
 #ifdef __cplusplus  /* wrapper to enable C++ usage */
 extern "C" {
@@ -50,6 +51,24 @@ extern "C" {
 #define IDA_CONSTR_RECVR    +5
 #define IDA_NLS_SETUP_RECVR +6
 
+/*
+ * ----------------------------------------------------------------
+ * Types: struct IDARootPtsMemRec, IDARootPtsMem
+ * ----------------------------------------------------------------
+ * Workspace for the root search passes that evaluate g at several
+ * points at once (see IDASetRootSearchPoints).
+ * ----------------------------------------------------------------
+ */
+
+typedef struct IDARootPtsMemRec {
+  int npts;          /* number of points the arrays below hold    */
+  realtype *tpts;    /* points of a root search pass              */
+  realtype *gpts;    /* g values at the points (npts*nrtfn)       */
+  N_Vector *yypts;   /* y values at the points                    */
+  N_Vector *yppts;   /* y' values at the points                   */
+  int *flags;        /* return values of g at the points          */
+} *IDARootPtsMem;
+
 /*
  * ----------------------------------------------------------------
  * Types: struct IDAMemRec, IDAMem
@@ -280,6 +299,16 @@ typedef struct IDAMemRec {
   long int ida_nge;         /* counter for g evaluations                       */
   booleantype *ida_gactive; /* array with active/inactive event functions      */
   int ida_mxgnull;          /* number of warning messages about possible g==0  */
+  realtype *ida_gfrac;      /* array of sign change fractions of a root scan   */
+  int ida_nrtpts;           /* number of g evaluations per root search pass    */
+  IDARootPtsMem ida_rtpts_mem; /* workspace for several g evaluations         */
+  long int ida_nrtiters;    /* counter for root search passes                  */
+  long int ida_nge_step;    /* value of nge when the last step was taken       */
+  long int ida_nrtiters_step; /* value of nrtiters when the last step was taken */
+
+  /* Profiling */
+
+  SUNProfile ida_profile;   /* phase timers, if built with profiling         */
 
   /* Arrays for Fused Vector Operations */
 
@@ -452,6 +481,7 @@ int idaNlsInit(IDAMem IDA_mem);
 #define MSG_NO_MEM         "ida_mem = NULL illegal."
 #define MSG_NO_MALLOC      "Attempt to call before IDAMalloc."
 #define MSG_BAD_NVECTOR    "A required vector operation is not implemented."
+#define MSG_BAD_ENSEMBLE   "Illegal ensemble input: nmembers < 1, nthreads < 1 or a NULL array."
 
 /* Initialization errors */
 
@@ -508,6 +538,9 @@ int idaNlsInit(IDAMem IDA_mem);
 #define MSG_BAD_K          "Illegal value for k."
 #define MSG_NULL_DKY       "dky = NULL illegal."
 #define MSG_BAD_T          "Illegal value for t." MSG_TIME_INT
+#define MSG_BAD_NTIMES     "ntimes < 0 or times = NULL illegal."
+#define MSG_BAD_LAYOUT     "Illegal value for layout."
+#define MSG_BAD_DKY_NVECTOR "The batch dense output requires node-local vectors with an array pointer."
 #define MSG_BAD_TOUT       "Trouble interpolating at " MSG_TIME_TOUT ". tout too far back in direction of integration."
 
 #define MSG_ERR_FAILS        "At " MSG_TIME_H "the error test failed repeatedly or with |h| = hmin."
@@ -519,6 +552,7 @@ int idaNlsInit(IDAMem IDA_mem);
 #define MSG_FAILED_CONSTR    "At " MSG_TIME "unable to satisfy inequality constraints."
 #define MSG_RTFUNC_FAILED    "At " MSG_TIME ", the rootfinding routine failed in an unrecoverable manner."
 #define MSG_NO_ROOT          "Rootfinding was not initialized."
+#define MSG_NO_PROFILING     "SUNDIALS was not built with profiling."
 #define MSG_INACTIVE_ROOTS   "At the end of the first step, there are still some root functions identically 0. This warning will not be issued again."
 #define MSG_NLS_INPUT_NULL   "At " MSG_TIME ", the nonlinear solver was passed a NULL input."
 #define MSG_NLS_SETUP_FAILED "At " MSG_TIME ", the nonlinear solver setup failed unrecoverably."
@@ -472,6 +472,29 @@ int IDASetNoInactiveRootWarn(void *ida_mem)
   return(IDA_SUCCESS);
 }
 
+/*
+ * IDASetRootSearchPoints
+ *
+ * Specifies the number of points at which g is evaluated in each pass
+ * of the root search. A value <= 0 resets it to the default (1).
+ */
+
+int IDASetRootSearchPoints(void *ida_mem, int npoints)
+{
+  IDAMem IDA_mem;
+
+  if (ida_mem==NULL) {
+    IDAProcessError(NULL, IDA_MEM_NULL, "IDA", "IDASetRootSearchPoints", MSG_NO_MEM);
+    return(IDA_MEM_NULL);
+  }
+
+  IDA_mem = (IDAMem) ida_mem;
+
+  IDA_mem->ida_nrtpts = (npoints <= 0) ? 1 : npoints;
+
+  return(IDA_SUCCESS);
+}
+
 
 /*
  * =================================================================
@@ -1035,6 +1058,50 @@ int IDAGetNumGEvals(void *ida_mem, long int *ngevals)
 
 /*-----------------------------------------------------------------*/
 
+int IDAGetRootfindStats(void *ida_mem, long int *nrtiters,
+                        long int *ngevals_step, long int *nrtiters_step)
+{
+  IDAMem IDA_mem;
+
+  if (ida_mem==NULL) {
+    IDAProcessError(NULL, IDA_MEM_NULL, "IDA", "IDAGetRootfindStats", MSG_NO_MEM);
+    return(IDA_MEM_NULL);
+  }
+
+  IDA_mem = (IDAMem) ida_mem;
+
+  *nrtiters      = IDA_mem->ida_nrtiters;
+  *ngevals_step  = IDA_mem->ida_nge - IDA_mem->ida_nge_step;
+  *nrtiters_step = IDA_mem->ida_nrtiters - IDA_mem->ida_nrtiters_step;
+
+  return(IDA_SUCCESS);
+}
+
+/*-----------------------------------------------------------------*/
+
+int IDAGetProfile(void *ida_mem, SUNProfile *prof)
+{
+  IDAMem IDA_mem;
+
+  if (ida_mem==NULL) {
+    IDAProcessError(NULL, IDA_MEM_NULL, "IDA", "IDAGetProfile", MSG_NO_MEM);
+    return(IDA_MEM_NULL);
+  }
+
+  IDA_mem = (IDAMem) ida_mem;
+
+#ifdef SUNDIALS_BUILD_WITH_PROFILING
+  *prof = IDA_mem->ida_profile;
+  return(IDA_SUCCESS);
+#else
+  IDAProcessError(IDA_mem, IDA_ILL_INPUT, "IDA", "IDAGetProfile",
+                  MSG_NO_PROFILING);
+  return(IDA_ILL_INPUT);
+#endif
+}
+
+/*-----------------------------------------------------------------*/
+
 int IDAGetRootInfo(void *ida_mem, int *rootsfound)
 {
   IDAMem IDA_mem;
@@ -36,6 +36,17 @@
 #define ONE        RCONST(1.0)
 #define TWO        RCONST(2.0)
 
+/*=================================================================
+  PRIVATE FUNCTION PROTOTYPES
+  =================================================================*/
+
+static int idaLsSparseDQJacInit(IDALsMem idals_mem);
+static void idaLsSparseDQJacFree(IDALsMem idals_mem);
+static int idaLsSparseDQJacColor(realtype tt, N_Vector yy, N_Vector yp,
+                                 N_Vector rr, N_Vector ytemp, N_Vector yptemp,
+                                 N_Vector rtemp, realtype *Jx, realtype srur,
+                                 sunindextype g, IDAMem IDA_mem);
+
 
 /*===============================================================
   IDALS Exported functions -- Required
@@ -394,6 +405,76 @@ int IDASetIncrementFactor(void *ida_mem, realtype dqincfac)
 }
 
 
+/* IDASetSparseDQJac enables the colored difference quotient
+   Jacobian for a sparse SUNMatrix. S holds the sparsity pattern of
+   dF/dy + c_j*dF/dy' (its values are not used); the columns are
+   grouped into colors of structurally orthogonal columns, so that
+   res is evaluated once per color rather than once per column. If
+   nthreads is larger than one and IDA is built with OpenMP, the
+   colors are evaluated concurrently, in which case res must be
+   thread-safe. A NULL S disables the colored approximation. */
+int IDASetSparseDQJac(void *ida_mem, SUNMatrix S, int nthreads)
+{
+  IDAMem   IDA_mem;
+  IDALsMem idals_mem;
+  int      retval;
+
+  /* access IDALsMem structure */
+  retval = idaLs_AccessLMem(ida_mem, "IDASetSparseDQJac",
+                            &IDA_mem, &idals_mem);
+  if (retval != IDALS_SUCCESS)  return(retval);
+
+  /* return with failure if the system matrix is not sparse */
+  if ((idals_mem->J == NULL) || (idals_mem->J->ops->getid == NULL) ||
+      (SUNMatGetID(idals_mem->J) != SUNMATRIX_SPARSE)) {
+    IDAProcessError(IDA_mem, IDALS_ILL_INPUT, "IDALS", "IDASetSparseDQJac",
+                    "The system matrix is not a sparse SUNMatrix");
+    return(IDALS_ILL_INPUT);
+  }
+
+  /* check the sparsity pattern and the number of threads */
+  if ((S != NULL) &&
+      ((S->ops->getid == NULL) || (SUNMatGetID(S) != SUNMATRIX_SPARSE) ||
+       (SUNSparseMatrix_Rows(S) != SUNSparseMatrix_Rows(idals_mem->J)) ||
+       (SUNSparseMatrix_Columns(S) != SUNSparseMatrix_Columns(idals_mem->J)))) {
+    IDAProcessError(IDA_mem, IDALS_ILL_INPUT, "IDALS", "IDASetSparseDQJac",
+                    "The sparsity pattern does not match the system matrix");
+    return(IDALS_ILL_INPUT);
+  }
+  if (nthreads < 1) {
+    IDAProcessError(IDA_mem, IDALS_ILL_INPUT, "IDALS", "IDASetSparseDQJac",
+                    "nthreads < 1 illegal.");
+    return(IDALS_ILL_INPUT);
+  }
+
+  /* free any previously set pattern */
+  idaLsSparseDQJacFree(idals_mem);
+  if (S == NULL)  return(IDALS_SUCCESS);
+
+  /* store a copy of the pattern in the storage format of J */
+  if (SUNSparseMatrix_SparseType(S) == SUNSparseMatrix_SparseType(idals_mem->J)) {
+    idals_mem->Jpat = SUNMatClone(S);
+    retval = (idals_mem->Jpat == NULL) ? -1 : SUNMatCopy(S, idals_mem->Jpat);
+  } else if (SUNSparseMatrix_SparseType(idals_mem->J) == CSR_MAT) {
+    retval = SUNSparseMatrix_ToCSR(S, &idals_mem->Jpat);
+  } else {
+    retval = SUNSparseMatrix_ToCSC(S, &idals_mem->Jpat);
+  }
+
+  /* build the column view and color the columns */
+  if (retval == 0)  retval = idaLsSparseDQJacInit(idals_mem);
+  if (retval != 0) {
+    idaLsSparseDQJacFree(idals_mem);
+    IDAProcessError(IDA_mem, IDALS_MEM_FAIL, "IDALS", "IDASetSparseDQJac",
+                    MSG_LS_MEM_FAIL);
+    return(IDALS_MEM_FAIL);
+  }
+  idals_mem->dqthreads = nthreads;
+
+  return(IDALS_SUCCESS);
+}
+
+
 /* IDASetPreconditioner specifies the user-supplied psetup and psolve routines */
 int IDASetPreconditioner(void *ida_mem,
                          IDALsPrecSetupFn psetup,
@@ -847,7 +928,7 @@ int idaLsPSolve(void *ida_mem, N_Vector r, N_Vector z, realtype tol, int lr)
 /*---------------------------------------------------------------
   idaLsDQJac:
 
-  This routine is a wrapper for the Dense and Band
+  This routine is a wrapper for the Dense, Band and Sparse
   implementations of the difference quotient Jacobian
   approximation routines.
 ---------------------------------------------------------------*/
@@ -855,8 +936,9 @@ int idaLsDQJac(realtype t, realtype c_j, N_Vector y, N_Vector yp,
                N_Vector r, SUNMatrix Jac, void *ida_mem,
                N_Vector tmp1, N_Vector tmp2, N_Vector tmp3)
 {
-  int    retval;
-  IDAMem IDA_mem;
+  int      retval;
+  IDAMem   IDA_mem;
+  IDALsMem idals_mem;
   IDA_mem = (IDAMem) ida_mem;
 
   /* access IDAMem structure */
@@ -865,6 +947,7 @@ int idaLsDQJac(realtype t, realtype c_j, N_Vector y, N_Vector yp,
                     "idaLsDQJac", MSG_LS_IDAMEM_NULL);
     return(IDALS_MEM_NULL);
   }
+  idals_mem = (IDALsMem) IDA_mem->ida_lmem;
 
   /* verify that Jac is non-NULL */
   if (Jac == NULL) {
@@ -890,6 +973,9 @@ int idaLsDQJac(realtype t, realtype c_j, N_Vector y, N_Vector yp,
     retval = idaLsDenseDQJac(t, c_j, y, yp, r, Jac, IDA_mem, tmp1);
   } else if (SUNMatGetID(Jac) == SUNMATRIX_BAND) {
     retval = idaLsBandDQJac(t, c_j, y, yp, r, Jac, IDA_mem, tmp1, tmp2, tmp3);
+  } else if ((SUNMatGetID(Jac) == SUNMATRIX_SPARSE) &&
+             (idals_mem->Jpat != NULL)) {
+    retval = idaLsSparseDQJac(t, c_j, y, yp, r, Jac, IDA_mem, tmp1, tmp2, tmp3);
   } else {
     IDAProcessError(IDA_mem, IDA_ILL_INPUT, "IDALS",
                     "idaLsDQJac",
@@ -975,7 +1061,9 @@ int idaLsDenseDQJac(realtype tt, realtype c_j, N_Vector yy,
     y_data[j] += inc;
     yp_data[j] += c_j*inc;
 
+    SUNDIALS_PROFILE_BEGIN(IDA_mem->ida_profile, SUN_PROFILE_RHS);
     retval = IDA_mem->ida_res(tt, yy, yp, rtemp, IDA_mem->ida_user_data);
+    SUNDIALS_PROFILE_END(IDA_mem->ida_profile, SUN_PROFILE_RHS);
     idals_mem->nreDQ++;
     if (retval != 0) break;
 
@@ -1086,7 +1174,9 @@ int idaLsBandDQJac(realtype tt, realtype c_j, N_Vector yy,
     }
 
     /* Call res routine with incremented arguments. */
+    SUNDIALS_PROFILE_BEGIN(IDA_mem->ida_profile, SUN_PROFILE_RHS);
     retval = IDA_mem->ida_res(tt, ytemp, yptemp, rtemp, IDA_mem->ida_user_data);
+    SUNDIALS_PROFILE_END(IDA_mem->ida_profile, SUN_PROFILE_RHS);
     idals_mem->nreDQ++;
     if (retval != 0) break;
 
@@ -1123,6 +1213,290 @@ int idaLsBandDQJac(realtype tt, realtype c_j, N_Vector yy,
 }
 
 
+/*---------------------------------------------------------------
+  idaLsSparseDQJac
+
+  This routine generates a sparse difference quotient approximation
+  JJ to the DAE system Jacobian J, using the sparsity pattern and
+  column coloring set with IDASetSparseDQJac (Curtis-Powell-Reid).
+  All columns of a color have no nonzero in a common row, so they
+  are incremented together and res is called once per color. If
+  more than one thread was requested, the colors are evaluated
+  concurrently with OpenMP, each thread using its own work vectors.
+  The return value is either 0, or the nonzero value returned by
+  the res routine, if any.
+  ---------------------------------------------------------------*/
+int idaLsSparseDQJac(realtype tt, realtype c_j, N_Vector yy,
+                     N_Vector yp, N_Vector rr, SUNMatrix Jac,
+                     IDAMem IDA_mem, N_Vector tmp1, N_Vector tmp2,
+                     N_Vector tmp3)
+{
+  realtype srur, *Jx;
+  N_Vector rtemp, ytemp, yptemp;
+  sunindextype g;
+  IDALsMem idals_mem;
+  int retval = 0;
+#ifdef _OPENMP
+  long int nre;
+  int ret;
+#endif
+
+  /* access LsMem interface structure */
+  idals_mem = (IDALsMem) IDA_mem->ida_lmem;
+
+  /* Load the sparsity pattern into Jac */
+  if (SUNMatCopy(idals_mem->Jpat, Jac) != 0) {
+    IDAProcessError(IDA_mem, IDALS_MEM_FAIL, "IDALS", "idaLsSparseDQJac",
+                    MSG_LS_MEM_FAIL);
+    return(-1);
+  }
+  Jx = SUNSparseMatrix_Data(Jac);
+
+  srur = SUNRsqrt(IDA_mem->ida_uround);
+
+#ifdef _OPENMP
+  if (idals_mem->dqthreads > 1) {
+
+    /* Evaluate the colors concurrently; a negative (unrecoverable)
+       return value from res takes precedence over a positive one */
+    nre = 0;
+#pragma omp parallel default(shared) private(g, rtemp, ytemp, yptemp, ret) \
+  num_threads(idals_mem->dqthreads)
+    {
+      rtemp  = N_VClone(tmp1);
+      ytemp  = N_VClone(tmp2);
+      yptemp = N_VClone(tmp3);
+      if ((rtemp != NULL) && (ytemp != NULL) && (yptemp != NULL)) {
+        N_VScale(ONE, yy, ytemp);
+        N_VScale(ONE, yp, yptemp);
+      }
+
+#pragma omp for schedule(dynamic) reduction(+:nre)
+      for (g = 0; g < idals_mem->ncolors; g++) {
+        if ((rtemp == NULL) || (ytemp == NULL) || (yptemp == NULL)) {
+          ret = -1;
+        } else {
+          ret = idaLsSparseDQJacColor(tt, yy, yp, rr, ytemp, yptemp, rtemp,
+                                      Jx, srur, g, IDA_mem);
+          nre++;
+        }
+        if (ret != 0) {
+#pragma omp critical (idaLsSparseDQJac_retval)
+          if ((retval == 0) || (ret < 0))  retval = ret;
+        }
+      }
+
+      if (rtemp != NULL)   N_VDestroy(rtemp);
+      if (ytemp != NULL)   N_VDestroy(ytemp);
+      if (yptemp != NULL)  N_VDestroy(yptemp);
+    }
+    idals_mem->nreDQ += nre;
+
+    return(retval);
+  }
+#endif
+
+  /* Rename work vectors for use as temporary values of r, y and yp */
+  rtemp = tmp1;
+  ytemp = tmp2;
+  yptemp= tmp3;
+
+  /* Initialize ytemp and yptemp. */
+  N_VScale(ONE, yy, ytemp);
+  N_VScale(ONE, yp, yptemp);
+
+  /* Loop over column colors. */
+  for (g = 0; g < idals_mem->ncolors; g++) {
+    retval = idaLsSparseDQJacColor(tt, yy, yp, rr, ytemp, yptemp, rtemp,
+                                   Jx, srur, g, IDA_mem);
+    idals_mem->nreDQ++;
+    if (retval != 0) break;
+  }
+
+  return(retval);
+}
+
+
+/*---------------------------------------------------------------
+  idaLsSparseDQJacColor
+
+  This routine computes the columns of color g of the sparse
+  difference quotient Jacobian. On entry ytemp and yptemp must
+  equal yy and yp; they are restored before returning.
+  ---------------------------------------------------------------*/
+static int idaLsSparseDQJacColor(realtype tt, N_Vector yy, N_Vector yp,
+                                 N_Vector rr, N_Vector ytemp, N_Vector yptemp,
+                                 N_Vector rtemp, realtype *Jx, realtype srur,
+                                 sunindextype g, IDAMem IDA_mem)
+{
+  realtype inc, inc_inv, yj, ypj, conj, ewtj;
+  realtype *y_data, *yp_data, *ewt_data, *cns_data = NULL;
+  realtype *ytemp_data, *yptemp_data, *rtemp_data, *r_data;
+  sunindextype c, j, k;
+  IDALsMem idals_mem;
+  int retval;
+
+  /* access LsMem interface structure */
+  idals_mem = (IDALsMem) IDA_mem->ida_lmem;
+
+  /* Obtain pointers to the data for all vectors used.  */
+  ewt_data    = N_VGetArrayPointer(IDA_mem->ida_ewt);
+  r_data      = N_VGetArrayPointer(rr);
+  y_data      = N_VGetArrayPointer(yy);
+  yp_data     = N_VGetArrayPointer(yp);
+  rtemp_data  = N_VGetArrayPointer(rtemp);
+  ytemp_data  = N_VGetArrayPointer(ytemp);
+  yptemp_data = N_VGetArrayPointer(yptemp);
+  if (IDA_mem->ida_constraintsSet)
+    cns_data = N_VGetArrayPointer(IDA_mem->ida_constraints);
+
+  /* Increment all yy[j] and yp[j] for j of color g. */
+  for (c = idals_mem->colorptrs[g]; c < idals_mem->colorptrs[g+1]; c++) {
+    j = idals_mem->colorcols[c];
+    yj = y_data[j];
+    ypj = yp_data[j];
+    ewtj = ewt_data[j];
+
+    /* Set increment inc to yj based on sqrt(uround)*abs(yj), with
+       adjustments using ypj and ewtj if this is small, and a further
+       adjustment to give it the same sign as hh*ypj. */
+    inc = SUNMAX( srur * SUNMAX( SUNRabs(yj), SUNRabs(IDA_mem->ida_hh*ypj) ),
+                  ONE/ewtj );
+    if (IDA_mem->ida_hh*ypj < ZERO)  inc = -inc;
+    inc = (yj + inc) - yj;
+
+    /* Adjust sign(inc) again if yj has an inequality constraint. */
+    if (IDA_mem->ida_constraintsSet) {
+      conj = cns_data[j];
+      if (SUNRabs(conj) == ONE)      {if((yj+inc)*conj <  ZERO) inc = -inc;}
+      else if (SUNRabs(conj) == TWO) {if((yj+inc)*conj <= ZERO) inc = -inc;}
+    }
+
+    /* Increment yj and ypj. */
+    ytemp_data[j] += inc;
+    yptemp_data[j] += IDA_mem->ida_cj*inc;
+  }
+
+  /* Call res routine with incremented arguments. */
+  retval = IDA_mem->ida_res(tt, ytemp, yptemp, rtemp, IDA_mem->ida_user_data);
+
+  /* Loop over the indices j of color g again. */
+  for (c = idals_mem->colorptrs[g]; c < idals_mem->colorptrs[g+1]; c++) {
+    j = idals_mem->colorcols[c];
+
+    /* Reset ytemp and yptemp components that were perturbed. */
+    yj = ytemp_data[j]  = y_data[j];
+    ypj = yptemp_data[j] = yp_data[j];
+    if (retval != 0) continue;
+    ewtj = ewt_data[j];
+
+    /* Set increment inc exactly as above. */
+    inc = SUNMAX( srur * SUNMAX( SUNRabs(yj), SUNRabs(IDA_mem->ida_hh*ypj) ),
+                  ONE/ewtj );
+    if (IDA_mem->ida_hh*ypj < ZERO)  inc = -inc;
+    inc = (yj + inc) - yj;
+    if (IDA_mem->ida_constraintsSet) {
+      conj = cns_data[j];
+      if (SUNRabs(conj) == ONE)      {if((yj+inc)*conj <  ZERO) inc = -inc;}
+      else if (SUNRabs(conj) == TWO) {if((yj+inc)*conj <= ZERO) inc = -inc;}
+    }
+
+    /* Load the difference quotients of column j. */
+    inc_inv = ONE/inc;
+    for (k = idals_mem->colptrs[j]; k < idals_mem->colptrs[j+1]; k++)
+      Jx[idals_mem->colpos[k]] = inc_inv*(rtemp_data[idals_mem->colrows[k]] -
+                                          r_data[idals_mem->colrows[k]]);
+  }
+
+  return(retval);
+}
+
+
+/*---------------------------------------------------------------
+  idaLsSparseDQJacInit
+
+  This routine builds a column-wise view of the sparsity pattern
+  Jpat (the data positions and rows of the entries of each column)
+  and colors its columns.
+  ---------------------------------------------------------------*/
+static int idaLsSparseDQJacInit(IDALsMem idals_mem)
+{
+  sunindextype *Jp, *Ji, *next;
+  sunindextype i, j, k, N, NP, nnz;
+
+  N   = SUNSparseMatrix_Columns(idals_mem->Jpat);
+  NP  = SUNSparseMatrix_NP(idals_mem->Jpat);
+  Jp  = SUNSparseMatrix_IndexPointers(idals_mem->Jpat);
+  Ji  = SUNSparseMatrix_IndexValues(idals_mem->Jpat);
+  nnz = Jp[NP];
+
+  idals_mem->colorptrs = (sunindextype *) malloc((N+1)*sizeof(sunindextype));
+  idals_mem->colorcols = (sunindextype *) malloc(N*sizeof(sunindextype));
+  idals_mem->colptrs   = (sunindextype *) calloc(N+1, sizeof(sunindextype));
+  idals_mem->colpos    = (sunindextype *) malloc((nnz+1)*sizeof(sunindextype));
+  idals_mem->colrows   = (sunindextype *) malloc((nnz+1)*sizeof(sunindextype));
+  if ((idals_mem->colorptrs == NULL) || (idals_mem->colorcols == NULL) ||
+      (idals_mem->colptrs == NULL) || (idals_mem->colpos == NULL) ||
+      (idals_mem->colrows == NULL))
+    return(-1);
+
+  if (SUNSparseMatrix_SparseType(idals_mem->Jpat) == CSC_MAT) {
+
+    /* the pattern is already stored by columns */
+    for (j = 0; j <= N; j++)
+      idals_mem->colptrs[j] = Jp[j];
+    for (k = 0; k < nnz; k++) {
+      idals_mem->colpos[k]  = k;
+      idals_mem->colrows[k] = Ji[k];
+    }
+
+  } else {
+
+    /* count the entries of each column, then fill the columns row by
+       row (colorcols is used as workspace for the next free slot) */
+    for (k = 0; k < nnz; k++)
+      idals_mem->colptrs[Ji[k]+1]++;
+    for (j = 0; j < N; j++)
+      idals_mem->colptrs[j+1] += idals_mem->colptrs[j];
+    next = idals_mem->colorcols;
+    for (j = 0; j < N; j++)
+      next[j] = idals_mem->colptrs[j];
+    for (i = 0; i < NP; i++)
+      for (k = Jp[i]; k < Jp[i+1]; k++) {
+        idals_mem->colpos[next[Ji[k]]]    = k;
+        idals_mem->colrows[next[Ji[k]]++] = i;
+      }
+
+  }
+
+  return(SUNSparseMatrix_ColumnColoring(idals_mem->Jpat, &idals_mem->ncolors,
+                                        idals_mem->colorptrs,
+                                        idals_mem->colorcols));
+}
+
+
+/*---------------------------------------------------------------
+  idaLsSparseDQJacFree
+
+  This routine frees the sparsity pattern and coloring set with
+  IDASetSparseDQJac.
+  ---------------------------------------------------------------*/
+static void idaLsSparseDQJacFree(IDALsMem idals_mem)
+{
+  if (idals_mem->Jpat) {
+    SUNMatDestroy(idals_mem->Jpat);
+    idals_mem->Jpat = NULL;
+  }
+  free(idals_mem->colorptrs);  idals_mem->colorptrs = NULL;
+  free(idals_mem->colorcols);  idals_mem->colorcols = NULL;
+  free(idals_mem->colptrs);    idals_mem->colptrs   = NULL;
+  free(idals_mem->colpos);     idals_mem->colpos    = NULL;
+  free(idals_mem->colrows);    idals_mem->colrows   = NULL;
+  idals_mem->ncolors   = 0;
+  idals_mem->dqthreads = 1;
+}
+
+
 /*---------------------------------------------------------------
   idaLsDQJtimes
 
@@ -1218,13 +1592,16 @@ int idaLsInitialize(IDAMem IDA_mem)
   } else if (idals_mem->jacDQ) {
 
     /* If J is non-NULL, and 'jac' is not user-supplied:
-       - if J is dense or band, ensure that our DQ approx. is used
+       - if J is dense or band, or sparse with a sparsity pattern,
+         ensure that our DQ approx. is used
        - otherwise => error */
     retval = 0;
     if (idals_mem->J->ops->getid) {
 
       if ( (SUNMatGetID(idals_mem->J) == SUNMATRIX_DENSE) ||
-           (SUNMatGetID(idals_mem->J) == SUNMATRIX_BAND) ) {
+           (SUNMatGetID(idals_mem->J) == SUNMATRIX_BAND) ||
+           ((SUNMatGetID(idals_mem->J) == SUNMATRIX_SPARSE) &&
+            (idals_mem->Jpat != NULL)) ) {
         idals_mem->jac    = idaLsDQJac;
         idals_mem->J_data = IDA_mem;
       } else {
@@ -1315,9 +1692,11 @@ int idaLsSetup(IDAMem IDA_mem, N_Vector y, N_Vector yp, N_Vector r,
     }
 
     /* Call Jacobian routine */
+    SUNDIALS_PROFILE_BEGIN(IDA_mem->ida_profile, SUN_PROFILE_JAC);
     retval = idals_mem->jac(IDA_mem->ida_tn, IDA_mem->ida_cj, y,
                             yp, r, idals_mem->J,
                             idals_mem->J_data, vt1, vt2, vt3);
+    SUNDIALS_PROFILE_END(IDA_mem->ida_profile, SUN_PROFILE_JAC);
     if (retval < 0) {
       IDAProcessError(IDA_mem, IDALS_JACFUNC_UNRECVR, "IDALS",
                       "idaLsSetup", MSG_LS_JACFUNC_FAILED);
@@ -1582,6 +1961,9 @@ int idaLsFree(IDAMem IDA_mem)
     idals_mem->x = NULL;
   }
 
+  /* Free the sparsity pattern and coloring */
+  idaLsSparseDQJacFree(idals_mem);
+
   /* Nullify other N_Vector pointers */
   idals_mem->ycur  = NULL;
   idals_mem->ypcur = NULL;
@@ -103,6 +103,23 @@ typedef struct IDALsMemRec {
   IDAResFn jt_res;
   void *jt_data;
 
+  /* Colored difference quotient Jacobian for a sparse J
+     (set with IDASetSparseDQJac):
+         - Jpat      = sparsity pattern of J, in the format of J
+         - the columns of color g are colorcols[colorptrs[g]] to
+           colorcols[colorptrs[g+1]-1]
+         - the entries of column j are Jx[colpos[k]] in row colrows[k],
+           colptrs[j] <= k < colptrs[j+1]
+         - dqthreads = number of threads evaluating the colors */
+  SUNMatrix Jpat;
+  sunindextype ncolors;
+  sunindextype *colorptrs;
+  sunindextype *colorcols;
+  sunindextype *colptrs;
+  sunindextype *colpos;
+  sunindextype *colrows;
+  int dqthreads;
+
 } *IDALsMem;
 
 
@@ -133,6 +150,10 @@ int idaLsBandDQJac(realtype tt, realtype c_j,  N_Vector yy,
                    N_Vector yp, N_Vector rr, SUNMatrix Jac,
                    IDAMem IDA_mem, N_Vector tmp1,
                    N_Vector tmp2, N_Vector tmp3);
+int idaLsSparseDQJac(realtype tt, realtype c_j, N_Vector yy,
+                     N_Vector yp, N_Vector rr, SUNMatrix Jac,
+                     IDAMem IDA_mem, N_Vector tmp1,
+                     N_Vector tmp2, N_Vector tmp3);
 
 /* Generic linit/lsetup/lsolve/lperf/lfree interface routines for IDA to call */
 int idaLsInitialize(IDAMem IDA_mem);
@@ -209,9 +209,11 @@ static int idaNlsLSetup(booleantype jbad, booleantype* jcur, void* ida_mem)
   IDA_mem = (IDAMem) ida_mem;
 
   IDA_mem->ida_nsetups++;
+  SUNDIALS_PROFILE_BEGIN(IDA_mem->ida_profile, SUN_PROFILE_LSETUP);
   retval = IDA_mem->ida_lsetup(IDA_mem, IDA_mem->ida_yy, IDA_mem->ida_yp,
                                IDA_mem->ida_savres, IDA_mem->ida_tempv1,
                                IDA_mem->ida_tempv2, IDA_mem->ida_tempv3);
+  SUNDIALS_PROFILE_END(IDA_mem->ida_profile, SUN_PROFILE_LSETUP);
 
   /* update Jacobian status */
   *jcur = SUNTRUE;
@@ -239,9 +241,11 @@ static int idaNlsLSolve(N_Vector delta, void* ida_mem)
   }
   IDA_mem = (IDAMem) ida_mem;
 
+  SUNDIALS_PROFILE_BEGIN(IDA_mem->ida_profile, SUN_PROFILE_LSOLVE);
   retval = IDA_mem->ida_lsolve(IDA_mem, delta, IDA_mem->ida_ewt,
                                IDA_mem->ida_yy, IDA_mem->ida_yp,
                                IDA_mem->ida_savres);
+  SUNDIALS_PROFILE_END(IDA_mem->ida_profile, SUN_PROFILE_LSOLVE);
 
   if (retval < 0) return(IDA_LSOLVE_FAIL);
   if (retval > 0) return(IDA_LSOLVE_RECVR);
@@ -266,8 +270,10 @@ static int idaNlsResidual(N_Vector ycor, N_Vector res, void* ida_mem)
   N_VLinearSum(ONE, IDA_mem->ida_yppredict, IDA_mem->ida_cj, ycor, IDA_mem->ida_yp);
 
   /* evaluate residual */
+  SUNDIALS_PROFILE_BEGIN(IDA_mem->ida_profile, SUN_PROFILE_RHS);
   retval = IDA_mem->ida_res(IDA_mem->ida_tn, IDA_mem->ida_yy, IDA_mem->ida_yp,
                             res, IDA_mem->ida_user_data);
+  SUNDIALS_PROFILE_END(IDA_mem->ida_profile, SUN_PROFILE_RHS);
 
   /* increment the number of residual evaluations */
   IDA_mem->ida_nre++;
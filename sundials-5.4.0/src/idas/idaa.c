@@ -45,7 +45,16 @@ static CkpntMem IDAAckpntInit(IDAMem IDA_mem);
 static CkpntMem IDAAckpntNew(IDAMem IDA_mem);
 static void IDAAckpntCopyVectors(IDAMem IDA_mem, CkpntMem ck_mem);
 static booleantype IDAAckpntAllocVectors(IDAMem IDA_mem, CkpntMem ck_mem);
-static void IDAAckpntDelete(CkpntMem *ck_memPtr);
+static int IDAAckpntVecs(IDAMem IDA_mem, CkpntMem ck_mem);
+static int IDAAckpntStash(IDAMem IDA_mem, CkpntMem ck_mem);
+static void IDAAckpntDelete(IDAadjMem IDAADJ_mem, CkpntMem *ck_memPtr);
+static void IDAAckpntRemove(IDAadjMem IDAADJ_mem, CkpntMem *ck_memPtr);
+static void IDAAckpntThin(IDAMem IDA_mem);
+static void IDAAckpntPrune(IDAadjMem IDAADJ_mem, CkpntMem ck_mem);
+static int IDAAckpntRefine(IDAMem IDA_mem, CkpntMem *ck_memPtr,
+                           realtype tBout, int itaskB, int sign);
+static booleantype IDAAckpntNeeded(IDAadjMem IDAADJ_mem, CkpntMem ck_mem,
+                                   realtype tBout, int itaskB, int sign);
 
 static void IDAAbckpbDelete(IDABMem *IDAB_memPtr);
 
@@ -136,6 +145,16 @@ int IDAAdjInit(void *ida_mem, long int steps, int interp)
   IDAADJ_mem->ia_nckpnts = 0;
   IDAADJ_mem->ia_ckpntData = NULL;
 
+  /* Check points are kept in N_Vectors */
+  IDAADJ_mem->ia_ckstoreType = IDA_CKPNT_MEMORY;
+  IDAADJ_mem->ia_ckstoreDir  = NULL;
+  IDAADJ_mem->ia_ckstore     = NULL;
+  IDAADJ_mem->ia_ckvecs      = NULL;
+  IDAADJ_mem->ia_nckvecs     = 0;
+
+  /* No limit on the number of check points */
+  IDAADJ_mem->ia_maxckpnts = 0;
+  IDAADJ_mem->ia_ckstride  = 1;
 
   /* Initialization of interpolation data. */
   IDAADJ_mem->ia_interpType = interp;
@@ -234,11 +253,12 @@ int IDAAdjReInit(void *ida_mem)
 
   /* Free all stored  checkpoints. */
   while (IDAADJ_mem->ck_mem != NULL)
-      IDAAckpntDelete(&(IDAADJ_mem->ck_mem));
+      IDAAckpntDelete(IDAADJ_mem, &(IDAADJ_mem->ck_mem));
 
   IDAADJ_mem->ck_mem = NULL;
   IDAADJ_mem->ia_nckpnts = 0;
   IDAADJ_mem->ia_ckpntData = NULL;
+  IDAADJ_mem->ia_ckstride = 1;
 
   /* Flags for tracking the first calls to IDASolveF and IDASolveF. */
   IDAADJ_mem->ia_firstIDAFcall = SUNTRUE;
@@ -270,9 +290,14 @@ void IDAAdjFree(void *ida_mem)
 
     /* Delete check points one by one */
     while (IDAADJ_mem->ck_mem != NULL) {
-      IDAAckpntDelete(&(IDAADJ_mem->ck_mem));
+      IDAAckpntDelete(IDAADJ_mem, &(IDAADJ_mem->ck_mem));
     }
 
+    /* Free the check point store */
+    SUNAdjStore_Destroy(IDAADJ_mem->ia_ckstore);
+    if (IDAADJ_mem->ia_ckstoreDir != NULL) free(IDAADJ_mem->ia_ckstoreDir);
+    if (IDAADJ_mem->ia_ckvecs != NULL) free(IDAADJ_mem->ia_ckvecs);
+
     IDAAdataFree(IDA_mem);
 
     /* Free all backward problems. */
@@ -408,6 +433,25 @@ int IDASolveF(void *ida_mem, realtype tout, realtype *tret,
   if ( IDAADJ_mem->ia_firstIDAFcall ) {
 
     IDAADJ_mem->ia_tinitial = IDA_mem->ida_tn;
+
+    /* Create the check point store, if one was requested */
+    if ( (IDAADJ_mem->ia_ckstoreType != IDA_CKPNT_MEMORY) &&
+         (IDAADJ_mem->ia_ckstore == NULL) ) {
+
+      if ( !SUNAdjStore_VectorOK(IDA_mem->ida_tempv1) ||
+           (IDA_mem->ida_quadr && !SUNAdjStore_VectorOK(IDA_mem->ida_eeQ)) ) {
+        IDAProcessError(IDA_mem, IDA_ILL_INPUT, "IDAA", "IDASolveF", MSGAM_CKSTORE_VEC);
+        return(IDA_ILL_INPUT);
+      }
+
+      IDAADJ_mem->ia_ckstore = SUNAdjStore_Create(IDAADJ_mem->ia_ckstoreType,
+                                                  IDAADJ_mem->ia_ckstoreDir);
+      if (IDAADJ_mem->ia_ckstore == NULL) {
+        IDAProcessError(IDA_mem, IDA_MEM_FAIL, "IDAA", "IDASolveF", MSGAM_CKSTORE_FAIL);
+        return(IDA_MEM_FAIL);
+      }
+    }
+
     IDAADJ_mem->ck_mem = IDAAckpntInit(IDA_mem);
     if (IDAADJ_mem->ck_mem == NULL) {
       IDAProcessError(IDA_mem, IDA_MEM_FAIL, "IDAA", "IDASolveF", MSG_MEM_FAIL);
@@ -517,6 +561,9 @@ int IDASolveF(void *ida_mem, realtype tout, realtype *tret,
 
       IDA_mem->ida_forceSetup = SUNTRUE;
 
+      /* Drop check points to stay within the maximum number */
+      IDAAckpntThin(IDA_mem);
+
       /* Reset i=0 and load dt_mem[0] */
       dt_mem[0]->t = IDAADJ_mem->ck_mem->ck_t0;
       IDAADJ_mem->ia_storePnt(IDA_mem, dt_mem[0]);
@@ -1459,22 +1506,8 @@ int IDASolveB(void *ida_mem, realtype tBout, int itaskB)
   gotCkpnt = SUNFALSE;
 
   for(;;) {
-    tmp_IDAB_mem = IDAB_mem;
-    while(tmp_IDAB_mem != NULL) {
-      tBn = tmp_IDAB_mem->IDA_mem->ida_tn;
-
-      if ( sign*(tBn-ck_mem->ck_t0) > ZERO ) {
-        gotCkpnt = SUNTRUE;
-        break;
-      }
 
-      if ( (itaskB == IDA_NORMAL) && (tBn == ck_mem->ck_t0) && (sign*(tBout-ck_mem->ck_t0) >= ZERO) ) {
-        gotCkpnt = SUNTRUE;
-        break;
-      }
-
-      tmp_IDAB_mem = tmp_IDAB_mem->ida_next;
-    }
+    gotCkpnt = IDAAckpntNeeded(IDAADJ_mem, ck_mem, tBout, itaskB, sign);
 
     if (gotCkpnt) break;
 
@@ -1486,10 +1519,18 @@ int IDASolveB(void *ida_mem, realtype tBout, int itaskB)
   /* Loop while propagating backward problems */
   for(;;) {
 
+    /* Free the check points recomputed for intervals already done */
+    IDAAckpntPrune(IDAADJ_mem, ck_mem);
+
     /* Store interpolation data if not available.
-       This is the 2nd forward integration pass */
+       This is the 2nd forward integration pass. If IDASolveF dropped
+       check points, first recompute them until the interval is
+       short enough. */
     if (ck_mem != IDAADJ_mem->ia_ckpntData) {
 
+      flag = IDAAckpntRefine(IDA_mem, &ck_mem, tBout, itaskB, sign);
+      if (flag != IDA_SUCCESS) break;
+
       flag = IDAAdataStore(IDA_mem, ck_mem);
       if (flag != IDA_SUCCESS) break;
     }
@@ -1718,6 +1759,10 @@ static CkpntMem IDAAckpntInit(IDAMem IDA_mem)
   /* Alloc 3: current order, i.e. 1,  +   2. */
   ck_mem->ck_phi_alloc = 3;
 
+  /* The initial check point is always kept in N_Vectors */
+  ck_mem->ck_rec  = NULL;
+  ck_mem->ck_temp = SUNFALSE;
+
   if (!IDAAckpntAllocVectors(IDA_mem, ck_mem)) {
     free(ck_mem); ck_mem = NULL;
     return(NULL);
@@ -1740,9 +1785,12 @@ static CkpntMem IDAAckpntInit(IDAMem IDA_mem)
 
 static CkpntMem IDAAckpntNew(IDAMem IDA_mem)
 {
+  IDAadjMem IDAADJ_mem;
   CkpntMem ck_mem;
   int j;
 
+  IDAADJ_mem = IDA_mem->ida_adj_mem;
+
   /* Allocate space for ckdata */
   ck_mem = (CkpntMem) malloc(sizeof(struct CkpntMemRec));
   if (ck_mem == NULL) return(NULL);
@@ -1786,6 +1834,19 @@ static CkpntMem IDAAckpntNew(IDAMem IDA_mem)
   ck_mem->ck_phi_alloc = (IDA_mem->ida_kk+2 < MXORDP1) ?
     IDA_mem->ida_kk+2 : MXORDP1;
 
+  ck_mem->ck_rec  = NULL;
+  ck_mem->ck_temp = SUNFALSE;
+
+  /* With a check point store, save the phi* arrays there instead of
+     copying them to new N_Vectors */
+  if (IDAADJ_mem->ia_ckstore != NULL) {
+    if (IDAAckpntStash(IDA_mem, ck_mem) != IDA_SUCCESS) {
+      free(ck_mem); ck_mem = NULL;
+      return(NULL);
+    }
+    return(ck_mem);
+  }
+
   if (!IDAAckpntAllocVectors(IDA_mem, ck_mem)) {
     free(ck_mem); ck_mem = NULL;
     return(NULL);
@@ -1797,12 +1858,82 @@ static CkpntMem IDAAckpntNew(IDAMem IDA_mem)
   return(ck_mem);
 }
 
+/*
+ * IDAAckpntVecs
+ *
+ * This routine lists in ia_ckvecs the vectors of IDA_mem that make
+ * up the phi* arrays of the check point ck_mem, in the order in which
+ * they are saved in the check point store, and returns their number
+ * (or -1 if the list could not be allocated).
+ */
+
+static int IDAAckpntVecs(IDAMem IDA_mem, CkpntMem ck_mem)
+{
+  IDAadjMem IDAADJ_mem;
+  N_Vector *v;
+  int j, is, nv, Ns;
+
+  IDAADJ_mem = IDA_mem->ida_adj_mem;
+
+  /* At most MXORDP1 arrays of each kind */
+  Ns = ck_mem->ck_sensi ? ck_mem->ck_Ns : 0;
+  nv = MXORDP1*(2 + 2*Ns);
+  if (nv > IDAADJ_mem->ia_nckvecs) {
+    v = (N_Vector *) realloc(IDAADJ_mem->ia_ckvecs, nv*sizeof(N_Vector));
+    if (v == NULL) return(-1);
+    IDAADJ_mem->ia_ckvecs  = v;
+    IDAADJ_mem->ia_nckvecs = nv;
+  }
+  v = IDAADJ_mem->ia_ckvecs;
+
+  nv = 0;
+
+  for (j=0; j<ck_mem->ck_phi_alloc; j++) v[nv++] = IDA_mem->ida_phi[j];
+
+  if (ck_mem->ck_quadr)
+    for (j=0; j<ck_mem->ck_phi_alloc; j++) v[nv++] = IDA_mem->ida_phiQ[j];
+
+  if (ck_mem->ck_sensi)
+    for (j=0; j<ck_mem->ck_phi_alloc; j++)
+      for (is=0; is<Ns; is++) v[nv++] = IDA_mem->ida_phiS[j][is];
+
+  if (ck_mem->ck_quadr_sensi)
+    for (j=0; j<ck_mem->ck_phi_alloc; j++)
+      for (is=0; is<Ns; is++) v[nv++] = IDA_mem->ida_phiQS[j][is];
+
+  return(nv);
+}
+
+/*
+ * IDAAckpntStash
+ *
+ * This routine saves the phi* arrays of IDA_mem for the new check
+ * point ck_mem in the check point store.
+ */
+
+static int IDAAckpntStash(IDAMem IDA_mem, CkpntMem ck_mem)
+{
+  IDAadjMem IDAADJ_mem;
+  int nv;
+
+  IDAADJ_mem = IDA_mem->ida_adj_mem;
+
+  nv = IDAAckpntVecs(IDA_mem, ck_mem);
+  if (nv < 0) return(IDA_MEM_FAIL);
+
+  if (SUNAdjStore_Put(IDAADJ_mem->ia_ckstore, IDAADJ_mem->ia_ckvecs, nv,
+                      &(ck_mem->ck_rec)) != 0)
+    return(IDA_MEM_FAIL);
+
+  return(IDA_SUCCESS);
+}
+
 /* IDAAckpntDelete
  *
  * This routine deletes the first check point in list.
 */
 
-static void IDAAckpntDelete(CkpntMem *ck_memPtr)
+static void IDAAckpntDelete(IDAadjMem IDAADJ_mem, CkpntMem *ck_memPtr)
 {
   CkpntMem tmp;
   int j;
@@ -1813,6 +1944,13 @@ static void IDAAckpntDelete(CkpntMem *ck_memPtr)
     /* move head of list */
     *ck_memPtr = (*ck_memPtr)->ck_next;
 
+    /* the data of tmp is in the check point store */
+    if (tmp->ck_rec != NULL) {
+      SUNAdjStore_Release(IDAADJ_mem->ia_ckstore, tmp->ck_rec);
+      free(tmp); tmp=NULL;
+      return;
+    }
+
     /* free N_Vectors in tmp */
     for (j=0; j<tmp->ck_phi_alloc; j++)
       N_VDestroy(tmp->ck_phi[j]);
@@ -1838,6 +1976,198 @@ static void IDAAckpntDelete(CkpntMem *ck_memPtr)
   }
 }
 
+/*
+ * IDAAckpntRemove
+ *
+ * This routine removes the check point *ck_memPtr from the middle of
+ * the list; the next (older) check point then spans both intervals.
+ */
+
+static void IDAAckpntRemove(IDAadjMem IDAADJ_mem, CkpntMem *ck_memPtr)
+{
+  CkpntMem tmp;
+
+  tmp = *ck_memPtr;
+
+  tmp->ck_next->ck_t1 = tmp->ck_t1;
+
+  if (IDAADJ_mem->ia_ckpntData == tmp) IDAADJ_mem->ia_ckpntData = NULL;
+  if (!tmp->ck_temp) IDAADJ_mem->ia_nckpnts--;
+
+  IDAAckpntDelete(IDAADJ_mem, ck_memPtr);
+}
+
+/*
+ * IDAAckpntThin
+ *
+ * This routine is called by IDASolveF after adding a check point. If
+ * a maximum number of check points was set, only the check points at
+ * multiples of ia_ckstride*nsteps steps are kept, besides the first
+ * and the last one. Whenever there are too many, the stride is
+ * doubled, which drops every other check point. IDASolveB needs up
+ * to log2(ia_ckstride) more to recompute the dropped ones, so these
+ * are kept free.
+ */
+
+static void IDAAckpntThin(IDAMem IDA_mem)
+{
+  IDAadjMem IDAADJ_mem;
+  CkpntMem *ck_memPtr;
+  long int stride, s;
+  int levels;
+
+  IDAADJ_mem = IDA_mem->ida_adj_mem;
+
+  if (IDAADJ_mem->ia_maxckpnts <= 0) return;
+
+  /* The previous last check point is kept only if it is on the stride */
+  stride = IDAADJ_mem->ia_ckstride * IDAADJ_mem->ia_nsteps;
+  ck_memPtr = &(IDAADJ_mem->ck_mem->ck_next);
+  if ( ((*ck_memPtr)->ck_next != NULL) && ((*ck_memPtr)->ck_nst % stride != 0) )
+    IDAAckpntRemove(IDAADJ_mem, ck_memPtr);
+
+  /* Check points needed: those in the list (nckpnts and the initial one)
+     and those recomputed by IDASolveB */
+  levels = 0;
+  for (s=IDAADJ_mem->ia_ckstride; s>1; s/=2) levels++;
+
+  if ( (IDAADJ_mem->ia_nckpnts + 1 + levels <= IDAADJ_mem->ia_maxckpnts) ||
+       (IDAADJ_mem->ia_nckpnts < 2) ) return;
+
+  /* Double the stride and drop the check points that are not on it */
+  IDAADJ_mem->ia_ckstride *= 2;
+  stride = IDAADJ_mem->ia_ckstride * IDAADJ_mem->ia_nsteps;
+
+  ck_memPtr = &(IDAADJ_mem->ck_mem->ck_next);
+  while ((*ck_memPtr)->ck_next != NULL) {
+    if ((*ck_memPtr)->ck_nst % stride != 0)
+      IDAAckpntRemove(IDAADJ_mem, ck_memPtr);
+    else
+      ck_memPtr = &((*ck_memPtr)->ck_next);
+  }
+}
+
+/*
+ * IDAAckpntPrune
+ *
+ * This routine frees the check points recomputed by IDASolveB that
+ * are later than the end of the interval of ck_mem; the backward
+ * problems are done with them.
+ */
+
+static void IDAAckpntPrune(IDAadjMem IDAADJ_mem, CkpntMem ck_mem)
+{
+  CkpntMem *ck_memPtr;
+
+  ck_memPtr = &(IDAADJ_mem->ck_mem);
+  while ( (*ck_memPtr != ck_mem) && ((*ck_memPtr)->ck_next != ck_mem) ) {
+    if ((*ck_memPtr)->ck_temp)
+      IDAAckpntRemove(IDAADJ_mem, ck_memPtr);
+    else
+      ck_memPtr = &((*ck_memPtr)->ck_next);
+  }
+}
+
+/*
+ * IDAAckpntRefine
+ *
+ * If the interval of the check point *ck_memPtr spans more than
+ * nsteps steps (because IDASolveF dropped check points), this routine
+ * integrates from it to the middle of the interval and adds a check
+ * point there. It continues with the half in which the backward
+ * problems are, until the interval fits in dt_mem, and returns that
+ * check point.
+ */
+
+static int IDAAckpntRefine(IDAMem IDA_mem, CkpntMem *ck_memPtr,
+                           realtype tBout, int itaskB, int sign)
+{
+  IDAadjMem IDAADJ_mem;
+  CkpntMem ck_mem, newer, tmp;
+  long int nsteps, nst, nstmid;
+  realtype t;
+  int flag;
+
+  IDAADJ_mem = IDA_mem->ida_adj_mem;
+  nsteps = IDAADJ_mem->ia_nsteps;
+  ck_mem = *ck_memPtr;
+
+  for(;;) {
+
+    /* Find the next (later) check point; the last interval is never
+       longer than nsteps steps */
+    newer = NULL;
+    for (tmp = IDAADJ_mem->ck_mem; tmp != ck_mem; tmp = tmp->ck_next) newer = tmp;
+    if (newer == NULL) break;
+
+    nst = newer->ck_nst - ck_mem->ck_nst;
+    if (nst <= nsteps) break;
+
+    /* Integrate to the middle of the interval (on a multiple of nsteps,
+       as IDASolveF forced a setup there) */
+    nstmid = ck_mem->ck_nst + ((nst + nsteps - 1) / nsteps / 2) * nsteps;
+
+    flag = IDAAckpntGet(IDA_mem, ck_mem);
+    if (flag != IDA_SUCCESS) return(IDA_REIFWD_FAIL);
+
+    if (IDAADJ_mem->ia_tstopIDAFcall)
+      IDASetStopTime(IDA_mem, IDAADJ_mem->ia_tstopIDAF);
+
+    while (IDA_mem->ida_nst < nstmid) {
+      flag = IDASolve(IDA_mem, newer->ck_t0, &t, IDAADJ_mem->ia_yyTmp,
+                      IDAADJ_mem->ia_ypTmp, IDA_ONE_STEP);
+      if (flag < 0) return(IDA_FWD_FAIL);
+      if (IDA_mem->ida_nst % nsteps == 0) IDA_mem->ida_forceSetup = SUNTRUE;
+    }
+
+    /* Insert the new check point between ck_mem and newer */
+    tmp = IDAAckpntNew(IDA_mem);
+    if (tmp == NULL) return(IDA_MEM_FAIL);
+
+    tmp->ck_temp   = SUNTRUE;
+    tmp->ck_t1     = ck_mem->ck_t1;
+    ck_mem->ck_t1  = tmp->ck_t0;
+    tmp->ck_next   = ck_mem;
+    newer->ck_next = tmp;
+
+    /* Continue with the later half if a backward problem is there */
+    if (IDAAckpntNeeded(IDAADJ_mem, tmp, tBout, itaskB, sign)) ck_mem = tmp;
+
+  }
+
+  *ck_memPtr = ck_mem;
+
+  return(IDA_SUCCESS);
+}
+
+/*
+ * IDAAckpntNeeded
+ *
+ * This routine returns SUNTRUE if a backward problem must still be
+ * integrated over (part of) the interval of the check point ck_mem.
+ */
+
+static booleantype IDAAckpntNeeded(IDAadjMem IDAADJ_mem, CkpntMem ck_mem,
+                                   realtype tBout, int itaskB, int sign)
+{
+  IDABMem tmp_IDAB_mem;
+  realtype tBn;
+
+  tmp_IDAB_mem = IDAADJ_mem->IDAB_mem;
+  while(tmp_IDAB_mem != NULL) {
+    tBn = tmp_IDAB_mem->IDA_mem->ida_tn;
+
+    if ( sign*(tBn-ck_mem->ck_t0) > ZERO ) return(SUNTRUE);
+
+    if ( (itaskB == IDA_NORMAL) && (tBn == ck_mem->ck_t0) && (sign*(tBout-ck_mem->ck_t0) >= ZERO) )
+      return(SUNTRUE);
+
+    tmp_IDAB_mem = tmp_IDAB_mem->ida_next;
+  }
+
+  return(SUNFALSE);
+}
+
 /*
  * IDAAckpntAllocVectors
  *
@@ -2095,6 +2425,9 @@ static int IDAAdataStore(IDAMem IDA_mem, CkpntMem ck_mem)
                     IDAADJ_mem->ia_ypTmp, IDA_ONE_STEP);
     if (flag < 0) return(IDA_FWD_FAIL);
 
+    /* The steps of the forward run must be replayed exactly */
+    if (i > IDAADJ_mem->ia_nsteps) return(IDA_FWD_FAIL);
+
     dt_mem[i]->t = t;
     IDAADJ_mem->ia_storePnt(IDA_mem, dt_mem[i]);
 
@@ -2118,7 +2451,10 @@ static int IDAAdataStore(IDAMem IDA_mem, CkpntMem ck_mem)
 
 static int IDAAckpntGet(IDAMem IDA_mem, CkpntMem ck_mem)
 {
-  int flag, j, is;
+  IDAadjMem IDAADJ_mem;
+  int flag, j, is, nv;
+
+  IDAADJ_mem = IDA_mem->ida_adj_mem;
 
   if (ck_mem->ck_next == NULL) {
 
@@ -2167,6 +2503,26 @@ static int IDAAckpntGet(IDAMem IDA_mem, CkpntMem ck_mem)
     IDA_mem->ida_ss        = ck_mem->ck_ss;
     IDA_mem->ida_ssS       = ck_mem->ck_ssS;
 
+    for (j=0; j<MXORDP1; j++) {
+      IDA_mem->ida_psi[j]   = ck_mem->ck_psi[j];
+      IDA_mem->ida_alpha[j] = ck_mem->ck_alpha[j];
+      IDA_mem->ida_beta[j]  = ck_mem->ck_beta[j];
+      IDA_mem->ida_sigma[j] = ck_mem->ck_sigma[j];
+      IDA_mem->ida_gamma[j] = ck_mem->ck_gamma[j];
+    }
+
+    /* Force a call to setup */
+    IDA_mem->ida_forceSetup = SUNTRUE;
+
+    /* Load the arrays from the check point store */
+    if (ck_mem->ck_rec != NULL) {
+      nv = IDAAckpntVecs(IDA_mem, ck_mem);
+      if (nv < 0) return(IDA_MEM_FAIL);
+      flag = SUNAdjStore_Get(IDAADJ_mem->ia_ckstore, ck_mem->ck_rec,
+                             IDAADJ_mem->ia_ckvecs, nv);
+      if (flag != 0) return(IDA_VECTOROP_ERR);
+      return(IDA_SUCCESS);
+    }
 
     /* Copy the arrays from check point data structure */
     for (j=0; j<ck_mem->ck_phi_alloc; j++)
@@ -2190,17 +2546,6 @@ static int IDAAckpntGet(IDAMem IDA_mem, CkpntMem ck_mem)
           N_VScale(ONE, ck_mem->ck_phiQS[j][is], IDA_mem->ida_phiQS[j][is]);
       }
     }
-
-    for (j=0; j<MXORDP1; j++) {
-      IDA_mem->ida_psi[j]   = ck_mem->ck_psi[j];
-      IDA_mem->ida_alpha[j] = ck_mem->ck_alpha[j];
-      IDA_mem->ida_beta[j]  = ck_mem->ck_beta[j];
-      IDA_mem->ida_sigma[j] = ck_mem->ck_sigma[j];
-      IDA_mem->ida_gamma[j] = ck_mem->ck_gamma[j];
-    }
-
-    /* Force a call to setup */
-    IDA_mem->ida_forceSetup = SUNTRUE;
   }
 
   return(IDA_SUCCESS);
@@ -29,6 +29,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "idas_impl.h"
 #include <sundials/sundials_types.h>
@@ -79,6 +80,115 @@ SUNDIALS_EXPORT int IDAAdjSetNoSensi(void *ida_mem)
   return(IDA_SUCCESS);
 }
 
+/*
+ * -----------------------------------------------------------------
+ * IDAAdjSetCheckPointStorage
+ * -----------------------------------------------------------------
+ * Selects where the phi arrays of the check points are kept: in
+ * N_Vectors (IDA_CKPNT_MEMORY, the default), in a spill file in the
+ * directory dir (IDA_CKPNT_FILE), or compressed (IDA_CKPNT_ZLIB).
+ * Must be called before the first call to IDASolveF.
+ * -----------------------------------------------------------------
+ */
+
+SUNDIALS_EXPORT int IDAAdjSetCheckPointStorage(void *ida_mem, int storage,
+                                               const char *dir)
+{
+  IDAMem IDA_mem;
+  IDAadjMem IDAADJ_mem;
+
+  /* Is ida_mem valid? */
+  if (ida_mem == NULL) {
+    IDAProcessError(NULL, IDA_MEM_NULL, "IDAA", "IDAAdjSetCheckPointStorage", MSGAM_NULL_IDAMEM);
+    return IDA_MEM_NULL;
+  }
+  IDA_mem = (IDAMem) ida_mem;
+
+  /* Is ASA initialized? */
+  if (IDA_mem->ida_adjMallocDone == SUNFALSE) {
+    IDAProcessError(IDA_mem, IDA_NO_ADJ, "IDAA", "IDAAdjSetCheckPointStorage",  MSGAM_NO_ADJ);
+    return(IDA_NO_ADJ);
+  }
+  IDAADJ_mem = IDA_mem->ida_adj_mem;
+
+  if ( (storage != IDA_CKPNT_MEMORY) && (storage != IDA_CKPNT_FILE) &&
+       (storage != IDA_CKPNT_ZLIB) ) {
+    IDAProcessError(IDA_mem, IDA_ILL_INPUT, "IDAA", "IDAAdjSetCheckPointStorage", MSGAM_BAD_CKSTORE);
+    return(IDA_ILL_INPUT);
+  }
+
+  if (!SUNAdjStore_Available(storage)) {
+    IDAProcessError(IDA_mem, IDA_ILL_INPUT, "IDAA", "IDAAdjSetCheckPointStorage", MSGAM_BAD_CKSTORE);
+    return(IDA_ILL_INPUT);
+  }
+
+  if (!IDAADJ_mem->ia_firstIDAFcall) {
+    IDAProcessError(IDA_mem, IDA_ILL_INPUT, "IDAA", "IDAAdjSetCheckPointStorage", MSGAM_CKSTORE_SET);
+    return(IDA_ILL_INPUT);
+  }
+
+  /* The store is created in the first call to IDASolveF */
+  SUNAdjStore_Destroy(IDAADJ_mem->ia_ckstore);
+  IDAADJ_mem->ia_ckstore = NULL;
+
+  if (IDAADJ_mem->ia_ckstoreDir != NULL) {
+    free(IDAADJ_mem->ia_ckstoreDir);
+    IDAADJ_mem->ia_ckstoreDir = NULL;
+  }
+
+  if (dir != NULL) {
+    IDAADJ_mem->ia_ckstoreDir = (char *) malloc(strlen(dir)+1);
+    if (IDAADJ_mem->ia_ckstoreDir == NULL) {
+      IDAProcessError(IDA_mem, IDA_MEM_FAIL, "IDAA", "IDAAdjSetCheckPointStorage", MSGAM_MEM_FAIL);
+      return(IDA_MEM_FAIL);
+    }
+    strcpy(IDAADJ_mem->ia_ckstoreDir, dir);
+  }
+
+  IDAADJ_mem->ia_ckstoreType = storage;
+
+  return(IDA_SUCCESS);
+}
+
+/*
+ * -----------------------------------------------------------------
+ * IDAAdjSetMaxCheckPoints
+ * -----------------------------------------------------------------
+ * Sets the number of check points IDASolveF may keep (0 for no
+ * limit). Above it, IDASolveF keeps fewer check points further
+ * apart and IDASolveB recomputes the missing ones.
+ * -----------------------------------------------------------------
+ */
+
+SUNDIALS_EXPORT int IDAAdjSetMaxCheckPoints(void *ida_mem, int maxckpnts)
+{
+  IDAMem IDA_mem;
+  IDAadjMem IDAADJ_mem;
+
+  /* Is ida_mem valid? */
+  if (ida_mem == NULL) {
+    IDAProcessError(NULL, IDA_MEM_NULL, "IDAA", "IDAAdjSetMaxCheckPoints", MSGAM_NULL_IDAMEM);
+    return IDA_MEM_NULL;
+  }
+  IDA_mem = (IDAMem) ida_mem;
+
+  /* Is ASA initialized? */
+  if (IDA_mem->ida_adjMallocDone == SUNFALSE) {
+    IDAProcessError(IDA_mem, IDA_NO_ADJ, "IDAA", "IDAAdjSetMaxCheckPoints",  MSGAM_NO_ADJ);
+    return(IDA_NO_ADJ);
+  }
+  IDAADJ_mem = IDA_mem->ida_adj_mem;
+
+  if ( (maxckpnts != 0) && (maxckpnts < 2) ) {
+    IDAProcessError(IDA_mem, IDA_ILL_INPUT, "IDAA", "IDAAdjSetMaxCheckPoints", MSGAM_BAD_MAXCKPNTS);
+    return(IDA_ILL_INPUT);
+  }
+
+  IDAADJ_mem->ia_maxckpnts = maxckpnts;
+
+  return(IDA_SUCCESS);
+}
+
 /* 
  * -----------------------------------------------------------------
  * Optional input functions for backward integration
@@ -573,7 +683,14 @@ int IDAGetAdjCheckPointsInfo(void *ida_mem, IDAadjCheckPointRec *ckpnt)
   i=0;
   ck_mem = IDAADJ_mem->ck_mem;
   while (ck_mem != NULL) {
-    
+
+    /* Skip check points recomputed by IDASolveB, they are not counted
+       in the number of check points returned by IDASolveF */
+    if (ck_mem->ck_temp) {
+      ck_mem = ck_mem->ck_next;
+      continue;
+    }
+
     ckpnt[i].my_addr = (void *) ck_mem;
     ckpnt[i].next_addr = (void *) ck_mem->ck_next;
     ckpnt[i].t0 = ck_mem->ck_t0;
@@ -21,6 +21,7 @@
 #include <stdarg.h>
 
 #include "idas/idas.h"
+#include "sundials_adjstore.h"
 
 #ifdef __cplusplus  /* wrapper to enable C++ usage */
 extern "C" {
@@ -598,6 +599,13 @@ struct CkpntMemRec {
   /* How many phi, phiS, phiQ and phiQS were allocated? */
   int          ck_phi_alloc;
 
+  /* Record holding the phi arrays if they were moved to the check
+     point store (the N_Vectors above are then not allocated) */
+  SUNAdjRecord ck_rec;
+
+  /* Was the check point created by IDASolveB to split an interval? */
+  booleantype  ck_temp;
+
   /* Pointer to next structure in list */
   struct CkpntMemRec *ck_next;
 };
@@ -759,6 +767,20 @@ struct IDAadjMemRec {
   /* Number of checkpoints. */
   int ia_nckpnts;
 
+  /* Check point store (NULL if check points are kept in N_Vectors) */
+  int ia_ckstoreType;
+  char *ia_ckstoreDir;
+  SUNAdjStore ia_ckstore;
+
+  /* Workspace with the vectors saved in the check point store */
+  N_Vector *ia_ckvecs;
+  int ia_nckvecs;
+
+  /* Maximum number of check points (0 for no limit) and stride, in
+     units of nsteps, of the check points kept by IDASolveF */
+  int ia_maxckpnts;
+  long int ia_ckstride;
+
   /* ------------------
    * Interpolation data
    * ------------------ */
@@ -1148,6 +1170,11 @@ int IDASensResDQ(int Ns, realtype t,
 #define MSGAM_WRONG_INTERP "This function cannot be called for the specified interp type."
 #define MSGAM_MEM_FAIL     "A memory request failed."
 #define MSGAM_NO_INITBS    "Illegal attempt to call before calling IDAInitBS."
+#define MSGAM_BAD_CKSTORE  "Illegal value for storage, or the storage type is not available."
+#define MSGAM_CKSTORE_SET  "The check point storage cannot be changed after the first call to IDASolveF."
+#define MSGAM_CKSTORE_VEC  "The N_Vector does not provide the buffer operations needed by the check point storage."
+#define MSGAM_CKSTORE_FAIL "The check point storage could not be created."
+#define MSGAM_BAD_MAXCKPNTS "maxckpnts < 2 illegal."
 
 #ifdef __cplusplus
 }
@@ -23,6 +23,8 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
+#include <unistd.h>
 
 #include <nvector/nvector_pthreads.h>
 #include <sundials/sundials_math.h>
@@ -33,6 +35,67 @@
 #define ONE    RCONST(1.0)
 #define ONEPT5 RCONST(1.5)
 
+/* Size of a cache line in bytes. The loop partitions of the threads and the
+   thread data structs are aligned to it to avoid false sharing. */
+#define PT_CACHE_LINE 64
+
+/* Number of times an idle worker thread polls for new work before it goes
+   to sleep on a condition variable. The threads do not spin if the pool has
+   more threads than there are processors, since a spinning thread would then
+   hold up the threads it waits for. */
+#define PT_SPIN_COUNT 20000
+
+/* Atomic access to the pool state shared by the caller and the workers. If
+   the compiler does not provide atomic builtins, the state is only accessed
+   while holding the pool mutex and the workers do not spin. */
+#if defined(__GNUC__) || defined(__clang__)
+#define PT_ATOMICS
+#define PT_LOAD(p)     __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define PT_STORE(p,x)  __atomic_store_n((p), (x), __ATOMIC_RELEASE)
+#define PT_DEC(p)      __atomic_sub_fetch((p), 1, __ATOMIC_ACQ_REL)
+#else
+#define PT_LOAD(p)     (*(p))
+#define PT_STORE(p,x)  (*(p) = (x))
+#define PT_DEC(p)      (--(*(p)))
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#define PT_PAUSE() __builtin_ia32_pause()
+#else
+#define PT_PAUSE()
+#endif
+
+/* Argument passed to each worker thread */
+typedef struct {
+  struct _Pthreads_Pool *pool; /* pool of the worker  */
+  int                   id;    /* index of the worker */
+} Pthreads_Worker;
+
+/* Persistent pool of worker threads. Thread 0 of every operation is the
+   calling thread, threads 1 to num_threads-1 are the workers. An operation
+   is dispatched by storing the companion function and incrementing the
+   generation count, and it is done when pending drops to zero. */
+struct _Pthreads_Pool {
+  int             num_threads; /* number of threads, including the caller  */
+  int             nworkers;    /* number of worker threads started          */
+  int             spin_count;  /* number of polls before sleeping           */
+  int             refcount;    /* number of vectors using the pool          */
+  pthread_t       *threads;    /* worker threads                            */
+  Pthreads_Worker *workers;    /* arguments of the worker threads           */
+  void            *data_mem;   /* memory holding the thread data structs    */
+  Pthreads_Data   *data;       /* thread data structs, cache line aligned   */
+  void            *(*func)(void *); /* companion function being run        */
+  unsigned long   generation;  /* number of operations dispatched           */
+  int             pending;     /* number of workers still running func      */
+  int             shutdown;    /* set to tell the workers to exit           */
+  pthread_mutex_t run_lock;    /* held while an operation uses the pool     */
+  pthread_mutex_t lock;        /* protects refcount and the sleeping threads */
+  pthread_cond_t  wake;        /* signaled when an operation is dispatched  */
+  pthread_cond_t  done;        /* signaled when the last worker is done     */
+};
+
+typedef struct _Pthreads_Pool Pthreads_Pool;
+
 /* Private functions for special cases of vector operations */
 static void VCopy_Pthreads(N_Vector x, N_Vector z);                              /* z=x       */
 static void VSum_Pthreads(N_Vector x, N_Vector y, N_Vector z);                   /* z=x+y     */
@@ -121,6 +184,15 @@ static void N_VSplitLoop(int myid, int *nthreads, sunindextype *N,
 /* Function to initialize thread data */
 static void N_VInitThreadData(Pthreads_Data *thread_data);
 
+/* Functions to manage the persistent pool of worker threads */
+static Pthreads_Pool *N_VPoolCreate(int num_threads);
+static Pthreads_Pool *N_VPoolAttach(Pthreads_Pool *pool);
+static void N_VPoolDetach(Pthreads_Pool *pool);
+static void N_VPoolFree(Pthreads_Pool *pool);
+static Pthreads_Data *N_VPoolGetData(N_Vector v);
+static void N_VPoolRun(N_Vector v, void *(*func)(void *));
+static void *N_VPoolWorker(void *arg);
+
 /*
  * -----------------------------------------------------------------
  * exported functions
@@ -214,6 +286,11 @@ N_Vector N_VNewEmpty_Pthreads(sunindextype length, int num_threads)
   content->num_threads = num_threads;
   content->own_data    = SUNFALSE;
   content->data        = NULL;
+  content->pool        = NULL;
+
+  /* Create the thread pool */
+  content->pool = N_VPoolCreate(num_threads);
+  if (content->pool == NULL) { N_VDestroy(v); return(NULL); }
 
   return(v);
 }
@@ -421,6 +498,10 @@ N_Vector N_VCloneEmpty_Pthreads(N_Vector w)
   content->num_threads = NV_NUM_THREADS_PT(w);
   content->own_data    = SUNFALSE;
   content->data        = NULL;
+  content->pool        = NULL;
+
+  /* Share the thread pool of w */
+  content->pool = N_VPoolAttach(NV_CONTENT_PT(w)->pool);
 
   return(v);
 }
@@ -473,6 +554,7 @@ void N_VDestroy_Pthreads(N_Vector v)
       free(NV_DATA_PT(v));
       NV_DATA_PT(v) = NULL;
     }
+    N_VPoolDetach(NV_CONTENT_PT(v)->pool);
     free(v->content);
     v->content = NULL;
   }
@@ -527,9 +609,7 @@ void N_VLinearSum_Pthreads(realtype a, N_Vector x, realtype b, N_Vector y, N_Vec
 {
   sunindextype   N;
   int            i, nthreads;
-  pthread_t      *threads;
   Pthreads_Data  *thread_data;
-  pthread_attr_t attr;
 
   realtype c;
   N_Vector v1, v2;
@@ -602,15 +682,10 @@ void N_VLinearSum_Pthreads(realtype a, N_Vector x, realtype b, N_Vector y, N_Vec
      (2) a == 0.0, b == other - user should have called N_VScale
      (3) a,b == other, a !=b, a != -b */
 
-  /* allocate threads and thread data structs */
+  /* get thread data structs from the thread pool */
   N            = NV_LENGTH_PT(x);
   nthreads     = NV_NUM_THREADS_PT(x);
-  threads      = (pthread_t *) malloc(nthreads*sizeof(pthread_t));
-  thread_data  = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
-
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
+  thread_data  = N_VPoolGetData(x);
 
   for (i=0; i<nthreads; i++) {
     /* initialize thread data */
@@ -625,20 +700,10 @@ void N_VLinearSum_Pthreads(realtype a, N_Vector x, realtype b, N_Vector y, N_Vec
     thread_data[i].v1 = NV_DATA_PT(x);
     thread_data[i].v2 = NV_DATA_PT(y);
     thread_data[i].v3 = NV_DATA_PT(z);
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, N_VLinearSum_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
-
-  /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
-  free(thread_data);
+  /* run the companion function on the thread pool */
+  N_VPoolRun(x, N_VLinearSum_PT);
 
   return;
 }
@@ -672,7 +737,7 @@ static void *N_VLinearSum_PT(void *thread_data)
   }
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -684,19 +749,12 @@ void N_VConst_Pthreads(realtype c, N_Vector z)
 {
   sunindextype   N;
   int            i, nthreads;
-  pthread_t      *threads;
   Pthreads_Data  *thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* get thread data structs from the thread pool */
   N            = NV_LENGTH_PT(z);
   nthreads     = NV_NUM_THREADS_PT(z);
-  threads      = malloc(nthreads*sizeof(pthread_t));
-  thread_data  = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
-
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
+  thread_data  = N_VPoolGetData(z);
 
   for (i=0; i<nthreads; i++) {
     /* initialize thread data */
@@ -708,20 +766,10 @@ void N_VConst_Pthreads(realtype c, N_Vector z)
     /* pack thread data */
     thread_data[i].c1 = c;
     thread_data[i].v1 = NV_DATA_PT(z);
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, N_VConst_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
-
-  /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
-  free(thread_data);
+  /* run the companion function on the thread pool */
+  N_VPoolRun(z, N_VConst_PT);
 
   return;
 }
@@ -752,7 +800,7 @@ static void *N_VConst_PT(void *thread_data)
     zd[i] = c;
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -764,19 +812,12 @@ void N_VProd_Pthreads(N_Vector x, N_Vector y, N_Vector z)
 {
   sunindextype   N;
   int            i, nthreads;
-  pthread_t      *threads;
   Pthreads_Data  *thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* get thread data structs from the thread pool */
   N            = NV_LENGTH_PT(x);
   nthreads     = NV_NUM_THREADS_PT(x);
-  threads      = malloc(nthreads*sizeof(pthread_t));
-  thread_data  = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
-
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
+  thread_data  = N_VPoolGetData(x);
 
   for (i=0; i<nthreads; i++) {
     /* initialize thread data */
@@ -789,20 +830,10 @@ void N_VProd_Pthreads(N_Vector x, N_Vector y, N_Vector z)
     thread_data[i].v1 = NV_DATA_PT(x);
     thread_data[i].v2 = NV_DATA_PT(y);
     thread_data[i].v3 = NV_DATA_PT(z);
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, N_VProd_PT, (void *) &thread_data[i]);
-  }
-
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
   }
 
-  /* clean up and exit */
-  pthread_attr_destroy(&attr);
-  free(threads);
-  free(thread_data);
+  /* run the companion function on the thread pool */
+  N_VPoolRun(x, N_VProd_PT);
 
   return;
 }
@@ -832,7 +863,7 @@ static void *N_VProd_PT(void *thread_data)
     zd[i] = xd[i]*yd[i];
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -844,19 +875,12 @@ void N_VDiv_Pthreads(N_Vector x, N_Vector y, N_Vector z)
 {
   sunindextype   N;
   int            i, nthreads;
-  pthread_t      *threads;
   Pthreads_Data  *thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* get thread data structs from the thread pool */
   N            = NV_LENGTH_PT(x);
   nthreads     = NV_NUM_THREADS_PT(x);
-  threads      = malloc(nthreads*sizeof(pthread_t));
-  thread_data  = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
-
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
+  thread_data  = N_VPoolGetData(x);
 
   for (i=0; i<nthreads; i++) {
     /* initialize thread data */
@@ -869,20 +893,10 @@ void N_VDiv_Pthreads(N_Vector x, N_Vector y, N_Vector z)
     thread_data[i].v1 = NV_DATA_PT(x);
     thread_data[i].v2 = NV_DATA_PT(y);
     thread_data[i].v3 = NV_DATA_PT(z);
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, N_VDiv_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
-
-  /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
-  free(thread_data);
+  /* run the companion function on the thread pool */
+  N_VPoolRun(x, N_VDiv_PT);
 
   return;
 }
@@ -913,7 +927,7 @@ static void *N_VDiv_PT(void *thread_data)
     zd[i] = xd[i]/yd[i];
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -925,9 +939,7 @@ void N_VScale_Pthreads(realtype c, N_Vector x, N_Vector z)
 {
   sunindextype   N;
   int            i, nthreads;
-  pthread_t      *threads;
   Pthreads_Data  *thread_data;
-  pthread_attr_t attr;
 
   if (z == x) {  /* BLAS usage: scale x <- cx */
     VScaleBy_Pthreads(c, x);
@@ -939,15 +951,10 @@ void N_VScale_Pthreads(realtype c, N_Vector x, N_Vector z)
   } else if (c == -ONE) {
     VNeg_Pthreads(x, z);
   } else {
-    /* allocate threads and thread data structs */
+    /* get thread data structs from the thread pool */
     N            = NV_LENGTH_PT(x);
     nthreads     = NV_NUM_THREADS_PT(x);
-    threads      = malloc(nthreads*sizeof(pthread_t));
-    thread_data  = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
-
-    /* set thread attributes */
-    pthread_attr_init(&attr);
-    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
+    thread_data  = N_VPoolGetData(x);
 
     for (i=0; i<nthreads; i++) {
       /* initialize thread data */
@@ -960,20 +967,10 @@ void N_VScale_Pthreads(realtype c, N_Vector x, N_Vector z)
       thread_data[i].c1 = c;
       thread_data[i].v1 = NV_DATA_PT(x);
       thread_data[i].v2 = NV_DATA_PT(z);
-
-      /* create threads and call pthread companion function */
-      pthread_create(&threads[i], &attr, N_VScale_PT, (void *) &thread_data[i]);
     }
 
-    /* wait for all threads to finish */
-    for (i=0; i<nthreads; i++) {
-      pthread_join(threads[i], NULL);
-    }
-
-    /* clean up */
-    pthread_attr_destroy(&attr);
-    free(threads);
-    free(thread_data);
+    /* run the companion function on the thread pool */
+    N_VPoolRun(x, N_VScale_PT);
   }
 
   return;
@@ -1006,7 +1003,7 @@ static void *N_VScale_PT(void *thread_data)
     zd[i] = c*xd[i];
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -1018,19 +1015,12 @@ void N_VAbs_Pthreads(N_Vector x, N_Vector z)
 {
   sunindextype   N;
   int            i, nthreads;
-  pthread_t      *threads;
   Pthreads_Data  *thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* get thread data structs from the thread pool */
   N            = NV_LENGTH_PT(x);
   nthreads     = NV_NUM_THREADS_PT(x);
-  threads      = malloc(nthreads*sizeof(pthread_t));
-  thread_data  = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
-
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
+  thread_data  = N_VPoolGetData(x);
 
   for (i=0; i<nthreads; i++) {
     /* initialize thread data */
@@ -1042,20 +1032,10 @@ void N_VAbs_Pthreads(N_Vector x, N_Vector z)
     /* pack thread data */
     thread_data[i].v1 = NV_DATA_PT(x);
     thread_data[i].v2 = NV_DATA_PT(z);
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, N_VAbs_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
-
-  /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
-  free(thread_data);
+  /* run the companion function on the thread pool */
+  N_VPoolRun(x, N_VAbs_PT);
 
   return;
 }
@@ -1085,7 +1065,7 @@ static void *N_VAbs_PT(void *thread_data)
     zd[i] = SUNRabs(xd[i]);
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -1097,19 +1077,12 @@ void N_VInv_Pthreads(N_Vector x, N_Vector z)
 {
   sunindextype   N;
   int            i, nthreads;
-  pthread_t      *threads;
   Pthreads_Data  *thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* get thread data structs from the thread pool */
   N            = NV_LENGTH_PT(x);
   nthreads     = NV_NUM_THREADS_PT(x);
-  threads      = malloc(nthreads*sizeof(pthread_t));
-  thread_data  = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
-
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
+  thread_data  = N_VPoolGetData(x);
 
   for (i=0; i<nthreads; i++) {
     /* initialize thread data */
@@ -1121,20 +1094,10 @@ void N_VInv_Pthreads(N_Vector x, N_Vector z)
     /* pack thread data */
     thread_data[i].v1 = NV_DATA_PT(x);
     thread_data[i].v2 = NV_DATA_PT(z);
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, N_VInv_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
-
-  /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
-  free(thread_data);
+  /* run the companion function on the thread pool */
+  N_VPoolRun(x, N_VInv_PT);
 
   return;
 }
@@ -1164,7 +1127,7 @@ static void *N_VInv_PT(void *thread_data)
     zd[i] = ONE/xd[i];
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -1176,19 +1139,12 @@ void N_VAddConst_Pthreads(N_Vector x, realtype b, N_Vector z)
 {
   sunindextype   N;
   int            i, nthreads;
-  pthread_t      *threads;
   Pthreads_Data  *thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* get thread data structs from the thread pool */
   N            = NV_LENGTH_PT(x);
   nthreads     = NV_NUM_THREADS_PT(x);
-  threads      = malloc(nthreads*sizeof(pthread_t));
-  thread_data  = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
-
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
+  thread_data  = N_VPoolGetData(x);
 
   for (i=0; i<nthreads; i++) {
     /* initialize thread data */
@@ -1201,20 +1157,10 @@ void N_VAddConst_Pthreads(N_Vector x, realtype b, N_Vector z)
     thread_data[i].c1 = b;
     thread_data[i].v1 = NV_DATA_PT(x);
     thread_data[i].v2 = NV_DATA_PT(z);
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, N_VAddConst_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
-
-  /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
-  free(thread_data);
+  /* run the companion function on the thread pool */
+  N_VPoolRun(x, N_VAddConst_PT);
 
   return;
 }
@@ -1246,7 +1192,7 @@ static void *N_VAddConst_PT(void *thread_data)
     zd[i] = xd[i] + b;
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -1258,21 +1204,14 @@ realtype N_VDotProd_Pthreads(N_Vector x, N_Vector y)
 {
   sunindextype    N;
   int             i, nthreads;
-  pthread_t       *threads;
   Pthreads_Data   *thread_data;
-  pthread_attr_t  attr;
   pthread_mutex_t global_mutex;
   realtype        sum = ZERO;
 
-  /* allocate threads and thread data structs */
+  /* get thread data structs from the thread pool */
   N           = NV_LENGTH_PT(x);
   nthreads    = NV_NUM_THREADS_PT(x);
-  threads     = malloc(nthreads*sizeof(pthread_t));
-  thread_data = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
-
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
+  thread_data = N_VPoolGetData(x);
 
   /* lock for reduction */
   pthread_mutex_init(&global_mutex, NULL);
@@ -1289,21 +1228,13 @@ realtype N_VDotProd_Pthreads(N_Vector x, N_Vector y)
     thread_data[i].v2 = NV_DATA_PT(y);
     thread_data[i].global_val   = &sum;
     thread_data[i].global_mutex = &global_mutex;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, N_VDotProd_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
+  /* run the companion function on the thread pool */
+  N_VPoolRun(x, N_VDotProd_PT);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
   pthread_mutex_destroy(&global_mutex);
-  free(threads);
-  free(thread_data);
 
   return(sum);
 }
@@ -1344,7 +1275,7 @@ static void *N_VDotProd_PT(void *thread_data)
   pthread_mutex_unlock(global_mutex);
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -1356,21 +1287,14 @@ realtype N_VMaxNorm_Pthreads(N_Vector x)
 {
   sunindextype    N;
   int             i, nthreads;
-  pthread_t       *threads;
   Pthreads_Data   *thread_data;
-  pthread_attr_t  attr;
   pthread_mutex_t global_mutex;
   realtype        max = ZERO;
 
-  /* allocate threads and thread data structs */
+  /* get thread data structs from the thread pool */
   N            = NV_LENGTH_PT(x);
   nthreads     = NV_NUM_THREADS_PT(x);
-  threads      = malloc(nthreads*sizeof(pthread_t));
-  thread_data  = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
-
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
+  thread_data  = N_VPoolGetData(x);
 
   /* lock for reduction */
   pthread_mutex_init(&global_mutex, NULL);
@@ -1386,21 +1310,13 @@ realtype N_VMaxNorm_Pthreads(N_Vector x)
     thread_data[i].v1 = NV_DATA_PT(x);
     thread_data[i].global_val   = &max;
     thread_data[i].global_mutex = &global_mutex;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, N_VMaxNorm_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
+  /* run the companion function on the thread pool */
+  N_VPoolRun(x, N_VMaxNorm_PT);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
   pthread_mutex_destroy(&global_mutex);
-  free(threads);
-  free(thread_data);
 
   return(max);
 }
@@ -1442,7 +1358,7 @@ static void *N_VMaxNorm_PT(void *thread_data)
   pthread_mutex_unlock(global_mutex);
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -1464,21 +1380,14 @@ realtype N_VWSqrSumLocal_Pthreads(N_Vector x, N_Vector w)
 {
   sunindextype    N;
   int             i, nthreads;
-  pthread_t       *threads;
   Pthreads_Data   *thread_data;
-  pthread_attr_t  attr;
   pthread_mutex_t global_mutex;
   realtype        sum = ZERO;
 
-  /* allocate threads and thread data structs */
+  /* get thread data structs from the thread pool */
   N           = NV_LENGTH_PT(x);
   nthreads    = NV_NUM_THREADS_PT(x);
-  threads     = malloc(nthreads*sizeof(pthread_t));
-  thread_data = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
-
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
+  thread_data = N_VPoolGetData(x);
 
   /* lock for reduction */
   pthread_mutex_init(&global_mutex, NULL);
@@ -1495,21 +1404,13 @@ realtype N_VWSqrSumLocal_Pthreads(N_Vector x, N_Vector w)
     thread_data[i].v2 = NV_DATA_PT(w);
     thread_data[i].global_val   = &sum;
     thread_data[i].global_mutex = &global_mutex;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, N_VWSqrSum_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
+  /* run the companion function on the thread pool */
+  N_VPoolRun(x, N_VWSqrSum_PT);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
   pthread_mutex_destroy(&global_mutex);
-  free(threads);
-  free(thread_data);
 
   return(sum);
 }
@@ -1550,7 +1451,7 @@ static void *N_VWSqrSum_PT(void *thread_data)
   pthread_mutex_unlock(global_mutex);
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -1572,21 +1473,14 @@ realtype N_VWSqrSumMaskLocal_Pthreads(N_Vector x, N_Vector w, N_Vector id)
 {
   sunindextype    N;
   int             i, nthreads;
-  pthread_t       *threads;
   Pthreads_Data   *thread_data;
-  pthread_attr_t  attr;
   pthread_mutex_t global_mutex;
   realtype        sum = ZERO;
 
-  /* allocate threads and thread data structs */
+  /* get thread data structs from the thread pool */
   N            = NV_LENGTH_PT(x);
   nthreads     = NV_NUM_THREADS_PT(x);
-  threads      = malloc(nthreads*sizeof(pthread_t));
-  thread_data  = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
-
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
+  thread_data  = N_VPoolGetData(x);
 
   /* lock for reduction */
   pthread_mutex_init(&global_mutex, NULL);
@@ -1604,21 +1498,13 @@ realtype N_VWSqrSumMaskLocal_Pthreads(N_Vector x, N_Vector w, N_Vector id)
     thread_data[i].v3 = NV_DATA_PT(id);
     thread_data[i].global_val   = &sum;
     thread_data[i].global_mutex = &global_mutex;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, N_VWSqrSumMask_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
+  /* run the companion function on the thread pool */
+  N_VPoolRun(x, N_VWSqrSumMask_PT);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
   pthread_mutex_destroy(&global_mutex);
-  free(threads);
-  free(thread_data);
 
   return(sum);
 }
@@ -1662,7 +1548,7 @@ static void *N_VWSqrSumMask_PT(void *thread_data)
   pthread_mutex_unlock(global_mutex);
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -1674,24 +1560,17 @@ realtype N_VMin_Pthreads(N_Vector x)
 {
   sunindextype    N;
   int             i, nthreads;
-  pthread_t       *threads;
   Pthreads_Data   *thread_data;
-  pthread_attr_t  attr;
   pthread_mutex_t global_mutex;
   realtype        min;
 
   /* initialize global min */
   min = NV_Ith_PT(x,0);
 
-  /* allocate threads and thread data structs */
+  /* get thread data structs from the thread pool */
   N           = NV_LENGTH_PT(x);
   nthreads    = NV_NUM_THREADS_PT(x);
-  threads     = malloc(nthreads*sizeof(pthread_t));
-  thread_data = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
-
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
+  thread_data = N_VPoolGetData(x);
 
   /* lock for reduction */
   pthread_mutex_init(&global_mutex, NULL);
@@ -1707,21 +1586,13 @@ realtype N_VMin_Pthreads(N_Vector x)
     thread_data[i].v1 = NV_DATA_PT(x);
     thread_data[i].global_val   = &min;
     thread_data[i].global_mutex = &global_mutex;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, N_VMin_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
+  /* run the companion function on the thread pool */
+  N_VPoolRun(x, N_VMin_PT);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
   pthread_mutex_destroy(&global_mutex);
-  free(threads);
-  free(thread_data);
 
   return(min);
 }
@@ -1764,7 +1635,7 @@ static void *N_VMin_PT(void *thread_data)
   pthread_mutex_unlock(global_mutex);
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -1776,21 +1647,14 @@ realtype N_VWL2Norm_Pthreads(N_Vector x, N_Vector w)
 {
   sunindextype    N;
   int             i, nthreads;
-  pthread_t       *threads;
   Pthreads_Data   *thread_data;
-  pthread_attr_t  attr;
   pthread_mutex_t global_mutex;
   realtype        sum = ZERO;
 
-  /* allocate threads and thread data structs */
+  /* get thread data structs from the thread pool */
   N           = NV_LENGTH_PT(x);
   nthreads    = NV_NUM_THREADS_PT(x);
-  threads     = malloc(nthreads*sizeof(pthread_t));
-  thread_data = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
-
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
+  thread_data = N_VPoolGetData(x);
 
   /* lock for reduction */
   pthread_mutex_init(&global_mutex, NULL);
@@ -1807,21 +1671,13 @@ realtype N_VWL2Norm_Pthreads(N_Vector x, N_Vector w)
     thread_data[i].v2 = NV_DATA_PT(w);
     thread_data[i].global_val   = &sum;
     thread_data[i].global_mutex = &global_mutex;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, N_VWL2Norm_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
+  /* run the companion function on the thread pool */
+  N_VPoolRun(x, N_VWL2Norm_PT);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
   pthread_mutex_destroy(&global_mutex);
-  free(threads);
-  free(thread_data);
 
   return(SUNRsqrt(sum));
 }
@@ -1862,7 +1718,7 @@ static void *N_VWL2Norm_PT(void *thread_data)
   pthread_mutex_unlock(global_mutex);
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -1874,21 +1730,14 @@ realtype N_VL1Norm_Pthreads(N_Vector x)
 {
   sunindextype    N;
   int             i, nthreads;
-  pthread_t       *threads;
   Pthreads_Data   *thread_data;
-  pthread_attr_t  attr;
   pthread_mutex_t global_mutex;
   realtype        sum = ZERO;
 
-  /* allocate threads and thread data structs */
+  /* get thread data structs from the thread pool */
   N            = NV_LENGTH_PT(x);
   nthreads     = NV_NUM_THREADS_PT(x);
-  threads      = malloc(nthreads*sizeof(pthread_t));
-  thread_data  = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
-
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
+  thread_data  = N_VPoolGetData(x);
 
   /* lock for reduction */
   pthread_mutex_init(&global_mutex, NULL);
@@ -1904,21 +1753,13 @@ realtype N_VL1Norm_Pthreads(N_Vector x)
     thread_data[i].v1 = NV_DATA_PT(x);
     thread_data[i].global_val   = &sum;
     thread_data[i].global_mutex = &global_mutex;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, N_VL1Norm_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
+  /* run the companion function on the thread pool */
+  N_VPoolRun(x, N_VL1Norm_PT);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
   pthread_mutex_destroy(&global_mutex);
-  free(threads);
-  free(thread_data);
 
   return(sum);
 }
@@ -1958,7 +1799,7 @@ static void *N_VL1Norm_PT(void *thread_data)
   pthread_mutex_unlock(global_mutex);
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -1970,19 +1811,12 @@ void N_VCompare_Pthreads(realtype c, N_Vector x, N_Vector z)
 {
   sunindextype   N;
   int            i, nthreads;
-  pthread_t      *threads;
   Pthreads_Data  *thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* get thread data structs from the thread pool */
   N            = NV_LENGTH_PT(x);
   nthreads     = NV_NUM_THREADS_PT(x);
-  threads      = malloc(nthreads*sizeof(pthread_t));
-  thread_data  = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
-
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
+  thread_data  = N_VPoolGetData(x);
 
   for (i=0; i<nthreads; i++) {
     /* initialize thread data */
@@ -1995,20 +1829,10 @@ void N_VCompare_Pthreads(realtype c, N_Vector x, N_Vector z)
     thread_data[i].c1  = c;
     thread_data[i].v1 = NV_DATA_PT(x);
     thread_data[i].v2 = NV_DATA_PT(z);
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, N_VCompare_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
-
-  /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
-  free(thread_data);
+  /* run the companion function on the thread pool */
+  N_VPoolRun(x, N_VCompare_PT);
 
   return;
 }
@@ -2039,7 +1863,7 @@ static void *N_VCompare_PT(void *thread_data)
     zd[i] = (SUNRabs(xd[i]) >= c) ? ONE : ZERO;
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -2051,21 +1875,14 @@ booleantype N_VInvTest_Pthreads(N_Vector x, N_Vector z)
 {
   sunindextype   N;
   int            i, nthreads;
-  pthread_t      *threads;
   Pthreads_Data  *thread_data;
-  pthread_attr_t attr;
 
   realtype val = ZERO;
 
-  /* allocate threads and thread data structs */
+  /* get thread data structs from the thread pool */
   N           = NV_LENGTH_PT(x);
   nthreads    = NV_NUM_THREADS_PT(x);
-  threads     = malloc(nthreads*sizeof(pthread_t));
-  thread_data = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
-
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
+  thread_data = N_VPoolGetData(x);
 
   for (i=0; i<nthreads; i++) {
     /* initialize thread data */
@@ -2078,20 +1895,10 @@ booleantype N_VInvTest_Pthreads(N_Vector x, N_Vector z)
     thread_data[i].v1 = NV_DATA_PT(x);
     thread_data[i].v2 = NV_DATA_PT(z);
     thread_data[i].global_val = &val;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, N_VInvTest_PT, (void *) &thread_data[i]);
-  }
-
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
   }
 
-  /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
-  free(thread_data);
+  /* run the companion function on the thread pool */
+  N_VPoolRun(x, N_VInvTest_PT);
 
   if (val > ZERO)
     return (SUNFALSE);
@@ -2137,7 +1944,7 @@ static void *N_VInvTest_PT(void *thread_data)
   }
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -2149,21 +1956,14 @@ booleantype N_VConstrMask_Pthreads(N_Vector c, N_Vector x, N_Vector m)
 {
   sunindextype   N;
   int            i, nthreads;
-  pthread_t      *threads;
   Pthreads_Data  *thread_data;
-  pthread_attr_t attr;
 
   realtype val = ZERO;
 
-  /* allocate threads and thread data structs */
+  /* get thread data structs from the thread pool */
   N           = NV_LENGTH_PT(x);
   nthreads    = NV_NUM_THREADS_PT(x);
-  threads     = malloc(nthreads*sizeof(pthread_t));
-  thread_data = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
-
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
+  thread_data = N_VPoolGetData(x);
 
   for (i=0; i<nthreads; i++) {
     /* initialize thread data */
@@ -2177,20 +1977,10 @@ booleantype N_VConstrMask_Pthreads(N_Vector c, N_Vector x, N_Vector m)
     thread_data[i].v2 = NV_DATA_PT(x);
     thread_data[i].v3 = NV_DATA_PT(m);
     thread_data[i].global_val = &val;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, N_VConstrMask_PT, (void *) &thread_data[i]);
-  }
-
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
   }
 
-  /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
-  free(thread_data);
+  /* run the companion function on the thread pool */
+  N_VPoolRun(x, N_VConstrMask_PT);
 
   if (val > ZERO)
     return(SUNFALSE);
@@ -2244,7 +2034,7 @@ static void *N_VConstrMask_PT(void *thread_data)
   }
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -2256,21 +2046,14 @@ realtype N_VMinQuotient_Pthreads(N_Vector num, N_Vector denom)
 {
   sunindextype    N;
   int             i, nthreads;
-  pthread_t       *threads;
   Pthreads_Data   *thread_data;
-  pthread_attr_t  attr;
   pthread_mutex_t global_mutex;
   realtype        min = BIG_REAL;
 
-  /* allocate threads and thread data structs */
+  /* get thread data structs from the thread pool */
   N           = NV_LENGTH_PT(num);
   nthreads    = NV_NUM_THREADS_PT(num);
-  threads     = malloc(nthreads*sizeof(pthread_t));
-  thread_data = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
-
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
+  thread_data = N_VPoolGetData(num);
 
   /* lock for reduction */
   pthread_mutex_init(&global_mutex, NULL);
@@ -2287,21 +2070,13 @@ realtype N_VMinQuotient_Pthreads(N_Vector num, N_Vector denom)
     thread_data[i].v2 = NV_DATA_PT(denom);
     thread_data[i].global_val   = &min;
     thread_data[i].global_mutex = &global_mutex;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, N_VMinQuotient_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
+  /* run the companion function on the thread pool */
+  N_VPoolRun(num, N_VMinQuotient_PT);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
   pthread_mutex_destroy(&global_mutex);
-  free(threads);
-  free(thread_data);
 
   return(min);
 }
@@ -2346,7 +2121,7 @@ static void *N_VMinQuotient_PT(void *thread_data)
   pthread_mutex_unlock(global_mutex);
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -2365,9 +2140,7 @@ int N_VLinearCombination_Pthreads(int nvec, realtype* c, N_Vector* X, N_Vector z
 {
   sunindextype   N;
   int            i, nthreads;
-  pthread_t      *threads;
   Pthreads_Data  *thread_data;
-  pthread_attr_t attr;
 
   /* invalid number of vectors */
   if (nvec < 1) return(-1);
@@ -2387,12 +2160,7 @@ int N_VLinearCombination_Pthreads(int nvec, realtype* c, N_Vector* X, N_Vector z
   /* get vector length and data array */
   N           = NV_LENGTH_PT(z);
   nthreads    = NV_NUM_THREADS_PT(z);
-  threads     = malloc(nthreads*sizeof(pthread_t));
-  thread_data = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
-
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
+  thread_data = N_VPoolGetData(z);
 
   for (i=0; i<nthreads; i++) {
     /* initialize thread data */
@@ -2406,20 +2174,10 @@ int N_VLinearCombination_Pthreads(int nvec, realtype* c, N_Vector* X, N_Vector z
     thread_data[i].cvals = c;
     thread_data[i].Y1    = X;
     thread_data[i].x1    = z;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, N_VLinearCombination_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
-
-  /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
-  free(thread_data);
+  /* run the companion function on the thread pool */
+  N_VPoolRun(z, N_VLinearCombination_PT);
 
   return(0);
 }
@@ -2458,7 +2216,7 @@ static void *N_VLinearCombination_PT(void *thread_data)
         zd[j] += c[i] * xd[j];
       }
     }
-    pthread_exit(NULL);
+    return(NULL);
   }
 
   /*
@@ -2474,7 +2232,7 @@ static void *N_VLinearCombination_PT(void *thread_data)
         zd[j] += c[i] * xd[j];
       }
     }
-    pthread_exit(NULL);
+    return(NULL);
   }
 
   /*
@@ -2490,7 +2248,7 @@ static void *N_VLinearCombination_PT(void *thread_data)
       zd[j] += c[i] * xd[j];
     }
   }
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -2502,9 +2260,7 @@ int N_VScaleAddMulti_Pthreads(int nvec, realtype* a, N_Vector x, N_Vector* Y, N_
 {
   sunindextype   N;
   int            i, nthreads;
-  pthread_t      *threads;
   Pthreads_Data  *thread_data;
-  pthread_attr_t attr;
 
   /* invalid number of vectors */
   if (nvec < 1) return(-1);
@@ -2518,12 +2274,7 @@ int N_VScaleAddMulti_Pthreads(int nvec, realtype* a, N_Vector x, N_Vector* Y, N_
   /* get vector length and data array */
   N           = NV_LENGTH_PT(x);
   nthreads    = NV_NUM_THREADS_PT(x);
-  threads     = malloc(nthreads*sizeof(pthread_t));
-  thread_data = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
-
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
+  thread_data = N_VPoolGetData(x);
 
   for (i=0; i<nthreads; i++) {
     /* initialize thread data */
@@ -2538,20 +2289,10 @@ int N_VScaleAddMulti_Pthreads(int nvec, realtype* a, N_Vector x, N_Vector* Y, N_
     thread_data[i].x1    = x;
     thread_data[i].Y1    = Y;
     thread_data[i].Y2    = Z;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, N_VScaleAddMulti_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
-
-  /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
-  free(thread_data);
+  /* run the companion function on the thread pool */
+  N_VPoolRun(x, N_VScaleAddMulti_PT);
 
   return(0);
 }
@@ -2591,7 +2332,7 @@ static void *N_VScaleAddMulti_PT(void *thread_data)
         yd[j] += a[i] * xd[j];
       }
     }
-    pthread_exit(NULL);
+    return(NULL);
   }
 
   /*
@@ -2604,7 +2345,7 @@ static void *N_VScaleAddMulti_PT(void *thread_data)
       zd[j] = a[i] * xd[j] + yd[j];
     }
   }
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -2616,9 +2357,7 @@ int N_VDotProdMulti_Pthreads(int nvec, N_Vector x, N_Vector* Y, realtype* dotpro
 {
   sunindextype    N;
   int             i, nthreads;
-  pthread_t       *threads;
   Pthreads_Data   *thread_data;
-  pthread_attr_t  attr;
   pthread_mutex_t global_mutex;
 
   /* invalid number of vectors */
@@ -2634,15 +2373,10 @@ int N_VDotProdMulti_Pthreads(int nvec, N_Vector x, N_Vector* Y, realtype* dotpro
   for (i=0; i<nvec; i++)
     dotprods[i] = ZERO;
 
-  /* allocate threads and thread data structs */
+  /* get thread data structs from the thread pool */
   N           = NV_LENGTH_PT(x);
   nthreads    = NV_NUM_THREADS_PT(x);
-  threads     = malloc(nthreads*sizeof(pthread_t));
-  thread_data = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
-
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
+  thread_data = N_VPoolGetData(x);
 
   /* lock for reduction */
   pthread_mutex_init(&global_mutex, NULL);
@@ -2661,21 +2395,13 @@ int N_VDotProdMulti_Pthreads(int nvec, N_Vector x, N_Vector* Y, realtype* dotpro
     thread_data[i].cvals = dotprods;
 
     thread_data[i].global_mutex = &global_mutex;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, N_VDotProdMulti_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
+  /* run the companion function on the thread pool */
+  N_VPoolRun(x, N_VDotProdMulti_PT);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
   pthread_mutex_destroy(&global_mutex);
-  free(threads);
-  free(thread_data);
 
   return(0);
 }
@@ -2721,7 +2447,7 @@ static void *N_VDotProdMulti_PT(void *thread_data)
   }
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -2741,9 +2467,7 @@ int N_VLinearSumVectorArray_Pthreads(int nvec, realtype a, N_Vector* X,
 {
   sunindextype   N;
   int            i, nthreads;
-  pthread_t      *threads;
   Pthreads_Data  *thread_data;
-  pthread_attr_t attr;
 
   realtype    c;
   N_Vector*  V1;
@@ -2818,12 +2542,7 @@ int N_VLinearSumVectorArray_Pthreads(int nvec, realtype a, N_Vector* X,
   /* get vector length and data array */
   N           = NV_LENGTH_PT(Z[0]);
   nthreads    = NV_NUM_THREADS_PT(Z[0]);
-  threads     = malloc(nthreads*sizeof(pthread_t));
-  thread_data = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
-
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
+  thread_data = N_VPoolGetData(Z[0]);
 
   for (i=0; i<nthreads; i++) {
     /* initialize thread data */
@@ -2839,21 +2558,10 @@ int N_VLinearSumVectorArray_Pthreads(int nvec, realtype a, N_Vector* X,
     thread_data[i].Y1   = X;
     thread_data[i].Y2   = Y;
     thread_data[i].Y3   = Z;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, N_VLinearSumVectorArray_PT,
-                   (void *) &thread_data[i]);
-  }
-
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
   }
 
-  /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
-  free(thread_data);
+  /* run the companion function on the thread pool */
+  N_VPoolRun(Z[0], N_VLinearSumVectorArray_PT);
 
   return(0);
 }
@@ -2894,7 +2602,7 @@ static void *N_VLinearSumVectorArray_PT(void *thread_data)
   }
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -2906,9 +2614,7 @@ int N_VScaleVectorArray_Pthreads(int nvec, realtype* c, N_Vector* X, N_Vector* Z
 {
   sunindextype   N;
   int            i, nthreads;
-  pthread_t      *threads;
   Pthreads_Data  *thread_data;
-  pthread_attr_t attr;
 
   /* invalid number of vectors */
   if (nvec < 1) return(-1);
@@ -2922,12 +2628,7 @@ int N_VScaleVectorArray_Pthreads(int nvec, realtype* c, N_Vector* X, N_Vector* Z
   /* get vector length and data array */
   N           = NV_LENGTH_PT(Z[0]);
   nthreads    = NV_NUM_THREADS_PT(Z[0]);
-  threads     = malloc(nthreads*sizeof(pthread_t));
-  thread_data = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
-
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
+  thread_data = N_VPoolGetData(Z[0]);
 
   for (i=0; i<nthreads; i++) {
     /* initialize thread data */
@@ -2941,21 +2642,10 @@ int N_VScaleVectorArray_Pthreads(int nvec, realtype* c, N_Vector* X, N_Vector* Z
     thread_data[i].cvals = c;
     thread_data[i].Y1    = X;
     thread_data[i].Y2    = Z;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, N_VScaleVectorArray_PT,
-                   (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
-
-  /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
-  free(thread_data);
+  /* run the companion function on the thread pool */
+  N_VPoolRun(Z[0], N_VScaleVectorArray_PT);
 
   return(0);
 }
@@ -2993,7 +2683,7 @@ static void *N_VScaleVectorArray_PT(void *thread_data)
         xd[j] *= c[i];
       }
     }
-    pthread_exit(NULL);
+    return(NULL);
   }
 
   /*
@@ -3006,7 +2696,7 @@ static void *N_VScaleVectorArray_PT(void *thread_data)
       zd[j] = c[i] * xd[j];
     }
   }
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -3018,9 +2708,7 @@ int N_VConstVectorArray_Pthreads(int nvec, realtype c, N_Vector* Z)
 {
   sunindextype   N;
   int            i, nthreads;
-  pthread_t      *threads;
   Pthreads_Data  *thread_data;
-  pthread_attr_t attr;
 
   /* invalid number of vectors */
   if (nvec < 1) return(-1);
@@ -3034,12 +2722,7 @@ int N_VConstVectorArray_Pthreads(int nvec, realtype c, N_Vector* Z)
   /* get vector length and data array */
   N           = NV_LENGTH_PT(Z[0]);
   nthreads    = NV_NUM_THREADS_PT(Z[0]);
-  threads     = malloc(nthreads*sizeof(pthread_t));
-  thread_data = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
-
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
+  thread_data = N_VPoolGetData(Z[0]);
 
   for (i=0; i<nthreads; i++) {
     /* initialize thread data */
@@ -3052,21 +2735,10 @@ int N_VConstVectorArray_Pthreads(int nvec, realtype c, N_Vector* Z)
     thread_data[i].nvec = nvec;
     thread_data[i].c1   = c;
     thread_data[i].Y1   = Z;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, N_VConstVectorArray_PT,
-                   (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
-
-  /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
-  free(thread_data);
+  /* run the companion function on the thread pool */
+  N_VPoolRun(Z[0], N_VConstVectorArray_PT);
 
   return(0);
 }
@@ -3099,7 +2771,7 @@ static void *N_VConstVectorArray_PT(void *thread_data)
   }
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -3111,9 +2783,7 @@ int N_VWrmsNormVectorArray_Pthreads(int nvec, N_Vector* X, N_Vector* W, realtype
 {
   sunindextype    N;
   int             i, nthreads;
-  pthread_t       *threads;
   Pthreads_Data   *thread_data;
-  pthread_attr_t  attr;
   pthread_mutex_t global_mutex;
 
   /* invalid number of vectors */
@@ -3129,15 +2799,10 @@ int N_VWrmsNormVectorArray_Pthreads(int nvec, N_Vector* X, N_Vector* W, realtype
   for (i=0; i<nvec; i++)
     nrm[i] = ZERO;
 
-  /* allocate threads and thread data structs */
+  /* get thread data structs from the thread pool */
   N           = NV_LENGTH_PT(X[0]);
   nthreads    = NV_NUM_THREADS_PT(X[0]);
-  threads     = malloc(nthreads*sizeof(pthread_t));
-  thread_data = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
-
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
+  thread_data = N_VPoolGetData(X[0]);
 
   /* lock for reduction */
   pthread_mutex_init(&global_mutex, NULL);
@@ -3156,26 +2821,17 @@ int N_VWrmsNormVectorArray_Pthreads(int nvec, N_Vector* X, N_Vector* W, realtype
     thread_data[i].cvals = nrm;
 
     thread_data[i].global_mutex = &global_mutex;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, N_VWrmsNormVectorArray_PT,
-                   (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
+  /* run the companion function on the thread pool */
+  N_VPoolRun(X[0], N_VWrmsNormVectorArray_PT);
 
   /* finalize wrms calculation */
   for (i=0; i<nvec; i++)
     nrm[i] = SUNRsqrt(nrm[i]/N);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
   pthread_mutex_destroy(&global_mutex);
-  free(threads);
-  free(thread_data);
 
   return(0);
 }
@@ -3221,7 +2877,7 @@ static void *N_VWrmsNormVectorArray_PT(void *thread_data)
   }
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -3234,9 +2890,7 @@ int N_VWrmsNormMaskVectorArray_Pthreads(int nvec, N_Vector* X, N_Vector* W,
 {
   sunindextype    N;
   int             i, nthreads;
-  pthread_t       *threads;
   Pthreads_Data   *thread_data;
-  pthread_attr_t  attr;
   pthread_mutex_t global_mutex;
 
   /* invalid number of vectors */
@@ -3252,15 +2906,10 @@ int N_VWrmsNormMaskVectorArray_Pthreads(int nvec, N_Vector* X, N_Vector* W,
   for (i=0; i<nvec; i++)
     nrm[i] = ZERO;
 
-  /* allocate threads and thread data structs */
+  /* get thread data structs from the thread pool */
   N           = NV_LENGTH_PT(X[0]);
   nthreads    = NV_NUM_THREADS_PT(X[0]);
-  threads     = malloc(nthreads*sizeof(pthread_t));
-  thread_data = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
-
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
+  thread_data = N_VPoolGetData(X[0]);
 
   /* lock for reduction */
   pthread_mutex_init(&global_mutex, NULL);
@@ -3280,26 +2929,17 @@ int N_VWrmsNormMaskVectorArray_Pthreads(int nvec, N_Vector* X, N_Vector* W,
     thread_data[i].cvals = nrm;
 
     thread_data[i].global_mutex = &global_mutex;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, N_VWrmsNormMaskVectorArray_PT,
-                   (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
+  /* run the companion function on the thread pool */
+  N_VPoolRun(X[0], N_VWrmsNormMaskVectorArray_PT);
 
   /* finalize wrms calculation */
   for (i=0; i<nvec; i++)
     nrm[i] = SUNRsqrt(nrm[i]/N);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
   pthread_mutex_destroy(&global_mutex);
-  free(threads);
-  free(thread_data);
 
   return(0);
 }
@@ -3348,7 +2988,7 @@ static void *N_VWrmsNormMaskVectorArray_PT(void *thread_data)
   }
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -3361,9 +3001,7 @@ int N_VScaleAddMultiVectorArray_Pthreads(int nvec, int nsum, realtype* a,
 {
   sunindextype   N;
   int            i, j, nthreads;
-  pthread_t      *threads;
   Pthreads_Data  *thread_data;
-  pthread_attr_t attr;
 
   int          retval;
   N_Vector*   YY;
@@ -3418,12 +3056,7 @@ int N_VScaleAddMultiVectorArray_Pthreads(int nvec, int nsum, realtype* a,
   /* get vector length and data array */
   N           = NV_LENGTH_PT(X[0]);
   nthreads    = NV_NUM_THREADS_PT(X[0]);
-  threads     = malloc(nthreads*sizeof(pthread_t));
-  thread_data = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
-
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
+  thread_data = N_VPoolGetData(X[0]);
 
   for (i=0; i<nthreads; i++) {
     /* initialize thread data */
@@ -3439,21 +3072,10 @@ int N_VScaleAddMultiVectorArray_Pthreads(int nvec, int nsum, realtype* a,
     thread_data[i].Y1    = X;
     thread_data[i].ZZ1   = Y;
     thread_data[i].ZZ2   = Z;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, N_VScaleAddMultiVectorArray_PT,
-                   (void *) &thread_data[i]);
-  }
-
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
   }
 
-  /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
-  free(thread_data);
+  /* run the companion function on the thread pool */
+  N_VPoolRun(X[0], N_VScaleAddMultiVectorArray_PT);
 
   return(0);
 }
@@ -3495,7 +3117,7 @@ static void *N_VScaleAddMultiVectorArray_PT(void *thread_data)
         }
       }
     }
-    pthread_exit(NULL);
+    return(NULL);
   }
 
   /*
@@ -3511,7 +3133,7 @@ static void *N_VScaleAddMultiVectorArray_PT(void *thread_data)
       }
     }
   }
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -3524,9 +3146,7 @@ int N_VLinearCombinationVectorArray_Pthreads(int nvec, int nsum, realtype* c,
 {
   sunindextype   N;
   int            i, j, nthreads;
-  pthread_t      *threads;
   Pthreads_Data  *thread_data;
-  pthread_attr_t attr;
 
   int          retval;
   realtype*    ctmp;
@@ -3599,12 +3219,7 @@ int N_VLinearCombinationVectorArray_Pthreads(int nvec, int nsum, realtype* c,
   /* get vector length and data array */
   N           = NV_LENGTH_PT(Z[0]);
   nthreads    = NV_NUM_THREADS_PT(Z[0]);
-  threads     = malloc(nthreads*sizeof(pthread_t));
-  thread_data = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
-
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
+  thread_data = N_VPoolGetData(Z[0]);
 
   for (i=0; i<nthreads; i++) {
     /* initialize thread data */
@@ -3619,21 +3234,10 @@ int N_VLinearCombinationVectorArray_Pthreads(int nvec, int nsum, realtype* c,
     thread_data[i].cvals = c;
     thread_data[i].ZZ1   = X;
     thread_data[i].Y1    = Z;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, N_VLinearCombinationVectorArray_PT,
-                   (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
-
-  /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
-  free(thread_data);
+  /* run the companion function on the thread pool */
+  N_VPoolRun(Z[0], N_VLinearCombinationVectorArray_PT);
 
   return(0);
 }
@@ -3675,7 +3279,7 @@ static void *N_VLinearCombinationVectorArray_PT(void *thread_data)
         }
       }
     }
-    pthread_exit(NULL);
+    return(NULL);
   }
 
   /*
@@ -3694,7 +3298,7 @@ static void *N_VLinearCombinationVectorArray_PT(void *thread_data)
         }
       }
     }
-    pthread_exit(NULL);
+    return(NULL);
   }
 
   /*
@@ -3713,7 +3317,7 @@ static void *N_VLinearCombinationVectorArray_PT(void *thread_data)
       }
     }
   }
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -3745,21 +3349,14 @@ int N_VBufPack_Pthreads(N_Vector x, void *buf)
 {
   sunindextype   N;
   int            i, nthreads;
-  pthread_t      *threads;
   Pthreads_Data  *thread_data;
-  pthread_attr_t attr;
 
   if (x == NULL || buf == NULL) return(-1);
 
-  /* allocate threads and thread data structs */
+  /* get thread data structs from the thread pool */
   N           = NV_LENGTH_PT(x);
   nthreads    = NV_NUM_THREADS_PT(x);
-  threads     = malloc(nthreads*sizeof(pthread_t));
-  thread_data = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
-
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
+  thread_data = N_VPoolGetData(x);
 
   for (i=0; i<nthreads; i++) {
     /* initialize thread data */
@@ -3771,20 +3368,10 @@ int N_VBufPack_Pthreads(N_Vector x, void *buf)
     /* pack thread data */
     thread_data[i].v1 = NV_DATA_PT(x);
     thread_data[i].v2 = (realtype*)buf;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, VBufPack_PT, (void *) &thread_data[i]);
-  }
-
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
   }
 
-  /* clean up */
-  pthread_attr_destroy(&attr);
-  free(threads);
-  free(thread_data);
+  /* run the companion function on the thread pool */
+  N_VPoolRun(x, VBufPack_PT);
 
   return(0);
 }
@@ -3815,7 +3402,7 @@ static void *VBufPack_PT(void *thread_data)
     bd[i] = xd[i];
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -3827,21 +3414,14 @@ int N_VBufUnpack_Pthreads(N_Vector x, void *buf)
 {
   sunindextype   N;
   int            i, nthreads;
-  pthread_t      *threads;
   Pthreads_Data  *thread_data;
-  pthread_attr_t attr;
 
   if (x == NULL || buf == NULL) return(-1);
 
-  /* allocate threads and thread data structs */
+  /* get thread data structs from the thread pool */
   N           = NV_LENGTH_PT(x);
   nthreads    = NV_NUM_THREADS_PT(x);
-  threads     = malloc(nthreads*sizeof(pthread_t));
-  thread_data = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
-
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
+  thread_data = N_VPoolGetData(x);
 
   for (i=0; i<nthreads; i++) {
     /* initialize thread data */
@@ -3853,20 +3433,10 @@ int N_VBufUnpack_Pthreads(N_Vector x, void *buf)
     /* pack thread data */
     thread_data[i].v1 = NV_DATA_PT(x);
     thread_data[i].v2 = (realtype*)buf;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, VBufUnpack_PT, (void *) &thread_data[i]);
-  }
-
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
   }
 
-  /* clean up */
-  pthread_attr_destroy(&attr);
-  free(threads);
-  free(thread_data);
+  /* run the companion function on the thread pool */
+  N_VPoolRun(x, VBufUnpack_PT);
 
   return(0);
 }
@@ -3897,7 +3467,7 @@ static void *VBufUnpack_PT(void *thread_data)
     xd[i] = bd[i];
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -3916,19 +3486,12 @@ static void VCopy_Pthreads(N_Vector x, N_Vector z)
 {
   sunindextype      N;
   int           i, nthreads;
-  pthread_t     *threads;
   Pthreads_Data *thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* get thread data structs from the thread pool */
   N            = NV_LENGTH_PT(x);
   nthreads     = NV_NUM_THREADS_PT(x);
-  threads      = malloc(nthreads*sizeof(pthread_t));
-  thread_data  = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
-
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
+  thread_data  = N_VPoolGetData(x);
 
   for (i=0; i<nthreads; i++) {
     /* initialize thread data */
@@ -3940,20 +3503,10 @@ static void VCopy_Pthreads(N_Vector x, N_Vector z)
     /* pack thread data */
     thread_data[i].v1 = NV_DATA_PT(x);
     thread_data[i].v2 = NV_DATA_PT(z);
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, VCopy_PT, (void *) &thread_data[i]);
-  }
-
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
   }
 
-  /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
-  free(thread_data);
+  /* run the companion function on the thread pool */
+  N_VPoolRun(x, VCopy_PT);
 
   return;
 }
@@ -3983,7 +3536,7 @@ static void *VCopy_PT(void *thread_data)
     zd[i] = xd[i];
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -3995,19 +3548,12 @@ static void VSum_Pthreads(N_Vector x, N_Vector y, N_Vector z)
 {
   sunindextype      N;
   int           i, nthreads;
-  pthread_t     *threads;
   Pthreads_Data *thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* get thread data structs from the thread pool */
   N            = NV_LENGTH_PT(x);
   nthreads     = NV_NUM_THREADS_PT(x);
-  threads      = malloc(nthreads*sizeof(pthread_t));
-  thread_data  = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
-
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
+  thread_data  = N_VPoolGetData(x);
 
   for (i=0; i<nthreads; i++) {
     /* initialize thread data */
@@ -4020,20 +3566,10 @@ static void VSum_Pthreads(N_Vector x, N_Vector y, N_Vector z)
     thread_data[i].v1 = NV_DATA_PT(x);
     thread_data[i].v2 = NV_DATA_PT(y);
     thread_data[i].v3 = NV_DATA_PT(z);
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, VSum_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
-
-  /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
-  free(thread_data);
+  /* run the companion function on the thread pool */
+  N_VPoolRun(x, VSum_PT);
 
   return;
 }
@@ -4064,7 +3600,7 @@ static void *VSum_PT(void *thread_data)
     zd[i] = xd[i] + yd[i];
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -4076,19 +3612,12 @@ static void VDiff_Pthreads(N_Vector x, N_Vector y, N_Vector z)
 {
   sunindextype  N;
   int           i, nthreads;
-  pthread_t     *threads;
   Pthreads_Data *thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* get thread data structs from the thread pool */
   N            = NV_LENGTH_PT(x);
   nthreads     = NV_NUM_THREADS_PT(x);
-  threads      = malloc(nthreads*sizeof(pthread_t));
-  thread_data  = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
-
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
+  thread_data  = N_VPoolGetData(x);
 
   for (i=0; i<nthreads; i++) {
     /* initialize thread data */
@@ -4101,20 +3630,10 @@ static void VDiff_Pthreads(N_Vector x, N_Vector y, N_Vector z)
     thread_data[i].v1 = NV_DATA_PT(x);
     thread_data[i].v2 = NV_DATA_PT(y);
     thread_data[i].v3 = NV_DATA_PT(z);
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, VDiff_PT, (void *) &thread_data[i]);
-  }
-
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
   }
 
-  /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
-  free(thread_data);
+  /* run the companion function on the thread pool */
+  N_VPoolRun(x, VDiff_PT);
 
   return;
 }
@@ -4145,7 +3664,7 @@ static void *VDiff_PT(void *thread_data)
     zd[i] = xd[i] - yd[i];
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -4157,19 +3676,12 @@ static void VNeg_Pthreads(N_Vector x, N_Vector z)
 {
   sunindextype  N;
   int           i, nthreads;
-  pthread_t     *threads;
   Pthreads_Data *thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* get thread data structs from the thread pool */
   N            = NV_LENGTH_PT(x);
   nthreads     = NV_NUM_THREADS_PT(x);
-  threads      = malloc(nthreads*sizeof(pthread_t));
-  thread_data  = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
-
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
+  thread_data  = N_VPoolGetData(x);
 
   for (i=0; i<nthreads; i++) {
     /* initialize thread data */
@@ -4181,20 +3693,10 @@ static void VNeg_Pthreads(N_Vector x, N_Vector z)
     /* pack thread data */
     thread_data[i].v1 = NV_DATA_PT(x);
     thread_data[i].v2 = NV_DATA_PT(z);
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, VNeg_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
-
-  /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
-  free(thread_data);
+  /* run the companion function on the thread pool */
+  N_VPoolRun(x, VNeg_PT);
 
   return;
 }
@@ -4224,7 +3726,7 @@ static void *VNeg_PT(void *thread_data)
     zd[i] = -xd[i];
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -4236,19 +3738,12 @@ static void VScaleSum_Pthreads(realtype c, N_Vector x, N_Vector y, N_Vector z)
 {
   sunindextype  N;
   int           i, nthreads;
-  pthread_t     *threads;
   Pthreads_Data *thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* get thread data structs from the thread pool */
   N            = NV_LENGTH_PT(x);
   nthreads     = NV_NUM_THREADS_PT(x);
-  threads      = malloc(nthreads*sizeof(pthread_t));
-  thread_data  = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
-
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
+  thread_data  = N_VPoolGetData(x);
 
   for (i=0; i<nthreads; i++) {
     /* initialize thread data */
@@ -4262,20 +3757,10 @@ static void VScaleSum_Pthreads(realtype c, N_Vector x, N_Vector y, N_Vector z)
     thread_data[i].v1 = NV_DATA_PT(x);
     thread_data[i].v2 = NV_DATA_PT(y);
     thread_data[i].v3 = NV_DATA_PT(z);
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, VScaleSum_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
-
-  /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
-  free(thread_data);
+  /* run the companion function on the thread pool */
+  N_VPoolRun(x, VScaleSum_PT);
 
   return;
 }
@@ -4308,7 +3793,7 @@ static void *VScaleSum_PT(void *thread_data)
     zd[i] = c*(xd[i] + yd[i]);
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -4320,19 +3805,12 @@ static void VScaleDiff_Pthreads(realtype c, N_Vector x, N_Vector y, N_Vector z)
 {
   sunindextype  N;
   int           i, nthreads;
-  pthread_t     *threads;
   Pthreads_Data *thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* get thread data structs from the thread pool */
   N            = NV_LENGTH_PT(x);
   nthreads     = NV_NUM_THREADS_PT(x);
-  threads      = malloc(nthreads*sizeof(pthread_t));
-  thread_data  = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
-
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
+  thread_data  = N_VPoolGetData(x);
 
   for (i=0; i<nthreads; i++) {
     /* initialize thread data */
@@ -4346,20 +3824,10 @@ static void VScaleDiff_Pthreads(realtype c, N_Vector x, N_Vector y, N_Vector z)
     thread_data[i].v1 = NV_DATA_PT(x);
     thread_data[i].v2 = NV_DATA_PT(y);
     thread_data[i].v3 = NV_DATA_PT(z);
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, VScaleDiff_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
-
-  /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
-  free(thread_data);
+  /* run the companion function on the thread pool */
+  N_VPoolRun(x, VScaleDiff_PT);
 
   return;
 }
@@ -4392,7 +3860,7 @@ static void *VScaleDiff_PT(void *thread_data)
     zd[i] = c*(xd[i] - yd[i]);
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -4404,19 +3872,12 @@ static void VLin1_Pthreads(realtype a, N_Vector x, N_Vector y, N_Vector z)
 {
   sunindextype  N;
   int           i, nthreads;
-  pthread_t     *threads;
   Pthreads_Data *thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* get thread data structs from the thread pool */
   N            = NV_LENGTH_PT(x);
   nthreads     = NV_NUM_THREADS_PT(x);
-  threads      = malloc(nthreads*sizeof(pthread_t));
-  thread_data  = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
-
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
+  thread_data  = N_VPoolGetData(x);
 
   for (i=0; i<nthreads; i++) {
     /* initialize thread data */
@@ -4430,20 +3891,10 @@ static void VLin1_Pthreads(realtype a, N_Vector x, N_Vector y, N_Vector z)
     thread_data[i].v1 = NV_DATA_PT(x);
     thread_data[i].v2 = NV_DATA_PT(y);
     thread_data[i].v3 = NV_DATA_PT(z);
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, VLin1_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
-
-  /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
-  free(thread_data);
+  /* run the companion function on the thread pool */
+  N_VPoolRun(x, VLin1_PT);
 
   return;
 }
@@ -4476,7 +3927,7 @@ static void *VLin1_PT(void *thread_data)
     zd[i] = (a*xd[i]) + yd[i];
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -4488,19 +3939,12 @@ static void VLin2_Pthreads(realtype a, N_Vector x, N_Vector y, N_Vector z)
 {
   sunindextype  N;
   int           i, nthreads;
-  pthread_t     *threads;
   Pthreads_Data *thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* get thread data structs from the thread pool */
   N            = NV_LENGTH_PT(x);
   nthreads     = NV_NUM_THREADS_PT(x);
-  threads      = malloc(nthreads*sizeof(pthread_t));
-  thread_data  = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
-
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
+  thread_data  = N_VPoolGetData(x);
 
   for (i=0; i<nthreads; i++) {
     /* initialize thread data */
@@ -4514,20 +3958,10 @@ static void VLin2_Pthreads(realtype a, N_Vector x, N_Vector y, N_Vector z)
     thread_data[i].v1 = NV_DATA_PT(x);
     thread_data[i].v2 = NV_DATA_PT(y);
     thread_data[i].v3 = NV_DATA_PT(z);
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, VLin2_PT, (void *) &thread_data[i]);
-  }
-
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
   }
 
-  /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
-  free(thread_data);
+  /* run the companion function on the thread pool */
+  N_VPoolRun(x, VLin2_PT);
 
   return;
 }
@@ -4559,7 +3993,7 @@ static void *VLin2_PT(void *thread_data)
     zd[i] = (a*xd[i]) - yd[i];
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -4571,19 +4005,12 @@ static void Vaxpy_Pthreads(realtype a, N_Vector x, N_Vector y)
 {
   sunindextype  N;
   int           i, nthreads;
-  pthread_t     *threads;
   Pthreads_Data *thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* get thread data structs from the thread pool */
   N            = NV_LENGTH_PT(x);
   nthreads     = NV_NUM_THREADS_PT(x);
-  threads      = malloc(nthreads*sizeof(pthread_t));
-  thread_data  = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
-
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
+  thread_data  = N_VPoolGetData(x);
 
   for (i=0; i<nthreads; i++) {
     /* initialize thread data */
@@ -4596,20 +4023,10 @@ static void Vaxpy_Pthreads(realtype a, N_Vector x, N_Vector y)
     thread_data[i].c1 = a;
     thread_data[i].v1 = NV_DATA_PT(x);
     thread_data[i].v2 = NV_DATA_PT(y);
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, Vaxpy_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
-
-  /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
-  free(thread_data);
+  /* run the companion function on the thread pool */
+  N_VPoolRun(x, Vaxpy_PT);
 
   return;
 }
@@ -4641,7 +4058,7 @@ static void *Vaxpy_PT(void *thread_data)
       yd[i] += xd[i];
 
     /* exit */
-    pthread_exit(NULL);
+    return(NULL);
   }
 
   if (a == -ONE) {
@@ -4649,14 +4066,14 @@ static void *Vaxpy_PT(void *thread_data)
       yd[i] -= xd[i];
 
     /* exit */
-    pthread_exit(NULL);
+    return(NULL);
   }
 
   for (i = start; i < end; i++)
     yd[i] += a*xd[i];
 
   /* return */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -4668,19 +4085,12 @@ static void VScaleBy_Pthreads(realtype a, N_Vector x)
 {
   sunindextype  N;
   int           i, nthreads;
-  pthread_t     *threads;
   Pthreads_Data *thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* get thread data structs from the thread pool */
   N            = NV_LENGTH_PT(x);
   nthreads     = NV_NUM_THREADS_PT(x);
-  threads      = malloc(nthreads*sizeof(pthread_t));
-  thread_data  = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
-
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
+  thread_data  = N_VPoolGetData(x);
 
   for (i=0; i<nthreads; i++) {
     /* initialize thread data */
@@ -4692,20 +4102,10 @@ static void VScaleBy_Pthreads(realtype a, N_Vector x)
     /* pack thread data */
     thread_data[i].c1 = a;
     thread_data[i].v1 = NV_DATA_PT(x);
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, VScaleBy_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++) {
-    pthread_join(threads[i], NULL);
-  }
-
-  /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
-  free(thread_data);
+  /* run the companion function on the thread pool */
+  N_VPoolRun(x, VScaleBy_PT);
 
   return;
 }
@@ -4736,7 +4136,7 @@ static void *VScaleBy_PT(void *thread_data)
     xd[i] *= a;
 
   /* exit */
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -4750,21 +4150,14 @@ static int VSumVectorArray_Pthreads(int nvec, N_Vector* X, N_Vector* Y, N_Vector
 {
   sunindextype   N;
   int            i, nthreads;
-  pthread_t      *threads;
   Pthreads_Data  *thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* get thread data structs from the thread pool */
   N           = NV_LENGTH_PT(X[0]);
   nthreads    = NV_NUM_THREADS_PT(X[0]);
-  threads     = malloc(nthreads*sizeof(pthread_t));
-  thread_data = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
-
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
+  thread_data = N_VPoolGetData(X[0]);
 
-  /* pack thread data, distribute loop indices, and create threads/call kernel */
+  /* pack thread data and distribute loop indices */
   for (i=0; i<nthreads; i++) {
     N_VInitThreadData(&thread_data[i]);
 
@@ -4774,18 +4167,10 @@ static int VSumVectorArray_Pthreads(int nvec, N_Vector* X, N_Vector* Y, N_Vector
     thread_data[i].Y3   = Z;
 
     N_VSplitLoop(i, &nthreads, &N, &thread_data[i].start, &thread_data[i].end);
-
-    pthread_create(&threads[i], &attr, VSumVectorArray_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++)
-    pthread_join(threads[i], NULL);
-
-  /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
-  free(thread_data);
+  /* run the companion function on the thread pool */
+  N_VPoolRun(X[0], VSumVectorArray_PT);
 
   return(0);
 }
@@ -4812,7 +4197,7 @@ static void *VSumVectorArray_PT(void *thread_data)
       zd[j] = xd[j] + yd[j];
   }
 
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -4820,21 +4205,14 @@ static int VDiffVectorArray_Pthreads(int nvec, N_Vector* X, N_Vector* Y, N_Vecto
 {
   sunindextype   N;
   int            i, nthreads;
-  pthread_t      *threads;
   Pthreads_Data  *thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* get thread data structs from the thread pool */
   N           = NV_LENGTH_PT(X[0]);
   nthreads    = NV_NUM_THREADS_PT(X[0]);
-  threads     = malloc(nthreads*sizeof(pthread_t));
-  thread_data = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
-
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
+  thread_data = N_VPoolGetData(X[0]);
 
-  /* pack thread data, distribute loop indices, and create threads/call kernel */
+  /* pack thread data and distribute loop indices */
   for (i=0; i<nthreads; i++) {
     N_VInitThreadData(&thread_data[i]);
 
@@ -4844,18 +4222,10 @@ static int VDiffVectorArray_Pthreads(int nvec, N_Vector* X, N_Vector* Y, N_Vecto
     thread_data[i].Y3   = Z;
 
     N_VSplitLoop(i, &nthreads, &N, &thread_data[i].start, &thread_data[i].end);
-
-    pthread_create(&threads[i], &attr, VDiffVectorArray_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++)
-    pthread_join(threads[i], NULL);
-
-  /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
-  free(thread_data);
+  /* run the companion function on the thread pool */
+  N_VPoolRun(X[0], VDiffVectorArray_PT);
 
   return(0);
 }
@@ -4882,7 +4252,7 @@ static void *VDiffVectorArray_PT(void *thread_data)
       zd[j] = xd[j] - yd[j];
   }
 
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -4890,21 +4260,14 @@ static int VScaleSumVectorArray_Pthreads(int nvec, realtype c, N_Vector* X, N_Ve
 {
   sunindextype   N;
   int            i, nthreads;
-  pthread_t      *threads;
   Pthreads_Data  *thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* get thread data structs from the thread pool */
   N            = NV_LENGTH_PT(X[0]);
   nthreads     = NV_NUM_THREADS_PT(X[0]);
-  threads      = malloc(nthreads*sizeof(pthread_t));
-  thread_data  = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
+  thread_data  = N_VPoolGetData(X[0]);
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
-  /* pack thread data, distribute loop indices, and create threads/call kernel */
+  /* pack thread data and distribute loop indices */
   for (i=0; i<nthreads; i++) {
     N_VInitThreadData(&thread_data[i]);
 
@@ -4915,18 +4278,10 @@ static int VScaleSumVectorArray_Pthreads(int nvec, realtype c, N_Vector* X, N_Ve
     thread_data[i].Y3   = Z;
 
     N_VSplitLoop(i, &nthreads, &N, &thread_data[i].start, &thread_data[i].end);
-
-    pthread_create(&threads[i], &attr, VScaleSumVectorArray_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++)
-    pthread_join(threads[i], NULL);
-
-  /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
-  free(thread_data);
+  /* run the companion function on the thread pool */
+  N_VPoolRun(X[0], VScaleSumVectorArray_PT);
 
   return(0);
 }
@@ -4955,7 +4310,7 @@ static void *VScaleSumVectorArray_PT(void *thread_data)
       zd[j] = c * (xd[j] + yd[j]);
   }
 
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -4963,21 +4318,14 @@ static int VScaleDiffVectorArray_Pthreads(int nvec, realtype c, N_Vector* X, N_V
 {
   sunindextype   N;
   int            i, nthreads;
-  pthread_t      *threads;
   Pthreads_Data  *thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* get thread data structs from the thread pool */
   N           = NV_LENGTH_PT(X[0]);
   nthreads    = NV_NUM_THREADS_PT(X[0]);
-  threads     = malloc(nthreads*sizeof(pthread_t));
-  thread_data = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
-
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
+  thread_data = N_VPoolGetData(X[0]);
 
-  /* pack thread data, distribute loop indices, and create threads/call kernel */
+  /* pack thread data and distribute loop indices */
   for (i=0; i<nthreads; i++) {
     N_VInitThreadData(&thread_data[i]);
 
@@ -4988,18 +4336,10 @@ static int VScaleDiffVectorArray_Pthreads(int nvec, realtype c, N_Vector* X, N_V
     thread_data[i].Y3   = Z;
 
     N_VSplitLoop(i, &nthreads, &N, &thread_data[i].start, &thread_data[i].end);
-
-    pthread_create(&threads[i], &attr, VScaleDiffVectorArray_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++)
-    pthread_join(threads[i], NULL);
-
-  /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
-  free(thread_data);
+  /* run the companion function on the thread pool */
+  N_VPoolRun(X[0], VScaleDiffVectorArray_PT);
 
   return(0);
 }
@@ -5028,7 +4368,7 @@ static void *VScaleDiffVectorArray_PT(void *thread_data)
       zd[j] = c * (xd[j] - yd[j]);
   }
 
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -5036,21 +4376,14 @@ static int VLin1VectorArray_Pthreads(int nvec, realtype a, N_Vector* X, N_Vector
 {
   sunindextype   N;
   int            i, nthreads;
-  pthread_t      *threads;
   Pthreads_Data  *thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* get thread data structs from the thread pool */
   N           = NV_LENGTH_PT(X[0]);
   nthreads    = NV_NUM_THREADS_PT(X[0]);
-  threads     = malloc(nthreads*sizeof(pthread_t));
-  thread_data = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
-
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
+  thread_data = N_VPoolGetData(X[0]);
 
-  /* pack thread data, distribute loop indices, and create threads/call kernel */
+  /* pack thread data and distribute loop indices */
   for (i=0; i<nthreads; i++) {
     N_VInitThreadData(&thread_data[i]);
 
@@ -5061,18 +4394,10 @@ static int VLin1VectorArray_Pthreads(int nvec, realtype a, N_Vector* X, N_Vector
     thread_data[i].Y3   = Z;
 
     N_VSplitLoop(i, &nthreads, &N, &thread_data[i].start, &thread_data[i].end);
-
-    pthread_create(&threads[i], &attr, VLin1VectorArray_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++)
-    pthread_join(threads[i], NULL);
-
-  /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
-  free(thread_data);
+  /* run the companion function on the thread pool */
+  N_VPoolRun(X[0], VLin1VectorArray_PT);
 
   return(0);
 }
@@ -5101,7 +4426,7 @@ static void *VLin1VectorArray_PT(void *thread_data)
       zd[j] = (a * xd[j]) + yd[j];
   }
 
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -5109,21 +4434,14 @@ static int VLin2VectorArray_Pthreads(int nvec, realtype a, N_Vector* X, N_Vector
 {
   sunindextype   N;
   int            i, nthreads;
-  pthread_t      *threads;
   Pthreads_Data  *thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* get thread data structs from the thread pool */
   N           = NV_LENGTH_PT(X[0]);
   nthreads    = NV_NUM_THREADS_PT(X[0]);
-  threads     = malloc(nthreads*sizeof(pthread_t));
-  thread_data = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
-
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
+  thread_data = N_VPoolGetData(X[0]);
 
-  /* pack thread data, distribute loop indices, and create threads/call kernel */
+  /* pack thread data and distribute loop indices */
   for (i=0; i<nthreads; i++) {
     N_VInitThreadData(&thread_data[i]);
 
@@ -5134,18 +4452,10 @@ static int VLin2VectorArray_Pthreads(int nvec, realtype a, N_Vector* X, N_Vector
     thread_data[i].Y3   = Z;
 
     N_VSplitLoop(i, &nthreads, &N, &thread_data[i].start, &thread_data[i].end);
-
-    pthread_create(&threads[i], &attr, VLin2VectorArray_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++)
-    pthread_join(threads[i], NULL);
-
-  /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
-  free(thread_data);
+  /* run the companion function on the thread pool */
+  N_VPoolRun(X[0], VLin2VectorArray_PT);
 
   return(0);
 }
@@ -5174,7 +4484,7 @@ static void *VLin2VectorArray_PT(void *thread_data)
       zd[j] = (a * xd[j]) - yd[j];
   }
 
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -5182,21 +4492,14 @@ static int VaxpyVectorArray_Pthreads(int nvec, realtype a, N_Vector* X, N_Vector
 {
   sunindextype   N;
   int            i, nthreads;
-  pthread_t      *threads;
   Pthreads_Data  *thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* get thread data structs from the thread pool */
   N           = NV_LENGTH_PT(X[0]);
   nthreads    = NV_NUM_THREADS_PT(X[0]);
-  threads     = malloc(nthreads*sizeof(pthread_t));
-  thread_data = (Pthreads_Data *) malloc(nthreads*sizeof(struct _Pthreads_Data));
-
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
+  thread_data = N_VPoolGetData(X[0]);
 
-  /* pack thread data, distribute loop indices, and create threads/call kernel */
+  /* pack thread data and distribute loop indices */
   for (i=0; i<nthreads; i++) {
     N_VInitThreadData(&thread_data[i]);
 
@@ -5206,18 +4509,10 @@ static int VaxpyVectorArray_Pthreads(int nvec, realtype a, N_Vector* X, N_Vector
     thread_data[i].Y2   = Y;
 
     N_VSplitLoop(i, &nthreads, &N, &thread_data[i].start, &thread_data[i].end);
-
-    pthread_create(&threads[i], &attr, VaxpyVectorArray_PT, (void *) &thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i=0; i<nthreads; i++)
-    pthread_join(threads[i], NULL);
-
-  /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
-  free(thread_data);
+  /* run the companion function on the thread pool */
+  N_VPoolRun(X[0], VaxpyVectorArray_PT);
 
   return(0);
 }
@@ -5244,7 +4539,7 @@ static void *VaxpyVectorArray_PT(void *thread_data)
       for (j=start; j<end; j++)
         yd[j] += xd[j];
     }
-    pthread_exit(NULL);
+    return(NULL);
   }
 
   if (a == -ONE) {
@@ -5254,7 +4549,7 @@ static void *VaxpyVectorArray_PT(void *thread_data)
       for (j=start; j<end; j++)
         yd[j] -= xd[j];
     }
-    pthread_exit(NULL);
+    return(NULL);
   }
 
   for (i=0; i<my_data->nvec; i++) {
@@ -5263,7 +4558,7 @@ static void *VaxpyVectorArray_PT(void *thread_data)
     for (j=start; j<end; j++)
       yd[j] += a * xd[j];
   }
-  pthread_exit(NULL);
+  return(NULL);
 }
 
 
@@ -5274,13 +4569,37 @@ static void *VaxpyVectorArray_PT(void *thread_data)
  */
 
 /* ----------------------------------------------------------------------------
- * Determine loop indices for a thread
+ * Determine loop indices for a thread. If every thread gets at least one cache
+ * line of entries, the work is split in whole cache lines (the last thread
+ * also gets the remaining entries) so that no two threads write to the same
+ * cache line.
  */
 
 static void N_VSplitLoop(int myid, int *nthreads, sunindextype *N,
 			 sunindextype *start, sunindextype *end)
 {
   sunindextype q, r; /* quotient and remainder */
+  sunindextype b;    /* entries per cache line */
+
+  b = PT_CACHE_LINE / sizeof(realtype);
+
+  if (b > 1 && *N / *nthreads >= b) {
+
+    /* cache lines per thread and leftover cache lines */
+    q = (*N / b) / *nthreads;
+    r = (*N / b) % *nthreads;
+
+    /* assign work */
+    if (myid < r) {
+      *start = (myid * q + myid) * b;
+      *end   = *start + (q + 1) * b;
+    } else {
+      *start = (myid * q + r) * b;
+      *end   = *start + q * b;
+    }
+    if (myid == *nthreads - 1) *end = *N;
+    return;
+  }
 
   /* work per thread and leftover work */
   q = *N / *nthreads;
@@ -5329,6 +4648,252 @@ static void N_VInitThreadData(Pthreads_Data *thread_data)
 }
 
 
+/* ----------------------------------------------------------------------------
+ * Create a thread pool with num_threads threads for a new vector. Returns NULL
+ * if the pool could not be created.
+ */
+
+static Pthreads_Pool *N_VPoolCreate(int num_threads)
+{
+  Pthreads_Pool *pool;
+  int           i;
+
+  if (num_threads < 1) return(NULL);
+
+  pool = (Pthreads_Pool *) malloc(sizeof(Pthreads_Pool));
+  if (pool == NULL) return(NULL);
+
+  pool->num_threads = num_threads;
+  pool->nworkers    = 0;
+  pool->spin_count  = PT_SPIN_COUNT;
+  pool->refcount    = 1;
+  pool->func        = NULL;
+  pool->generation  = 0;
+  pool->pending     = 0;
+  pool->shutdown    = 0;
+
+  pool->threads  = (pthread_t *) malloc(num_threads*sizeof(pthread_t));
+  pool->workers  = (Pthreads_Worker *) malloc(num_threads*sizeof(Pthreads_Worker));
+  pool->data_mem = malloc(num_threads*sizeof(Pthreads_Data) + PT_CACHE_LINE);
+
+  pthread_mutex_init(&pool->run_lock, NULL);
+  pthread_mutex_init(&pool->lock, NULL);
+  pthread_cond_init(&pool->wake, NULL);
+  pthread_cond_init(&pool->done, NULL);
+
+  if (pool->threads == NULL || pool->workers == NULL || pool->data_mem == NULL) {
+    N_VPoolFree(pool);
+    return(NULL);
+  }
+
+#if defined(_SC_NPROCESSORS_ONLN)
+  if (num_threads > sysconf(_SC_NPROCESSORS_ONLN)) pool->spin_count = 0;
+#endif
+
+  /* thread data structs, starting on a cache line */
+  pool->data = (Pthreads_Data *)
+    (((uintptr_t) pool->data_mem + PT_CACHE_LINE - 1) &
+     ~((uintptr_t) (PT_CACHE_LINE - 1)));
+
+  /* start the workers, thread 0 is the calling thread */
+  for (i=1; i<num_threads; i++) {
+    pool->workers[i].pool = pool;
+    pool->workers[i].id   = i;
+    if (pthread_create(&pool->threads[i], NULL, N_VPoolWorker,
+                       (void *) &pool->workers[i])) {
+      N_VPoolFree(pool);
+      return(NULL);
+    }
+    pool->nworkers++;
+  }
+
+  return(pool);
+}
+
+
+/* ----------------------------------------------------------------------------
+ * Attach a clone to the thread pool of the vector it is cloned from
+ */
+
+static Pthreads_Pool *N_VPoolAttach(Pthreads_Pool *pool)
+{
+  pthread_mutex_lock(&pool->lock);
+  pool->refcount++;
+  pthread_mutex_unlock(&pool->lock);
+
+  return(pool);
+}
+
+
+/* ----------------------------------------------------------------------------
+ * Detach a vector from its thread pool, and destroy the pool if no other
+ * vector uses it.
+ */
+
+static void N_VPoolDetach(Pthreads_Pool *pool)
+{
+  int refcount;
+
+  if (pool == NULL) return;
+
+  pthread_mutex_lock(&pool->lock);
+  refcount = --pool->refcount;
+  pthread_mutex_unlock(&pool->lock);
+
+  if (refcount == 0) N_VPoolFree(pool);
+}
+
+
+/* ----------------------------------------------------------------------------
+ * Stop the workers of a thread pool and free it
+ */
+
+static void N_VPoolFree(Pthreads_Pool *pool)
+{
+  int i;
+
+  /* wake up the workers and wait for them to exit */
+  pthread_mutex_lock(&pool->lock);
+  PT_STORE(&pool->shutdown, 1);
+  PT_STORE(&pool->generation, pool->generation + 1);
+  pthread_cond_broadcast(&pool->wake);
+  pthread_mutex_unlock(&pool->lock);
+
+  for (i=1; i<=pool->nworkers; i++)
+    pthread_join(pool->threads[i], NULL);
+
+  pthread_mutex_destroy(&pool->run_lock);
+  pthread_mutex_destroy(&pool->lock);
+  pthread_cond_destroy(&pool->wake);
+  pthread_cond_destroy(&pool->done);
+
+  free(pool->threads);
+  free(pool->workers);
+  free(pool->data_mem);
+  free(pool);
+}
+
+
+/* ----------------------------------------------------------------------------
+ * Get the thread data structs of the thread pool of a vector. The pool is
+ * reserved for the calling thread until N_VPoolRun returns.
+ */
+
+static Pthreads_Data *N_VPoolGetData(N_Vector v)
+{
+  Pthreads_Pool *pool = NV_CONTENT_PT(v)->pool;
+
+  pthread_mutex_lock(&pool->run_lock);
+
+  return(pool->data);
+}
+
+
+/* ----------------------------------------------------------------------------
+ * Run a companion function on each thread of the thread pool of a vector, with
+ * the thread data structs filled in after N_VPoolGetData, and wait for all the
+ * threads to finish. The calling thread runs the function as thread 0.
+ */
+
+static void N_VPoolRun(N_Vector v, void *(*func)(void *))
+{
+  Pthreads_Pool *pool = NV_CONTENT_PT(v)->pool;
+#if defined(PT_ATOMICS)
+  int           spin;
+#endif
+
+  if (pool->nworkers > 0) {
+
+    /* dispatch the operation to the workers */
+    pool->func    = func;
+    pool->pending = pool->nworkers;
+
+    pthread_mutex_lock(&pool->lock);
+    PT_STORE(&pool->generation, pool->generation + 1);
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+  }
+
+  /* thread 0 */
+  func((void *) &pool->data[0]);
+
+  if (pool->nworkers > 0) {
+
+    /* wait for the workers to finish, spinning for a while first */
+#if defined(PT_ATOMICS)
+    for (spin=0; spin<pool->spin_count && PT_LOAD(&pool->pending) > 0; spin++)
+      PT_PAUSE();
+#endif
+    pthread_mutex_lock(&pool->lock);
+    while (PT_LOAD(&pool->pending) > 0)
+      pthread_cond_wait(&pool->done, &pool->lock);
+    pthread_mutex_unlock(&pool->lock);
+  }
+
+  pthread_mutex_unlock(&pool->run_lock);
+}
+
+
+/* ----------------------------------------------------------------------------
+ * Main loop of a worker thread: wait for an operation to be dispatched, spinning
+ * for a while and then sleeping, run the companion function on the thread
+ * data struct of the worker, and signal the caller when the last worker is
+ * done.
+ */
+
+static void *N_VPoolWorker(void *arg)
+{
+  Pthreads_Pool *pool;
+  unsigned long seen;
+  int           id;
+#if defined(PT_ATOMICS)
+  int           spin;
+#endif
+
+  pool = ((Pthreads_Worker *) arg)->pool;
+  id   = ((Pthreads_Worker *) arg)->id;
+  seen = 0;
+
+  for (;;) {
+
+    /* wait for the next operation */
+#if defined(PT_ATOMICS)
+    for (spin=0; spin<pool->spin_count && PT_LOAD(&pool->generation) == seen; spin++)
+      PT_PAUSE();
+    if (PT_LOAD(&pool->generation) == seen) {
+#endif
+      pthread_mutex_lock(&pool->lock);
+      while (PT_LOAD(&pool->generation) == seen)
+        pthread_cond_wait(&pool->wake, &pool->lock);
+      pthread_mutex_unlock(&pool->lock);
+#if defined(PT_ATOMICS)
+    }
+#endif
+    seen = PT_LOAD(&pool->generation);
+    if (PT_LOAD(&pool->shutdown)) break;
+
+    /* run the operation */
+    pool->func((void *) &pool->data[id]);
+
+    /* signal the caller if this is the last worker to finish */
+#if defined(PT_ATOMICS)
+    if (PT_DEC(&pool->pending) == 0) {
+      pthread_mutex_lock(&pool->lock);
+      pthread_cond_signal(&pool->done);
+      pthread_mutex_unlock(&pool->lock);
+    }
+#else
+    pthread_mutex_lock(&pool->lock);
+    if (PT_DEC(&pool->pending) == 0)
+      pthread_cond_signal(&pool->done);
+    pthread_mutex_unlock(&pool->lock);
+#endif
+  }
+
+  return(NULL);
+}
+
+
 /*
  * -----------------------------------------------------------------
  * Enable / Disable fused and vector array operations
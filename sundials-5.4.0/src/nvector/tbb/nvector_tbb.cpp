@@ -0,0 +1,2281 @@
+/* -----------------------------------------------------------------
+ * Acknowledgements: This NVECTOR module is based on the NVECTOR
+ *                   OpenMP module by David J. Gardner and Carol S.
+ *                   Woodward @ LLNL
+ * -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2020, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the implementation file for an Intel TBB implementation
+ * of the NVECTOR module.
+ *
+ * Every operation is a single tbb::parallel_for or
+ * tbb::parallel_reduce over the elements of the vector, using the
+ * tbb::affinity_partitioner of the vector, and run in the
+ * tbb::task_arena of the vector (if any). The fused and vector
+ * array operations go over all of their vectors within each chunk
+ * of elements, so that the chunks of the vectors involved stay
+ * with the same thread.
+ * -----------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <new>
+#include <vector>
+
+/* The TBB bundled with OpenModelica is built for the Boehm GC, and its headers
+   expect gc.h to be included when GC_THREADS is defined */
+#if defined(GC_THREADS)
+#include <gc.h>
+#endif
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_reduce.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_arena.h>
+
+#include <nvector/nvector_tbb.h>
+#include <sundials/sundials_math.h>
+
+#define ZERO   RCONST(0.0)
+#define HALF   RCONST(0.5)
+#define ONE    RCONST(1.0)
+#define ONEPT5 RCONST(1.5)
+
+/* Content of the vector as TBB objects */
+#define NV_TASK_ARENA_TBB(v)  ( static_cast<tbb::task_arena*>(NV_ARENA_TBB(v)) )
+#define NV_PARTITIONER_TBB(v) \
+  ( *static_cast<tbb::affinity_partitioner*>(NV_CONTENT_TBB(v)->partitioner) )
+
+typedef tbb::blocked_range<sunindextype> range_type;
+
+/* Private functions for special cases of vector operations */
+static void VCopy_Tbb(N_Vector x, N_Vector z);                              /* z=x       */
+static void VSum_Tbb(N_Vector x, N_Vector y, N_Vector z);                   /* z=x+y     */
+static void VDiff_Tbb(N_Vector x, N_Vector y, N_Vector z);                  /* z=x-y     */
+static void VNeg_Tbb(N_Vector x, N_Vector z);                               /* z=-x      */
+static void VScaleSum_Tbb(realtype c, N_Vector x, N_Vector y, N_Vector z);  /* z=c(x+y)  */
+static void VScaleDiff_Tbb(realtype c, N_Vector x, N_Vector y, N_Vector z); /* z=c(x-y)  */
+static void VLin1_Tbb(realtype a, N_Vector x, N_Vector y, N_Vector z);      /* z=ax+y    */
+static void VLin2_Tbb(realtype a, N_Vector x, N_Vector y, N_Vector z);      /* z=ax-y    */
+static void Vaxpy_Tbb(realtype a, N_Vector x, N_Vector y);                  /* y <- ax+y */
+static void VScaleBy_Tbb(realtype a, N_Vector x);                           /* x <- ax   */
+
+/* Private functions for special cases of vector array operations */
+static int VSumVectorArray_Tbb(int nvec, N_Vector* X, N_Vector* Y, N_Vector* Z);                   /* Z=X+Y     */
+static int VDiffVectorArray_Tbb(int nvec, N_Vector* X, N_Vector* Y, N_Vector* Z);                  /* Z=X-Y     */
+static int VScaleSumVectorArray_Tbb(int nvec, realtype c, N_Vector* X, N_Vector* Y, N_Vector* Z);  /* Z=c(X+Y)  */
+static int VScaleDiffVectorArray_Tbb(int nvec, realtype c, N_Vector* X, N_Vector* Y, N_Vector* Z); /* Z=c(X-Y)  */
+static int VLin1VectorArray_Tbb(int nvec, realtype a, N_Vector* X, N_Vector* Y, N_Vector* Z);      /* Z=aX+Y    */
+static int VLin2VectorArray_Tbb(int nvec, realtype a, N_Vector* X, N_Vector* Y, N_Vector* Z);      /* Z=aX-Y    */
+static int VaxpyVectorArray_Tbb(int nvec, realtype a, N_Vector* X, N_Vector* Y);                   /* Y <- aX+Y */
+
+/*
+ * -----------------------------------------------------------------
+ * private loop templates
+ * -----------------------------------------------------------------
+ */
+
+/* ----------------------------------------------------------------------------
+ * Run f in the task arena of v, or in the calling thread's arena if v has
+ * none
+ */
+
+template <typename F>
+static void VRun_Tbb(N_Vector v, const F& f)
+{
+  tbb::task_arena *arena = NV_TASK_ARENA_TBB(v);
+
+  if (arena == NULL)
+    f();
+  else
+    arena->execute(f);
+}
+
+/* ----------------------------------------------------------------------------
+ * Call body(lo, hi) on the chunks of the index range of v, in parallel
+ */
+
+template <typename Body>
+static void VFor_Tbb(N_Vector v, const Body& body)
+{
+  sunindextype N = NV_LENGTH_TBB(v);
+  tbb::affinity_partitioner& ap = NV_PARTITIONER_TBB(v);
+
+  if (N <= 0) return;
+
+  VRun_Tbb(v, [&]() {
+      tbb::parallel_for(range_type(0, N), [&](const range_type& r) {
+          body(r.begin(), r.end());
+        }, ap);
+    });
+}
+
+/* ----------------------------------------------------------------------------
+ * Reduce over the index range of v in parallel: body(lo, hi, value)
+ * folds a chunk into value and returns the result, join combines the results
+ * of two chunks.
+ */
+
+template <typename T, typename Body, typename Join>
+static T VReduce_Tbb(N_Vector v, T init, const Body& body, const Join& join)
+{
+  sunindextype N = NV_LENGTH_TBB(v);
+  tbb::affinity_partitioner& ap = NV_PARTITIONER_TBB(v);
+  T result = init;
+
+  if (N <= 0) return(result);
+
+  VRun_Tbb(v, [&]() {
+      result = tbb::parallel_reduce(range_type(0, N), init,
+        [&](const range_type& r, T value) {
+          return body(r.begin(), r.end(), value);
+        }, join, ap);
+    });
+
+  return(result);
+}
+
+/* ----------------------------------------------------------------------------
+ * Sum of f(i) over the index range of v
+ */
+
+template <typename F>
+static realtype VReduceSum_Tbb(N_Vector v, const F& f)
+{
+  return VReduce_Tbb(v, ZERO,
+    [&](sunindextype lo, sunindextype hi, realtype sum) {
+      for (sunindextype i = lo; i < hi; i++)
+        sum += f(i);
+      return(sum);
+    },
+    [](realtype s1, realtype s2) { return(s1 + s2); });
+}
+
+/* ----------------------------------------------------------------------------
+ * Logical and of f(i) over the index range of v
+ */
+
+template <typename F>
+static booleantype VReduceAll_Tbb(N_Vector v, const F& f)
+{
+  return VReduce_Tbb(v, SUNTRUE,
+    [&](sunindextype lo, sunindextype hi, booleantype test) {
+      for (sunindextype i = lo; i < hi; i++)
+        if (!f(i)) test = SUNFALSE;
+      return(test);
+    },
+    [](booleantype t1, booleantype t2) -> booleantype {
+      return((t1 && t2) ? SUNTRUE : SUNFALSE);
+    });
+}
+
+/* ----------------------------------------------------------------------------
+ * Body of a parallel_reduce of nsum sums at once: f(lo, hi, sums) adds the
+ * terms of a chunk to sums[0],...,sums[nsum-1]
+ */
+
+template <typename F>
+class VSums_Tbb
+{
+public:
+  VSums_Tbb(int nsum, const F& f) : sums(nsum, ZERO), f(f) {}
+  VSums_Tbb(VSums_Tbb& other, tbb::split) : sums(other.sums.size(), ZERO), f(other.f) {}
+
+  void operator()(const range_type& r) { f(r.begin(), r.end(), sums.data()); }
+
+  void join(const VSums_Tbb& other)
+  {
+    for (size_t i = 0; i < sums.size(); i++)
+      sums[i] += other.sums[i];
+  }
+
+  std::vector<realtype> sums;
+
+private:
+  const F& f;
+};
+
+/* ----------------------------------------------------------------------------
+ * Computes the nsum sums of f over the index range of v in a single pass
+ */
+
+template <typename F>
+static void VReduceSums_Tbb(N_Vector v, int nsum, realtype* sums, const F& f)
+{
+  sunindextype N = NV_LENGTH_TBB(v);
+  tbb::affinity_partitioner& ap = NV_PARTITIONER_TBB(v);
+  VSums_Tbb<F> body(nsum, f);
+
+  if (N > 0) {
+    VRun_Tbb(v, [&]() {
+        tbb::parallel_reduce(range_type(0, N), body, ap);
+      });
+  }
+
+  for (int i = 0; i < nsum; i++)
+    sums[i] = body.sums[i];
+}
+
+/*
+ * -----------------------------------------------------------------
+ * exported functions
+ * -----------------------------------------------------------------
+ */
+
+/* ----------------------------------------------------------------
+ * Returns vector type ID. Used to identify vector implementation
+ * from abstract N_Vector interface.
+ */
+N_Vector_ID N_VGetVectorID_Tbb(N_Vector v)
+{
+  return SUNDIALS_NVEC_TBB;
+}
+
+/* ----------------------------------------------------------------------------
+ * Function to create a new empty vector
+ */
+
+N_Vector N_VNewEmpty_Tbb(sunindextype length, void *arena)
+{
+  N_Vector v;
+  N_VectorContent_Tbb content;
+
+  /* Create vector */
+  v = NULL;
+  v = N_VNewEmpty();
+  if (v == NULL) return(NULL);
+
+  /* Attach operations */
+
+  /* constructors, destructors, and utility operations */
+  v->ops->nvgetvectorid     = N_VGetVectorID_Tbb;
+  v->ops->nvclone           = N_VClone_Tbb;
+  v->ops->nvcloneempty      = N_VCloneEmpty_Tbb;
+  v->ops->nvdestroy         = N_VDestroy_Tbb;
+  v->ops->nvspace           = N_VSpace_Tbb;
+  v->ops->nvgetarraypointer = N_VGetArrayPointer_Tbb;
+  v->ops->nvsetarraypointer = N_VSetArrayPointer_Tbb;
+  v->ops->nvgetlength       = N_VGetLength_Tbb;
+
+  /* standard vector operations */
+  v->ops->nvlinearsum    = N_VLinearSum_Tbb;
+  v->ops->nvconst        = N_VConst_Tbb;
+  v->ops->nvprod         = N_VProd_Tbb;
+  v->ops->nvdiv          = N_VDiv_Tbb;
+  v->ops->nvscale        = N_VScale_Tbb;
+  v->ops->nvabs          = N_VAbs_Tbb;
+  v->ops->nvinv          = N_VInv_Tbb;
+  v->ops->nvaddconst     = N_VAddConst_Tbb;
+  v->ops->nvdotprod      = N_VDotProd_Tbb;
+  v->ops->nvmaxnorm      = N_VMaxNorm_Tbb;
+  v->ops->nvwrmsnormmask = N_VWrmsNormMask_Tbb;
+  v->ops->nvwrmsnorm     = N_VWrmsNorm_Tbb;
+  v->ops->nvmin          = N_VMin_Tbb;
+  v->ops->nvwl2norm      = N_VWL2Norm_Tbb;
+  v->ops->nvl1norm       = N_VL1Norm_Tbb;
+  v->ops->nvcompare      = N_VCompare_Tbb;
+  v->ops->nvinvtest      = N_VInvTest_Tbb;
+  v->ops->nvconstrmask   = N_VConstrMask_Tbb;
+  v->ops->nvminquotient  = N_VMinQuotient_Tbb;
+
+  /* fused and vector array operations are disabled (NULL) by default */
+
+  /* local reduction kernels */
+  v->ops->nvdotprodlocal     = N_VDotProd_Tbb;
+  v->ops->nvmaxnormlocal     = N_VMaxNorm_Tbb;
+  v->ops->nvminlocal         = N_VMin_Tbb;
+  v->ops->nvl1normlocal      = N_VL1Norm_Tbb;
+  v->ops->nvinvtestlocal     = N_VInvTest_Tbb;
+  v->ops->nvconstrmasklocal  = N_VConstrMask_Tbb;
+  v->ops->nvminquotientlocal = N_VMinQuotient_Tbb;
+  v->ops->nvwsqrsumlocal     = N_VWSqrSumLocal_Tbb;
+  v->ops->nvwsqrsummasklocal = N_VWSqrSumMaskLocal_Tbb;
+
+  /* XBraid interface operations */
+  v->ops->nvbufsize   = N_VBufSize_Tbb;
+  v->ops->nvbufpack   = N_VBufPack_Tbb;
+  v->ops->nvbufunpack = N_VBufUnpack_Tbb;
+
+  /* Create content */
+  content = NULL;
+  content = (N_VectorContent_Tbb) malloc(sizeof *content);
+  if (content == NULL) { N_VDestroy(v); return(NULL); }
+
+  /* Attach content */
+  v->content = content;
+
+  /* Initialize content */
+  content->length      = length;
+  content->own_data    = SUNFALSE;
+  content->data        = NULL;
+  content->arena       = arena;
+  content->partitioner = new (std::nothrow) tbb::affinity_partitioner();
+  if (content->partitioner == NULL) { N_VDestroy_Tbb(v); return(NULL); }
+
+  return(v);
+}
+
+/* ----------------------------------------------------------------------------
+ * Function to create a new vector
+ */
+
+N_Vector N_VNew_Tbb(sunindextype length, void *arena)
+{
+  N_Vector v;
+  realtype *data;
+
+  v = NULL;
+  v = N_VNewEmpty_Tbb(length, arena);
+  if (v == NULL) return(NULL);
+
+  /* Create data */
+  if (length > 0) {
+
+    /* Allocate memory */
+    data = NULL;
+    data = (realtype *) malloc(length * sizeof(realtype));
+    if(data == NULL) { N_VDestroy_Tbb(v); return(NULL); }
+
+    /* Attach data */
+    NV_OWN_DATA_TBB(v) = SUNTRUE;
+    NV_DATA_TBB(v)     = data;
+
+  }
+
+  return(v);
+}
+
+/* ----------------------------------------------------------------------------
+ * Function to create a vector with user data component
+ */
+
+N_Vector N_VMake_Tbb(sunindextype length, realtype *v_data, void *arena)
+{
+  N_Vector v;
+
+  v = NULL;
+  v = N_VNewEmpty_Tbb(length, arena);
+  if (v == NULL) return(NULL);
+
+  if (length > 0) {
+    /* Attach data */
+    NV_OWN_DATA_TBB(v) = SUNFALSE;
+    NV_DATA_TBB(v)     = v_data;
+  }
+
+  return(v);
+}
+
+/* ----------------------------------------------------------------------------
+ * Function to create an array of new vectors.
+ */
+
+N_Vector* N_VCloneVectorArray_Tbb(int count, N_Vector w)
+{
+  N_Vector* vs;
+  int j;
+
+  if (count <= 0) return(NULL);
+
+  vs = NULL;
+  vs = (N_Vector*) malloc(count * sizeof(N_Vector));
+  if(vs == NULL) return(NULL);
+
+  for (j = 0; j < count; j++) {
+    vs[j] = NULL;
+    vs[j] = N_VClone_Tbb(w);
+    if (vs[j] == NULL) {
+      N_VDestroyVectorArray_Tbb(vs, j-1);
+      return(NULL);
+    }
+  }
+
+  return(vs);
+}
+
+/* ----------------------------------------------------------------------------
+ * Function to create an array of new vectors with NULL data array.
+ */
+
+N_Vector* N_VCloneVectorArrayEmpty_Tbb(int count, N_Vector w)
+{
+  N_Vector* vs;
+  int j;
+
+  if (count <= 0) return(NULL);
+
+  vs = NULL;
+  vs = (N_Vector*) malloc(count * sizeof(N_Vector));
+  if(vs == NULL) return(NULL);
+
+  for (j = 0; j < count; j++) {
+    vs[j] = NULL;
+    vs[j] = N_VCloneEmpty_Tbb(w);
+    if (vs[j] == NULL) {
+      N_VDestroyVectorArray_Tbb(vs, j-1);
+      return(NULL);
+    }
+  }
+
+  return(vs);
+}
+
+/* ----------------------------------------------------------------------------
+ * Function to free an array created with N_VCloneVectorArray_Tbb
+ */
+
+void N_VDestroyVectorArray_Tbb(N_Vector* vs, int count)
+{
+  int j;
+
+  for (j = 0; j < count; j++) N_VDestroy_Tbb(vs[j]);
+
+  free(vs); vs = NULL;
+
+  return;
+}
+
+/* ----------------------------------------------------------------------------
+ * Function to return number of vector elements
+ */
+sunindextype N_VGetLength_Tbb(N_Vector v)
+{
+  return NV_LENGTH_TBB(v);
+}
+
+/* ----------------------------------------------------------------------------
+ * Function to print a vector to stdout
+ */
+
+void N_VPrint_Tbb(N_Vector x)
+{
+  N_VPrintFile_Tbb(x, stdout);
+}
+
+/* ----------------------------------------------------------------------------
+ * Function to print a vector to outfile
+ */
+
+void N_VPrintFile_Tbb(N_Vector x, FILE *outfile)
+{
+  sunindextype i, N;
+  realtype *xd;
+
+  xd = NULL;
+
+  N  = NV_LENGTH_TBB(x);
+  xd = NV_DATA_TBB(x);
+
+  for (i = 0; i < N; i++) {
+#if defined(SUNDIALS_EXTENDED_PRECISION)
+    fprintf(outfile, "%11.8Lg\n", xd[i]);
+#elif defined(SUNDIALS_DOUBLE_PRECISION)
+    fprintf(outfile, "%11.8g\n", xd[i]);
+#else
+    fprintf(outfile, "%11.8g\n", xd[i]);
+#endif
+  }
+  fprintf(outfile, "\n");
+
+  return;
+}
+
+/* ----------------------------------------------------------------------------
+ * Function to create a task arena of at most max_concurrency threads (or of
+ * the default number of threads if max_concurrency < 1), for use as the arena
+ * argument of the vector constructors
+ */
+
+void *N_VNewTaskArena_Tbb(int max_concurrency)
+{
+  if (max_concurrency < 1)
+    max_concurrency = tbb::task_arena::automatic;
+
+  return(new (std::nothrow) tbb::task_arena(max_concurrency));
+}
+
+/* ----------------------------------------------------------------------------
+ * Function to free a task arena created with N_VNewTaskArena_Tbb
+ */
+
+void N_VFreeTaskArena_Tbb(void *arena)
+{
+  delete static_cast<tbb::task_arena*>(arena);
+}
+
+/*
+ * -----------------------------------------------------------------
+ * implementation of vector operations
+ * -----------------------------------------------------------------
+ */
+
+/* ----------------------------------------------------------------------------
+ * Create new vector from existing vector without attaching data
+ */
+
+N_Vector N_VCloneEmpty_Tbb(N_Vector w)
+{
+  N_Vector v;
+  N_VectorContent_Tbb content;
+
+  if (w == NULL) return(NULL);
+
+  /* Create vector */
+  v = NULL;
+  v = N_VNewEmpty();
+  if (v == NULL) return(NULL);
+
+  /* Attach operations */
+  if (N_VCopyOps(w, v)) { N_VDestroy(v); return(NULL); }
+
+  /* Create content */
+  content = NULL;
+  content = (N_VectorContent_Tbb) malloc(sizeof *content);
+  if (content == NULL) { N_VDestroy(v); return(NULL); }
+
+  /* Attach content */
+  v->content = content;
+
+  /* Initialize content; the clone runs in the same arena as w, with a
+     partitioner of its own */
+  content->length      = NV_LENGTH_TBB(w);
+  content->own_data    = SUNFALSE;
+  content->data        = NULL;
+  content->arena       = NV_ARENA_TBB(w);
+  content->partitioner = new (std::nothrow) tbb::affinity_partitioner();
+  if (content->partitioner == NULL) { N_VDestroy_Tbb(v); return(NULL); }
+
+  return(v);
+}
+
+
+/* ----------------------------------------------------------------------------
+ * Create new vector from existing vector and attach data
+ */
+
+N_Vector N_VClone_Tbb(N_Vector w)
+{
+  N_Vector v;
+  realtype *data;
+  sunindextype length;
+
+  v = NULL;
+  v = N_VCloneEmpty_Tbb(w);
+  if (v == NULL) return(NULL);
+
+  length = NV_LENGTH_TBB(w);
+
+  /* Create data */
+  if (length > 0) {
+
+    /* Allocate memory */
+    data = NULL;
+    data = (realtype *) malloc(length * sizeof(realtype));
+    if(data == NULL) { N_VDestroy_Tbb(v); return(NULL); }
+
+    /* Attach data */
+    NV_OWN_DATA_TBB(v) = SUNTRUE;
+    NV_DATA_TBB(v)     = data;
+
+  }
+
+  return(v);
+}
+
+
+/* ----------------------------------------------------------------------------
+ * Destroy vector and free vector memory
+ */
+
+void N_VDestroy_Tbb(N_Vector v)
+{
+  if (v == NULL) return;
+
+  /* free content */
+  if (v->content != NULL) {
+    /* free data array if it's owned by the vector */
+    if (NV_OWN_DATA_TBB(v) && NV_DATA_TBB(v) != NULL) {
+      free(NV_DATA_TBB(v));
+      NV_DATA_TBB(v) = NULL;
+    }
+    delete static_cast<tbb::affinity_partitioner*>(NV_CONTENT_TBB(v)->partitioner);
+    free(v->content);
+    v->content = NULL;
+  }
+
+  /* free ops and vector */
+  if (v->ops != NULL) { free(v->ops); v->ops = NULL; }
+  free(v); v = NULL;
+
+  return;
+}
+
+
+/* ----------------------------------------------------------------------------
+ * Get storage requirement for N_Vector
+ */
+
+void N_VSpace_Tbb(N_Vector v, sunindextype *lrw, sunindextype *liw)
+{
+  *lrw = NV_LENGTH_TBB(v);
+  *liw = 1;
+
+  return;
+}
+
+
+/* ----------------------------------------------------------------------------
+ * Get vector data pointer
+ */
+
+realtype *N_VGetArrayPointer_Tbb(N_Vector v)
+{
+  return((realtype *) NV_DATA_TBB(v));
+}
+
+
+/* ----------------------------------------------------------------------------
+ * Set vector data pointer
+ */
+
+void N_VSetArrayPointer_Tbb(realtype *v_data, N_Vector v)
+{
+  if (NV_LENGTH_TBB(v) > 0) NV_DATA_TBB(v) = v_data;
+
+  return;
+}
+
+
+/* ----------------------------------------------------------------------------
+ * Compute linear combination z[i] = a*x[i]+b*y[i]
+ */
+
+void N_VLinearSum_Tbb(realtype a, N_Vector x, realtype b, N_Vector y, N_Vector z)
+{
+  realtype c, *xd, *yd, *zd;
+  N_Vector v1, v2;
+  booleantype test;
+
+  if ((b == ONE) && (z == y)) {    /* BLAS usage: axpy y <- ax+y */
+    Vaxpy_Tbb(a,x,y);
+    return;
+  }
+
+  if ((a == ONE) && (z == x)) {    /* BLAS usage: axpy x <- by+x */
+    Vaxpy_Tbb(b,y,x);
+    return;
+  }
+
+  /* Case: a == b == 1.0 */
+
+  if ((a == ONE) && (b == ONE)) {
+    VSum_Tbb(x, y, z);
+    return;
+  }
+
+  /* Cases: (1) a == 1.0, b = -1.0, (2) a == -1.0, b == 1.0 */
+
+  if ((test = ((a == ONE) && (b == -ONE))) || ((a == -ONE) && (b == ONE))) {
+    v1 = test ? y : x;
+    v2 = test ? x : y;
+    VDiff_Tbb(v2, v1, z);
+    return;
+  }
+
+  /* Cases: (1) a == 1.0, b == other or 0.0, (2) a == other or 0.0, b == 1.0 */
+  /* if a or b is 0.0, then user should have called N_VScale */
+
+  if ((test = (a == ONE)) || (b == ONE)) {
+    c  = test ? b : a;
+    v1 = test ? y : x;
+    v2 = test ? x : y;
+    VLin1_Tbb(c, v1, v2, z);
+    return;
+  }
+
+  /* Cases: (1) a == -1.0, b != 1.0, (2) a != 1.0, b == -1.0 */
+
+  if ((test = (a == -ONE)) || (b == -ONE)) {
+    c  = test ? b : a;
+    v1 = test ? y : x;
+    v2 = test ? x : y;
+    VLin2_Tbb(c, v1, v2, z);
+    return;
+  }
+
+  /* Case: a == b */
+  /* catches case both a and b are 0.0 - user should have called N_VConst */
+
+  if (a == b) {
+    VScaleSum_Tbb(a, x, y, z);
+    return;
+  }
+
+  /* Case: a == -b */
+
+  if (a == -b) {
+    VScaleDiff_Tbb(a, x, y, z);
+    return;
+  }
+
+  /* Do all cases not handled above:
+     (1) a == other, b == 0.0 - user should have called N_VScale
+     (2) a == 0.0, b == other - user should have called N_VScale
+     (3) a,b == other, a !=b, a != -b */
+
+  xd = NV_DATA_TBB(x);
+  yd = NV_DATA_TBB(y);
+  zd = NV_DATA_TBB(z);
+
+  VFor_Tbb(z, [=](sunindextype lo, sunindextype hi) {
+      for (sunindextype i = lo; i < hi; i++)
+        zd[i] = (a*xd[i])+(b*yd[i]);
+    });
+
+  return;
+}
+
+
+/* ----------------------------------------------------------------------------
+ * Assigns constant value to all vector elements, z[i] = c
+ */
+
+void N_VConst_Tbb(realtype c, N_Vector z)
+{
+  realtype *zd = NV_DATA_TBB(z);
+
+  VFor_Tbb(z, [=](sunindextype lo, sunindextype hi) {
+      for (sunindextype i = lo; i < hi; i++)
+        zd[i] = c;
+    });
+
+  return;
+}
+
+
+/* ----------------------------------------------------------------------------
+ * Compute componentwise product z[i] = x[i]*y[i]
+ */
+
+void N_VProd_Tbb(N_Vector x, N_Vector y, N_Vector z)
+{
+  realtype *xd = NV_DATA_TBB(x);
+  realtype *yd = NV_DATA_TBB(y);
+  realtype *zd = NV_DATA_TBB(z);
+
+  VFor_Tbb(z, [=](sunindextype lo, sunindextype hi) {
+      for (sunindextype i = lo; i < hi; i++)
+        zd[i] = xd[i]*yd[i];
+    });
+
+  return;
+}
+
+
+/* ----------------------------------------------------------------------------
+ * Compute componentwise division z[i] = x[i]/y[i]
+ */
+
+void N_VDiv_Tbb(N_Vector x, N_Vector y, N_Vector z)
+{
+  realtype *xd = NV_DATA_TBB(x);
+  realtype *yd = NV_DATA_TBB(y);
+  realtype *zd = NV_DATA_TBB(z);
+
+  VFor_Tbb(z, [=](sunindextype lo, sunindextype hi) {
+      for (sunindextype i = lo; i < hi; i++)
+        zd[i] = xd[i]/yd[i];
+    });
+
+  return;
+}
+
+
+/* ----------------------------------------------------------------------------
+ * Compute scaler multiplication z[i] = c*x[i]
+ */
+
+void N_VScale_Tbb(realtype c, N_Vector x, N_Vector z)
+{
+  realtype *xd, *zd;
+
+  if (z == x) {  /* BLAS usage: scale x <- cx */
+    VScaleBy_Tbb(c, x);
+    return;
+  }
+
+  if (c == ONE) {
+    VCopy_Tbb(x, z);
+  } else if (c == -ONE) {
+    VNeg_Tbb(x, z);
+  } else {
+    xd = NV_DATA_TBB(x);
+    zd = NV_DATA_TBB(z);
+    VFor_Tbb(z, [=](sunindextype lo, sunindextype hi) {
+        for (sunindextype i = lo; i < hi; i++)
+          zd[i] = c*xd[i];
+      });
+  }
+
+  return;
+}
+
+
+/* ----------------------------------------------------------------------------
+ * Compute absolute value of vector components z[i] = SUNRabs(x[i])
+ */
+
+void N_VAbs_Tbb(N_Vector x, N_Vector z)
+{
+  realtype *xd = NV_DATA_TBB(x);
+  realtype *zd = NV_DATA_TBB(z);
+
+  VFor_Tbb(z, [=](sunindextype lo, sunindextype hi) {
+      for (sunindextype i = lo; i < hi; i++)
+        zd[i] = SUNRabs(xd[i]);
+    });
+
+  return;
+}
+
+
+/* ----------------------------------------------------------------------------
+ * Compute componentwise inverse z[i] = 1 / x[i]
+ */
+
+void N_VInv_Tbb(N_Vector x, N_Vector z)
+{
+  realtype *xd = NV_DATA_TBB(x);
+  realtype *zd = NV_DATA_TBB(z);
+
+  VFor_Tbb(z, [=](sunindextype lo, sunindextype hi) {
+      for (sunindextype i = lo; i < hi; i++)
+        zd[i] = ONE/xd[i];
+    });
+
+  return;
+}
+
+
+/* ----------------------------------------------------------------------------
+ * Compute componentwise addition of a scaler to a vector z[i] = x[i] + b
+ */
+
+void N_VAddConst_Tbb(N_Vector x, realtype b, N_Vector z)
+{
+  realtype *xd = NV_DATA_TBB(x);
+  realtype *zd = NV_DATA_TBB(z);
+
+  VFor_Tbb(z, [=](sunindextype lo, sunindextype hi) {
+      for (sunindextype i = lo; i < hi; i++)
+        zd[i] = xd[i]+b;
+    });
+
+  return;
+}
+
+
+/* ----------------------------------------------------------------------------
+ * Computes the dot product of two vectors, a = sum(x[i]*y[i])
+ */
+
+realtype N_VDotProd_Tbb(N_Vector x, N_Vector y)
+{
+  realtype *xd = NV_DATA_TBB(x);
+  realtype *yd = NV_DATA_TBB(y);
+
+  return VReduceSum_Tbb(x, [=](sunindextype i) { return xd[i]*yd[i]; });
+}
+
+
+/* ----------------------------------------------------------------------------
+ * Computes max norm of a vector
+ */
+
+realtype N_VMaxNorm_Tbb(N_Vector x)
+{
+  realtype *xd = NV_DATA_TBB(x);
+
+  return VReduce_Tbb(x, ZERO,
+    [=](sunindextype lo, sunindextype hi, realtype max) {
+      for (sunindextype i = lo; i < hi; i++)
+        if (SUNRabs(xd[i]) > max) max = SUNRabs(xd[i]);
+      return(max);
+    },
+    [](realtype m1, realtype m2) { return (m1 > m2) ? m1 : m2; });
+}
+
+
+/* ----------------------------------------------------------------------------
+ * Computes weighted root mean square norm of a vector
+ */
+
+realtype N_VWrmsNorm_Tbb(N_Vector x, N_Vector w)
+{
+  return(SUNRsqrt(N_VWSqrSumLocal_Tbb(x, w)/(NV_LENGTH_TBB(x))));
+}
+
+
+/* ----------------------------------------------------------------------------
+ * Computes weighted root mean square norm of a masked vector
+ */
+
+realtype N_VWrmsNormMask_Tbb(N_Vector x, N_Vector w, N_Vector id)
+{
+  return(SUNRsqrt(N_VWSqrSumMaskLocal_Tbb(x, w, id)/(NV_LENGTH_TBB(x))));
+}
+
+
+/* ----------------------------------------------------------------------------
+ * Finds the minimun component of a vector
+ */
+
+realtype N_VMin_Tbb(N_Vector x)
+{
+  realtype *xd = NV_DATA_TBB(x);
+  realtype min = (NV_LENGTH_TBB(x) > 0) ? xd[0] : BIG_REAL;
+
+  return VReduce_Tbb(x, min,
+    [=](sunindextype lo, sunindextype hi, realtype m) {
+      for (sunindextype i = lo; i < hi; i++)
+        if (xd[i] < m) m = xd[i];
+      return(m);
+    },
+    [](realtype m1, realtype m2) { return (m1 < m2) ? m1 : m2; });
+}
+
+
+/* ----------------------------------------------------------------------------
+ * Computes weighted L2 norm of a vector
+ */
+
+realtype N_VWL2Norm_Tbb(N_Vector x, N_Vector w)
+{
+  return(SUNRsqrt(N_VWSqrSumLocal_Tbb(x, w)));
+}
+
+
+/* ----------------------------------------------------------------------------
+ * Computes L1 norm of a vector
+ */
+
+realtype N_VL1Norm_Tbb(N_Vector x)
+{
+  realtype *xd = NV_DATA_TBB(x);
+
+  return VReduceSum_Tbb(x, [=](sunindextype i) { return SUNRabs(xd[i]); });
+}
+
+
+/* ----------------------------------------------------------------------------
+ * Compare vector component values to a scaler
+ */
+
+void N_VCompare_Tbb(realtype c, N_Vector x, N_Vector z)
+{
+  realtype *xd = NV_DATA_TBB(x);
+  realtype *zd = NV_DATA_TBB(z);
+
+  VFor_Tbb(z, [=](sunindextype lo, sunindextype hi) {
+      for (sunindextype i = lo; i < hi; i++)
+        zd[i] = (SUNRabs(xd[i]) >= c) ? ONE : ZERO;
+    });
+
+  return;
+}
+
+
+/* ----------------------------------------------------------------------------
+ * Compute componentwise inverse z[i] = ONE/x[i] and checks if x[i] == ZERO
+ */
+
+booleantype N_VInvTest_Tbb(N_Vector x, N_Vector z)
+{
+  realtype *xd = NV_DATA_TBB(x);
+  realtype *zd = NV_DATA_TBB(z);
+
+  return VReduceAll_Tbb(z, [=](sunindextype i) -> booleantype {
+      if (xd[i] == ZERO) return(SUNFALSE);
+      zd[i] = ONE/xd[i];
+      return(SUNTRUE);
+    });
+}
+
+
+/* ----------------------------------------------------------------------------
+ * Compute constraint mask of a vector
+ */
+
+booleantype N_VConstrMask_Tbb(N_Vector c, N_Vector x, N_Vector m)
+{
+  realtype *cd = NV_DATA_TBB(c);
+  realtype *xd = NV_DATA_TBB(x);
+  realtype *md = NV_DATA_TBB(m);
+
+  return VReduceAll_Tbb(m, [=](sunindextype i) -> booleantype {
+      md[i] = ZERO;
+
+      /* Continue if no constraints were set for the variable */
+      if (cd[i] == ZERO)
+        return(SUNTRUE);
+
+      /* Check if a set constraint has been violated */
+      if ((SUNRabs(cd[i]) > ONEPT5 && xd[i]*cd[i] <= ZERO) ||
+          (SUNRabs(cd[i]) > HALF   && xd[i]*cd[i] <  ZERO)) {
+        md[i] = ONE;
+        return(SUNFALSE);
+      }
+      return(SUNTRUE);
+    });
+}
+
+
+/* ----------------------------------------------------------------------------
+ * Compute minimum componentwise quotient
+ */
+
+realtype N_VMinQuotient_Tbb(N_Vector num, N_Vector denom)
+{
+  realtype *nd = NV_DATA_TBB(num);
+  realtype *dd = NV_DATA_TBB(denom);
+
+  return VReduce_Tbb(num, BIG_REAL,
+    [=](sunindextype lo, sunindextype hi, realtype min) {
+      for (sunindextype i = lo; i < hi; i++) {
+        if (dd[i] == ZERO) continue;
+        if ((nd[i]/dd[i]) < min) min = nd[i]/dd[i];
+      }
+      return(min);
+    },
+    [](realtype m1, realtype m2) { return (m1 < m2) ? m1 : m2; });
+}
+
+
+/* ----------------------------------------------------------------------------
+ * Computes weighted square sum of a vector
+ */
+
+realtype N_VWSqrSumLocal_Tbb(N_Vector x, N_Vector w)
+{
+  realtype *xd = NV_DATA_TBB(x);
+  realtype *wd = NV_DATA_TBB(w);
+
+  return VReduceSum_Tbb(x, [=](sunindextype i) { return SUNSQR(xd[i]*wd[i]); });
+}
+
+
+/* ----------------------------------------------------------------------------
+ * Computes weighted square sum of a masked vector
+ */
+
+realtype N_VWSqrSumMaskLocal_Tbb(N_Vector x, N_Vector w, N_Vector id)
+{
+  realtype *xd  = NV_DATA_TBB(x);
+  realtype *wd  = NV_DATA_TBB(w);
+  realtype *idd = NV_DATA_TBB(id);
+
+  return VReduceSum_Tbb(x, [=](sunindextype i) {
+      return (idd[i] > ZERO) ? SUNSQR(xd[i]*wd[i]) : ZERO;
+    });
+}
+
+
+/*
+ * -----------------------------------------------------------------
+ * fused vector operations
+ * -----------------------------------------------------------------
+ */
+
+int N_VLinearCombination_Tbb(int nvec, realtype* c, N_Vector* X, N_Vector z)
+{
+  realtype* zd;
+
+  /* invalid number of vectors */
+  if (nvec < 1) return(-1);
+
+  /* should have called N_VScale */
+  if (nvec == 1) {
+    N_VScale_Tbb(c[0], X[0], z);
+    return(0);
+  }
+
+  /* should have called N_VLinearSum */
+  if (nvec == 2) {
+    N_VLinearSum_Tbb(c[0], X[0], c[1], X[1], z);
+    return(0);
+  }
+
+  /* get data array */
+  zd = NV_DATA_TBB(z);
+
+  /*
+   * X[0] += c[i]*X[i], i = 1,...,nvec-1
+   * X[0] = c[0] * X[0] + sum{ c[i] * X[i] }, i = 1,...,nvec-1
+   * z = sum{ c[i] * X[i] }, i = 0,...,nvec-1
+   */
+  VFor_Tbb(z, [=](sunindextype lo, sunindextype hi) {
+      realtype *xd;
+      sunindextype j;
+      int i;
+
+      if ((X[0] == z) && (c[0] == ONE)) {
+        /* nothing to do for the first vector */
+      } else if (X[0] == z) {
+        for (j=lo; j<hi; j++)
+          zd[j] *= c[0];
+      } else {
+        xd = NV_DATA_TBB(X[0]);
+        for (j=lo; j<hi; j++)
+          zd[j] = c[0] * xd[j];
+      }
+
+      for (i=1; i<nvec; i++) {
+        xd = NV_DATA_TBB(X[i]);
+        for (j=lo; j<hi; j++)
+          zd[j] += c[i] * xd[j];
+      }
+    });
+
+  return(0);
+}
+
+
+int N_VScaleAddMulti_Tbb(int nvec, realtype* a, N_Vector x, N_Vector* Y, N_Vector* Z)
+{
+  realtype* xd;
+
+  /* invalid number of vectors */
+  if (nvec < 1) return(-1);
+
+  /* should have called N_VLinearSum */
+  if (nvec == 1) {
+    N_VLinearSum_Tbb(a[0], x, ONE, Y[0], Z[0]);
+    return(0);
+  }
+
+  /* get data array */
+  xd = NV_DATA_TBB(x);
+
+  /*
+   * Y[i][j] += a[i] * x[j]
+   * Z[i][j] = Y[i][j] + a[i] * x[j]
+   */
+  VFor_Tbb(x, [=](sunindextype lo, sunindextype hi) {
+      realtype *yd, *zd;
+      sunindextype j;
+      int i;
+
+      for (i=0; i<nvec; i++) {
+        yd = NV_DATA_TBB(Y[i]);
+        zd = NV_DATA_TBB(Z[i]);
+        for (j=lo; j<hi; j++)
+          zd[j] = a[i] * xd[j] + yd[j];
+      }
+    });
+
+  return(0);
+}
+
+
+int N_VDotProdMulti_Tbb(int nvec, N_Vector x, N_Vector* Y, realtype* dotprods)
+{
+  realtype* xd;
+
+  /* invalid number of vectors */
+  if (nvec < 1) return(-1);
+
+  /* should have called N_VDotProd */
+  if (nvec == 1) {
+    dotprods[0] = N_VDotProd_Tbb(x, Y[0]);
+    return(0);
+  }
+
+  /* get data array */
+  xd = NV_DATA_TBB(x);
+
+  /* compute multiple dot products */
+  VReduceSums_Tbb(x, nvec, dotprods,
+    [=](sunindextype lo, sunindextype hi, realtype* sums) {
+      realtype *yd;
+      sunindextype j;
+      int i;
+
+      for (i=0; i<nvec; i++) {
+        yd = NV_DATA_TBB(Y[i]);
+        for (j=lo; j<hi; j++)
+          sums[i] += xd[j] * yd[j];
+      }
+    });
+
+  return(0);
+}
+
+
+/*
+ * -----------------------------------------------------------------
+ * vector array operations
+ * -----------------------------------------------------------------
+ */
+
+int N_VLinearSumVectorArray_Tbb(int nvec,
+                                realtype a, N_Vector* X,
+                                realtype b, N_Vector* Y,
+                                N_Vector* Z)
+{
+  realtype    c;
+  N_Vector*   V1;
+  N_Vector*   V2;
+  booleantype test;
+
+  /* invalid number of vectors */
+  if (nvec < 1) return(-1);
+
+  /* should have called N_VLinearSum */
+  if (nvec == 1) {
+    N_VLinearSum_Tbb(a, X[0], b, Y[0], Z[0]);
+    return(0);
+  }
+
+  /* BLAS usage: axpy y <- ax+y */
+  if ((b == ONE) && (Z == Y))
+    return(VaxpyVectorArray_Tbb(nvec, a, X, Y));
+
+  /* BLAS usage: axpy x <- by+x */
+  if ((a == ONE) && (Z == X))
+    return(VaxpyVectorArray_Tbb(nvec, b, Y, X));
+
+  /* Case: a == b == 1.0 */
+  if ((a == ONE) && (b == ONE))
+    return(VSumVectorArray_Tbb(nvec, X, Y, Z));
+
+  /* Cases:                    */
+  /*   (1) a == 1.0, b = -1.0, */
+  /*   (2) a == -1.0, b == 1.0 */
+  if ((test = ((a == ONE) && (b == -ONE))) || ((a == -ONE) && (b == ONE))) {
+    V1 = test ? Y : X;
+    V2 = test ? X : Y;
+    return(VDiffVectorArray_Tbb(nvec, V2, V1, Z));
+  }
+
+  /* Cases:                                                  */
+  /*   (1) a == 1.0, b == other or 0.0,                      */
+  /*   (2) a == other or 0.0, b == 1.0                       */
+  /* if a or b is 0.0, then user should have called N_VScale */
+  if ((test = (a == ONE)) || (b == ONE)) {
+    c  = test ? b : a;
+    V1 = test ? Y : X;
+    V2 = test ? X : Y;
+    return(VLin1VectorArray_Tbb(nvec, c, V1, V2, Z));
+  }
+
+  /* Cases:                     */
+  /*   (1) a == -1.0, b != 1.0, */
+  /*   (2) a != 1.0, b == -1.0  */
+  if ((test = (a == -ONE)) || (b == -ONE)) {
+    c  = test ? b : a;
+    V1 = test ? Y : X;
+    V2 = test ? X : Y;
+    return(VLin2VectorArray_Tbb(nvec, c, V1, V2, Z));
+  }
+
+  /* Case: a == b                                                         */
+  /* catches case both a and b are 0.0 - user should have called N_VConst */
+  if (a == b)
+    return(VScaleSumVectorArray_Tbb(nvec, a, X, Y, Z));
+
+  /* Case: a == -b */
+  if (a == -b)
+    return(VScaleDiffVectorArray_Tbb(nvec, a, X, Y, Z));
+
+  /* Do all cases not handled above:                               */
+  /*   (1) a == other, b == 0.0 - user should have called N_VScale */
+  /*   (2) a == 0.0, b == other - user should have called N_VScale */
+  /*   (3) a,b == other, a !=b, a != -b                            */
+
+  /* compute linear sum for each vector pair in vector arrays */
+  VFor_Tbb(Z[0], [=](sunindextype lo, sunindextype hi) {
+      realtype *xd, *yd, *zd;
+      sunindextype j;
+      int i;
+
+      for (i=0; i<nvec; i++) {
+        xd = NV_DATA_TBB(X[i]);
+        yd = NV_DATA_TBB(Y[i]);
+        zd = NV_DATA_TBB(Z[i]);
+        for (j=lo; j<hi; j++)
+          zd[j] = a * xd[j] + b * yd[j];
+      }
+    });
+
+  return(0);
+}
+
+
+int N_VScaleVectorArray_Tbb(int nvec, realtype* c, N_Vector* X, N_Vector* Z)
+{
+  /* invalid number of vectors */
+  if (nvec < 1) return(-1);
+
+  /* should have called N_VScale */
+  if (nvec == 1) {
+    N_VScale_Tbb(c[0], X[0], Z[0]);
+    return(0);
+  }
+
+  /*
+   * X[i] *= c[i]
+   * Z[i] = c[i] * X[i]
+   */
+  VFor_Tbb(Z[0], [=](sunindextype lo, sunindextype hi) {
+      realtype *xd, *zd;
+      sunindextype j;
+      int i;
+
+      for (i=0; i<nvec; i++) {
+        xd = NV_DATA_TBB(X[i]);
+        zd = NV_DATA_TBB(Z[i]);
+        for (j=lo; j<hi; j++)
+          zd[j] = c[i] * xd[j];
+      }
+    });
+
+  return(0);
+}
+
+
+int N_VConstVectorArray_Tbb(int nvec, realtype c, N_Vector* Z)
+{
+  /* invalid number of vectors */
+  if (nvec < 1) return(-1);
+
+  /* should have called N_VConst */
+  if (nvec == 1) {
+    N_VConst_Tbb(c, Z[0]);
+    return(0);
+  }
+
+  /* set each vector in the vector array to a constant */
+  VFor_Tbb(Z[0], [=](sunindextype lo, sunindextype hi) {
+      realtype *zd;
+      sunindextype j;
+      int i;
+
+      for (i=0; i<nvec; i++) {
+        zd = NV_DATA_TBB(Z[i]);
+        for (j=lo; j<hi; j++)
+          zd[j] = c;
+      }
+    });
+
+  return(0);
+}
+
+
+int N_VWrmsNormVectorArray_Tbb(int nvec, N_Vector* X, N_Vector* W, realtype* nrm)
+{
+  int i;
+
+  /* invalid number of vectors */
+  if (nvec < 1) return(-1);
+
+  /* should have called N_VWrmsNorm */
+  if (nvec == 1) {
+    nrm[0] = N_VWrmsNorm_Tbb(X[0], W[0]);
+    return(0);
+  }
+
+  /* compute the WRMS norm for each vector in the vector array */
+  VReduceSums_Tbb(X[0], nvec, nrm,
+    [=](sunindextype lo, sunindextype hi, realtype* sums) {
+      realtype *xd, *wd;
+      sunindextype j;
+      int i;
+
+      for (i=0; i<nvec; i++) {
+        xd = NV_DATA_TBB(X[i]);
+        wd = NV_DATA_TBB(W[i]);
+        for (j=lo; j<hi; j++)
+          sums[i] += SUNSQR(xd[j] * wd[j]);
+      }
+    });
+
+  for (i=0; i<nvec; i++)
+    nrm[i] = SUNRsqrt(nrm[i]/NV_LENGTH_TBB(X[0]));
+
+  return(0);
+}
+
+
+int N_VWrmsNormMaskVectorArray_Tbb(int nvec, N_Vector* X, N_Vector* W,
+                                   N_Vector id, realtype* nrm)
+{
+  int       i;
+  realtype* idd;
+
+  /* invalid number of vectors */
+  if (nvec < 1) return(-1);
+
+  /* should have called N_VWrmsNorm */
+  if (nvec == 1) {
+    nrm[0] = N_VWrmsNormMask_Tbb(X[0], W[0], id);
+    return(0);
+  }
+
+  /* get mask data array */
+  idd = NV_DATA_TBB(id);
+
+  /* compute the WRMS norm for each vector in the vector array */
+  VReduceSums_Tbb(X[0], nvec, nrm,
+    [=](sunindextype lo, sunindextype hi, realtype* sums) {
+      realtype *xd, *wd;
+      sunindextype j;
+      int i;
+
+      for (i=0; i<nvec; i++) {
+        xd = NV_DATA_TBB(X[i]);
+        wd = NV_DATA_TBB(W[i]);
+        for (j=lo; j<hi; j++)
+          if (idd[j] > ZERO)
+            sums[i] += SUNSQR(xd[j] * wd[j]);
+      }
+    });
+
+  for (i=0; i<nvec; i++)
+    nrm[i] = SUNRsqrt(nrm[i]/NV_LENGTH_TBB(X[0]));
+
+  return(0);
+}
+
+
+int N_VScaleAddMultiVectorArray_Tbb(int nvec, int nsum, realtype* a,
+                                    N_Vector* X, N_Vector** Y, N_Vector** Z)
+{
+  int         j;
+  int         retval;
+  N_Vector*   YY;
+  N_Vector*   ZZ;
+
+  /* invalid number of vectors */
+  if (nvec < 1) return(-1);
+  if (nsum < 1) return(-1);
+
+  /* ---------------------------
+   * Special cases for nvec == 1
+   * --------------------------- */
+
+  if (nvec == 1) {
+
+    /* should have called N_VLinearSum */
+    if (nsum == 1) {
+      N_VLinearSum_Tbb(a[0], X[0], ONE, Y[0][0], Z[0][0]);
+      return(0);
+    }
+
+    /* should have called N_VScaleAddMulti */
+    YY = (N_Vector*) malloc(nsum * sizeof(N_Vector));
+    ZZ = (N_Vector*) malloc(nsum * sizeof(N_Vector));
+
+    for (j=0; j<nsum; j++) {
+      YY[j] = Y[j][0];
+      ZZ[j] = Z[j][0];
+    }
+
+    retval = N_VScaleAddMulti_Tbb(nsum, a, X[0], YY, ZZ);
+
+    free(YY);
+    free(ZZ);
+    return(retval);
+  }
+
+  /* --------------------------
+   * Special cases for nvec > 1
+   * -------------------------- */
+
+  /* should have called N_VLinearSumVectorArray */
+  if (nsum == 1) {
+    retval = N_VLinearSumVectorArray_Tbb(nvec, a[0], X, ONE, Y[0], Z[0]);
+    return(retval);
+  }
+
+  /* ----------------------------
+   * Compute multiple linear sums
+   * ---------------------------- */
+
+  /*
+   * Y[i][j] += a[i] * x[j]
+   * Z[i][j] = Y[i][j] + a[i] * x[j]
+   */
+  VFor_Tbb(X[0], [=](sunindextype lo, sunindextype hi) {
+      realtype *xd, *yd, *zd;
+      sunindextype k;
+      int i, j;
+
+      for (i=0; i<nvec; i++) {
+        xd = NV_DATA_TBB(X[i]);
+        for (j=0; j<nsum; j++) {
+          yd = NV_DATA_TBB(Y[j][i]);
+          zd = NV_DATA_TBB(Z[j][i]);
+          for (k=lo; k<hi; k++)
+            zd[k] = a[j] * xd[k] + yd[k];
+        }
+      }
+    });
+
+  return(0);
+}
+
+
+int N_VLinearCombinationVectorArray_Tbb(int nvec, int nsum,
+                                        realtype* c,
+                                        N_Vector** X,
+                                        N_Vector* Z)
+{
+  int          i; /* vector arrays index in summation [0,nsum) */
+  int          j; /* vector index in vector array     [0,nvec) */
+
+  realtype*    ctmp;
+  N_Vector*   Y;
+
+  /* invalid number of vectors */
+  if (nvec < 1) return(-1);
+  if (nsum < 1) return(-1);
+
+  /* ---------------------------
+   * Special cases for nvec == 1
+   * --------------------------- */
+
+  if (nvec == 1) {
+
+    /* should have called N_VScale */
+    if (nsum == 1) {
+      N_VScale_Tbb(c[0], X[0][0], Z[0]);
+      return(0);
+    }
+
+    /* should have called N_VLinearSum */
+    if (nsum == 2) {
+      N_VLinearSum_Tbb(c[0], X[0][0], c[1], X[1][0], Z[0]);
+      return(0);
+    }
+
+    /* should have called N_VLinearCombination */
+    Y = (N_Vector*) malloc(nsum * sizeof(N_Vector));
+
+    for (i=0; i<nsum; i++) {
+      Y[i] = X[i][0];
+    }
+
+    N_VLinearCombination_Tbb(nsum, c, Y, Z[0]);
+
+    free(Y);
+    return(0);
+  }
+
+  /* --------------------------
+   * Special cases for nvec > 1
+   * -------------------------- */
+
+  /* should have called N_VScaleVectorArray */
+  if (nsum == 1) {
+
+    ctmp = (realtype*) malloc(nvec * sizeof(realtype));
+
+    for (j=0; j<nvec; j++) {
+      ctmp[j] = c[0];
+    }
+
+    N_VScaleVectorArray_Tbb(nvec, ctmp, X[0], Z);
+
+    free(ctmp);
+    return(0);
+  }
+
+  /* should have called N_VLinearSumVectorArray */
+  if (nsum == 2) {
+    N_VLinearSumVectorArray_Tbb(nvec, c[0], X[0], c[1], X[1], Z);
+    return(0);
+  }
+
+  /* --------------------------
+   * Compute linear combination
+   * -------------------------- */
+
+  /*
+   * X[0][j] += c[i]*X[i][j], i = 1,...,nvec-1
+   * X[0][j] = c[0] * X[0][j] + sum{ c[i] * X[i][j] }, i = 1,...,nvec-1
+   * Z[j] = sum{ c[i] * X[i][j] }, i = 0,...,nvec-1
+   */
+  VFor_Tbb(Z[0], [=](sunindextype lo, sunindextype hi) {
+      realtype *xd, *zd;
+      sunindextype k;
+      int i, j;
+
+      for (j=0; j<nvec; j++) {
+        zd = NV_DATA_TBB(Z[j]);
+
+        /* scale first vector in the sum into the output vector */
+        if ((X[0] == Z) && (c[0] == ONE)) {
+          /* nothing to do for the first vector */
+        } else if (X[0] == Z) {
+          for (k=lo; k<hi; k++)
+            zd[k] *= c[0];
+        } else {
+          xd = NV_DATA_TBB(X[0][j]);
+          for (k=lo; k<hi; k++)
+            zd[k] = c[0] * xd[k];
+        }
+
+        /* scale and sum remaining vectors into the output vector */
+        for (i=1; i<nsum; i++) {
+          xd = NV_DATA_TBB(X[i][j]);
+          for (k=lo; k<hi; k++)
+            zd[k] += c[i] * xd[k];
+        }
+      }
+    });
+
+  return(0);
+}
+
+
+/*
+ * -----------------------------------------------------------------
+ * OPTIONAL XBraid interface operations
+ * -----------------------------------------------------------------
+ */
+
+
+int N_VBufSize_Tbb(N_Vector x, sunindextype *size)
+{
+  if (x == NULL) return(-1);
+  *size = NV_LENGTH_TBB(x) * ((sunindextype)sizeof(realtype));
+  return(0);
+}
+
+
+int N_VBufPack_Tbb(N_Vector x, void *buf)
+{
+  realtype *xd, *bd;
+
+  if (x == NULL || buf == NULL) return(-1);
+
+  xd = NV_DATA_TBB(x);
+  bd = (realtype*) buf;
+
+  VFor_Tbb(x, [=](sunindextype lo, sunindextype hi) {
+      for (sunindextype i = lo; i < hi; i++)
+        bd[i] = xd[i];
+    });
+
+  return(0);
+}
+
+
+int N_VBufUnpack_Tbb(N_Vector x, void *buf)
+{
+  realtype *xd, *bd;
+
+  if (x == NULL || buf == NULL) return(-1);
+
+  xd = NV_DATA_TBB(x);
+  bd = (realtype*) buf;
+
+  VFor_Tbb(x, [=](sunindextype lo, sunindextype hi) {
+      for (sunindextype i = lo; i < hi; i++)
+        xd[i] = bd[i];
+    });
+
+  return(0);
+}
+
+
+/*
+ * -----------------------------------------------------------------
+ * private functions for special cases of vector operations
+ * -----------------------------------------------------------------
+ */
+
+
+/* ----------------------------------------------------------------------------
+ * Copy vector components into a second vector
+ */
+
+static void VCopy_Tbb(N_Vector x, N_Vector z)
+{
+  realtype *xd = NV_DATA_TBB(x);
+  realtype *zd = NV_DATA_TBB(z);
+
+  VFor_Tbb(z, [=](sunindextype lo, sunindextype hi) {
+      for (sunindextype i = lo; i < hi; i++)
+        zd[i] = xd[i];
+    });
+
+  return;
+}
+
+
+/* ----------------------------------------------------------------------------
+ * Compute vector sum
+ */
+
+static void VSum_Tbb(N_Vector x, N_Vector y, N_Vector z)
+{
+  realtype *xd = NV_DATA_TBB(x);
+  realtype *yd = NV_DATA_TBB(y);
+  realtype *zd = NV_DATA_TBB(z);
+
+  VFor_Tbb(z, [=](sunindextype lo, sunindextype hi) {
+      for (sunindextype i = lo; i < hi; i++)
+        zd[i] = xd[i]+yd[i];
+    });
+
+  return;
+}
+
+
+/* ----------------------------------------------------------------------------
+ * Compute vector difference
+ */
+
+static void VDiff_Tbb(N_Vector x, N_Vector y, N_Vector z)
+{
+  realtype *xd = NV_DATA_TBB(x);
+  realtype *yd = NV_DATA_TBB(y);
+  realtype *zd = NV_DATA_TBB(z);
+
+  VFor_Tbb(z, [=](sunindextype lo, sunindextype hi) {
+      for (sunindextype i = lo; i < hi; i++)
+        zd[i] = xd[i]-yd[i];
+    });
+
+  return;
+}
+
+
+/* ----------------------------------------------------------------------------
+ * Compute the negative of a vector
+ */
+
+static void VNeg_Tbb(N_Vector x, N_Vector z)
+{
+  realtype *xd = NV_DATA_TBB(x);
+  realtype *zd = NV_DATA_TBB(z);
+
+  VFor_Tbb(z, [=](sunindextype lo, sunindextype hi) {
+      for (sunindextype i = lo; i < hi; i++)
+        zd[i] = -xd[i];
+    });
+
+  return;
+}
+
+
+/* ----------------------------------------------------------------------------
+ * Compute scaled vector sum
+ */
+
+static void VScaleSum_Tbb(realtype c, N_Vector x, N_Vector y, N_Vector z)
+{
+  realtype *xd = NV_DATA_TBB(x);
+  realtype *yd = NV_DATA_TBB(y);
+  realtype *zd = NV_DATA_TBB(z);
+
+  VFor_Tbb(z, [=](sunindextype lo, sunindextype hi) {
+      for (sunindextype i = lo; i < hi; i++)
+        zd[i] = c*(xd[i]+yd[i]);
+    });
+
+  return;
+}
+
+
+/* ----------------------------------------------------------------------------
+ * Compute scaled vector difference
+ */
+
+static void VScaleDiff_Tbb(realtype c, N_Vector x, N_Vector y, N_Vector z)
+{
+  realtype *xd = NV_DATA_TBB(x);
+  realtype *yd = NV_DATA_TBB(y);
+  realtype *zd = NV_DATA_TBB(z);
+
+  VFor_Tbb(z, [=](sunindextype lo, sunindextype hi) {
+      for (sunindextype i = lo; i < hi; i++)
+        zd[i] = c*(xd[i]-yd[i]);
+    });
+
+  return;
+}
+
+
+/* ----------------------------------------------------------------------------
+ * Compute vector sum z[i] = a*x[i]+y[i]
+ */
+
+static void VLin1_Tbb(realtype a, N_Vector x, N_Vector y, N_Vector z)
+{
+  realtype *xd = NV_DATA_TBB(x);
+  realtype *yd = NV_DATA_TBB(y);
+  realtype *zd = NV_DATA_TBB(z);
+
+  VFor_Tbb(z, [=](sunindextype lo, sunindextype hi) {
+      for (sunindextype i = lo; i < hi; i++)
+        zd[i] = (a*xd[i])+yd[i];
+    });
+
+  return;
+}
+
+
+/* ----------------------------------------------------------------------------
+ * Compute vector difference z[i] = a*x[i]-y[i]
+ */
+
+static void VLin2_Tbb(realtype a, N_Vector x, N_Vector y, N_Vector z)
+{
+  realtype *xd = NV_DATA_TBB(x);
+  realtype *yd = NV_DATA_TBB(y);
+  realtype *zd = NV_DATA_TBB(z);
+
+  VFor_Tbb(z, [=](sunindextype lo, sunindextype hi) {
+      for (sunindextype i = lo; i < hi; i++)
+        zd[i] = (a*xd[i])-yd[i];
+    });
+
+  return;
+}
+
+
+/* ----------------------------------------------------------------------------
+ * Compute special cases of linear sum
+ */
+
+static void Vaxpy_Tbb(realtype a, N_Vector x, N_Vector y)
+{
+  realtype *xd = NV_DATA_TBB(x);
+  realtype *yd = NV_DATA_TBB(y);
+
+  if (a == ONE) {
+    VFor_Tbb(y, [=](sunindextype lo, sunindextype hi) {
+        for (sunindextype i = lo; i < hi; i++)
+          yd[i] += xd[i];
+      });
+    return;
+  }
+
+  if (a == -ONE) {
+    VFor_Tbb(y, [=](sunindextype lo, sunindextype hi) {
+        for (sunindextype i = lo; i < hi; i++)
+          yd[i] -= xd[i];
+      });
+    return;
+  }
+
+  VFor_Tbb(y, [=](sunindextype lo, sunindextype hi) {
+      for (sunindextype i = lo; i < hi; i++)
+        yd[i] += a*xd[i];
+    });
+
+  return;
+}
+
+
+/* ----------------------------------------------------------------------------
+ * Compute scaled vector x[i] = a*x[i]
+ */
+
+static void VScaleBy_Tbb(realtype a, N_Vector x)
+{
+  realtype *xd = NV_DATA_TBB(x);
+
+  VFor_Tbb(x, [=](sunindextype lo, sunindextype hi) {
+      for (sunindextype i = lo; i < hi; i++)
+        xd[i] *= a;
+    });
+
+  return;
+}
+
+
+/*
+ * -----------------------------------------------------------------
+ * private functions for special cases of vector array operations
+ * -----------------------------------------------------------------
+ */
+
+static int VSumVectorArray_Tbb(int nvec, N_Vector* X, N_Vector* Y, N_Vector* Z)
+{
+  VFor_Tbb(Z[0], [=](sunindextype lo, sunindextype hi) {
+      realtype *xd, *yd, *zd;
+      sunindextype j;
+      int i;
+
+      for (i=0; i<nvec; i++) {
+        xd = NV_DATA_TBB(X[i]);
+        yd = NV_DATA_TBB(Y[i]);
+        zd = NV_DATA_TBB(Z[i]);
+        for (j=lo; j<hi; j++)
+          zd[j] = xd[j] + yd[j];
+      }
+    });
+
+  return(0);
+}
+
+static int VDiffVectorArray_Tbb(int nvec, N_Vector* X, N_Vector* Y, N_Vector* Z)
+{
+  VFor_Tbb(Z[0], [=](sunindextype lo, sunindextype hi) {
+      realtype *xd, *yd, *zd;
+      sunindextype j;
+      int i;
+
+      for (i=0; i<nvec; i++) {
+        xd = NV_DATA_TBB(X[i]);
+        yd = NV_DATA_TBB(Y[i]);
+        zd = NV_DATA_TBB(Z[i]);
+        for (j=lo; j<hi; j++)
+          zd[j] = xd[j] - yd[j];
+      }
+    });
+
+  return(0);
+}
+
+static int VScaleSumVectorArray_Tbb(int nvec, realtype c, N_Vector* X, N_Vector* Y, N_Vector* Z)
+{
+  VFor_Tbb(Z[0], [=](sunindextype lo, sunindextype hi) {
+      realtype *xd, *yd, *zd;
+      sunindextype j;
+      int i;
+
+      for (i=0; i<nvec; i++) {
+        xd = NV_DATA_TBB(X[i]);
+        yd = NV_DATA_TBB(Y[i]);
+        zd = NV_DATA_TBB(Z[i]);
+        for (j=lo; j<hi; j++)
+          zd[j] = c * (xd[j] + yd[j]);
+      }
+    });
+
+  return(0);
+}
+
+static int VScaleDiffVectorArray_Tbb(int nvec, realtype c, N_Vector* X, N_Vector* Y, N_Vector* Z)
+{
+  VFor_Tbb(Z[0], [=](sunindextype lo, sunindextype hi) {
+      realtype *xd, *yd, *zd;
+      sunindextype j;
+      int i;
+
+      for (i=0; i<nvec; i++) {
+        xd = NV_DATA_TBB(X[i]);
+        yd = NV_DATA_TBB(Y[i]);
+        zd = NV_DATA_TBB(Z[i]);
+        for (j=lo; j<hi; j++)
+          zd[j] = c * (xd[j] - yd[j]);
+      }
+    });
+
+  return(0);
+}
+
+static int VLin1VectorArray_Tbb(int nvec, realtype a, N_Vector* X, N_Vector* Y, N_Vector* Z)
+{
+  VFor_Tbb(Z[0], [=](sunindextype lo, sunindextype hi) {
+      realtype *xd, *yd, *zd;
+      sunindextype j;
+      int i;
+
+      for (i=0; i<nvec; i++) {
+        xd = NV_DATA_TBB(X[i]);
+        yd = NV_DATA_TBB(Y[i]);
+        zd = NV_DATA_TBB(Z[i]);
+        for (j=lo; j<hi; j++)
+          zd[j] = (a * xd[j]) + yd[j];
+      }
+    });
+
+  return(0);
+}
+
+static int VLin2VectorArray_Tbb(int nvec, realtype a, N_Vector* X, N_Vector* Y, N_Vector* Z)
+{
+  VFor_Tbb(Z[0], [=](sunindextype lo, sunindextype hi) {
+      realtype *xd, *yd, *zd;
+      sunindextype j;
+      int i;
+
+      for (i=0; i<nvec; i++) {
+        xd = NV_DATA_TBB(X[i]);
+        yd = NV_DATA_TBB(Y[i]);
+        zd = NV_DATA_TBB(Z[i]);
+        for (j=lo; j<hi; j++)
+          zd[j] = (a * xd[j]) - yd[j];
+      }
+    });
+
+  return(0);
+}
+
+static int VaxpyVectorArray_Tbb(int nvec, realtype a, N_Vector* X, N_Vector* Y)
+{
+  VFor_Tbb(Y[0], [=](sunindextype lo, sunindextype hi) {
+      realtype *xd, *yd;
+      sunindextype j;
+      int i;
+
+      for (i=0; i<nvec; i++) {
+        xd = NV_DATA_TBB(X[i]);
+        yd = NV_DATA_TBB(Y[i]);
+        if (a == ONE) {
+          for (j=lo; j<hi; j++)
+            yd[j] += xd[j];
+        } else if (a == -ONE) {
+          for (j=lo; j<hi; j++)
+            yd[j] -= xd[j];
+        } else {
+          for (j=lo; j<hi; j++)
+            yd[j] += a * xd[j];
+        }
+      }
+    });
+
+  return(0);
+}
+
+
+/*
+ * -----------------------------------------------------------------
+ * Enable / Disable fused and vector array operations
+ * -----------------------------------------------------------------
+ */
+
+int N_VEnableFusedOps_Tbb(N_Vector v, booleantype tf)
+{
+  /* check that vector is non-NULL */
+  if (v == NULL) return(-1);
+
+  /* check that ops structure is non-NULL */
+  if (v->ops == NULL) return(-1);
+
+  if (tf) {
+    /* enable all fused vector operations */
+    v->ops->nvlinearcombination = N_VLinearCombination_Tbb;
+    v->ops->nvscaleaddmulti     = N_VScaleAddMulti_Tbb;
+    v->ops->nvdotprodmulti      = N_VDotProdMulti_Tbb;
+    /* enable all vector array operations */
+    v->ops->nvlinearsumvectorarray         = N_VLinearSumVectorArray_Tbb;
+    v->ops->nvscalevectorarray             = N_VScaleVectorArray_Tbb;
+    v->ops->nvconstvectorarray             = N_VConstVectorArray_Tbb;
+    v->ops->nvwrmsnormvectorarray          = N_VWrmsNormVectorArray_Tbb;
+    v->ops->nvwrmsnormmaskvectorarray      = N_VWrmsNormMaskVectorArray_Tbb;
+    v->ops->nvscaleaddmultivectorarray     = N_VScaleAddMultiVectorArray_Tbb;
+    v->ops->nvlinearcombinationvectorarray = N_VLinearCombinationVectorArray_Tbb;
+  } else {
+    /* disable all fused vector operations */
+    v->ops->nvlinearcombination = NULL;
+    v->ops->nvscaleaddmulti     = NULL;
+    v->ops->nvdotprodmulti      = NULL;
+    /* disable all vector array operations */
+    v->ops->nvlinearsumvectorarray         = NULL;
+    v->ops->nvscalevectorarray             = NULL;
+    v->ops->nvconstvectorarray             = NULL;
+    v->ops->nvwrmsnormvectorarray          = NULL;
+    v->ops->nvwrmsnormmaskvectorarray      = NULL;
+    v->ops->nvscaleaddmultivectorarray     = NULL;
+    v->ops->nvlinearcombinationvectorarray = NULL;
+  }
+
+  /* return success */
+  return(0);
+}
+
+
+int N_VEnableLinearCombination_Tbb(N_Vector v, booleantype tf)
+{
+  /* check that vector is non-NULL */
+  if (v == NULL) return(-1);
+
+  /* check that ops structure is non-NULL */
+  if (v->ops == NULL) return(-1);
+
+  /* enable/disable operation */
+  if (tf)
+    v->ops->nvlinearcombination = N_VLinearCombination_Tbb;
+  else
+    v->ops->nvlinearcombination = NULL;
+
+  /* return success */
+  return(0);
+}
+
+int N_VEnableScaleAddMulti_Tbb(N_Vector v, booleantype tf)
+{
+  /* check that vector is non-NULL */
+  if (v == NULL) return(-1);
+
+  /* check that ops structure is non-NULL */
+  if (v->ops == NULL) return(-1);
+
+  /* enable/disable operation */
+  if (tf)
+    v->ops->nvscaleaddmulti = N_VScaleAddMulti_Tbb;
+  else
+    v->ops->nvscaleaddmulti = NULL;
+
+  /* return success */
+  return(0);
+}
+
+int N_VEnableDotProdMulti_Tbb(N_Vector v, booleantype tf)
+{
+  /* check that vector is non-NULL */
+  if (v == NULL) return(-1);
+
+  /* check that ops structure is non-NULL */
+  if (v->ops == NULL) return(-1);
+
+  /* enable/disable operation */
+  if (tf)
+    v->ops->nvdotprodmulti = N_VDotProdMulti_Tbb;
+  else
+    v->ops->nvdotprodmulti = NULL;
+
+  /* return success */
+  return(0);
+}
+
+int N_VEnableLinearSumVectorArray_Tbb(N_Vector v, booleantype tf)
+{
+  /* check that vector is non-NULL */
+  if (v == NULL) return(-1);
+
+  /* check that ops structure is non-NULL */
+  if (v->ops == NULL) return(-1);
+
+  /* enable/disable operation */
+  if (tf)
+    v->ops->nvlinearsumvectorarray = N_VLinearSumVectorArray_Tbb;
+  else
+    v->ops->nvlinearsumvectorarray = NULL;
+
+  /* return success */
+  return(0);
+}
+
+int N_VEnableScaleVectorArray_Tbb(N_Vector v, booleantype tf)
+{
+  /* check that vector is non-NULL */
+  if (v == NULL) return(-1);
+
+  /* check that ops structure is non-NULL */
+  if (v->ops == NULL) return(-1);
+
+  /* enable/disable operation */
+  if (tf)
+    v->ops->nvscalevectorarray = N_VScaleVectorArray_Tbb;
+  else
+    v->ops->nvscalevectorarray = NULL;
+
+  /* return success */
+  return(0);
+}
+
+int N_VEnableConstVectorArray_Tbb(N_Vector v, booleantype tf)
+{
+  /* check that vector is non-NULL */
+  if (v == NULL) return(-1);
+
+  /* check that ops structure is non-NULL */
+  if (v->ops == NULL) return(-1);
+
+  /* enable/disable operation */
+  if (tf)
+    v->ops->nvconstvectorarray = N_VConstVectorArray_Tbb;
+  else
+    v->ops->nvconstvectorarray = NULL;
+
+  /* return success */
+  return(0);
+}
+
+int N_VEnableWrmsNormVectorArray_Tbb(N_Vector v, booleantype tf)
+{
+  /* check that vector is non-NULL */
+  if (v == NULL) return(-1);
+
+  /* check that ops structure is non-NULL */
+  if (v->ops == NULL) return(-1);
+
+  /* enable/disable operation */
+  if (tf)
+    v->ops->nvwrmsnormvectorarray = N_VWrmsNormVectorArray_Tbb;
+  else
+    v->ops->nvwrmsnormvectorarray = NULL;
+
+  /* return success */
+  return(0);
+}
+
+int N_VEnableWrmsNormMaskVectorArray_Tbb(N_Vector v, booleantype tf)
+{
+  /* check that vector is non-NULL */
+  if (v == NULL) return(-1);
+
+  /* check that ops structure is non-NULL */
+  if (v->ops == NULL) return(-1);
+
+  /* enable/disable operation */
+  if (tf)
+    v->ops->nvwrmsnormmaskvectorarray = N_VWrmsNormMaskVectorArray_Tbb;
+  else
+    v->ops->nvwrmsnormmaskvectorarray = NULL;
+
+  /* return success */
+  return(0);
+}
+
+int N_VEnableScaleAddMultiVectorArray_Tbb(N_Vector v, booleantype tf)
+{
+  /* check that vector is non-NULL */
+  if (v == NULL) return(-1);
+
+  /* check that ops structure is non-NULL */
+  if (v->ops == NULL) return(-1);
+
+  /* enable/disable operation */
+  if (tf)
+    v->ops->nvscaleaddmultivectorarray = N_VScaleAddMultiVectorArray_Tbb;
+  else
+    v->ops->nvscaleaddmultivectorarray = NULL;
+
+  /* return success */
+  return(0);
+}
+
+int N_VEnableLinearCombinationVectorArray_Tbb(N_Vector v, booleantype tf)
+{
+  /* check that vector is non-NULL */
+  if (v == NULL) return(-1);
+
+  /* check that ops structure is non-NULL */
+  if (v->ops == NULL) return(-1);
+
+  /* enable/disable operation */
+  if (tf)
+    v->ops->nvlinearcombinationvectorarray = N_VLinearCombinationVectorArray_Tbb;
+  else
+    v->ops->nvlinearcombinationvectorarray = NULL;
+
+  /* return success */
+  return(0);
+}
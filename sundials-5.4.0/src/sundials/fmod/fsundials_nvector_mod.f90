@@ -25,12 +25,14 @@ module fsundials_nvector_mod
   enumerator :: SUNDIALS_NVEC_MANYVECTOR
   enumerator :: SUNDIALS_NVEC_MPIMANYVECTOR
   enumerator :: SUNDIALS_NVEC_MPIPLUSX
+  enumerator :: SUNDIALS_NVEC_TBB
   enumerator :: SUNDIALS_NVEC_CUSTOM
  end enum
  integer, parameter, public :: N_Vector_ID = kind(SUNDIALS_NVEC_SERIAL)
  public :: SUNDIALS_NVEC_SERIAL, SUNDIALS_NVEC_PARALLEL, SUNDIALS_NVEC_OPENMP, SUNDIALS_NVEC_PTHREADS, SUNDIALS_NVEC_PARHYP, &
     SUNDIALS_NVEC_PETSC, SUNDIALS_NVEC_CUDA, SUNDIALS_NVEC_RAJA, SUNDIALS_NVEC_OPENMPDEV, SUNDIALS_NVEC_TRILINOS, &
-    SUNDIALS_NVEC_MANYVECTOR, SUNDIALS_NVEC_MPIMANYVECTOR, SUNDIALS_NVEC_MPIPLUSX, SUNDIALS_NVEC_CUSTOM
+    SUNDIALS_NVEC_MANYVECTOR, SUNDIALS_NVEC_MPIMANYVECTOR, SUNDIALS_NVEC_MPIPLUSX, SUNDIALS_NVEC_TBB, &
+    SUNDIALS_NVEC_CUSTOM
  ! struct struct _generic_N_Vector_Ops
  type, bind(C), public :: N_Vector_Ops
   type(C_FUNPTR), public :: nvgetvectorid
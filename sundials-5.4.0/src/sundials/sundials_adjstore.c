@@ -0,0 +1,483 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2020, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the implementation file for the check point store used
+ * by the adjoint modules of CVODES and IDAS.
+ *
+ * SUN_ADJSTORE_FILE keeps the records in slots of an unlinked
+ * temporary file. On POSIX systems the file is mapped into memory
+ * and grown by doubling; elsewhere it is accessed with stdio.
+ * Released slots are kept on a free list and reused for records of
+ * the same slot size, so the file does not grow beyond the largest
+ * number of records alive at the same time.
+ *
+ * SUN_ADJSTORE_ZLIB keeps each record as a zlib compressed buffer.
+ * -----------------------------------------------------------------*/
+
+/* mkstemp, fdopen and ftruncate are POSIX */
+#if !defined(_WIN32) && !defined(_XOPEN_SOURCE)
+#define _XOPEN_SOURCE 600
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <sundials/sundials_config.h>
+#include "sundials_adjstore.h"
+
+#if !defined(_WIN32)
+#include <unistd.h>
+#include <sys/mman.h>
+#define SUN_ADJSTORE_MMAP
+#endif
+
+#ifdef SUNDIALS_ZLIB
+#include <zlib.h>
+#endif
+
+/* size of a file slot is rounded up to a multiple of this */
+#define SLOT_ALIGN 64
+#define SLOT_SIZE(size) \
+  ( ((size) + SLOT_ALIGN - 1) / SLOT_ALIGN * SLOT_ALIGN )
+
+/* initial size of the spill file */
+#define FILE_MIN_SIZE 65536
+
+/*
+ * -----------------------------------------------------------------
+ * Private types
+ * -----------------------------------------------------------------
+ */
+
+struct SUNAdjRecordRec {
+  size_t size;                 /* size of the packed data            */
+  size_t slot;                 /* size of the file slot              */
+  size_t offset;               /* offset of the slot in the file     */
+  unsigned char *zdata;        /* compressed data                    */
+  size_t zsize;                /* size of the compressed data        */
+  struct SUNAdjRecordRec *next;  /* next released slot               */
+};
+
+struct SUNAdjStoreRec {
+  int type;                    /* store type                         */
+
+  unsigned char *buf;          /* staging buffer for packed data     */
+  size_t bufsize;              /* size of the staging buffer         */
+
+  FILE *fp;                    /* spill file                         */
+  size_t fsize;                /* size of the spill file             */
+  size_t fused;                /* end of the last slot in the file   */
+  unsigned char *map;          /* mapping of the spill file          */
+  SUNAdjRecord freeslots;      /* released slots                     */
+};
+
+/*
+ * -----------------------------------------------------------------
+ * Private functions
+ * -----------------------------------------------------------------
+ */
+
+static int adjStorePack(SUNAdjStore store, N_Vector *v, int nv, size_t *size);
+static int adjStoreUnpack(SUNAdjStore store, N_Vector *v, int nv);
+static int adjStoreBuffer(SUNAdjStore store, size_t size);
+static FILE *adjStoreOpenFile(const char *dir);
+static int adjStoreFileSlot(SUNAdjStore store, size_t size, SUNAdjRecord rec);
+static int adjStoreFileWrite(SUNAdjStore store, SUNAdjRecord rec);
+static int adjStoreFileRead(SUNAdjStore store, SUNAdjRecord rec);
+
+/*
+ * -----------------------------------------------------------------
+ * Exported functions
+ * -----------------------------------------------------------------
+ */
+
+booleantype SUNAdjStore_Available(int type)
+{
+  switch (type) {
+  case SUN_ADJSTORE_MEMORY:
+  case SUN_ADJSTORE_FILE:
+    return(SUNTRUE);
+  case SUN_ADJSTORE_ZLIB:
+#ifdef SUNDIALS_ZLIB
+    return(SUNTRUE);
+#else
+    return(SUNFALSE);
+#endif
+  default:
+    return(SUNFALSE);
+  }
+}
+
+booleantype SUNAdjStore_VectorOK(N_Vector v)
+{
+  if (v == NULL || v->ops == NULL) return(SUNFALSE);
+  if (v->ops->nvbufsize == NULL || v->ops->nvbufpack == NULL ||
+      v->ops->nvbufunpack == NULL) return(SUNFALSE);
+  return(SUNTRUE);
+}
+
+SUNAdjStore SUNAdjStore_Create(int type, const char *dir)
+{
+  SUNAdjStore store;
+
+  if (type == SUN_ADJSTORE_MEMORY || !SUNAdjStore_Available(type))
+    return(NULL);
+
+  store = NULL;
+  store = (SUNAdjStore) malloc(sizeof(struct SUNAdjStoreRec));
+  if (store == NULL) return(NULL);
+  memset(store, 0, sizeof(struct SUNAdjStoreRec));
+
+  store->type = type;
+
+  if (type == SUN_ADJSTORE_FILE) {
+    store->fp = adjStoreOpenFile(dir);
+    if (store->fp == NULL) {
+      free(store);
+      return(NULL);
+    }
+  }
+
+  return(store);
+}
+
+int SUNAdjStore_Put(SUNAdjStore store, N_Vector *v, int nv,
+                    SUNAdjRecord *rec)
+{
+  SUNAdjRecord r;
+  size_t size;
+  int retval;
+
+  *rec = NULL;
+
+  retval = adjStorePack(store, v, nv, &size);
+  if (retval != 0) return(retval);
+
+  if (store->type == SUN_ADJSTORE_FILE) {
+
+    /* reuse a released slot of the right size if there is one */
+    r = store->freeslots;
+    while (r != NULL && r->slot != SLOT_SIZE(size)) r = r->next;
+
+    if (r != NULL) {
+      if (r == store->freeslots) {
+        store->freeslots = r->next;
+      } else {
+        SUNAdjRecord prev = store->freeslots;
+        while (prev->next != r) prev = prev->next;
+        prev->next = r->next;
+      }
+      r->next = NULL;
+      r->size = size;
+    } else {
+      r = (SUNAdjRecord) malloc(sizeof(struct SUNAdjRecordRec));
+      if (r == NULL) return(-1);
+      memset(r, 0, sizeof(struct SUNAdjRecordRec));
+      retval = adjStoreFileSlot(store, size, r);
+      if (retval != 0) { free(r); return(retval); }
+    }
+
+    retval = adjStoreFileWrite(store, r);
+    if (retval != 0) { SUNAdjStore_Release(store, r); return(retval); }
+
+  } else {
+
+#ifdef SUNDIALS_ZLIB
+    uLongf zsize;
+
+    r = (SUNAdjRecord) malloc(sizeof(struct SUNAdjRecordRec));
+    if (r == NULL) return(-1);
+    memset(r, 0, sizeof(struct SUNAdjRecordRec));
+    r->size = size;
+
+    zsize = compressBound((uLong) size);
+    r->zdata = (unsigned char *) malloc(zsize);
+    if (r->zdata == NULL) { free(r); return(-1); }
+
+    /* check point data does not compress much beyond what a fast
+       level gives, so trade ratio for speed */
+    if (compress2(r->zdata, &zsize, store->buf, (uLong) size,
+                  Z_BEST_SPEED) != Z_OK) {
+      free(r->zdata); free(r);
+      return(-1);
+    }
+
+    /* shrink the buffer to the compressed size */
+    r->zsize = (size_t) zsize;
+    if (r->zsize > 0) {
+      unsigned char *zdata = (unsigned char *) realloc(r->zdata, r->zsize);
+      if (zdata != NULL) r->zdata = zdata;
+    }
+#else
+    return(-1);
+#endif
+
+  }
+
+  *rec = r;
+  return(0);
+}
+
+int SUNAdjStore_Get(SUNAdjStore store, SUNAdjRecord rec, N_Vector *v,
+                    int nv)
+{
+  int retval;
+
+  if (rec == NULL) return(-1);
+
+  retval = adjStoreBuffer(store, rec->size);
+  if (retval != 0) return(retval);
+
+  if (store->type == SUN_ADJSTORE_FILE) {
+
+    retval = adjStoreFileRead(store, rec);
+    if (retval != 0) return(retval);
+
+  } else {
+
+#ifdef SUNDIALS_ZLIB
+    uLongf size = (uLongf) rec->size;
+    if (uncompress(store->buf, &size, rec->zdata, (uLong) rec->zsize) != Z_OK)
+      return(-1);
+    if ((size_t) size != rec->size) return(-1);
+#else
+    return(-1);
+#endif
+
+  }
+
+  return(adjStoreUnpack(store, v, nv));
+}
+
+void SUNAdjStore_Release(SUNAdjStore store, SUNAdjRecord rec)
+{
+  if (rec == NULL) return;
+
+  if (store->type == SUN_ADJSTORE_FILE) {
+    /* keep the slot for reuse */
+    rec->next = store->freeslots;
+    store->freeslots = rec;
+  } else {
+    if (rec->zdata != NULL) free(rec->zdata);
+    free(rec);
+  }
+}
+
+void SUNAdjStore_Destroy(SUNAdjStore store)
+{
+  SUNAdjRecord r;
+
+  if (store == NULL) return;
+
+  while (store->freeslots != NULL) {
+    r = store->freeslots;
+    store->freeslots = r->next;
+    free(r);
+  }
+
+#ifdef SUN_ADJSTORE_MMAP
+  if (store->map != NULL) munmap(store->map, store->fsize);
+#endif
+  if (store->fp != NULL) fclose(store->fp);
+
+  if (store->buf != NULL) free(store->buf);
+  free(store);
+}
+
+/*
+ * -----------------------------------------------------------------
+ * Packing
+ * -----------------------------------------------------------------
+ */
+
+/*
+ * adjStorePack packs the vectors in v one after the other into the
+ * staging buffer and returns the packed size.
+ */
+
+static int adjStorePack(SUNAdjStore store, N_Vector *v, int nv, size_t *size)
+{
+  sunindextype vsize;
+  size_t offset;
+  int i, retval;
+
+  *size = 0;
+  for (i = 0; i < nv; i++) {
+    retval = N_VBufSize(v[i], &vsize);
+    if (retval != 0) return(-1);
+    *size += (size_t) vsize;
+  }
+
+  retval = adjStoreBuffer(store, *size);
+  if (retval != 0) return(retval);
+
+  offset = 0;
+  for (i = 0; i < nv; i++) {
+    N_VBufSize(v[i], &vsize);
+    retval = N_VBufPack(v[i], store->buf + offset);
+    if (retval != 0) return(-1);
+    offset += (size_t) vsize;
+  }
+
+  return(0);
+}
+
+static int adjStoreUnpack(SUNAdjStore store, N_Vector *v, int nv)
+{
+  sunindextype vsize;
+  size_t offset;
+  int i, retval;
+
+  offset = 0;
+  for (i = 0; i < nv; i++) {
+    retval = N_VBufSize(v[i], &vsize);
+    if (retval != 0) return(-1);
+    retval = N_VBufUnpack(v[i], store->buf + offset);
+    if (retval != 0) return(-1);
+    offset += (size_t) vsize;
+  }
+
+  return(0);
+}
+
+/* adjStoreBuffer makes sure the staging buffer holds size bytes */
+
+static int adjStoreBuffer(SUNAdjStore store, size_t size)
+{
+  unsigned char *buf;
+
+  if (size <= store->bufsize) return(0);
+
+  buf = (unsigned char *) realloc(store->buf, size);
+  if (buf == NULL) return(-1);
+
+  store->buf = buf;
+  store->bufsize = size;
+  return(0);
+}
+
+/*
+ * -----------------------------------------------------------------
+ * Spill file
+ * -----------------------------------------------------------------
+ */
+
+/*
+ * adjStoreOpenFile opens an anonymous spill file in dir. If dir is
+ * NULL, TMPDIR (or /tmp) is used. The file is unlinked right away,
+ * so it is removed when it is closed or the program ends.
+ */
+
+static FILE *adjStoreOpenFile(const char *dir)
+{
+#ifdef SUN_ADJSTORE_MMAP
+  const char *name = "/sundials_ckpnt_XXXXXX";
+  char *path;
+  FILE *fp;
+  int fd;
+
+  if (dir == NULL) dir = getenv("TMPDIR");
+  if (dir == NULL || dir[0] == '\0') dir = "/tmp";
+
+  path = (char *) malloc(strlen(dir) + strlen(name) + 1);
+  if (path == NULL) return(NULL);
+  strcpy(path, dir);
+  strcat(path, name);
+
+  fd = mkstemp(path);
+  if (fd < 0) { free(path); return(NULL); }
+  unlink(path);
+  free(path);
+
+  fp = fdopen(fd, "w+b");
+  if (fp == NULL) close(fd);
+  return(fp);
+#else
+  /* tmpfile always uses the system temporary directory */
+  (void) dir;
+  return(tmpfile());
+#endif
+}
+
+/*
+ * adjStoreFileSlot appends a slot for size bytes to the spill file,
+ * growing the file (and its mapping) by doubling if needed.
+ */
+
+static int adjStoreFileSlot(SUNAdjStore store, size_t size, SUNAdjRecord rec)
+{
+  size_t slot, fsize;
+
+  slot = SLOT_SIZE(size);
+
+  rec->size   = size;
+  rec->slot   = slot;
+  rec->offset = store->fused;
+
+  if (store->fused + slot > store->fsize) {
+
+    fsize = (store->fsize > 0) ? store->fsize : FILE_MIN_SIZE;
+    while (store->fused + slot > fsize) fsize *= 2;
+
+#ifdef SUN_ADJSTORE_MMAP
+    if (store->map != NULL) {
+      munmap(store->map, store->fsize);
+      store->map = NULL;
+    }
+    if (ftruncate(fileno(store->fp), (off_t) fsize) != 0) {
+      /* remap the old size, so that existing records stay readable */
+      if (store->fsize > 0) {
+        store->map = (unsigned char *) mmap(NULL, store->fsize,
+                                            PROT_READ | PROT_WRITE, MAP_SHARED,
+                                            fileno(store->fp), 0);
+        if (store->map == MAP_FAILED) store->map = NULL;
+      }
+      return(-1);
+    }
+    store->map = (unsigned char *) mmap(NULL, fsize, PROT_READ | PROT_WRITE,
+                                        MAP_SHARED, fileno(store->fp), 0);
+    if (store->map == MAP_FAILED) {
+      store->map = NULL;
+      return(-1);
+    }
+#endif
+
+    store->fsize = fsize;
+  }
+
+  store->fused += slot;
+  return(0);
+}
+
+static int adjStoreFileWrite(SUNAdjStore store, SUNAdjRecord rec)
+{
+#ifdef SUN_ADJSTORE_MMAP
+  if (store->map == NULL) return(-1);
+  memcpy(store->map + rec->offset, store->buf, rec->size);
+#else
+  if (fseek(store->fp, (long) rec->offset, SEEK_SET) != 0) return(-1);
+  if (fwrite(store->buf, 1, rec->size, store->fp) != rec->size) return(-1);
+#endif
+  return(0);
+}
+
+static int adjStoreFileRead(SUNAdjStore store, SUNAdjRecord rec)
+{
+#ifdef SUN_ADJSTORE_MMAP
+  if (store->map == NULL) return(-1);
+  memcpy(store->buf, store->map + rec->offset, rec->size);
+#else
+  if (fseek(store->fp, (long) rec->offset, SEEK_SET) != 0) return(-1);
+  if (fread(store->buf, 1, rec->size, store->fp) != rec->size) return(-1);
+#endif
+  return(0);
+}
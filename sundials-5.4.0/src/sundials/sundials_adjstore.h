@@ -0,0 +1,68 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2020, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the private header file for the check point store used
+ * by the adjoint modules of CVODES and IDAS. A store keeps the
+ * N_Vector data of check points outside of the N_Vectors, either
+ * in a spill file mapped into memory or compressed with zlib.
+ *
+ * The vectors are serialized with N_VBufSize, N_VBufPack and
+ * N_VBufUnpack, so the N_Vector implementation must provide
+ * these operations.
+ * -----------------------------------------------------------------*/
+
+#ifndef _SUNDIALS_ADJSTORE_H
+#define _SUNDIALS_ADJSTORE_H
+
+#include <sundials/sundials_nvector.h>
+
+#ifdef __cplusplus  /* wrapper to enable C++ usage */
+extern "C" {
+#endif
+
+/* store types */
+#define SUN_ADJSTORE_MEMORY 0  /* keep the N_Vectors, no store */
+#define SUN_ADJSTORE_FILE   1  /* spill file mapped into memory */
+#define SUN_ADJSTORE_ZLIB   2  /* zlib compressed buffers       */
+
+typedef struct SUNAdjStoreRec  *SUNAdjStore;
+typedef struct SUNAdjRecordRec *SUNAdjRecord;
+
+/* Returns SUNTRUE if the store type is available in this build */
+booleantype SUNAdjStore_Available(int type);
+
+/* Returns SUNTRUE if v supports the operations needed by a store */
+booleantype SUNAdjStore_VectorOK(N_Vector v);
+
+/* Creates a store of the given type. For SUN_ADJSTORE_FILE, dir is
+   the directory of the spill file (NULL for the system default). */
+SUNAdjStore SUNAdjStore_Create(int type, const char *dir);
+
+/* Saves the data of the nv vectors in v as a new record */
+int SUNAdjStore_Put(SUNAdjStore store, N_Vector *v, int nv,
+                    SUNAdjRecord *rec);
+
+/* Loads the data of a record into the nv vectors in v, which must
+   have the shapes of the vectors it was saved from */
+int SUNAdjStore_Get(SUNAdjStore store, SUNAdjRecord rec, N_Vector *v,
+                    int nv);
+
+/* Releases a record */
+void SUNAdjStore_Release(SUNAdjStore store, SUNAdjRecord rec);
+
+/* Destroys the store and all of its records */
+void SUNAdjStore_Destroy(SUNAdjStore store);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
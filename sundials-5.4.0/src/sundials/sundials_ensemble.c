@@ -0,0 +1,122 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2020, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the implementation file for the scheduler of the ensemble
+ * drivers.
+ * -----------------------------------------------------------------*/
+
+#include <stdlib.h>
+
+#include "sundials_ensemble.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+
+/* Members not yet started by a thread, [head, tail). The owner takes
+   members from the head and thieves take them from the tail. Padded to
+   keep the queues of different threads on different cache lines. */
+typedef struct {
+  omp_lock_t lock;
+  int head;
+  int tail;
+  char pad[64];
+} SUNEnsembleQueue;
+
+/* Takes the next member of queue q, or returns -1 if q is empty */
+static int ensemblePop(SUNEnsembleQueue *q)
+{
+  int member = -1;
+
+  omp_set_lock(&(q->lock));
+  if (q->head < q->tail) member = q->head++;
+  omp_unset_lock(&(q->lock));
+
+  return(member);
+}
+
+/* Moves half of the members of another queue to the empty queue of
+   thread tid. Returns 0 if all queues are empty. */
+static int ensembleSteal(SUNEnsembleQueue *queues, int nthreads, int tid)
+{
+  SUNEnsembleQueue *victim;
+  int i, n, head, tail;
+
+  for (i=1; i<nthreads; i++) {
+    victim = &(queues[(tid+i) % nthreads]);
+
+    omp_set_lock(&(victim->lock));
+    n = victim->tail - victim->head;
+    tail = victim->tail;
+    head = tail - (n+1)/2;
+    if (n > 0) victim->tail = head;
+    omp_unset_lock(&(victim->lock));
+
+    if (n > 0) {
+      omp_set_lock(&(queues[tid].lock));
+      queues[tid].head = head;
+      queues[tid].tail = tail;
+      omp_unset_lock(&(queues[tid].lock));
+      return(1);
+    }
+  }
+
+  return(0);
+}
+#endif
+
+void SUNEnsemble_Run(int nmembers, int nthreads, SUNEnsembleMemberFn fn,
+                     void *user_data)
+{
+  int k;
+#ifdef _OPENMP
+  SUNEnsembleQueue *queues;
+  int t;
+
+  if (nthreads > nmembers) nthreads = nmembers;
+
+  queues = NULL;
+  if (nthreads > 1)
+    queues = (SUNEnsembleQueue *) malloc(nthreads*sizeof(SUNEnsembleQueue));
+
+  if (queues != NULL) {
+
+    /* split the members evenly over the threads */
+    for (t=0; t<nthreads; t++) {
+      omp_init_lock(&(queues[t].lock));
+      queues[t].head = (int) (((long int) nmembers * t) / nthreads);
+      queues[t].tail = (int) (((long int) nmembers * (t+1)) / nthreads);
+    }
+
+#pragma omp parallel default(shared) private(k) num_threads(nthreads)
+    {
+      int tid = omp_get_thread_num();
+
+      /* fewer threads may have been started than requested; the
+         queues of the others are emptied by stealing */
+      for(;;) {
+        k = ensemblePop(&(queues[tid]));
+        if (k < 0) {
+          if (!ensembleSteal(queues, nthreads, tid)) break;
+          continue;
+        }
+        fn(k, user_data);
+      }
+    }
+
+    for (t=0; t<nthreads; t++) omp_destroy_lock(&(queues[t].lock));
+    free(queues);
+    return;
+  }
+#endif
+
+  /* serial fallback */
+  for (k=0; k<nmembers; k++) fn(k, user_data);
+}
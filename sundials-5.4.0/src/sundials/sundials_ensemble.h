@@ -0,0 +1,39 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2020, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the private header file for the scheduler used by the
+ * ensemble drivers of CVODE and IDA. It calls a function for each
+ * member of an ensemble on a number of OpenMP threads. The members
+ * are first split evenly over the threads; a thread that runs out
+ * of members steals half of the remaining members of another one,
+ * so that members taking different times keep all threads busy.
+ * -----------------------------------------------------------------*/
+
+#ifndef _SUNDIALS_ENSEMBLE_H
+#define _SUNDIALS_ENSEMBLE_H
+
+#ifdef __cplusplus  /* wrapper to enable C++ usage */
+extern "C" {
+#endif
+
+/* Function called for one member of the ensemble */
+typedef void (*SUNEnsembleMemberFn)(int member, void *user_data);
+
+/* Calls fn for each of the nmembers members on up to nthreads
+   threads. Without OpenMP the members are run in order. */
+void SUNEnsemble_Run(int nmembers, int nthreads, SUNEnsembleMemberFn fn,
+                     void *user_data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
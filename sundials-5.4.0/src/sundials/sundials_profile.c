@@ -0,0 +1,68 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2020, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the implementation file for the phase timers of the
+ * SUNDIALS integrators.
+ * -----------------------------------------------------------------*/
+
+#include <string.h>
+#include <time.h>
+
+#include <sundials/sundials_profile.h>
+#include "sundials_profile_impl.h"
+
+#if defined(SUNDIALS_HAVE_POSIX_TIMERS)
+#include <unistd.h>
+#endif
+
+static const char *phase_names[SUN_PROFILE_NPHASES] = {
+  "rhs", "jac", "lsetup", "lsolve", "errtest", "rootfind", "interp",
+  "nlsolve", "step"
+};
+
+double SUNProfile_Time(void)
+{
+#if defined(SUNDIALS_HAVE_POSIX_TIMERS) && defined(_POSIX_TIMERS)
+  struct timespec spec;
+  clock_gettime(CLOCK_MONOTONIC, &spec);
+  return((double) spec.tv_sec + ((double) spec.tv_nsec)/1.0e9);
+#else
+  return(((double) clock())/CLOCKS_PER_SEC);
+#endif
+}
+
+void SUNProfile_Reset(SUNProfile *prof)
+{
+  memset(prof, 0, sizeof(SUNProfile));
+}
+
+const char *SUNProfile_PhaseName(int phase)
+{
+  if (phase < 0 || phase >= SUN_PROFILE_NPHASES) return(NULL);
+  return(phase_names[phase]);
+}
+
+int SUNProfile_WriteJSON(SUNProfile *prof, FILE *fp)
+{
+  int i;
+
+  if (prof == NULL || fp == NULL) return(-1);
+
+  fprintf(fp, "{");
+  for (i = 0; i < SUN_PROFILE_NPHASES; i++) {
+    fprintf(fp, "%s\"%s\": {\"time\": %.9e, \"calls\": %ld}",
+            (i > 0) ? ", " : "", phase_names[i], prof->time[i],
+            prof->ncalls[i]);
+  }
+  fprintf(fp, "}\n");
+
+  return(0);
+}
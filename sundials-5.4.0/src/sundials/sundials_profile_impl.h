@@ -0,0 +1,48 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2020, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the private header file for the phase timers of the
+ * SUNDIALS integrators. SUNDIALS_PROFILE_BEGIN/END time a phase
+ * in a SUNProfile; they expand to nothing unless SUNDIALS is built
+ * with SUNDIALS_BUILD_WITH_PROFILING.
+ * -----------------------------------------------------------------*/
+
+#ifndef _SUNDIALS_PROFILE_IMPL_H
+#define _SUNDIALS_PROFILE_IMPL_H
+
+#include <sundials/sundials_profile.h>
+
+#ifdef __cplusplus  /* wrapper to enable C++ usage */
+extern "C" {
+#endif
+
+/* Returns the time in seconds of a monotonic clock */
+double SUNProfile_Time(void);
+
+/* Sets all times and calls to zero */
+void SUNProfile_Reset(SUNProfile *prof);
+
+#ifdef SUNDIALS_BUILD_WITH_PROFILING
+#define SUNDIALS_PROFILE_BEGIN(prof, phase)                       \
+  { (prof).tstart[phase] = SUNProfile_Time(); }
+#define SUNDIALS_PROFILE_END(prof, phase)                         \
+  { (prof).time[phase] += SUNProfile_Time() - (prof).tstart[phase]; \
+    (prof).ncalls[phase]++; }
+#else
+#define SUNDIALS_PROFILE_BEGIN(prof, phase)
+#define SUNDIALS_PROFILE_END(prof, phase)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
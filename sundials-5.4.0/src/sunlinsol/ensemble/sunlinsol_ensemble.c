@@ -0,0 +1,399 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2020, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the implementation file for the ensemble implementation
+ * of the SUNLINSOL package.
+ * -----------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <sunlinsol/sunlinsol_ensemble.h>
+#include <sundials/sundials_math.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#define ZERO RCONST(0.0)
+#define ONE  RCONST(1.0)
+
+/*
+ * -----------------------------------------------------------------
+ * Ensemble solver structure accessibility macros:
+ * -----------------------------------------------------------------
+ */
+
+#define ENSEMBLE_CONTENT(S) ( (SUNLinearSolverContent_Ensemble)(S->content) )
+#define PIVOTS(S)           ( ENSEMBLE_CONTENT(S)->pivots )
+#define LASTFLAG(S)         ( ENSEMBLE_CONTENT(S)->last_flag )
+
+/* Private function prototypes */
+static sunindextype ensembleGETRF(realtype *a, sunindextype N, sunindextype n,
+                                  sunindextype *p, sunindextype k0,
+                                  sunindextype k1);
+static void ensembleGETRS(realtype *a, sunindextype N, sunindextype n,
+                          sunindextype *p, realtype *b, sunindextype k0,
+                          sunindextype k1);
+
+/*
+ * -----------------------------------------------------------------
+ * exported functions
+ * -----------------------------------------------------------------
+ */
+
+/* ----------------------------------------------------------------------------
+ * Function to create a new ensemble linear solver
+ */
+
+SUNLinearSolver SUNLinSol_Ensemble(N_Vector y, SUNMatrix A)
+{
+  SUNLinearSolver S;
+  SUNLinearSolverContent_Ensemble content;
+
+  /* Check compatibility with supplied SUNMatrix and N_Vector */
+  if (SUNMatGetID(A) != SUNMATRIX_ENSEMBLE) return(NULL);
+
+  if ( (N_VGetVectorID(y) != SUNDIALS_NVEC_SERIAL) &&
+       (N_VGetVectorID(y) != SUNDIALS_NVEC_OPENMP) &&
+       (N_VGetVectorID(y) != SUNDIALS_NVEC_PTHREADS) &&
+       (N_VGetVectorID(y) != SUNDIALS_NVEC_TBB) )
+    return(NULL);
+
+  if (SUNEnsembleMatrix_Rows(A) != N_VGetLength(y)) return(NULL);
+
+  /* Create an empty linear solver */
+  S = NULL;
+  S = SUNLinSolNewEmpty();
+  if (S == NULL) return(NULL);
+
+  /* Attach operations */
+  S->ops->gettype    = SUNLinSolGetType_Ensemble;
+  S->ops->getid      = SUNLinSolGetID_Ensemble;
+  S->ops->initialize = SUNLinSolInitialize_Ensemble;
+  S->ops->setup      = SUNLinSolSetup_Ensemble;
+  S->ops->solve      = SUNLinSolSolve_Ensemble;
+  S->ops->lastflag   = SUNLinSolLastFlag_Ensemble;
+  S->ops->space      = SUNLinSolSpace_Ensemble;
+  S->ops->free       = SUNLinSolFree_Ensemble;
+
+  /* Create content */
+  content = NULL;
+  content = (SUNLinearSolverContent_Ensemble) malloc(sizeof *content);
+  if (content == NULL) { SUNLinSolFree(S); return(NULL); }
+
+  /* Attach content */
+  S->content = content;
+
+  /* Fill content */
+  content->nmembers  = SUNEnsembleMatrix_Members(A);
+  content->blocksize = SUNEnsembleMatrix_BlockSize(A);
+  content->last_flag = 0;
+  content->pivots    = NULL;
+
+  /* Allocate content */
+  content->pivots = (sunindextype *)
+    malloc(content->nmembers * content->blocksize * sizeof(sunindextype));
+  if (content->pivots == NULL) { SUNLinSolFree(S); return(NULL); }
+
+  return(S);
+}
+
+/*
+ * -----------------------------------------------------------------
+ * implementation of linear solver operations
+ * -----------------------------------------------------------------
+ */
+
+SUNLinearSolver_Type SUNLinSolGetType_Ensemble(SUNLinearSolver S)
+{
+  return(SUNLINEARSOLVER_DIRECT);
+}
+
+SUNLinearSolver_ID SUNLinSolGetID_Ensemble(SUNLinearSolver S)
+{
+  return(SUNLINEARSOLVER_ENSEMBLE);
+}
+
+int SUNLinSolInitialize_Ensemble(SUNLinearSolver S)
+{
+  /* all solver-specific memory has already been allocated */
+  LASTFLAG(S) = SUNLS_SUCCESS;
+  return(SUNLS_SUCCESS);
+}
+
+int SUNLinSolSetup_Ensemble(SUNLinearSolver S, SUNMatrix A)
+{
+  realtype *A_data;
+  sunindextype *pivots, N, n, fail;
+
+  /* check for valid inputs */
+  if ( (A == NULL) || (S == NULL) )
+    return(SUNLS_MEM_NULL);
+
+  /* Ensure that A is an ensemble matrix of the right shape */
+  if ( (SUNMatGetID(A) != SUNMATRIX_ENSEMBLE) ||
+       (SUNEnsembleMatrix_Members(A) != ENSEMBLE_CONTENT(S)->nmembers) ||
+       (SUNEnsembleMatrix_BlockSize(A) != ENSEMBLE_CONTENT(S)->blocksize) ) {
+    LASTFLAG(S) = SUNLS_ILL_INPUT;
+    return(SUNLS_ILL_INPUT);
+  }
+
+  /* access data pointers (return with failure on NULL) */
+  A_data = NULL;
+  pivots = NULL;
+  A_data = SUNEnsembleMatrix_Data(A);
+  pivots = PIVOTS(S);
+  if ( (A_data == NULL) || (pivots == NULL) ) {
+    LASTFLAG(S) = SUNLS_MEM_FAIL;
+    return(SUNLS_MEM_FAIL);
+  }
+
+  N = ENSEMBLE_CONTENT(S)->nmembers;
+  n = ENSEMBLE_CONTENT(S)->blocksize;
+
+  /* perform LU factorization of all blocks, each thread on a contiguous
+     range of members; keep the first zero-valued pivot over all members */
+#ifdef _OPENMP
+  fail = 0;
+#pragma omp parallel default(shared) \
+  num_threads(SM_NTHREADS_E(A)) if(SM_NTHREADS_E(A) > 1)
+  {
+    int tid = omp_get_thread_num();
+    int nthr = omp_get_num_threads();
+    sunindextype tfail = ensembleGETRF(A_data, N, n, pivots, (N*tid)/nthr,
+                                       (N*(tid+1))/nthr);
+#pragma omp critical
+    {
+      if ( (tfail > 0) && ((fail == 0) || (tfail < fail)) ) fail = tfail;
+    }
+  }
+#else
+  fail = ensembleGETRF(A_data, N, n, pivots, 0, N);
+#endif
+
+  /* store error flag (if nonzero, this row encountered zero-valued pivot) */
+  LASTFLAG(S) = fail;
+  if (LASTFLAG(S) > 0)
+    return(SUNLS_LUFACT_FAIL);
+  return(SUNLS_SUCCESS);
+}
+
+int SUNLinSolSolve_Ensemble(SUNLinearSolver S, SUNMatrix A, N_Vector x,
+                            N_Vector b, realtype tol)
+{
+  realtype *A_data, *xdata;
+  sunindextype *pivots, N, n;
+
+  if ( (A == NULL) || (S == NULL) || (x == NULL) || (b == NULL) )
+    return(SUNLS_MEM_NULL);
+
+  /* copy b into x */
+  N_VScale(ONE, b, x);
+
+  /* access data pointers (return with failure on NULL) */
+  A_data = NULL;
+  xdata = NULL;
+  pivots = NULL;
+  A_data = SUNEnsembleMatrix_Data(A);
+  xdata = N_VGetArrayPointer(x);
+  pivots = PIVOTS(S);
+  if ( (A_data == NULL) || (xdata == NULL)  || (pivots == NULL) ) {
+    LASTFLAG(S) = SUNLS_MEM_FAIL;
+    return(SUNLS_MEM_FAIL);
+  }
+
+  N = ENSEMBLE_CONTENT(S)->nmembers;
+  n = ENSEMBLE_CONTENT(S)->blocksize;
+
+  /* solve using LU factors */
+#ifdef _OPENMP
+#pragma omp parallel default(shared) \
+  num_threads(SM_NTHREADS_E(A)) if(SM_NTHREADS_E(A) > 1)
+  {
+    int tid = omp_get_thread_num();
+    int nthr = omp_get_num_threads();
+    ensembleGETRS(A_data, N, n, pivots, xdata, (N*tid)/nthr,
+                  (N*(tid+1))/nthr);
+  }
+#else
+  ensembleGETRS(A_data, N, n, pivots, xdata, 0, N);
+#endif
+
+  LASTFLAG(S) = SUNLS_SUCCESS;
+  return(SUNLS_SUCCESS);
+}
+
+sunindextype SUNLinSolLastFlag_Ensemble(SUNLinearSolver S)
+{
+  /* return the stored 'last_flag' value */
+  if (S == NULL) return(-1);
+  return(LASTFLAG(S));
+}
+
+int SUNLinSolSpace_Ensemble(SUNLinearSolver S,
+                            long int *lenrwLS,
+                            long int *leniwLS)
+{
+  *leniwLS = 3 + ENSEMBLE_CONTENT(S)->nmembers * ENSEMBLE_CONTENT(S)->blocksize;
+  *lenrwLS = 0;
+  return(SUNLS_SUCCESS);
+}
+
+int SUNLinSolFree_Ensemble(SUNLinearSolver S)
+{
+  /* return if S is already free */
+  if (S == NULL) return(SUNLS_SUCCESS);
+
+  /* delete items from contents, then delete generic structure */
+  if (S->content) {
+    if (PIVOTS(S)) {
+      free(PIVOTS(S));
+      PIVOTS(S) = NULL;
+    }
+    free(S->content);
+    S->content = NULL;
+  }
+  if (S->ops) {
+    free(S->ops);
+    S->ops = NULL;
+  }
+  free(S); S = NULL;
+  return(SUNLS_SUCCESS);
+}
+
+/*
+ * -----------------------------------------------------------------
+ * private functions
+ * -----------------------------------------------------------------
+ */
+
+/* ----------------------------------------------------------------------------
+ * LU factorization with partial pivoting of the blocks of the members
+ * k0 <= m < k1, as denseGETRF does for one block. Entry (i,j) of member m
+ * is a[(j*n+i)*N+m] and the pivot row of column j is p[j*N+m]. Returns 0,
+ * or j+1 for the first column j with a zero pivot in one of the members.
+ */
+
+static sunindextype ensembleGETRF(realtype *a, sunindextype N, sunindextype n,
+                                  sunindextype *p, sunindextype k0,
+                                  sunindextype k1)
+{
+  sunindextype i, j, k, l, m, fail;
+  realtype *col_k, *col_j, *akk, *aik, *ail, *akj, *aij, tmp;
+
+  fail = 0;
+
+  for (k=0; k<n; k++) {
+
+    col_k = a + k*n*N;
+    akk   = col_k + k*N;
+
+    /* find the pivot row of each member and swap it into row k */
+    for (m=k0; m<k1; m++) {
+      l = k;
+      for (i=k+1; i<n; i++)
+        if (SUNRabs(col_k[i*N+m]) > SUNRabs(col_k[l*N+m])) l = i;
+      p[k*N+m] = l;
+
+      if (col_k[l*N+m] == ZERO) {
+        if (fail == 0) fail = k+1;
+        continue;
+      }
+
+      if (l != k) {
+        for (j=0; j<n; j++) {
+          col_j = a + j*n*N;
+          tmp = col_j[l*N+m];
+          col_j[l*N+m] = col_j[k*N+m];
+          col_j[k*N+m] = tmp;
+        }
+      }
+    }
+
+    /* a zero pivot leaves the factorization of that member incomplete,
+       which is reported to the caller */
+    if (fail > 0) return(fail);
+
+    /* scale the elements below the diagonal in column k */
+    for (i=k+1; i<n; i++) {
+      aik = col_k + i*N;
+      for (m=k0; m<k1; m++)
+        aik[m] /= akk[m];
+    }
+
+    /* row_i -= a(i,k) * row_k for i > k, in columns j > k */
+    for (j=k+1; j<n; j++) {
+      col_j = a + j*n*N;
+      akj   = col_j + k*N;
+      for (i=k+1; i<n; i++) {
+        aij = col_j + i*N;
+        ail = col_k + i*N;
+        for (m=k0; m<k1; m++)
+          aij[m] -= ail[m]*akj[m];
+      }
+    }
+  }
+
+  return(0);
+}
+
+/* ----------------------------------------------------------------------------
+ * Solves A x = b for the members k0 <= m < k1 with the factors computed by
+ * ensembleGETRF; b is overwritten with x.
+ */
+
+static void ensembleGETRS(realtype *a, sunindextype N, sunindextype n,
+                          sunindextype *p, realtype *b, sunindextype k0,
+                          sunindextype k1)
+{
+  sunindextype i, k, m, pk;
+  realtype *col_k, *aik, *bi, *bk, tmp;
+
+  /* Permute b, based on pivot information in p */
+  for (k=0; k<n; k++) {
+    for (m=k0; m<k1; m++) {
+      pk = p[k*N+m];
+      if (pk != k) {
+        tmp = b[k*N+m];
+        b[k*N+m] = b[pk*N+m];
+        b[pk*N+m] = tmp;
+      }
+    }
+  }
+
+  /* Solve Ly = b, store solution y in b */
+  for (k=0; k<n-1; k++) {
+    col_k = a + k*n*N;
+    bk    = b + k*N;
+    for (i=k+1; i<n; i++) {
+      aik = col_k + i*N;
+      bi  = b + i*N;
+      for (m=k0; m<k1; m++)
+        bi[m] -= aik[m]*bk[m];
+    }
+  }
+
+  /* Solve Ux = y, store solution x in b */
+  for (k=n-1; k>=0; k--) {
+    col_k = a + k*n*N;
+    bk    = b + k*N;
+    aik   = col_k + k*N;
+    for (m=k0; m<k1; m++)
+      bk[m] /= aik[m];
+    for (i=0; i<k; i++) {
+      aik = col_k + i*N;
+      bi  = b + i*N;
+      for (m=k0; m<k1; m++)
+        bi[m] -= aik[m]*bk[m];
+    }
+  }
+}
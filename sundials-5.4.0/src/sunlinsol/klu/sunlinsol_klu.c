@@ -18,10 +18,17 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include <sunlinsol/sunlinsol_klu.h>
 #include <sundials/sundials_math.h>
 
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
 #define ZERO      RCONST(0.0)
 #define ONE       RCONST(1.0)
 #define TWO       RCONST(2.0)
@@ -37,9 +44,15 @@
 #define LASTFLAG(S)        ( KLU_CONTENT(S)->last_flag )
 #define FIRSTFACTORIZE(S)  ( KLU_CONTENT(S)->first_factorize )
 #define SYMBOLIC(S)        ( KLU_CONTENT(S)->symbolic )
+#define SYMCACHED(S)       ( KLU_CONTENT(S)->symbolic_cached )
 #define NUMERIC(S)         ( KLU_CONTENT(S)->numeric )
 #define COMMON(S)          ( KLU_CONTENT(S)->common )
 #define SOLVE(S)           ( KLU_CONTENT(S)->klu_solver )
+#define GROWTHTOL(S)       ( KLU_CONTENT(S)->growth_tol )
+#define RESIDTOL(S)        ( KLU_CONTENT(S)->resid_tol )
+#define RGROWTHREF(S)      ( KLU_CONTENT(S)->rgrowth_ref )
+#define REPIVOTNEXT(S)     ( KLU_CONTENT(S)->repivot_next )
+#define RESID(S)           ( KLU_CONTENT(S)->resid )
 
 /*
  * -----------------------------------------------------------------
@@ -57,6 +70,61 @@
 #define KLU_INDEXTYPE int
 #endif
 
+/*
+ * -----------------------------------------------------------------
+ * symbolic cache
+ * -----------------------------------------------------------------
+ * The cache is a list of symbolic analyses, most recently used
+ * first.  Each entry keeps a copy of the sparsity pattern it was
+ * computed for, so that a hash collision is never mistaken for a
+ * hit.  Entries in use by a solver (refcount > 0) are not evicted.
+ * All accesses to the list and to the counters below are made with
+ * cache_lock held, since solvers in different threads share them.
+ * -----------------------------------------------------------------
+ */
+
+typedef struct _SUNKLUCacheEntry {
+  unsigned long    hash;
+  sunindextype     n, nnz;
+  int              ordering, btf;
+  sunindextype     nd_threshold;
+  sunindextype     *colptr;
+  sunindextype     *rowind;
+  sun_klu_symbolic *symbolic;
+  int              refcount;
+  struct _SUNKLUCacheEntry *next;
+} *SUNKLUCacheEntry;
+
+static SUNKLUCacheEntry cache_head = NULL;
+static int      cache_size      = 0;
+static int      cache_max       = SUNKLU_SYMBOLIC_CACHE_DEFAULT;
+static long int cache_hits      = 0;
+static long int cache_misses    = 0;
+static long int cache_evictions = 0;
+
+#if defined(_WIN32)
+static SRWLOCK cache_lock = SRWLOCK_INIT;
+#define CACHE_LOCK()   AcquireSRWLockExclusive(&cache_lock)
+#define CACHE_UNLOCK() ReleaseSRWLockExclusive(&cache_lock)
+#else
+static pthread_mutex_t cache_lock = PTHREAD_MUTEX_INITIALIZER;
+#define CACHE_LOCK()   pthread_mutex_lock(&cache_lock)
+#define CACHE_UNLOCK() pthread_mutex_unlock(&cache_lock)
+#endif
+
+/* private functions */
+static unsigned long sunklu_pattern_hash(sunindextype n, sunindextype *colptr,
+                                         sunindextype *rowind);
+static void sunklu_cache_evict(int max_entries, sun_klu_common *common);
+static SUNKLUCacheEntry sunklu_cache_acquire(unsigned long hash,
+                                             sunindextype n,
+                                             sunindextype *colptr,
+                                             sunindextype *rowind,
+                                             sun_klu_common *common);
+static int sunklu_get_symbolic(SUNLinearSolver S, SUNMatrix A);
+static void sunklu_release_symbolic(SUNLinearSolver S);
+static int sunklu_factor(SUNLinearSolver S, SUNMatrix A);
+
 
 /*
  * -----------------------------------------------------------------
@@ -130,7 +198,17 @@ SUNLinearSolver SUNLinSol_KLU(N_Vector y, SUNMatrix A)
   content->last_flag       = 0;
   content->first_factorize = 1;
   content->symbolic        = NULL;
+  content->symbolic_cached = 0;
   content->numeric         = NULL;
+  content->growth_tol      = SUNKLU_GROWTH_TOL_DEFAULT;
+  content->resid_tol       = SUNKLU_RESID_TOL_DEFAULT;
+  content->rgrowth_ref     = ZERO;
+  content->repivot_next    = 0;
+  content->resid           = NULL;
+  content->nrefactor       = 0;
+  content->nrepivot        = 0;
+  content->nreanalyze      = 0;
+  content->nrejected       = 0;
 
 #if defined(SUNDIALS_INT64_T)
   if (SUNSparseMatrix_SparseType(A) == CSC_MAT) {
@@ -183,7 +261,7 @@ int SUNLinSol_KLUReInit(SUNLinearSolver S, SUNMatrix A,
 
   /* Free the prior factorazation and reset for first factorization */
   if( SYMBOLIC(S) != NULL)
-    sun_klu_free_symbolic(&SYMBOLIC(S), &COMMON(S));
+    sunklu_release_symbolic(S);
   if( NUMERIC(S) != NULL)
     sun_klu_free_numeric(&NUMERIC(S), &COMMON(S));
   FIRSTFACTORIZE(S) = 1;
@@ -199,7 +277,7 @@ int SUNLinSol_KLUReInit(SUNLinearSolver S, SUNMatrix A,
 int SUNLinSol_KLUSetOrdering(SUNLinearSolver S, int ordering_choice)
 {
   /* Check for legal ordering_choice */
-  if ((ordering_choice < 0) || (ordering_choice > 2))
+  if ((ordering_choice < 0) || (ordering_choice > 4) || (ordering_choice == 3))
     return(SUNLS_ILL_INPUT);
 
   /* Check for non-NULL SUNLinearSolver */
@@ -212,6 +290,94 @@ int SUNLinSol_KLUSetOrdering(SUNLinearSolver S, int ordering_choice)
   return(LASTFLAG(S));
 }
 
+/* ----------------------------------------------------------------------------
+ * Function to set the policy for choosing between refactorization (reusing
+ * the pivot sequence) and factorization with new pivoting.  A refactorization
+ * is rejected if KLU finds a zero pivot, if its reciprocal pivot growth drops
+ * below growth_tol times that of the last factorization with pivoting, or if
+ * the matrix appears to be ill-conditioned.  If resid_tol > 0, each solve
+ * also checks the relative residual ||b - Ax||/||b|| in the max norm, and
+ * a residual above resid_tol forces new pivoting on the next setup.  Either
+ * check is disabled by a zero tolerance, which is the default; the pivot
+ * growth then is not computed at all.  If the growth check is enabled after
+ * the last factorization with pivoting, the first refactorization checked
+ * provides the reference growth.
+ */
+
+int SUNLinSol_KLUSetPivotPolicy(SUNLinearSolver S, realtype growth_tol,
+                                realtype resid_tol)
+{
+  /* Check for non-NULL SUNLinearSolver */
+  if (S == NULL) return(SUNLS_MEM_NULL);
+
+  /* Check for legal tolerances */
+  if ((growth_tol < ZERO) || (growth_tol > ONE) || (resid_tol < ZERO)) {
+    LASTFLAG(S) = SUNLS_ILL_INPUT;
+    return(LASTFLAG(S));
+  }
+
+  GROWTHTOL(S) = growth_tol;
+  RESIDTOL(S)  = resid_tol;
+
+  LASTFLAG(S) = SUNLS_SUCCESS;
+  return(LASTFLAG(S));
+}
+
+/* ----------------------------------------------------------------------------
+ * Functions to control the symbolic cache shared by all KLU linear solvers
+ */
+
+int SUNLinSol_KLUSetSymbolicCache(int max_entries)
+{
+  sun_klu_common common;
+
+  /* Check for legal max_entries (0 disables the cache) */
+  if (max_entries < 0)
+    return(SUNLS_ILL_INPUT);
+
+  if (sun_klu_defaults(&common) == 0)
+    return(SUNLS_PACKAGE_FAIL_UNREC);
+
+  /* Evict the entries beyond the new limit that are not in use */
+  CACHE_LOCK();
+  cache_max = max_entries;
+  if (cache_size > cache_max)
+    sunklu_cache_evict(cache_max, &common);
+  CACHE_UNLOCK();
+
+  return(SUNLS_SUCCESS);
+}
+
+int SUNLinSol_KLUGetSymbolicCacheStats(long int *hits, long int *misses,
+                                       long int *evictions)
+{
+  if ((hits == NULL) || (misses == NULL) || (evictions == NULL))
+    return(SUNLS_MEM_NULL);
+
+  CACHE_LOCK();
+  *hits      = cache_hits;
+  *misses    = cache_misses;
+  *evictions = cache_evictions;
+  CACHE_UNLOCK();
+  return(SUNLS_SUCCESS);
+}
+
+int SUNLinSol_KLUFreeSymbolicCache(void)
+{
+  sun_klu_common common;
+
+  if (sun_klu_defaults(&common) == 0)
+    return(SUNLS_PACKAGE_FAIL_UNREC);
+
+  /* Free all entries that are not in use; the others are freed once
+     released by their solvers, unless the cache has room for them */
+  CACHE_LOCK();
+  sunklu_cache_evict(0, &common);
+  CACHE_UNLOCK();
+
+  return(SUNLS_SUCCESS);
+}
+
 
 /*
  * -----------------------------------------------------------------
@@ -234,6 +400,21 @@ sun_klu_common* SUNLinSol_KLUGetCommon(SUNLinearSolver S)
   return(&(COMMON(S)));
 }
 
+int SUNLinSol_KLUGetPivotStats(SUNLinearSolver S, long int *nrefactor,
+                               long int *nrepivot, long int *nreanalyze,
+                               long int *nrejected)
+{
+  if ((S == NULL) || (nrefactor == NULL) || (nrepivot == NULL) ||
+      (nreanalyze == NULL) || (nrejected == NULL))
+    return(SUNLS_MEM_NULL);
+
+  *nrefactor  = KLU_CONTENT(S)->nrefactor;
+  *nrepivot   = KLU_CONTENT(S)->nrepivot;
+  *nreanalyze = KLU_CONTENT(S)->nreanalyze;
+  *nrejected  = KLU_CONTENT(S)->nrejected;
+  return(SUNLS_SUCCESS);
+}
+
 
 /*
  * -----------------------------------------------------------------
@@ -265,7 +446,7 @@ int SUNLinSolInitialize_KLU(SUNLinearSolver S)
 
 int SUNLinSolSetup_KLU(SUNLinearSolver S, SUNMatrix A)
 {
-  int retval;
+  int retval, repivot;
   realtype uround_twothirds;
 
   uround_twothirds = SUNRpowerR(UNIT_ROUNDOFF,TWOTHIRDS);
@@ -279,14 +460,11 @@ int SUNLinSolSetup_KLU(SUNLinearSolver S, SUNMatrix A)
   /* On first decomposition, get the symbolic factorization */
   if (FIRSTFACTORIZE(S)) {
 
-    /* Perform symbolic analysis of sparsity structure */
+    /* Perform symbolic analysis of sparsity structure, or reuse a
+       cached one for the same structure */
     if (SYMBOLIC(S))
-      sun_klu_free_symbolic(&SYMBOLIC(S), &COMMON(S));
-    SYMBOLIC(S) = sun_klu_analyze(SUNSparseMatrix_NP(A),
-                                  (KLU_INDEXTYPE*) SUNSparseMatrix_IndexPointers(A),
-                                  (KLU_INDEXTYPE*) SUNSparseMatrix_IndexValues(A),
-                                  &COMMON(S));
-    if (SYMBOLIC(S) == NULL) {
+      sunklu_release_symbolic(S);
+    if (sunklu_get_symbolic(S, A) != 0) {
       LASTFLAG(S) = SUNLS_PACKAGE_FAIL_UNREC;
       return(LASTFLAG(S));
     }
@@ -294,75 +472,104 @@ int SUNLinSolSetup_KLU(SUNLinearSolver S, SUNMatrix A)
     /* ------------------------------------------------------------
        Compute the LU factorization of the matrix
        ------------------------------------------------------------*/
-    if(NUMERIC(S))
-      sun_klu_free_numeric(&NUMERIC(S), &COMMON(S));
-    NUMERIC(S) = sun_klu_factor((KLU_INDEXTYPE*) SUNSparseMatrix_IndexPointers(A),
-                                (KLU_INDEXTYPE*) SUNSparseMatrix_IndexValues(A),
-                                SUNSparseMatrix_Data(A),
-                                SYMBOLIC(S),
-                                &COMMON(S));
-    if (NUMERIC(S) == NULL) {
-      LASTFLAG(S) = SUNLS_PACKAGE_FAIL_UNREC;
+    retval = sunklu_factor(S, A);
+    if (retval != SUNLS_SUCCESS) {
+      LASTFLAG(S) = retval;
       return(LASTFLAG(S));
     }
 
+    KLU_CONTENT(S)->nreanalyze++;
     FIRSTFACTORIZE(S) = 0;
 
-  } else {   /* not the first decomposition, so just refactor */
+  } else {   /* not the first decomposition, so try to refactor */
 
-    retval = sun_klu_refactor((KLU_INDEXTYPE*) SUNSparseMatrix_IndexPointers(A),
-                              (KLU_INDEXTYPE*) SUNSparseMatrix_IndexValues(A),
-                              SUNSparseMatrix_Data(A),
-                              SYMBOLIC(S),
-                              NUMERIC(S),
-                              &COMMON(S));
-    if (retval == 0) {
-      LASTFLAG(S) = SUNLS_PACKAGE_FAIL_REC;
-      return(LASTFLAG(S));
+    /* a poor solve since the last setup asks for new pivoting */
+    repivot = REPIVOTNEXT(S);
+
+    if (!repivot) {
+      retval = sun_klu_refactor((KLU_INDEXTYPE*) SUNSparseMatrix_IndexPointers(A),
+                                (KLU_INDEXTYPE*) SUNSparseMatrix_IndexValues(A),
+                                SUNSparseMatrix_Data(A),
+                                SYMBOLIC(S),
+                                NUMERIC(S),
+                                &COMMON(S));
+      if (retval == 0) {
+        /* a zero pivot in the old pivot sequence may be avoided by
+           pivoting again; any other failure is returned */
+        if (COMMON(S).status != KLU_SINGULAR) {
+          LASTFLAG(S) = SUNLS_PACKAGE_FAIL_REC;
+          return(LASTFLAG(S));
+        }
+        repivot = 1;
+      }
     }
 
     /*-----------------------------------------------------------
-      Check if a cheap estimate of the reciprocal of the condition
-      number is getting too small.  If so, delete
-      the prior numeric factorization and recompute it.
+      Check if the pivot growth of the refactorization is much
+      worse than that of the last factorization with pivoting.
       -----------------------------------------------------------*/
 
-    retval = sun_klu_rcond(SYMBOLIC(S), NUMERIC(S), &COMMON(S));
-    if (retval == 0) {
-      LASTFLAG(S) = SUNLS_PACKAGE_FAIL_REC;
-      return(LASTFLAG(S));
-    }
-
-    if ( COMMON(S).rcond < uround_twothirds ) {
-
-      /* Condition number may be getting large.
-	 Compute more accurate estimate */
-      retval = sun_klu_condest((KLU_INDEXTYPE*) SUNSparseMatrix_IndexPointers(A),
+    if (!repivot && (GROWTHTOL(S) > ZERO)) {
+      retval = sun_klu_rgrowth((KLU_INDEXTYPE*) SUNSparseMatrix_IndexPointers(A),
+                               (KLU_INDEXTYPE*) SUNSparseMatrix_IndexValues(A),
                                SUNSparseMatrix_Data(A),
                                SYMBOLIC(S),
                                NUMERIC(S),
                                &COMMON(S));
       if (retval == 0) {
-	LASTFLAG(S) = SUNLS_PACKAGE_FAIL_REC;
+        LASTFLAG(S) = SUNLS_PACKAGE_FAIL_REC;
+        return(LASTFLAG(S));
+      }
+      if (RGROWTHREF(S) == ZERO)
+        RGROWTHREF(S) = COMMON(S).rgrowth;
+      if (COMMON(S).rgrowth < GROWTHTOL(S)*RGROWTHREF(S))
+        repivot = 1;
+    }
+
+    /*-----------------------------------------------------------
+      Check if a cheap estimate of the reciprocal of the condition
+      number is getting too small.  If so, delete
+      the prior numeric factorization and recompute it.
+      -----------------------------------------------------------*/
+
+    if (!repivot) {
+      retval = sun_klu_rcond(SYMBOLIC(S), NUMERIC(S), &COMMON(S));
+      if (retval == 0) {
+        LASTFLAG(S) = SUNLS_PACKAGE_FAIL_REC;
         return(LASTFLAG(S));
       }
 
-      if ( COMMON(S).condest > (ONE/uround_twothirds) ) {
-
-	/* More accurate estimate also says condition number is
-	   large, so recompute the numeric factorization */
-	sun_klu_free_numeric(&NUMERIC(S), &COMMON(S));
-	NUMERIC(S) = sun_klu_factor((KLU_INDEXTYPE*) SUNSparseMatrix_IndexPointers(A),
-                                    (KLU_INDEXTYPE*) SUNSparseMatrix_IndexValues(A),
-                                    SUNSparseMatrix_Data(A),
-                                    SYMBOLIC(S),
-                                    &COMMON(S));
-	if (NUMERIC(S) == NULL) {
-	  LASTFLAG(S) = SUNLS_PACKAGE_FAIL_UNREC;
+      if ( COMMON(S).rcond < uround_twothirds ) {
+
+        /* Condition number may be getting large.
+           Compute more accurate estimate */
+        retval = sun_klu_condest((KLU_INDEXTYPE*) SUNSparseMatrix_IndexPointers(A),
+                                 SUNSparseMatrix_Data(A),
+                                 SYMBOLIC(S),
+                                 NUMERIC(S),
+                                 &COMMON(S));
+        if (retval == 0) {
+          LASTFLAG(S) = SUNLS_PACKAGE_FAIL_REC;
           return(LASTFLAG(S));
-	}
+        }
+
+        /* More accurate estimate also says condition number is
+           large, so recompute the numeric factorization */
+        if ( COMMON(S).condest > (ONE/uround_twothirds) )
+          repivot = 1;
       }
+    }
 
+    if (repivot) {
+      if (!REPIVOTNEXT(S)) KLU_CONTENT(S)->nrejected++;
+      retval = sunklu_factor(S, A);
+      if (retval != SUNLS_SUCCESS) {
+        LASTFLAG(S) = retval;
+        return(LASTFLAG(S));
+      }
+      KLU_CONTENT(S)->nrepivot++;
+    } else {
+      KLU_CONTENT(S)->nrefactor++;
     }
   }
 
@@ -400,6 +607,25 @@ int SUNLinSolSolve_KLU(SUNLinearSolver S, SUNMatrix A, N_Vector x,
     return(LASTFLAG(S));
   }
 
+  /* Check the residual, and ask for new pivoting on the next setup if the
+     factorization was not accurate enough */
+  if ((RESIDTOL(S) > ZERO) && (x != b)) {
+    if (RESID(S) == NULL) {
+      RESID(S) = N_VClone(x);
+      if (RESID(S) == NULL) {
+        LASTFLAG(S) = SUNLS_MEM_FAIL;
+        return(LASTFLAG(S));
+      }
+    }
+    if (SUNMatMatvec(A, x, RESID(S)) != 0) {
+      LASTFLAG(S) = SUNLS_PACKAGE_FAIL_REC;
+      return(LASTFLAG(S));
+    }
+    N_VLinearSum(ONE, b, -ONE, RESID(S), RESID(S));
+    if (N_VMaxNorm(RESID(S)) > RESIDTOL(S)*N_VMaxNorm(b))
+      REPIVOTNEXT(S) = 1;
+  }
+
   LASTFLAG(S) = SUNLS_SUCCESS;
   return(LASTFLAG(S));
 }
@@ -434,7 +660,9 @@ int SUNLinSolFree_KLU(SUNLinearSolver S)
     if (NUMERIC(S))
       sun_klu_free_numeric(&NUMERIC(S), &COMMON(S));
     if (SYMBOLIC(S))
-      sun_klu_free_symbolic(&SYMBOLIC(S), &COMMON(S));
+      sunklu_release_symbolic(S);
+    if (RESID(S))
+      N_VDestroy(RESID(S));
     free(S->content);
     S->content = NULL;
   }
@@ -447,3 +675,260 @@ int SUNLinSolFree_KLU(SUNLinearSolver S)
   free(S); S = NULL;
   return(SUNLS_SUCCESS);
 }
+
+
+/*
+ * -----------------------------------------------------------------
+ * private functions
+ * -----------------------------------------------------------------
+ */
+
+/* ----------------------------------------------------------------------------
+ * Compute the numeric factorization with pivoting, and record its pivot
+ * growth as the reference for later refactorizations
+ */
+
+static int sunklu_factor(SUNLinearSolver S, SUNMatrix A)
+{
+  int retval;
+
+  if (NUMERIC(S))
+    sun_klu_free_numeric(&NUMERIC(S), &COMMON(S));
+  NUMERIC(S) = sun_klu_factor((KLU_INDEXTYPE*) SUNSparseMatrix_IndexPointers(A),
+                              (KLU_INDEXTYPE*) SUNSparseMatrix_IndexValues(A),
+                              SUNSparseMatrix_Data(A),
+                              SYMBOLIC(S),
+                              &COMMON(S));
+  if (NUMERIC(S) == NULL)
+    return(SUNLS_PACKAGE_FAIL_UNREC);
+
+  REPIVOTNEXT(S) = 0;
+  RGROWTHREF(S)  = ZERO;
+  if (GROWTHTOL(S) > ZERO) {
+    retval = sun_klu_rgrowth((KLU_INDEXTYPE*) SUNSparseMatrix_IndexPointers(A),
+                             (KLU_INDEXTYPE*) SUNSparseMatrix_IndexValues(A),
+                             SUNSparseMatrix_Data(A),
+                             SYMBOLIC(S),
+                             NUMERIC(S),
+                             &COMMON(S));
+    if (retval == 0)
+      return(SUNLS_PACKAGE_FAIL_REC);
+    RGROWTHREF(S) = COMMON(S).rgrowth;
+  }
+
+  return(SUNLS_SUCCESS);
+}
+
+/* ----------------------------------------------------------------------------
+ * FNV-1a style hash of a sparsity pattern
+ */
+
+static unsigned long sunklu_pattern_hash(sunindextype n, sunindextype *colptr,
+                                         sunindextype *rowind)
+{
+  unsigned long hash;
+  sunindextype i;
+
+  hash = 2166136261UL;
+  hash = (hash ^ (unsigned long) n) * 16777619UL;
+  for (i = 0; i <= n; i++)
+    hash = (hash ^ (unsigned long) colptr[i]) * 16777619UL;
+  for (i = 0; i < colptr[n]; i++)
+    hash = (hash ^ (unsigned long) rowind[i]) * 16777619UL;
+
+  return(hash);
+}
+
+/* ----------------------------------------------------------------------------
+ * Evict least recently used entries that are not in use, until at most
+ * max_entries are left (or all remaining entries are in use).  Called with
+ * cache_lock held.
+ */
+
+static void sunklu_cache_evict(int max_entries, sun_klu_common *common)
+{
+  SUNKLUCacheEntry e, *prev, *lru;
+
+  while (cache_size > max_entries) {
+
+    /* find the last (least recently used) entry that is not in use */
+    lru = NULL;
+    for (prev = &cache_head; (*prev) != NULL; prev = &((*prev)->next))
+      if ((*prev)->refcount == 0) lru = prev;
+    if (lru == NULL) return;
+
+    /* unlink and free it */
+    e = *lru;
+    *lru = e->next;
+    sun_klu_free_symbolic(&(e->symbolic), common);
+    free(e->colptr);
+    free(e->rowind);
+    free(e);
+    cache_size--;
+    cache_evictions++;
+  }
+}
+
+/* ----------------------------------------------------------------------------
+ * Look for an entry for the pattern colptr/rowind and the ordering settings
+ * of common.  A hit is moved to the front of the list and its refcount is
+ * incremented.  Called with cache_lock held.
+ */
+
+static SUNKLUCacheEntry sunklu_cache_acquire(unsigned long hash,
+                                             sunindextype n,
+                                             sunindextype *colptr,
+                                             sunindextype *rowind,
+                                             sun_klu_common *common)
+{
+  SUNKLUCacheEntry e, *prev;
+  sunindextype nnz;
+
+  nnz = colptr[n];
+  for (prev = &cache_head; (e = *prev) != NULL; prev = &(e->next)) {
+    if ((e->hash == hash) && (e->n == n) && (e->nnz == nnz) &&
+        (e->ordering == common->ordering) && (e->btf == common->btf) &&
+        (e->nd_threshold == common->nd_threshold) &&
+        (memcmp(e->colptr, colptr, (n+1)*sizeof(sunindextype)) == 0) &&
+        (memcmp(e->rowind, rowind, nnz*sizeof(sunindextype)) == 0)) {
+      *prev = e->next;
+      e->next = cache_head;
+      cache_head = e;
+      e->refcount++;
+      return(e);
+    }
+  }
+  return(NULL);
+}
+
+/* ----------------------------------------------------------------------------
+ * Set SYMBOLIC(S) for the pattern of A, from the cache if possible.  Returns
+ * 0 on success and 1 if the symbolic analysis failed.
+ */
+
+static int sunklu_get_symbolic(SUNLinearSolver S, SUNMatrix A)
+{
+  SUNKLUCacheEntry e, hit;
+  sunindextype n, nnz, *colptr, *rowind;
+  unsigned long hash;
+  int use_cache, inserted;
+
+  n      = SUNSparseMatrix_NP(A);
+  colptr = SUNSparseMatrix_IndexPointers(A);
+  rowind = SUNSparseMatrix_IndexValues(A);
+  nnz    = colptr[n];
+
+  SYMCACHED(S) = 0;
+
+  /* a user ordering function may depend on more than the pattern */
+  CACHE_LOCK();
+  use_cache = (cache_max > 0) && (COMMON(S).ordering != 3);
+  CACHE_UNLOCK();
+  if (!use_cache) {
+    SYMBOLIC(S) = sun_klu_analyze(n, (KLU_INDEXTYPE*) colptr,
+                                  (KLU_INDEXTYPE*) rowind, &COMMON(S));
+    return((SYMBOLIC(S) == NULL) ? 1 : 0);
+  }
+
+  hash = sunklu_pattern_hash(n, colptr, rowind);
+  CACHE_LOCK();
+  hit = sunklu_cache_acquire(hash, n, colptr, rowind, &COMMON(S));
+  if (hit != NULL) cache_hits++;
+  else             cache_misses++;
+  CACHE_UNLOCK();
+  if (hit != NULL) {
+    SYMBOLIC(S) = hit->symbolic;
+    SYMCACHED(S) = 1;
+    return(0);
+  }
+
+  /* the analysis is done without the lock, so that solvers in other
+     threads are not held up by it */
+  SYMBOLIC(S) = sun_klu_analyze(n, (KLU_INDEXTYPE*) colptr,
+                                (KLU_INDEXTYPE*) rowind, &COMMON(S));
+  if (SYMBOLIC(S) == NULL) return(1);
+
+  /* if memory is short, the analysis simply stays private to this solver */
+  e = (SUNKLUCacheEntry) malloc(sizeof *e);
+  if (e == NULL) return(0);
+  e->colptr = (sunindextype *) malloc((n+1)*sizeof(sunindextype));
+  e->rowind = (sunindextype *) malloc((nnz > 0 ? nnz : 1)*sizeof(sunindextype));
+  if ((e->colptr == NULL) || (e->rowind == NULL)) {
+    free(e->colptr);
+    free(e->rowind);
+    free(e);
+    return(0);
+  }
+  memcpy(e->colptr, colptr, (n+1)*sizeof(sunindextype));
+  memcpy(e->rowind, rowind, nnz*sizeof(sunindextype));
+  e->hash     = hash;
+  e->n        = n;
+  e->nnz      = nnz;
+  e->ordering = COMMON(S).ordering;
+  e->btf      = COMMON(S).btf;
+  e->nd_threshold = COMMON(S).nd_threshold;
+  e->symbolic = SYMBOLIC(S);
+  e->refcount = 1;
+
+  inserted = 0;
+  CACHE_LOCK();
+
+  /* another solver may have added the same pattern in the meantime;
+     otherwise make room for the new entry, unless all entries are in use */
+  hit = sunklu_cache_acquire(hash, n, colptr, rowind, &COMMON(S));
+  if (hit == NULL) {
+    sunklu_cache_evict(cache_max-1, &COMMON(S));
+    if (cache_size < cache_max) {
+      e->next    = cache_head;
+      cache_head = e;
+      cache_size++;
+      inserted   = 1;
+    }
+  }
+
+  CACHE_UNLOCK();
+
+  if (hit != NULL) {
+    sun_klu_free_symbolic(&SYMBOLIC(S), &COMMON(S));
+    SYMBOLIC(S) = hit->symbolic;
+  }
+  if (!inserted) {
+    free(e->colptr);
+    free(e->rowind);
+    free(e);
+  }
+  SYMCACHED(S) = (hit != NULL) || inserted;
+  return(0);
+}
+
+/* ----------------------------------------------------------------------------
+ * Free SYMBOLIC(S), or hand it back to the cache if it is owned by the cache
+ */
+
+static void sunklu_release_symbolic(SUNLinearSolver S)
+{
+  SUNKLUCacheEntry e;
+
+  if (!SYMCACHED(S)) {
+    sun_klu_free_symbolic(&SYMBOLIC(S), &COMMON(S));
+    return;
+  }
+
+  CACHE_LOCK();
+
+  for (e = cache_head; e != NULL; e = e->next) {
+    if (e->symbolic == SYMBOLIC(S)) {
+      e->refcount--;
+      break;
+    }
+  }
+
+  /* the cache may have been shrunk while the entry was in use */
+  if (cache_size > cache_max)
+    sunklu_cache_evict(cache_max, &COMMON(S));
+
+  CACHE_UNLOCK();
+
+  SYMBOLIC(S) = NULL;
+  SYMCACHED(S) = 0;
+}
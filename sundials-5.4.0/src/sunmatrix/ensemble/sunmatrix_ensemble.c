@@ -0,0 +1,429 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2020, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the implementation file for the ensemble implementation
+ * of the SUNMATRIX package.
+ * -----------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <sunmatrix/sunmatrix_ensemble.h>
+#include <sundials/sundials_nvector.h>
+#include <sundials/sundials_math.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#define ZERO RCONST(0.0)
+#define ONE  RCONST(1.0)
+
+
+/* Private function prototypes */
+static booleantype SMCompatible_Ensemble(SUNMatrix A, SUNMatrix B);
+static booleantype SMCompatible2_Ensemble(SUNMatrix A, N_Vector x, N_Vector y);
+static void Matvec_Members(SUNMatrix A, realtype *xd, realtype *yd,
+                           sunindextype k0, sunindextype k1);
+
+
+/*
+ * -----------------------------------------------------------------
+ * exported functions
+ * -----------------------------------------------------------------
+ */
+
+/* ----------------------------------------------------------------------------
+ * Function to create a new ensemble matrix
+ */
+
+SUNMatrix SUNEnsembleMatrix(sunindextype nmembers, sunindextype blocksize)
+{
+  SUNMatrix A;
+  SUNMatrixContent_Ensemble content;
+
+  /* return with NULL matrix on illegal dimension input */
+  if ( (nmembers <= 0) || (blocksize <= 0) ) return(NULL);
+
+  /* Create an empty matrix object */
+  A = NULL;
+  A = SUNMatNewEmpty();
+  if (A == NULL) return(NULL);
+
+  /* Attach operations */
+  A->ops->getid     = SUNMatGetID_Ensemble;
+  A->ops->clone     = SUNMatClone_Ensemble;
+  A->ops->destroy   = SUNMatDestroy_Ensemble;
+  A->ops->zero      = SUNMatZero_Ensemble;
+  A->ops->copy      = SUNMatCopy_Ensemble;
+  A->ops->scaleadd  = SUNMatScaleAdd_Ensemble;
+  A->ops->scaleaddi = SUNMatScaleAddI_Ensemble;
+  A->ops->matvec    = SUNMatMatvec_Ensemble;
+  A->ops->space     = SUNMatSpace_Ensemble;
+
+  /* Create content */
+  content = NULL;
+  content = (SUNMatrixContent_Ensemble) malloc(sizeof *content);
+  if (content == NULL) { SUNMatDestroy(A); return(NULL); }
+
+  /* Attach content */
+  A->content = content;
+
+  /* Fill content */
+  content->nmembers  = nmembers;
+  content->blocksize = blocksize;
+  content->ldata     = blocksize*blocksize*nmembers;
+  content->data      = NULL;
+  content->nthreads  = 1;
+
+  /* Allocate content */
+  content->data = (realtype *) calloc(content->ldata, sizeof(realtype));
+  if (content->data == NULL) { SUNMatDestroy(A); return(NULL); }
+
+  return(A);
+}
+
+
+/* ----------------------------------------------------------------------------
+ * Function to print the ensemble matrix, one block per member
+ */
+
+void SUNEnsembleMatrix_Print(SUNMatrix A, FILE* outfile)
+{
+  sunindextype i, j, k;
+
+  /* should not be called unless A is an ensemble matrix;
+     otherwise return immediately */
+  if (SUNMatGetID(A) != SUNMATRIX_ENSEMBLE)
+    return;
+
+  /* perform operation */
+  fprintf(outfile,"\n");
+  for (k=0; k<SM_MEMBERS_E(A); k++) {
+    fprintf(outfile,"member %ld\n", (long int) k);
+    for (i=0; i<SM_BLOCKSIZE_E(A); i++) {
+      for (j=0; j<SM_BLOCKSIZE_E(A); j++) {
+#if defined(SUNDIALS_EXTENDED_PRECISION)
+        fprintf(outfile,"%12Lg  ", SM_ELEMENT_E(A,k,i,j));
+#elif defined(SUNDIALS_DOUBLE_PRECISION)
+        fprintf(outfile,"%12g  ", SM_ELEMENT_E(A,k,i,j));
+#else
+        fprintf(outfile,"%12g  ", SM_ELEMENT_E(A,k,i,j));
+#endif
+      }
+      fprintf(outfile,"\n");
+    }
+    fprintf(outfile,"\n");
+  }
+  return;
+}
+
+
+/* ----------------------------------------------------------------------------
+ * Functions to access the contents of the ensemble matrix structure
+ */
+
+sunindextype SUNEnsembleMatrix_Members(SUNMatrix A)
+{
+  if (SUNMatGetID(A) == SUNMATRIX_ENSEMBLE)
+    return SM_MEMBERS_E(A);
+  else
+    return SUNMAT_ILL_INPUT;
+}
+
+sunindextype SUNEnsembleMatrix_BlockSize(SUNMatrix A)
+{
+  if (SUNMatGetID(A) == SUNMATRIX_ENSEMBLE)
+    return SM_BLOCKSIZE_E(A);
+  else
+    return SUNMAT_ILL_INPUT;
+}
+
+sunindextype SUNEnsembleMatrix_Rows(SUNMatrix A)
+{
+  if (SUNMatGetID(A) == SUNMATRIX_ENSEMBLE)
+    return SM_BLOCKSIZE_E(A)*SM_MEMBERS_E(A);
+  else
+    return SUNMAT_ILL_INPUT;
+}
+
+sunindextype SUNEnsembleMatrix_LData(SUNMatrix A)
+{
+  if (SUNMatGetID(A) == SUNMATRIX_ENSEMBLE)
+    return SM_LDATA_E(A);
+  else
+    return SUNMAT_ILL_INPUT;
+}
+
+realtype* SUNEnsembleMatrix_Data(SUNMatrix A)
+{
+  if (SUNMatGetID(A) == SUNMATRIX_ENSEMBLE)
+    return SM_DATA_E(A);
+  else
+    return NULL;
+}
+
+
+/* ----------------------------------------------------------------------------
+ * Function to set the number of threads used by the matrix operations. It
+ * only has an effect when the library is built with OpenMP.
+ */
+
+int SUNEnsembleMatrix_SetNumThreads(SUNMatrix A, int nthreads)
+{
+  /* check for valid matrix type */
+  if (SUNMatGetID(A) != SUNMATRIX_ENSEMBLE)  return SUNMAT_ILL_INPUT;
+
+  /* check for valid number of threads */
+  if (nthreads < 1)  return SUNMAT_ILL_INPUT;
+
+  SM_NTHREADS_E(A) = nthreads;
+
+  return SUNMAT_SUCCESS;
+}
+
+
+/*
+ * -----------------------------------------------------------------
+ * implementation of matrix operations
+ * -----------------------------------------------------------------
+ */
+
+SUNMatrix_ID SUNMatGetID_Ensemble(SUNMatrix A)
+{
+  return SUNMATRIX_ENSEMBLE;
+}
+
+SUNMatrix SUNMatClone_Ensemble(SUNMatrix A)
+{
+  SUNMatrix B = SUNEnsembleMatrix(SM_MEMBERS_E(A), SM_BLOCKSIZE_E(A));
+  if (B != NULL) SM_NTHREADS_E(B) = SM_NTHREADS_E(A);
+  return(B);
+}
+
+void SUNMatDestroy_Ensemble(SUNMatrix A)
+{
+  if (A == NULL) return;
+
+  /* free content */
+  if (A->content != NULL) {
+    /* free data array */
+    if (SM_DATA_E(A) != NULL) {
+      free(SM_DATA_E(A));
+      SM_DATA_E(A) = NULL;
+    }
+    /* free content struct */
+    free(A->content);
+    A->content = NULL;
+  }
+
+  /* free ops and matrix */
+  if (A->ops) { free(A->ops); A->ops = NULL; }
+  free(A); A = NULL;
+
+  return;
+}
+
+int SUNMatZero_Ensemble(SUNMatrix A)
+{
+  sunindextype i;
+  realtype *Adata;
+
+  /* Perform operation */
+  Adata = SM_DATA_E(A);
+#ifdef _OPENMP
+#pragma omp parallel for default(shared) private(i) schedule(static) \
+  num_threads(SM_NTHREADS_E(A)) if(SM_NTHREADS_E(A) > 1)
+#endif
+  for (i=0; i<SM_LDATA_E(A); i++)
+    Adata[i] = ZERO;
+  return SUNMAT_SUCCESS;
+}
+
+int SUNMatCopy_Ensemble(SUNMatrix A, SUNMatrix B)
+{
+  sunindextype i;
+  realtype *Adata, *Bdata;
+
+  /* Verify that A and B are compatible */
+  if (!SMCompatible_Ensemble(A, B))
+    return SUNMAT_ILL_INPUT;
+
+  /* Perform operation */
+  Adata = SM_DATA_E(A);
+  Bdata = SM_DATA_E(B);
+#ifdef _OPENMP
+#pragma omp parallel for default(shared) private(i) schedule(static) \
+  num_threads(SM_NTHREADS_E(B)) if(SM_NTHREADS_E(B) > 1)
+#endif
+  for (i=0; i<SM_LDATA_E(A); i++)
+    Bdata[i] = Adata[i];
+  return SUNMAT_SUCCESS;
+}
+
+int SUNMatScaleAddI_Ensemble(realtype c, SUNMatrix A)
+{
+  sunindextype i, k, N, n;
+  realtype *Adata, *Aii;
+
+  /* Perform operation */
+  Adata = SM_DATA_E(A);
+  N = SM_MEMBERS_E(A);
+  n = SM_BLOCKSIZE_E(A);
+#ifdef _OPENMP
+#pragma omp parallel for default(shared) private(i) schedule(static) \
+  num_threads(SM_NTHREADS_E(A)) if(SM_NTHREADS_E(A) > 1)
+#endif
+  for (i=0; i<SM_LDATA_E(A); i++)
+    Adata[i] *= c;
+
+  /* the diagonal entries of all members are contiguous per row */
+  for (i=0; i<n; i++) {
+    Aii = Adata + (i*n + i)*N;
+    for (k=0; k<N; k++)
+      Aii[k] += ONE;
+  }
+  return SUNMAT_SUCCESS;
+}
+
+int SUNMatScaleAdd_Ensemble(realtype c, SUNMatrix A, SUNMatrix B)
+{
+  sunindextype i;
+  realtype *Adata, *Bdata;
+
+  /* Verify that A and B are compatible */
+  if (!SMCompatible_Ensemble(A, B))
+    return SUNMAT_ILL_INPUT;
+
+  /* Perform operation */
+  Adata = SM_DATA_E(A);
+  Bdata = SM_DATA_E(B);
+#ifdef _OPENMP
+#pragma omp parallel for default(shared) private(i) schedule(static) \
+  num_threads(SM_NTHREADS_E(A)) if(SM_NTHREADS_E(A) > 1)
+#endif
+  for (i=0; i<SM_LDATA_E(A); i++)
+    Adata[i] = c*Adata[i] + Bdata[i];
+  return SUNMAT_SUCCESS;
+}
+
+int SUNMatMatvec_Ensemble(SUNMatrix A, N_Vector x, N_Vector y)
+{
+  realtype *xd, *yd;
+
+  /* Verify that A, x and y are compatible */
+  if (!SMCompatible2_Ensemble(A, x, y))
+    return SUNMAT_ILL_INPUT;
+
+  /* access vector data (return if failure) */
+  xd = N_VGetArrayPointer(x);
+  yd = N_VGetArrayPointer(y);
+  if ((xd == NULL) || (yd == NULL) || (xd == yd))
+    return SUNMAT_MEM_FAIL;
+
+  /* Perform operation, each thread on a contiguous range of members */
+#ifdef _OPENMP
+#pragma omp parallel default(shared) \
+  num_threads(SM_NTHREADS_E(A)) if(SM_NTHREADS_E(A) > 1)
+  {
+    sunindextype N = SM_MEMBERS_E(A);
+    int tid = omp_get_thread_num();
+    int nthr = omp_get_num_threads();
+    Matvec_Members(A, xd, yd, (N*tid)/nthr, (N*(tid+1))/nthr);
+  }
+#else
+  Matvec_Members(A, xd, yd, 0, SM_MEMBERS_E(A));
+#endif
+  return SUNMAT_SUCCESS;
+}
+
+int SUNMatSpace_Ensemble(SUNMatrix A, long int *lenrw, long int *leniw)
+{
+  *lenrw = SM_LDATA_E(A);
+  *leniw = 4;
+  return SUNMAT_SUCCESS;
+}
+
+
+/*
+ * -----------------------------------------------------------------
+ * private functions
+ * -----------------------------------------------------------------
+ */
+
+static booleantype SMCompatible_Ensemble(SUNMatrix A, SUNMatrix B)
+{
+  /* both matrices must be SUNMATRIX_ENSEMBLE */
+  if (SUNMatGetID(A) != SUNMATRIX_ENSEMBLE)
+    return SUNFALSE;
+  if (SUNMatGetID(B) != SUNMATRIX_ENSEMBLE)
+    return SUNFALSE;
+
+  /* both matrices must have the same shape */
+  if (SM_MEMBERS_E(A) != SM_MEMBERS_E(B))
+    return SUNFALSE;
+  if (SM_BLOCKSIZE_E(A) != SM_BLOCKSIZE_E(B))
+    return SUNFALSE;
+
+  return SUNTRUE;
+}
+
+
+static booleantype SMCompatible2_Ensemble(SUNMatrix A, N_Vector x, N_Vector y)
+{
+  sunindextype n;
+
+  /*   vectors must be one of {SERIAL, OPENMP, PTHREADS, TBB} */
+  if ( (N_VGetVectorID(x) != SUNDIALS_NVEC_SERIAL) &&
+       (N_VGetVectorID(x) != SUNDIALS_NVEC_OPENMP) &&
+       (N_VGetVectorID(x) != SUNDIALS_NVEC_PTHREADS) &&
+       (N_VGetVectorID(x) != SUNDIALS_NVEC_TBB) )
+    return SUNFALSE;
+
+  /* the vectors hold all members */
+  n = SM_BLOCKSIZE_E(A)*SM_MEMBERS_E(A);
+  if ( (N_VGetLength(x) != n) || (N_VGetLength(y) != n) )
+    return SUNFALSE;
+
+  return SUNTRUE;
+}
+
+
+/* ----------------------------------------------------------------------------
+ * y = A x for the members k0 <= k < k1. The innermost loop runs over the
+ * members, which are contiguous in A, x and y.
+ */
+
+static void Matvec_Members(SUNMatrix A, realtype *xd, realtype *yd,
+                           sunindextype k0, sunindextype k1)
+{
+  sunindextype i, j, k, N, n;
+  realtype *Aij, *xj, *yi;
+
+  N = SM_MEMBERS_E(A);
+  n = SM_BLOCKSIZE_E(A);
+
+  for (i=0; i<n; i++) {
+    yi = yd + i*N;
+    for (k=k0; k<k1; k++)
+      yi[k] = ZERO;
+  }
+
+  for (j=0; j<n; j++) {
+    xj = xd + j*N;
+    for (i=0; i<n; i++) {
+      Aij = SM_DATA_E(A) + (j*n + i)*N;
+      yi  = yd + i*N;
+      for (k=k0; k<k1; k++)
+        yi[k] += Aij[k]*xj[k];
+    }
+  }
+}
@@ -22,20 +22,62 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include <sunmatrix/sunmatrix_sparse.h>
 #include <sundials/sundials_nvector.h>
 #include <sundials/sundials_math.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #define ZERO RCONST(0.0)
 #define ONE  RCONST(1.0)
 
+/* Merged sparsity pattern of the operands of the last SUNMatScaleAdd or
+   SUNMatScaleAddI call, and work arrays of the matrix operations. The
+   patterns of A and B are kept to detect when the merged pattern can be
+   reused; the copy of A is not kept when A already contains B. */
+struct _SUNMatrixWork_Sparse {
+  booleantype identity;  /* B is the identity matrix                      */
+  sunindextype Anz;      /* nonzeros in the pattern of A                  */
+  sunindextype *Ap;      /* copy of the pattern of A (NULL if C == A)     */
+  sunindextype *Ai;
+  sunindextype Bnz;      /* nonzeros in B (min(M,N) for the identity)     */
+  sunindextype *Bp;      /* copy of the pattern of B (NULL for I)         */
+  sunindextype *Bi;
+  sunindextype Cnz;      /* nonzeros in the merged pattern                */
+  sunindextype *Cp;      /* merged pattern                                */
+  sunindextype *Ci;
+  sunindextype *Amap;    /* position of each entry of A in the merged one */
+  sunindextype *Bmap;    /* position of each entry of B in the merged one */
+  realtype *Cx;          /* values of the merged matrix                   */
+  sunindextype ylen;     /* length of yw                                  */
+  realtype *yw;          /* per-thread products of the CSC matvec         */
+};
+
+typedef struct _SUNMatrixWork_Sparse *SUNMatrixWork_Sparse;
+
 /* Private function prototypes */
 static booleantype SMCompatible_Sparse(SUNMatrix A, SUNMatrix B);
 static booleantype SMCompatible2_Sparse(SUNMatrix A, N_Vector x, N_Vector y);
 static int Matvec_SparseCSC(SUNMatrix A, N_Vector x, N_Vector y);
 static int Matvec_SparseCSR(SUNMatrix A, N_Vector x, N_Vector y);
+#ifdef _OPENMP
+static int Matvec_SparseCSC_OMP(SUNMatrix A, realtype *xd, realtype *yd);
+#endif
 static int format_convert(const SUNMatrix A, SUNMatrix B);
+static int ScaleAdd_Merged(realtype c, SUNMatrix A, SUNMatrix B);
+static int merge_pattern(SUNMatrix A, SUNMatrix B);
+static void free_merge(SUNMatrixWork_Sparse work);
+static booleantype same_pattern(sunindextype NP, sunindextype nz,
+                                sunindextype *Ap, sunindextype *Ai,
+                                sunindextype *Cp, sunindextype *Ci);
+static int compare_index(const void *a, const void *b);
+static int transpose_pattern(sunindextype np, sunindextype nq,
+                             sunindextype *Ap, sunindextype *Ai,
+                             sunindextype **Tp, sunindextype **Ti);
 
 /*
  * -----------------------------------------------------------------
@@ -112,6 +154,8 @@ SUNMatrix SUNSparseMatrix(sunindextype M, sunindextype N,
   content->data      = NULL;
   content->indexvals = NULL;
   content->indexptrs = NULL;
+  content->nthreads  = 1;
+  content->work      = NULL;
 
   /* Allocate content */
   content->data = (realtype *) calloc(NNZ, sizeof(realtype));
@@ -339,6 +383,123 @@ int SUNSparseMatrix_Reallocate(SUNMatrix A, sunindextype NNZ)
 }
 
 
+/* ----------------------------------------------------------------------------
+ * Function to set the number of threads used by the copy, scale-add and matvec
+ * operations. It only has an effect when the library is built with OpenMP.
+ */
+
+int SUNSparseMatrix_SetNumThreads(SUNMatrix A, int nthreads)
+{
+  /* check for valid matrix type */
+  if (SUNMatGetID(A) != SUNMATRIX_SPARSE)  return SUNMAT_ILL_INPUT;
+
+  /* check for valid number of threads */
+  if (nthreads < 1)  return SUNMAT_ILL_INPUT;
+
+  SM_NTHREADS_S(A) = nthreads;
+
+  return SUNMAT_SUCCESS;
+}
+
+
+/* ----------------------------------------------------------------------------
+ * Function to partition the columns of a sparse matrix into groups (colors)
+ * of columns that have no nonzero in a common row, e.g. for computing a
+ * difference quotient Jacobian with one function evaluation per group
+ * (Curtis-Powell-Reid). The columns are colored greedily in their natural
+ * order. On return, the columns of color g are colorcols[colorptrs[g]] to
+ * colorcols[colorptrs[g+1]-1]. colorptrs must have room for N+1 entries and
+ * colorcols for N entries, where N is the number of columns.
+ */
+
+int SUNSparseMatrix_ColumnColoring(SUNMatrix A, sunindextype *ncolors,
+                                   sunindextype *colorptrs,
+                                   sunindextype *colorcols)
+{
+  sunindextype i, j, k, p, q, c, M, N, nc;
+  sunindextype *cp, *ci, *rp, *rj, *Tp, *Ti, *color, *mark;
+
+  /* check for valid input */
+  if (SUNMatGetID(A) != SUNMATRIX_SPARSE)  return SUNMAT_ILL_INPUT;
+  if ((ncolors == NULL) || (colorptrs == NULL) || (colorcols == NULL))
+    return SUNMAT_ILL_INPUT;
+
+  M = SM_ROWS_S(A);
+  N = SM_COLUMNS_S(A);
+
+  /* access the columns and rows of the pattern (one of them is the
+     transposed pattern) */
+  Tp = Ti = NULL;
+  if (SM_SPARSETYPE_S(A) == CSC_MAT) {
+    cp = SM_INDEXPTRS_S(A);
+    ci = SM_INDEXVALS_S(A);
+    if (transpose_pattern(N, M, cp, ci, &Tp, &Ti) != SUNMAT_SUCCESS)
+      return SUNMAT_MEM_FAIL;
+    rp = Tp;
+    rj = Ti;
+  } else {
+    rp = SM_INDEXPTRS_S(A);
+    rj = SM_INDEXVALS_S(A);
+    if (transpose_pattern(M, N, rp, rj, &Tp, &Ti) != SUNMAT_SUCCESS)
+      return SUNMAT_MEM_FAIL;
+    cp = Tp;
+    ci = Ti;
+  }
+
+  /* color[j] is the color of column j, mark[c] == j if color c is used
+     by a column sharing a row with column j */
+  color = (sunindextype *) malloc(N * sizeof(sunindextype));
+  mark  = (sunindextype *) malloc((N+1) * sizeof(sunindextype));
+  if ((color == NULL) || (mark == NULL)) {
+    if (color) free(color);
+    if (mark)  free(mark);
+    free(Tp);  free(Ti);
+    return SUNMAT_MEM_FAIL;
+  }
+  for (j=0; j<N; j++) {
+    color[j] = -1;
+    mark[j]  = -1;
+  }
+  mark[N] = -1;
+
+  /* give each column the smallest color not used by its neighbors */
+  nc = 0;
+  for (j=0; j<N; j++) {
+    for (p=cp[j]; p<cp[j+1]; p++) {
+      i = ci[p];
+      for (q=rp[i]; q<rp[i+1]; q++) {
+        k = rj[q];
+        if (color[k] >= 0)  mark[color[k]] = j;
+      }
+    }
+    for (c=0; mark[c] == j; c++);
+    color[j] = c;
+    if (c >= nc)  nc = c+1;
+  }
+
+  /* group the columns by color */
+  for (c=0; c<=nc; c++)
+    colorptrs[c] = 0;
+  for (j=0; j<N; j++)
+    colorptrs[color[j]+1]++;
+  for (c=0; c<nc; c++) {
+    colorptrs[c+1] += colorptrs[c];
+    mark[c] = colorptrs[c];
+  }
+  for (j=0; j<N; j++)
+    colorcols[mark[color[j]]++] = j;
+
+  *ncolors = nc;
+
+  free(color);
+  free(mark);
+  free(Tp);
+  free(Ti);
+
+  return SUNMAT_SUCCESS;
+}
+
+
 /* ----------------------------------------------------------------------------
  * Function to print the sparse matrix
  */
@@ -474,6 +635,7 @@ SUNMatrix SUNMatClone_Sparse(SUNMatrix A)
 {
   SUNMatrix B = SUNSparseMatrix(SM_ROWS_S(A), SM_COLUMNS_S(A),
                                 SM_NNZ_S(A), SM_SPARSETYPE_S(A));
+  if (B != NULL) SM_NTHREADS_S(B) = SM_NTHREADS_S(A);
   return(B);
 }
 
@@ -502,6 +664,13 @@ void SUNMatDestroy_Sparse(SUNMatrix A)
       SM_CONTENT_S(A)->colptrs = NULL;
       SM_CONTENT_S(A)->rowptrs = NULL;
     }
+    /* free cached pattern and work arrays */
+    if (SM_CONTENT_S(A)->work) {
+      free_merge(SM_CONTENT_S(A)->work);
+      if (SM_CONTENT_S(A)->work->yw) free(SM_CONTENT_S(A)->work->yw);
+      free(SM_CONTENT_S(A)->work);
+      SM_CONTENT_S(A)->work = NULL;
+    }
     /* free content struct */
     free(A->content);
     A->content = NULL;
@@ -532,6 +701,8 @@ int SUNMatZero_Sparse(SUNMatrix A)
 int SUNMatCopy_Sparse(SUNMatrix A, SUNMatrix B)
 {
   sunindextype i, A_nz;
+  sunindextype *Ai, *Bi;
+  realtype *Ax, *Bx;
 
   /* Verify that A and B are compatible */
   if (!SMCompatible_Sparse(A, B))
@@ -547,22 +718,32 @@ int SUNMatCopy_Sparse(SUNMatrix A, SUNMatrix B)
     SM_DATA_S(B) = (realtype *) realloc(SM_DATA_S(B), A_nz*sizeof(realtype));
     SM_NNZ_S(B) = A_nz;
   }
+  if ((SM_INDEXVALS_S(B) == NULL) || (SM_DATA_S(B) == NULL))
+    return SUNMAT_MEM_FAIL;
 
-  /* zero out B so that copy works correctly */
-  if (SUNMatZero_Sparse(B) != SUNMAT_SUCCESS)
-    return SUNMAT_OPERATION_FAIL;
+  Ai = SM_INDEXVALS_S(A);
+  Ax = SM_DATA_S(A);
+  Bi = SM_INDEXVALS_S(B);
+  Bx = SM_DATA_S(B);
 
-  /* copy the data and row indices over */
-  for (i=0; i<A_nz; i++){
-    (SM_DATA_S(B))[i] = (SM_DATA_S(A))[i];
-    (SM_INDEXVALS_S(B))[i] = (SM_INDEXVALS_S(A))[i];
+  /* copy the data and row indices over, and zero out the rest of B */
+#ifdef _OPENMP
+#pragma omp parallel for default(shared) private(i) schedule(static) \
+  num_threads(SM_NTHREADS_S(B)) if(SM_NTHREADS_S(B) > 1)
+#endif
+  for (i=0; i<SM_NNZ_S(B); i++) {
+    if (i < A_nz) {
+      Bx[i] = Ax[i];
+      Bi[i] = Ai[i];
+    } else {
+      Bx[i] = ZERO;
+      Bi[i] = 0;
+    }
   }
 
   /* copy the column pointers over */
-  for (i=0; i<SM_NP_S(A); i++) {
-    (SM_INDEXPTRS_S(B))[i] = (SM_INDEXPTRS_S(A))[i];
-  }
-  (SM_INDEXPTRS_S(B))[SM_NP_S(A)] = A_nz;
+  memcpy(SM_INDEXPTRS_S(B), SM_INDEXPTRS_S(A),
+         (SM_NP_S(A)+1)*sizeof(sunindextype));
 
   return SUNMAT_SUCCESS;
 }
@@ -595,6 +776,11 @@ int SUNMatScaleAddI_Sparse(realtype c, SUNMatrix A)
   if (SM_DATA_S(A))       Ax = SM_DATA_S(A);
   else  return (SUNMAT_MEM_FAIL);
 
+  /* reuse the merged pattern of A and I from an earlier call when possible;
+     the code below is only used if the pattern cannot be allocated */
+  if (ScaleAdd_Merged(c, A, NULL) == SUNMAT_SUCCESS)
+    return SUNMAT_SUCCESS;
+
 
   /* determine if A: contains values on the diagonal (so I can just be added in);
      if not, then increment counter for extra storage that should be required. */
@@ -817,6 +1003,11 @@ int SUNMatScaleAdd_Sparse(realtype c, SUNMatrix A, SUNMatrix B)
   if (SM_DATA_S(B))       Bx = SM_DATA_S(B);
   else  return(SUNMAT_MEM_FAIL);
 
+  /* reuse the merged pattern of A and B from an earlier call when possible;
+     the code below is only used if the pattern cannot be allocated */
+  if (ScaleAdd_Merged(c, A, B) == SUNMAT_SUCCESS)
+    return SUNMAT_SUCCESS;
+
   /* create work arrays for row indices and nonzero column values */
   w = (sunindextype *) malloc(M * sizeof(sunindextype));
   x = (realtype *) malloc(M * sizeof(realtype));
@@ -1102,6 +1293,13 @@ int Matvec_SparseCSC(SUNMatrix A, N_Vector x, N_Vector y)
   if ((xd == NULL) || (yd == NULL) || (xd == yd) )
     return SUNMAT_MEM_FAIL;
 
+#ifdef _OPENMP
+  /* with several threads, each thread accumulates the products of its
+     columns in its own copy of y, and the copies are summed at the end */
+  if (SM_NTHREADS_S(A) > 1)
+    return Matvec_SparseCSC_OMP(A, xd, yd);
+#endif
+
   /* initialize result */
   for (i=0; i<SM_ROWS_S(A); i++)
     yd[i] = 0.0;
@@ -1119,6 +1317,71 @@ int Matvec_SparseCSC(SUNMatrix A, N_Vector x, N_Vector y)
 }
 
 
+#ifdef _OPENMP
+/* -----------------------------------------------------------------
+ * Threaded version of Matvec_SparseCSC, using SM_NTHREADS_S(A)
+ * per-thread copies of y stored in the work arrays of A.
+ */
+static int Matvec_SparseCSC_OMP(SUNMatrix A, realtype *xd, realtype *yd)
+{
+  sunindextype i, j, p, M, ylen;
+  sunindextype *Ap, *Ai;
+  realtype *Ax, *yw, *yt, sum;
+  SUNMatrixWork_Sparse work;
+  int t, nthr;
+
+  M  = SM_ROWS_S(A);
+  Ap = SM_INDEXPTRS_S(A);
+  Ai = SM_INDEXVALS_S(A);
+  Ax = SM_DATA_S(A);
+
+  /* make sure there is a copy of y for every thread */
+  if (SM_CONTENT_S(A)->work == NULL) {
+    SM_CONTENT_S(A)->work = (SUNMatrixWork_Sparse) calloc(1, sizeof *work);
+    if (SM_CONTENT_S(A)->work == NULL) return SUNMAT_MEM_FAIL;
+  }
+  work = SM_CONTENT_S(A)->work;
+  ylen = SM_NTHREADS_S(A) * M;
+  if (work->ylen < ylen) {
+    yw = (realtype *) realloc(work->yw, ylen*sizeof(realtype));
+    if (yw == NULL) return SUNMAT_MEM_FAIL;
+    work->yw   = yw;
+    work->ylen = ylen;
+  }
+  yw = work->yw;
+
+#pragma omp parallel default(shared) private(i, j, p, t, nthr, yt, sum) \
+  num_threads(SM_NTHREADS_S(A))
+  {
+    t    = omp_get_thread_num();
+    nthr = omp_get_num_threads();
+    yt   = yw + t*M;
+
+    /* clear the copy of this thread */
+    for (i=0; i<M; i++)
+      yt[i] = ZERO;
+
+    /* iterate through the matrix columns of this thread */
+#pragma omp for schedule(static)
+    for (j=0; j<SM_COLUMNS_S(A); j++)
+      for (p=Ap[j]; p<Ap[j+1]; p++)
+        yt[Ai[p]] += Ax[p]*xd[j];
+
+    /* sum the copies */
+#pragma omp for schedule(static)
+    for (i=0; i<M; i++) {
+      sum = ZERO;
+      for (t=0; t<nthr; t++)
+        sum += yw[t*M + i];
+      yd[i] = sum;
+    }
+  }
+
+  return SUNMAT_SUCCESS;
+}
+#endif
+
+
 /* -----------------------------------------------------------------
  * Computes y=A*x, where A is a CSR SUNMatrix_Sparse of dimension MxN, x is a
  * compatible N_Vector object of length N, and y is a compatible
@@ -1130,7 +1393,7 @@ int Matvec_SparseCSR(SUNMatrix A, N_Vector x, N_Vector y)
 {
   sunindextype i, j;
   sunindextype *Ap, *Aj;
-  realtype *Ax, *xd, *yd;
+  realtype *Ax, *xd, *yd, sum;
 
   /* access data from CSR structure (return if failure) */
   Ap = SM_INDEXPTRS_S(A);
@@ -1145,16 +1408,19 @@ int Matvec_SparseCSR(SUNMatrix A, N_Vector x, N_Vector y)
   if ((xd == NULL) || (yd == NULL) || (xd == yd))
     return SUNMAT_MEM_FAIL;
 
-  /* initialize result */
-  for (i=0; i<SM_ROWS_S(A); i++)
-    yd[i] = 0.0;
-
-  /* iterate through matrix rows */
+  /* iterate through matrix rows (the rows are independent, so they are
+     divided between the threads) */
+#ifdef _OPENMP
+#pragma omp parallel for default(shared) private(i, j, sum) schedule(static) \
+  num_threads(SM_NTHREADS_S(A)) if(SM_NTHREADS_S(A) > 1)
+#endif
   for (i=0; i<SM_ROWS_S(A); i++) {
 
     /* iterate along row of A, performing product */
+    sum = ZERO;
     for (j=Ap[i]; j<Ap[i+1]; j++)
-      yd[i] += Ax[j]*xd[Aj[j]];
+      sum += Ax[j]*xd[Aj[j]];
+    yd[i] = sum;
 
   }
 
@@ -1230,4 +1496,394 @@ int format_convert(const SUNMatrix A, SUNMatrix B)
     }
 
     return 0;
-}
\ No newline at end of file
+}
+
+/* -----------------------------------------------------------------
+ * Computes A = c*A + B, where B is NULL for the identity matrix,
+ * using the merged pattern of A and B cached in the work arrays of A.
+ *
+ * The merged pattern is recomputed only if the pattern of B or A has
+ * changed since it was computed. A may either have the merged pattern
+ * (the result of the last call, or any A containing B), in which case
+ * B is added in place, or the pattern A had when the merged pattern
+ * was computed (e.g. A was copied again from an unchanged Jacobian),
+ * in which case A and B are scattered into the merged pattern.
+ *
+ * Returns SUNMAT_MEM_FAIL, without changing the values of A, if the
+ * merged pattern cannot be allocated.
+ */
+static int ScaleAdd_Merged(realtype c, SUNMatrix A, SUNMatrix B)
+{
+  sunindextype j, k, p, M, N;
+  sunindextype *Ap, *Ai, *Bp, *Bi, *Cp, *Ci, *Amap, *Bmap, *vals;
+  realtype *Ax, *Bx, *Cx, *data;
+  SUNMatrixWork_Sparse work;
+  booleantype valid, inplace;
+  int retval;
+
+  /* store shortcuts to matrix dimensions (M is inner dimension, N is outer) */
+  if (SM_SPARSETYPE_S(A) == CSC_MAT) {
+    M = SM_ROWS_S(A);
+    N = SM_COLUMNS_S(A);
+  }
+  else {
+    M = SM_COLUMNS_S(A);
+    N = SM_ROWS_S(A);
+  }
+
+  Ap = SM_INDEXPTRS_S(A);
+  Ai = SM_INDEXVALS_S(A);
+  Ax = SM_DATA_S(A);
+  Bp = Bi = NULL;
+  Bx = NULL;
+  if (B != NULL) {
+    Bp = SM_INDEXPTRS_S(B);
+    Bi = SM_INDEXVALS_S(B);
+    Bx = SM_DATA_S(B);
+  }
+
+  /* A = c*A + A does not need a merged pattern */
+  if (B == A) {
+#ifdef _OPENMP
+#pragma omp parallel for default(shared) private(p) schedule(static) \
+  num_threads(SM_NTHREADS_S(A)) if(SM_NTHREADS_S(A) > 1)
+#endif
+    for (p=0; p<Ap[N]; p++)
+      Ax[p] = (c + ONE)*Ax[p];
+    return SUNMAT_SUCCESS;
+  }
+
+  /* create the work arrays of A */
+  if (SM_CONTENT_S(A)->work == NULL) {
+    SM_CONTENT_S(A)->work = (SUNMatrixWork_Sparse) calloc(1, sizeof *work);
+    if (SM_CONTENT_S(A)->work == NULL) return SUNMAT_MEM_FAIL;
+  }
+  work = SM_CONTENT_S(A)->work;
+
+  /* check whether the cached merged pattern can be used for A and B */
+  valid = (work->Cp != NULL) && (work->identity == (B == NULL));
+  if (valid && (B != NULL))
+    valid = same_pattern(N, work->Bnz, Bp, Bi, work->Bp, work->Bi);
+
+  if (valid && same_pattern(N, work->Cnz, Ap, Ai, work->Cp, work->Ci)) {
+    inplace = SUNTRUE;
+  } else if (valid && same_pattern(N, work->Anz, Ap, Ai, work->Ap, work->Ai)) {
+    inplace = SUNFALSE;
+  } else {
+    retval = merge_pattern(A, B);
+    if (retval != SUNMAT_SUCCESS) return retval;
+    inplace = (work->Ap == NULL);
+  }
+
+  Cp   = work->Cp;
+  Ci   = work->Ci;
+  Amap = work->Amap;
+  Bmap = work->Bmap;
+  Cx   = work->Cx;
+
+  /*   case 1: A has the merged pattern, so B is added in place */
+  if (inplace) {
+
+#ifdef _OPENMP
+#pragma omp parallel for default(shared) private(j, p) schedule(static) \
+  num_threads(SM_NTHREADS_S(A)) if(SM_NTHREADS_S(A) > 1)
+#endif
+    for (j=0; j<N; j++) {
+      for (p=Ap[j]; p<Ap[j+1]; p++)
+        Ax[p] *= c;
+      if (B == NULL) {
+        if (j < M)  Ax[Bmap[j]] += ONE;
+      } else {
+        for (p=Bp[j]; p<Bp[j+1]; p++)
+          Ax[Bmap[p]] += Bx[p];
+      }
+    }
+
+    return SUNMAT_SUCCESS;
+  }
+
+  /*   case 2: A and B are scattered into the merged pattern */
+
+  /* ensure that A has storage for the merged pattern */
+  if (SM_NNZ_S(A) < work->Cnz) {
+    vals = (sunindextype *) realloc(Ai, work->Cnz*sizeof(sunindextype));
+    if (vals == NULL) return SUNMAT_MEM_FAIL;
+    SM_INDEXVALS_S(A) = Ai = vals;
+    data = (realtype *) realloc(Ax, work->Cnz*sizeof(realtype));
+    if (data == NULL) return SUNMAT_MEM_FAIL;
+    SM_DATA_S(A) = Ax = data;
+    SM_NNZ_S(A) = work->Cnz;
+  }
+
+  /* compute the values of the sum in the merged pattern (the columns
+     (rows) of the merged pattern are disjoint, so they are divided
+     between the threads) */
+#ifdef _OPENMP
+#pragma omp parallel for default(shared) private(j, k, p) schedule(static) \
+  num_threads(SM_NTHREADS_S(A)) if(SM_NTHREADS_S(A) > 1)
+#endif
+  for (j=0; j<N; j++) {
+    for (k=Cp[j]; k<Cp[j+1]; k++)
+      Cx[k] = ZERO;
+    for (p=Ap[j]; p<Ap[j+1]; p++)
+      Cx[Amap[p]] = c*Ax[p];
+    if (B == NULL) {
+      if (j < M)  Cx[Bmap[j]] += ONE;
+    } else {
+      for (p=Bp[j]; p<Bp[j+1]; p++)
+        Cx[Bmap[p]] += Bx[p];
+    }
+  }
+
+  /* update A's structure with the merged pattern and values */
+  memcpy(Ax, Cx, work->Cnz*sizeof(realtype));
+  memcpy(Ai, Ci, work->Cnz*sizeof(sunindextype));
+  memcpy(Ap, Cp, (N+1)*sizeof(sunindextype));
+
+  return SUNMAT_SUCCESS;
+}
+
+
+/* -----------------------------------------------------------------
+ * Computes the merged pattern of A and B (B is NULL for the identity
+ * matrix) and the positions of the entries of A and B in it, and
+ * stores them in the work arrays of A. Columns (rows) of A which do
+ * not gain entries keep their order; the others are sorted.
+ *
+ * Returns SUNMAT_SUCCESS, or SUNMAT_MEM_FAIL if allocation failed.
+ */
+static int merge_pattern(SUNMatrix A, SUNMatrix B)
+{
+  sunindextype j, k, p, M, N, nz, Anz, Bnz, start, nA;
+  sunindextype *Ap, *Ai, *Bp, *Bi, *Cp, *Ci, *Amap, *Bmap, *mark, *pos;
+  SUNMatrixWork_Sparse work;
+
+  /* store shortcuts to matrix dimensions (M is inner dimension, N is outer) */
+  if (SM_SPARSETYPE_S(A) == CSC_MAT) {
+    M = SM_ROWS_S(A);
+    N = SM_COLUMNS_S(A);
+  }
+  else {
+    M = SM_COLUMNS_S(A);
+    N = SM_ROWS_S(A);
+  }
+
+  Ap = SM_INDEXPTRS_S(A);
+  Ai = SM_INDEXVALS_S(A);
+  Bp = Bi = NULL;
+  if (B != NULL) {
+    Bp = SM_INDEXPTRS_S(B);
+    Bi = SM_INDEXVALS_S(B);
+  }
+  Anz = Ap[N];
+  Bnz = (B == NULL) ? SUNMIN(M,N) : Bp[N];
+
+  /* drop the previous merged pattern */
+  work = SM_CONTENT_S(A)->work;
+  free_merge(work);
+
+  /* allocate the merged pattern, the maps and temporary arrays (one
+     extra entry each avoids zero-length allocations) */
+  mark = (sunindextype *) malloc(M * sizeof(sunindextype));
+  pos  = (sunindextype *) malloc(M * sizeof(sunindextype));
+  Cp   = (sunindextype *) malloc((N+1) * sizeof(sunindextype));
+  Ci   = (sunindextype *) malloc((Anz+Bnz+1) * sizeof(sunindextype));
+  Amap = (sunindextype *) malloc((Anz+1) * sizeof(sunindextype));
+  Bmap = (sunindextype *) malloc((Bnz+1) * sizeof(sunindextype));
+  if ((mark == NULL) || (pos == NULL) || (Cp == NULL) || (Ci == NULL) ||
+      (Amap == NULL) || (Bmap == NULL)) {
+    if (mark) free(mark);
+    if (pos)  free(pos);
+    if (Cp)   free(Cp);
+    if (Ci)   free(Ci);
+    if (Amap) free(Amap);
+    if (Bmap) free(Bmap);
+    return SUNMAT_MEM_FAIL;
+  }
+
+  /* mark[i] == j if row (column) i is in column (row) j of the sum */
+  for (k=0; k<M; k++)
+    mark[k] = -1;
+
+  /* iterate through columns (rows) */
+  nz = 0;
+  for (j=0; j<N; j++) {
+
+    start = Cp[j] = nz;
+
+    /* collect the entries of A */
+    for (p=Ap[j]; p<Ap[j+1]; p++) {
+      Ci[nz++] = Ai[p];
+      mark[Ai[p]] = j;
+    }
+    nA = nz - start;
+
+    /* add the entries of B that are not in A */
+    if (B == NULL) {
+      if ((j < M) && (mark[j] != j)) {
+        mark[j] = j;
+        Ci[nz++] = j;
+      }
+    } else {
+      for (p=Bp[j]; p<Bp[j+1]; p++) {
+        if (mark[Bi[p]] != j) {
+          mark[Bi[p]] = j;
+          Ci[nz++] = Bi[p];
+        }
+      }
+    }
+
+    /* sort the column (row) if entries were added */
+    if (nz - start > nA)
+      qsort(Ci + start, nz - start, sizeof(sunindextype), compare_index);
+
+    /* store the positions of the entries of A and B */
+    for (k=start; k<nz; k++)
+      pos[Ci[k]] = k;
+    for (p=Ap[j]; p<Ap[j+1]; p++)
+      Amap[p] = pos[Ai[p]];
+    if (B == NULL) {
+      if (j < M)  Bmap[j] = pos[j];
+    } else {
+      for (p=Bp[j]; p<Bp[j+1]; p++)
+        Bmap[p] = pos[Bi[p]];
+    }
+  }
+  Cp[N] = nz;
+
+  free(mark);
+  free(pos);
+
+  work->identity = (B == NULL);
+  work->Anz  = Anz;
+  work->Bnz  = Bnz;
+  work->Cnz  = nz;
+  work->Cp   = Cp;
+  work->Ci   = Ci;
+  work->Bmap = Bmap;
+
+  /* keep a copy of the pattern of B */
+  if (B != NULL) {
+    work->Bp = (sunindextype *) malloc((N+1) * sizeof(sunindextype));
+    work->Bi = (sunindextype *) malloc((Bnz+1) * sizeof(sunindextype));
+    if ((work->Bp == NULL) || (work->Bi == NULL)) {
+      free(Amap);
+      free_merge(work);
+      return SUNMAT_MEM_FAIL;
+    }
+    memcpy(work->Bp, Bp, (N+1) * sizeof(sunindextype));
+    memcpy(work->Bi, Bi, Bnz * sizeof(sunindextype));
+  }
+
+  /* if A already contains B, the merged pattern is the pattern of A */
+  if (nz == Anz) {
+    free(Amap);
+    return SUNMAT_SUCCESS;
+  }
+
+  /* otherwise keep a copy of the pattern of A, the positions of its
+     entries, and storage for the values of the sum */
+  work->Amap = Amap;
+  work->Ap = (sunindextype *) malloc((N+1) * sizeof(sunindextype));
+  work->Ai = (sunindextype *) malloc((Anz+1) * sizeof(sunindextype));
+  work->Cx = (realtype *) malloc(nz * sizeof(realtype));
+  if ((work->Ap == NULL) || (work->Ai == NULL) || (work->Cx == NULL)) {
+    free_merge(work);
+    return SUNMAT_MEM_FAIL;
+  }
+  memcpy(work->Ap, Ap, (N+1) * sizeof(sunindextype));
+  memcpy(work->Ai, Ai, Anz * sizeof(sunindextype));
+
+  return SUNMAT_SUCCESS;
+}
+
+
+/* -----------------------------------------------------------------
+ * Frees the merged pattern stored in the work arrays of a matrix.
+ */
+static void free_merge(SUNMatrixWork_Sparse work)
+{
+  if (work->Ap)   { free(work->Ap);   work->Ap   = NULL; }
+  if (work->Ai)   { free(work->Ai);   work->Ai   = NULL; }
+  if (work->Bp)   { free(work->Bp);   work->Bp   = NULL; }
+  if (work->Bi)   { free(work->Bi);   work->Bi   = NULL; }
+  if (work->Cp)   { free(work->Cp);   work->Cp   = NULL; }
+  if (work->Ci)   { free(work->Ci);   work->Ci   = NULL; }
+  if (work->Amap) { free(work->Amap); work->Amap = NULL; }
+  if (work->Bmap) { free(work->Bmap); work->Bmap = NULL; }
+  if (work->Cx)   { free(work->Cx);   work->Cx   = NULL; }
+  work->Anz = work->Bnz = work->Cnz = 0;
+}
+
+
+/* -----------------------------------------------------------------
+ * Checks whether the pattern (Ap, Ai) with NP columns (rows) equals
+ * the cached pattern (Cp, Ci) with nz nonzeros.
+ */
+static booleantype same_pattern(sunindextype NP, sunindextype nz,
+                                sunindextype *Ap, sunindextype *Ai,
+                                sunindextype *Cp, sunindextype *Ci)
+{
+  if ((Cp == NULL) || (Ap[NP] != nz))
+    return SUNFALSE;
+  if (memcmp(Ap, Cp, (NP+1) * sizeof(sunindextype)) != 0)
+    return SUNFALSE;
+  if ((nz > 0) && (memcmp(Ai, Ci, nz * sizeof(sunindextype)) != 0))
+    return SUNFALSE;
+  return SUNTRUE;
+}
+
+
+/* -----------------------------------------------------------------
+ * Comparison function for sorting indices with qsort.
+ */
+static int compare_index(const void *a, const void *b)
+{
+  sunindextype ia = *((const sunindextype *) a);
+  sunindextype ib = *((const sunindextype *) b);
+  return (ia > ib) - (ia < ib);
+}
+
+
+/* -----------------------------------------------------------------
+ * Computes the transpose (Tp, Ti) of the pattern (Ap, Ai) with np
+ * columns (rows) and nq rows (columns). The arrays are allocated here.
+ *
+ * Returns SUNMAT_SUCCESS, or SUNMAT_MEM_FAIL if allocation failed.
+ */
+static int transpose_pattern(sunindextype np, sunindextype nq,
+                             sunindextype *Ap, sunindextype *Ai,
+                             sunindextype **Tp, sunindextype **Ti)
+{
+  sunindextype j, p, nz;
+  sunindextype *next;
+
+  nz  = Ap[np];
+  *Tp = (sunindextype *) calloc(nq+1, sizeof(sunindextype));
+  *Ti = (sunindextype *) malloc((nz+1) * sizeof(sunindextype));
+  next = (sunindextype *) malloc((nq+1) * sizeof(sunindextype));
+  if ((*Tp == NULL) || (*Ti == NULL) || (next == NULL)) {
+    if (*Tp)  free(*Tp);
+    if (*Ti)  free(*Ti);
+    if (next) free(next);
+    *Tp = *Ti = NULL;
+    return SUNMAT_MEM_FAIL;
+  }
+
+  /* count the entries of each transposed column (row) */
+  for (p=0; p<nz; p++)
+    (*Tp)[Ai[p]+1]++;
+  for (j=0; j<nq; j++)
+    (*Tp)[j+1] += (*Tp)[j];
+
+  /* fill in the indices */
+  for (j=0; j<nq; j++)
+    next[j] = (*Tp)[j];
+  for (j=0; j<np; j++)
+    for (p=Ap[j]; p<Ap[j+1]; p++)
+      (*Ti)[next[Ai[p]]++] = j;
+
+  free(next);
+
+  return SUNMAT_SUCCESS;
+}
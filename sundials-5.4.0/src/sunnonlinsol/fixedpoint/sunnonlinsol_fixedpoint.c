@@ -28,6 +28,9 @@
 /* Internal utility routines */
 static int AndersonAccelerate(SUNNonlinearSolver NLS, N_Vector gval, N_Vector x,
                               N_Vector xold, int iter);
+static void QRDeleteFirst(SUNNonlinearSolver NLS, N_Vector vtemp, realtype *qtf);
+static int QRAddClassical(SUNNonlinearSolver NLS, N_Vector fv, N_Vector vtemp,
+                          int i_pt, int iter, int *lAA);
 
 static int AllocateContent(SUNNonlinearSolver NLS, N_Vector tmpl);
 static void FreeContent(SUNNonlinearSolver NLS);
@@ -39,6 +42,9 @@ static void FreeContent(SUNNonlinearSolver NLS);
 #define ONE  RCONST(1.0)
 #define ZERO RCONST(0.0)
 
+/* reorthogonalize if the norm of a new column drops by more than this */
+#define FACTOR RCONST(1000.0)
+
 /*==============================================================================
   Constructor to create a new fixed point solver
   ============================================================================*/
@@ -94,6 +100,9 @@ SUNNonlinearSolver SUNNonlinSol_FixedPoint(N_Vector y, int m)
   content->m           = m;
   content->damping     = SUNFALSE;
   content->beta        = ONE;
+  content->gstype      = MODIFIED_GS;
+  content->restart     = 0;
+  content->aa_start    = 0;
   content->curiter     = 0;
   content->maxiters    = 3;
   content->niters      = 0;
@@ -383,6 +392,35 @@ int SUNNonlinSolSetDamping_FixedPoint(SUNNonlinearSolver NLS, realtype beta)
 }
 
 
+int SUNNonlinSolSetGSType_FixedPoint(SUNNonlinearSolver NLS, int gstype)
+{
+  /* check that the nonlinear solver is non-null */
+  if (NLS == NULL)
+    return(SUN_NLS_MEM_NULL);
+
+  /* check that gstype is valid */
+  if ((gstype != MODIFIED_GS) && (gstype != CLASSICAL_GS))
+    return(SUN_NLS_ILL_INPUT);
+
+  FP_CONTENT(NLS)->gstype = gstype;
+  return(SUN_NLS_SUCCESS);
+}
+
+int SUNNonlinSolSetRestart_FixedPoint(SUNNonlinearSolver NLS, int restart)
+{
+  /* check that the nonlinear solver is non-null */
+  if (NLS == NULL)
+    return(SUN_NLS_MEM_NULL);
+
+  /* check that restart is valid (0 disables restarts) */
+  if (restart < 0)
+    return(SUN_NLS_ILL_INPUT);
+
+  FP_CONTENT(NLS)->restart = restart;
+  return(SUN_NLS_SUCCESS);
+}
+
+
 /*==============================================================================
   Get functions
   ============================================================================*/
@@ -448,6 +486,11 @@ int SUNNonlinSolGetSysFn_FixedPoint(SUNNonlinearSolver NLS, SUNNonlinSolSysFn *S
 
   The result of the routine is held in x.
 
+  If a restart interval was set, the acceleration history is
+  cleared after that many accelerated iterations. With
+  gstype = CLASSICAL_GS the QR factorization is updated by
+  QRAddClassical instead of modified Gram-Schmidt.
+
   Possible return values:
     SUN_NLS_MEM_NULL --> a required item was missing from memory
     SUN_NLS_SUCCESS  --> successful completion
@@ -456,8 +499,8 @@ static int AndersonAccelerate(SUNNonlinearSolver NLS, N_Vector gval,
                               N_Vector x, N_Vector xold, int iter)
 {
   /* local variables */
-  int         nvec, retval, i_pt, i, j, lAA, maa, *ipt_map;
-  realtype    a, b, rtemp, c, s, beta, onembeta, *cvals, *R, *gamma;
+  int         nvec, retval, i_pt, i, j, lAA = 0, maa, *ipt_map;
+  realtype    beta, onembeta, *cvals, *R, *gamma;
   N_Vector    fv, vtemp, gold, fold, *df, *dg, *Q, *Xvecs;
   booleantype damping;
 
@@ -478,6 +521,16 @@ static int AndersonAccelerate(SUNNonlinearSolver NLS, N_Vector gval,
   damping = FP_CONTENT(NLS)->damping;
   beta    = FP_CONTENT(NLS)->beta;
 
+  /* restart the acceleration history if requested, iter is then counted
+     from the start of the current history */
+  if (iter == 0) {
+    FP_CONTENT(NLS)->aa_start = 0;
+  } else if ( (FP_CONTENT(NLS)->restart > 0) &&
+              (iter - FP_CONTENT(NLS)->aa_start > FP_CONTENT(NLS)->restart) ) {
+    FP_CONTENT(NLS)->aa_start = iter-1;
+  }
+  iter -= FP_CONTENT(NLS)->aa_start;
+
   /* reset ipt_map, i_pt */
   for (i = 0; i < maa; i++)  ipt_map[i]=0;
   i_pt = iter-1 - ((iter-1)/maa)*maa;
@@ -499,7 +552,18 @@ static int AndersonAccelerate(SUNNonlinearSolver NLS, N_Vector gval,
 
   /* update data structures based on current iteration index */
 
-  if (iter == 1) {   /* second iteration */
+  if (FP_CONTENT(NLS)->gstype == CLASSICAL_GS) {
+
+    retval = QRAddClassical(NLS, fv, vtemp, i_pt, iter, &lAA);
+    if (retval != SUN_NLS_SUCCESS)  return(retval);
+
+    /* no acceleration if the difference was zero */
+    if (lAA == 0) {
+      N_VScale(ONE, gval, x);
+      return(SUN_NLS_SUCCESS);
+    }
+
+  } else if (iter == 1) {   /* second iteration */
 
     R[0] = SUNRsqrt( N_VDotProd(df[i_pt], df[i_pt]) );
     N_VScale(ONE/R[0], df[i_pt], Q[i_pt]);
@@ -524,32 +588,7 @@ static int AndersonAccelerate(SUNNonlinearSolver NLS, N_Vector gval,
   } else {   /* we've filled the acceleration subspace, so start recycling */
 
     /* delete left-most column vector from QR factorization */
-    for (i = 0; i < maa-1; i++) {
-      a = R[(i+1)*maa + i];
-      b = R[(i+1)*maa + i+1];
-      rtemp = SUNRsqrt(a*a + b*b);
-      c = a / rtemp;
-      s = b / rtemp;
-      R[(i+1)*maa + i] = rtemp;
-      R[(i+1)*maa + i+1] = ZERO;
-      if (i < maa-1) {
-        for (j = i+2; j < maa; j++) {
-          a = R[j*maa + i];
-          b = R[j*maa + i+1];
-          rtemp = c * a + s * b;
-          R[j*maa + i+1] = -s*a + c*b;
-          R[j*maa + i] = rtemp;
-        }
-      }
-      N_VLinearSum(c, Q[i], s, Q[i+1], vtemp);
-      N_VLinearSum(-s, Q[i], c, Q[i+1], Q[i+1]);
-      N_VScale(ONE, vtemp, Q[i]);
-    }
-
-    /* ahift R to the left by one */
-    for (i = 1; i < maa; i++)
-      for (j = 0; j < maa-1; j++)
-        R[(i-1)*maa + j] = R[i*maa + j];
+    QRDeleteFirst(NLS, vtemp, NULL);
 
     /* add the new df vector */
     N_VScale(ONE, df[i_pt], vtemp);
@@ -569,10 +608,12 @@ static int AndersonAccelerate(SUNNonlinearSolver NLS, N_Vector gval,
   }
 
   /* solve least squares problem and update solution */
-  lAA = iter;
-  if (maa < iter)  lAA = maa;
-  retval = N_VDotProdMulti(lAA, fv, Q, gamma);
-  if (retval != 0)  return(SUN_NLS_VECTOROP_ERR);
+  if (FP_CONTENT(NLS)->gstype != CLASSICAL_GS) {
+    lAA = iter;
+    if (maa < iter)  lAA = maa;
+    retval = N_VDotProdMulti(lAA, fv, Q, gamma);
+    if (retval != 0)  return(SUN_NLS_VECTOROP_ERR);
+  }
 
   /* set arrays for fused vector operation */
   cvals[0] = ONE;
@@ -611,6 +652,220 @@ static int AndersonAccelerate(SUNNonlinearSolver NLS, N_Vector gval,
   return(SUN_NLS_SUCCESS);
 }
 
+/*---------------------------------------------------------------
+  QRDeleteFirst
+
+  This routine deletes the left-most column of the QR
+  factorization by Givens rotations, and shifts R to the left by
+  one. The last column of Q is then free for the new df vector.
+  If qtf is not NULL, the rotations are also applied to it.
+  -------------------------------------------------------------*/
+static void QRDeleteFirst(SUNNonlinearSolver NLS, N_Vector vtemp, realtype *qtf)
+{
+  /* local variables */
+  int       i, j, maa;
+  realtype  a, b, rtemp, c, s, *R;
+  N_Vector *Q;
+
+  /* local shortcut variables */
+  maa = FP_CONTENT(NLS)->m;
+  Q   = FP_CONTENT(NLS)->q;
+  R   = FP_CONTENT(NLS)->R;
+
+  for (i = 0; i < maa-1; i++) {
+    a = R[(i+1)*maa + i];
+    b = R[(i+1)*maa + i+1];
+    rtemp = SUNRsqrt(a*a + b*b);
+    c = a / rtemp;
+    s = b / rtemp;
+    R[(i+1)*maa + i] = rtemp;
+    R[(i+1)*maa + i+1] = ZERO;
+    if (i < maa-1) {
+      for (j = i+2; j < maa; j++) {
+        a = R[j*maa + i];
+        b = R[j*maa + i+1];
+        rtemp = c * a + s * b;
+        R[j*maa + i+1] = -s*a + c*b;
+        R[j*maa + i] = rtemp;
+      }
+    }
+    N_VLinearSum(c, Q[i], s, Q[i+1], vtemp);
+    N_VLinearSum(-s, Q[i], c, Q[i+1], Q[i+1]);
+    N_VScale(ONE, vtemp, Q[i]);
+    if (qtf != NULL) {
+      rtemp = c * qtf[i] + s * qtf[i+1];
+      qtf[i+1] = -s * qtf[i] + c * qtf[i+1];
+      qtf[i] = rtemp;
+    }
+  }
+
+  /* ahift R to the left by one */
+  for (i = 1; i < maa; i++)
+    for (j = 0; j < maa-1; j++)
+      R[(i-1)*maa + j] = R[i*maa + j];
+}
+
+/*---------------------------------------------------------------
+  QRAddClassical
+
+  This routine adds the newest df vector to the QR factorization
+  with classical Gram-Schmidt, and sets gamma = Q^T fv for the
+  least squares problem. It sets lAA to the number of columns.
+
+  All inner products come from a single N_VDotProdMulti call,
+  i.e. one reduction per iteration for a parallel vector:
+    - Q^T df, df^T df and df^T fv are computed together,
+    - the norm of the new column is (df^T df - |Q^T df|^2)^(1/2),
+    - Q^T fv is Q^T fold, kept from the previous iteration in qtf,
+      plus Q^T df.
+  If the norm of the new column is much smaller than that of df,
+  a second pass reorthogonalizes it (one more reduction).
+
+  If df is (nearly) in the span of the previous columns, the
+  acceleration history is restarted with df alone. If df is zero,
+  lAA is set to 0 and the history is restarted in the next
+  iteration.
+
+  Possible return values:
+    SUN_NLS_VECTOROP_ERR --> a vector operation failed
+    SUN_NLS_SUCCESS      --> successful completion
+  -------------------------------------------------------------*/
+static int QRAddClassical(SUNNonlinearSolver NLS, N_Vector fv, N_Vector vtemp,
+                          int i_pt, int iter, int *lAA)
+{
+  /* local variables */
+  int          i, j, k, maa, retval, *ipt_map;
+  realtype     dfdf, dffv, rkk2, rkk, *R, *r, *gamma, *qtf, *dots, *cvals;
+  N_Vector     v, *df, *dg, *Q, *Xvecs;
+  booleantype  restart;
+
+  /* local shortcut variables */
+  maa     = FP_CONTENT(NLS)->m;
+  ipt_map = FP_CONTENT(NLS)->imap;
+  df      = FP_CONTENT(NLS)->df;
+  dg      = FP_CONTENT(NLS)->dg;
+  Q       = FP_CONTENT(NLS)->q;
+  R       = FP_CONTENT(NLS)->R;
+  gamma   = FP_CONTENT(NLS)->gamma;
+  qtf     = FP_CONTENT(NLS)->qtf;
+  Xvecs   = FP_CONTENT(NLS)->Xvecs;
+  dots    = FP_CONTENT(NLS)->cvals;          /* first m+1 values  */
+  cvals   = FP_CONTENT(NLS)->cvals + maa+1;  /* last m+1 values   */
+
+  /* make room for the new column and update the iteration map */
+  if (iter > maa) {
+    QRDeleteFirst(NLS, vtemp, qtf);
+    k = maa-1;
+    j = 0;
+    for (i = i_pt+1; i < maa; i++)
+      ipt_map[j++] = i;
+    for (i = 0; i < i_pt+1; i++)
+      ipt_map[j++] = i;
+  } else {
+    k = iter-1;
+    for (j = 0; j <= k; j++)
+      ipt_map[j] = j;
+  }
+  r = R + k*maa;
+  v = Q[k];
+
+  /* compute Q^T df, df^T df and df^T fv at once */
+  for (j = 0; j < k; j++)
+    Xvecs[j] = Q[j];
+  Xvecs[k]   = df[i_pt];
+  Xvecs[k+1] = fv;
+  retval = N_VDotProdMulti(k+2, df[i_pt], Xvecs, dots);
+  if (retval != 0)  return(SUN_NLS_VECTOROP_ERR);
+
+  dfdf = dots[k];
+  dffv = dots[k+1];
+  rkk2 = dfdf;
+  for (j = 0; j < k; j++) {
+    r[j]  = dots[j];
+    rkk2 -= r[j]*r[j];
+  }
+
+  /* the norm above is only accurate to roundoff in df^T df */
+  restart = (k > 0) && (rkk2 <= UNIT_ROUNDOFF*dfdf);
+
+  if (!restart && k > 0) {
+
+    /* v = df - Q r */
+    cvals[0] = ONE;
+    Xvecs[0] = df[i_pt];
+    for (j = 0; j < k; j++) {
+      cvals[j+1] = -r[j];
+      Xvecs[j+1] = Q[j];
+    }
+    retval = N_VLinearCombination(k+1, cvals, Xvecs, v);
+    if (retval != 0)  return(SUN_NLS_VECTOROP_ERR);
+
+    /* reorthogonalize if necessary */
+    if (FACTOR*FACTOR*rkk2 < dfdf) {
+      for (j = 0; j < k; j++)
+        Xvecs[j] = Q[j];
+      Xvecs[k] = v;
+      retval = N_VDotProdMulti(k+1, v, Xvecs, dots);
+      if (retval != 0)  return(SUN_NLS_VECTOROP_ERR);
+
+      rkk2 = dots[k];
+      cvals[0] = ONE;
+      Xvecs[0] = v;
+      for (j = 0; j < k; j++) {
+        r[j]      += dots[j];
+        rkk2      -= dots[j]*dots[j];
+        cvals[j+1] = -dots[j];
+        Xvecs[j+1] = Q[j];
+      }
+      retval = N_VLinearCombination(k+1, cvals, Xvecs, v);
+      if (retval != 0)  return(SUN_NLS_VECTOROP_ERR);
+
+      restart = (rkk2 <= UNIT_ROUNDOFF*dfdf);
+    }
+  }
+
+  /* restart from the newest df and dg vectors, moved to the first slot */
+  if (restart) {
+    v = df[i_pt];  df[i_pt] = df[0];  df[0] = v;
+    v = dg[i_pt];  dg[i_pt] = dg[0];  dg[0] = v;
+    FP_CONTENT(NLS)->aa_start += iter-1;
+    k = 0;
+    r = R;
+    v = Q[0];
+    ipt_map[0] = 0;
+    rkk2 = dfdf;
+  }
+
+  /* no acceleration if df is zero */
+  if (rkk2 <= ZERO) {
+    FP_CONTENT(NLS)->aa_start += (restart) ? 1 : iter;
+    *lAA = 0;
+    return(SUN_NLS_SUCCESS);
+  }
+
+  /* normalize the new column */
+  rkk  = SUNRsqrt(rkk2);
+  r[k] = rkk;
+  if (k == 0) {
+    N_VScale(ONE/rkk, df[0], v);
+  } else {
+    N_VScale(ONE/rkk, v, v);
+  }
+
+  /* gamma = Q^T fv, kept in qtf for the next iteration */
+  gamma[k] = dffv;
+  for (j = 0; j < k; j++) {
+    gamma[j]  = qtf[j] + r[j];
+    gamma[k] -= r[j]*gamma[j];
+  }
+  gamma[k] /= rkk;
+  for (j = 0; j <= k; j++)
+    qtf[j] = gamma[j];
+
+  *lAA = k+1;
+  return(SUN_NLS_SUCCESS);
+}
+
 static int AllocateContent(SUNNonlinearSolver NLS, N_Vector y)
 {
   int m = FP_CONTENT(NLS)->m;
@@ -647,6 +902,10 @@ static int AllocateContent(SUNNonlinearSolver NLS, N_Vector y)
     if (FP_CONTENT(NLS)->gamma == NULL) {
       FreeContent(NLS); return(SUN_NLS_MEM_FAIL); }
 
+    FP_CONTENT(NLS)->qtf = (realtype *) malloc(m * sizeof(realtype));
+    if (FP_CONTENT(NLS)->qtf == NULL) {
+      FreeContent(NLS); return(SUN_NLS_MEM_FAIL); }
+
     FP_CONTENT(NLS)->cvals = (realtype *) malloc(2*(m+1) * sizeof(realtype));
     if (FP_CONTENT(NLS)->cvals == NULL) {
       FreeContent(NLS); return(SUN_NLS_MEM_FAIL); }
@@ -705,6 +964,10 @@ static void FreeContent(SUNNonlinearSolver NLS)
     free(FP_CONTENT(NLS)->gamma);
     FP_CONTENT(NLS)->gamma = NULL; }
 
+  if (FP_CONTENT(NLS)->qtf) {
+    free(FP_CONTENT(NLS)->qtf);
+    FP_CONTENT(NLS)->qtf = NULL; }
+
   if (FP_CONTENT(NLS)->cvals) {
     free(FP_CONTENT(NLS)->cvals);
     FP_CONTENT(NLS)->cvals = NULL; }
@@ -0,0 +1,306 @@
+/*---------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2020, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ *---------------------------------------------------------------
+ * Routine to test CVodeGetDkyBatch against repeated calls to
+ * CVodeGetDky, using the decoupled problem
+ *    y_i' = -lambda_i*y_i,  lambda_i = 1 + i/N,  y_i(0) = 1,
+ * with N larger than one block of the batch interpolation.
+ *
+ * After each step, the derivatives of orders k = 0, ..., q are
+ * computed at NT times spread over the last step [tn-hu, tn], in
+ * both the row-major and the column-major layout, and compared
+ * with CVodeGetDky at each time. The batch must also reject a
+ * time before the last step with CV_BAD_T (leaving dky as is),
+ * an order k > q with CV_BAD_K and an unknown layout with
+ * CV_ILL_INPUT, and accept ntimes = 0.
+ *
+ * The number of problem equations may be given as an argument.
+ *---------------------------------------------------------------*/
+
+/* Header files */
+#include <stdio.h>
+#include <stdlib.h>
+#include <cvode/cvode.h>
+#include <nvector/nvector_serial.h>
+#include <sunmatrix/sunmatrix_band.h>
+#include <sunlinsol/sunlinsol_band.h>
+#include <sundials/sundials_math.h>
+
+#define NT      5                  /* times per batch            */
+#define NSTEPS  30                 /* steps to test              */
+#define RTOL    RCONST(1.0e-6)     /* scalar relative tolerance  */
+#define ATOL    RCONST(1.0e-10)    /* scalar absolute tolerance  */
+#define TF      RCONST(10.0)       /* final time                 */
+#define DKYTOL  (RCONST(100.0)*UNIT_ROUNDOFF)  /* allowed relative
+                                                  difference     */
+#define FILL    RCONST(-12345.0)   /* marks untouched entries    */
+
+#define TWO     RCONST(2.0)
+
+/* User-supplied Functions Called by the Solver */
+static int f(realtype t, N_Vector y, N_Vector ydot, void *user_data);
+
+/* Private function to check function return values */
+static int check_flag(void *flagvalue, const char *funcname, int opt);
+
+/* Private functions to run the tests */
+static int compare_batch(void *cvode_mem, sunindextype N, realtype *times,
+                         int k, realtype *dkyr, realtype *dkyc, N_Vector dky);
+static int check_errors(void *cvode_mem, sunindextype N, realtype *times,
+                        realtype *dkyr);
+
+/* Main Program */
+int main(int argc, char *argv[])
+{
+  sunindextype N;
+  int flag, k, q, p, istep, fails;
+  realtype t, tcur, hu, times[NT], *dkyr, *dkyc;
+  N_Vector y, dky;
+  SUNMatrix A;
+  SUNLinearSolver LS;
+  void *cvode_mem;
+
+  /* if an argument supplied, set N (otherwise use 600) */
+  N = 600;
+  if (argc > 1) N = (sunindextype) atol(argv[1]);
+  if (N < 1) {
+    printf("ERROR: the number of equations must be positive\n");
+    return(1);
+  }
+
+  printf("\nCVodeGetDkyBatch test, N = %ld\n", (long int) N);
+
+  y = N_VNew_Serial(N);
+  if (check_flag((void *)y, "N_VNew_Serial", 0)) return(1);
+  dky = N_VNew_Serial(N);
+  if (check_flag((void *)dky, "N_VNew_Serial", 0)) return(1);
+  N_VConst(RCONST(1.0), y);
+
+  dkyr = (realtype *) malloc(NT*N*sizeof(realtype));
+  dkyc = (realtype *) malloc(NT*N*sizeof(realtype));
+  if (check_flag((void *)dkyr, "malloc", 2)) return(1);
+  if (check_flag((void *)dkyc, "malloc", 2)) return(1);
+
+  cvode_mem = CVodeCreate(CV_BDF);
+  if (check_flag((void *)cvode_mem, "CVodeCreate", 0)) return(1);
+  flag = CVodeInit(cvode_mem, f, RCONST(0.0), y);
+  if (check_flag(&flag, "CVodeInit", 1)) return(1);
+  flag = CVodeSetUserData(cvode_mem, (void *) &N);
+  if (check_flag(&flag, "CVodeSetUserData", 1)) return(1);
+  flag = CVodeSStolerances(cvode_mem, RTOL, ATOL);
+  if (check_flag(&flag, "CVodeSStolerances", 1)) return(1);
+  flag = CVodeSetStopTime(cvode_mem, TF);
+  if (check_flag(&flag, "CVodeSetStopTime", 1)) return(1);
+
+  /* The Jacobian is diagonal */
+  A = SUNBandMatrix(N, 0, 0);
+  if (check_flag((void *)A, "SUNBandMatrix", 0)) return(1);
+  LS = SUNLinSol_Band(y, A);
+  if (check_flag((void *)LS, "SUNLinSol_Band", 0)) return(1);
+  flag = CVodeSetLinearSolver(cvode_mem, LS, A);
+  if (check_flag(&flag, "CVodeSetLinearSolver", 1)) return(1);
+
+  fails = 0;
+  t = RCONST(0.0);
+  for (istep = 0; istep < NSTEPS && t < TF; istep++) {
+    flag = CVode(cvode_mem, TF, y, &t, CV_ONE_STEP);
+    if (check_flag(&flag, "CVode", 1)) return(1);
+
+    flag = CVodeGetLastOrder(cvode_mem, &q);
+    if (check_flag(&flag, "CVodeGetLastOrder", 1)) return(1);
+    flag = CVodeGetLastStep(cvode_mem, &hu);
+    if (check_flag(&flag, "CVodeGetLastStep", 1)) return(1);
+    flag = CVodeGetCurrentTime(cvode_mem, &tcur);
+    if (check_flag(&flag, "CVodeGetCurrentTime", 1)) return(1);
+
+    /* Times from tn back to tn-hu, not in order */
+    for (p = 0; p < NT; p++)
+      times[p] = tcur - hu*((p*3) % NT)/(NT-1);
+
+    for (k = 0; k <= q; k++)
+      fails += compare_batch(cvode_mem, N, times, k, dkyr, dkyc, dky);
+  }
+  printf("  %d steps compared, last order %d\n", istep, q);
+
+  fails += check_errors(cvode_mem, N, times, dkyr);
+
+  /* Clean up */
+  N_VDestroy(y);
+  N_VDestroy(dky);
+  free(dkyr);
+  free(dkyc);
+  CVodeFree(&cvode_mem);
+  SUNLinSolFree(LS);
+  SUNMatDestroy(A);
+
+  if (fails) {
+    printf("FAIL: %d checks failed\n", fails);
+    return(1);
+  }
+
+  printf("SUCCESS\n");
+  return(0);
+}
+
+/*-------------------------------
+ * Functions called by the solver
+ *-------------------------------*/
+
+/* f routine to compute the ODE RHS function f(t,y). */
+static int f(realtype t, N_Vector y, N_Vector ydot, void *user_data)
+{
+  sunindextype i, N;
+  realtype *yd, *ydotd;
+
+  N = *((sunindextype *) user_data);
+  yd = N_VGetArrayPointer(y);
+  ydotd = N_VGetArrayPointer(ydot);
+
+  for (i = 0; i < N; i++)
+    ydotd[i] = -(RCONST(1.0) + ((realtype) i)/N)*yd[i];
+
+  return(0);
+}
+
+/*-------------------------------
+ * Private helper functions
+ *-------------------------------*/
+
+/* Computes the k-th derivatives at the NT times with CVodeGetDkyBatch
+   in both layouts and compares them with CVodeGetDky. Returns the
+   number of failed checks. */
+static int compare_batch(void *cvode_mem, sunindextype N, realtype *times,
+                         int k, realtype *dkyr, realtype *dkyc, N_Vector dky)
+{
+  sunindextype i;
+  int flag, p, fails;
+  realtype *dkyd, err;
+
+  flag = CVodeGetDkyBatch(cvode_mem, NT, times, k, CV_ROW_MAJOR, dkyr);
+  if (check_flag(&flag, "CVodeGetDkyBatch", 1)) return(1);
+  flag = CVodeGetDkyBatch(cvode_mem, NT, times, k, CV_COL_MAJOR, dkyc);
+  if (check_flag(&flag, "CVodeGetDkyBatch", 1)) return(1);
+
+  dkyd = N_VGetArrayPointer(dky);
+  fails = 0;
+  for (p = 0; p < NT; p++) {
+    flag = CVodeGetDky(cvode_mem, times[p], k, dky);
+    if (check_flag(&flag, "CVodeGetDky", 1)) return(1);
+    for (i = 0; i < N; i++) {
+      err = SUNMAX(SUNRabs(dkyr[p*N+i] - dkyd[i]),
+                   SUNRabs(dkyc[i*NT+p] - dkyd[i]));
+      if (err > DKYTOL*SUNMAX(RCONST(1.0), SUNRabs(dkyd[i]))) {
+        printf("FAIL: k = %d, t = %g, i = %ld: batch differs by %g\n",
+               k, (double) times[p], (long int) i, (double) err);
+        fails++;
+        break;
+      }
+    }
+  }
+
+  return(fails);
+}
+
+/* Checks the error returns of CVodeGetDkyBatch. Returns the number
+   of failed checks. */
+static int check_errors(void *cvode_mem, sunindextype N, realtype *times,
+                        realtype *dkyr)
+{
+  sunindextype i;
+  int flag, q, fails;
+  realtype hu, tsave;
+
+  flag = CVodeGetLastOrder(cvode_mem, &q);
+  if (check_flag(&flag, "CVodeGetLastOrder", 1)) return(1);
+  flag = CVodeGetLastStep(cvode_mem, &hu);
+  if (check_flag(&flag, "CVodeGetLastStep", 1)) return(1);
+
+  /* The error messages are expected */
+  flag = CVodeSetErrFile(cvode_mem, NULL);
+  if (check_flag(&flag, "CVodeSetErrFile", 1)) return(1);
+
+  fails = 0;
+
+  /* A time before the last step, after valid times */
+  for (i = 0; i < NT*N; i++) dkyr[i] = FILL;
+  tsave = times[NT-1];
+  times[NT-1] = times[0] - TWO*hu;
+  flag = CVodeGetDkyBatch(cvode_mem, NT, times, 0, CV_ROW_MAJOR, dkyr);
+  times[NT-1] = tsave;
+  if (flag != CV_BAD_T) {
+    printf("FAIL: t out of range returned %d, expected CV_BAD_T\n", flag);
+    fails++;
+  }
+  for (i = 0; i < NT*N; i++) {
+    if (dkyr[i] != FILL) {
+      printf("FAIL: t out of range wrote dky\n");
+      fails++;
+      break;
+    }
+  }
+
+  flag = CVodeGetDkyBatch(cvode_mem, NT, times, q+1, CV_ROW_MAJOR, dkyr);
+  if (flag != CV_BAD_K) {
+    printf("FAIL: k = q+1 returned %d, expected CV_BAD_K\n", flag);
+    fails++;
+  }
+
+  flag = CVodeGetDkyBatch(cvode_mem, NT, times, 0, -1, dkyr);
+  if (flag != CV_ILL_INPUT) {
+    printf("FAIL: bad layout returned %d, expected CV_ILL_INPUT\n", flag);
+    fails++;
+  }
+
+  flag = CVodeGetDkyBatch(cvode_mem, 0, NULL, 0, CV_COL_MAJOR, dkyr);
+  if (flag != CV_SUCCESS) {
+    printf("FAIL: ntimes = 0 returned %d, expected CV_SUCCESS\n", flag);
+    fails++;
+  }
+
+  if (fails == 0) printf("  error returns as expected\n");
+
+  return(fails);
+}
+
+/* Check function return value...
+    opt == 0 means SUNDIALS function allocates memory so check if
+             returned NULL pointer
+    opt == 1 means SUNDIALS function returns a flag so check if
+             flag >= 0
+    opt == 2 means function allocates memory so check if returned
+             NULL pointer
+*/
+static int check_flag(void *flagvalue, const char *funcname, int opt)
+{
+  int *errflag;
+
+  /* Check if SUNDIALS function returned NULL pointer - no memory allocated */
+  if (opt == 0 && flagvalue == NULL) {
+    fprintf(stderr, "\nSUNDIALS_ERROR: %s() failed - returned NULL pointer\n\n",
+            funcname);
+    return 1; }
+
+  /* Check if flag < 0 */
+  else if (opt == 1) {
+    errflag = (int *) flagvalue;
+    if (*errflag < 0) {
+      fprintf(stderr, "\nSUNDIALS_ERROR: %s() failed with flag = %d\n\n",
+              funcname, *errflag);
+      return 1; }}
+
+  /* Check if function returned NULL pointer - no memory allocated */
+  else if (opt == 2 && flagvalue == NULL) {
+    fprintf(stderr, "\nMEMORY_ERROR: %s() failed - returned NULL pointer\n\n",
+            funcname);
+    return 1; }
+
+  return 0;
+}